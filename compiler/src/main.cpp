@@ -8,26 +8,38 @@
  * - Parsing (AST generation)
  * - Semantic validation
  * - Bytecode compilation
- * - Output in various formats (binary, JSON)
+ * - Output in various formats (binary NMC2 or legacy NMC1, JSON)
  *
  * Usage:
- *   nmc <input.nms> [-o output] [--ast] [--tokens] [--validate-only] [--verbose]
+ *   nmc <input.nms> [-o output] [-O0|-O1|-O2] [--ast] [--tokens] [--validate-only] [--verbose]
+ *   nmc --project <dir> [-j N] [-o output] [-O0|-O1|-O2] [--no-cache]
+ *   nmc ... --pack <game.nmres> [--assets <dir>]
  */
 
 #include "NovelMind/scripting/lexer.hpp"
 #include "NovelMind/scripting/parser.hpp"
 #include "NovelMind/scripting/validator.hpp"
 #include "NovelMind/scripting/compiler.hpp"
+#include "NovelMind/scripting/bytecode_optimizer.hpp"
+#include "NovelMind/scripting/asset_prefetcher.hpp"
+#include "NovelMind/scripting/compiled_script_image.hpp"
 #include "NovelMind/scripting/script_error.hpp"
 #include "NovelMind/core/logger.hpp"
+#include "NovelMind/vfs/pack_writer.hpp"
+#include "NovelMind/vfs/resource_id.hpp"
+#include "project_build.hpp"
 
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <string>
 #include <vector>
+#include <cctype>
+#include <cstdlib>
 #include <cstring>
+#include <iomanip>
 #include <filesystem>
+#include <algorithm>
 
 // Platform-specific includes for isatty/fileno
 #ifdef _WIN32
@@ -63,6 +75,19 @@ struct CompilerOptions {
     bool noColor = false;
     bool help = false;
     bool version = false;
+    bool legacyFormat = false;
+
+    // Project mode (--project)
+    std::string projectDir;
+    std::string cacheDir;
+    unsigned jobs = 0;
+    bool noCache = false;
+    NovelMind::scripting::OptimizationLevel optimizationLevel =
+        NovelMind::scripting::OptimizationLevel::O0;
+
+    // Asset pack (--pack)
+    std::string packFile;
+    std::string assetsDir;
 };
 
 void printVersion() {
@@ -74,10 +99,19 @@ void printVersion() {
 }
 
 void printUsage(const char* programName) {
-    std::cout << "Usage: " << programName << " <input.nms> [options]\n\n";
+    std::cout << "Usage: " << programName << " <input.nms> [options]\n";
+    std::cout << "       " << programName << " --project <dir> [options]\n\n";
     std::cout << "NovelMind Script Compiler - Compiles NM Script files to bytecode.\n\n";
     std::cout << "Options:\n";
     std::cout << "  -o, --output <file>   Output file (default: <input>.nmc)\n";
+    std::cout << "  -O0, -O1, -O2         Bytecode optimization level (default: -O0)\n";
+    std::cout << "  --nmc1                Write the legacy NMC1 format instead of NMC2\n";
+    std::cout << "  --project <dir>       Compile and link every .nms file under <dir>\n";
+    std::cout << "  -j, --jobs <n>        Worker threads for --project (default: all cores)\n";
+    std::cout << "  --cache-dir <dir>     Unit cache location (default: <dir>/.nmc-cache)\n";
+    std::cout << "  --no-cache            Recompile every file in --project mode\n";
+    std::cout << "  --pack <file>         Also pack the assets in play order into <file>\n";
+    std::cout << "  --assets <dir>        Assets for --pack (default: the project or script directory)\n";
     std::cout << "  --tokens              Show lexer tokens\n";
     std::cout << "  --ast                 Show parsed AST\n";
     std::cout << "  --ir                  Show intermediate representation\n";
@@ -89,7 +123,10 @@ void printUsage(const char* programName) {
     std::cout << "Examples:\n";
     std::cout << "  " << programName << " main.nms                  # Compile main.nms to main.nmc\n";
     std::cout << "  " << programName << " main.nms -o game.nmc      # Compile to game.nmc\n";
+    std::cout << "  " << programName << " main.nms -O2              # Compile with full optimization\n";
     std::cout << "  " << programName << " main.nms --validate-only  # Only check for errors\n";
+    std::cout << "  " << programName << " --project scripts -j 8    # Parallel project build\n";
+    std::cout << "  " << programName << " --project game --pack game.nmres  # Build and pack assets\n";
     std::cout << "  " << programName << " main.nms --ast --tokens   # Show debug output\n";
 }
 
@@ -109,6 +146,49 @@ CompilerOptions parseArgs(int argc, char* argv[]) {
             } else {
                 std::cerr << "Error: -o requires an argument\n";
             }
+        } else if (arg == "-O0") {
+            opts.optimizationLevel = NovelMind::scripting::OptimizationLevel::O0;
+        } else if (arg == "-O1") {
+            opts.optimizationLevel = NovelMind::scripting::OptimizationLevel::O1;
+        } else if (arg == "-O2") {
+            opts.optimizationLevel = NovelMind::scripting::OptimizationLevel::O2;
+        } else if (arg == "--project") {
+            if (i + 1 < argc) {
+                opts.projectDir = argv[++i];
+            } else {
+                std::cerr << "Error: --project requires an argument\n";
+            }
+        } else if (arg == "-j" || arg == "--jobs") {
+            if (i + 1 < argc) {
+                opts.jobs = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+            } else {
+                std::cerr << "Error: " << arg << " requires an argument\n";
+            }
+        } else if (arg.rfind("-j", 0) == 0 && arg.size() > 2 &&
+                   std::isdigit(static_cast<unsigned char>(arg[2]))) {
+            opts.jobs = static_cast<unsigned>(std::strtoul(arg.c_str() + 2, nullptr, 10));
+        } else if (arg == "--cache-dir") {
+            if (i + 1 < argc) {
+                opts.cacheDir = argv[++i];
+            } else {
+                std::cerr << "Error: --cache-dir requires an argument\n";
+            }
+        } else if (arg == "--no-cache") {
+            opts.noCache = true;
+        } else if (arg == "--pack") {
+            if (i + 1 < argc) {
+                opts.packFile = argv[++i];
+            } else {
+                std::cerr << "Error: --pack requires an argument\n";
+            }
+        } else if (arg == "--assets") {
+            if (i + 1 < argc) {
+                opts.assetsDir = argv[++i];
+            } else {
+                std::cerr << "Error: --assets requires an argument\n";
+            }
+        } else if (arg == "--nmc1") {
+            opts.legacyFormat = true;
         } else if (arg == "--tokens") {
             opts.showTokens = true;
         } else if (arg == "--ast") {
@@ -132,6 +212,20 @@ CompilerOptions parseArgs(int argc, char* argv[]) {
     if (opts.outputFile.empty() && !opts.inputFile.empty()) {
         fs::path inputPath(opts.inputFile);
         opts.outputFile = inputPath.stem().string() + ".nmc";
+    } else if (opts.outputFile.empty() && !opts.projectDir.empty()) {
+        fs::path projectPath = fs::absolute(opts.projectDir).lexically_normal();
+        if (projectPath.filename().empty()) {
+            projectPath = projectPath.parent_path();
+        }
+        opts.outputFile = projectPath.filename().string() + ".nmc";
+    }
+
+    if (!opts.packFile.empty() && opts.assetsDir.empty()) {
+        if (!opts.projectDir.empty()) {
+            opts.assetsDir = opts.projectDir;
+        } else if (!opts.inputFile.empty()) {
+            opts.assetsDir = fs::absolute(opts.inputFile).parent_path().string();
+        }
     }
 
     return opts;
@@ -148,7 +242,7 @@ std::string readFile(const std::string& path) {
     return buffer.str();
 }
 
-void printTokens(const std::vector<NovelMind::scripting::Token>& tokens, bool useColor) {
+void printTokens(const std::vector<NovelMind::scripting::TokenView>& tokens, bool useColor) {
     const char* cyan = useColor ? Color::Cyan : "";
     const char* yellow = useColor ? Color::Yellow : "";
     const char* green = useColor ? Color::Green : "";
@@ -245,8 +339,8 @@ void printErrors(const NovelMind::scripting::ErrorList& errors, bool useColor) {
     }
 }
 
-bool writeCompiledScript(const NovelMind::scripting::CompiledScript& script,
-                         const std::string& path) {
+bool writeLegacyCompiledScript(const NovelMind::scripting::CompiledScript& script,
+                               const std::string& path) {
     std::ofstream file(path, std::ios::binary);
     if (!file.is_open()) {
         return false;
@@ -316,6 +410,169 @@ bool writeCompiledScript(const NovelMind::scripting::CompiledScript& script,
     return file.good();
 }
 
+/**
+ * Pack every file under --assets, laid out in the order the script first
+ * uses them. Hidden entries, scripts, compiled scripts and packs are left
+ * out; resource ids are paths relative to the asset directory.
+ */
+int writeAssetPack(const NovelMind::scripting::CompiledScript& script,
+                   const CompilerOptions& opts, bool useColor) {
+    const char* green = useColor ? Color::Green : "";
+    const char* red = useColor ? Color::Red : "";
+    const char* bold = useColor ? Color::Bold : "";
+    const char* reset = useColor ? Color::Reset : "";
+
+    std::error_code ec;
+    const fs::path root = fs::absolute(opts.assetsDir).lexically_normal();
+    const fs::path packPath = fs::absolute(opts.packFile).lexically_normal();
+    const fs::path outputPath = fs::absolute(opts.outputFile).lexically_normal();
+
+    std::vector<fs::path> files;
+    for (auto it = fs::recursive_directory_iterator(root, ec);
+         !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+        const fs::path& path = it->path();
+        if (path.filename().string().rfind('.', 0) == 0) {
+            if (it->is_directory()) {
+                it.disable_recursion_pending();
+            }
+            continue;
+        }
+        const fs::path extension = path.extension();
+        if (!it->is_regular_file() || extension == ".nms" ||
+            extension == ".nmc" || extension == ".nmres" ||
+            path == packPath || path == outputPath) {
+            continue;
+        }
+        files.push_back(path);
+    }
+    if (ec) {
+        std::cerr << red << "Error: " << reset << "Cannot list assets in "
+                  << opts.assetsDir << ": " << ec.message() << "\n";
+        return 1;
+    }
+    // Directory order varies by file system; keep packs reproducible
+    std::sort(files.begin(), files.end());
+
+    NovelMind::vfs::PackWriterConfig config;
+    config.jobs = opts.jobs;
+    NovelMind::vfs::PackWriter writer(config);
+    for (const auto& path : files) {
+        const std::string id = path.lexically_relative(root).generic_string();
+        // The pack format has no types past Data
+        auto type = static_cast<NovelMind::vfs::ResourceType>(
+            NovelMind::VFS::ResourceId::typeFromExtension(id));
+        if (type > NovelMind::vfs::ResourceType::Data) {
+            type = NovelMind::vfs::ResourceType::Data;
+        }
+        auto added = writer.addFile(id, path.string(), type);
+        if (added.isError()) {
+            std::cerr << red << "Error: " << reset << added.error() << "\n";
+            return 1;
+        }
+    }
+
+    writer.setFirstUseOrder(
+        NovelMind::scripting::AssetPrefetcher::firstUseOrder(script));
+    auto written = writer.write(opts.packFile);
+    if (written.isError()) {
+        std::cerr << red << "Error: " << reset << written.error() << "\n";
+        return 1;
+    }
+
+    const auto& report = writer.report();
+    std::cout << green << bold << "Packed" << reset << " "
+              << report.resourceCount << " assets -> " << opts.packFile
+              << " (" << report.bytesSaved() << " bytes deduplicated, "
+              << report.orderedBlobs << " in play order)\n";
+    if (opts.verbose) {
+        std::cout << "  " << report.storedBytes << " bytes of data in "
+                  << report.blobCount << " payloads\n";
+        std::cout << "  " << static_cast<int>(report.seekReduction() * 100.0)
+                  << "% less seeking on a cold start\n";
+    }
+    return 0;
+}
+
+/**
+ * Optimize (if requested), print and write a compiled script, then pack
+ * the assets if --pack was given. Shared by single-file and project builds.
+ */
+int emitOutput(NovelMind::scripting::CompiledScript& compiledScript,
+               const CompilerOptions& opts, const std::string& inputDescription,
+               bool useColor) {
+    const char* green = useColor ? Color::Green : "";
+    const char* red = useColor ? Color::Red : "";
+    const char* bold = useColor ? Color::Bold : "";
+    const char* reset = useColor ? Color::Reset : "";
+
+    // Optimization
+    if (opts.optimizationLevel != NovelMind::scripting::OptimizationLevel::O0) {
+        if (opts.verbose) {
+            std::cout << "Optimizing...\n";
+        }
+
+        NovelMind::scripting::BytecodeOptimizer optimizer(opts.optimizationLevel);
+        auto stats = optimizer.optimize(compiledScript);
+
+        std::cout << "Optimized (-O" << static_cast<int>(opts.optimizationLevel)
+                  << "): " << stats.instructionsBefore << " -> "
+                  << stats.instructionsAfter << " instructions ("
+                  << static_cast<int>(stats.reductionPercent()) << "% fewer)\n";
+
+        if (opts.verbose) {
+            std::cout << "  " << stats.constantsFolded << " constants folded\n";
+            std::cout << "  " << stats.branchesSimplified << " branches simplified\n";
+            std::cout << "  " << stats.jumpsThreaded << " jumps threaded\n";
+            std::cout << "  " << stats.branchesFused << " compare/branch pairs fused\n";
+            std::cout << "  " << stats.deadInstructionsRemoved << " unreachable instructions removed\n";
+        }
+    }
+
+    if (opts.showIr) {
+        printIr(compiledScript, useColor);
+    }
+
+    // Write output
+    if (opts.verbose) {
+        std::cout << "Writing " << opts.outputFile << "...\n";
+    }
+
+    bool written = false;
+    if (opts.legacyFormat) {
+        written = writeLegacyCompiledScript(compiledScript, opts.outputFile);
+    } else {
+        NovelMind::u32 version = (NOVELMIND_VERSION_MAJOR << 16) |
+                                 (NOVELMIND_VERSION_MINOR << 8) |
+                                  NOVELMIND_VERSION_PATCH;
+        written = NovelMind::scripting::writeNmc2(compiledScript, opts.outputFile,
+                                                  version).isOk();
+    }
+
+    if (!written) {
+        std::cerr << red << "Error: " << reset
+                  << "Failed to write output file: " << opts.outputFile << "\n";
+        return 1;
+    }
+
+    std::cout << green << bold << "Success!" << reset << " Compiled "
+              << inputDescription << " -> " << opts.outputFile << "\n";
+
+    if (opts.verbose) {
+        std::cout << "  " << compiledScript.instructions.size() << " instructions\n";
+        std::cout << "  " << compiledScript.stringTable.size() << " strings\n";
+        std::cout << "  " << compiledScript.sceneEntryPoints.size() << " scenes\n";
+        std::cout << "  " << compiledScript.characters.size() << " characters\n";
+    }
+
+    if (!opts.packFile.empty()) {
+        return writeAssetPack(compiledScript, opts, useColor);
+    }
+    return 0;
+}
+
+// Build every script under --project; defined after main()
+int runProjectBuild(const CompilerOptions& opts, bool useColor);
+
 int main(int argc, char* argv[]) {
     CompilerOptions opts = parseArgs(argc, argv);
 
@@ -332,11 +589,15 @@ int main(int argc, char* argv[]) {
         return 0;
     }
 
-    if (opts.help || opts.inputFile.empty()) {
+    if (opts.help || (opts.inputFile.empty() && opts.projectDir.empty())) {
         printUsage(argv[0]);
         return opts.help ? 0 : 1;
     }
 
+    if (!opts.projectDir.empty()) {
+        return runProjectBuild(opts, useColor);
+    }
+
     const char* green = useColor ? Color::Green : "";
     const char* red = useColor ? Color::Red : "";
     const char* bold = useColor ? Color::Bold : "";
@@ -355,8 +616,10 @@ int main(int argc, char* argv[]) {
             std::cout << "Tokenizing...\n";
         }
 
+        // Tokens view into `source` and `lexerArena`; both outlive parsing
+        NovelMind::core::Arena lexerArena;
         NovelMind::scripting::Lexer lexer;
-        auto tokenResult = lexer.tokenize(source);
+        auto tokenResult = lexer.tokenizeViews(source, lexerArena);
 
         if (!tokenResult.isOk()) {
             std::cerr << red << "Lexer error: " << reset
@@ -364,7 +627,7 @@ int main(int argc, char* argv[]) {
             return 1;
         }
 
-        auto tokens = tokenResult.value();
+        const auto& tokens = tokenResult.value();
 
         if (!lexer.getErrors().empty()) {
             for (const auto& err : lexer.getErrors()) {
@@ -472,32 +735,56 @@ int main(int argc, char* argv[]) {
             return 1;
         }
 
-        if (opts.showIr) {
-            printIr(compiledScript, useColor);
-        }
+        return emitOutput(compiledScript, opts, opts.inputFile, useColor);
 
-        // Write output
-        if (opts.verbose) {
-            std::cout << "Writing " << opts.outputFile << "...\n";
-        }
+    } catch (const std::exception& e) {
+        std::cerr << red << "Error: " << reset << e.what() << "\n";
+        return 1;
+    }
+}
 
-        if (!writeCompiledScript(compiledScript, opts.outputFile)) {
-            std::cerr << red << "Error: " << reset
-                      << "Failed to write output file: " << opts.outputFile << "\n";
-            return 1;
-        }
+int runProjectBuild(const CompilerOptions& opts, bool useColor) {
+    const char* red = useColor ? Color::Red : "";
+    const char* yellow = useColor ? Color::Yellow : "";
+    const char* reset = useColor ? Color::Reset : "";
 
-        std::cout << green << bold << "Success!" << reset << " Compiled "
-                  << opts.inputFile << " -> " << opts.outputFile << "\n";
+    nmc::ProjectBuildOptions buildOptions;
+    buildOptions.projectDir = opts.projectDir;
+    buildOptions.cacheDir = opts.cacheDir;
+    buildOptions.jobs = opts.jobs;
+    buildOptions.useCache = !opts.noCache;
 
-        if (opts.verbose) {
-            std::cout << "  " << compiledScript.instructions.size() << " instructions\n";
-            std::cout << "  " << compiledScript.stringTable.size() << " strings\n";
-            std::cout << "  " << compiledScript.sceneEntryPoints.size() << " scenes\n";
-            std::cout << "  " << compiledScript.characters.size() << " characters\n";
+    try {
+        nmc::ProjectBuildReport report;
+        auto result = nmc::buildProject(buildOptions, report);
+
+        for (const auto& warning : report.warnings) {
+            std::cerr << yellow << "warning" << reset << ": " << warning << "\n";
+        }
+        for (const auto& error : report.errors) {
+            std::cerr << red << "error" << reset << ": " << error << "\n";
         }
 
-        return 0;
+        std::cout << "Project: " << report.filesTotal << " files ("
+                  << report.filesCompiled << " compiled, "
+                  << report.filesCached << " cached) on "
+                  << report.jobs << " threads\n";
+        std::cout << std::fixed << std::setprecision(1)
+                  << "  scan+hash " << report.scanMs << " ms, "
+                  << "lex+parse " << report.frontendMs << " ms, "
+                  << "validate+compile " << report.backendMs << " ms, "
+                  << "link " << report.linkMs << " ms\n";
+        std::cout.unsetf(std::ios::floatfield);
+
+        if (!result.isOk()) {
+            if (report.errors.empty()) {
+                std::cerr << red << "Error: " << reset << result.error() << "\n";
+            }
+            return 1;
+        }
+
+        auto script = std::move(result).value();
+        return emitOutput(script, opts, opts.projectDir, useColor);
 
     } catch (const std::exception& e) {
         std::cerr << red << "Error: " << reset << e.what() << "\n";
@@ -0,0 +1,533 @@
+#include "project_build.hpp"
+
+#include "NovelMind/resource/decoded_asset_cache.hpp"
+#include "NovelMind/scripting/compiled_script_image.hpp"
+#include "NovelMind/scripting/lexer.hpp"
+#include "NovelMind/scripting/parser.hpp"
+#include "NovelMind/scripting/script_linker.hpp"
+#include "NovelMind/scripting/validator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <set>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace nmc {
+
+using NovelMind::Result;
+using NovelMind::u32;
+using NovelMind::u64;
+using NovelMind::u8;
+using NovelMind::usize;
+using namespace NovelMind::scripting;
+
+namespace {
+
+constexpr char kCacheMagic[4] = {'N', 'M', 'C', 'U'};
+constexpr u32 kCacheVersion = 2;
+
+u64 fnv1aBytes(const void* data, usize size,
+                u64 hash = 0xcbf29ce484222325ULL) {
+    constexpr u64 FNV_PRIME = 0x100000001b3ULL;
+    const auto* bytes = static_cast<const u8*>(data);
+    for (usize i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+u64 fnv1a(const std::string& str, u64 hash = 0xcbf29ce484222325ULL) {
+    // Include the terminator so adjacent names cannot run together
+    return fnv1aBytes(str.c_str(), str.size() + 1, hash);
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+// Run fn(i) for i in [0, count) on up to `jobs` threads
+template <typename Fn>
+void parallelFor(usize count, unsigned jobs, Fn&& fn) {
+    const usize workers = std::min<usize>(jobs, count);
+    if (workers <= 1) {
+        for (usize i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    std::atomic<usize> next{0};
+    auto worker = [&]() {
+        for (usize i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            fn(i);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (usize t = 1; t < workers; ++t) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+struct SourceFile {
+    fs::path path;
+    std::string displayName;
+    std::string source;
+    u64 sourceHash = 0;
+
+    // Symbols this file defines
+    std::vector<std::string> characters;
+    std::vector<std::string> scenes;
+
+    std::optional<Program> program;
+    std::optional<CompiledScript> unit;
+    u64 cachedFingerprint = 0;
+    bool fromCache = false;
+
+    std::vector<std::string> errors;
+    std::vector<std::string> warnings;
+};
+
+// ----------------------------------------------------------------------------
+// Cache entries: NMCU header (format and compiler version), symbol lists,
+// validator warnings, external refs, then an NMC2 image
+// ----------------------------------------------------------------------------
+
+class ByteWriter {
+public:
+    template <typename T> void pod(const T& value) {
+        const auto* p = reinterpret_cast<const u8*>(&value);
+        bytes.insert(bytes.end(), p, p + sizeof(T));
+    }
+    void str(const std::string& value) {
+        pod(static_cast<u32>(value.size()));
+        bytes.insert(bytes.end(), value.begin(), value.end());
+    }
+    void strings(const std::vector<std::string>& values) {
+        pod(static_cast<u32>(values.size()));
+        for (const auto& value : values) {
+            str(value);
+        }
+    }
+
+    std::vector<u8> bytes;
+};
+
+class ByteReader {
+public:
+    explicit ByteReader(const std::vector<u8>& data) : m_data(data) {}
+
+    template <typename T> bool pod(T& value) {
+        if (m_data.size() - m_pos < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, m_data.data() + m_pos, sizeof(T));
+        m_pos += sizeof(T);
+        return true;
+    }
+    bool str(std::string& value) {
+        u32 len = 0;
+        if (!pod(len) || m_data.size() - m_pos < len) {
+            return false;
+        }
+        value.assign(reinterpret_cast<const char*>(m_data.data() + m_pos), len);
+        m_pos += len;
+        return true;
+    }
+    bool strings(std::vector<std::string>& values) {
+        u32 count = 0;
+        if (!pod(count)) {
+            return false;
+        }
+        values.resize(count);
+        for (auto& value : values) {
+            if (!str(value)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    std::vector<u8> rest() const {
+        return {m_data.begin() + static_cast<std::ptrdiff_t>(m_pos), m_data.end()};
+    }
+
+private:
+    const std::vector<u8>& m_data;
+    usize m_pos = 0;
+};
+
+fs::path cachePathFor(const fs::path& cacheDir, const std::string& displayName) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.nmcu",
+                  static_cast<unsigned long long>(fnv1a(displayName)));
+    return cacheDir / name;
+}
+
+void writeCacheEntry(const fs::path& path, const SourceFile& file,
+                     u64 fingerprint) {
+    ByteWriter writer;
+    writer.bytes.insert(writer.bytes.end(), kCacheMagic, kCacheMagic + 4);
+    writer.pod(kCacheVersion);
+    writer.pod(NovelMind::resource::kEngineVersion);
+    writer.pod(file.sourceHash);
+    writer.pod(fingerprint);
+    writer.strings(file.characters);
+    writer.strings(file.scenes);
+    writer.strings(file.warnings);
+
+    const auto& refs = file.unit->externalSceneRefs;
+    writer.pod(static_cast<u32>(refs.size()));
+    for (const auto& ref : refs) {
+        writer.pod(ref.instructionIndex);
+        writer.str(ref.scene);
+    }
+
+    std::vector<u8> image = serializeNmc2(*file.unit);
+    writer.bytes.insert(writer.bytes.end(), image.begin(), image.end());
+
+    // Write to a temporary name first so a crash never leaves a torn entry
+    fs::path tmp = path;
+    tmp += ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(writer.bytes.data()),
+                  static_cast<std::streamsize>(writer.bytes.size()));
+        if (!out.good()) {
+            return;
+        }
+    }
+    std::error_code ec;
+    fs::rename(tmp, path, ec);
+}
+
+bool readCacheEntry(const fs::path& path, SourceFile& file) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+    std::vector<u8> data((std::istreambuf_iterator<char>(in)),
+                         std::istreambuf_iterator<char>());
+
+    if (data.size() < 4 || std::memcmp(data.data(), kCacheMagic, 4) != 0) {
+        return false;
+    }
+
+    ByteReader reader(data);
+    u32 magic = 0;
+    u32 version = 0;
+    u32 engineVersion = 0;
+    u64 sourceHash = 0;
+    u64 fingerprint = 0;
+    // Entries from another compiler build may have been validated or
+    // compiled differently
+    if (!reader.pod(magic) || !reader.pod(version) || version != kCacheVersion ||
+        !reader.pod(engineVersion) ||
+        engineVersion != NovelMind::resource::kEngineVersion ||
+        !reader.pod(sourceHash) || sourceHash != file.sourceHash ||
+        !reader.pod(fingerprint)) {
+        return false;
+    }
+
+    std::vector<std::string> characters;
+    std::vector<std::string> scenes;
+    std::vector<std::string> warnings;
+    u32 refCount = 0;
+    if (!reader.strings(characters) || !reader.strings(scenes) ||
+        !reader.strings(warnings) || !reader.pod(refCount)) {
+        return false;
+    }
+
+    std::vector<CompiledScript::SceneReference> refs(refCount);
+    for (auto& ref : refs) {
+        if (!reader.pod(ref.instructionIndex) || !reader.str(ref.scene)) {
+            return false;
+        }
+    }
+
+    auto image = CompiledScriptImage::fromBuffer(reader.rest());
+    if (image.isError()) {
+        return false;
+    }
+
+    file.characters = std::move(characters);
+    file.scenes = std::move(scenes);
+    file.warnings = std::move(warnings);
+    file.unit = image.value().toCompiledScript();
+    file.unit->externalSceneRefs = std::move(refs);
+    file.cachedFingerprint = fingerprint;
+    file.fromCache = true;
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Pipeline stages
+// ----------------------------------------------------------------------------
+
+void runFrontend(SourceFile& file) {
+    NovelMind::core::Arena arena;
+    Lexer lexer;
+    auto tokens = lexer.tokenizeViews(file.source, arena);
+    if (!tokens.isOk()) {
+        file.errors.push_back("lexer error: " + tokens.error());
+        return;
+    }
+    for (const auto& err : lexer.getErrors()) {
+        file.errors.push_back("lexer error: " + err.message + " [line " +
+                              std::to_string(err.location.line) + "]");
+    }
+    if (!file.errors.empty()) {
+        return;
+    }
+
+    Parser parser;
+    auto parsed = parser.parse(tokens.value());
+    if (!parsed.isOk()) {
+        file.errors.push_back("parse error: " + parsed.error());
+        return;
+    }
+    for (const auto& err : parser.getErrors()) {
+        file.errors.push_back("parse error: " + err.message + " [line " +
+                              std::to_string(err.location.line) + "]");
+    }
+    if (!file.errors.empty()) {
+        return;
+    }
+
+    file.program = std::move(parsed).value();
+    file.characters.clear();
+    file.scenes.clear();
+    for (const auto& ch : file.program->characters) {
+        file.characters.push_back(ch.id);
+    }
+    for (const auto& scene : file.program->scenes) {
+        file.scenes.push_back(scene.name);
+    }
+}
+
+void runBackend(SourceFile& file, const std::set<std::string>& allCharacters,
+                const std::set<std::string>& allScenes) {
+    // Symbols from the rest of the project count as defined for this file
+    auto external = [](const std::set<std::string>& all,
+                       const std::vector<std::string>& own) {
+        std::vector<std::string> out;
+        for (const auto& name : all) {
+            if (std::find(own.begin(), own.end(), name) == own.end()) {
+                out.push_back(name);
+            }
+        }
+        return out;
+    };
+
+    Validator validator;
+    // Unused/unreachable analysis needs the whole program; skip per file
+    validator.setReportUnused(false);
+    validator.setReportDeadCode(false);
+    validator.setExternalSymbols(external(allCharacters, file.characters),
+                                 external(allScenes, file.scenes));
+
+    auto validation = validator.validate(*file.program);
+    for (const auto& err : validation.errors.all()) {
+        std::string line = err.message + " [line " +
+                           std::to_string(err.span.start.line) + "]";
+        if (err.severity == Severity::Error) {
+            file.errors.push_back(std::move(line));
+        } else if (err.severity == Severity::Warning) {
+            file.warnings.push_back(std::move(line));
+        }
+    }
+    if (!validation.isValid) {
+        return;
+    }
+
+    Compiler compiler;
+    compiler.setAllowExternalScenes(true);
+    auto compiled = compiler.compile(*file.program);
+    if (!compiled.isOk()) {
+        file.errors.push_back("compile error: " + compiled.error());
+        return;
+    }
+    file.unit = std::move(compiled).value();
+}
+
+} // namespace
+
+Result<CompiledScript> buildProject(const ProjectBuildOptions& options,
+                                    ProjectBuildReport& report) {
+    using Clock = std::chrono::steady_clock;
+
+    const fs::path root(options.projectDir);
+    if (!fs::is_directory(root)) {
+        return Result<CompiledScript>::error("Not a directory: " +
+                                             options.projectDir);
+    }
+
+    report.jobs = options.jobs != 0
+                      ? options.jobs
+                      : std::max(1u, std::thread::hardware_concurrency());
+
+    const fs::path cacheDir = options.cacheDir.empty()
+                                  ? root / ".nmc-cache"
+                                  : fs::path(options.cacheDir);
+    if (options.useCache) {
+        std::error_code ec;
+        fs::create_directories(cacheDir, ec);
+    }
+
+    // Stage 1: discover, read and hash sources; probe the cache
+    auto stageStart = Clock::now();
+    std::vector<SourceFile> files;
+    for (const auto& entry : fs::recursive_directory_iterator(root)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".nms") {
+            SourceFile file;
+            file.path = entry.path();
+            file.displayName = fs::relative(entry.path(), root).generic_string();
+            files.push_back(std::move(file));
+        }
+    }
+    std::sort(files.begin(), files.end(),
+              [](const SourceFile& a, const SourceFile& b) {
+                  return a.displayName < b.displayName;
+              });
+    report.filesTotal = files.size();
+
+    if (files.empty()) {
+        return Result<CompiledScript>::error("No .nms files found in " +
+                                             options.projectDir);
+    }
+
+    parallelFor(files.size(), report.jobs, [&](usize i) {
+        SourceFile& file = files[i];
+        std::ifstream in(file.path, std::ios::binary);
+        if (!in.is_open()) {
+            file.errors.push_back("cannot open file");
+            return;
+        }
+        file.source.assign(std::istreambuf_iterator<char>(in),
+                           std::istreambuf_iterator<char>());
+        if (in.bad()) {
+            file.errors.push_back("cannot read file");
+            return;
+        }
+        file.sourceHash = fnv1aBytes(file.source.data(), file.source.size());
+        if (options.useCache) {
+            readCacheEntry(cachePathFor(cacheDir, file.displayName), file);
+        }
+    });
+    report.scanMs = elapsedMs(stageStart);
+
+    // Stage 2: lex + parse everything the cache could not supply
+    stageStart = Clock::now();
+    auto parseWhere = [&](auto&& predicate) {
+        std::vector<SourceFile*> todo;
+        for (auto& file : files) {
+            if (predicate(file)) {
+                todo.push_back(&file);
+            }
+        }
+        parallelFor(todo.size(), report.jobs,
+                    [&](usize i) { runFrontend(*todo[i]); });
+    };
+    parseWhere([](const SourceFile& file) {
+        return !file.fromCache && file.errors.empty();
+    });
+
+    // The symbol fingerprint covers every definition in the project: a
+    // cached unit validated against a different symbol set must be redone
+    std::set<std::string> allCharacters;
+    std::set<std::string> allScenes;
+    for (const auto& file : files) {
+        allCharacters.insert(file.characters.begin(), file.characters.end());
+        allScenes.insert(file.scenes.begin(), file.scenes.end());
+    }
+    u64 fingerprint = fnv1a(std::string("characters"));
+    for (const auto& name : allCharacters) {
+        fingerprint = fnv1a(name, fingerprint);
+    }
+    fingerprint = fnv1a(std::string("scenes"), fingerprint);
+    for (const auto& name : allScenes) {
+        fingerprint = fnv1a(name, fingerprint);
+    }
+
+    parseWhere([fingerprint](SourceFile& file) {
+        if (file.fromCache && file.cachedFingerprint != fingerprint) {
+            file.fromCache = false;
+            file.unit.reset();
+            file.warnings.clear();
+            return true;
+        }
+        return false;
+    });
+    report.frontendMs = elapsedMs(stageStart);
+
+    // Stage 3: validate + compile each parsed file, refresh its cache entry
+    stageStart = Clock::now();
+    std::vector<SourceFile*> toCompile;
+    for (auto& file : files) {
+        if (!file.fromCache && file.program) {
+            toCompile.push_back(&file);
+        }
+    }
+    parallelFor(toCompile.size(), report.jobs, [&](usize i) {
+        SourceFile& file = *toCompile[i];
+        runBackend(file, allCharacters, allScenes);
+        if (file.unit && options.useCache) {
+            writeCacheEntry(cachePathFor(cacheDir, file.displayName), file,
+                            fingerprint);
+        }
+    });
+    report.backendMs = elapsedMs(stageStart);
+
+    for (const auto& file : files) {
+        if (file.fromCache) {
+            ++report.filesCached;
+        } else {
+            ++report.filesCompiled;
+        }
+        for (const auto& err : file.errors) {
+            report.errors.push_back(file.displayName + ": " + err);
+        }
+        for (const auto& warn : file.warnings) {
+            report.warnings.push_back(file.displayName + ": " + warn);
+        }
+    }
+    if (!report.errors.empty()) {
+        return Result<CompiledScript>::error(report.errors.front());
+    }
+
+    // Stage 4: link in path order
+    stageStart = Clock::now();
+    std::vector<const CompiledScript*> units;
+    std::vector<std::string> names;
+    for (const auto& file : files) {
+        units.push_back(&*file.unit);
+        names.push_back(file.displayName);
+    }
+
+    ScriptLinker linker;
+    auto linked = linker.link(units, names);
+    report.linkMs = elapsedMs(stageStart);
+
+    if (!linked.isOk()) {
+        report.errors.insert(report.errors.end(), linker.getErrors().begin(),
+                             linker.getErrors().end());
+    }
+    return linked;
+}
+
+} // namespace nmc
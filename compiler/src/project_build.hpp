@@ -0,0 +1,53 @@
+#pragma once
+
+/**
+ * @file project_build.hpp
+ * @brief Multi-file project compilation for nmc (--project)
+ *
+ * Every .nms file under the project directory is compiled as its own unit:
+ * lexing, parsing, validation and code generation run in parallel on a
+ * fixed pool of worker threads. Units are cached on disk keyed by a hash of
+ * the file contents and of the project-wide symbol set, so unchanged files
+ * are not recompiled. A final ScriptLinker step merges the units and
+ * resolves cross-file goto targets into one CompiledScript.
+ */
+
+#include "NovelMind/core/result.hpp"
+#include "NovelMind/core/types.hpp"
+#include "NovelMind/scripting/compiler.hpp"
+#include <string>
+#include <vector>
+
+namespace nmc {
+
+struct ProjectBuildOptions {
+    std::string projectDir;
+    std::string cacheDir;        // Default: <projectDir>/.nmc-cache
+    unsigned jobs = 0;           // 0 = hardware concurrency
+    bool useCache = true;
+};
+
+struct ProjectBuildReport {
+    NovelMind::usize filesTotal = 0;
+    NovelMind::usize filesCached = 0;
+    NovelMind::usize filesCompiled = 0;
+    unsigned jobs = 0;
+
+    // Wall-clock milliseconds per stage
+    double scanMs = 0.0;
+    double frontendMs = 0.0;   // Lex + parse
+    double backendMs = 0.0;    // Validate + compile + cache write
+    double linkMs = 0.0;
+
+    // "file: message" diagnostics in file order
+    std::vector<std::string> errors;
+    std::vector<std::string> warnings;
+};
+
+/**
+ * @brief Compile and link every script in a project directory
+ */
+NovelMind::Result<NovelMind::scripting::CompiledScript>
+buildProject(const ProjectBuildOptions& options, ProjectBuildReport& report);
+
+} // namespace nmc
@@ -215,6 +215,9 @@ void EditorRuntimeHost::stepFrame() {
     if (m_scriptRuntime) {
       m_scriptRuntime->update(frameTime);
     }
+    if (m_resourceManager) {
+      m_resourceManager->update();
+    }
     if (m_sceneGraph) {
       m_sceneGraph->update(frameTime);
     }
@@ -290,6 +293,11 @@ void EditorRuntimeHost::update(f64 deltaTime) {
     }
   }
 
+  // Finish loads started by the runtime and the prefetcher
+  if (m_resourceManager) {
+    m_resourceManager->update();
+  }
+
   // Update scene graph
   if (m_sceneGraph) {
     m_sceneGraph->update(deltaTime);
@@ -134,9 +134,9 @@ Result<void> EditorRuntimeHost::initializeRuntime() {
   m_audioManager = std::make_unique<audio::AudioManager>();
   m_audioManager->setDataProvider([this](const std::string &id) {
     if (!m_resourceManager) {
-      return Result<std::vector<u8>>::error("Resource manager unavailable");
+      return Result<SharedBuffer>::error("Resource manager unavailable");
     }
-    return m_resourceManager->readData(id);
+    return m_resourceManager->readShared(id);
   });
   m_audioManager->initialize();
 
@@ -150,12 +150,17 @@ Result<void> EditorRuntimeHost::initializeRuntime() {
   // Create script runtime
   m_scriptRuntime = std::make_unique<scripting::ScriptRuntime>();
 
+  // Shown assets load (and upcoming ones prefetch) through the same
+  // manager the scene graph draws from; prefetched audio is served to the
+  // audio manager's data provider above
+  m_scriptRuntime->setResourceManager(m_resourceManager.get());
+  m_scriptRuntime->setAudioManager(m_audioManager.get());
+
   // Connect runtime to scene components
   // Note: In a full implementation, we would also connect:
   // - SceneManager
   // - DialogueBox
   // - ChoiceMenu
-  // - AudioManager
 
   // Set up event callback
   m_scriptRuntime->setEventCallback(
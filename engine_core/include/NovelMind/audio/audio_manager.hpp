@@ -15,6 +15,7 @@
  */
 
 #include "NovelMind/core/result.hpp"
+#include "NovelMind/core/shared_buffer.hpp"
 #include "NovelMind/core/types.hpp"
 #include <functional>
 #include <memory>
@@ -186,7 +187,7 @@ private:
 
   std::unique_ptr<ma_sound> m_sound;
   bool m_soundReady = false;
-  std::vector<u8> m_memoryData;
+  SharedBuffer m_memoryData; // Read by the decoder while it plays
   std::unique_ptr<ma_decoder> m_decoder;
   bool m_decoderReady = false;
 };
@@ -197,7 +198,7 @@ private:
 class AudioManager {
 public:
   using DataProvider =
-      std::function<Result<std::vector<u8>>(const std::string &id)>;
+      std::function<Result<SharedBuffer>(const std::string &id)>;
   AudioManager();
   ~AudioManager();
 
@@ -407,6 +408,14 @@ public:
    */
   [[nodiscard]] size_t getActiveSourceCount() const;
 
+  /**
+   * @brief Restart every playing source of @p trackId with fresh data
+   *
+   * For hot reload: handles and settings are kept, playback starts over.
+   * @return Number of sources restarted
+   */
+  size_t reloadTrack(const std::string &trackId);
+
   // =========================================================================
   // Callbacks
   // =========================================================================
@@ -439,6 +448,9 @@ public:
 
 private:
   AudioHandle createSource(const std::string &trackId, AudioChannel channel);
+  // Decode source.trackId into a new ma_sound; false if that fails
+  bool openSound(AudioSource &source);
+  void closeSound(AudioSource &source);
   void releaseSource(AudioHandle handle);
   void fireEvent(AudioEvent::Type type, AudioHandle handle,
                  const std::string &trackId = "");
@@ -12,7 +12,7 @@
 #include "NovelMind/save/save_manager.hpp"
 #include "NovelMind/scene/scene_graph.hpp"
 #include "NovelMind/audio/audio_manager.hpp"
-#include "NovelMind/vfs/virtual_fs.hpp"
+#include "NovelMind/vfs/layered_file_system.hpp"
 #include <memory>
 #include <string>
 
@@ -22,6 +22,12 @@ struct EngineConfig {
   platform::WindowConfig window;
   std::string packFile;
   std::string startScene;
+  /// Development: loose assets here shadow the pack and reload on save
+  std::string watchDirectory;
+  /// Keep decoded textures and font atlases here across runs; empty = off
+  std::string decodedCacheDirectory;
+  /// Auto falls back to the software renderer if OpenGL fails to start
+  renderer::RendererBackend renderer = renderer::RendererBackend::Auto;
   bool debug = false;
 };
 
@@ -62,14 +68,18 @@ protected:
 
 private:
   void mainLoop();
+  void pollAssetChanges();
 
   bool m_running;
   EngineConfig m_config;
 
   std::unique_ptr<platform::IWindow> m_window;
   std::unique_ptr<platform::IFileSystem> m_fileSystem;
-  std::unique_ptr<vfs::IVirtualFileSystem> m_vfs;
+  std::unique_ptr<vfs::LayeredFileSystem> m_vfs;
+  VFS::OverlayBackend *m_assetOverlay = nullptr; // Owned by m_vfs
   std::unique_ptr<renderer::IRenderer> m_renderer;
+  // Declared before m_resources so it outlives the loaders that use it
+  std::unique_ptr<resource::DecodedAssetCache> m_decodedCache;
   std::unique_ptr<resource::ResourceManager> m_resources;
   std::unique_ptr<scene::SceneGraph> m_sceneGraph;
   std::unique_ptr<input::InputManager> m_input;
@@ -0,0 +1,77 @@
+#pragma once
+
+/**
+ * @file arena.hpp
+ * @brief Bump allocator for short-lived, bulk-freed data
+ *
+ * Memory is carved from large blocks and released all at once when the
+ * arena is reset or destroyed. Nothing allocated here has its destructor
+ * run, so only trivially destructible data (characters, PODs) belongs in
+ * an arena. Typical use is one arena per compile job.
+ */
+
+#include "NovelMind/core/types.hpp"
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace NovelMind::core {
+
+class Arena {
+public:
+  static constexpr usize DefaultBlockSize = 64 * 1024;
+
+  explicit Arena(usize blockSize = DefaultBlockSize);
+  ~Arena() = default;
+
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+  Arena(Arena &&) noexcept = default;
+  Arena &operator=(Arena &&) noexcept = default;
+
+  /**
+   * @brief Allocate uninitialized storage
+   * @param alignment Must be a power of two
+   */
+  [[nodiscard]] void *allocate(usize size,
+                               usize alignment = alignof(std::max_align_t));
+
+  /**
+   * @brief Allocate storage for @p count characters
+   */
+  [[nodiscard]] char *allocateChars(usize count) {
+    return static_cast<char *>(allocate(count, 1));
+  }
+
+  /**
+   * @brief Copy a string into the arena; the view lives as long as the arena
+   */
+  [[nodiscard]] std::string_view copyString(std::string_view str);
+
+  /**
+   * @brief Release everything, keeping the first block for reuse
+   */
+  void reset();
+
+  /// Bytes handed out since construction or the last reset()
+  [[nodiscard]] usize bytesUsed() const { return m_bytesUsed; }
+
+  /// Number of heap blocks currently owned
+  [[nodiscard]] usize blockCount() const { return m_blocks.size(); }
+
+private:
+  struct Block {
+    std::unique_ptr<std::byte[]> data;
+    usize size = 0;
+  };
+
+  void addBlock(usize minSize);
+
+  std::vector<Block> m_blocks;
+  usize m_blockSize;
+  usize m_offset = 0; // Into m_blocks.back()
+  usize m_bytesUsed = 0;
+};
+
+} // namespace NovelMind::core
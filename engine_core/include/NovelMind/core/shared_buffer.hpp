@@ -0,0 +1,71 @@
+#pragma once
+
+/**
+ * @file shared_buffer.hpp
+ * @brief Immutable, reference-counted byte range
+ *
+ * A SharedBuffer is a span plus a keepalive for whatever owns the bytes: a
+ * vector it adopted, a memory-mapped pack, or another buffer it was sliced
+ * from. Copies share the bytes, so resource data can pass from a pack
+ * through the caches to decoders without being copied.
+ */
+
+#include "NovelMind/core/types.hpp"
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace NovelMind {
+
+class SharedBuffer {
+public:
+  SharedBuffer() = default;
+
+  /// Adopt @p bytes without copying them
+  explicit SharedBuffer(std::vector<u8> bytes) {
+    auto owned = std::make_shared<const std::vector<u8>>(std::move(bytes));
+    m_bytes = std::span<const u8>(owned->data(), owned->size());
+    m_owner = std::move(owned);
+  }
+
+  /// View @p bytes, which stay valid as long as @p owner is alive
+  SharedBuffer(std::shared_ptr<const void> owner, std::span<const u8> bytes)
+      : m_owner(std::move(owner)), m_bytes(bytes) {}
+
+  [[nodiscard]] static SharedBuffer copyOf(std::span<const u8> bytes) {
+    return SharedBuffer(std::vector<u8>(bytes.begin(), bytes.end()));
+  }
+
+  [[nodiscard]] const u8 *data() const { return m_bytes.data(); }
+  [[nodiscard]] usize size() const { return m_bytes.size(); }
+  [[nodiscard]] bool empty() const { return m_bytes.empty(); }
+
+  // Also a contiguous range, so it converts to std::span<const u8>
+  [[nodiscard]] std::span<const u8> span() const { return m_bytes; }
+
+  [[nodiscard]] auto begin() const { return m_bytes.begin(); }
+  [[nodiscard]] auto end() const { return m_bytes.end(); }
+  [[nodiscard]] u8 operator[](usize index) const { return m_bytes[index]; }
+
+  /// Part of this buffer sharing its owner
+  [[nodiscard]] SharedBuffer slice(usize offset, usize length) const {
+    return SharedBuffer(m_owner, m_bytes.subspan(offset, length));
+  }
+
+  /// Owned copy, for APIs that need a mutable vector
+  [[nodiscard]] std::vector<u8> toVector() const {
+    return std::vector<u8>(m_bytes.begin(), m_bytes.end());
+  }
+
+  /// True if both refer to the same bytes (not merely equal contents)
+  [[nodiscard]] bool sharesWith(const SharedBuffer &other) const {
+    return m_bytes.data() == other.m_bytes.data() &&
+           m_bytes.size() == other.m_bytes.size();
+  }
+
+private:
+  std::shared_ptr<const void> m_owner;
+  std::span<const u8> m_bytes;
+};
+
+} // namespace NovelMind
@@ -0,0 +1,59 @@
+#pragma once
+
+/**
+ * @file mapped_file.hpp
+ * @brief Read-only memory mapping of a file
+ *
+ * Maps the whole file with mmap (POSIX) or a file mapping object (Windows).
+ * Where mapping is unavailable the file is read into an owned buffer in a
+ * single call, so callers always see one contiguous byte range.
+ */
+
+#include "NovelMind/core/result.hpp"
+#include "NovelMind/core/types.hpp"
+#include <span>
+#include <string>
+#include <vector>
+
+namespace NovelMind::platform {
+
+class MappedFile {
+public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  MappedFile(MappedFile &&other) noexcept;
+  MappedFile &operator=(MappedFile &&other) noexcept;
+
+  /**
+   * @brief Map a file read-only
+   */
+  [[nodiscard]] static Result<MappedFile> open(const std::string &path);
+
+  /**
+   * @brief Wrap an in-memory buffer (no file backing)
+   */
+  [[nodiscard]] static MappedFile fromBuffer(std::vector<u8> buffer);
+
+  [[nodiscard]] const u8 *data() const { return m_data; }
+  [[nodiscard]] usize size() const { return m_size; }
+  [[nodiscard]] std::span<const u8> bytes() const { return {m_data, m_size}; }
+  [[nodiscard]] bool empty() const { return m_size == 0; }
+
+  /**
+   * @brief True when the bytes come from an OS mapping, not a copy
+   */
+  [[nodiscard]] bool isMapped() const { return m_mapping != nullptr; }
+
+private:
+  void close();
+
+  const u8 *m_data = nullptr;
+  usize m_size = 0;
+  void *m_mapping = nullptr; // Base address (POSIX) or mapping handle (Win32)
+  std::vector<u8> m_buffer;  // Fallback storage when not mapped
+};
+
+} // namespace NovelMind::platform
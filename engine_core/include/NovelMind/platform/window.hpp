@@ -3,6 +3,7 @@
 #include "NovelMind/core/result.hpp"
 #include "NovelMind/core/types.hpp"
 #include <memory>
+#include <span>
 #include <string>
 
 namespace NovelMind::platform {
@@ -14,6 +15,7 @@ struct WindowConfig {
   bool fullscreen = false;
   bool resizable = true;
   bool vsync = true;
+  bool hidden = false; ///< Never shown, e.g. for offscreen smoke tests
 };
 
 class IWindow {
@@ -35,6 +37,16 @@ public:
   virtual void pollEvents() = 0;
   virtual void swapBuffers() = 0;
 
+  /**
+   * @brief Show a CPU-rendered RGBA8 frame (rows top first), scaled to fit
+   *
+   * For renderers without a GPU context. Not to be mixed with
+   * swapBuffers() on the same window.
+   * @return False if the frame could not be shown
+   */
+  virtual bool presentPixels(std::span<const u8> rgba, i32 width,
+                             i32 height) = 0;
+
   [[nodiscard]] virtual void *getNativeHandle() const = 0;
 };
 
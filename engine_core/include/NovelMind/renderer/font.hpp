@@ -1,9 +1,11 @@
 #pragma once
 
 #include "NovelMind/core/result.hpp"
+#include "NovelMind/core/shared_buffer.hpp"
 #include "NovelMind/core/types.hpp"
 #include "NovelMind/renderer/texture.hpp"
 #include "NovelMind/renderer/transform.hpp"
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -20,17 +22,22 @@ public:
   Font(Font &&other) noexcept;
   Font &operator=(Font &&other) noexcept;
 
+  /// FreeType reads the face lazily, so the font keeps @p data alive
+  Result<void> loadFromMemory(SharedBuffer data, i32 size);
   Result<void> loadFromMemory(const std::vector<u8> &data, i32 size);
   void destroy();
 
   [[nodiscard]] bool isValid() const;
   [[nodiscard]] i32 getSize() const;
   [[nodiscard]] void *getNativeHandle() const;
+  /// Source bytes the font was loaded from
+  [[nodiscard]] const SharedBuffer &getData() const { return m_data; }
 
 private:
   void *m_handle;
   void *m_library = nullptr;
   i32 m_size;
+  SharedBuffer m_data;
 };
 
 struct GlyphInfo {
@@ -42,6 +49,13 @@ struct GlyphInfo {
   Rect uv{};
 };
 
+/// CPU side of a FontAtlas: glyph metrics plus the RGBA8 atlas pixels
+struct FontAtlasImage {
+  ImageData image;
+  i32 lineHeight = 0;
+  std::unordered_map<char32_t, GlyphInfo> glyphs;
+};
+
 /**
  * @brief FontAtlas builds a texture atlas from a Font (FreeType-backed)
  *        to enable GPU text rendering and accurate metrics.
@@ -59,6 +73,13 @@ public:
   Result<void> build(const Font &font, const std::string &charset,
                      i32 padding = 1);
 
+  /// Rasterize without touching the GPU; build() is rasterize() + load()
+  [[nodiscard]] static Result<FontAtlasImage>
+  rasterize(const Font &font, const std::string &charset, i32 padding = 1);
+
+  /// Upload a rasterized (or cached) atlas
+  Result<void> load(const FontAtlasImage &atlas);
+
   [[nodiscard]] const GlyphInfo *getGlyph(char32_t codepoint) const;
   [[nodiscard]] const Texture &getAtlasTexture() const { return m_texture; }
   [[nodiscard]] bool isValid() const { return m_valid; }
@@ -76,4 +97,19 @@ private:
   bool m_valid = false;
 };
 
+/**
+ * @brief Printable-ASCII FontAtlas per Font, built on first use
+ *
+ * Keyed by the Font's address; a failed build is cached as an invalid
+ * atlas rather than retried every frame.
+ */
+class FontAtlasCache {
+public:
+  [[nodiscard]] std::shared_ptr<FontAtlas> get(const Font &font);
+  void clear() { m_atlases.clear(); }
+
+private:
+  std::unordered_map<const Font *, std::shared_ptr<FontAtlas>> m_atlases;
+};
+
 } // namespace NovelMind::renderer
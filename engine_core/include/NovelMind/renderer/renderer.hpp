@@ -14,6 +14,14 @@ namespace NovelMind::renderer {
 
 enum class BlendMode { None, Alpha, Additive, Multiply };
 
+/// Work submitted to the GPU, for the debug overlay
+struct RenderStats {
+  u32 quads = 0;     ///< Sprites, glyphs and rectangles drawn
+  u32 vertices = 0;  ///< Vertices uploaded
+  u32 batches = 0;   ///< Vertex buffer uploads
+  u32 drawCalls = 0; ///< One per run of quads sharing texture and blend mode
+};
+
 class IRenderer {
 public:
   virtual ~IRenderer() = default;
@@ -49,8 +57,29 @@ public:
 
   [[nodiscard]] virtual i32 getWidth() const = 0;
   [[nodiscard]] virtual i32 getHeight() const = 0;
+
+  /// Totals for the last finished frame
+  [[nodiscard]] virtual RenderStats getStats() const { return {}; }
+
+  /**
+   * @brief RGBA8 copy of the frame drawn so far, top row first
+   *
+   * Draws everything queued first. Call before endFrame(), which may
+   * discard the frame once it is shown.
+   */
+  [[nodiscard]] virtual Result<ImageData> captureFrame() {
+    return Result<ImageData>::error("Renderer cannot capture frames");
+  }
+};
+
+enum class RendererBackend : u8 {
+  Auto,     ///< OpenGL when built with it, otherwise Null
+  OpenGL,   ///< Falls back to Software when not built with OpenGL
+  Software, ///< CPU rasterizer, see software_renderer.hpp
+  Null      ///< Draws nothing
 };
 
-std::unique_ptr<IRenderer> createRenderer();
+std::unique_ptr<IRenderer>
+createRenderer(RendererBackend backend = RendererBackend::Auto);
 
 } // namespace NovelMind::renderer
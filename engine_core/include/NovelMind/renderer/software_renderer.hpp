@@ -0,0 +1,140 @@
+#pragma once
+
+/**
+ * @file software_renderer.hpp
+ * @brief CPU renderer drawing into an RGBA8 framebuffer
+ *
+ * Needs no GPU, so it renders on headless CI machines, backs golden-image
+ * tests of scenes and transitions, and stands in when OpenGL cannot be
+ * initialized. Quads go through the same SpriteBatch as the GL renderer
+ * and are rasterized at pixel centres with nearest-neighbour sampling.
+ * Initialized with a window, each endFrame() presents the framebuffer
+ * through IWindow::presentPixels().
+ *
+ * The framebuffer is split into square tiles that threads rasterize
+ * independently, each in submission order. The threads are started once
+ * by initialize() and reused for every flush. Blending uses the same integer
+ * arithmetic in its AVX2, SSE2 and scalar forms, so the output is
+ * bit-identical whatever the thread count or instruction set.
+ *
+ * Textures must keep their pixels on the CPU (Texture::getPixels()), which
+ * they do whenever no GPU texture was created.
+ *
+ * Example usage:
+ * @code
+ * SoftwareRenderer renderer;
+ * renderer.initialize(1280, 720);
+ * renderer.beginFrame();
+ * sceneGraph.render(renderer);
+ * renderer.endFrame();
+ * renderer.savePng("frame.png");
+ * @endcode
+ */
+
+#include "NovelMind/core/result.hpp"
+#include "NovelMind/core/types.hpp"
+#include "NovelMind/renderer/renderer.hpp"
+#include "NovelMind/renderer/sprite_batch.hpp"
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace NovelMind::renderer {
+
+enum class SimdLevel : u8 { Scalar, SSE2, AVX2 };
+
+struct SoftwareRendererConfig {
+  unsigned threads = 0; ///< Raster threads; 0 uses every hardware thread
+  u32 tileSize = 64;    ///< Tile edge in pixels
+  /// Blend implementation; the best one the CPU supports by default
+  std::optional<SimdLevel> simd;
+};
+
+class SoftwareRenderer : public IRenderer {
+public:
+  explicit SoftwareRenderer(SoftwareRendererConfig config = {});
+  ~SoftwareRenderer() override;
+
+  Result<void> initialize(platform::IWindow &window) override;
+  /// Allocate a @p width x @p height framebuffer without a window
+  Result<void> initialize(i32 width, i32 height);
+  void shutdown() override;
+
+  void beginFrame() override;
+  void endFrame() override;
+
+  void clear(const Color &color) override;
+  void setBlendMode(BlendMode mode) override;
+
+  void drawSprite(const Texture &texture, const Transform2D &transform,
+                  const Color &tint = Color::White) override;
+  void drawSprite(const Texture &texture, const Rect &sourceRect,
+                  const Transform2D &transform,
+                  const Color &tint = Color::White) override;
+
+  void drawRect(const Rect &rect, const Color &color) override;
+  void fillRect(const Rect &rect, const Color &color) override;
+
+  void drawText(const Font &font, const std::string &text, f32 x, f32 y,
+                const Color &color = Color::White) override;
+  /// drawText() with an atlas built elsewhere
+  void drawText(const FontAtlas &atlas, const std::string &text, f32 x,
+                f32 y, const Color &color = Color::White);
+
+  void setFade(f32 alpha, const Color &color = Color::Black) override;
+
+  [[nodiscard]] i32 getWidth() const override { return m_width; }
+  [[nodiscard]] i32 getHeight() const override { return m_height; }
+  [[nodiscard]] RenderStats getStats() const override { return m_lastStats; }
+  [[nodiscard]] Result<ImageData> captureFrame() override;
+
+  /// Rasterize everything queued so far
+  void flush();
+
+  /// RGBA8 rows, top first; complete after endFrame() or flush()
+  [[nodiscard]] std::span<const u8> pixels() const { return m_framebuffer; }
+  [[nodiscard]] Color pixelAt(i32 x, i32 y) const;
+
+  [[nodiscard]] SimdLevel simdLevel() const { return m_simd; }
+  [[nodiscard]] unsigned threadCount() const { return m_threads; }
+  /// Widest blend implementation this CPU runs
+  [[nodiscard]] static SimdLevel bestSimdLevel();
+
+  /// The framebuffer as a PNG file image
+  [[nodiscard]] std::vector<u8> encodePng() const;
+  Result<void> savePng(const std::string &path) const;
+
+private:
+  struct QuadSetup;
+  class WorkerPool;
+
+  void rasterize(std::span<const SpriteVertex> vertices,
+                 std::span<const SpriteDrawCommand> commands);
+  void rasterizeTile(u32 tile);
+
+  SoftwareRendererConfig m_config;
+  SimdLevel m_simd = SimdLevel::Scalar;
+  unsigned m_threads = 1;
+  std::unique_ptr<WorkerPool> m_pool; // m_threads - 1 helpers, if any
+  platform::IWindow *m_window = nullptr;
+  bool m_warnedPresent = false;
+
+  i32 m_width = 0;
+  i32 m_height = 0;
+  std::vector<u8> m_framebuffer;
+
+  SpriteBatch m_batch;
+  RenderStats m_lastStats;
+  FontAtlasCache m_fontAtlases;
+
+  // Per flush: quad setups, and the quads touching each tile in order
+  std::vector<QuadSetup> m_quads;
+  std::vector<std::vector<u32>> m_tileQuads;
+  u32 m_tilesX = 0;
+  u32 m_tilesY = 0;
+  bool m_warnedGpuTexture = false;
+};
+
+} // namespace NovelMind::renderer
@@ -0,0 +1,164 @@
+#pragma once
+
+/**
+ * @file sprite_batch.hpp
+ * @brief Collects textured and solid quads into few draw calls
+ *
+ * Quads are transformed on the CPU into one vertex array and grouped into
+ * runs that share a texture and blend mode; each run is one draw call.
+ * A quad may join an earlier run with its state as long as it overlaps
+ * nothing drawn since, so the frame looks exactly as if every quad had
+ * been drawn in submission order. Interleaved text and sprites therefore
+ * collapse into one run per texture.
+ *
+ * The backend receives the vertices and runs in a flush callback: when the
+ * batch is full and on flush(). Quads use four vertices each, indexed as
+ * two triangles by quadIndices().
+ *
+ * Example usage:
+ * @code
+ * SpriteBatch batch;
+ * batch.setFlushCallback([](auto vertices, auto commands) { ... });
+ * batch.draw(texture, source, transform, Color::White);
+ * batch.fill(Rect{0, 500, 1280, 220}, Color(0, 0, 0, 160));
+ * batch.flush();
+ * @endcode
+ */
+
+#include "NovelMind/core/types.hpp"
+#include "NovelMind/renderer/renderer.hpp"
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace NovelMind::renderer {
+
+struct SpriteVertex {
+  f32 x;
+  f32 y;
+  f32 u;
+  f32 v;
+  u8 r;
+  u8 g;
+  u8 b;
+  u8 a;
+};
+
+/**
+ * @brief What a draw call needs of a Texture
+ *
+ * Copied when the quad is queued, so the Texture object itself may move
+ * or be destroyed before the flush. Its GL name or pixel storage must
+ * still exist then, as with any texture drawn in the current frame.
+ */
+struct SpriteTexture {
+  void *handle = nullptr;     ///< Texture::getNativeHandle()
+  const u8 *pixels = nullptr; ///< Texture::getPixels() of a CPU texture
+  i32 width = 0;
+  i32 height = 0;
+
+  [[nodiscard]] static SpriteTexture of(const Texture &texture);
+
+  /// False for solid colour
+  explicit operator bool() const { return handle || pixels; }
+  bool operator==(const SpriteTexture &other) const {
+    return handle == other.handle && pixels == other.pixels;
+  }
+};
+
+/// One draw call: @p quadCount quads starting at quad @p firstQuad
+struct SpriteDrawCommand {
+  SpriteTexture texture; ///< Empty for solid colour
+  BlendMode blend = BlendMode::Alpha;
+  u32 firstQuad = 0;
+  u32 quadCount = 0;
+};
+
+struct SpriteBatchConfig {
+  /// Quads per flush; at most 16384 so 16-bit indices suffice
+  u32 maxQuads = 4096;
+  /// Earlier runs a quad is checked against for joining
+  u32 lookback = 16;
+};
+
+class SpriteBatch {
+public:
+  using FlushCallback =
+      std::function<void(std::span<const SpriteVertex> vertices,
+                          std::span<const SpriteDrawCommand> commands)>;
+
+  explicit SpriteBatch(SpriteBatchConfig config = {});
+
+  void setFlushCallback(FlushCallback callback) {
+    m_onFlush = std::move(callback);
+  }
+
+  [[nodiscard]] const SpriteBatchConfig &config() const { return m_config; }
+
+  /// Blend mode of quads added from now on
+  void setBlendMode(BlendMode mode) { m_blend = mode; }
+  [[nodiscard]] BlendMode blendMode() const { return m_blend; }
+
+  /**
+   * @brief Queue @p source of @p texture, placed like the immediate-mode
+   * renderer did: anchor, scale, rotate (degrees), then translate
+   */
+  void draw(const Texture &texture, const Rect &source,
+            const Transform2D &transform, const Color &tint);
+
+  /// Queue a solid rectangle
+  void fill(const Rect &rect, const Color &color);
+
+  /// Queue a one-pixel outline just inside @p rect
+  void outline(const Rect &rect, const Color &color);
+
+  /**
+   * @brief Queue one glyph per character of @p text
+   *
+   * @p y is the top of the first line and '\n' starts the next one.
+   * Characters missing from @p atlas advance the pen by @p missingAdvance.
+   */
+  void drawText(const FontAtlas &atlas, const std::string &text, f32 x,
+                f32 y, const Color &color, f32 missingAdvance = 0.0f);
+
+  /// Hand everything queued to the flush callback
+  void flush();
+
+  [[nodiscard]] u32 pendingQuads() const { return m_pendingQuads; }
+
+  /// Totals since the last resetStats()
+  [[nodiscard]] const RenderStats &stats() const { return m_stats; }
+  void resetStats() { m_stats = {}; }
+
+  /// Indices drawing @p quads quads as triangle pairs
+  [[nodiscard]] static std::vector<u16> quadIndices(u32 quads);
+
+private:
+  struct Run {
+    SpriteTexture texture;
+    BlendMode blend = BlendMode::Alpha;
+    f32 minX = 0.0f;
+    f32 minY = 0.0f;
+    f32 maxX = 0.0f;
+    f32 maxY = 0.0f;
+    std::vector<SpriteVertex> vertices;
+  };
+
+  void push(const SpriteTexture &texture, const SpriteVertex (&quad)[4]);
+
+  SpriteBatchConfig m_config;
+  FlushCallback m_onFlush;
+  BlendMode m_blend = BlendMode::Alpha;
+
+  // Runs are reused between flushes to keep their vertex capacity
+  std::vector<Run> m_runs;
+  usize m_activeRuns = 0;
+  u32 m_pendingQuads = 0;
+
+  std::vector<SpriteVertex> m_vertices;
+  std::vector<SpriteDrawCommand> m_commands;
+  RenderStats m_stats;
+};
+
+} // namespace NovelMind::renderer
@@ -2,10 +2,18 @@
 
 #include "NovelMind/core/result.hpp"
 #include "NovelMind/core/types.hpp"
+#include <span>
 #include <vector>
 
 namespace NovelMind::renderer {
 
+// RGBA8 pixels decoded on the CPU, ready for Texture::loadFromRGBA
+struct ImageData {
+  i32 width = 0;
+  i32 height = 0;
+  std::vector<u8> pixels;
+};
+
 class Texture {
 public:
   Texture();
@@ -16,19 +24,29 @@ public:
   Texture(Texture &&other) noexcept;
   Texture &operator=(Texture &&other) noexcept;
 
-  Result<void> loadFromMemory(const std::vector<u8> &data);
+  Result<void> loadFromMemory(std::span<const u8> data);
   Result<void> loadFromRGBA(const u8 *pixels, i32 width, i32 height);
+  Result<void> loadFromImage(const ImageData &image);
   void destroy();
 
+  // Decodes without touching the GPU; safe on worker threads
+  [[nodiscard]] static Result<ImageData>
+  decodeImage(std::span<const u8> data);
+
   [[nodiscard]] bool isValid() const;
   [[nodiscard]] i32 getWidth() const;
   [[nodiscard]] i32 getHeight() const;
   [[nodiscard]] void *getNativeHandle() const;
 
+  // RGBA8 pixels, kept only when no GPU texture was created (software
+  // rendering); empty otherwise
+  [[nodiscard]] std::span<const u8> getPixels() const { return m_pixels; }
+
 private:
   void *m_handle;
   i32 m_width;
   i32 m_height;
+  std::vector<u8> m_pixels;
 };
 
 } // namespace NovelMind::renderer
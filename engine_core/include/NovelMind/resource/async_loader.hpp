@@ -0,0 +1,315 @@
+#pragma once
+
+/**
+ * @file async_loader.hpp
+ * @brief Background resource loading with priorities and a main-thread
+ *        upload stage
+ *
+ * A request runs in two stages. Read and decode run on a worker pool;
+ * an optional finish step (GPU upload, anything bound to the render
+ * context) runs on the owning thread inside processUploads(), which stops
+ * once its per-frame time budget is spent. Immediate requests are always
+ * finished in the frame they become ready.
+ *
+ * Requests are observed through LoadHandle, which resolves to Ready,
+ * Failed or Cancelled. wait() completes a request on the calling thread
+ * so synchronous callers never depend on the frame loop.
+ */
+
+#include "NovelMind/core/result.hpp"
+#include "NovelMind/core/shared_buffer.hpp"
+#include "NovelMind/core/types.hpp"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace NovelMind::resource {
+
+/// Scheduling class, highest first
+enum class LoadPriority : u8 {
+  Immediate = 0, ///< Needed this frame (a sprite being shown now)
+  NextLine = 1,  ///< Needed after the current line of dialogue
+  Prefetch = 2   ///< Speculative; may never be used
+};
+
+enum class LoadStatus : u8 { Pending, Ready, Failed, Cancelled };
+
+struct AsyncLoaderConfig {
+  unsigned workerThreads = 2; ///< 0 = decode inside processUploads()
+  f64 uploadBudgetMs = 2.0;   ///< Per processUploads() call
+};
+
+namespace detail {
+
+/// Shared state of one request; owned by the loader and its handles
+struct LoadState {
+  enum Stage : u8 { Queued, Decoding, AwaitingFinish, Finishing, Done };
+
+  using Decoder = std::function<Result<std::shared_ptr<void>>(
+      const SharedBuffer &bytes)>;
+  using Finisher = std::function<Result<std::shared_ptr<void>>(
+      std::shared_ptr<void> decoded)>;
+  using Task = std::function<Result<std::shared_ptr<void>>()>;
+
+  std::string id;
+  Decoder decode;
+  Finisher finish;
+  Task task; ///< Replaces read and decode when set
+
+  std::atomic<LoadPriority> priority{LoadPriority::Prefetch};
+  std::atomic<LoadStatus> status{LoadStatus::Pending};
+  std::atomic<bool> cancelRequested{false};
+
+  // Guarded by the loader mutex until status leaves Pending
+  Stage stage = Queued;
+  std::shared_ptr<void> value;
+  std::string error;
+};
+
+} // namespace detail
+
+/**
+ * @brief Observer of one asynchronous load
+ *
+ * Copies share the request. Dropping every handle does not cancel it; use
+ * cancel() for that.
+ */
+template <typename T> class LoadHandle {
+public:
+  LoadHandle() = default;
+  explicit LoadHandle(std::shared_ptr<detail::LoadState> state)
+      : m_state(std::move(state)) {}
+
+  [[nodiscard]] bool isValid() const { return m_state != nullptr; }
+
+  [[nodiscard]] LoadStatus status() const {
+    return m_state ? m_state->status.load(std::memory_order_acquire)
+                   : LoadStatus::Failed;
+  }
+  [[nodiscard]] bool isReady() const { return status() == LoadStatus::Ready; }
+  [[nodiscard]] bool isDone() const { return status() != LoadStatus::Pending; }
+
+  /// The loaded object once Ready, otherwise null
+  [[nodiscard]] std::shared_ptr<T> get() const {
+    return isReady() ? std::static_pointer_cast<T>(m_state->value) : nullptr;
+  }
+
+  /// Failure reason once Failed
+  [[nodiscard]] std::string error() const {
+    return status() == LoadStatus::Failed ? m_state->error : std::string{};
+  }
+
+  [[nodiscard]] const std::string &id() const { return m_state->id; }
+
+  /// Stop the load at its next stage boundary; no effect once done
+  void cancel() const {
+    if (m_state) {
+      m_state->cancelRequested.store(true, std::memory_order_release);
+    }
+  }
+
+  [[nodiscard]] const std::shared_ptr<detail::LoadState> &state() const {
+    return m_state;
+  }
+
+private:
+  std::shared_ptr<detail::LoadState> m_state;
+};
+
+class AsyncLoader {
+public:
+  /// Reads raw bytes for an id; called from worker threads
+  using ReadFn = std::function<Result<SharedBuffer>(const std::string &)>;
+
+  explicit AsyncLoader(ReadFn read, AsyncLoaderConfig config = {});
+  ~AsyncLoader();
+
+  AsyncLoader(const AsyncLoader &) = delete;
+  AsyncLoader &operator=(const AsyncLoader &) = delete;
+
+  /**
+   * @brief Queue a load of @p id
+   * @param decode Runs on a worker with the bytes read for @p id
+   * @param finish Optional; runs on the thread calling processUploads().
+   *        Required when Decoded differs from T.
+   */
+  template <typename T, typename Decoded = T>
+  LoadHandle<T> request(
+      const std::string &id, LoadPriority priority,
+      std::function<Result<std::shared_ptr<Decoded>>(const SharedBuffer &)>
+          decode,
+      std::function<Result<std::shared_ptr<T>>(std::shared_ptr<Decoded>)>
+          finish = {});
+
+  /// Handle that is already Ready with @p value (e.g. a cache hit)
+  template <typename T>
+  [[nodiscard]] static LoadHandle<T> resolved(std::shared_ptr<T> value);
+
+  /// Queue a read of @p id with no decode step; the bytes are not copied
+  LoadHandle<SharedBuffer> requestData(const std::string &id,
+                                       LoadPriority priority);
+
+  /**
+   * @brief Queue @p task in place of a read and decode
+   *
+   * For I/O that is not one resource, e.g. a batched read of several.
+   * @param id Names the request in errors and LoadHandle::id()
+   */
+  template <typename T>
+  LoadHandle<T> requestTask(const std::string &id, LoadPriority priority,
+                            std::function<Result<std::shared_ptr<T>>()> task);
+
+  /**
+   * @brief Move a queued request to another class (e.g. prefetch that is
+   *        now needed on screen)
+   */
+  void setPriority(const std::shared_ptr<detail::LoadState> &state,
+                   LoadPriority priority);
+
+  /**
+   * @brief Finish decoded requests on this thread
+   * @param budgetMs Overrides AsyncLoaderConfig::uploadBudgetMs when >= 0
+   * @return Number of requests that completed
+   */
+  usize processUploads(f64 budgetMs = -1.0);
+
+  /**
+   * @brief Complete @p state on the calling thread
+   *
+   * Runs read and decode here if no worker has started them, otherwise
+   * waits for the worker, then runs the finish step. Must be called from
+   * the thread that calls processUploads().
+   */
+  void wait(const std::shared_ptr<detail::LoadState> &state);
+
+  template <typename T>
+  Result<std::shared_ptr<T>> wait(const LoadHandle<T> &handle);
+
+  /// Cancel every request still queued; running decodes finish normally
+  void cancelAll();
+
+  /// Requests submitted but not yet completed
+  [[nodiscard]] usize pendingCount() const;
+
+  [[nodiscard]] const AsyncLoaderConfig &config() const { return m_config; }
+
+private:
+  using StatePtr = std::shared_ptr<detail::LoadState>;
+  using Queues = std::array<std::deque<StatePtr>, 3>;
+
+  std::shared_ptr<detail::LoadState>
+  submit(const std::string &id, LoadPriority priority,
+         detail::LoadState::Decoder decode,
+         detail::LoadState::Finisher finish);
+  StatePtr enqueue(StatePtr state, const std::string &id,
+                   LoadPriority priority);
+
+  void workerLoop();
+  StatePtr popQueued(Queues &queues, detail::LoadState::Stage stage);
+  // Read and decode, or the task that replaces them
+  Result<std::shared_ptr<void>> produce(const detail::LoadState &state);
+  void decodeJob(const StatePtr &state, bool onOwnerThread);
+  void finishJob(const StatePtr &state);
+  void complete(const StatePtr &state, LoadStatus status);
+
+  ReadFn m_read;
+  AsyncLoaderConfig m_config;
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_workAvailable;
+  std::condition_variable m_stageChanged;
+  Queues m_decodeQueue;
+  Queues m_finishQueue;
+  usize m_pending = 0;
+  std::atomic<bool> m_stopping{false};
+  std::vector<std::thread> m_workers;
+};
+
+template <typename T, typename Decoded>
+LoadHandle<T> AsyncLoader::request(
+    const std::string &id, LoadPriority priority,
+    std::function<Result<std::shared_ptr<Decoded>>(const SharedBuffer &)>
+        decode,
+    std::function<Result<std::shared_ptr<T>>(std::shared_ptr<Decoded>)>
+        finish) {
+  const bool missingFinish = !std::is_same_v<T, Decoded> && !finish;
+  detail::LoadState::Decoder erasedDecode =
+      [decode = std::move(decode), missingFinish](const SharedBuffer &bytes)
+      -> Result<std::shared_ptr<void>> {
+    if (missingFinish) {
+      return Result<std::shared_ptr<void>>::error(
+          "Decoded type needs a finish step");
+    }
+    auto result = decode(bytes);
+    if (result.isError()) {
+      return Result<std::shared_ptr<void>>::error(result.error());
+    }
+    return Result<std::shared_ptr<void>>::ok(std::move(result.value()));
+  };
+
+  detail::LoadState::Finisher erasedFinish;
+  if (finish) {
+    erasedFinish = [finish = std::move(finish)](std::shared_ptr<void> decoded)
+        -> Result<std::shared_ptr<void>> {
+      auto result =
+          finish(std::static_pointer_cast<Decoded>(std::move(decoded)));
+      if (result.isError()) {
+        return Result<std::shared_ptr<void>>::error(result.error());
+      }
+      return Result<std::shared_ptr<void>>::ok(std::move(result.value()));
+    };
+  }
+
+  return LoadHandle<T>(submit(id, priority, std::move(erasedDecode),
+                              std::move(erasedFinish)));
+}
+
+template <typename T>
+LoadHandle<T>
+AsyncLoader::requestTask(const std::string &id, LoadPriority priority,
+                         std::function<Result<std::shared_ptr<T>>()> task) {
+  auto state = std::make_shared<detail::LoadState>();
+  state->task = [task = std::move(task)]() -> Result<std::shared_ptr<void>> {
+    auto result = task();
+    if (result.isError()) {
+      return Result<std::shared_ptr<void>>::error(result.error());
+    }
+    return Result<std::shared_ptr<void>>::ok(std::move(result.value()));
+  };
+  return LoadHandle<T>(enqueue(std::move(state), id, priority));
+}
+
+template <typename T>
+LoadHandle<T> AsyncLoader::resolved(std::shared_ptr<T> value) {
+  auto state = std::make_shared<detail::LoadState>();
+  state->stage = detail::LoadState::Done;
+  state->value = std::move(value);
+  state->status.store(LoadStatus::Ready, std::memory_order_release);
+  return LoadHandle<T>(std::move(state));
+}
+
+template <typename T>
+Result<std::shared_ptr<T>> AsyncLoader::wait(const LoadHandle<T> &handle) {
+  if (!handle.isValid()) {
+    return Result<std::shared_ptr<T>>::error("Invalid load handle");
+  }
+  wait(handle.state());
+  switch (handle.status()) {
+  case LoadStatus::Ready:
+    return Result<std::shared_ptr<T>>::ok(handle.get());
+  case LoadStatus::Cancelled:
+    return Result<std::shared_ptr<T>>::error("Load cancelled: " + handle.id());
+  default:
+    return Result<std::shared_ptr<T>>::error(handle.error());
+  }
+}
+
+} // namespace NovelMind::resource
@@ -0,0 +1,153 @@
+#pragma once
+
+/**
+ * @file decoded_asset_cache.hpp
+ * @brief Persistent on-disk cache of decoded assets
+ *
+ * Decoded textures, rasterized font atlases and compiled scripts are kept
+ * in a cache directory between launches, so a warm start maps the result
+ * instead of decoding again. Each entry is one file:
+ *
+ * @code
+ * DecodedAssetHeader  // 64 bytes, see decoded_asset_cache.cpp
+ * u8 payload[]        // 16-byte aligned, format depends on the kind
+ * @endcode
+ *
+ * - Image: RGBA8 pixels, width and height in the header.
+ * - FontAtlas: glyph records, then the RGBA8 atlas pixels.
+ * - Script: an NMC2 image (compiled_script_image.hpp).
+ *
+ * Entries are keyed by kind, resource id, a variant string (e.g. font size
+ * and charset) and the checksum of the source bytes, and are only valid
+ * for the engine version that wrote them. A changed source or engine
+ * simply misses and is overwritten. Files are written to a temporary name
+ * and renamed, so a crash never leaves a torn entry.
+ *
+ * The directory is bounded by size; the least recently used entries are
+ * deleted first. Use times are kept in the files' modification times, so
+ * recency survives restarts.
+ *
+ * All members are thread-safe.
+ */
+
+#include "NovelMind/core/result.hpp"
+#include "NovelMind/core/shared_buffer.hpp"
+#include "NovelMind/core/types.hpp"
+#include "NovelMind/renderer/font.hpp"
+#include "NovelMind/scripting/compiler.hpp"
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace NovelMind::resource {
+
+/// Engine version as encoded in compiled scripts and cache entries
+inline constexpr u32 kEngineVersion =
+    (static_cast<u32>(NOVELMIND_VERSION_MAJOR) << 16) |
+    (static_cast<u32>(NOVELMIND_VERSION_MINOR) << 8) |
+    static_cast<u32>(NOVELMIND_VERSION_PATCH);
+
+enum class DecodedAssetKind : u32 { Image = 1, FontAtlas = 2, Script = 3 };
+
+struct DecodedAssetKey {
+  DecodedAssetKind kind = DecodedAssetKind::Image;
+  std::string id;
+  std::string variant;    ///< Decode parameters, e.g. "24:abc" for atlases
+  u32 sourceChecksum = 0; ///< CRC32 of the source bytes
+};
+
+struct DecodedAssetCacheConfig {
+  std::string directory;
+  usize maxBytes = 256 * 1024 * 1024;
+  u32 engineVersion = kEngineVersion;
+};
+
+struct DecodedAssetCacheStats {
+  usize hits = 0;
+  usize misses = 0;
+  usize stores = 0;
+  usize evictions = 0;
+  usize entryCount = 0;
+  usize totalBytes = 0;
+
+  [[nodiscard]] f64 hitRate() const {
+    const auto total = hits + misses;
+    return total > 0 ? static_cast<f64>(hits) / static_cast<f64>(total) : 0.0;
+  }
+};
+
+/// RGBA8 image whose pixels may live in a cache file mapping
+struct DecodedImage {
+  i32 width = 0;
+  i32 height = 0;
+  SharedBuffer pixels;
+};
+
+class DecodedAssetCache {
+public:
+  explicit DecodedAssetCache(DecodedAssetCacheConfig config);
+
+  DecodedAssetCache(const DecodedAssetCache &) = delete;
+  DecodedAssetCache &operator=(const DecodedAssetCache &) = delete;
+
+  /**
+   * @brief Create the directory if needed and index what it holds
+   *
+   * Trims the directory to the size budget. Lookups before open() miss.
+   */
+  Result<void> open();
+  [[nodiscard]] bool isOpen() const;
+
+  /// Payload of @p key, mapped from its file; nullopt on a miss
+  [[nodiscard]] std::optional<SharedBuffer> load(const DecodedAssetKey &key);
+  Result<void> store(const DecodedAssetKey &key, std::span<const u8> payload);
+
+  [[nodiscard]] std::optional<DecodedImage>
+  loadImage(const DecodedAssetKey &key);
+  Result<void> storeImage(const DecodedAssetKey &key,
+                          const DecodedImage &image);
+
+  [[nodiscard]] std::optional<renderer::FontAtlasImage>
+  loadFontAtlas(const DecodedAssetKey &key);
+  Result<void> storeFontAtlas(const DecodedAssetKey &key,
+                              const renderer::FontAtlasImage &atlas);
+
+  [[nodiscard]] std::optional<scripting::CompiledScript>
+  loadScript(const DecodedAssetKey &key);
+  Result<void> storeScript(const DecodedAssetKey &key,
+                           const scripting::CompiledScript &script);
+
+  /// Delete every entry
+  void clear();
+
+  [[nodiscard]] DecodedAssetCacheStats stats() const;
+  [[nodiscard]] const DecodedAssetCacheConfig &config() const {
+    return m_config;
+  }
+
+private:
+  struct Entry {
+    usize size = 0;
+    i64 lastUse = 0; // File modification time, in clock ticks
+  };
+
+  [[nodiscard]] std::optional<SharedBuffer>
+  loadEntry(const DecodedAssetKey &key, u32 (&meta)[4]);
+  Result<void> storeEntry(const DecodedAssetKey &key, const u32 (&meta)[4],
+                          std::span<const u8> first,
+                          std::span<const u8> second = {});
+  [[nodiscard]] std::string pathOf(const std::string &name) const;
+  void forget(const std::string &name);
+  // Caller holds m_mutex
+  void evictToFit();
+
+  DecodedAssetCacheConfig m_config;
+  mutable std::mutex m_mutex;
+  bool m_open = false;
+  std::unordered_map<std::string, Entry> m_entries; // By file name
+  usize m_totalBytes = 0;
+  DecodedAssetCacheStats m_stats;
+};
+
+} // namespace NovelMind::resource
@@ -3,9 +3,17 @@
 #include "NovelMind/core/result.hpp"
 #include "NovelMind/core/types.hpp"
 #include "NovelMind/renderer/font.hpp"
+#include "NovelMind/resource/async_loader.hpp"
+#include "NovelMind/resource/decoded_asset_cache.hpp"
 #include "NovelMind/renderer/texture.hpp"
 #include "NovelMind/vfs/virtual_fs.hpp"
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -15,6 +23,8 @@ namespace NovelMind::resource {
 using TextureHandle = std::shared_ptr<renderer::Texture>;
 using FontHandle = std::shared_ptr<renderer::Font>;
 using FontAtlasHandle = std::shared_ptr<renderer::FontAtlas>;
+using TextureLoadHandle = LoadHandle<renderer::Texture>;
+using DataLoadHandle = LoadHandle<SharedBuffer>;
 
 class ResourceManager {
 public:
@@ -27,9 +37,82 @@ public:
   void setVfs(vfs::IVirtualFileSystem *vfs);
   void setBasePath(const std::string &path);
 
+  /**
+   * @brief Reuse decoded textures and font atlases from @p cache
+   *
+   * Not owned and must outlive the manager; may be set or cleared while
+   * loader workers run. Entries are keyed by the checksum the VFS reports
+   * for a resource, or else by one computed from its bytes.
+   */
+  void setDecodedAssetCache(DecodedAssetCache *cache);
+
   [[nodiscard]] Result<TextureHandle> loadTexture(const std::string &id);
   void unloadTexture(const std::string &id);
 
+  /**
+   * @brief Read and decode on worker threads from now on
+   *
+   * Without this, requests are decoded inside update() on the calling
+   * thread and acquireTexture() loads synchronously. Pending requests of
+   * the previous loader are cancelled.
+   */
+  void enableAsyncLoading(const AsyncLoaderConfig &config = {});
+  [[nodiscard]] bool isAsyncLoadingEnabled() const;
+
+  /**
+   * @brief Start loading a texture; the handle resolves once it is
+   *        uploaded (by update() or a synchronous loadTexture())
+   */
+  TextureLoadHandle requestTexture(const std::string &id,
+                                   LoadPriority priority);
+
+  /**
+   * @brief Start reading raw resource bytes (audio, scripts, data)
+   *
+   * Once update() collects the result, readShared() and readData() serve
+   * the bytes from memory until unloadData(), reload() or clearCache().
+   */
+  DataLoadHandle requestData(const std::string &id, LoadPriority priority);
+
+  /// Forget bytes read by requestData(); a request in flight is cancelled
+  void unloadData(const std::string &id);
+
+  /**
+   * @brief Read @p ids into the file system cache in one batch on a loader
+   *        worker
+   *
+   * For assets needed soon, e.g. on entering a scene; loads that start
+   * after the batch then skip the read. Without workers, the batch runs
+   * in update(). See vfs::IVirtualFileSystem::preload().
+   * @return Resolves to the number of ids now cached
+   */
+  LoadHandle<usize> preload(std::span<const std::string> ids,
+                            LoadPriority priority = LoadPriority::Immediate);
+
+  /**
+   * @brief Texture for drawing this frame
+   *
+   * With async loading enabled, returns null while the texture is still
+   * loading (starting an immediate load if needed) instead of blocking.
+   */
+  [[nodiscard]] TextureHandle acquireTexture(const std::string &id);
+
+  /**
+   * @brief How long acquireTexture() gives up on a texture that failed
+   *
+   * After that it is requested again, so a file that was missing or
+   * broken shows up once it is fixed. Defaults to two seconds.
+   */
+  void setFailedTextureRetryDelay(f64 seconds);
+
+  /**
+   * @brief Finish pending uploads within the per-frame budget
+   * @return Number of requests completed
+   */
+  usize update(f64 budgetMs = -1.0);
+
+  [[nodiscard]] AsyncLoader &getLoader() { return *m_loader; }
+
   [[nodiscard]] Result<FontHandle> loadFont(const std::string &id, i32 size);
   void unloadFont(const std::string &id, i32 size);
 
@@ -40,18 +123,69 @@ public:
   [[nodiscard]] Result<std::vector<u8>>
   readData(const std::string &id) const;
 
+  /// readData() without a copy when the VFS can share its bytes
+  [[nodiscard]] Result<SharedBuffer>
+  readShared(const std::string &id) const;
+
   void clearCache();
 
+  /**
+   * @brief Load @p id again after its source changed
+   *
+   * Textures, fonts and font atlases already loaded from @p id are decoded
+   * again into the objects that were handed out, so holders see the new
+   * asset without asking for it again. A pending request for @p id is
+   * cancelled. If the new bytes cannot be read or decoded, the old objects
+   * stay as they were. Reload listeners hear of every call, so systems
+   * that keep their own copies (audio) can react.
+   * @return Number of loaded objects replaced
+   */
+  usize reload(const std::string &id);
+
+  /// reload() every loaded resource, e.g. after file changes were lost
+  usize reloadAll();
+
+  using ReloadListener = std::function<void(const std::string &id)>;
+  void addReloadListener(ReloadListener listener);
+
   [[nodiscard]] size_t getTextureCount() const;
+  /// Resources whose bytes requestData() left in memory
+  [[nodiscard]] size_t getDataCount() const;
   [[nodiscard]] size_t getFontCount() const;
   [[nodiscard]] size_t getFontAtlasCount() const;
 
 private:
-  Result<std::vector<u8>> readResource(const std::string &id) const;
+  Result<SharedBuffer> readResource(const std::string &id) const;
+  u32 sourceChecksum(const std::string &id, const SharedBuffer &bytes) const;
+  // Worker-safe; served by the decoded-asset cache when possible
+  Result<DecodedImage> decodeTexture(const std::string &id,
+                                     const SharedBuffer &bytes) const;
+  Result<void> buildFontAtlas(renderer::FontAtlas &atlas,
+                              const std::string &id,
+                              const renderer::Font &font, i32 size,
+                              const std::string &charset) const;
+  usize reloadFrom(const std::string &id, const SharedBuffer &bytes);
   std::string resolvePath(const std::string &id) const;
+  void collectTexture(const std::string &id, const TextureLoadHandle &handle);
+  void collectData(const std::string &id, const DataLoadHandle &handle);
 
   vfs::IVirtualFileSystem *m_vfs = nullptr;
   std::string m_basePath;
+  // Read by loader workers without m_sourceMutex
+  std::atomic<DecodedAssetCache *> m_decodedCache{nullptr};
+  // Guards m_vfs and m_basePath. Reads share it, so loader workers read
+  // in parallel; setVfs() and setBasePath() take it exclusively.
+  mutable std::shared_mutex m_sourceMutex;
+  std::unique_ptr<AsyncLoader> m_loader;
+  std::unordered_map<std::string, TextureLoadHandle> m_pendingTextures;
+  // Failed texture -> when acquireTexture() may request it again
+  std::unordered_map<std::string, std::chrono::steady_clock::time_point>
+      m_failedTextures;
+  std::chrono::steady_clock::duration m_failedRetryDelay =
+      std::chrono::seconds(2);
+  std::unordered_map<std::string, DataLoadHandle> m_pendingData;
+  std::unordered_map<std::string, SharedBuffer> m_data;
+  std::vector<ReloadListener> m_reloadListeners;
 
   std::unordered_map<std::string, TextureHandle> m_textures;
   std::unordered_map<std::string,
@@ -0,0 +1,181 @@
+#pragma once
+
+/**
+ * @file asset_prefetcher.hpp
+ * @brief Bytecode lookahead that starts loading assets before they are shown
+ *
+ * Every background, sprite, sound and music track a script uses is a
+ * string operand of SHOW_BACKGROUND, SHOW_CHARACTER, PLAY_SOUND or
+ * PLAY_MUSIC. AssetPrefetcher walks the control flow graph forward from the
+ * current instruction, following both sides of every conditional jump and
+ * therefore every option of a CHOICE, and stops each path after a fixed
+ * number of instructions. What it finds is requested through the
+ * ResourceManager: assets reachable before the next SAY, CHOICE or WAIT at
+ * NextLine priority, the rest at Prefetch. Assets that drop out of the
+ * window (the branch not taken) are cancelled if still queued.
+ * Sounds and music are read into the ResourceManager's data cache, which
+ * readShared() (and so the AudioManager data provider) serves from while
+ * they stay in the window.
+ *
+ * The runtime reports every asset it actually uses through recordUse(),
+ * which classifies it as a hit (already loaded), late (requested but still
+ * loading) or miss (never requested).
+ *
+ * Example usage:
+ * @code
+ * AssetPrefetcher prefetcher;
+ * prefetcher.setScript({vm.program(), vm.strings(), &script});
+ * prefetcher.setResourceManager(&resources);
+ * prefetcher.update(vm.getIP()); // after each VM slice
+ * @endcode
+ */
+
+#include "NovelMind/core/types.hpp"
+#include "NovelMind/resource/resource_manager.hpp"
+#include "NovelMind/scripting/compiler.hpp"
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace NovelMind::scripting {
+
+enum class PrefetchAssetKind : u8 { Background, Character, Sound, Music };
+
+/// One asset found ahead of the instruction pointer
+struct PrefetchTarget {
+  PrefetchAssetKind kind = PrefetchAssetKind::Background;
+  std::string id;      ///< Resource id (sprite id for characters)
+  u32 distance = 0;    ///< Instructions on the shortest path to the use
+  u32 waitsBefore = 0; ///< SAY/CHOICE/WAIT stops on that path
+};
+
+/**
+ * @brief What the prefetcher reads from a script
+ *
+ * Bytecode and strings are views, so a script that runs straight from a
+ * mapped image (VirtualMachine::program() and strings()) is scanned in
+ * place. Scenes, characters and unlinked scene jumps come from @p tables.
+ */
+struct PrefetchScript {
+  std::span<const Instruction> instructions;
+  std::span<const std::string_view> strings;
+  const CompiledScript *tables = nullptr;
+};
+
+struct PrefetchConfig {
+  /// Longest path followed from the current instruction; 0 disables
+  u32 instructionHorizon = 512;
+  /// Upper bound on assets kept in flight, nearest first
+  u32 maxTargets = 32;
+};
+
+struct PrefetchStats {
+  u64 scans = 0;
+  u64 requested = 0; ///< Loads started by the prefetcher
+  u64 hits = 0;      ///< Used assets that were already loaded
+  u64 late = 0;      ///< Used assets that were requested but still loading
+  u64 misses = 0;    ///< Used assets the prefetcher did not request
+  u64 dropped = 0;   ///< Requested assets that left the window unused
+
+  [[nodiscard]] f64 hitRate() const {
+    const u64 uses = hits + late + misses;
+    return uses == 0 ? 0.0 : static_cast<f64>(hits) / static_cast<f64>(uses);
+  }
+};
+
+class AssetPrefetcher {
+public:
+  AssetPrefetcher() = default;
+
+  /**
+   * @brief Assets reachable from @p ip within @p horizon instructions
+   *
+   * Each asset is reported once, at its shortest distance, ordered
+   * nearest first. Pure analysis: nothing is loaded.
+   */
+  [[nodiscard]] static std::vector<PrefetchTarget>
+  scan(const PrefetchScript &script, u32 ip, u32 horizon);
+  [[nodiscard]] static std::vector<PrefetchTarget>
+  scan(const CompiledScript &script, u32 ip, u32 horizon);
+
+  /**
+   * @brief Every asset the script uses, in the order a player meets them
+   *
+   * Assets reachable from the first instruction come first, nearest first,
+   * followed by those of scenes only entered from elsewhere, by entry
+   * point. Used to lay packs out in play order (vfs::PackWriter).
+   */
+  [[nodiscard]] static std::vector<std::string>
+  firstUseOrder(const CompiledScript &script);
+
+  /// The viewed script must outlive the prefetcher or be replaced first
+  void setScript(const PrefetchScript &script);
+  void setResourceManager(resource::ResourceManager *resources);
+  void setConfig(const PrefetchConfig &config);
+  [[nodiscard]] const PrefetchConfig &getConfig() const { return m_config; }
+
+  /**
+   * @brief Rescan from @p ip and adjust the requests in flight
+   *
+   * Cheap to call every frame: nothing happens while @p ip is unchanged.
+   */
+  void update(u32 ip);
+
+  /**
+   * @brief Batch-read the assets used before the first stop after @p ip
+   *
+   * Queued as one Immediate loader job, e.g. on a scene change, so the
+   * caller does not wait on disk. update() still requests and decodes the
+   * assets. A batch still queued from an earlier call is cancelled.
+   * @return Resolves to the number of assets read into the file system
+   *         cache; invalid without a script or resource manager
+   */
+  resource::LoadHandle<usize> preload(u32 ip);
+
+  /// Record that the runtime needs @p id now
+  void recordUse(PrefetchAssetKind kind, const std::string &id);
+
+  /// Cancel everything still queued and forget the window
+  void clear();
+
+  [[nodiscard]] const PrefetchStats &getStats() const { return m_stats; }
+  void resetStats() { m_stats = {}; }
+
+  /// Assets currently tracked (requested and still in the window)
+  [[nodiscard]] usize trackedCount() const { return m_tracked.size(); }
+
+private:
+  struct Tracked {
+    PrefetchAssetKind kind = PrefetchAssetKind::Background;
+    std::string id;
+    resource::TextureLoadHandle texture;
+    resource::DataLoadHandle data;
+    bool used = false;
+
+    [[nodiscard]] resource::LoadStatus status() const {
+      return texture.isValid() ? texture.status() : data.status();
+    }
+    [[nodiscard]] const std::shared_ptr<resource::detail::LoadState> &
+    state() const {
+      return texture.isValid() ? texture.state() : data.state();
+    }
+  };
+
+  static std::string keyOf(PrefetchAssetKind kind, const std::string &id);
+  void request(const PrefetchTarget &target, Tracked &tracked);
+  void release(Tracked &tracked);
+
+  PrefetchScript m_script;
+  resource::ResourceManager *m_resources = nullptr;
+  PrefetchConfig m_config;
+  PrefetchStats m_stats;
+
+  std::unordered_map<std::string, Tracked> m_tracked;
+  resource::LoadHandle<usize> m_preload;
+  u32 m_lastIp = 0;
+  bool m_scanned = false;
+};
+
+} // namespace NovelMind::scripting
@@ -6,11 +6,20 @@
  *
  * This module defines the AST node types used to represent
  * parsed NM Script programs.
+ *
+ * Expression and Statement nodes live in the AstArena owned by their
+ * Program, one chunked pool per node type. ExprPtr/StmtPtr name a node by
+ * its pool and 32-bit index within it, so a whole parse costs one heap
+ * block per 256 nodes and the tree is released in bulk with its Program.
+ * Identifiers, literals and child lists inside the nodes are still
+ * std::string and std::vector and allocate as before.
  */
 
 #include "NovelMind/core/types.hpp"
 #include "NovelMind/scripting/token.hpp"
+#include <cstddef>
 #include <memory>
+#include <new>
 #include <optional>
 #include <string>
 #include <variant>
@@ -21,9 +30,45 @@ namespace NovelMind::scripting {
 // Forward declarations
 struct Expression;
 struct Statement;
+template <typename T> class AstNodePool;
 
-using ExprPtr = std::unique_ptr<Expression>;
-using StmtPtr = std::unique_ptr<Statement>;
+/**
+ * @brief Non-owning reference to an arena node: pool plus 32-bit index
+ *
+ * Behaves like a pointer (->, *, bool); the node stays valid for as long
+ * as the AstArena it was created in.
+ *
+ * The pool pointer makes this 16 bytes rather than a bare u32. It is kept
+ * so the validator, compiler and IR conversion can walk the tree through
+ * -> as they did with owning pointers, instead of threading the arena
+ * through every visitor.
+ */
+template <typename T> class AstRef {
+public:
+  AstRef() = default;
+  AstRef(std::nullptr_t) {}
+  AstRef(AstNodePool<T> *pool, u32 index) : m_pool(pool), m_index(index) {}
+
+  [[nodiscard]] T *get() const {
+    return m_pool ? &(*m_pool)[m_index] : nullptr;
+  }
+  T &operator*() const { return (*m_pool)[m_index]; }
+  T *operator->() const { return &(*m_pool)[m_index]; }
+  explicit operator bool() const { return m_pool != nullptr; }
+
+  /// Index of the node within its arena pool
+  [[nodiscard]] u32 index() const { return m_index; }
+
+  bool operator==(std::nullptr_t) const { return m_pool == nullptr; }
+  bool operator!=(std::nullptr_t) const { return m_pool != nullptr; }
+
+private:
+  AstNodePool<T> *m_pool = nullptr;
+  u32 m_index = 0;
+};
+
+using ExprPtr = AstRef<Expression>;
+using StmtPtr = AstRef<Statement>;
 
 /**
  * @brief Position enum for character/sprite placement
@@ -241,26 +286,113 @@ struct Statement {
 };
 
 /**
- * @brief Root AST node representing a complete NM Script program
+ * @brief Chunked storage for one node type
+ *
+ * Chunks hold ChunkSize nodes each and never move, so references stay
+ * valid while the pool grows; the recursive-descent parser holds node
+ * references across nested allocations, which one contiguous array would
+ * invalidate on growth. Expressions and statements differ in size, hence
+ * a pool per type. Node destructors run when the pool is destroyed.
  */
-struct Program {
-  std::vector<CharacterDecl> characters;
-  std::vector<SceneDecl> scenes;
-  std::vector<StmtPtr> globalStatements;
+template <typename T> class AstNodePool {
+public:
+  static constexpr u32 ChunkShift = 8;
+  static constexpr u32 ChunkSize = 1u << ChunkShift;
+
+  AstNodePool() = default;
+  ~AstNodePool() { clear(); }
+
+  AstNodePool(const AstNodePool &) = delete;
+  AstNodePool &operator=(const AstNodePool &) = delete;
+
+  template <typename... Args> u32 emplace(Args &&...args) {
+    if ((m_size >> ChunkShift) == m_chunks.size()) {
+      m_chunks.push_back(std::make_unique<Chunk>());
+    }
+    new (slot(m_size)) T(std::forward<Args>(args)...);
+    return m_size++;
+  }
+
+  T &operator[](u32 index) { return *std::launder(slot(index)); }
+
+  [[nodiscard]] u32 size() const { return m_size; }
+  [[nodiscard]] usize chunkCount() const { return m_chunks.size(); }
+
+  void clear() {
+    for (u32 i = 0; i < m_size; ++i) {
+      (*this)[i].~T();
+    }
+    m_chunks.clear();
+    m_size = 0;
+  }
+
+private:
+  struct Chunk {
+    alignas(T) std::byte storage[sizeof(T) * ChunkSize];
+  };
+
+  T *slot(u32 index) {
+    return reinterpret_cast<T *>(m_chunks[index >> ChunkShift]->storage +
+                                 (index & (ChunkSize - 1)) * sizeof(T));
+  }
+
+  std::vector<std::unique_ptr<Chunk>> m_chunks;
+  u32 m_size = 0;
 };
 
 /**
- * @brief Helper to create expressions
+ * @brief Owns every expression and statement node of a Program
  */
-template <typename T> ExprPtr makeExpr(T &&expr, SourceLocation loc = {}) {
-  return std::make_unique<Expression>(std::forward<T>(expr), loc);
-}
+class AstArena {
+public:
+  AstArena() = default;
+  AstArena(const AstArena &) = delete;
+  AstArena &operator=(const AstArena &) = delete;
+
+  template <typename T> ExprPtr makeExpr(T &&expr, SourceLocation loc = {}) {
+    return {&m_expressions, m_expressions.emplace(std::forward<T>(expr), loc)};
+  }
+
+  template <typename T> StmtPtr makeStmt(T &&stmt, SourceLocation loc = {}) {
+    return {&m_statements, m_statements.emplace(std::forward<T>(stmt), loc)};
+  }
+
+  [[nodiscard]] Expression &expression(u32 index) {
+    return m_expressions[index];
+  }
+  [[nodiscard]] Statement &statement(u32 index) { return m_statements[index]; }
+
+  [[nodiscard]] u32 expressionCount() const { return m_expressions.size(); }
+  [[nodiscard]] u32 statementCount() const { return m_statements.size(); }
+
+  /// Heap blocks backing the nodes (one per chunk)
+  [[nodiscard]] usize blockCount() const {
+    return m_expressions.chunkCount() + m_statements.chunkCount();
+  }
+
+private:
+  AstNodePool<Expression> m_expressions;
+  AstNodePool<Statement> m_statements;
+};
 
 /**
- * @brief Helper to create statements
+ * @brief Root AST node representing a complete NM Script program
  */
-template <typename T> StmtPtr makeStmt(T &&stmt, SourceLocation loc = {}) {
-  return std::make_unique<Statement>(std::forward<T>(stmt), loc);
-}
+struct Program {
+  std::vector<CharacterDecl> characters;
+  std::vector<SceneDecl> scenes;
+  std::vector<StmtPtr> globalStatements;
+
+  // Heap-held so node references survive moving the Program
+  std::unique_ptr<AstArena> arena = std::make_unique<AstArena>();
+
+  /// The node arena, recreated empty if this Program was moved from
+  AstArena &nodes() {
+    if (!arena) {
+      arena = std::make_unique<AstArena>();
+    }
+    return *arena;
+  }
+};
 
 } // namespace NovelMind::scripting
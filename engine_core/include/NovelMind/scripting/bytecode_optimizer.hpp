@@ -0,0 +1,83 @@
+#pragma once
+
+/**
+ * @file bytecode_optimizer.hpp
+ * @brief Peephole optimizer for compiled NM Script bytecode
+ *
+ * The Compiler emits straightforward stack code. BytecodeOptimizer rewrites
+ * CompiledScript::instructions in place:
+ * - O1: constant folding, NOT/constant branch simplification, jump
+ *   threading, and removal of unreachable code and NOPs
+ * - O2: O1 plus fusion of compare + JUMP_IF_NOT into JUMP_IF_NOT_<cmp>
+ *   superinstructions
+ *
+ * Jump operands, GOTO_SCENE targets and sceneEntryPoints are remapped after
+ * instructions are removed.
+ *
+ * Example usage:
+ * @code
+ * BytecodeOptimizer optimizer(OptimizationLevel::O2);
+ * OptimizationStats stats = optimizer.optimize(script);
+ * @endcode
+ */
+
+#include "NovelMind/core/types.hpp"
+#include "NovelMind/scripting/compiler.hpp"
+#include <vector>
+
+namespace NovelMind::scripting {
+
+enum class OptimizationLevel : u8 { O0 = 0, O1 = 1, O2 = 2 };
+
+/**
+ * @brief What an optimization run changed
+ */
+struct OptimizationStats {
+  usize instructionsBefore = 0;
+  usize instructionsAfter = 0;
+  usize constantsFolded = 0;
+  usize branchesSimplified = 0;
+  usize jumpsThreaded = 0;
+  usize branchesFused = 0;
+  usize deadInstructionsRemoved = 0;
+
+  [[nodiscard]] f64 reductionPercent() const {
+    if (instructionsBefore == 0) {
+      return 0.0;
+    }
+    return 100.0 *
+           static_cast<f64>(instructionsBefore - instructionsAfter) /
+           static_cast<f64>(instructionsBefore);
+  }
+};
+
+class BytecodeOptimizer {
+public:
+  explicit BytecodeOptimizer(OptimizationLevel level = OptimizationLevel::O1);
+
+  /**
+   * @brief Optimize a compiled script in place
+   */
+  OptimizationStats optimize(CompiledScript &script);
+
+private:
+  // Each pass replaces instructions with NOP instead of erasing them, so
+  // indices stay stable until compact() drops NOPs and remaps targets.
+  bool foldConstants();
+  bool simplifyBranches();
+  bool threadJumps();
+  bool fuseCompareBranch();
+  bool removeUnreachable(const CompiledScript &script);
+  void compact(CompiledScript &script);
+
+  void computeTargets(const CompiledScript &script);
+  [[nodiscard]] usize nextLive(usize index) const;
+  [[nodiscard]] bool isBlocked(usize from, usize to) const;
+
+  OptimizationLevel m_level;
+  std::vector<Instruction> m_code;
+  std::vector<u8> m_isTarget;
+  OptimizationStats m_stats;
+};
+
+} // namespace NovelMind::scripting
@@ -0,0 +1,173 @@
+#pragma once
+
+/**
+ * @file compiled_script_image.hpp
+ * @brief NMC2 compiled script format (memory-mappable, zero-parse load)
+ *
+ * NMC2 stores a CompiledScript as fixed-layout, 8-byte aligned sections that
+ * can be used directly from a memory mapping:
+ *
+ * @code
+ * Nmc2Header
+ * Instruction[instructionCount]          // same layout as scripting::Instruction
+ * u32 stringOffsets[blobStringCount + 1] // offsets into the string blob
+ * char stringBlob[stringBlobSize]        // NUL-terminated strings
+ * Nmc2Scene[sceneCount]                  // sorted by scene name
+ * Nmc2Character[characterCount]
+ * u32 sourceLines[instructionCount]      // optional, lineTableOffset != 0
+ * @endcode
+ *
+ * The first stringCount blob strings are the script's string table; scene
+ * and character names follow. All integers are little-endian.
+ *
+ * Example usage:
+ * @code
+ * auto image = CompiledScriptImage::open("game.nmc");
+ * if (image.isOk()) {
+ *   vm.load(std::make_shared<const CompiledScriptImage>(
+ *       std::move(image).value()));
+ * }
+ * @endcode
+ */
+
+#include "NovelMind/core/result.hpp"
+#include "NovelMind/core/types.hpp"
+#include "NovelMind/platform/mapped_file.hpp"
+#include "NovelMind/scripting/compiler.hpp"
+#include "NovelMind/scripting/opcode.hpp"
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace NovelMind::scripting {
+
+inline constexpr char kNmc2Magic[4] = {'N', 'M', 'C', '2'};
+inline constexpr u32 kNmc2FormatVersion = 1;
+
+struct Nmc2Header {
+  char magic[4];
+  u32 formatVersion;
+  u32 engineVersion;
+  u32 headerSize;
+  u64 fileSize;
+  u32 instructionCount;
+  u32 instructionOffset;
+  u32 stringCount;
+  u32 blobStringCount;
+  u32 stringOffsetsOffset;
+  u32 stringBlobOffset;
+  u32 stringBlobSize;
+  u32 sceneCount;
+  u32 sceneTableOffset;
+  u32 characterCount;
+  u32 characterTableOffset;
+  u32 lineTableOffset; // 0 when the image carries no source lines
+};
+
+struct Nmc2Scene {
+  u32 nameString; // Blob string index
+  u32 entryPoint; // Instruction index
+};
+
+struct Nmc2Character {
+  u32 idString;
+  u32 displayNameString;
+  u32 colorString;
+  u32 reserved;
+};
+
+static_assert(sizeof(Nmc2Header) == 72, "NMC2 header layout changed");
+static_assert(sizeof(Instruction) == 8 && offsetof(Instruction, operand) == 4,
+              "NMC2 maps Instruction directly");
+
+/**
+ * @brief Serialize a compiled script to NMC2 bytes
+ */
+[[nodiscard]] std::vector<u8> serializeNmc2(const CompiledScript &script,
+                                            u32 engineVersion = 0);
+
+/**
+ * @brief Serialize a compiled script and write it to disk in one call
+ */
+[[nodiscard]] Result<void> writeNmc2(const CompiledScript &script,
+                                     const std::string &path,
+                                     u32 engineVersion = 0);
+
+/**
+ * @brief True if the bytes start with the NMC2 magic
+ */
+[[nodiscard]] bool isNmc2(std::span<const u8> bytes);
+
+/**
+ * @brief Read-only view over an NMC2 file
+ *
+ * open() maps the file and validates every offset once; afterwards all
+ * accessors are O(1) (scene lookup is a binary search) and return views into
+ * the mapping, which stays alive as long as the image.
+ */
+class CompiledScriptImage {
+public:
+  CompiledScriptImage() = default;
+
+  [[nodiscard]] static Result<CompiledScriptImage>
+  open(const std::string &path);
+
+  [[nodiscard]] static Result<CompiledScriptImage>
+  fromBuffer(std::vector<u8> bytes);
+
+  [[nodiscard]] std::span<const Instruction> instructions() const {
+    return m_instructions;
+  }
+
+  /**
+   * @brief Views of the script string table (indexable by operands)
+   */
+  [[nodiscard]] std::span<const std::string_view> strings() const {
+    return {m_strings.data(), m_stringCount};
+  }
+
+  /**
+   * @brief Source line per instruction; empty if not recorded
+   */
+  [[nodiscard]] std::span<const u32> sourceLines() const {
+    return m_sourceLines;
+  }
+
+  [[nodiscard]] usize sceneCount() const { return m_scenes.size(); }
+  [[nodiscard]] std::string_view sceneName(usize index) const;
+  [[nodiscard]] u32 sceneEntryPoint(usize index) const;
+  [[nodiscard]] std::optional<u32> findScene(std::string_view name) const;
+
+  [[nodiscard]] u32 engineVersion() const { return m_engineVersion; }
+  [[nodiscard]] bool isMapped() const { return m_file.isMapped(); }
+
+  /**
+   * @brief Scene entry points and character declarations only
+   *
+   * For hosts that run the bytecode from the image itself and only need
+   * the lookup tables around it.
+   */
+  [[nodiscard]] CompiledScript metadata() const;
+
+  /**
+   * @brief Materialize an owning CompiledScript (copies everything)
+   */
+  [[nodiscard]] CompiledScript toCompiledScript() const;
+
+private:
+  Result<void> parse();
+
+  platform::MappedFile m_file;
+  std::span<const Instruction> m_instructions;
+  std::span<const Nmc2Scene> m_scenes;
+  std::span<const Nmc2Character> m_characters;
+  std::span<const u32> m_sourceLines;
+  std::vector<std::string_view> m_strings; // All blob strings
+  usize m_stringCount = 0;
+  u32 m_engineVersion = 0;
+};
+
+} // namespace NovelMind::scripting
@@ -34,6 +34,18 @@ struct CompiledScript {
 
   // Variable declarations (for type checking)
   std::unordered_map<std::string, ValueType> variables;
+
+  // Jumps to scenes defined in other files, left for ScriptLinker to patch.
+  // Only produced when Compiler::setAllowExternalScenes(true) is used.
+  struct SceneReference {
+    u32 instructionIndex;
+    std::string scene;
+  };
+  std::vector<SceneReference> externalSceneRefs;
+
+  // Source line of the statement each instruction came from (0 = none).
+  // Parallel to instructions when present; empty if not recorded.
+  std::vector<u32> sourceLines;
 };
 
 /**
@@ -81,6 +93,14 @@ public:
    */
   [[nodiscard]] const std::vector<CompileError> &getErrors() const;
 
+  /**
+   * @brief Record unknown goto targets instead of failing
+   *
+   * Used when compiling one file of a multi-file project: unresolved scene
+   * names end up in CompiledScript::externalSceneRefs for ScriptLinker.
+   */
+  void setAllowExternalScenes(bool allow) { m_allowExternalScenes = allow; }
+
 private:
   // Compilation helpers
   void reset();
@@ -135,6 +155,9 @@ private:
 
   // Current compilation context
   std::string m_currentScene;
+  u32 m_currentLine = 0;
+
+  bool m_allowExternalScenes = false;
 };
 
 } // namespace NovelMind::scripting
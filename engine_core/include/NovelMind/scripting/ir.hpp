@@ -285,10 +285,10 @@ public:
   Result<Program> convert(const IRGraph &graph);
 
 private:
-  std::unique_ptr<Statement> convertNode(const IRNode *node,
-                                         const IRGraph &graph);
-  std::unique_ptr<Expression> convertToExpression(const IRNode *node,
-                                                  const IRGraph &graph);
+  StmtPtr convertNode(const IRNode *node, const IRGraph &graph,
+                      AstArena &arena);
+  ExprPtr convertToExpression(const IRNode *node, const IRGraph &graph,
+                              AstArena &arena);
 
   std::unordered_set<NodeId> m_visited;
 };
@@ -8,6 +8,7 @@
  * source code into a stream of tokens for parsing.
  */
 
+#include "NovelMind/core/arena.hpp"
 #include "NovelMind/core/result.hpp"
 #include "NovelMind/core/types.hpp"
 #include "NovelMind/scripting/token.hpp"
@@ -37,6 +38,11 @@ struct LexerError {
  * a sequence of tokens. It handles comments, string literals,
  * numbers, identifiers, and keywords.
  *
+ * tokenizeViews() is the allocation-light mode used by the compiler:
+ * lexemes are views into the source, and only string literals with escape
+ * sequences are decoded into a caller-owned arena. tokenize() returns
+ * owning tokens built from the same scan.
+ *
  * Example usage:
  * @code
  * Lexer lexer;
@@ -60,6 +66,14 @@ public:
    */
   [[nodiscard]] Result<std::vector<Token>> tokenize(std::string_view source);
 
+  /**
+   * @brief Tokenize without copying lexemes
+   * @param source Must outlive the returned tokens
+   * @param arena Receives decoded escaped strings; must outlive the tokens
+   */
+  [[nodiscard]] Result<std::vector<TokenView>>
+  tokenizeViews(std::string_view source, core::Arena &arena);
+
   /**
    * @brief Reset lexer state for reuse
    */
@@ -83,17 +97,17 @@ private:
   void skipLineComment();
   void skipBlockComment();
 
-  Token scanToken();
-  Token makeToken(TokenType type);
-  Token makeToken(TokenType type, const std::string &lexeme);
-  Token errorToken(const std::string &message);
+  TokenView scanToken();
+  TokenView makeToken(TokenType type);
+  TokenView makeToken(TokenType type, std::string_view lexeme);
+  TokenView errorToken(std::string_view message);
 
-  Token scanString();
-  Token scanNumber();
-  Token scanIdentifier();
-  Token scanColorLiteral();
+  TokenView scanString();
+  TokenView scanNumber();
+  TokenView scanIdentifier();
+  TokenView scanColorLiteral();
 
-  [[nodiscard]] TokenType identifierType(const std::string &lexeme) const;
+  [[nodiscard]] TokenType identifierType(std::string_view lexeme) const;
 
   std::string_view m_source;
   size_t m_start;
@@ -102,8 +116,10 @@ private:
   u32 m_column;
   u32 m_startColumn;
 
+  core::Arena *m_arena = nullptr;
+
   std::vector<LexerError> m_errors;
-  std::unordered_map<std::string, TokenType> m_keywords;
+  std::unordered_map<std::string_view, TokenType> m_keywords;
 };
 
 } // namespace NovelMind::scripting
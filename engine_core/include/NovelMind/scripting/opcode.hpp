@@ -63,9 +63,200 @@ enum class OpCode : u8 {
   STOP_MUSIC = 0x69,
   WAIT = 0x6A,
   TRANSITION = 0x6B,
-  GOTO_SCENE = 0x6C
+  GOTO_SCENE = 0x6C,
+
+  // Fused compare-and-branch (emitted by BytecodeOptimizer at -O2):
+  // pop b, pop a, jump to operand unless (a <cmp> b)
+  JUMP_IF_NOT_EQ = 0x70,
+  JUMP_IF_NOT_NE = 0x71,
+  JUMP_IF_NOT_LT = 0x72,
+  JUMP_IF_NOT_LE = 0x73,
+  JUMP_IF_NOT_GT = 0x74,
+  JUMP_IF_NOT_GE = 0x75
 };
 
+/**
+ * @brief True for opcodes whose operand is a branch target instruction index
+ */
+[[nodiscard]] constexpr bool isJumpOpcode(OpCode op) {
+  switch (op) {
+  case OpCode::JUMP:
+  case OpCode::JUMP_IF:
+  case OpCode::JUMP_IF_NOT:
+  case OpCode::JUMP_IF_NOT_EQ:
+  case OpCode::JUMP_IF_NOT_NE:
+  case OpCode::JUMP_IF_NOT_LT:
+  case OpCode::JUMP_IF_NOT_LE:
+  case OpCode::JUMP_IF_NOT_GT:
+  case OpCode::JUMP_IF_NOT_GE:
+    return true;
+  default:
+    return false;
+  }
+}
+
+/**
+ * @brief True for opcodes whose operand indexes the string table
+ */
+[[nodiscard]] constexpr bool hasStringOperand(OpCode op) {
+  switch (op) {
+  case OpCode::CALL:
+  case OpCode::PUSH_STRING:
+  case OpCode::LOAD_VAR:
+  case OpCode::STORE_VAR:
+  case OpCode::LOAD_GLOBAL:
+  case OpCode::STORE_GLOBAL:
+  case OpCode::SHOW_BACKGROUND:
+  case OpCode::SHOW_CHARACTER:
+  case OpCode::HIDE_CHARACTER:
+  case OpCode::SAY:
+  case OpCode::SET_FLAG:
+  case OpCode::CHECK_FLAG:
+  case OpCode::PLAY_SOUND:
+  case OpCode::PLAY_MUSIC:
+  case OpCode::TRANSITION:
+    return true;
+  default:
+    return false;
+  }
+}
+
+/**
+ * @brief True for opcodes the VM hands to a native handler or callback
+ */
+[[nodiscard]] constexpr bool isNativeOpcode(OpCode op) {
+  switch (op) {
+  case OpCode::CALL:
+  case OpCode::SHOW_BACKGROUND:
+  case OpCode::SHOW_CHARACTER:
+  case OpCode::HIDE_CHARACTER:
+  case OpCode::SAY:
+  case OpCode::CHOICE:
+  case OpCode::PLAY_SOUND:
+  case OpCode::PLAY_MUSIC:
+  case OpCode::STOP_MUSIC:
+  case OpCode::WAIT:
+  case OpCode::TRANSITION:
+  case OpCode::GOTO_SCENE:
+    return true;
+  default:
+    return false;
+  }
+}
+
+/**
+ * @brief Mnemonic for an opcode (for listings and profiles)
+ */
+[[nodiscard]] constexpr const char *opcodeToString(OpCode op) {
+  switch (op) {
+  case OpCode::NOP:
+    return "NOP";
+  case OpCode::HALT:
+    return "HALT";
+  case OpCode::JUMP:
+    return "JUMP";
+  case OpCode::JUMP_IF:
+    return "JUMP_IF";
+  case OpCode::JUMP_IF_NOT:
+    return "JUMP_IF_NOT";
+  case OpCode::CALL:
+    return "CALL";
+  case OpCode::RETURN:
+    return "RETURN";
+  case OpCode::PUSH_INT:
+    return "PUSH_INT";
+  case OpCode::PUSH_FLOAT:
+    return "PUSH_FLOAT";
+  case OpCode::PUSH_STRING:
+    return "PUSH_STRING";
+  case OpCode::PUSH_BOOL:
+    return "PUSH_BOOL";
+  case OpCode::PUSH_NULL:
+    return "PUSH_NULL";
+  case OpCode::POP:
+    return "POP";
+  case OpCode::DUP:
+    return "DUP";
+  case OpCode::LOAD_VAR:
+    return "LOAD_VAR";
+  case OpCode::STORE_VAR:
+    return "STORE_VAR";
+  case OpCode::LOAD_GLOBAL:
+    return "LOAD_GLOBAL";
+  case OpCode::STORE_GLOBAL:
+    return "STORE_GLOBAL";
+  case OpCode::ADD:
+    return "ADD";
+  case OpCode::SUB:
+    return "SUB";
+  case OpCode::MUL:
+    return "MUL";
+  case OpCode::DIV:
+    return "DIV";
+  case OpCode::MOD:
+    return "MOD";
+  case OpCode::NEG:
+    return "NEG";
+  case OpCode::EQ:
+    return "EQ";
+  case OpCode::NE:
+    return "NE";
+  case OpCode::LT:
+    return "LT";
+  case OpCode::LE:
+    return "LE";
+  case OpCode::GT:
+    return "GT";
+  case OpCode::GE:
+    return "GE";
+  case OpCode::AND:
+    return "AND";
+  case OpCode::OR:
+    return "OR";
+  case OpCode::NOT:
+    return "NOT";
+  case OpCode::SHOW_BACKGROUND:
+    return "SHOW_BACKGROUND";
+  case OpCode::SHOW_CHARACTER:
+    return "SHOW_CHARACTER";
+  case OpCode::HIDE_CHARACTER:
+    return "HIDE_CHARACTER";
+  case OpCode::SAY:
+    return "SAY";
+  case OpCode::CHOICE:
+    return "CHOICE";
+  case OpCode::SET_FLAG:
+    return "SET_FLAG";
+  case OpCode::CHECK_FLAG:
+    return "CHECK_FLAG";
+  case OpCode::PLAY_SOUND:
+    return "PLAY_SOUND";
+  case OpCode::PLAY_MUSIC:
+    return "PLAY_MUSIC";
+  case OpCode::STOP_MUSIC:
+    return "STOP_MUSIC";
+  case OpCode::WAIT:
+    return "WAIT";
+  case OpCode::TRANSITION:
+    return "TRANSITION";
+  case OpCode::GOTO_SCENE:
+    return "GOTO_SCENE";
+  case OpCode::JUMP_IF_NOT_EQ:
+    return "JUMP_IF_NOT_EQ";
+  case OpCode::JUMP_IF_NOT_NE:
+    return "JUMP_IF_NOT_NE";
+  case OpCode::JUMP_IF_NOT_LT:
+    return "JUMP_IF_NOT_LT";
+  case OpCode::JUMP_IF_NOT_LE:
+    return "JUMP_IF_NOT_LE";
+  case OpCode::JUMP_IF_NOT_GT:
+    return "JUMP_IF_NOT_GT";
+  case OpCode::JUMP_IF_NOT_GE:
+    return "JUMP_IF_NOT_GE";
+  }
+  return "UNKNOWN";
+}
+
 struct Instruction {
   OpCode opcode;
   u32 operand;
@@ -57,6 +57,14 @@ public:
    */
   [[nodiscard]] Result<Program> parse(const std::vector<Token> &tokens);
 
+  /**
+   * @brief Parse the non-owning token stream from Lexer::tokenizeViews()
+   *
+   * The AST owns copies of every lexeme it keeps, so the source buffer and
+   * lexer arena may be released once this returns.
+   */
+  [[nodiscard]] Result<Program> parse(const std::vector<TokenView> &tokens);
+
   /**
    * @brief Get all errors encountered during parsing
    */
@@ -65,13 +73,13 @@ public:
 private:
   // Token navigation
   [[nodiscard]] bool isAtEnd() const;
-  [[nodiscard]] const Token &peek() const;
-  [[nodiscard]] const Token &previous() const;
-  const Token &advance();
+  [[nodiscard]] const TokenView &peek() const;
+  [[nodiscard]] const TokenView &previous() const;
+  const TokenView &advance();
   bool check(TokenType type) const;
   bool match(TokenType type);
   bool match(std::initializer_list<TokenType> types);
-  const Token &consume(TokenType type, const std::string &message);
+  const TokenView &consume(TokenType type, const std::string &message);
 
   // Error handling
   void error(const std::string &message);
@@ -115,10 +123,11 @@ private:
   std::string parseString();
   std::vector<StmtPtr> parseStatementList();
 
-  const std::vector<Token> *m_tokens;
+  const std::vector<TokenView> *m_tokens;
   size_t m_current;
   std::vector<ParseError> m_errors;
   Program m_program;
+  AstArena *m_arena; // m_program.arena during parse()
 };
 
 } // namespace NovelMind::scripting
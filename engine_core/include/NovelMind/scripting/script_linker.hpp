@@ -0,0 +1,50 @@
+#pragma once
+
+/**
+ * @file script_linker.hpp
+ * @brief Links separately compiled script files into one CompiledScript
+ *
+ * Each unit is the output of Compiler::compile() for a single file (with
+ * setAllowExternalScenes(true)). Linking:
+ * - concatenates instructions in unit order and rebases jump targets
+ * - merges string tables, deduplicating strings and remapping operands
+ * - merges scene entry points and characters, rejecting duplicates
+ * - patches externalSceneRefs against the merged scene table
+ *
+ * Example usage:
+ * @code
+ * ScriptLinker linker;
+ * auto linked = linker.link({&unitA, &unitB});
+ * @endcode
+ */
+
+#include "NovelMind/core/result.hpp"
+#include "NovelMind/scripting/compiler.hpp"
+#include <string>
+#include <vector>
+
+namespace NovelMind::scripting {
+
+class ScriptLinker {
+public:
+  /**
+   * @brief Link units into a single program
+   * @param units Compiled units in program order
+   * @param unitNames Optional names for error messages, parallel to @p units
+   */
+  [[nodiscard]] Result<CompiledScript>
+  link(const std::vector<const CompiledScript *> &units,
+       const std::vector<std::string> &unitNames = {});
+
+  /**
+   * @brief All errors from the last link() call
+   */
+  [[nodiscard]] const std::vector<std::string> &getErrors() const {
+    return m_errors;
+  }
+
+private:
+  std::vector<std::string> m_errors;
+};
+
+} // namespace NovelMind::scripting
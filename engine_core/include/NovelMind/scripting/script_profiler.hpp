@@ -0,0 +1,149 @@
+#pragma once
+
+/**
+ * @file script_profiler.hpp
+ * @brief Instruction-level profiling for the script VM
+ *
+ * When a ScriptProfiler is attached with VirtualMachine::setProfiler(), the
+ * VM counts every executed instruction per IP and per opcode and times each
+ * native handler call. Counts are mapped back to scenes through
+ * CompiledScript::sceneEntryPoints and to source lines through
+ * CompiledScript::sourceLines. The VM takes its step() path while profiling;
+ * with no profiler attached the threaded interpreter is untouched.
+ *
+ * Example usage:
+ * @code
+ * ScriptProfiler profiler;
+ * vm.setProfiler(&profiler);
+ * vm.run();
+ * std::cout << profiler.formatReport(script);
+ * profiler.exportToChromeTrace("script_trace.json", script);
+ * @endcode
+ */
+
+#include "NovelMind/core/types.hpp"
+#include "NovelMind/scripting/compiler.hpp"
+#include "NovelMind/scripting/opcode.hpp"
+#include <array>
+#include <chrono>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace NovelMind::scripting {
+
+struct ScriptSceneProfile {
+  std::string scene; // "<global>" for code ahead of the first scene
+  u32 entryPoint = 0;
+  u64 instructions = 0;
+  u64 nativeCalls = 0;
+  f64 nativeMs = 0.0;
+};
+
+struct ScriptLineProfile {
+  u32 line = 0;
+  std::string scene;
+  u64 instructions = 0;
+  f64 nativeMs = 0.0;
+};
+
+struct NativeCallStats {
+  u64 calls = 0;
+  f64 totalMs = 0.0;
+  f64 maxMs = 0.0;
+};
+
+class ScriptProfiler {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  ScriptProfiler();
+
+  /**
+   * @brief Discard all recorded data
+   */
+  void reset();
+
+  /**
+   * @brief Grow per-IP counters to cover @p programSize instructions
+   *
+   * Called by the VM when the profiler is attached and on every load().
+   * Counters are kept, so repeated scene reloads of one program accumulate.
+   */
+  void attach(usize programSize);
+
+  void recordInstruction(u32 ip, OpCode op) {
+    if (ip < m_ipCounts.size()) {
+      ++m_ipCounts[ip];
+    }
+    ++m_opcodeCounts[static_cast<usize>(op)];
+    ++m_totalInstructions;
+  }
+
+  void recordNativeCall(OpCode op, u32 ip, Clock::time_point start,
+                        Clock::time_point end);
+
+  /**
+   * @brief Cap on native-call spans kept for the Chrome trace (default 100k)
+   *
+   * Aggregate statistics keep counting after the cap is reached.
+   */
+  void setMaxTraceEvents(usize maxEvents) { m_maxTraceEvents = maxEvents; }
+
+  [[nodiscard]] u64 totalInstructions() const { return m_totalInstructions; }
+  [[nodiscard]] std::span<const u64> instructionCounts() const {
+    return m_ipCounts;
+  }
+  [[nodiscard]] u64 opcodeCount(OpCode op) const {
+    return m_opcodeCounts[static_cast<usize>(op)];
+  }
+  [[nodiscard]] const NativeCallStats &nativeStats(OpCode op) const {
+    return m_nativeStats[static_cast<usize>(op)];
+  }
+
+  /**
+   * @brief Per-scene totals, hottest first
+   */
+  [[nodiscard]] std::vector<ScriptSceneProfile>
+  sceneProfile(const CompiledScript &script) const;
+
+  /**
+   * @brief Per-source-line totals, hottest first
+   * @return Empty when @p script carries no line table
+   */
+  [[nodiscard]] std::vector<ScriptLineProfile>
+  lineProfile(const CompiledScript &script) const;
+
+  /**
+   * @brief Human-readable hot-scene/hot-line/opcode summary
+   */
+  [[nodiscard]] std::string formatReport(const CompiledScript &script,
+                                         usize maxRows = 10) const;
+
+  /**
+   * @brief Write native-call spans and per-scene counters in the Chrome
+   *        trace format used by Core::Profiler
+   */
+  bool exportToChromeTrace(const std::string &filename,
+                           const CompiledScript &script) const;
+
+private:
+  struct NativeEvent {
+    OpCode opcode;
+    u32 ip;
+    f64 startUs; // Relative to m_origin
+    f64 durationUs;
+  };
+
+  std::vector<u64> m_ipCounts;
+  std::vector<f64> m_ipNativeMs;
+  std::array<u64, 256> m_opcodeCounts{};
+  std::array<NativeCallStats, 256> m_nativeStats{};
+  u64 m_totalInstructions = 0;
+
+  std::vector<NativeEvent> m_events;
+  usize m_maxTraceEvents = 100000;
+  Clock::time_point m_origin;
+};
+
+} // namespace NovelMind::scripting
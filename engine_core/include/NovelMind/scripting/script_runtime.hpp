@@ -15,18 +15,21 @@
 #include "NovelMind/audio/audio_manager.hpp"
 #include "NovelMind/core/result.hpp"
 #include "NovelMind/core/types.hpp"
+#include "NovelMind/resource/resource_manager.hpp"
 #include "NovelMind/scene/animation.hpp"
 #include "NovelMind/scene/character_sprite.hpp"
 #include "NovelMind/scene/choice_menu.hpp"
 #include "NovelMind/scene/dialogue_box.hpp"
 #include "NovelMind/scene/scene_manager.hpp"
 #include "NovelMind/scene/transition.hpp"
+#include "NovelMind/scripting/asset_prefetcher.hpp"
 #include "NovelMind/scripting/compiler.hpp"
 #include "NovelMind/scripting/vm.hpp"
 #include <functional>
 #include <memory>
 #include <queue>
 #include <string>
+#include <string_view>
 #include <variant>
 
 namespace NovelMind::scripting {
@@ -67,7 +70,8 @@ enum class ScriptEventType : u8 {
   MusicStop,          // Music stopped
   SoundPlay,          // Sound effect played
   VariableChanged,    // Variable was modified
-  FlagChanged         // Flag was modified
+  FlagChanged,        // Flag was modified
+  SliceOverrun        // update() budget ran out with the script runnable
 };
 
 /**
@@ -90,6 +94,15 @@ struct RuntimeConfig {
   f32 autoAdvanceDelay = 2.0f; // Seconds after text complete
   bool skipModeEnabled = false;
   f32 skipModeSpeed = 100.0f; // Text speed in skip mode
+
+  // Per-update() execution budget. The VM runs until the script blocks or
+  // either limit is reached, then resumes on the next frame. 0 = unlimited.
+  u32 instructionBudget = 10000;
+  u32 timeBudgetMicros = 2000;
+
+  // Bytecode lookahead that loads upcoming assets; used once a resource
+  // manager is set
+  PrefetchConfig prefetch;
 };
 
 /**
@@ -154,6 +167,11 @@ public:
    */
   Result<void> load(const CompiledScript &script);
 
+  /**
+   * @brief Run a mapped NMC2 image in place (see VirtualMachine::load)
+   */
+  Result<void> load(std::shared_ptr<const CompiledScriptImage> image);
+
   /**
    * @brief Set the scene manager for character/background commands
    */
@@ -179,6 +197,13 @@ public:
    */
   void setAnimationManager(scene::AnimationManager *manager);
 
+  /**
+   * @brief Set the resource manager; shown backgrounds and sprites start
+   *        loading as soon as their command executes, and assets further
+   *        ahead in the script are prefetched
+   */
+  void setResourceManager(resource::ResourceManager *resources);
+
   /**
    * @brief Set runtime configuration
    */
@@ -201,6 +226,11 @@ public:
 
   /**
    * @brief Update the runtime (call each frame)
+   *
+   * Executes one bounded slice of script: until the script waits for
+   * input, a timer or a transition, or until RuntimeConfig's instruction
+   * or time budget is used up. An exhausted budget fires SliceOverrun with
+   * the executed instruction count and continues on the next update().
    */
   void update(f64 deltaTime);
 
@@ -249,6 +279,11 @@ public:
    */
   [[nodiscard]] bool isComplete() const;
 
+  /**
+   * @brief Instructions executed by the most recent update()
+   */
+  [[nodiscard]] u32 getLastSliceInstructions() const;
+
   /**
    * @brief Set a script variable
    */
@@ -309,23 +344,30 @@ public:
    */
   [[nodiscard]] VirtualMachine &getVM();
 
+  /**
+   * @brief Get the asset prefetcher (for hit/miss statistics)
+   */
+  [[nodiscard]] const AssetPrefetcher &getPrefetcher() const;
+
 private:
-  // VM callback handlers
-  void onShowBackground(const std::vector<Value> &args);
-  void onShowCharacter(const std::vector<Value> &args);
-  void onHideCharacter(const std::vector<Value> &args);
-  void onSay(const std::vector<Value> &args);
-  void onChoice(const std::vector<Value> &args);
-  void onGotoScene(const std::vector<Value> &args);
-  void onWait(const std::vector<Value> &args);
-  void onPlaySound(const std::vector<Value> &args);
-  void onPlayMusic(const std::vector<Value> &args);
-  void onStopMusic(const std::vector<Value> &args);
-  void onTransition(const std::vector<Value> &args);
+  // VM native opcode handlers (allocation-free ABI, see NativeCallArgs)
+  void onShowBackground(const NativeCallArgs &args);
+  void onShowCharacter(const NativeCallArgs &args);
+  void onHideCharacter(const NativeCallArgs &args);
+  void onSay(const NativeCallArgs &args);
+  void onChoice(const NativeCallArgs &args);
+  void onGotoScene(const NativeCallArgs &args);
+  void onWait(const NativeCallArgs &args);
+  void onPlaySound(const NativeCallArgs &args);
+  void onPlayMusic(const NativeCallArgs &args);
+  void onStopMusic(const NativeCallArgs &args);
+  void onTransition(const NativeCallArgs &args);
 
   // Internal helpers
+  void onScriptLoaded();
   void registerCallbacks();
-  void fireEvent(ScriptEventType type, const std::string &name = "",
+  void runSlice();
+  void fireEvent(ScriptEventType type, std::string_view name = {},
                  const Value &value = Value{});
 
   void updateWaitTimer(f64 deltaTime);
@@ -337,7 +379,8 @@ private:
   std::unique_ptr<Scene::ITransition> createTransition(const std::string &type,
                                                        f32 duration);
 
-  // VM and compiled script
+  // VM and the script's scene and character tables; the bytecode itself
+  // lives only in the VM
   VirtualMachine m_vm;
   CompiledScript m_script;
 
@@ -347,6 +390,8 @@ private:
   Scene::ChoiceMenu *m_choiceMenu = nullptr;
   audio::AudioManager *m_audioManager = nullptr;
   scene::AnimationManager *m_animationManager = nullptr;
+  resource::ResourceManager *m_resources = nullptr;
+  AssetPrefetcher m_prefetcher;
 
   // State
   RuntimeState m_state = RuntimeState::Idle;
@@ -356,6 +401,11 @@ private:
   std::string m_currentSpeaker;
   std::string m_currentDialogue;
   RuntimeConfig m_config;
+  u32 m_lastSliceInstructions = 0;
+
+  // Scene requested by GOTO_SCENE; applied between VM steps so the IP is
+  // never moved from inside its own native handler
+  std::string m_pendingScene;
 
   // Wait state
   f32 m_waitTimer = 0.0f;
@@ -371,6 +421,9 @@ private:
   // Skip mode
   bool m_skipMode = false;
 
+  // Reused buffer for passing opcode string operands to std::string APIs
+  std::string m_nameScratch;
+
   // Event callback
   EventCallback m_eventCallback;
 };
@@ -0,0 +1,277 @@
+#pragma once
+
+/**
+ * @file tagged_value.hpp
+ * @brief Compact value representation used inside the script VM
+ *
+ * Value (a std::variant holding std::string) remains the type exchanged at
+ * API boundaries. Inside the interpreter loop the VM stores TaggedValue: a
+ * 16-byte tag + payload whose strings are either borrowed pointers into the
+ * loaded string table or intrusively refcounted heap strings. Pushing,
+ * duplicating and loading string values therefore never allocates.
+ *
+ * Reference counts are not atomic: tagged values never leave the VM thread;
+ * convert with toValue() before handing data to other systems.
+ */
+
+#include "NovelMind/core/types.hpp"
+#include "NovelMind/scripting/value.hpp"
+#include <concepts>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace NovelMind::scripting {
+
+class TaggedValue {
+public:
+  TaggedValue() noexcept : m_kind(Kind::Null) { m_data.i = 0; }
+  TaggedValue(std::monostate) noexcept : TaggedValue() {}
+  TaggedValue(i32 value) noexcept : m_kind(Kind::Int) { m_data.i = value; }
+  TaggedValue(f32 value) noexcept : m_kind(Kind::Float) { m_data.f = value; }
+  TaggedValue(bool value) noexcept : m_kind(Kind::Bool) { m_data.b = value; }
+  TaggedValue(std::string value) : m_kind(Kind::OwnedString) {
+    m_data.owned = new SharedString{1, std::move(value)};
+  }
+
+  /**
+   * @brief Reference a string that outlives the value (e.g. string table)
+   */
+  [[nodiscard]] static TaggedValue
+  interned(const std::string_view *str) noexcept {
+    TaggedValue v;
+    v.m_kind = Kind::InternedString;
+    v.m_data.interned = str;
+    return v;
+  }
+
+  [[nodiscard]] static TaggedValue fromValue(const Value &value) {
+    switch (getValueType(value)) {
+    case ValueType::Int:
+      return TaggedValue(std::get<i32>(value));
+    case ValueType::Float:
+      return TaggedValue(std::get<f32>(value));
+    case ValueType::Bool:
+      return TaggedValue(std::get<bool>(value));
+    case ValueType::String:
+      return TaggedValue(std::get<std::string>(value));
+    case ValueType::Null:
+      break;
+    }
+    return TaggedValue();
+  }
+
+  TaggedValue(const TaggedValue &other) noexcept
+      : m_kind(other.m_kind), m_data(other.m_data) {
+    retain();
+  }
+
+  TaggedValue(TaggedValue &&other) noexcept
+      : m_kind(other.m_kind), m_data(other.m_data) {
+    other.m_kind = Kind::Null;
+  }
+
+  TaggedValue &operator=(const TaggedValue &other) noexcept {
+    if (this != &other) {
+      TaggedValue copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  TaggedValue &operator=(TaggedValue &&other) noexcept {
+    if (this != &other) {
+      release();
+      m_kind = other.m_kind;
+      m_data = other.m_data;
+      other.m_kind = Kind::Null;
+    }
+    return *this;
+  }
+
+  ~TaggedValue() { release(); }
+
+  void swap(TaggedValue &other) noexcept {
+    std::swap(m_kind, other.m_kind);
+    std::swap(m_data, other.m_data);
+  }
+
+  [[nodiscard]] ValueType type() const noexcept {
+    switch (m_kind) {
+    case Kind::Int:
+      return ValueType::Int;
+    case Kind::Float:
+      return ValueType::Float;
+    case Kind::Bool:
+      return ValueType::Bool;
+    case Kind::InternedString:
+    case Kind::OwnedString:
+      return ValueType::String;
+    case Kind::Null:
+      break;
+    }
+    return ValueType::Null;
+  }
+
+  [[nodiscard]] bool isNull() const noexcept { return m_kind == Kind::Null; }
+  [[nodiscard]] bool isString() const noexcept {
+    return m_kind == Kind::InternedString || m_kind == Kind::OwnedString;
+  }
+
+  /**
+   * @brief View of the string payload (empty for non-string values)
+   */
+  [[nodiscard]] std::string_view stringView() const noexcept {
+    if (m_kind == Kind::InternedString) {
+      return *m_data.interned;
+    }
+    if (m_kind == Kind::OwnedString) {
+      return m_data.owned->text;
+    }
+    return {};
+  }
+
+  [[nodiscard]] i32 asInt() const noexcept {
+    switch (m_kind) {
+    case Kind::Int:
+      return m_data.i;
+    case Kind::Float:
+      return static_cast<i32>(m_data.f);
+    case Kind::Bool:
+      return m_data.b ? 1 : 0;
+    default:
+      return 0;
+    }
+  }
+
+  [[nodiscard]] f32 asFloat() const noexcept {
+    switch (m_kind) {
+    case Kind::Float:
+      return m_data.f;
+    case Kind::Int:
+      return static_cast<f32>(m_data.i);
+    case Kind::Bool:
+      return m_data.b ? 1.0f : 0.0f;
+    default:
+      return 0.0f;
+    }
+  }
+
+  [[nodiscard]] bool asBool() const noexcept {
+    switch (m_kind) {
+    case Kind::Bool:
+      return m_data.b;
+    case Kind::Int:
+      return m_data.i != 0;
+    case Kind::Float:
+      return m_data.f != 0.0f;
+    case Kind::InternedString:
+    case Kind::OwnedString:
+      return !stringView().empty();
+    case Kind::Null:
+      break;
+    }
+    return false;
+  }
+
+  [[nodiscard]] std::string asString() const {
+    switch (m_kind) {
+    case Kind::InternedString:
+    case Kind::OwnedString:
+      return std::string(stringView());
+    case Kind::Int:
+      return std::to_string(m_data.i);
+    case Kind::Float:
+      return std::to_string(m_data.f);
+    case Kind::Bool:
+      return m_data.b ? "true" : "false";
+    case Kind::Null:
+      break;
+    }
+    return "null";
+  }
+
+  [[nodiscard]] Value toValue() const {
+    switch (m_kind) {
+    case Kind::Int:
+      return m_data.i;
+    case Kind::Float:
+      return m_data.f;
+    case Kind::Bool:
+      return m_data.b;
+    case Kind::InternedString:
+    case Kind::OwnedString:
+      return std::string(stringView());
+    case Kind::Null:
+      break;
+    }
+    return std::monostate{};
+  }
+
+  /**
+   * @brief Convert a borrowed string into an owned one
+   *
+   * Must be called before the storage an interned string points into is
+   * released (e.g. when the VM replaces its string table).
+   */
+  void detach() {
+    if (m_kind == Kind::InternedString) {
+      *this = TaggedValue(std::string(*m_data.interned));
+    }
+  }
+
+private:
+  enum class Kind : u8 { Null, Int, Float, Bool, InternedString, OwnedString };
+
+  struct SharedString {
+    u32 refs;
+    std::string text;
+  };
+
+  void retain() noexcept {
+    if (m_kind == Kind::OwnedString) {
+      ++m_data.owned->refs;
+    }
+  }
+
+  void release() noexcept {
+    if (m_kind == Kind::OwnedString && --m_data.owned->refs == 0) {
+      delete m_data.owned;
+    }
+    m_kind = Kind::Null;
+  }
+
+  Kind m_kind;
+  union {
+    i32 i;
+    f32 f;
+    bool b;
+    const std::string_view *interned;
+    SharedString *owned;
+  } m_data;
+};
+
+static_assert(sizeof(TaggedValue) <= 16, "TaggedValue must stay compact");
+
+// Helpers mirroring value.hpp. Constrained to exactly TaggedValue so plain
+// scalars keep resolving to the Value overloads instead of becoming ambiguous.
+template <std::same_as<TaggedValue> T> ValueType getValueType(const T &val) {
+  return val.type();
+}
+template <std::same_as<TaggedValue> T> bool isNull(const T &val) {
+  return val.isNull();
+}
+template <std::same_as<TaggedValue> T> i32 asInt(const T &val) {
+  return val.asInt();
+}
+template <std::same_as<TaggedValue> T> f32 asFloat(const T &val) {
+  return val.asFloat();
+}
+template <std::same_as<TaggedValue> T> bool asBool(const T &val) {
+  return val.asBool();
+}
+template <std::same_as<TaggedValue> T> std::string asString(const T &val) {
+  return val.asString();
+}
+
+} // namespace NovelMind::scripting
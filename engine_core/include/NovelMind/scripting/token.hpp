@@ -10,6 +10,7 @@
 
 #include "NovelMind/core/types.hpp"
 #include <string>
+#include <string_view>
 
 namespace NovelMind::scripting {
 
@@ -132,6 +133,41 @@ struct Token {
   }
 };
 
+/**
+ * @brief Non-owning token produced by Lexer::tokenizeViews()
+ *
+ * The lexeme points into the source buffer, or into the lexer arena for
+ * string literals that contained escape sequences. Both must outlive the
+ * token.
+ */
+struct TokenView {
+  TokenType type;
+  std::string_view lexeme;
+  SourceLocation location;
+
+  union {
+    i32 intValue;
+    f32 floatValue;
+  };
+
+  TokenView() : type(TokenType::EndOfFile), lexeme(), location(), intValue(0) {}
+
+  TokenView(TokenType t, std::string_view lex, SourceLocation loc)
+      : type(t), lexeme(lex), location(loc), intValue(0) {}
+
+  /// View an owning token (valid while @p token is alive)
+  explicit TokenView(const Token &token)
+      : type(token.type), lexeme(token.lexeme), location(token.location),
+        intValue(token.intValue) {}
+
+  /// Materialize an owning copy
+  [[nodiscard]] Token toToken() const {
+    Token token(type, std::string(lexeme), location);
+    token.intValue = intValue;
+    return token;
+  }
+};
+
 /**
  * @brief Convert token type to string for debugging
  */
@@ -88,6 +88,15 @@ public:
    */
   void setReportDeadCode(bool report);
 
+  /**
+   * @brief Treat characters and scenes defined in other files as defined
+   *
+   * Used when each file of a project is validated on its own. External
+   * symbols never produce unused warnings; redefining one is an error.
+   */
+  void setExternalSymbols(std::vector<std::string> characters,
+                          std::vector<std::string> scenes);
+
 private:
   // Reset state for new validation
   void reset();
@@ -161,6 +170,9 @@ private:
   SourceLocation m_currentLocation;
 
   // Configuration
+  std::unordered_set<std::string> m_externalCharacters;
+  std::unordered_set<std::string> m_externalScenes;
+
   bool m_reportUnused = true;
   bool m_reportDeadCode = true;
 
@@ -3,27 +3,111 @@
 #include "NovelMind/core/result.hpp"
 #include "NovelMind/core/types.hpp"
 #include "NovelMind/scripting/opcode.hpp"
+#include "NovelMind/scripting/tagged_value.hpp"
 #include "NovelMind/scripting/value.hpp"
+#include <array>
 #include <functional>
+#include <memory>
+#include <span>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
 namespace NovelMind::scripting {
 
+class CompiledScriptImage;
+class ScriptProfiler;
+
+/**
+ * @brief Interpreter loop used by VirtualMachine::run()
+ *
+ * Threaded runs straight-line bytecode without per-instruction state checks
+ * until an opcode yields (HALT, VN commands, CALL). On GCC/Clang it uses
+ * direct-threaded code (computed goto); elsewhere, or when built with
+ * NOVELMIND_VM_SWITCH_DISPATCH, it falls back to the Portable loop.
+ * Portable is the same engine dispatching through a switch; it is built
+ * everywhere so it can be tested and compared on any toolchain.
+ * Switch uses the original step()-per-instruction loop.
+ * step() always executes exactly one instruction regardless of the mode.
+ */
+enum class DispatchMode : u8 { Switch, Threaded, Portable };
+
+/**
+ * @brief Arguments passed to a native opcode handler
+ *
+ * A view over VM-owned storage, valid only for the duration of the call.
+ * Handlers must not re-enter run()/step() while inspecting it.
+ *
+ * Per opcode:
+ * - SAY: text = line, fromTop(0) = speaker (may be null)
+ * - SHOW_CHARACTER: fromTop(1) = id (null -> use text), fromTop(0) = position
+ * - CHOICE: operand = option count, option(i) = i-th option text
+ * - TRANSITION: text = type, fromTop(0) = duration bits
+ * - STOP_MUSIC: fromTop(0) = optional fade-out duration bits
+ * - SHOW_BACKGROUND/HIDE_CHARACTER/PLAY_SOUND/PLAY_MUSIC/CALL: text
+ * - WAIT: operand = duration bits; GOTO_SCENE: operand = entry point
+ */
+struct NativeCallArgs {
+  OpCode opcode = OpCode::NOP;
+  u32 operand = 0;
+  std::string_view text;               // String operand, empty if none
+  std::span<const TaggedValue> values; // Consumed stack values, push order
+
+  /**
+   * @brief Value at @p depth below the top of the consumed stack slice
+   * @return The value, or null when fewer values were on the stack
+   */
+  [[nodiscard]] const TaggedValue &fromTop(usize depth) const {
+    static const TaggedValue kNull;
+    return depth < values.size() ? values[values.size() - 1 - depth] : kNull;
+  }
+
+  /**
+   * @brief CHOICE option @p index in declaration order
+   */
+  [[nodiscard]] const TaggedValue &option(usize index) const {
+    return fromTop(static_cast<usize>(operand) - 1 - index);
+  }
+};
+
 class VirtualMachine {
 public:
   using NativeCallback = std::function<void(const std::vector<Value> &)>;
+  using NativeHandlerFn = void (*)(void *context, const NativeCallArgs &args);
 
   VirtualMachine();
   ~VirtualMachine();
 
+  /**
+   * @brief Load a program, copying it into VM-owned storage
+   */
   Result<void> load(const std::vector<Instruction> &program,
                     const std::vector<std::string> &stringTable);
+
+  /**
+   * @brief Run straight from a mapped NMC2 image
+   *
+   * Nothing is copied: the VM executes the image's instruction array and
+   * string views in place and keeps @p image alive until the next load().
+   */
+  Result<void> load(std::shared_ptr<const CompiledScriptImage> image);
   void reset();
 
   bool step();
   void run();
+
+  /**
+   * @brief Run at most @p maxInstructions instructions
+   *
+   * Goes through the dispatch engine like run() but also returns after any
+   * native command or other yielding opcode, so the host can react to it
+   * before more script runs. Does not leave the VM in the running state
+   * that makes signalContinue() and resume() execute on their own.
+   *
+   * @return Instructions executed; 0 if the VM is halted, paused or waiting
+   */
+  u32 run(u32 maxInstructions);
   void pause();
   void resume();
 
@@ -34,37 +118,156 @@ public:
   [[nodiscard]] u32 getIP() const { return m_ip; }
   void setIP(u32 ip);
 
+  /// Loaded bytecode, exactly as compiled
+  [[nodiscard]] std::span<const Instruction> program() const {
+    return m_program;
+  }
+  /// String table of the loaded program, indexable by operands
+  [[nodiscard]] std::span<const std::string_view> strings() const {
+    return m_strings;
+  }
+
   void setVariable(const std::string &name, Value value);
   [[nodiscard]] Value getVariable(const std::string &name) const;
   [[nodiscard]] bool hasVariable(const std::string &name) const;
   [[nodiscard]] std::unordered_map<std::string, Value>
-  getAllVariables() const {
-    return m_variables;
-  }
+  getAllVariables() const;
 
   void setFlag(const std::string &name, bool value);
   [[nodiscard]] bool getFlag(const std::string &name) const;
-  [[nodiscard]] std::unordered_map<std::string, bool> getAllFlags() const {
-    return m_flags;
-  }
+  [[nodiscard]] std::unordered_map<std::string, bool> getAllFlags() const;
 
+  /**
+   * @brief Register a std::function callback receiving owned Value copies
+   *
+   * Convenient but allocates per call; replaces any native handler for @p op.
+   */
   void registerCallback(OpCode op, NativeCallback callback);
 
+  /**
+   * @brief Register an allocation-free handler for a native opcode
+   *
+   * Replaces any std::function callback for @p op. Pass nullptr to clear.
+   */
+  void registerNativeHandler(OpCode op, NativeHandlerFn fn, void *context);
+
+  /**
+   * @brief Bind a member function as the native handler for @p op
+   */
+  template <auto Method, typename T>
+  void bindNativeHandler(OpCode op, T *object) {
+    registerNativeHandler(
+        op,
+        [](void *context, const NativeCallArgs &args) {
+          (static_cast<T *>(context)->*Method)(args);
+        },
+        object);
+  }
+
+  void setDispatchMode(DispatchMode mode) { m_dispatchMode = mode; }
+  [[nodiscard]] DispatchMode getDispatchMode() const { return m_dispatchMode; }
+  /// False when Threaded falls back to the Portable loop
+  [[nodiscard]] static bool computedGotoAvailable();
+
+  /**
+   * @brief Attach an instruction profiler (nullptr to detach)
+   *
+   * While attached, run() uses the step() loop so every instruction is
+   * counted. The profiler must outlive the VM or be detached first.
+   */
+  void setProfiler(ScriptProfiler *profiler);
+  [[nodiscard]] ScriptProfiler *getProfiler() const { return m_profiler; }
+
   void signalContinue();
   void signalChoice(i32 choice);
 
 private:
+  /**
+   * @brief Dense storage for named script state
+   *
+   * Names are interned to slot indices once (at load time or on first use
+   * through the public API); bytecode then addresses values by slot only,
+   * through a per-program table from string index to slot.
+   * Slots are never removed, so indices stay valid across load() calls and
+   * values survive scene changes that reload the program.
+   */
+  template <typename T> struct SlotTable {
+    std::vector<std::string> names;
+    std::vector<T> values;
+    std::vector<u8> defined;
+    std::unordered_map<std::string, u32> index;
+
+    u32 intern(const std::string &name) {
+      auto it = index.find(name);
+      if (it != index.end()) {
+        return it->second;
+      }
+      u32 slot = static_cast<u32>(names.size());
+      names.push_back(name);
+      values.emplace_back();
+      defined.push_back(0);
+      index.emplace(name, slot);
+      return slot;
+    }
+
+    u32 intern(std::string_view name) { return intern(std::string(name)); }
+
+    [[nodiscard]] const T *find(const std::string &name) const {
+      auto it = index.find(name);
+      if (it == index.end() || !defined[it->second]) {
+        return nullptr;
+      }
+      return &values[it->second];
+    }
+  };
+
+  Result<void> bindProgram();
+  void resolveSlots();
+  // Engine loops; a @p budget of 0 means unbounded. With @p yieldOnSlow
+  // they return after the first opcode that leaves the inline set.
+  u64 runThreaded(u64 budget, bool yieldOnSlow);
+  u64 runComputedGoto(u64 budget, bool yieldOnSlow);
+  u64 runSwitchLoop(u64 budget, bool yieldOnSlow);
   void executeInstruction(const Instruction &instr);
-  void push(Value value);
-  Value pop();
-  [[nodiscard]] const std::string &getString(u32 index) const;
-
-  std::vector<Instruction> m_program;
-  std::vector<std::string> m_stringTable;
-  std::vector<Value> m_stack;
-  std::unordered_map<std::string, Value> m_variables;
-  std::unordered_map<std::string, bool> m_flags;
-  std::unordered_map<OpCode, NativeCallback> m_callbacks;
+  void dispatchNative(const Instruction &instr);
+  template <OpCode Op> void applyBinary();
+  template <OpCode Op> bool compareTop();
+  template <OpCode Op> void branchUnless(u32 target);
+  void push(TaggedValue value);
+  TaggedValue pop();
+  [[nodiscard]] const std::string_view &getString(u32 index) const;
+
+  // Views of the program being run: either the VM-owned copies below or
+  // the sections of m_image. Instructions are never rewritten.
+  std::span<const Instruction> m_program;
+  std::span<const std::string_view> m_strings;
+  std::vector<Instruction> m_ownedProgram;
+  std::vector<std::string> m_ownedStrings;
+  std::vector<std::string_view> m_ownedStringViews;
+  std::shared_ptr<const CompiledScriptImage> m_image;
+  // String index -> slot for the names the program uses
+  std::vector<u32> m_variableSlots;
+  std::vector<u32> m_flagSlots;
+  std::vector<TaggedValue> m_stack;
+  SlotTable<TaggedValue> m_variables;
+  SlotTable<u8> m_flags; // u8 rather than bool to avoid vector<bool>
+  struct NativeHandler {
+    NativeHandlerFn fn = nullptr;
+    void *context = nullptr;
+  };
+
+  // Opcode-indexed; u8 opcodes make a flat table cheaper than hashing
+  std::array<NativeHandler, 256> m_nativeHandlers{};
+  std::array<NativeCallback, 256> m_callbacks;
+  std::vector<TaggedValue> m_callArgs; // Reused scratch for NativeCallArgs
+
+  // Direct-threaded translation of m_program (label addresses), rebuilt
+  // lazily whenever m_programVersion changes.
+  std::vector<const void *> m_threadedCode;
+  u32 m_programVersion = 0;
+  u32 m_threadedVersion = 0;
+  DispatchMode m_dispatchMode = DispatchMode::Threaded;
+  ScriptProfiler *m_profiler = nullptr;
 
   u32 m_ip;
   bool m_running;
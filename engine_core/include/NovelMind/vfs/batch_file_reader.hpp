@@ -0,0 +1,80 @@
+#pragma once
+
+/**
+ * @file batch_file_reader.hpp
+ * @brief Reads many file ranges with a deep I/O queue
+ *
+ * Reading a scene's assets one blocking call at a time leaves the disk idle
+ * between requests. BatchFileReader takes the whole list up front and keeps
+ * up to queueDepth reads in flight:
+ *
+ * - IoUring: one submission ring (Linux 5.1+), reads are queued and reaped
+ *   from the calling thread without extra threads.
+ * - ThreadPool: worker threads issuing pread, used where io_uring is not
+ *   built in, not supported by the kernel or blocked by a sandbox.
+ *
+ * Auto picks io_uring when a ring can be created and falls back otherwise,
+ * so callers never need to check. Results come back in request order.
+ */
+
+#include "NovelMind/core/result.hpp"
+#include "NovelMind/core/shared_buffer.hpp"
+#include "NovelMind/core/types.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace NovelMind::VFS {
+
+enum class BatchReadEngine : u8 { Auto, IoUring, ThreadPool };
+
+struct BatchReadConfig {
+  BatchReadEngine engine = BatchReadEngine::Auto;
+  u32 queueDepth = 64; ///< Reads in flight at once
+  u32 threads = 4;     ///< Workers for the thread pool engine
+};
+
+struct BatchReadRequest {
+  std::string path;
+  u64 offset = 0;
+  std::optional<usize> size; ///< nullopt reads to the end of the file
+};
+
+class BatchFileReader {
+public:
+  explicit BatchFileReader(BatchReadConfig config = {});
+  ~BatchFileReader();
+
+  BatchFileReader(const BatchFileReader &) = delete;
+  BatchFileReader &operator=(const BatchFileReader &) = delete;
+
+  /**
+   * @brief Read every request; one result per request, in order
+   *
+   * A range past the end of its file is truncated, not an error. Safe to
+   * call from several threads; batches sharing the ring run one at a time.
+   */
+  [[nodiscard]] std::vector<Result<SharedBuffer>>
+  read(std::span<const BatchReadRequest> requests);
+
+  /// Engine actually in use: IoUring or ThreadPool, never Auto
+  [[nodiscard]] BatchReadEngine engine() const { return m_engine.load(); }
+  [[nodiscard]] const BatchReadConfig &config() const { return m_config; }
+
+  /// True when this build and kernel can create an io_uring
+  [[nodiscard]] static bool ioUringAvailable();
+
+private:
+  struct Ring;
+
+  BatchReadConfig m_config;
+  std::atomic<BatchReadEngine> m_engine{BatchReadEngine::ThreadPool};
+  std::unique_ptr<Ring> m_ring;
+  std::mutex m_ringMutex;
+};
+
+} // namespace NovelMind::VFS
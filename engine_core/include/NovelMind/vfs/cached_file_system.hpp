@@ -1,17 +1,19 @@
 #pragma once
 
 #include "NovelMind/core/types.hpp"
+#include "NovelMind/vfs/resource_cache.hpp"
 #include "NovelMind/vfs/virtual_fs.hpp"
-#include <list>
 #include <memory>
-#include <unordered_map>
 
 namespace NovelMind::vfs {
 
 class CachedFileSystem final : public IVirtualFileSystem {
 public:
-  explicit CachedFileSystem(std::unique_ptr<IVirtualFileSystem> inner,
-                            usize maxBytes = 64 * 1024 * 1024);
+  /// @param maxBytes Cache budget; 0 = unbounded
+  explicit CachedFileSystem(
+      std::unique_ptr<IVirtualFileSystem> inner,
+      usize maxBytes = 64 * 1024 * 1024,
+      VFS::CachePolicy policy = VFS::CachePolicy::CostAware);
 
   Result<void> mount(const std::string &packPath) override;
   void unmount(const std::string &packPath) override;
@@ -20,6 +22,10 @@ public:
   [[nodiscard]] Result<std::vector<u8>>
   readFile(const std::string &resourceId) const override;
 
+  /// Cache hits share the cached bytes
+  [[nodiscard]] Result<SharedBuffer>
+  readShared(const std::string &resourceId) const override;
+
   [[nodiscard]] bool exists(const std::string &resourceId) const override;
   [[nodiscard]] std::optional<ResourceInfo>
   getInfo(const std::string &resourceId) const override;
@@ -30,23 +36,15 @@ public:
   void setMaxBytes(usize maxBytes);
   void clearCache();
 
-private:
-  struct CacheEntry {
-    std::vector<u8> data;
-    usize size = 0;
-  };
-
-  void touch(const std::string &resourceId) const;
-  void evictIfNeeded() const;
-
-  mutable std::unordered_map<std::string,
-                             std::pair<CacheEntry,
-                                       std::list<std::string>::iterator>>
-      m_cache;
-  mutable std::list<std::string> m_lru;
-  mutable usize m_currentBytes = 0;
-  usize m_maxBytes = 0;
+  /// Keep @p resourceId cached while it is in use; false if not cached
+  bool pin(const std::string &resourceId);
+  void unpin(const std::string &resourceId);
 
+  [[nodiscard]] VFS::CacheStats cacheStats() const;
+
+private:
+  // Misses are weighted by how long the inner read took
+  mutable VFS::ResourceCache m_cache;
   std::unique_ptr<IVirtualFileSystem> m_inner;
 };
 
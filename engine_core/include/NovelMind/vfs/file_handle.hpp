@@ -3,6 +3,8 @@
 #include "NovelMind/core/result.hpp"
 #include "NovelMind/core/types.hpp"
 #include <cstddef>
+#include <fstream>
+#include <string>
 #include <vector>
 
 namespace NovelMind::VFS {
@@ -46,4 +48,23 @@ private:
   bool m_valid = false;
 };
 
+/// Streams a file from disk; nothing is read until asked for
+class DiskFileHandle : public IFileHandle {
+public:
+  explicit DiskFileHandle(const std::string &path);
+
+  [[nodiscard]] bool isValid() const override;
+  [[nodiscard]] usize size() const override;
+  [[nodiscard]] usize position() const override;
+  [[nodiscard]] bool isEof() const override;
+
+  Result<usize> read(u8 *buffer, usize count) override;
+  Result<void> seek(i64 offset, SeekOrigin origin) override;
+
+private:
+  std::ifstream m_file;
+  usize m_size = 0;
+  usize m_position = 0;
+};
+
 } // namespace NovelMind::VFS
@@ -1,14 +1,26 @@
 #pragma once
 
+#include "NovelMind/core/shared_buffer.hpp"
+#include "NovelMind/vfs/batch_file_reader.hpp"
 #include "NovelMind/vfs/file_handle.hpp"
+#include "NovelMind/vfs/file_watcher.hpp"
 #include "NovelMind/vfs/resource_id.hpp"
+#include <deque>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <string>
 #include <vector>
 
 namespace NovelMind::VFS {
 
+/// One entry of a backend's change journal
+struct ResourceChange {
+  u64 sequence = 0; ///< Increases by one per change within a backend
+  ResourceId id;    ///< Empty when changes were lost: treat all as changed
+  FileChangeKind kind = FileChangeKind::Modified;
+};
+
 class IFileSystemBackend {
 public:
   virtual ~IFileSystemBackend() = default;
@@ -24,6 +36,25 @@ public:
   [[nodiscard]] virtual std::vector<ResourceId>
   list(ResourceType type = ResourceType::Unknown) const = 0;
 
+  /**
+   * @brief Read several resources in one call; one result per id, in order
+   *
+   * Backends with real I/O override this to keep many reads in flight.
+   * The default opens and reads each id in turn.
+   */
+  [[nodiscard]] virtual std::vector<Result<SharedBuffer>>
+  readMany(std::span<const ResourceId> ids);
+
+  /**
+   * @brief Changes to this backend's resources since the previous call
+   *
+   * Only backends over storage that can change while running report
+   * anything; see OverlayBackend.
+   */
+  [[nodiscard]] virtual std::vector<ResourceChange> pollChanges() {
+    return {};
+  }
+
   virtual Result<void> initialize() { return Result<void>::ok(); }
   virtual void shutdown() {}
 };
@@ -63,4 +94,83 @@ private:
   std::unordered_map<ResourceId, ResourceEntry> m_resources;
 };
 
+/**
+ * @brief Loose files under a root directory, e.g. an unpacked mod folder
+ *
+ * Resource ids are paths relative to the root with '/' separators; ids
+ * that would escape the root are treated as missing. readMany() batches
+ * through a BatchFileReader.
+ */
+class DirectoryBackend : public IFileSystemBackend {
+public:
+  explicit DirectoryBackend(std::string root, u32 priority = 50,
+                            BatchReadConfig batchConfig = {});
+  ~DirectoryBackend() override = default;
+
+  [[nodiscard]] std::string name() const override {
+    return "directory:" + m_root;
+  }
+  [[nodiscard]] u32 priority() const override { return m_priority; }
+
+  [[nodiscard]] std::unique_ptr<IFileHandle>
+  open(const ResourceId &id) override;
+  [[nodiscard]] bool exists(const ResourceId &id) const override;
+  [[nodiscard]] std::optional<ResourceInfo>
+  getInfo(const ResourceId &id) const override;
+  [[nodiscard]] std::vector<ResourceId> list(ResourceType type) const override;
+  [[nodiscard]] std::vector<Result<SharedBuffer>>
+  readMany(std::span<const ResourceId> ids) override;
+
+  [[nodiscard]] const std::string &root() const { return m_root; }
+  [[nodiscard]] BatchReadEngine batchEngine() const {
+    return m_reader.engine();
+  }
+
+private:
+  /// Path of @p id on disk, or empty when it is not a safe relative path
+  [[nodiscard]] std::string pathOf(const ResourceId &id) const;
+
+  std::string m_root;
+  u32 m_priority;
+  BatchFileReader m_reader;
+};
+
+/**
+ * @brief Watched loose-file directory layered over packs, for development
+ *
+ * Files under the root shadow the same ids in lower-priority backends and
+ * are watched for edits from initialize() on (see FileWatcher). Each change
+ * gets an entry in a bounded journal, so tools can ask what changed since
+ * the last sequence number they saw.
+ */
+class OverlayBackend : public DirectoryBackend {
+public:
+  explicit OverlayBackend(std::string root, u32 priority = 1000,
+                          FileWatcherConfig watcherConfig = {},
+                          usize journalCapacity = 4096);
+  ~OverlayBackend() override = default;
+
+  [[nodiscard]] std::string name() const override {
+    return "overlay:" + root();
+  }
+
+  Result<void> initialize() override;
+  void shutdown() override;
+
+  /// Drains the watcher into the journal and returns the new entries
+  [[nodiscard]] std::vector<ResourceChange> pollChanges() override;
+
+  /// Retained journal entries after @p sequence, oldest first
+  [[nodiscard]] std::vector<ResourceChange> changesSince(u64 sequence) const;
+  [[nodiscard]] u64 lastSequence() const;
+  [[nodiscard]] bool isWatching() const { return m_watcher.isWatching(); }
+
+private:
+  FileWatcher m_watcher;
+  usize m_journalCapacity;
+  mutable std::mutex m_journalMutex;
+  std::deque<ResourceChange> m_journal;
+  u64 m_sequence = 0;
+};
+
 } // namespace NovelMind::VFS
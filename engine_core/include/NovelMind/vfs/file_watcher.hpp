@@ -0,0 +1,89 @@
+#pragma once
+
+/**
+ * @file file_watcher.hpp
+ * @brief Reports files added, modified or removed under a directory tree
+ *
+ * On Linux the tree is watched with inotify, so poll() only drains queued
+ * events and costs nothing while files are unchanged. Elsewhere, or when
+ * forced, poll() rescans the tree at most once per interval and compares
+ * modification times and sizes.
+ *
+ * Changes are coalesced per path between polls: a file written several
+ * times is reported once, and a file created and deleted again is not
+ * reported at all. If the kernel queue overflows, a single change with an
+ * empty path is reported; treat everything as changed.
+ */
+
+#include "NovelMind/core/result.hpp"
+#include "NovelMind/core/types.hpp"
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace NovelMind::VFS {
+
+enum class FileChangeKind : u8 { Added, Modified, Removed };
+
+struct FileChange {
+  std::string path; ///< Relative to the root, '/' separated
+  FileChangeKind kind = FileChangeKind::Modified;
+};
+
+struct FileWatcherConfig {
+  bool forcePolling = false;
+  u32 pollIntervalMs = 250; ///< Minimum time between rescans when polling
+};
+
+class FileWatcher {
+public:
+  explicit FileWatcher(std::string root, FileWatcherConfig config = {});
+  ~FileWatcher();
+
+  FileWatcher(const FileWatcher &) = delete;
+  FileWatcher &operator=(const FileWatcher &) = delete;
+
+  /// Begin watching; changes made before this are not reported
+  Result<void> start();
+  void stop();
+
+  [[nodiscard]] bool isWatching() const { return m_watching; }
+  /// True when the OS pushes events instead of the tree being rescanned
+  [[nodiscard]] bool usesNotifications() const { return m_notifyFd >= 0; }
+  [[nodiscard]] const std::string &root() const { return m_root; }
+
+  /// Changes since the previous poll; never blocks
+  [[nodiscard]] std::vector<FileChange> poll();
+
+private:
+  struct FileStamp {
+    i64 modified = 0;
+    u64 size = 0;
+  };
+
+  void record(const std::string &path, FileChangeKind kind);
+  [[nodiscard]] std::vector<FileChange> takeChanges();
+  [[nodiscard]] std::unordered_map<std::string, FileStamp> scan() const;
+  void pollScan();
+  void pollNotifications();
+  void watchDirectory(const std::string &relative, bool reportFiles);
+
+  std::string m_root;
+  FileWatcherConfig m_config;
+  bool m_watching = false;
+
+  // Coalesced changes since the last poll, in first-seen order
+  std::vector<FileChange> m_changes;
+  std::unordered_map<std::string, usize> m_changeIndex;
+
+  // Polling
+  std::unordered_map<std::string, FileStamp> m_snapshot;
+  std::chrono::steady_clock::time_point m_lastScan;
+
+  // inotify
+  int m_notifyFd = -1;
+  std::unordered_map<int, std::string> m_watchDirs; // Descriptor -> dir
+};
+
+} // namespace NovelMind::VFS
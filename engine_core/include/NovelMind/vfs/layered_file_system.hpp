@@ -0,0 +1,49 @@
+#pragma once
+
+#include "NovelMind/core/types.hpp"
+#include "NovelMind/vfs/virtual_file_system.hpp"
+#include "NovelMind/vfs/virtual_fs.hpp"
+#include <string>
+#include <vector>
+
+namespace NovelMind::vfs {
+
+/**
+ * @brief The engine's file system over prioritized VFS backends
+ *
+ * Packs mounted here become backends of one VFS::VirtualFileSystem, so
+ * higher-priority backends such as a development VFS::OverlayBackend
+ * shadow them. Reads share the VirtualFileSystem's cache, which its
+ * pollChanges() invalidates entry by entry.
+ */
+class LayeredFileSystem final : public IVirtualFileSystem {
+public:
+  explicit LayeredFileSystem(const VFS::VFSConfig &config = {});
+
+  /// Mount a secure pack as the backend "pack:<path>", below overlays
+  Result<void> mount(const std::string &packPath) override;
+  void unmount(const std::string &packPath) override;
+  void unmountAll() override;
+
+  [[nodiscard]] Result<std::vector<u8>>
+  readFile(const std::string &resourceId) const override;
+  [[nodiscard]] Result<SharedBuffer>
+  readShared(const std::string &resourceId) const override;
+  /// Batched through VFS::VirtualFileSystem::preload()
+  usize preload(std::span<const std::string> resourceIds) const override;
+
+  [[nodiscard]] bool exists(const std::string &resourceId) const override;
+  [[nodiscard]] std::optional<ResourceInfo>
+  getInfo(const std::string &resourceId) const override;
+  [[nodiscard]] std::vector<std::string>
+  listResources(ResourceType type = ResourceType::Unknown) const override;
+
+  /// The backend stack, e.g. to register an overlay or poll for changes
+  [[nodiscard]] VFS::VirtualFileSystem &layers() { return m_layers; }
+
+private:
+  mutable VFS::VirtualFileSystem m_layers;
+  std::vector<std::string> m_packs;
+};
+
+} // namespace NovelMind::vfs
@@ -18,6 +18,9 @@ public:
   [[nodiscard]] Result<std::vector<u8>>
   readFile(const std::string &resourceId) const override;
 
+  [[nodiscard]] Result<SharedBuffer>
+  readShared(const std::string &resourceId) const override;
+
   [[nodiscard]] bool exists(const std::string &resourceId) const override;
 
   [[nodiscard]] std::optional<ResourceInfo>
@@ -35,12 +38,12 @@ public:
 
 private:
   struct ResourceEntry {
-    std::vector<u8> data;
+    SharedBuffer data;
     ResourceType type;
     u32 checksum;
   };
 
-  [[nodiscard]] static u32 calculateChecksum(const std::vector<u8> &data);
+  [[nodiscard]] static u32 calculateChecksum(std::span<const u8> data);
 
   mutable std::mutex m_mutex;
   std::unordered_map<std::string, ResourceEntry> m_resources;
@@ -17,11 +17,12 @@
 
 #include "NovelMind/core/result.hpp"
 #include "NovelMind/core/types.hpp"
+#include "NovelMind/vfs/resource_index.hpp"
 #include "NovelMind/vfs/secure_pack_reader.hpp"
 #include "NovelMind/vfs/virtual_fs.hpp"
 #include <functional>
 #include <memory>
-#include <set>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -431,6 +432,8 @@ private:
                                   i32 priority);
   PackInfo readPackManifest(const std::string &path);
   void rebuildResourceIndex();
+  [[nodiscard]] std::optional<size_t>
+  findProvider(const std::string &resourceId) const;
   i32 calculateEffectivePriority(PackType type, i32 basePriority) const;
   void firePackLoaded(const PackInfo &info);
   void firePackUnloaded(const std::string &packId);
@@ -446,14 +449,14 @@ private:
     PackInfo info;
     std::unique_ptr<IVirtualFileSystem> reader;
     i32 effectivePriority = 0;
-    std::set<std::string> providedResources;
+    std::vector<std::string> providedResources; // Sorted, unique
   };
 
   std::vector<std::unique_ptr<LoadedPack>> m_packs;
   std::unordered_map<std::string, size_t> m_packIdToIndex;
 
-  // Resource index: resource ID -> pack index
-  std::unordered_map<std::string, size_t> m_resourceIndex;
+  // Resource index: resource ID -> (pack index, providedResources index)
+  ResourceIndex m_resourceIndex;
 
   // Mod load order
   std::vector<std::string> m_modLoadOrder;
@@ -0,0 +1,118 @@
+#pragma once
+
+/**
+ * @file pack_blocks.hpp
+ * @brief Block-compressed pack resources with random access
+ *
+ * A resource entry flagged PackFlags::Blocked stores its data as
+ * independently compressed fixed-size blocks:
+ *
+ *   PackBlockHeader | u64 offsets[blockCount + 1] | block data
+ *
+ * Offsets are relative to the first byte after the offset table. Every
+ * block except the last holds blockSize uncompressed bytes; a block whose
+ * stored size equals its uncompressed size is kept raw. Because blocks are
+ * independent, a range read decodes only the blocks it touches and a whole
+ * resource can be decoded on several threads.
+ *
+ * Codecs other than None depend on build options (NOVELMIND_HAS_ZLIB,
+ * NOVELMIND_HAS_LZ4, NOVELMIND_HAS_ZSTD); isBlockCodecAvailable() reports
+ * what this build can encode and decode.
+ */
+
+#include "NovelMind/core/result.hpp"
+#include "NovelMind/core/types.hpp"
+#include "NovelMind/vfs/virtual_fs.hpp"
+#include <span>
+#include <vector>
+
+namespace NovelMind::vfs {
+
+constexpr u32 PACK_BLOCK_MAGIC = 0x4B424D4E; // "NMBK" in little-endian
+constexpr u32 DEFAULT_PACK_BLOCK_SIZE = 64 * 1024;
+
+enum class BlockCodec : u8 { None = 0, Zlib = 1, Lz4 = 2, Zstd = 3 };
+
+struct PackBlockHeader {
+  u32 magic;
+  u8 codec;
+  u8 reserved[3];
+  u32 blockSize;
+  u32 blockCount;
+  u64 uncompressedSize;
+};
+
+[[nodiscard]] bool isBlockCodecAvailable(BlockCodec codec);
+
+[[nodiscard]] const char *blockCodecName(BlockCodec codec);
+
+/**
+ * @brief Codec a pack builder should use for @p type
+ *
+ * LZ4 for large binary assets where decode speed matters (textures, audio,
+ * fonts), zstd for text-like data that compresses well (scripts, scenes,
+ * localization). Falls back to zlib, then None, when a codec is not built
+ * in.
+ */
+[[nodiscard]] BlockCodec preferredBlockCodec(ResourceType type);
+
+/**
+ * @brief Compress @p data into the block layout
+ * @param jobs Threads used to compress blocks (1 = calling thread only)
+ */
+[[nodiscard]] Result<std::vector<u8>>
+encodeBlocks(std::span<const u8> data, BlockCodec codec,
+             u32 blockSize = DEFAULT_PACK_BLOCK_SIZE, unsigned jobs = 1);
+
+/**
+ * @brief Read-only view over block-encoded resource data
+ *
+ * Does not own the bytes; they must outlive the view.
+ */
+class BlockedResource {
+public:
+  /**
+   * @brief Validate the header and block table of @p encoded
+   */
+  [[nodiscard]] static Result<BlockedResource>
+  open(std::span<const u8> encoded);
+
+  [[nodiscard]] BlockCodec codec() const { return m_codec; }
+  [[nodiscard]] u32 blockSize() const { return m_blockSize; }
+  [[nodiscard]] u32 blockCount() const { return m_blockCount; }
+  [[nodiscard]] u64 size() const { return m_size; }
+
+  /// Uncompressed size of block @p index
+  [[nodiscard]] usize blockLength(u32 index) const;
+
+  /**
+   * @brief Decode block @p index into @p out (exactly blockLength() bytes)
+   */
+  [[nodiscard]] Result<void> decodeBlock(u32 index, std::span<u8> out) const;
+
+  /**
+   * @brief Decode bytes [offset, offset + out.size()) clamped to size()
+   * @return Number of bytes written
+   */
+  [[nodiscard]] Result<usize> read(u64 offset, std::span<u8> out) const;
+
+  /**
+   * @brief Decode the whole resource
+   * @param jobs Threads used to decode blocks (1 = calling thread only)
+   */
+  [[nodiscard]] Result<std::vector<u8>> readAll(unsigned jobs = 1) const;
+
+private:
+  BlockedResource() = default;
+
+  [[nodiscard]] u64 offsetAt(u32 index) const;
+
+  const u8 *m_offsets = nullptr;
+  const u8 *m_blocks = nullptr;
+  BlockCodec m_codec = BlockCodec::None;
+  u32 m_blockSize = 0;
+  u32 m_blockCount = 0;
+  u64 m_size = 0;
+};
+
+} // namespace NovelMind::vfs
@@ -1,15 +1,33 @@
 #pragma once
 
+/**
+ * @file pack_reader.hpp
+ * @brief Reader for plain (unencrypted, uncompressed) .nmres packs
+ *
+ * Each pack is memory-mapped once at mount time and its header, resource
+ * table, string table and every resource's byte range are validated then.
+ * Reads are served straight from the mapping without opening the file
+ * again. Readers work on an immutable snapshot of the mounted packs, so
+ * concurrent reads never wait on one another; mount/unmount publish a new
+ * snapshot together with one ResourceIndex over every mounted pack.
+ */
+
+#include "NovelMind/platform/mapped_file.hpp"
+#include "NovelMind/vfs/resource_id.hpp"
+#include "NovelMind/vfs/resource_index.hpp"
 #include "NovelMind/vfs/virtual_fs.hpp"
-#include <fstream>
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <mutex>
+#include <span>
 #include <unordered_map>
 
 namespace NovelMind::vfs {
 
 constexpr u32 PACK_MAGIC = 0x53524D4E; // "NMRS" in little-endian
 constexpr u16 PACK_VERSION_MAJOR = 1;
-constexpr u16 PACK_VERSION_MINOR = 0;
+constexpr u16 PACK_VERSION_MINOR = 1; // 1.1: block-compressed entries
 
 struct PackHeader {
   u32 magic;
@@ -39,7 +57,19 @@ enum class PackFlags : u32 {
   None = 0,
   Encrypted = 1 << 0,
   Compressed = 1 << 1,
-  Signed = 1 << 2
+  Signed = 1 << 2,
+  Blocked = 1 << 3 // Entry only: data uses the pack_blocks.hpp layout
+};
+
+/**
+ * @brief Bytes of one resource inside a mounted pack's mapping
+ *
+ * The view shares ownership of the mapping, so it stays valid after the
+ * pack is unmounted.
+ */
+struct PackResourceView {
+  std::shared_ptr<const platform::MappedFile> backing;
+  std::span<const u8> data;
 };
 
 class PackReader : public IVirtualFileSystem {
@@ -54,6 +84,46 @@ public:
   [[nodiscard]] Result<std::vector<u8>>
   readFile(const std::string &resourceId) const override;
 
+  /**
+   * @brief readFile() that shares the pack mapping instead of copying
+   *
+   * Blocked entries are decoded into a new buffer.
+   */
+  [[nodiscard]] Result<SharedBuffer>
+  readShared(const std::string &resourceId) const override;
+
+  /**
+   * @brief Zero-copy access to a resource's bytes
+   *
+   * Fails for entries flagged as blocked, compressed or encrypted, which
+   * need a decoded copy.
+   */
+  [[nodiscard]] Result<PackResourceView>
+  readView(const std::string &resourceId) const;
+
+  /**
+   * @brief readView() with the ID hash already computed
+   */
+  [[nodiscard]] Result<PackResourceView>
+  readView(const VFS::ResourceId &resourceId) const;
+
+  /**
+   * @brief Read uncompressed bytes [offset, offset + out.size())
+   *
+   * Blocked entries decode only the blocks covering the range, so seeking
+   * in a stream or peeking at a file header stays cheap.
+   * @return Bytes written; fewer than out.size() at the end of the resource
+   */
+  [[nodiscard]] Result<usize> readRange(const std::string &resourceId,
+                                        u64 offset, std::span<u8> out) const;
+
+  /**
+   * @brief Threads used to decode one blocked resource in readFile()
+   */
+  void setDecodeThreads(unsigned threads) {
+    m_decodeThreads = std::max(1u, threads);
+  }
+
   [[nodiscard]] bool exists(const std::string &resourceId) const override;
 
   [[nodiscard]] std::optional<ResourceInfo>
@@ -66,20 +136,54 @@ private:
   struct MountedPack {
     std::string path;
     PackHeader header;
-    std::unordered_map<std::string, PackResourceEntry> entries;
+    std::shared_ptr<const platform::MappedFile> file;
+    std::vector<PackResourceEntry> entries; // Only entries with a valid ID
     std::vector<std::string> stringTable;
-  };
 
-  Result<void> readPackHeader(std::ifstream &file, PackHeader &header);
-  Result<void> readResourceTable(std::ifstream &file, MountedPack &pack);
-  Result<void> readStringTable(std::ifstream &file, MountedPack &pack);
+    [[nodiscard]] const std::string &idOf(const PackResourceEntry &e) const {
+      return stringTable[e.idStringOffset];
+    }
+  };
 
-  [[nodiscard]] Result<std::vector<u8>>
-  readResourceData(const std::string &packPath,
-                   const PackResourceEntry &entry) const;
+  // Mounted packs in mount order; earlier packs win on duplicate ids
+  struct PackSet {
+    std::vector<std::shared_ptr<const MountedPack>> packs;
+    ResourceIndex index;
+  };
 
-  mutable std::mutex m_mutex;
-  std::unordered_map<std::string, MountedPack> m_packs;
+  static Result<void> readPackHeader(std::span<const u8> bytes,
+                                     PackHeader &header);
+  static Result<void> readResourceTable(std::span<const u8> bytes,
+                                        MountedPack &pack);
+  static Result<void> readStringTable(std::span<const u8> bytes,
+                                      MountedPack &pack);
+  static Result<void> validateEntry(std::span<const u8> bytes,
+                                    const PackHeader &header,
+                                    const PackResourceEntry &entry);
+
+  [[nodiscard]] std::shared_ptr<const PackSet> snapshot() const {
+    return m_packs.load(std::memory_order_acquire);
+  }
+
+  // Index every pack, then publish the set
+  void publish(std::vector<std::shared_ptr<const MountedPack>> packs);
+
+  // Pack owning @p resourceId in @p set, with its entry
+  [[nodiscard]] static std::pair<const MountedPack *,
+                                 const PackResourceEntry *>
+  find(const PackSet &set, u64 hash, std::string_view resourceId);
+
+  [[nodiscard]] static Result<PackResourceView>
+  viewOf(const MountedPack *pack, const PackResourceEntry *entry,
+         std::string_view resourceId);
+
+  [[nodiscard]] static std::span<const u8>
+  storedBytes(const MountedPack &pack, const PackResourceEntry &entry);
+
+  std::atomic<unsigned> m_decodeThreads{1};
+  std::mutex m_writeMutex; // Serializes mount/unmount only
+  std::atomic<std::shared_ptr<const PackSet>> m_packs{
+      std::make_shared<const PackSet>()};
 };
 
 } // namespace NovelMind::vfs
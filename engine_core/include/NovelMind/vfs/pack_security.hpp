@@ -2,7 +2,9 @@
 
 #include "NovelMind/core/result.hpp"
 #include "NovelMind/core/types.hpp"
+#include "NovelMind/platform/mapped_file.hpp"
 #include <array>
+#include <atomic>
 #include <iosfwd>
 #include <memory>
 #include <optional>
@@ -35,6 +37,18 @@ struct PackVerificationReport {
   std::string resourceId;
 };
 
+/**
+ * @brief When a chunk-hashed pack checks its data chunks
+ *
+ * Chunk-hashed packs carry a SHA-256 per fixed-size chunk of the data
+ * section, stored with the tables; the signature (and the header content
+ * hash) cover those tables rather than the whole file. Mount cost is then
+ * proportional to the table size and the data chunks can be hashed in
+ * parallel at mount (Eager) or each on the first read that touches it
+ * (Lazy). Either way no resource is returned from unverified bytes.
+ */
+enum class ChunkVerification { Eager, Lazy };
+
 struct PackResourceMeta {
   u32 type = 0;
   u64 uncompressedSize = 0;
@@ -69,10 +83,33 @@ public:
   verifyPackSignatureStream(std::istream &stream, usize size,
                             const u8 *signature, usize signatureSize);
 
+  /**
+   * @brief Check chunks [firstChunk, firstChunk + count) of @p data
+   * @param expected Hashes of every chunk of @p data
+   * @param jobs Threads used to hash chunks (1 = calling thread only)
+   */
+  [[nodiscard]] Result<PackVerificationReport>
+  verifyChunks(const u8 *data, usize size, u32 chunkSize,
+               const std::vector<std::array<u8, 32>> &expected,
+               usize firstChunk, usize count, unsigned jobs = 1);
+
   [[nodiscard]] static u32 calculateCrc32(const u8 *data, usize size);
   [[nodiscard]] static std::array<u8, 32> calculateSha256(const u8 *data,
                                                           usize size);
 
+  /**
+   * @brief SHA-256 of each @p chunkSize slice of @p data (last may be short)
+   */
+  [[nodiscard]] static std::vector<std::array<u8, 32>>
+  calculateChunkHashes(const u8 *data, usize size, u32 chunkSize,
+                       unsigned jobs = 1);
+
+  /**
+   * @brief Root over a chunk hash list: SHA-256 of the concatenated hashes
+   */
+  [[nodiscard]] static std::array<u8, 32>
+  calculateChunkRoot(const std::vector<std::array<u8, 32>> &chunkHashes);
+
 private:
 #ifdef NOVELMIND_HAS_OPENSSL
   struct EVPKeyDeleter {
@@ -114,6 +151,12 @@ public:
   Result<void> setPublicKeyPem(const std::string &pem);
   Result<void> setPublicKeyFromFile(const std::string &path);
 
+  /**
+   * @brief Configure verification of chunk-hashed packs opened afterwards
+   * @param threads Threads used for eager verification (0 = one per core)
+   */
+  void setChunkVerification(ChunkVerification mode, unsigned threads = 0);
+
   [[nodiscard]] Result<void> openPack(const std::string &path);
   void closePack();
 
@@ -130,6 +173,11 @@ public:
   getResourceMeta(const std::string &resourceId) const;
   [[nodiscard]] u32 packFlags() const { return m_header.flags; }
 
+  /**
+   * @brief Chunks of a chunk-hashed pack checked so far
+   */
+  [[nodiscard]] usize verifiedChunkCount() const;
+
 private:
   struct PackHeader {
     u32 magic;
@@ -163,6 +211,9 @@ private:
     u8 reserved[12];
   };
 
+  Result<void> loadChunkTable(std::ifstream &file, u64 tablesEnd);
+  Result<void> verifyChunkRange(u64 offset, u64 size);
+
   std::unique_ptr<PackDecryptor> m_decryptor;
   std::unique_ptr<PackIntegrityChecker> m_integrityChecker;
   std::string m_packPath;
@@ -171,8 +222,18 @@ private:
   u64 m_fileSize = 0;
   std::unordered_map<std::string, PackResourceEntry> m_entries;
   std::vector<std::string> m_stringTable;
+  ChunkVerification m_chunkVerification = ChunkVerification::Eager;
+  unsigned m_verifyThreads = 0;
+  u32 m_chunkSize = 0;
+  std::vector<std::array<u8, 32>> m_chunkHashes;
+  // Lazy reads may run on several threads at once. Two of them may hash
+  // the same chunk, which only repeats work; a flag is set after its
+  // chunk matched, so no read trusts bytes that were not checked.
+  std::vector<std::atomic<bool>> m_chunkVerified;
+  std::unique_ptr<platform::MappedFile> m_mapping;
   bool m_isOpen = false;
-  PackVerificationResult m_lastResult = PackVerificationResult::Valid;
+  std::atomic<PackVerificationResult> m_lastResult{
+      PackVerificationResult::Valid};
 };
 
 } // namespace NovelMind::VFS
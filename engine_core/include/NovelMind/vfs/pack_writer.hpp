@@ -0,0 +1,145 @@
+#pragma once
+
+/**
+ * @file pack_writer.hpp
+ * @brief Writes .nmres packs with deduplicated, play-ordered data
+ *
+ * Resource data is content addressed: resources whose bytes are identical
+ * are stored once and every PackResourceEntry for them points at the same
+ * range of the data section. PackReader only checks that each range lies
+ * inside the pack, so such packs mount unchanged.
+ *
+ * Stored payloads are laid out in the order the game first needs them
+ * (see setFirstUseOrder() and scripting::AssetPrefetcher::firstUseOrder()),
+ * so a cold start reads the pack mostly front to back. Payloads nobody
+ * listed follow in the order they were added.
+ *
+ * Example usage:
+ * @code
+ * PackWriter writer;
+ * writer.add("bg/room.png", roomBytes, ResourceType::Texture);
+ * writer.addFile("music/theme.ogg", "assets/theme.ogg", ResourceType::Music);
+ * writer.setFirstUseOrder(AssetPrefetcher::firstUseOrder(script));
+ * writer.write("game.nmres");
+ * writer.report().bytesSaved();
+ * @endcode
+ */
+
+#include "NovelMind/core/result.hpp"
+#include "NovelMind/core/types.hpp"
+#include "NovelMind/vfs/pack_blocks.hpp"
+#include "NovelMind/vfs/virtual_fs.hpp"
+#include <array>
+#include <map>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace NovelMind::vfs {
+
+struct PackWriterConfig {
+  /// Store identical resources once
+  bool deduplicate = true;
+  /// Resources at least this large are block-compressed with
+  /// preferredBlockCodec(); 0 stores everything uncompressed
+  usize blockThreshold = 0;
+  u32 blockSize = DEFAULT_PACK_BLOCK_SIZE;
+  unsigned jobs = 1; ///< Threads used to compress one resource
+};
+
+/// What the last PackWriter::build() or write() wrote
+struct PackLayoutReport {
+  u32 resourceCount = 0;
+  u32 blobCount = 0;     ///< Distinct payloads in the data section
+  u64 logicalBytes = 0;  ///< Data section size with one copy per resource
+  u64 storedBytes = 0;   ///< Data section size as written
+  u32 orderedBlobs = 0;  ///< Payloads placed by the first-use order
+  /// Bytes skipped or rewound reading the first-use order front to back,
+  /// with payloads in the order they were added
+  u64 seekDistanceBefore = 0;
+  /// The same with the layout that was written
+  u64 seekDistanceAfter = 0;
+
+  [[nodiscard]] u64 bytesSaved() const { return logicalBytes - storedBytes; }
+  /// Fraction of the seek distance removed by the layout, 0 to 1
+  [[nodiscard]] f64 seekReduction() const {
+    return seekDistanceBefore == 0
+               ? 0.0
+               : 1.0 - static_cast<f64>(seekDistanceAfter) /
+                           static_cast<f64>(seekDistanceBefore);
+  }
+};
+
+class PackWriter {
+public:
+  explicit PackWriter(PackWriterConfig config = {});
+
+  /**
+   * @brief Add a resource; fails if @p id was already added
+   */
+  Result<void> add(const std::string &id, std::span<const u8> data,
+                   ResourceType type);
+
+  /**
+   * @brief add() with the contents of the file at @p sourcePath
+   */
+  Result<void> addFile(const std::string &id, const std::string &sourcePath,
+                       ResourceType type);
+
+  /**
+   * @brief Resource ids in the order the game first reads them
+   *
+   * Ids that are not in the pack are ignored.
+   */
+  void setFirstUseOrder(std::vector<std::string> ids);
+
+  [[nodiscard]] usize resourceCount() const { return m_entries.size(); }
+
+  /// The complete pack file, in memory
+  [[nodiscard]] Result<std::vector<u8>> build();
+  /// Stream the pack to @p packPath without assembling it in memory.
+  /// Written to "<packPath>.tmp" and renamed over @p packPath, so readers
+  /// that have the old pack open or mapped keep seeing it whole.
+  Result<void> write(const std::string &packPath);
+
+  [[nodiscard]] const PackLayoutReport &report() const { return m_report; }
+
+private:
+  struct Blob {
+    std::vector<u8> bytes; // As stored: raw or block-encoded
+    u64 uncompressedSize = 0;
+    u32 flags = 0;
+    u32 checksum = 0; // CRC32 of the uncompressed bytes
+  };
+
+  struct Entry {
+    std::string id;
+    ResourceType type = ResourceType::Unknown;
+    usize blob = 0;
+  };
+
+  struct Layout {
+    std::vector<u8> tables;   // Header, resource table and string table
+    std::vector<usize> blobs; // Payloads in file order
+    u64 totalSize = 0;
+  };
+
+  /// Place the payloads and fill m_report
+  [[nodiscard]] Result<Layout> layout();
+  [[nodiscard]] std::vector<usize> firstUseBlobs() const;
+  [[nodiscard]] static u64 seekDistance(const std::vector<usize> &reads,
+                                        const std::vector<u64> &offsets,
+                                        const std::vector<Blob> &blobs);
+
+  PackWriterConfig m_config;
+  std::vector<Entry> m_entries;
+  std::unordered_map<std::string, usize> m_entryIndex;
+  std::vector<Blob> m_blobs;
+  // SHA-256 of the uncompressed bytes plus the codec -> blob
+  std::map<std::pair<std::array<u8, 32>, BlockCodec>, usize> m_blobIndex;
+  std::vector<std::string> m_firstUse;
+  PackLayoutReport m_report;
+};
+
+} // namespace NovelMind::vfs
@@ -1,9 +1,36 @@
 #pragma once
 
+/**
+ * @file resource_cache.hpp
+ * @brief Sharded, size-bounded cache of raw resource bytes
+ *
+ * Entries are spread over independently locked shards by ResourceId hash,
+ * so readers of different resources rarely contend. Each shard keeps its
+ * recency order in intrusive lists threaded through the entries. The byte
+ * budget is global: an insertion evicts from its own shard first and only
+ * then from the others.
+ *
+ * Eviction is chosen per cache:
+ * - LRU drops the least recently used entry.
+ * - ARC balances recently and frequently used entries, adapting to the
+ *   access pattern through ghost lists of recently evicted ids.
+ * - CostAware looks at the oldest few entries and drops the one that is
+ *   cheapest to reload per byte, so slow-to-decode assets outlive cheap
+ *   ones of the same age.
+ *
+ * Pinned entries are never evicted; the cache may exceed its budget while
+ * they are held.
+ *
+ * Entries are SharedBuffers: getShared() hands out the cached bytes
+ * themselves, and an evicted entry stays valid for whoever still holds it.
+ */
+
+#include "NovelMind/core/shared_buffer.hpp"
 #include "NovelMind/core/types.hpp"
 #include "NovelMind/vfs/resource_id.hpp"
-#include <chrono>
-#include <list>
+#include <array>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <unordered_map>
@@ -11,63 +38,107 @@
 
 namespace NovelMind::VFS {
 
-struct CacheEntry {
-  std::vector<u8> data;
-  std::chrono::steady_clock::time_point lastAccess;
-  usize accessCount = 0;
+enum class CachePolicy : u8 { LRU, ARC, CostAware };
+
+/// Number of ResourceType values, for per-type statistics
+inline constexpr usize kResourceTypeCount =
+    static_cast<usize>(ResourceType::Config) + 1;
+
+struct ResourceCacheConfig {
+  usize maxSize = 64 * 1024 * 1024;
+  usize shardCount = 16; ///< Rounded up to a power of two
+  CachePolicy policy = CachePolicy::LRU;
+};
+
+struct CacheTypeStats {
+  usize hitCount = 0;
+  usize missCount = 0;
+
+  [[nodiscard]] f64 hitRate() const {
+    const auto total = hitCount + missCount;
+    return total > 0 ? static_cast<f64>(hitCount) / static_cast<f64>(total)
+                     : 0.0;
+  }
 };
 
 struct CacheStats {
   usize totalSize = 0;
   usize entryCount = 0;
+  usize pinnedCount = 0;
   usize hitCount = 0;
   usize missCount = 0;
   usize evictionCount = 0;
+  std::array<CacheTypeStats, kResourceTypeCount> byType{};
 
   [[nodiscard]] f64 hitRate() const {
     const auto total = hitCount + missCount;
     return total > 0 ? static_cast<f64>(hitCount) / static_cast<f64>(total)
                      : 0.0;
   }
+
+  [[nodiscard]] f64 hitRate(ResourceType type) const {
+    return byType[static_cast<usize>(type)].hitRate();
+  }
 };
 
 class ResourceCache {
 public:
   explicit ResourceCache(usize maxSize = 64 * 1024 * 1024);
-  ~ResourceCache() = default;
+  explicit ResourceCache(const ResourceCacheConfig &config);
+  ~ResourceCache();
 
   ResourceCache(const ResourceCache &) = delete;
   ResourceCache &operator=(const ResourceCache &) = delete;
 
   void setMaxSize(usize maxSize);
-  [[nodiscard]] usize maxSize() const { return m_maxSize; }
+  [[nodiscard]] usize maxSize() const { return m_maxSize.load(); }
+  [[nodiscard]] CachePolicy policy() const { return m_policy; }
+  [[nodiscard]] usize shardCount() const { return m_shardCount; }
 
+  /// Copy of the entry; prefer getShared()
   [[nodiscard]] std::optional<std::vector<u8>> get(const ResourceId &id);
-  void put(const ResourceId &id, std::vector<u8> data);
+  [[nodiscard]] std::optional<SharedBuffer> getShared(const ResourceId &id);
+
+  /**
+   * @brief Insert or replace @p id
+   * @param reloadCost What a miss on this entry would cost, in units the
+   *        caller keeps consistent (e.g. microseconds spent reading and
+   *        decoding). Used by CachePolicy::CostAware; 0 = the data size.
+   */
+  void put(const ResourceId &id, SharedBuffer data, u64 reloadCost = 0);
+  void put(const ResourceId &id, std::vector<u8> data, u64 reloadCost = 0) {
+    put(id, SharedBuffer(std::move(data)), reloadCost);
+  }
   void remove(const ResourceId &id);
   void clear();
 
+  /// Keep @p id resident until a matching unpin(); false if not cached
+  bool pin(const ResourceId &id);
+  void unpin(const ResourceId &id);
+
   [[nodiscard]] bool contains(const ResourceId &id) const;
-  [[nodiscard]] usize currentSize() const { return m_currentSize; }
-  [[nodiscard]] usize entryCount() const { return m_cache.size(); }
+  [[nodiscard]] usize currentSize() const { return m_currentSize.load(); }
+  [[nodiscard]] usize entryCount() const;
 
   [[nodiscard]] CacheStats stats() const;
   void resetStats();
 
 private:
-  void evictIfNeeded(usize requiredSpace);
-  void updateAccessOrder(const ResourceId &id);
-
-  mutable std::mutex m_mutex;
-  usize m_maxSize;
-  usize m_currentSize = 0;
-
-  std::unordered_map<ResourceId, CacheEntry> m_cache;
-  std::list<ResourceId> m_accessOrder;
-  std::unordered_map<ResourceId, std::list<ResourceId>::iterator>
-      m_orderIterators;
-
-  mutable CacheStats m_stats;
+  struct Shard;
+  struct Node;
+
+  [[nodiscard]] Shard &shardFor(const ResourceId &id) const;
+  [[nodiscard]] usize shardCapacity() const;
+  [[nodiscard]] bool overBudget() const;
+  bool evictOne(Shard &shard, const Node *keep);
+  void evictToFit(const Shard *skip);
+
+  const CachePolicy m_policy;
+  usize m_shardCount = 0;
+  std::unique_ptr<Shard[]> m_shards;
+  std::atomic<usize> m_maxSize;
+  std::atomic<usize> m_currentSize{0};
+  std::atomic<usize> m_evictCursor{0};
 };
 
 } // namespace NovelMind::VFS
@@ -3,6 +3,7 @@
 #include "NovelMind/core/types.hpp"
 #include <functional>
 #include <string>
+#include <string_view>
 
 namespace NovelMind::VFS {
 
@@ -39,6 +40,9 @@ public:
 
   static ResourceType typeFromExtension(const std::string &path);
 
+  /// FNV-1a hash of @p id, identical to ResourceId(id).hash()
+  [[nodiscard]] static u64 hashOf(std::string_view id);
+
 private:
   void computeHash();
 
@@ -0,0 +1,77 @@
+#pragma once
+
+/**
+ * @file resource_index.hpp
+ * @brief Immutable hash index from resource ID to pack location
+ *
+ * Built once whenever the set of mounted packs changes. Keys are the 64-bit
+ * FNV-1a hashes from VFS::ResourceId, stored in a sorted array with a
+ * directory over the top hash bits, so a lookup is one directory read and,
+ * on average, one slot compare. Resource ID strings are not stored; the
+ * owner of the packs confirms a hit by comparing the ID it already holds
+ * for that location. The rare IDs that share a hash fall back to a string
+ * map.
+ */
+
+#include "NovelMind/core/types.hpp"
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace NovelMind::vfs {
+
+struct ResourceLocation {
+  u32 pack = 0;  // Index into the owner's pack list
+  u32 entry = 0; // Index into that pack's resource table
+};
+
+class ResourceIndex {
+public:
+  struct Candidate {
+    u64 hash = 0;
+    std::string_view id; // Must outlive build()
+    i32 priority = 0;    // Higher wins; ties go to the earlier candidate
+    ResourceLocation location;
+  };
+
+  ResourceIndex() = default;
+
+  /**
+   * @brief Build an index keeping the highest-priority location per ID
+   */
+  [[nodiscard]] static ResourceIndex build(std::vector<Candidate> candidates);
+
+  /**
+   * @brief Location for @p id, or nullptr
+   *
+   * @p hash must be VFS::ResourceId::hashOf(@p id). A hit may belong to a
+   * different ID with the same hash; callers verify against their own ID.
+   */
+  [[nodiscard]] const ResourceLocation *find(u64 hash,
+                                             std::string_view id) const;
+
+  [[nodiscard]] const ResourceLocation *find(std::string_view id) const;
+
+  /// Distinct resource IDs in the index
+  [[nodiscard]] usize size() const { return m_size; }
+  [[nodiscard]] bool empty() const { return m_size == 0; }
+
+  /// Heap bytes held by the index
+  [[nodiscard]] usize memoryUsage() const;
+
+private:
+  struct Slot {
+    u64 hash;
+    ResourceLocation location; // pack == kCollision: see m_collisions
+  };
+  static constexpr u32 kCollision = ~u32{0};
+
+  std::vector<Slot> m_slots;     // Sorted by hash
+  std::vector<u32> m_directory;  // First slot per top-bits bucket, + end
+  u32 m_shift = 64;
+  usize m_size = 0;
+  std::unordered_map<std::string, ResourceLocation> m_collisions;
+};
+
+} // namespace NovelMind::vfs
@@ -1,8 +1,10 @@
 #pragma once
 
 #include "NovelMind/core/result.hpp"
+#include "NovelMind/core/shared_buffer.hpp"
 #include "NovelMind/core/types.hpp"
 #include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -38,6 +40,34 @@ public:
   [[nodiscard]] virtual Result<std::vector<u8>>
   readFile(const std::string &resourceId) const = 0;
 
+  /**
+   * @brief Read a resource without copying it where the backend allows
+   *
+   * Backends that already hold the bytes (mapped packs, memory stores,
+   * caches) return a view sharing them. The default adopts readFile's
+   * vector.
+   */
+  [[nodiscard]] virtual Result<SharedBuffer>
+  readShared(const std::string &resourceId) const {
+    auto data = readFile(resourceId);
+    if (data.isError()) {
+      return Result<SharedBuffer>::error(data.error());
+    }
+    return Result<SharedBuffer>::ok(SharedBuffer(std::move(data).value()));
+  }
+
+  /**
+   * @brief Read @p resourceIds into this file system's cache in one batch
+   *
+   * Lets backends keep many reads in flight, e.g. for a scene's assets.
+   * File systems without a cache have nothing to warm.
+   * @return Number of ids now served from the cache
+   */
+  virtual usize preload(std::span<const std::string> resourceIds) const {
+    (void)resourceIds;
+    return 0;
+  }
+
   [[nodiscard]] virtual bool exists(const std::string &resourceId) const = 0;
 
   [[nodiscard]] virtual std::optional<ResourceInfo>
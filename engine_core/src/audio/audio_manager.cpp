@@ -195,8 +195,8 @@ void AudioManager::shutdown() {
 
   stopAll(0.0f);
   for (auto &source : m_sources) {
-    if (source && source->m_soundReady && source->m_sound) {
-      ma_sound_uninit(source->m_sound.get());
+    if (source) {
+      closeSound(*source);
     }
   }
   m_sources.clear();
@@ -704,72 +704,116 @@ AudioHandle AudioManager::createSource(const std::string &trackId,
   source->trackId = trackId;
   source->channel = channel;
 
+  if (!openSound(*source)) {
+    fireEvent(AudioEvent::Type::Error, handle, trackId);
+    return {};
+  }
+
+  m_sources.push_back(std::move(source));
+  return handle;
+}
+
+bool AudioManager::openSound(AudioSource &source) {
   auto sound = std::make_unique<ma_sound>();
   ma_uint32 flags = 0;
-  if (channel == AudioChannel::Music || channel == AudioChannel::Voice ||
-      channel == AudioChannel::Ambient) {
+  if (source.channel == AudioChannel::Music ||
+      source.channel == AudioChannel::Voice ||
+      source.channel == AudioChannel::Ambient) {
     flags |= MA_SOUND_FLAG_STREAM;
   }
 
   bool loaded = false;
   if (m_dataProvider) {
-    auto dataResult = m_dataProvider(trackId);
+    auto dataResult = m_dataProvider(source.trackId);
     if (dataResult.isOk() && !dataResult.value().empty()) {
-      source->m_memoryData = std::move(dataResult.value());
-      source->m_decoder = std::make_unique<ma_decoder>();
+      source.m_memoryData = std::move(dataResult.value());
+      source.m_decoder = std::make_unique<ma_decoder>();
       ma_decoder_config config = ma_decoder_config_init(
           ma_format_f32, ma_engine_get_channels(m_engine),
           ma_engine_get_sample_rate(m_engine));
-      if (ma_decoder_init_memory(source->m_memoryData.data(),
-                                 source->m_memoryData.size(), &config,
-                                 source->m_decoder.get()) == MA_SUCCESS) {
-        if (ma_sound_init_from_data_source(
-                m_engine, source->m_decoder.get(), flags, nullptr,
-                sound.get()) == MA_SUCCESS) {
+      if (ma_decoder_init_memory(source.m_memoryData.data(),
+                                 source.m_memoryData.size(), &config,
+                                 source.m_decoder.get()) == MA_SUCCESS) {
+        if (ma_sound_init_from_data_source(m_engine, source.m_decoder.get(),
+                                           flags, nullptr,
+                                           sound.get()) == MA_SUCCESS) {
           loaded = true;
-          source->m_decoderReady = true;
+          source.m_decoderReady = true;
         } else {
-          ma_decoder_uninit(source->m_decoder.get());
-          source->m_decoder.reset();
-          source->m_memoryData.clear();
+          ma_decoder_uninit(source.m_decoder.get());
+          source.m_decoder.reset();
+          source.m_memoryData = SharedBuffer();
         }
       } else {
-        source->m_decoder.reset();
-        source->m_memoryData.clear();
+        source.m_decoder.reset();
+        source.m_memoryData = SharedBuffer();
       }
     }
   }
 
   if (!loaded) {
-    if (ma_sound_init_from_file(m_engine, trackId.c_str(), flags, nullptr,
-                                nullptr, sound.get()) != MA_SUCCESS) {
-      fireEvent(AudioEvent::Type::Error, handle, trackId);
-      return {};
+    if (ma_sound_init_from_file(m_engine, source.trackId.c_str(), flags,
+                                nullptr, nullptr,
+                                sound.get()) != MA_SUCCESS) {
+      return false;
     }
   }
-  source->m_sound = std::move(sound);
-  source->m_soundReady = true;
+  source.m_sound = std::move(sound);
+  source.m_soundReady = true;
 
   float lengthSeconds = 0.0f;
-  ma_sound_get_length_in_seconds(source->m_sound.get(), &lengthSeconds);
-  source->m_duration = lengthSeconds;
+  ma_sound_get_length_in_seconds(source.m_sound.get(), &lengthSeconds);
+  source.m_duration = lengthSeconds;
+  return true;
+}
 
-  m_sources.push_back(std::move(source));
-  return handle;
+void AudioManager::closeSound(AudioSource &source) {
+  if (source.m_soundReady && source.m_sound) {
+    ma_sound_uninit(source.m_sound.get());
+  }
+  if (source.m_decoderReady && source.m_decoder) {
+    ma_decoder_uninit(source.m_decoder.get());
+  }
+  source.m_sound.reset();
+  source.m_soundReady = false;
+  source.m_decoder.reset();
+  source.m_decoderReady = false;
+  source.m_memoryData = SharedBuffer();
+}
+
+size_t AudioManager::reloadTrack(const std::string &trackId) {
+  if (!m_engineInitialized || !m_engine) {
+    return 0;
+  }
+
+  size_t reloaded = 0;
+  for (auto &source : m_sources) {
+    if (!source || source->trackId != trackId || !source->isPlaying()) {
+      continue;
+    }
+    closeSound(*source);
+    if (!openSound(*source)) {
+      source->stop();
+      fireEvent(AudioEvent::Type::Error, source->handle, trackId);
+      continue;
+    }
+    // Volume and looping are applied on the next update()
+    source->setPitch(source->m_pitch);
+    source->setPan(source->m_pan);
+    source->m_position = 0.0f;
+    ma_sound_start(source->m_sound.get());
+    ++reloaded;
+  }
+  return reloaded;
 }
 
 void AudioManager::releaseSource(AudioHandle handle) {
   m_sources.erase(std::remove_if(m_sources.begin(), m_sources.end(),
-                                 [&handle](const auto &s) {
+                                 [this, &handle](const auto &s) {
                                    if (!s || s->handle.id != handle.id) {
                                      return false;
                                    }
-                                   if (s->m_soundReady && s->m_sound) {
-                                     ma_sound_uninit(s->m_sound.get());
-                                   }
-                                   if (s->m_decoderReady && s->m_decoder) {
-                                     ma_decoder_uninit(s->m_decoder.get());
-                                   }
+                                   closeSound(*s);
                                    return true;
                                  }),
                   m_sources.end());
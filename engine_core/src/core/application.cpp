@@ -1,8 +1,6 @@
 #include "NovelMind/core/application.hpp"
+#include "NovelMind/core/debug_overlay.hpp"
 #include "NovelMind/core/logger.hpp"
-#include "NovelMind/vfs/cached_file_system.hpp"
-#include "NovelMind/vfs/memory_fs.hpp"
-#include "NovelMind/vfs/secure_pack_reader.hpp"
 
 namespace NovelMind::core {
 
@@ -28,26 +26,57 @@ Result<void> Application::initialize(const EngineConfig &config) {
 
   m_fileSystem = platform::createFileSystem();
 
-  std::unique_ptr<vfs::IVirtualFileSystem> baseFs;
+  VFS::VFSConfig vfsConfig;
+  vfsConfig.cachePolicy = VFS::CachePolicy::CostAware;
+  m_vfs = std::make_unique<vfs::LayeredFileSystem>(vfsConfig);
   if (!m_config.packFile.empty()) {
-    auto packFs = std::make_unique<vfs::SecurePackFileSystem>();
-    auto mountResult = packFs->mount(m_config.packFile);
+    auto mountResult = m_vfs->mount(m_config.packFile);
     if (mountResult.isError()) {
       return Result<void>::error(mountResult.error());
     }
-    baseFs = std::move(packFs);
-  } else {
-    baseFs = std::make_unique<vfs::MemoryFileSystem>();
   }
-  m_vfs = std::make_unique<vfs::CachedFileSystem>(std::move(baseFs));
+  if (!m_config.watchDirectory.empty()) {
+    // Loose files shadow the pack even if watching them fails
+    auto overlay =
+        std::make_unique<VFS::OverlayBackend>(m_config.watchDirectory);
+    m_assetOverlay = overlay.get();
+    m_vfs->layers().registerBackend(std::move(overlay));
+    auto watchResult = m_vfs->layers().initialize();
+    if (watchResult.isError()) {
+      NOVELMIND_LOG_WARN("Asset hot reload disabled: " + watchResult.error());
+    } else {
+      NOVELMIND_LOG_INFO("Watching " + m_config.watchDirectory +
+                         " for asset changes");
+    }
+  }
 
-  m_renderer = renderer::createRenderer();
+  m_renderer = renderer::createRenderer(m_config.renderer);
   auto renderResult = m_renderer->initialize(*m_window);
+  if (renderResult.isError() &&
+      m_config.renderer == renderer::RendererBackend::Auto) {
+    NOVELMIND_LOG_WARN("Renderer failed to start (" + renderResult.error() +
+                       "), using the software renderer");
+    m_renderer = renderer::createRenderer(renderer::RendererBackend::Software);
+    renderResult = m_renderer->initialize(*m_window);
+  }
   if (renderResult.isError()) {
     return Result<void>::error(renderResult.error());
   }
 
   m_resources = std::make_unique<resource::ResourceManager>(m_vfs.get());
+  if (!m_config.decodedCacheDirectory.empty()) {
+    m_decodedCache = std::make_unique<resource::DecodedAssetCache>(
+        resource::DecodedAssetCacheConfig{m_config.decodedCacheDirectory});
+    auto openResult = m_decodedCache->open();
+    if (openResult.isError()) {
+      NOVELMIND_LOG_WARN("Decoded asset cache disabled: " +
+                         openResult.error());
+      m_decodedCache.reset();
+    } else {
+      m_resources->setDecodedAssetCache(m_decodedCache.get());
+    }
+  }
+  m_resources->enableAsyncLoading();
   m_sceneGraph = std::make_unique<scene::SceneGraph>();
   m_sceneGraph->setResourceManager(m_resources.get());
 
@@ -56,12 +85,21 @@ Result<void> Application::initialize(const EngineConfig &config) {
   m_audio = std::make_unique<audio::AudioManager>();
   m_audio->setDataProvider([this](const std::string &id) {
     if (!m_resources) {
-      return Result<std::vector<u8>>::error("Resource manager unavailable");
+      return Result<SharedBuffer>::error("Resource manager unavailable");
     }
-    return m_resources->readData(id);
+    return m_resources->readShared(id);
   });
   m_audio->initialize();
 
+  if (m_assetOverlay && m_assetOverlay->isWatching()) {
+    // Music and sounds decode bytes read at play time; restart them
+    m_resources->addReloadListener([this](const std::string &id) {
+      if (m_audio) {
+        m_audio->reloadTrack(id);
+      }
+    });
+  }
+
   m_saveManager = std::make_unique<save::SaveManager>();
   m_localization = std::make_unique<localization::LocalizationManager>();
   if (m_sceneGraph) {
@@ -90,8 +128,10 @@ void Application::shutdown() {
     m_audio->shutdown();
   }
   m_audio.reset();
+  m_assetOverlay = nullptr;
   m_sceneGraph.reset();
   m_resources.reset();
+  m_decodedCache.reset();
   if (m_renderer) {
     m_renderer->shutdown();
   }
@@ -194,6 +234,10 @@ void Application::mainLoop() {
     if (m_audio) {
       m_audio->update(deltaTime);
     }
+    if (m_resources) {
+      pollAssetChanges();
+      m_resources->update();
+    }
 
     if (m_renderer) {
       m_renderer->beginFrame();
@@ -206,6 +250,16 @@ void Application::mainLoop() {
 
     if (m_renderer) {
       m_renderer->endFrame();
+
+      auto &overlay = Core::DebugOverlay::instance();
+      if (overlay.isEnabled()) {
+        const auto stats = m_renderer->getStats();
+        overlay.setDrawCalls(stats.drawCalls);
+        overlay.setMetric("Batches", static_cast<i64>(stats.batches),
+                          "Renderer");
+        overlay.setMetric("Vertices", static_cast<i64>(stats.vertices),
+                          "Renderer");
+      }
     }
 
     if (!m_renderer) {
@@ -214,4 +268,29 @@ void Application::mainLoop() {
   }
 }
 
+void Application::pollAssetChanges() {
+  if (!m_assetOverlay || !m_assetOverlay->isWatching()) {
+    return;
+  }
+
+  // Drops exactly the changed entries from the VFS cache, so the reloads
+  // below read the new bytes
+  for (const auto &change : m_vfs->layers().pollChanges()) {
+    if (change.id.isEmpty()) {
+      m_resources->reloadAll();
+      continue;
+    }
+    const usize reloaded = m_resources->reload(change.id.id());
+    NOVELMIND_LOG_DEBUG("Asset changed: " + change.id.id() + " (" +
+                        std::to_string(reloaded) + " reloaded)");
+  }
+
+  auto &overlay = Core::DebugOverlay::instance();
+  if (overlay.isEnabled()) {
+    overlay.setMetric("Changes",
+                      static_cast<i64>(m_assetOverlay->lastSequence()),
+                      "Assets");
+  }
+}
+
 } // namespace NovelMind::core
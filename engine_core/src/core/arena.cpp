@@ -0,0 +1,59 @@
+#include "NovelMind/core/arena.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace NovelMind::core {
+
+Arena::Arena(usize blockSize) : m_blockSize(std::max<usize>(blockSize, 64)) {}
+
+void Arena::addBlock(usize minSize) {
+  const usize size = std::max(m_blockSize, minSize);
+  m_blocks.push_back({std::make_unique<std::byte[]>(size), size});
+  m_offset = 0;
+}
+
+void *Arena::allocate(usize size, usize alignment) {
+  if (size == 0) {
+    size = 1;
+  }
+
+  if (!m_blocks.empty()) {
+    Block &block = m_blocks.back();
+    const auto base = reinterpret_cast<uintptr_t>(block.data.get());
+    const usize aligned =
+        ((base + m_offset + alignment - 1) & ~(alignment - 1)) - base;
+    if (aligned + size <= block.size) {
+      m_offset = aligned + size;
+      m_bytesUsed += size;
+      return block.data.get() + aligned;
+    }
+  }
+
+  // Oversized requests get a dedicated block; new blocks are max-aligned
+  addBlock(size + alignment);
+  Block &block = m_blocks.back();
+  const auto base = reinterpret_cast<uintptr_t>(block.data.get());
+  const usize aligned = ((base + alignment - 1) & ~(alignment - 1)) - base;
+  m_offset = aligned + size;
+  m_bytesUsed += size;
+  return block.data.get() + aligned;
+}
+
+std::string_view Arena::copyString(std::string_view str) {
+  if (str.empty()) {
+    return {};
+  }
+  char *dst = allocateChars(str.size());
+  std::memcpy(dst, str.data(), str.size());
+  return {dst, str.size()};
+}
+
+void Arena::reset() {
+  if (m_blocks.size() > 1) {
+    m_blocks.erase(m_blocks.begin() + 1, m_blocks.end());
+  }
+  m_offset = 0;
+  m_bytesUsed = 0;
+}
+
+} // namespace NovelMind::core
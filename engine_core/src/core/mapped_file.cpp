@@ -0,0 +1,162 @@
+#include "NovelMind/platform/mapped_file.hpp"
+#include <fstream>
+#include <utility>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace NovelMind::platform {
+
+namespace {
+
+Result<std::vector<u8>> readWholeFile(const std::string &path) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file.is_open()) {
+    return Result<std::vector<u8>>::error("Cannot open file: " + path);
+  }
+
+  const auto size = file.tellg();
+  if (size < 0) {
+    return Result<std::vector<u8>>::error("Cannot determine file size: " +
+                                          path);
+  }
+  file.seekg(0, std::ios::beg);
+
+  std::vector<u8> data(static_cast<usize>(size));
+  if (!data.empty() &&
+      !file.read(reinterpret_cast<char *>(data.data()),
+                 static_cast<std::streamsize>(data.size()))) {
+    return Result<std::vector<u8>>::error("Failed to read file: " + path);
+  }
+  return Result<std::vector<u8>>::ok(std::move(data));
+}
+
+} // namespace
+
+MappedFile::~MappedFile() { close(); }
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)),
+      m_size(std::exchange(other.m_size, 0)),
+      m_mapping(std::exchange(other.m_mapping, nullptr)),
+      m_buffer(std::move(other.m_buffer)) {
+  if (!m_mapping && !m_buffer.empty()) {
+    m_data = m_buffer.data();
+  }
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+  if (this != &other) {
+    close();
+    m_data = std::exchange(other.m_data, nullptr);
+    m_size = std::exchange(other.m_size, 0);
+    m_mapping = std::exchange(other.m_mapping, nullptr);
+    m_buffer = std::move(other.m_buffer);
+    if (!m_mapping && !m_buffer.empty()) {
+      m_data = m_buffer.data();
+    }
+  }
+  return *this;
+}
+
+MappedFile MappedFile::fromBuffer(std::vector<u8> buffer) {
+  MappedFile file;
+  file.m_buffer = std::move(buffer);
+  file.m_data = file.m_buffer.data();
+  file.m_size = file.m_buffer.size();
+  return file;
+}
+
+Result<MappedFile> MappedFile::open(const std::string &path) {
+#if defined(_WIN32)
+  HANDLE handle =
+      CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (handle == INVALID_HANDLE_VALUE) {
+    return Result<MappedFile>::error("Cannot open file: " + path);
+  }
+
+  LARGE_INTEGER size{};
+  if (!GetFileSizeEx(handle, &size)) {
+    CloseHandle(handle);
+    return Result<MappedFile>::error("Cannot determine file size: " + path);
+  }
+
+  MappedFile file;
+  if (size.QuadPart > 0) {
+    HANDLE mapping =
+        CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void *view =
+        mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (view) {
+      file.m_mapping = mapping;
+      file.m_data = static_cast<const u8 *>(view);
+      file.m_size = static_cast<usize>(size.QuadPart);
+    } else if (mapping) {
+      CloseHandle(mapping);
+    }
+  }
+  CloseHandle(handle);
+
+  if (file.m_mapping || size.QuadPart == 0) {
+    return Result<MappedFile>::ok(std::move(file));
+  }
+#else
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return Result<MappedFile>::error("Cannot open file: " + path);
+  }
+
+  struct stat st {};
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    return Result<MappedFile>::error("Cannot determine file size: " + path);
+  }
+
+  MappedFile file;
+  if (st.st_size > 0) {
+    void *base = ::mmap(nullptr, static_cast<usize>(st.st_size), PROT_READ,
+                        MAP_PRIVATE, fd, 0);
+    if (base != MAP_FAILED) {
+      file.m_mapping = base;
+      file.m_data = static_cast<const u8 *>(base);
+      file.m_size = static_cast<usize>(st.st_size);
+    }
+  }
+  ::close(fd);
+
+  if (file.m_mapping || st.st_size == 0) {
+    return Result<MappedFile>::ok(std::move(file));
+  }
+#endif
+
+  // Mapping failed (e.g. special files); fall back to a single read
+  auto data = readWholeFile(path);
+  if (data.isError()) {
+    return Result<MappedFile>::error(data.error());
+  }
+  return Result<MappedFile>::ok(fromBuffer(std::move(data).value()));
+}
+
+void MappedFile::close() {
+  if (m_mapping) {
+#if defined(_WIN32)
+    UnmapViewOfFile(m_data);
+    CloseHandle(static_cast<HANDLE>(m_mapping));
+#else
+    ::munmap(m_mapping, m_size);
+#endif
+  }
+  m_mapping = nullptr;
+  m_data = nullptr;
+  m_size = 0;
+  m_buffer.clear();
+}
+
+} // namespace NovelMind::platform
@@ -20,7 +20,8 @@ public:
                                  SDL_GetError());
     }
 
-    u32 flags = SDL_WINDOW_SHOWN | SDL_WINDOW_OPENGL;
+    u32 flags = SDL_WINDOW_OPENGL;
+    flags |= config.hidden ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN;
     if (config.fullscreen) {
       flags |= SDL_WINDOW_FULLSCREEN;
     }
@@ -106,6 +107,31 @@ public:
     }
   }
 
+  bool presentPixels(std::span<const u8> rgba, i32 width,
+                     i32 height) override {
+    if (!m_window || width <= 0 || height <= 0 ||
+        rgba.size() < static_cast<usize>(width) * static_cast<usize>(height) *
+                          4) {
+      return false;
+    }
+    SDL_Surface *target = SDL_GetWindowSurface(m_window);
+    if (!target) {
+      return false;
+    }
+    // Wraps the caller's pixels; SDL only reads them during the blit
+    SDL_Surface *frame = SDL_CreateRGBSurfaceWithFormatFrom(
+        const_cast<u8 *>(rgba.data()), width, height, 32, width * 4,
+        SDL_PIXELFORMAT_RGBA32);
+    if (!frame) {
+      return false;
+    }
+    SDL_SetSurfaceBlendMode(frame, SDL_BLENDMODE_NONE);
+    const bool shown = SDL_BlitScaled(frame, nullptr, target, nullptr) == 0 &&
+                       SDL_UpdateWindowSurface(m_window) == 0;
+    SDL_FreeSurface(frame);
+    return shown;
+  }
+
   [[nodiscard]] void *getNativeHandle() const override { return m_window; }
 
 private:
@@ -158,6 +184,12 @@ public:
     // Nothing to do
   }
 
+  bool presentPixels(std::span<const u8> /*rgba*/, i32 /*width*/,
+                     i32 /*height*/) override {
+    // Nothing to show
+    return true;
+  }
+
   [[nodiscard]] void *getNativeHandle() const override { return nullptr; }
 
   void requestClose() { m_shouldClose = true; }
@@ -15,8 +15,10 @@ Font::Font() : m_handle(nullptr), m_size(0) {}
 Font::~Font() { destroy(); }
 
 Font::Font(Font &&other) noexcept
-    : m_handle(other.m_handle), m_size(other.m_size) {
+    : m_handle(other.m_handle), m_library(other.m_library),
+      m_size(other.m_size), m_data(std::move(other.m_data)) {
   other.m_handle = nullptr;
+  other.m_library = nullptr;
   other.m_size = 0;
 }
 
@@ -24,14 +26,21 @@ Font &Font::operator=(Font &&other) noexcept {
   if (this != &other) {
     destroy();
     m_handle = other.m_handle;
+    m_library = other.m_library;
     m_size = other.m_size;
+    m_data = std::move(other.m_data);
     other.m_handle = nullptr;
+    other.m_library = nullptr;
     other.m_size = 0;
   }
   return *this;
 }
 
 Result<void> Font::loadFromMemory(const std::vector<u8> &data, i32 size) {
+  return loadFromMemory(SharedBuffer::copyOf(data), size);
+}
+
+Result<void> Font::loadFromMemory(SharedBuffer data, i32 size) {
   if (data.empty() || size <= 0) {
     return Result<void>::error("Invalid font data or size");
   }
@@ -58,6 +67,7 @@ Result<void> Font::loadFromMemory(const std::vector<u8> &data, i32 size) {
   m_handle = face;
   m_size = size;
   m_library = ft;
+  m_data = std::move(data);
   NOVELMIND_LOG_INFO("Font loaded via FreeType, size " + std::to_string(size));
   return Result<void>::ok();
 #else
@@ -84,6 +94,7 @@ void Font::destroy() {
     m_handle = nullptr;
   }
   m_size = 0;
+  m_data = SharedBuffer();
 }
 
 bool Font::isValid() const { return m_size > 0; }
@@ -103,16 +114,48 @@ Result<void> FontAtlas::build(const Font &font, const std::string &charset,
   m_lineHeight = 0;
   m_valid = false;
 
+  auto atlas = rasterize(font, charset, padding);
+  if (atlas.isError()) {
+    return Result<void>::error(atlas.error());
+  }
+  return load(atlas.value());
+}
+
+Result<void> FontAtlas::load(const FontAtlasImage &atlas) {
+  m_glyphs = atlas.glyphs;
+  m_lineHeight = atlas.lineHeight;
+  m_valid = false;
+
+  auto texRes = m_texture.loadFromImage(atlas.image);
+  if (texRes.isError()) {
+    return texRes;
+  }
+
+  m_valid = m_texture.isValid();
+  if (!m_valid) {
+    return Result<void>::error("FontAtlas texture is not valid");
+  }
+  return Result<void>::ok();
+}
+
+Result<FontAtlasImage> FontAtlas::rasterize(const Font &font,
+                                            const std::string &charset,
+                                            i32 padding) {
   if (!font.isValid()) {
-    return Result<void>::error("FontAtlas::build - font is not loaded");
+    return Result<FontAtlasImage>::error(
+        "FontAtlas::build - font is not loaded");
   }
 
 #if defined(NOVELMIND_HAS_FREETYPE)
   auto *face = static_cast<FT_Face>(font.getNativeHandle());
   if (!face) {
-    return Result<void>::error("FontAtlas::build - missing FreeType face");
+    return Result<FontAtlasImage>::error(
+        "FontAtlas::build - missing FreeType face");
   }
 
+  FontAtlasImage atlas;
+  auto &glyphs = atlas.glyphs;
+
   // Fixed atlas width for simplicity; height will grow as needed.
   const i32 atlasWidth = 1024;
   i32 atlasHeight = padding * 2;
@@ -125,10 +168,10 @@ Result<void> FontAtlas::build(const Font &font, const std::string &charset,
 
   // Record line height from the face metrics
   if (face->size) {
-    m_lineHeight =
+    atlas.lineHeight =
         static_cast<i32>(face->size->metrics.height / 64); // 26.6 fixed point
   } else {
-    m_lineHeight = font.getSize();
+    atlas.lineHeight = font.getSize();
   }
 
   auto addGlyph = [&](char32_t codepoint) -> Result<void> {
@@ -145,7 +188,7 @@ Result<void> FontAtlas::build(const Font &font, const std::string &charset,
       GlyphInfo info{};
       info.advanceX = static_cast<f32>(g->advance.x) / 64.0f;
       info.uv = Rect(0, 0, 0, 0);
-      m_glyphs[codepoint] = info;
+      glyphs[codepoint] = info;
       return Result<void>::ok();
     }
 
@@ -191,7 +234,7 @@ Result<void> FontAtlas::build(const Font &font, const std::string &charset,
     info.uv = Rect(static_cast<f32>(cursorX), static_cast<f32>(cursorY),
                    static_cast<f32>(glyphW), static_cast<f32>(glyphH));
 
-    m_glyphs[codepoint] = info;
+    glyphs[codepoint] = info;
 
     cursorX += glyphW + padding;
     return Result<void>::ok();
@@ -213,29 +256,22 @@ Result<void> FontAtlas::build(const Font &font, const std::string &charset,
   atlasPixels.resize(static_cast<size_t>(atlasWidth * atlasHeight * 4), 0);
 
   // Normalize UVs now that final atlas dimensions are known
-  for (auto &[_, glyph] : m_glyphs) {
+  for (auto &[_, glyph] : glyphs) {
     glyph.uv.x /= static_cast<f32>(atlasWidth);
     glyph.uv.y /= static_cast<f32>(atlasHeight);
     glyph.uv.width /= static_cast<f32>(atlasWidth);
     glyph.uv.height /= static_cast<f32>(atlasHeight);
   }
 
-  auto texRes =
-      m_texture.loadFromRGBA(atlasPixels.data(), atlasWidth, atlasHeight);
-  if (texRes.isError()) {
-    return texRes;
-  }
-
-  m_valid = m_texture.isValid();
-  if (!m_valid) {
-    return Result<void>::error("FontAtlas texture is not valid");
-  }
-  return Result<void>::ok();
+  atlas.image.width = atlasWidth;
+  atlas.image.height = atlasHeight;
+  atlas.image.pixels = std::move(atlasPixels);
+  return Result<FontAtlasImage>::ok(std::move(atlas));
 #else
   (void)font;
   (void)charset;
   (void)padding;
-  return Result<void>::error("FreeType not available for FontAtlas");
+  return Result<FontAtlasImage>::error("FreeType not available for FontAtlas");
 #endif
 }
 
@@ -247,4 +283,29 @@ const GlyphInfo *FontAtlas::getGlyph(char32_t codepoint) const {
   return nullptr;
 }
 
+std::shared_ptr<FontAtlas> FontAtlasCache::get(const Font &font) {
+  auto it = m_atlases.find(&font);
+  if (it != m_atlases.end()) {
+    return it->second;
+  }
+
+  static const std::string kDefaultCharset = []() {
+    std::string charset;
+    charset.reserve(95);
+    for (int c = 32; c <= 126; ++c) {
+      charset.push_back(static_cast<char>(c));
+    }
+    return charset;
+  }();
+
+  auto atlas = std::make_shared<FontAtlas>();
+  auto buildResult = atlas->build(font, kDefaultCharset);
+  if (buildResult.isError()) {
+    NOVELMIND_LOG_WARN("Failed to build font atlas: " + buildResult.error());
+  }
+
+  m_atlases[&font] = atlas;
+  return atlas;
+}
+
 } // namespace NovelMind::renderer
@@ -1,6 +1,10 @@
 #include "NovelMind/renderer/renderer.hpp"
 #include "NovelMind/core/logger.hpp"
 #include "NovelMind/platform/window.hpp"
+#include "NovelMind/renderer/software_renderer.hpp"
+#include "NovelMind/renderer/sprite_batch.hpp"
+#include <algorithm>
+#include <cstddef>
 #include <limits>
 #include <unordered_map>
 
@@ -82,7 +86,13 @@ private:
 
 class SDLOpenGLRenderer : public IRenderer {
 public:
-  SDLOpenGLRenderer() = default;
+  SDLOpenGLRenderer() {
+    m_batch.setFlushCallback(
+        [this](std::span<const SpriteVertex> vertices,
+               std::span<const SpriteDrawCommand> commands) {
+          submit(vertices, commands);
+        });
+  }
   ~SDLOpenGLRenderer() override { shutdown(); }
 
   Result<void> initialize(platform::IWindow &window) override {
@@ -116,12 +126,18 @@ public:
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    createBuffers();
+
     NOVELMIND_LOG_INFO("SDL OpenGL renderer initialized");
     return Result<void>::ok();
   }
 
   void shutdown() override {
     if (m_glContext && m_window) {
+      destroyBuffers();
       SDL_GL_DeleteContext(m_glContext);
       m_glContext = nullptr;
     }
@@ -129,82 +145,50 @@ public:
   }
 
   void beginFrame() override {
+    m_batch.resetStats();
     glClearColor(0.05f, 0.05f, 0.06f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     glLoadIdentity();
   }
 
   void endFrame() override {
+    m_batch.flush();
+    m_lastStats = m_batch.stats();
     if (m_window) {
       SDL_GL_SwapWindow(m_window);
     }
   }
 
   void clear(const Color &color) override {
+    m_batch.flush();
     glClearColor(color.r / 255.0f, color.g / 255.0f, color.b / 255.0f,
                  color.a / 255.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
   }
 
-  void setBlendMode(BlendMode mode) override {
-    switch (mode) {
-    case BlendMode::None:
-      glDisable(GL_BLEND);
-      break;
-    case BlendMode::Alpha:
-      glEnable(GL_BLEND);
-      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-      break;
-    case BlendMode::Additive:
-      glEnable(GL_BLEND);
-      glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-      break;
-    case BlendMode::Multiply:
-      glEnable(GL_BLEND);
-      glBlendFunc(GL_DST_COLOR, GL_ONE_MINUS_SRC_ALPHA);
-      break;
-    }
-  }
+  void setBlendMode(BlendMode mode) override { m_batch.setBlendMode(mode); }
 
   void drawSprite(const Texture &texture, const Transform2D &transform,
                   const Color &tint) override {
-    if (!texture.isValid()) {
-      return;
-    }
-    drawTexturedQuad(texture, Rect{0, 0, static_cast<f32>(texture.getWidth()),
-                                   static_cast<f32>(texture.getHeight())},
-                     transform, tint);
+    m_batch.draw(texture,
+                 Rect{0, 0, static_cast<f32>(texture.getWidth()),
+                      static_cast<f32>(texture.getHeight())},
+                 transform, tint);
   }
 
   void drawSprite(const Texture &texture, const Rect &sourceRect,
                   const Transform2D &transform,
                   const Color &tint) override {
-    if (!texture.isValid()) {
-      return;
-    }
-    drawTexturedQuad(texture, sourceRect, transform, tint);
+    m_batch.draw(texture, sourceRect, transform, tint);
   }
 
   void drawRect(const Rect &rect, const Color &color) override {
-    glColor4f(color.r / 255.0f, color.g / 255.0f, color.b / 255.0f,
-              color.a / 255.0f);
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(rect.x, rect.y);
-    glVertex2f(rect.x + rect.width, rect.y);
-    glVertex2f(rect.x + rect.width, rect.y + rect.height);
-    glVertex2f(rect.x, rect.y + rect.height);
-    glEnd();
+    // One-pixel edges, so outlines batch with everything else
+    m_batch.outline(rect, color);
   }
 
   void fillRect(const Rect &rect, const Color &color) override {
-    glColor4f(color.r / 255.0f, color.g / 255.0f, color.b / 255.0f,
-              color.a / 255.0f);
-    glBegin(GL_QUADS);
-    glVertex2f(rect.x, rect.y);
-    glVertex2f(rect.x + rect.width, rect.y);
-    glVertex2f(rect.x + rect.width, rect.y + rect.height);
-    glVertex2f(rect.x, rect.y + rect.height);
-    glEnd();
+    m_batch.fill(rect, color);
   }
 
   void drawText(const Font &font, const std::string &text, f32 x, f32 y,
@@ -212,156 +196,240 @@ public:
     if (text.empty()) {
       return;
     }
-
-    auto atlas = getOrBuildAtlas(font);
-    if (!atlas || !atlas->isValid()) {
-      return;
-    }
-
-    const Texture &texture = atlas->getAtlasTexture();
-    if (!texture.isValid()) {
-      return;
-    }
-
-    f32 penX = x;
-    f32 baseline = y + static_cast<f32>(atlas->getLineHeight());
-
-    for (char c : text) {
-      if (c == '\n') {
-        penX = x;
-        baseline += static_cast<f32>(atlas->getLineHeight());
-        continue;
-      }
-
-      const auto *glyph =
-          atlas->getGlyph(static_cast<unsigned char>(c));
-      if (!glyph) {
-        penX += static_cast<f32>(font.getSize()) * 0.5f;
-        continue;
-      }
-
-      Rect src{glyph->uv.x * texture.getWidth(),
-               glyph->uv.y * texture.getHeight(),
-               glyph->uv.width * texture.getWidth(),
-               glyph->uv.height * texture.getHeight()};
-
-      Transform2D transform;
-      transform.x = penX + glyph->bearingX;
-      transform.y = baseline - glyph->bearingY;
-      transform.scaleX = 1.0f;
-      transform.scaleY = 1.0f;
-      transform.rotation = 0.0f;
-      transform.anchorX = 0.0f;
-      transform.anchorY = 0.0f;
-
-      drawTexturedQuad(texture, src, transform, color);
-
-      penX += glyph->advanceX;
+    if (auto atlas = m_fontAtlases.get(font)) {
+      m_batch.drawText(*atlas, text, x, y, color,
+                       static_cast<f32>(font.getSize()) * 0.5f);
     }
   }
 
   void setFade(f32 alpha, const Color &color) override {
-    glDisable(GL_TEXTURE_2D);
-    glColor4f(color.r / 255.0f, color.g / 255.0f, color.b / 255.0f,
-              alpha);
-    glBegin(GL_QUADS);
-    glVertex2f(0, 0);
-    glVertex2f(static_cast<f32>(m_width), 0);
-    glVertex2f(static_cast<f32>(m_width), static_cast<f32>(m_height));
-    glVertex2f(0, static_cast<f32>(m_height));
-    glEnd();
-    glEnable(GL_TEXTURE_2D);
+    const auto a = static_cast<u8>(std::clamp(alpha, 0.0f, 1.0f) * 255.0f);
+    m_batch.fill(Rect{0, 0, static_cast<f32>(m_width),
+                      static_cast<f32>(m_height)},
+                 Color(color.r, color.g, color.b, a));
   }
 
   [[nodiscard]] i32 getWidth() const override { return m_width; }
   [[nodiscard]] i32 getHeight() const override { return m_height; }
 
-private:
-  std::shared_ptr<FontAtlas> getOrBuildAtlas(const Font &font) {
-    const Font *key = &font;
-    auto it = m_fontAtlases.find(key);
-    if (it != m_fontAtlases.end()) {
-      return it->second;
-    }
+  [[nodiscard]] RenderStats getStats() const override { return m_lastStats; }
 
-    auto atlas = std::make_shared<FontAtlas>();
-    static const std::string kDefaultCharset = []() {
-      std::string charset;
-      charset.reserve(95);
-      for (int c = 32; c <= 126; ++c) {
-        charset.push_back(static_cast<char>(c));
-      }
-      return charset;
-    }();
-
-    auto buildResult = atlas->build(font, kDefaultCharset);
-    if (buildResult.isError()) {
-      NOVELMIND_LOG_WARN("Failed to build font atlas: " +
-                         buildResult.error());
+  [[nodiscard]] Result<ImageData> captureFrame() override {
+    if (!m_glContext) {
+      return Result<ImageData>::error("OpenGL renderer not initialized");
+    }
+    m_batch.flush();
+
+    ImageData image;
+    image.width = m_width;
+    image.height = m_height;
+    const usize row = static_cast<usize>(m_width) * 4;
+    const auto height = static_cast<usize>(m_height);
+    image.pixels.resize(row * height);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadBuffer(GL_BACK);
+    glReadPixels(0, 0, m_width, m_height, GL_RGBA, GL_UNSIGNED_BYTE,
+                 image.pixels.data());
+    if (glGetError() != GL_NO_ERROR) {
+      return Result<ImageData>::error("glReadPixels failed");
     }
 
-    m_fontAtlases[key] = atlas;
-    return atlas;
+    // GL returns the bottom row first
+    for (usize y = 0; y < height / 2; ++y) {
+      u8 *top = image.pixels.data() + y * row;
+      u8 *bottom = image.pixels.data() + (height - 1 - y) * row;
+      std::swap_ranges(top, top + row, bottom);
+    }
+    return Result<ImageData>::ok(std::move(image));
   }
 
-  void drawTexturedQuad(const Texture &texture, const Rect &sourceRect,
-                        const Transform2D &transform, const Color &tint) {
-    const auto handle =
-        reinterpret_cast<uintptr_t>(texture.getNativeHandle());
-    if (handle > static_cast<uintptr_t>(std::numeric_limits<GLuint>::max())) {
+private:
+  void createBuffers() {
+    m_indices = SpriteBatch::quadIndices(m_batch.config().maxQuads);
+
+    m_genBuffers = reinterpret_cast<PFNGLGENBUFFERSPROC>(
+        SDL_GL_GetProcAddress("glGenBuffers"));
+    m_deleteBuffers = reinterpret_cast<PFNGLDELETEBUFFERSPROC>(
+        SDL_GL_GetProcAddress("glDeleteBuffers"));
+    m_bindBuffer = reinterpret_cast<PFNGLBINDBUFFERPROC>(
+        SDL_GL_GetProcAddress("glBindBuffer"));
+    m_bufferData = reinterpret_cast<PFNGLBUFFERDATAPROC>(
+        SDL_GL_GetProcAddress("glBufferData"));
+    m_bufferSubData = reinterpret_cast<PFNGLBUFFERSUBDATAPROC>(
+        SDL_GL_GetProcAddress("glBufferSubData"));
+    if (!m_genBuffers || !m_deleteBuffers || !m_bindBuffer || !m_bufferData ||
+        !m_bufferSubData) {
+      NOVELMIND_LOG_WARN("OpenGL buffer objects unavailable, drawing from "
+                         "client memory");
       return;
     }
-    GLuint texId = static_cast<GLuint>(handle);
-    glBindTexture(GL_TEXTURE_2D, texId);
-
-    glPushMatrix();
-    glTranslatef(transform.x, transform.y, 0.0f);
-    glRotatef(transform.rotation, 0.0f, 0.0f, 1.0f);
-    glScalef(transform.scaleX, transform.scaleY, 1.0f);
-    glTranslatef(-transform.anchorX, -transform.anchorY, 0.0f);
-
-    const f32 u0 = sourceRect.x / static_cast<f32>(texture.getWidth());
-    const f32 v0 = sourceRect.y / static_cast<f32>(texture.getHeight());
-    const f32 u1 =
-        (sourceRect.x + sourceRect.width) / static_cast<f32>(texture.getWidth());
-    const f32 v1 = (sourceRect.y + sourceRect.height) /
-                   static_cast<f32>(texture.getHeight());
 
-    glColor4f(tint.r / 255.0f, tint.g / 255.0f, tint.b / 255.0f,
-              tint.a / 255.0f);
+    GLuint buffers[2] = {0, 0};
+    m_genBuffers(2, buffers);
+    m_vertexBuffer = buffers[0];
+    m_indexBuffer = buffers[1];
+
+    m_bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer);
+    m_bufferData(GL_ELEMENT_ARRAY_BUFFER,
+                 static_cast<GLsizeiptr>(m_indices.size() * sizeof(u16)),
+                 m_indices.data(), GL_STATIC_DRAW);
+    m_vertexBufferBytes = static_cast<GLsizeiptr>(
+        m_batch.config().maxQuads * 4 * sizeof(SpriteVertex));
+    m_bindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+    m_bufferData(GL_ARRAY_BUFFER, m_vertexBufferBytes, nullptr,
+                 GL_STREAM_DRAW);
+  }
 
-    glBegin(GL_QUADS);
-    glTexCoord2f(u0, v0);
-    glVertex2f(0.0f, 0.0f);
+  void destroyBuffers() {
+    if (m_vertexBuffer != 0) {
+      const GLuint buffers[2] = {m_vertexBuffer, m_indexBuffer};
+      m_deleteBuffers(2, buffers);
+      m_vertexBuffer = 0;
+      m_indexBuffer = 0;
+    }
+  }
 
-    glTexCoord2f(u1, v0);
-    glVertex2f(sourceRect.width, 0.0f);
+  void submit(std::span<const SpriteVertex> vertices,
+              std::span<const SpriteDrawCommand> commands) {
+    // Offsets into the bound buffers, or pointers into client memory
+    const u8 *vertexBase = nullptr;
+    const u8 *indexBase = nullptr;
+    if (m_vertexBuffer != 0) {
+      m_bindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+      // Orphan the previous contents so the driver need not wait for the
+      // draws still reading them
+      m_bufferData(GL_ARRAY_BUFFER, m_vertexBufferBytes, nullptr,
+                   GL_STREAM_DRAW);
+      m_bufferSubData(GL_ARRAY_BUFFER, 0,
+                      static_cast<GLsizeiptr>(vertices.size_bytes()),
+                      vertices.data());
+      m_bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer);
+    } else {
+      vertexBase = reinterpret_cast<const u8 *>(vertices.data());
+      indexBase = reinterpret_cast<const u8 *>(m_indices.data());
+    }
+    const auto at = [](const u8 *base, usize offset) -> const void * {
+      return base ? static_cast<const void *>(base + offset)
+                  : reinterpret_cast<const void *>(offset);
+    };
+
+    constexpr auto stride = static_cast<GLsizei>(sizeof(SpriteVertex));
+    glVertexPointer(2, GL_FLOAT, stride,
+                    at(vertexBase, offsetof(SpriteVertex, x)));
+    glTexCoordPointer(2, GL_FLOAT, stride,
+                      at(vertexBase, offsetof(SpriteVertex, u)));
+    glColorPointer(4, GL_UNSIGNED_BYTE, stride,
+                   at(vertexBase, offsetof(SpriteVertex, r)));
+
+    bool first = true;
+    BlendMode blend = BlendMode::Alpha;
+    bool texturing = true;
+    GLuint bound = 0;
+    for (const auto &command : commands) {
+      if (first || command.blend != blend) {
+        blend = command.blend;
+        applyBlendMode(blend);
+      }
+      if (command.texture) {
+        const auto handle =
+            reinterpret_cast<uintptr_t>(command.texture.handle);
+        if (handle >
+            static_cast<uintptr_t>(std::numeric_limits<GLuint>::max())) {
+          continue;
+        }
+        if (first || !texturing) {
+          glEnable(GL_TEXTURE_2D);
+          texturing = true;
+        }
+        const auto texId = static_cast<GLuint>(handle);
+        if (first || texId != bound) {
+          glBindTexture(GL_TEXTURE_2D, texId);
+          bound = texId;
+        }
+      } else if (first || texturing) {
+        glDisable(GL_TEXTURE_2D);
+        texturing = false;
+      }
+      first = false;
 
-    glTexCoord2f(u1, v1);
-    glVertex2f(sourceRect.width, sourceRect.height);
+      glDrawElements(GL_TRIANGLES,
+                     static_cast<GLsizei>(command.quadCount * 6),
+                     GL_UNSIGNED_SHORT,
+                     at(indexBase, static_cast<usize>(command.firstQuad) * 6 *
+                                       sizeof(u16)));
+    }
 
-    glTexCoord2f(u0, v1);
-    glVertex2f(0.0f, sourceRect.height);
-    glEnd();
+    glEnable(GL_TEXTURE_2D);
+    if (m_vertexBuffer != 0) {
+      m_bindBuffer(GL_ARRAY_BUFFER, 0);
+      m_bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+  }
 
-    glPopMatrix();
+  static void applyBlendMode(BlendMode mode) {
+    switch (mode) {
+    case BlendMode::None:
+      glDisable(GL_BLEND);
+      break;
+    case BlendMode::Alpha:
+      glEnable(GL_BLEND);
+      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+      break;
+    case BlendMode::Additive:
+      glEnable(GL_BLEND);
+      glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+      break;
+    case BlendMode::Multiply:
+      glEnable(GL_BLEND);
+      glBlendFunc(GL_DST_COLOR, GL_ONE_MINUS_SRC_ALPHA);
+      break;
+    }
   }
 
   SDL_Window *m_window = nullptr;
   SDL_GLContext m_glContext = nullptr;
   i32 m_width = 0;
   i32 m_height = 0;
-  std::unordered_map<const Font *, std::shared_ptr<FontAtlas>> m_fontAtlases;
+  FontAtlasCache m_fontAtlases;
+
+  SpriteBatch m_batch;
+  RenderStats m_lastStats;
+
+  // Streamed vertex buffer and a fixed quad index buffer; both stay 0
+  // when buffer objects are unavailable and client arrays are used
+  std::vector<u16> m_indices;
+  GLuint m_vertexBuffer = 0;
+  GLuint m_indexBuffer = 0;
+  GLsizeiptr m_vertexBufferBytes = 0;
+  PFNGLGENBUFFERSPROC m_genBuffers = nullptr;
+  PFNGLDELETEBUFFERSPROC m_deleteBuffers = nullptr;
+  PFNGLBINDBUFFERPROC m_bindBuffer = nullptr;
+  PFNGLBUFFERDATAPROC m_bufferData = nullptr;
+  PFNGLBUFFERSUBDATAPROC m_bufferSubData = nullptr;
 };
 #endif // NOVELMIND_HAS_SDL2 && NOVELMIND_HAS_OPENGL
 
-std::unique_ptr<IRenderer> createRenderer() {
+std::unique_ptr<IRenderer> createRenderer(RendererBackend backend) {
+  switch (backend) {
+  case RendererBackend::Null:
+    return std::make_unique<NullRenderer>();
+  case RendererBackend::Software:
+    return std::make_unique<SoftwareRenderer>();
+  case RendererBackend::OpenGL:
+#if !defined(NOVELMIND_HAS_SDL2) || !defined(NOVELMIND_HAS_OPENGL)
+    NOVELMIND_LOG_WARN("Built without OpenGL, using the software renderer");
+#endif
+    [[fallthrough]];
+  case RendererBackend::Auto:
+    break;
+  }
 #if defined(NOVELMIND_HAS_SDL2) && defined(NOVELMIND_HAS_OPENGL)
   return std::make_unique<SDLOpenGLRenderer>();
 #else
-  // Factory function returns NullRenderer by default.
-  // Platform-specific implementations (SDL/OpenGL/Vulkan) are
-  // instantiated through platform layer configuration.
+  if (backend == RendererBackend::OpenGL) {
+    return std::make_unique<SoftwareRenderer>();
+  }
+  // Builds without OpenGL usually have no window to show frames in either
   return std::make_unique<NullRenderer>();
 #endif
 }
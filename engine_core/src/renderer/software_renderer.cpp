@@ -0,0 +1,804 @@
+#include "NovelMind/renderer/software_renderer.hpp"
+#include "NovelMind/core/logger.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NOVELMIND_RASTER_SSE2 1
+#include <emmintrin.h>
+#endif
+#if defined(NOVELMIND_RASTER_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#define NOVELMIND_RASTER_AVX2 1
+#include <immintrin.h>
+#endif
+
+#ifdef NOVELMIND_HAS_ZLIB
+#include <zlib.h>
+#endif
+
+namespace NovelMind::renderer {
+
+namespace {
+
+// --- Blending ---------------------------------------------------------------
+//
+// Every channel, alpha included, follows the GL blend function of the
+// mode, in integer arithmetic that the vector versions reproduce exactly:
+//   Alpha:    s * sa + d * (1 - sa)
+//   Additive: s * sa + d
+//   Multiply: s * d + d * (1 - sa)
+// with each product rounded to 8 bits and the sum saturated.
+
+inline u32 div255(u32 v) {
+  v += 128;
+  return (v + (v >> 8)) >> 8;
+}
+
+template <BlendMode Mode> inline u32 blendChannel(u32 s, u32 d, u32 a) {
+  u32 v = 0;
+  if constexpr (Mode == BlendMode::Alpha) {
+    v = div255(s * a) + div255(d * (255 - a));
+  } else if constexpr (Mode == BlendMode::Additive) {
+    v = div255(s * a) + d;
+  } else {
+    v = div255(s * d) + div255(d * (255 - a));
+  }
+  return std::min(v, 255u);
+}
+
+template <BlendMode Mode>
+void blendScalar(u8 *dst, const u8 *src, usize count) {
+  for (usize i = 0; i < count; ++i, dst += 4, src += 4) {
+    const u32 a = src[3];
+    for (int c = 0; c < 4; ++c) {
+      dst[c] = static_cast<u8>(blendChannel<Mode>(src[c], dst[c], a));
+    }
+  }
+}
+
+#ifdef NOVELMIND_RASTER_SSE2
+inline __m128i div255Sse2(__m128i v) {
+  v = _mm_add_epi16(v, _mm_set1_epi16(128));
+  return _mm_srli_epi16(_mm_add_epi16(v, _mm_srli_epi16(v, 8)), 8);
+}
+
+// Two pixels widened to 16-bit channels
+template <BlendMode Mode> inline __m128i blendSse2(__m128i s, __m128i d) {
+  __m128i a = _mm_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3));
+  a = _mm_shufflehi_epi16(a, _MM_SHUFFLE(3, 3, 3, 3));
+  const __m128i inv = _mm_sub_epi16(_mm_set1_epi16(255), a);
+  if constexpr (Mode == BlendMode::Alpha) {
+    return _mm_add_epi16(div255Sse2(_mm_mullo_epi16(s, a)),
+                         div255Sse2(_mm_mullo_epi16(d, inv)));
+  } else if constexpr (Mode == BlendMode::Additive) {
+    return _mm_add_epi16(div255Sse2(_mm_mullo_epi16(s, a)), d);
+  } else {
+    return _mm_add_epi16(div255Sse2(_mm_mullo_epi16(s, d)),
+                         div255Sse2(_mm_mullo_epi16(d, inv)));
+  }
+}
+
+template <BlendMode Mode>
+void blendSpanSse2(u8 *dst, const u8 *src, usize count) {
+  const __m128i zero = _mm_setzero_si128();
+  usize i = 0;
+  for (; i + 4 <= count; i += 4) {
+    auto *out = reinterpret_cast<__m128i *>(dst + i * 4);
+    const __m128i s =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 4));
+    const __m128i d = _mm_loadu_si128(out);
+    const __m128i lo = blendSse2<Mode>(_mm_unpacklo_epi8(s, zero),
+                                       _mm_unpacklo_epi8(d, zero));
+    const __m128i hi = blendSse2<Mode>(_mm_unpackhi_epi8(s, zero),
+                                       _mm_unpackhi_epi8(d, zero));
+    _mm_storeu_si128(out, _mm_packus_epi16(lo, hi));
+  }
+  blendScalar<Mode>(dst + i * 4, src + i * 4, count - i);
+}
+#endif
+
+#ifdef NOVELMIND_RASTER_AVX2
+__attribute__((target("avx2"))) inline __m256i div255Avx2(__m256i v) {
+  v = _mm256_add_epi16(v, _mm256_set1_epi16(128));
+  return _mm256_srli_epi16(_mm256_add_epi16(v, _mm256_srli_epi16(v, 8)), 8);
+}
+
+template <BlendMode Mode>
+__attribute__((target("avx2"))) inline __m256i blendAvx2(__m256i s,
+                                                         __m256i d) {
+  __m256i a = _mm256_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3));
+  a = _mm256_shufflehi_epi16(a, _MM_SHUFFLE(3, 3, 3, 3));
+  const __m256i inv = _mm256_sub_epi16(_mm256_set1_epi16(255), a);
+  if constexpr (Mode == BlendMode::Alpha) {
+    return _mm256_add_epi16(div255Avx2(_mm256_mullo_epi16(s, a)),
+                            div255Avx2(_mm256_mullo_epi16(d, inv)));
+  } else if constexpr (Mode == BlendMode::Additive) {
+    return _mm256_add_epi16(div255Avx2(_mm256_mullo_epi16(s, a)), d);
+  } else {
+    return _mm256_add_epi16(div255Avx2(_mm256_mullo_epi16(s, d)),
+                            div255Avx2(_mm256_mullo_epi16(d, inv)));
+  }
+}
+
+template <BlendMode Mode>
+__attribute__((target("avx2"))) void blendSpanAvx2(u8 *dst, const u8 *src,
+                                                   usize count) {
+  const __m256i zero = _mm256_setzero_si256();
+  usize i = 0;
+  // Unpack and pack both work within 128-bit lanes, so pixel order holds
+  for (; i + 8 <= count; i += 8) {
+    auto *out = reinterpret_cast<__m256i *>(dst + i * 4);
+    const __m256i s =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i * 4));
+    const __m256i d = _mm256_loadu_si256(out);
+    const __m256i lo = blendAvx2<Mode>(_mm256_unpacklo_epi8(s, zero),
+                                       _mm256_unpacklo_epi8(d, zero));
+    const __m256i hi = blendAvx2<Mode>(_mm256_unpackhi_epi8(s, zero),
+                                       _mm256_unpackhi_epi8(d, zero));
+    _mm256_storeu_si256(out, _mm256_packus_epi16(lo, hi));
+  }
+  blendSpanSse2<Mode>(dst + i * 4, src + i * 4, count - i);
+}
+#endif
+
+using BlendSpanFn = void (*)(u8 *dst, const u8 *src, usize count);
+
+void copySpan(u8 *dst, const u8 *src, usize count) {
+  std::memcpy(dst, src, count * 4);
+}
+
+template <BlendMode Mode> BlendSpanFn blendFor(SimdLevel level) {
+  switch (level) {
+#ifdef NOVELMIND_RASTER_AVX2
+  case SimdLevel::AVX2:
+    return &blendSpanAvx2<Mode>;
+#endif
+#ifdef NOVELMIND_RASTER_SSE2
+  case SimdLevel::SSE2:
+    return &blendSpanSse2<Mode>;
+#endif
+  default:
+    return &blendScalar<Mode>;
+  }
+}
+
+BlendSpanFn blendFor(SimdLevel level, BlendMode mode) {
+  switch (mode) {
+  case BlendMode::None:
+    return &copySpan;
+  case BlendMode::Alpha:
+    return blendFor<BlendMode::Alpha>(level);
+  case BlendMode::Additive:
+    return blendFor<BlendMode::Additive>(level);
+  case BlendMode::Multiply:
+    return blendFor<BlendMode::Multiply>(level);
+  }
+  return &copySpan;
+}
+
+// --- PNG --------------------------------------------------------------------
+
+u32 crc32(const u8 *data, usize size, u32 crc = 0) {
+  static const auto kTable = [] {
+    std::array<u32, 256> table{};
+    for (u32 n = 0; n < 256; ++n) {
+      u32 c = n;
+      for (int k = 0; k < 8; ++k) {
+        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+      }
+      table[n] = c;
+    }
+    return table;
+  }();
+  crc = ~crc;
+  for (usize i = 0; i < size; ++i) {
+    crc = kTable[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+void appendBigEndian(std::vector<u8> &out, u32 value) {
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    out.push_back(static_cast<u8>(value >> shift));
+  }
+}
+
+void appendChunk(std::vector<u8> &out, const char *type,
+                 const std::vector<u8> &data) {
+  appendBigEndian(out, static_cast<u32>(data.size()));
+  const usize start = out.size();
+  out.insert(out.end(), type, type + 4);
+  out.insert(out.end(), data.begin(), data.end());
+  appendBigEndian(out, crc32(out.data() + start, out.size() - start));
+}
+
+std::vector<u8> zlibStream(const std::vector<u8> &raw) {
+#ifdef NOVELMIND_HAS_ZLIB
+  uLongf size = compressBound(static_cast<uLong>(raw.size()));
+  std::vector<u8> compressed(size);
+  if (compress2(compressed.data(), &size, raw.data(),
+                static_cast<uLong>(raw.size()),
+                Z_DEFAULT_COMPRESSION) == Z_OK) {
+    compressed.resize(size);
+    return compressed;
+  }
+#endif
+  // Stored (uncompressed) deflate blocks
+  std::vector<u8> out = {0x78, 0x01};
+  usize offset = 0;
+  do {
+    const usize length = std::min<usize>(raw.size() - offset, 65535);
+    const bool last = offset + length == raw.size();
+    out.push_back(last ? 1 : 0);
+    out.push_back(static_cast<u8>(length));
+    out.push_back(static_cast<u8>(length >> 8));
+    out.push_back(static_cast<u8>(~length));
+    out.push_back(static_cast<u8>(~length >> 8));
+    out.insert(out.end(), raw.begin() + static_cast<std::ptrdiff_t>(offset),
+               raw.begin() + static_cast<std::ptrdiff_t>(offset + length));
+    offset += length;
+  } while (offset < raw.size());
+
+  u32 a = 1;
+  u32 b = 0;
+  for (u8 byte : raw) {
+    a = (a + byte) % 65521;
+    b = (b + a) % 65521;
+  }
+  appendBigEndian(out, (b << 16) | a);
+  return out;
+}
+
+} // namespace
+
+struct SoftwareRenderer::QuadSetup {
+  const u8 *texels = nullptr; // nullptr for solid colour
+  i32 texWidth = 0;
+  i32 texHeight = 0;
+  BlendMode blend = BlendMode::Alpha;
+  u8 tint[4] = {};
+
+  // Quad coordinates of a pixel centre (cx, cy), inside on [0, 1)^2:
+  // s = sx * cx + sy * cy + s0, t likewise
+  f32 sx = 0.0f;
+  f32 sy = 0.0f;
+  f32 s0 = 0.0f;
+  f32 tx = 0.0f;
+  f32 ty = 0.0f;
+  f32 t0 = 0.0f;
+
+  // Texel coordinates: u = u0 + s * us + t * ut, v likewise
+  f32 u0 = 0.0f;
+  f32 us = 0.0f;
+  f32 ut = 0.0f;
+  f32 v0 = 0.0f;
+  f32 vs = 0.0f;
+  f32 vt = 0.0f;
+
+  // Pixel bounds, clipped to the framebuffer; max is exclusive
+  i32 minX = 0;
+  i32 minY = 0;
+  i32 maxX = 0;
+  i32 maxY = 0;
+};
+
+// Raster threads kept for the renderer's lifetime. run() wakes them for
+// one batch of indices and works through the batch on the calling thread
+// too, returning once every index is done.
+class SoftwareRenderer::WorkerPool {
+public:
+  explicit WorkerPool(unsigned helpers) {
+    m_threads.reserve(helpers);
+    for (unsigned i = 0; i < helpers; ++i) {
+      m_threads.emplace_back([this] { workerLoop(); });
+    }
+  }
+
+  ~WorkerPool() {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (auto &thread : m_threads) {
+      thread.join();
+    }
+  }
+
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool &operator=(const WorkerPool &) = delete;
+
+  void run(usize count, const std::function<void(usize)> &fn) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_job = &fn;
+      m_count = count;
+      m_next.store(0, std::memory_order_relaxed);
+      m_busy = m_threads.size();
+      ++m_generation;
+    }
+    m_wake.notify_all();
+    drain();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_busy == 0; });
+    m_job = nullptr;
+  }
+
+private:
+  void drain() {
+    for (usize i = m_next.fetch_add(1); i < m_count; i = m_next.fetch_add(1)) {
+      (*m_job)(i);
+    }
+  }
+
+  void workerLoop() {
+    u64 seen = 0;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+      m_wake.wait(lock,
+                  [&] { return m_stopping || m_generation != seen; });
+      if (m_stopping) {
+        return;
+      }
+      seen = m_generation;
+      lock.unlock();
+      drain();
+      lock.lock();
+      if (--m_busy == 0) {
+        m_done.notify_one();
+      }
+    }
+  }
+
+  std::vector<std::thread> m_threads;
+  std::mutex m_mutex;
+  std::condition_variable m_wake;
+  std::condition_variable m_done;
+  // Batch state; written under m_mutex before m_generation changes
+  const std::function<void(usize)> *m_job = nullptr;
+  usize m_count = 0;
+  std::atomic<usize> m_next{0};
+  usize m_busy = 0;
+  u64 m_generation = 0;
+  bool m_stopping = false;
+};
+
+SoftwareRenderer::SoftwareRenderer(SoftwareRendererConfig config)
+    : m_config(config) {
+  m_config.tileSize = std::max(m_config.tileSize, 8u);
+  m_simd = std::min(m_config.simd.value_or(SimdLevel::AVX2), bestSimdLevel());
+  m_threads = m_config.threads != 0
+                  ? m_config.threads
+                  : std::max(1u, std::thread::hardware_concurrency());
+  m_batch.setFlushCallback(
+      [this](std::span<const SpriteVertex> vertices,
+             std::span<const SpriteDrawCommand> commands) {
+        rasterize(vertices, commands);
+      });
+}
+
+SoftwareRenderer::~SoftwareRenderer() = default;
+
+SimdLevel SoftwareRenderer::bestSimdLevel() {
+#ifdef NOVELMIND_RASTER_AVX2
+  if (__builtin_cpu_supports("avx2")) {
+    return SimdLevel::AVX2;
+  }
+#endif
+#ifdef NOVELMIND_RASTER_SSE2
+  return SimdLevel::SSE2;
+#else
+  return SimdLevel::Scalar;
+#endif
+}
+
+Result<void> SoftwareRenderer::initialize(platform::IWindow &window) {
+  auto result = initialize(window.getWidth(), window.getHeight());
+  if (result.isOk()) {
+    m_window = &window;
+  }
+  return result;
+}
+
+Result<void> SoftwareRenderer::initialize(i32 width, i32 height) {
+  if (width <= 0 || height <= 0) {
+    return Result<void>::error("Invalid framebuffer size");
+  }
+  m_width = width;
+  m_height = height;
+  m_framebuffer.assign(static_cast<usize>(width) *
+                           static_cast<usize>(height) * 4,
+                       0);
+  m_tilesX = (static_cast<u32>(width) + m_config.tileSize - 1) /
+             m_config.tileSize;
+  m_tilesY = (static_cast<u32>(height) + m_config.tileSize - 1) /
+             m_config.tileSize;
+  m_tileQuads.assign(static_cast<usize>(m_tilesX) * m_tilesY, {});
+  m_window = nullptr;
+  m_warnedPresent = false;
+  if (!m_pool && m_threads > 1) {
+    m_pool = std::make_unique<WorkerPool>(m_threads - 1);
+  }
+
+  static const char *const kSimdNames[] = {"scalar", "SSE2", "AVX2"};
+  NOVELMIND_LOG_INFO("Software renderer initialized: " +
+                     std::to_string(width) + "x" + std::to_string(height) +
+                     ", " + std::to_string(m_threads) + " threads, " +
+                     kSimdNames[static_cast<int>(m_simd)] + " blending");
+  return Result<void>::ok();
+}
+
+void SoftwareRenderer::shutdown() {
+  m_pool.reset();
+  m_window = nullptr;
+  m_framebuffer.clear();
+  m_tileQuads.clear();
+  m_quads.clear();
+  m_fontAtlases.clear();
+  m_width = 0;
+  m_height = 0;
+}
+
+void SoftwareRenderer::beginFrame() {
+  m_batch.resetStats();
+  // Same backdrop as the GL renderer
+  clear(Color(13, 13, 15, 255));
+}
+
+void SoftwareRenderer::endFrame() {
+  flush();
+  m_lastStats = m_batch.stats();
+  if (m_window &&
+      !m_window->presentPixels(m_framebuffer, m_width, m_height) &&
+      !m_warnedPresent) {
+    NOVELMIND_LOG_WARN("Window cannot show software-rendered frames");
+    m_warnedPresent = true;
+  }
+}
+
+Result<ImageData> SoftwareRenderer::captureFrame() {
+  if (m_framebuffer.empty()) {
+    return Result<ImageData>::error("Software renderer not initialized");
+  }
+  flush();
+  return Result<ImageData>::ok(ImageData{m_width, m_height, m_framebuffer});
+}
+
+void SoftwareRenderer::clear(const Color &color) {
+  flush();
+  const u8 pixel[4] = {color.r, color.g, color.b, color.a};
+  for (usize i = 0; i < m_framebuffer.size(); i += 4) {
+    std::memcpy(m_framebuffer.data() + i, pixel, 4);
+  }
+}
+
+void SoftwareRenderer::setBlendMode(BlendMode mode) {
+  m_batch.setBlendMode(mode);
+}
+
+void SoftwareRenderer::drawSprite(const Texture &texture,
+                                  const Transform2D &transform,
+                                  const Color &tint) {
+  m_batch.draw(texture,
+               Rect{0, 0, static_cast<f32>(texture.getWidth()),
+                    static_cast<f32>(texture.getHeight())},
+               transform, tint);
+}
+
+void SoftwareRenderer::drawSprite(const Texture &texture,
+                                  const Rect &sourceRect,
+                                  const Transform2D &transform,
+                                  const Color &tint) {
+  m_batch.draw(texture, sourceRect, transform, tint);
+}
+
+void SoftwareRenderer::drawRect(const Rect &rect, const Color &color) {
+  m_batch.outline(rect, color);
+}
+
+void SoftwareRenderer::fillRect(const Rect &rect, const Color &color) {
+  m_batch.fill(rect, color);
+}
+
+void SoftwareRenderer::drawText(const Font &font, const std::string &text,
+                                f32 x, f32 y, const Color &color) {
+  if (text.empty()) {
+    return;
+  }
+  if (auto atlas = m_fontAtlases.get(font)) {
+    m_batch.drawText(*atlas, text, x, y, color,
+                     static_cast<f32>(font.getSize()) * 0.5f);
+  }
+}
+
+void SoftwareRenderer::drawText(const FontAtlas &atlas,
+                                const std::string &text, f32 x, f32 y,
+                                const Color &color) {
+  m_batch.drawText(atlas, text, x, y, color);
+}
+
+void SoftwareRenderer::setFade(f32 alpha, const Color &color) {
+  const auto a = static_cast<u8>(std::clamp(alpha, 0.0f, 1.0f) * 255.0f);
+  m_batch.fill(Rect{0, 0, static_cast<f32>(m_width),
+                    static_cast<f32>(m_height)},
+               Color(color.r, color.g, color.b, a));
+}
+
+void SoftwareRenderer::flush() { m_batch.flush(); }
+
+Color SoftwareRenderer::pixelAt(i32 x, i32 y) const {
+  if (x < 0 || y < 0 || x >= m_width || y >= m_height) {
+    return Color(0, 0, 0, 0);
+  }
+  const u8 *p = m_framebuffer.data() +
+                (static_cast<usize>(y) * static_cast<usize>(m_width) +
+                 static_cast<usize>(x)) *
+                    4;
+  return Color(p[0], p[1], p[2], p[3]);
+}
+
+void SoftwareRenderer::rasterize(std::span<const SpriteVertex> vertices,
+                                 std::span<const SpriteDrawCommand> commands) {
+  if (m_framebuffer.empty()) {
+    return;
+  }
+
+  m_quads.clear();
+  for (auto &quads : m_tileQuads) {
+    quads.clear();
+  }
+
+  for (const auto &command : commands) {
+    QuadSetup base;
+    base.blend = command.blend;
+    if (command.texture) {
+      const SpriteTexture &texture = command.texture;
+      if (!texture.pixels) {
+        if (!m_warnedGpuTexture) {
+          NOVELMIND_LOG_WARN("Software renderer skipped a texture that only "
+                             "exists on the GPU");
+          m_warnedGpuTexture = true;
+        }
+        continue;
+      }
+      base.texels = texture.pixels;
+      base.texWidth = texture.width;
+      base.texHeight = texture.height;
+    }
+
+    for (u32 q = 0; q < command.quadCount; ++q) {
+      const SpriteVertex *v = &vertices[(command.firstQuad + q) * 4];
+      QuadSetup quad = base;
+      quad.tint[0] = v[0].r;
+      quad.tint[1] = v[0].g;
+      quad.tint[2] = v[0].b;
+      quad.tint[3] = v[0].a;
+
+      // Corner 0 plus s along edge 0-1 and t along edge 0-3
+      const f32 e1x = v[1].x - v[0].x;
+      const f32 e1y = v[1].y - v[0].y;
+      const f32 e2x = v[3].x - v[0].x;
+      const f32 e2y = v[3].y - v[0].y;
+      const f32 det = e1x * e2y - e1y * e2x;
+      if (std::fabs(det) < 1e-6f) {
+        continue;
+      }
+      quad.sx = e2y / det;
+      quad.sy = -e2x / det;
+      quad.s0 = -(v[0].x * quad.sx + v[0].y * quad.sy);
+      quad.tx = -e1y / det;
+      quad.ty = e1x / det;
+      quad.t0 = -(v[0].x * quad.tx + v[0].y * quad.ty);
+
+      const auto w = static_cast<f32>(quad.texWidth);
+      const auto h = static_cast<f32>(quad.texHeight);
+      quad.u0 = v[0].u * w;
+      quad.us = (v[1].u - v[0].u) * w;
+      quad.ut = (v[3].u - v[0].u) * w;
+      quad.v0 = v[0].v * h;
+      quad.vs = (v[1].v - v[0].v) * h;
+      quad.vt = (v[3].v - v[0].v) * h;
+
+      f32 minX = v[0].x;
+      f32 maxX = v[0].x;
+      f32 minY = v[0].y;
+      f32 maxY = v[0].y;
+      for (int i = 1; i < 4; ++i) {
+        minX = std::min(minX, v[i].x);
+        maxX = std::max(maxX, v[i].x);
+        minY = std::min(minY, v[i].y);
+        maxY = std::max(maxY, v[i].y);
+      }
+      const auto width = static_cast<f32>(m_width);
+      const auto height = static_cast<f32>(m_height);
+      quad.minX = static_cast<i32>(std::clamp(std::floor(minX), 0.0f, width));
+      quad.minY =
+          static_cast<i32>(std::clamp(std::floor(minY), 0.0f, height));
+      quad.maxX = static_cast<i32>(std::clamp(std::ceil(maxX), 0.0f, width));
+      quad.maxY = static_cast<i32>(std::clamp(std::ceil(maxY), 0.0f, height));
+      if (quad.minX >= quad.maxX || quad.minY >= quad.maxY) {
+        continue;
+      }
+
+      const auto index = static_cast<u32>(m_quads.size());
+      m_quads.push_back(quad);
+      const u32 tileSize = m_config.tileSize;
+      for (u32 ty = static_cast<u32>(quad.minY) / tileSize;
+           ty <= static_cast<u32>(quad.maxY - 1) / tileSize; ++ty) {
+        for (u32 tx = static_cast<u32>(quad.minX) / tileSize;
+             tx <= static_cast<u32>(quad.maxX - 1) / tileSize; ++tx) {
+          m_tileQuads[ty * m_tilesX + tx].push_back(index);
+        }
+      }
+    }
+  }
+
+  const auto tiles = m_tileQuads.size();
+  if (!m_pool) {
+    for (usize tile = 0; tile < tiles; ++tile) {
+      rasterizeTile(static_cast<u32>(tile));
+    }
+    return;
+  }
+  m_pool->run(tiles,
+              [this](usize tile) { rasterizeTile(static_cast<u32>(tile)); });
+}
+
+void SoftwareRenderer::rasterizeTile(u32 tile) {
+  const auto &quads = m_tileQuads[tile];
+  if (quads.empty()) {
+    return;
+  }
+
+  const auto tileSize = static_cast<i32>(m_config.tileSize);
+  const i32 tileX0 = static_cast<i32>(tile % m_tilesX) * tileSize;
+  const i32 tileY0 = static_cast<i32>(tile / m_tilesX) * tileSize;
+  const i32 tileX1 = std::min(tileX0 + tileSize, m_width);
+  const i32 tileY1 = std::min(tileY0 + tileSize, m_height);
+
+  thread_local std::vector<u8> span;
+  span.resize(static_cast<usize>(tileSize) * 4);
+
+  for (u32 index : quads) {
+    const QuadSetup &q = m_quads[index];
+    const i32 x0 = std::max(q.minX, tileX0);
+    const i32 x1 = std::min(q.maxX, tileX1);
+    const i32 y0 = std::max(q.minY, tileY0);
+    const i32 y1 = std::min(q.maxY, tileY1);
+    if (x0 >= x1 || y0 >= y1) {
+      continue;
+    }
+    const BlendSpanFn blend = blendFor(m_simd, q.blend);
+
+    for (i32 y = y0; y < y1; ++y) {
+      // Every value is computed from absolute pixel coordinates, so a
+      // pixel comes out the same whichever tile it falls in
+      const f32 cy = static_cast<f32>(y) + 0.5f;
+      const f32 sRow = q.sy * cy + q.s0;
+      const f32 tRow = q.ty * cy + q.t0;
+
+      // Solve 0 <= s, t < 1 for the row's x range, one pixel wider to
+      // absorb rounding; the exact test below decides each pixel
+      f32 lo = static_cast<f32>(x0);
+      f32 hi = static_cast<f32>(x1);
+      auto narrow = [&lo, &hi](f32 slope, f32 base) {
+        if (std::fabs(slope) < 1e-12f) {
+          if (base < 0.0f || base >= 1.0f) {
+            hi = lo;
+          }
+          return;
+        }
+        const f32 a = -base / slope - 0.5f;
+        const f32 b = (1.0f - base) / slope - 0.5f;
+        lo = std::max(lo, std::min(a, b) - 1.0f);
+        hi = std::min(hi, std::max(a, b) + 2.0f);
+      };
+      narrow(q.sx, sRow);
+      narrow(q.tx, tRow);
+      if (lo >= hi) {
+        continue;
+      }
+      const i32 spanX0 = std::max(x0, static_cast<i32>(std::floor(lo)));
+      const i32 spanX1 = std::min(x1, static_cast<i32>(std::ceil(hi)));
+
+      i32 start = -1;
+      i32 count = 0;
+      for (i32 x = spanX0; x < spanX1; ++x) {
+        const f32 cx = static_cast<f32>(x) + 0.5f;
+        const f32 s = q.sx * cx + sRow;
+        const f32 t = q.tx * cx + tRow;
+        if (s < 0.0f || s >= 1.0f || t < 0.0f || t >= 1.0f) {
+          if (start >= 0) {
+            break; // Quads are convex: the row's span has ended
+          }
+          continue;
+        }
+        if (start < 0) {
+          start = x;
+        }
+
+        u8 *out = span.data() + static_cast<usize>(count) * 4;
+        if (q.texels) {
+          const f32 u = q.u0 + s * q.us + t * q.ut;
+          const f32 v = q.v0 + s * q.vs + t * q.vt;
+          const i32 texX =
+              std::clamp(static_cast<i32>(std::floor(u)), 0, q.texWidth - 1);
+          const i32 texY =
+              std::clamp(static_cast<i32>(std::floor(v)), 0, q.texHeight - 1);
+          const u8 *texel =
+              q.texels + (static_cast<usize>(texY) *
+                              static_cast<usize>(q.texWidth) +
+                          static_cast<usize>(texX)) *
+                             4;
+          for (int c = 0; c < 4; ++c) {
+            out[c] = static_cast<u8>(div255(static_cast<u32>(texel[c]) *
+                                            q.tint[c]));
+          }
+        } else {
+          std::memcpy(out, q.tint, 4);
+        }
+        ++count;
+      }
+
+      if (count > 0) {
+        u8 *row = m_framebuffer.data() +
+                  (static_cast<usize>(y) * static_cast<usize>(m_width) +
+                   static_cast<usize>(start)) *
+                      4;
+        blend(row, span.data(), static_cast<usize>(count));
+      }
+    }
+  }
+}
+
+std::vector<u8> SoftwareRenderer::encodePng() const {
+  // Filter type 0 (none) on every row
+  const usize stride = static_cast<usize>(m_width) * 4;
+  std::vector<u8> raw;
+  raw.reserve((stride + 1) * static_cast<usize>(m_height));
+  for (i32 y = 0; y < m_height; ++y) {
+    raw.push_back(0);
+    const auto *row = m_framebuffer.data() + static_cast<usize>(y) * stride;
+    raw.insert(raw.end(), row, row + stride);
+  }
+
+  std::vector<u8> header;
+  appendBigEndian(header, static_cast<u32>(m_width));
+  appendBigEndian(header, static_cast<u32>(m_height));
+  header.insert(header.end(), {8, 6, 0, 0, 0}); // 8-bit RGBA
+
+  std::vector<u8> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+  appendChunk(png, "IHDR", header);
+  appendChunk(png, "IDAT", zlibStream(raw));
+  appendChunk(png, "IEND", {});
+  return png;
+}
+
+Result<void> SoftwareRenderer::savePng(const std::string &path) const {
+  if (m_framebuffer.empty()) {
+    return Result<void>::error("Software renderer is not initialized");
+  }
+  const auto png = encodePng();
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    return Result<void>::error("Cannot create image: " + path);
+  }
+  file.write(reinterpret_cast<const char *>(png.data()),
+             static_cast<std::streamsize>(png.size()));
+  if (!file) {
+    return Result<void>::error("Cannot write image: " + path);
+  }
+  return Result<void>::ok();
+}
+
+} // namespace NovelMind::renderer
@@ -0,0 +1,243 @@
+#include "NovelMind/renderer/sprite_batch.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace NovelMind::renderer {
+
+namespace {
+
+constexpr u32 kMaxIndexedQuads = 65536 / 4;
+constexpr f32 kDegreesToRadians = 3.14159265358979323846f / 180.0f;
+
+} // namespace
+
+SpriteTexture SpriteTexture::of(const Texture &texture) {
+  SpriteTexture result;
+  result.handle = texture.getNativeHandle();
+  if (!result.handle) {
+    result.pixels = texture.getPixels().data();
+  }
+  result.width = texture.getWidth();
+  result.height = texture.getHeight();
+  return result;
+}
+
+SpriteBatch::SpriteBatch(SpriteBatchConfig config) : m_config(config) {
+  m_config.maxQuads = std::clamp(m_config.maxQuads, 1u, kMaxIndexedQuads);
+  m_config.lookback = std::max(m_config.lookback, 1u);
+}
+
+void SpriteBatch::draw(const Texture &texture, const Rect &source,
+                       const Transform2D &transform, const Color &tint) {
+  if (!texture.isValid()) {
+    return;
+  }
+
+  const f32 invWidth = 1.0f / static_cast<f32>(texture.getWidth());
+  const f32 invHeight = 1.0f / static_cast<f32>(texture.getHeight());
+  const f32 u0 = source.x * invWidth;
+  const f32 v0 = source.y * invHeight;
+  const f32 u1 = (source.x + source.width) * invWidth;
+  const f32 v1 = (source.y + source.height) * invHeight;
+
+  // Corners around the anchor, scaled
+  const f32 x0 = -transform.anchorX * transform.scaleX;
+  const f32 y0 = -transform.anchorY * transform.scaleY;
+  const f32 x1 = (source.width - transform.anchorX) * transform.scaleX;
+  const f32 y1 = (source.height - transform.anchorY) * transform.scaleY;
+
+  SpriteVertex quad[4] = {
+      {x0, y0, u0, v0, tint.r, tint.g, tint.b, tint.a},
+      {x1, y0, u1, v0, tint.r, tint.g, tint.b, tint.a},
+      {x1, y1, u1, v1, tint.r, tint.g, tint.b, tint.a},
+      {x0, y1, u0, v1, tint.r, tint.g, tint.b, tint.a},
+  };
+
+  if (transform.rotation != 0.0f) {
+    const f32 radians = transform.rotation * kDegreesToRadians;
+    const f32 c = std::cos(radians);
+    const f32 s = std::sin(radians);
+    for (auto &vertex : quad) {
+      const f32 x = vertex.x;
+      vertex.x = c * x - s * vertex.y;
+      vertex.y = s * x + c * vertex.y;
+    }
+  }
+  for (auto &vertex : quad) {
+    vertex.x += transform.x;
+    vertex.y += transform.y;
+  }
+
+  push(SpriteTexture::of(texture), quad);
+}
+
+void SpriteBatch::fill(const Rect &rect, const Color &color) {
+  const f32 x1 = rect.x + rect.width;
+  const f32 y1 = rect.y + rect.height;
+  const SpriteVertex quad[4] = {
+      {rect.x, rect.y, 0.0f, 0.0f, color.r, color.g, color.b, color.a},
+      {x1, rect.y, 0.0f, 0.0f, color.r, color.g, color.b, color.a},
+      {x1, y1, 0.0f, 0.0f, color.r, color.g, color.b, color.a},
+      {rect.x, y1, 0.0f, 0.0f, color.r, color.g, color.b, color.a},
+  };
+  push(SpriteTexture{}, quad);
+}
+
+void SpriteBatch::outline(const Rect &rect, const Color &color) {
+  if (rect.width <= 2.0f || rect.height <= 2.0f) {
+    fill(rect, color);
+    return;
+  }
+  const f32 right = rect.x + rect.width - 1.0f;
+  const f32 bottom = rect.y + rect.height - 1.0f;
+  fill(Rect{rect.x, rect.y, rect.width, 1.0f}, color);
+  fill(Rect{rect.x, bottom, rect.width, 1.0f}, color);
+  fill(Rect{rect.x, rect.y + 1.0f, 1.0f, rect.height - 2.0f}, color);
+  fill(Rect{right, rect.y + 1.0f, 1.0f, rect.height - 2.0f}, color);
+}
+
+void SpriteBatch::drawText(const FontAtlas &atlas, const std::string &text,
+                           f32 x, f32 y, const Color &color,
+                           f32 missingAdvance) {
+  const Texture &texture = atlas.getAtlasTexture();
+  if (text.empty() || !atlas.isValid() || !texture.isValid()) {
+    return;
+  }
+
+  const auto width = static_cast<f32>(texture.getWidth());
+  const auto height = static_cast<f32>(texture.getHeight());
+  const auto lineHeight = static_cast<f32>(atlas.getLineHeight());
+  f32 penX = x;
+  f32 baseline = y + lineHeight;
+
+  for (char c : text) {
+    if (c == '\n') {
+      penX = x;
+      baseline += lineHeight;
+      continue;
+    }
+
+    const auto *glyph = atlas.getGlyph(static_cast<unsigned char>(c));
+    if (!glyph) {
+      penX += missingAdvance;
+      continue;
+    }
+
+    const Rect source{glyph->uv.x * width, glyph->uv.y * height,
+                      glyph->uv.width * width, glyph->uv.height * height};
+    Transform2D transform;
+    transform.x = penX + glyph->bearingX;
+    transform.y = baseline - glyph->bearingY;
+    draw(texture, source, transform, color);
+
+    penX += glyph->advanceX;
+  }
+}
+
+void SpriteBatch::push(const SpriteTexture &texture,
+                       const SpriteVertex (&quad)[4]) {
+  if (m_pendingQuads >= m_config.maxQuads) {
+    flush();
+  }
+
+  f32 minX = quad[0].x;
+  f32 maxX = quad[0].x;
+  f32 minY = quad[0].y;
+  f32 maxY = quad[0].y;
+  for (const auto &vertex : quad) {
+    minX = std::min(minX, vertex.x);
+    maxX = std::max(maxX, vertex.x);
+    minY = std::min(minY, vertex.y);
+    maxY = std::max(maxY, vertex.y);
+  }
+
+  // Join the latest run with this state unless something drawn after it
+  // overlaps the quad, which would change what ends up on top
+  Run *target = nullptr;
+  const usize stop = m_activeRuns > m_config.lookback
+                         ? m_activeRuns - m_config.lookback
+                         : 0;
+  for (usize i = m_activeRuns; i-- > stop;) {
+    Run &run = m_runs[i];
+    if (run.texture == texture && run.blend == m_blend) {
+      target = &run;
+      break;
+    }
+    if (minX < run.maxX && run.minX < maxX && minY < run.maxY &&
+        run.minY < maxY) {
+      break;
+    }
+  }
+
+  if (target) {
+    target->minX = std::min(target->minX, minX);
+    target->minY = std::min(target->minY, minY);
+    target->maxX = std::max(target->maxX, maxX);
+    target->maxY = std::max(target->maxY, maxY);
+  } else {
+    if (m_activeRuns == m_runs.size()) {
+      m_runs.emplace_back();
+    }
+    target = &m_runs[m_activeRuns++];
+    target->texture = texture;
+    target->blend = m_blend;
+    target->minX = minX;
+    target->minY = minY;
+    target->maxX = maxX;
+    target->maxY = maxY;
+    target->vertices.clear();
+  }
+
+  target->vertices.insert(target->vertices.end(), quad, quad + 4);
+  ++m_pendingQuads;
+  ++m_stats.quads;
+}
+
+void SpriteBatch::flush() {
+  if (m_pendingQuads == 0) {
+    return;
+  }
+
+  m_vertices.clear();
+  m_commands.clear();
+  for (usize i = 0; i < m_activeRuns; ++i) {
+    const Run &run = m_runs[i];
+    SpriteDrawCommand command;
+    command.texture = run.texture;
+    command.blend = run.blend;
+    command.firstQuad = static_cast<u32>(m_vertices.size() / 4);
+    command.quadCount = static_cast<u32>(run.vertices.size() / 4);
+    m_commands.push_back(command);
+    m_vertices.insert(m_vertices.end(), run.vertices.begin(),
+                      run.vertices.end());
+  }
+
+  m_stats.vertices += static_cast<u32>(m_vertices.size());
+  m_stats.drawCalls += static_cast<u32>(m_commands.size());
+  ++m_stats.batches;
+  m_activeRuns = 0;
+  m_pendingQuads = 0;
+
+  if (m_onFlush) {
+    m_onFlush(m_vertices, m_commands);
+  }
+}
+
+std::vector<u16> SpriteBatch::quadIndices(u32 quads) {
+  quads = std::min(quads, kMaxIndexedQuads);
+  std::vector<u16> indices;
+  indices.reserve(static_cast<usize>(quads) * 6);
+  for (u32 quad = 0; quad < quads; ++quad) {
+    const auto base = static_cast<u16>(quad * 4);
+    const u16 corners[6] = {base,
+                            static_cast<u16>(base + 1),
+                            static_cast<u16>(base + 2),
+                            base,
+                            static_cast<u16>(base + 2),
+                            static_cast<u16>(base + 3)};
+    indices.insert(indices.end(), corners, corners + 6);
+  }
+  return indices;
+}
+
+} // namespace NovelMind::renderer
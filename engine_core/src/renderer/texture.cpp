@@ -15,7 +15,7 @@ Texture::~Texture() { destroy(); }
 
 Texture::Texture(Texture &&other) noexcept
     : m_handle(other.m_handle), m_width(other.m_width),
-      m_height(other.m_height) {
+      m_height(other.m_height), m_pixels(std::move(other.m_pixels)) {
   other.m_handle = nullptr;
   other.m_width = 0;
   other.m_height = 0;
@@ -27,6 +27,7 @@ Texture &Texture::operator=(Texture &&other) noexcept {
     m_handle = other.m_handle;
     m_width = other.m_width;
     m_height = other.m_height;
+    m_pixels = std::move(other.m_pixels);
     other.m_handle = nullptr;
     other.m_width = 0;
     other.m_height = 0;
@@ -34,9 +35,21 @@ Texture &Texture::operator=(Texture &&other) noexcept {
   return *this;
 }
 
-Result<void> Texture::loadFromMemory(const std::vector<u8> &data) {
+Result<void> Texture::loadFromMemory(std::span<const u8> data) {
+  auto image = decodeImage(data);
+  if (image.isError()) {
+    return Result<void>::error(image.error());
+  }
+  return loadFromImage(image.value());
+}
+
+Result<void> Texture::loadFromImage(const ImageData &image) {
+  return loadFromRGBA(image.pixels.data(), image.width, image.height);
+}
+
+Result<ImageData> Texture::decodeImage(std::span<const u8> data) {
   if (data.empty()) {
-    return Result<void>::error("Empty texture data");
+    return Result<ImageData>::error("Empty texture data");
   }
 
   int width = 0;
@@ -48,14 +61,21 @@ Result<void> Texture::loadFromMemory(const std::vector<u8> &data) {
 
   if (!pixels || width <= 0 || height <= 0) {
     const char *reason = stbi_failure_reason();
-    return Result<void>::error(
+    if (pixels) {
+      stbi_image_free(pixels);
+    }
+    return Result<ImageData>::error(
         reason ? reason : "Failed to decode texture");
   }
 
-  auto result =
-      loadFromRGBA(reinterpret_cast<const u8 *>(pixels), width, height);
+  ImageData image;
+  image.width = width;
+  image.height = height;
+  const auto *begin = reinterpret_cast<const u8 *>(pixels);
+  image.pixels.assign(begin, begin + static_cast<usize>(width) *
+                                         static_cast<usize>(height) * 4);
   stbi_image_free(pixels);
-  return result;
+  return Result<ImageData>::ok(std::move(image));
 }
 
 Result<void> Texture::loadFromRGBA(const u8 *pixels, i32 width, i32 height) {
@@ -66,21 +86,33 @@ Result<void> Texture::loadFromRGBA(const u8 *pixels, i32 width, i32 height) {
   m_width = width;
   m_height = height;
 
-#if defined(NOVELMIND_HAS_SDL2) && defined(NOVELMIND_HAS_OPENGL)
-  GLuint tex = 0;
-  glGenTextures(1, &tex);
-  glBindTexture(GL_TEXTURE_2D, tex);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA,
-               GL_UNSIGNED_BYTE, pixels);
-  m_handle = reinterpret_cast<void *>(static_cast<uintptr_t>(tex));
-#else
   m_handle = nullptr;
+#if defined(NOVELMIND_HAS_SDL2) && defined(NOVELMIND_HAS_OPENGL)
+  // GL calls need a current context; there is none when the software
+  // renderer runs instead (no GPU, or the GL renderer failed to start)
+  if (SDL_GL_GetCurrentContext()) {
+    GLuint tex = 0;
+    glGenTextures(1, &tex);
+    glBindTexture(GL_TEXTURE_2D, tex);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA,
+                 GL_UNSIGNED_BYTE, pixels);
+    m_handle = reinterpret_cast<void *>(static_cast<uintptr_t>(tex));
+  }
 #endif
 
+  // No GPU texture (no GL build or no context): keep the pixels for the
+  // software renderer
+  if (!m_handle) {
+    m_pixels.assign(pixels, pixels + static_cast<usize>(width) *
+                                         static_cast<usize>(height) * 4);
+  } else {
+    m_pixels.clear();
+  }
+
   return Result<void>::ok();
 }
 
@@ -95,6 +127,7 @@ void Texture::destroy() {
     // Texture resource cleanup is handled by platform backend.
     m_handle = nullptr;
   }
+  m_pixels.clear();
   m_width = 0;
   m_height = 0;
 }
@@ -0,0 +1,302 @@
+#include "NovelMind/resource/async_loader.hpp"
+#include <chrono>
+#include <unordered_set>
+
+namespace NovelMind::resource {
+
+using Stage = detail::LoadState::Stage;
+
+AsyncLoader::AsyncLoader(ReadFn read, AsyncLoaderConfig config)
+    : m_read(std::move(read)), m_config(config) {
+  m_workers.reserve(m_config.workerThreads);
+  for (unsigned i = 0; i < m_config.workerThreads; ++i) {
+    m_workers.emplace_back([this] { workerLoop(); });
+  }
+}
+
+AsyncLoader::~AsyncLoader() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+  m_workAvailable.notify_all();
+  for (auto &worker : m_workers) {
+    worker.join();
+  }
+  cancelAll();
+}
+
+std::shared_ptr<detail::LoadState>
+AsyncLoader::submit(const std::string &id, LoadPriority priority,
+                    detail::LoadState::Decoder decode,
+                    detail::LoadState::Finisher finish) {
+  auto state = std::make_shared<detail::LoadState>();
+  state->decode = std::move(decode);
+  state->finish = std::move(finish);
+  return enqueue(std::move(state), id, priority);
+}
+
+AsyncLoader::StatePtr AsyncLoader::enqueue(StatePtr state,
+                                           const std::string &id,
+                                           LoadPriority priority) {
+  state->id = id;
+  state->priority = priority;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_decodeQueue[static_cast<usize>(priority)].push_back(state);
+    ++m_pending;
+  }
+  m_workAvailable.notify_one();
+  return state;
+}
+
+LoadHandle<SharedBuffer>
+AsyncLoader::requestData(const std::string &id, LoadPriority priority) {
+  return LoadHandle<SharedBuffer>(submit(id, priority, {}, {}));
+}
+
+void AsyncLoader::setPriority(const std::shared_ptr<detail::LoadState> &state,
+                              LoadPriority priority) {
+  if (!state) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (state->priority == priority) {
+    return;
+  }
+  state->priority = priority;
+  // The entry in the old class goes stale: whichever copy is popped first
+  // advances the stage and the other is skipped
+  const auto index = static_cast<usize>(priority);
+  if (state->stage == Stage::Queued) {
+    m_decodeQueue[index].push_front(state);
+    m_workAvailable.notify_one();
+  } else if (state->stage == Stage::AwaitingFinish) {
+    m_finishQueue[index].push_front(state);
+  }
+}
+
+AsyncLoader::StatePtr AsyncLoader::popQueued(Queues &queues, Stage stage) {
+  for (auto &queue : queues) {
+    while (!queue.empty()) {
+      StatePtr state = std::move(queue.front());
+      queue.pop_front();
+      if (state->stage == stage) {
+        return state;
+      }
+    }
+  }
+  return nullptr;
+}
+
+void AsyncLoader::workerLoop() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (!m_stopping) {
+    StatePtr state = popQueued(m_decodeQueue, Stage::Queued);
+    if (!state) {
+      m_workAvailable.wait(lock);
+      continue;
+    }
+
+    state->stage = Stage::Decoding;
+    lock.unlock();
+    decodeJob(state, false);
+    lock.lock();
+  }
+}
+
+Result<std::shared_ptr<void>>
+AsyncLoader::produce(const detail::LoadState &state) {
+  if (state.task) {
+    return state.task();
+  }
+  auto bytes = m_read(state.id);
+  if (bytes.isError()) {
+    return Result<std::shared_ptr<void>>::error(bytes.error());
+  }
+  if (state.decode) {
+    return state.decode(bytes.value());
+  }
+  return Result<std::shared_ptr<void>>::ok(
+      std::make_shared<SharedBuffer>(std::move(bytes.value())));
+}
+
+void AsyncLoader::decodeJob(const StatePtr &state, bool onOwnerThread) {
+  if (state->cancelRequested || m_stopping) {
+    complete(state, LoadStatus::Cancelled);
+    return;
+  }
+
+  auto decoded = produce(*state);
+  if (decoded.isError()) {
+    state->error = decoded.error();
+    complete(state, LoadStatus::Failed);
+    return;
+  }
+
+  if (state->cancelRequested) {
+    complete(state, LoadStatus::Cancelled);
+    return;
+  }
+
+  state->value = std::move(decoded.value());
+  if (!state->finish) {
+    complete(state, LoadStatus::Ready);
+    return;
+  }
+
+  if (onOwnerThread) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      state->stage = Stage::Finishing;
+    }
+    finishJob(state);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    state->stage = Stage::AwaitingFinish;
+    m_finishQueue[static_cast<usize>(state->priority.load())].push_back(
+        state);
+  }
+  m_stageChanged.notify_all();
+}
+
+void AsyncLoader::finishJob(const StatePtr &state) {
+  if (state->cancelRequested) {
+    complete(state, LoadStatus::Cancelled);
+    return;
+  }
+
+  auto result = state->finish(std::move(state->value));
+  if (result.isError()) {
+    state->error = result.error();
+    complete(state, LoadStatus::Failed);
+    return;
+  }
+  state->value = std::move(result.value());
+  complete(state, LoadStatus::Ready);
+}
+
+void AsyncLoader::complete(const StatePtr &state, LoadStatus status) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    state->stage = Stage::Done;
+    if (status != LoadStatus::Ready) {
+      state->value.reset();
+    }
+    // Drop the callbacks so captured resources are released early
+    state->decode = nullptr;
+    state->finish = nullptr;
+    state->task = nullptr;
+    state->status.store(status, std::memory_order_release);
+    --m_pending;
+  }
+  m_stageChanged.notify_all();
+}
+
+usize AsyncLoader::processUploads(f64 budgetMs) {
+  using Clock = std::chrono::steady_clock;
+  const auto start = Clock::now();
+  const f64 budget = budgetMs >= 0.0 ? budgetMs : m_config.uploadBudgetMs;
+  // Without workers, decoding happens here as well
+  const bool inlineDecode = m_workers.empty();
+  auto &queues = inlineDecode ? m_decodeQueue : m_finishQueue;
+  const Stage ready = inlineDecode ? Stage::Queued : Stage::AwaitingFinish;
+
+  usize completed = 0;
+  while (true) {
+    StatePtr state;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      state = popQueued(queues, ready);
+      if (!state) {
+        break;
+      }
+
+      const f64 elapsedMs =
+          std::chrono::duration<f64, std::milli>(Clock::now() - start)
+              .count();
+      // Always make progress; only immediate work may overrun the budget
+      if (completed > 0 && elapsedMs >= budget &&
+          state->priority != LoadPriority::Immediate) {
+        queues[static_cast<usize>(state->priority.load())].push_front(state);
+        break;
+      }
+      state->stage = inlineDecode ? Stage::Decoding : Stage::Finishing;
+    }
+
+    if (inlineDecode) {
+      decodeJob(state, true);
+    } else {
+      finishJob(state);
+    }
+    ++completed;
+  }
+  return completed;
+}
+
+void AsyncLoader::wait(const std::shared_ptr<detail::LoadState> &state) {
+  if (!state) {
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (state->status.load(std::memory_order_acquire) ==
+         LoadStatus::Pending) {
+    switch (state->stage) {
+    case Stage::Queued:
+      // Not picked up yet: do it here instead of waiting behind the queue
+      state->stage = Stage::Decoding;
+      lock.unlock();
+      decodeJob(state, true);
+      lock.lock();
+      break;
+    case Stage::AwaitingFinish:
+      state->stage = Stage::Finishing;
+      lock.unlock();
+      finishJob(state);
+      lock.lock();
+      break;
+    default:
+      m_stageChanged.wait(lock);
+      break;
+    }
+  }
+}
+
+void AsyncLoader::cancelAll() {
+  std::vector<StatePtr> cancelled;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unordered_set<detail::LoadState *> seen;
+    for (Queues *queues : {&m_decodeQueue, &m_finishQueue}) {
+      for (auto &queue : *queues) {
+        for (auto &state : queue) {
+          state->cancelRequested = true;
+          if ((state->stage == Stage::Queued ||
+               state->stage == Stage::AwaitingFinish) &&
+              seen.insert(state.get()).second) {
+            state->stage = Stage::Finishing;
+            cancelled.push_back(state);
+          }
+        }
+        queue.clear();
+      }
+    }
+  }
+
+  for (const auto &state : cancelled) {
+    complete(state, LoadStatus::Cancelled);
+  }
+}
+
+usize AsyncLoader::pendingCount() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_pending;
+}
+
+} // namespace NovelMind::resource
@@ -0,0 +1,443 @@
+#include "NovelMind/resource/decoded_asset_cache.hpp"
+#include "NovelMind/core/logger.hpp"
+#include "NovelMind/platform/mapped_file.hpp"
+#include "NovelMind/scripting/compiled_script_image.hpp"
+#include "NovelMind/vfs/resource_id.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace NovelMind::resource {
+
+namespace {
+
+constexpr char kMagic[4] = {'N', 'M', 'D', 'A'};
+constexpr u32 kFormatVersion = 1;
+constexpr const char *kEntryExtension = ".nmda";
+constexpr const char *kTempExtension = ".tmp";
+
+struct DecodedAssetHeader {
+  char magic[4];
+  u32 formatVersion;
+  u32 engineVersion;
+  u32 kind;
+  u64 keyHash; // FNV-1a of kind, id and variant
+  u64 payloadSize;
+  u32 sourceChecksum;
+  u32 payloadOffset;
+  u32 meta[4]; // Kind-specific, see the typed load/store functions
+  u8 reserved[8];
+};
+
+static_assert(sizeof(DecodedAssetHeader) == 64,
+              "Decoded asset header layout changed");
+
+// Glyph metrics as stored in a FontAtlas entry
+struct GlyphRecord {
+  u32 codepoint;
+  f32 advanceX;
+  f32 bearingX;
+  f32 bearingY;
+  f32 width;
+  f32 height;
+  f32 uv[4];
+};
+
+static_assert(sizeof(GlyphRecord) == 40, "Glyph record layout changed");
+
+u64 keyHashOf(const DecodedAssetKey &key) {
+  std::string text = std::to_string(static_cast<u32>(key.kind));
+  text.push_back('\0');
+  text += key.id;
+  text.push_back('\0');
+  text += key.variant;
+  return VFS::ResourceId::hashOf(text);
+}
+
+std::string fileNameOf(u64 keyHash) {
+  static constexpr char kHex[] = "0123456789abcdef";
+  std::string name(16, '0');
+  for (usize i = 0; i < 16; ++i) {
+    name[15 - i] = kHex[(keyHash >> (i * 4)) & 0xF];
+  }
+  return name + kEntryExtension;
+}
+
+i64 nowTicks() {
+  return static_cast<i64>(
+      fs::file_time_type::clock::now().time_since_epoch().count());
+}
+
+} // namespace
+
+DecodedAssetCache::DecodedAssetCache(DecodedAssetCacheConfig config)
+    : m_config(std::move(config)) {}
+
+Result<void> DecodedAssetCache::open() {
+  if (m_config.directory.empty()) {
+    return Result<void>::error("Decoded asset cache directory is empty");
+  }
+
+  std::error_code ec;
+  fs::create_directories(m_config.directory, ec);
+  if (ec) {
+    return Result<void>::error("Cannot create decoded asset cache '" +
+                               m_config.directory + "': " + ec.message());
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_entries.clear();
+  m_totalBytes = 0;
+  for (const auto &file : fs::directory_iterator(m_config.directory, ec)) {
+    if (!file.is_regular_file(ec)) {
+      continue;
+    }
+    const auto extension = file.path().extension().string();
+    if (extension == kTempExtension) {
+      // Left behind by a store() that never finished
+      fs::remove(file.path(), ec);
+      continue;
+    }
+    if (extension != kEntryExtension) {
+      continue;
+    }
+
+    Entry entry;
+    entry.size = static_cast<usize>(file.file_size(ec));
+    entry.lastUse = static_cast<i64>(
+        file.last_write_time(ec).time_since_epoch().count());
+    m_totalBytes += entry.size;
+    m_entries[file.path().filename().string()] = entry;
+  }
+
+  m_open = true;
+  evictToFit();
+  m_stats.entryCount = m_entries.size();
+  m_stats.totalBytes = m_totalBytes;
+  return Result<void>::ok();
+}
+
+bool DecodedAssetCache::isOpen() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_open;
+}
+
+std::string DecodedAssetCache::pathOf(const std::string &name) const {
+  return (fs::path(m_config.directory) / name).string();
+}
+
+void DecodedAssetCache::forget(const std::string &name) {
+  std::error_code ec;
+  fs::remove(pathOf(name), ec);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_entries.find(name);
+  if (it != m_entries.end()) {
+    m_totalBytes -= it->second.size;
+    m_entries.erase(it);
+  }
+  m_stats.entryCount = m_entries.size();
+  m_stats.totalBytes = m_totalBytes;
+}
+
+std::optional<SharedBuffer>
+DecodedAssetCache::loadEntry(const DecodedAssetKey &key, u32 (&meta)[4]) {
+  const u64 keyHash = keyHashOf(key);
+  const std::string name = fileNameOf(keyHash);
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_open || m_entries.find(name) == m_entries.end()) {
+      ++m_stats.misses;
+      return std::nullopt;
+    }
+  }
+
+  auto file = platform::MappedFile::open(pathOf(name));
+  bool valid =
+      file.isOk() && file.value().size() >= sizeof(DecodedAssetHeader);
+  DecodedAssetHeader header{};
+  if (valid) {
+    std::memcpy(&header, file.value().data(), sizeof(header));
+    const u64 end = u64{header.payloadOffset} + header.payloadSize;
+    valid = std::memcmp(header.magic, kMagic, sizeof(kMagic)) == 0 &&
+            header.formatVersion == kFormatVersion &&
+            header.payloadOffset >= sizeof(DecodedAssetHeader) &&
+            end <= file.value().size();
+  }
+
+  // Written by another engine version, or for an older source
+  if (!valid || header.engineVersion != m_config.engineVersion ||
+      header.kind != static_cast<u32>(key.kind) || header.keyHash != keyHash ||
+      header.sourceChecksum != key.sourceChecksum) {
+    forget(name);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_stats.misses;
+    return std::nullopt;
+  }
+
+  // Record the use where it survives a restart
+  std::error_code ec;
+  const auto now = fs::file_time_type::clock::now();
+  fs::last_write_time(pathOf(name), now, ec);
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(name);
+    if (it != m_entries.end()) {
+      it->second.lastUse = static_cast<i64>(now.time_since_epoch().count());
+    }
+    ++m_stats.hits;
+  }
+
+  std::memcpy(meta, header.meta, sizeof(header.meta));
+  auto mapping =
+      std::make_shared<platform::MappedFile>(std::move(file).value());
+  const auto payload = mapping->bytes().subspan(
+      header.payloadOffset, static_cast<usize>(header.payloadSize));
+  return SharedBuffer(std::move(mapping), payload);
+}
+
+Result<void> DecodedAssetCache::storeEntry(const DecodedAssetKey &key,
+                                           const u32 (&meta)[4],
+                                           std::span<const u8> first,
+                                           std::span<const u8> second) {
+  if (!isOpen()) {
+    return Result<void>::error("Decoded asset cache is not open");
+  }
+
+  const usize fileSize = sizeof(DecodedAssetHeader) + first.size() +
+                         second.size();
+  if (fileSize > m_config.maxBytes) {
+    return Result<void>::ok(); // Never admitted, like ResourceCache
+  }
+
+  DecodedAssetHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.formatVersion = kFormatVersion;
+  header.engineVersion = m_config.engineVersion;
+  header.kind = static_cast<u32>(key.kind);
+  header.keyHash = keyHashOf(key);
+  header.payloadSize = first.size() + second.size();
+  header.sourceChecksum = key.sourceChecksum;
+  header.payloadOffset = sizeof(DecodedAssetHeader);
+  std::memcpy(header.meta, meta, sizeof(header.meta));
+
+  const std::string name = fileNameOf(header.keyHash);
+  const std::string path = pathOf(name);
+
+  // Unique per writer, so concurrent stores of one key cannot interleave
+  static std::atomic<u64> s_tempCounter{0};
+  const std::string tempPath =
+      path + "." +
+      std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) +
+      "-" + std::to_string(s_tempCounter.fetch_add(1)) + kTempExtension;
+  {
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(first.data()),
+              static_cast<std::streamsize>(first.size()));
+    out.write(reinterpret_cast<const char *>(second.data()),
+              static_cast<std::streamsize>(second.size()));
+    if (!out) {
+      std::error_code ec;
+      out.close();
+      fs::remove(tempPath, ec);
+      return Result<void>::error("Failed to write decoded asset: " + tempPath);
+    }
+  }
+
+  std::error_code ec;
+  fs::rename(tempPath, path, ec);
+  if (ec) {
+    fs::remove(tempPath, ec);
+    return Result<void>::error("Failed to store decoded asset: " + path);
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  Entry &entry = m_entries[name];
+  m_totalBytes -= entry.size;
+  entry.size = fileSize;
+  entry.lastUse = nowTicks();
+  m_totalBytes += fileSize;
+  ++m_stats.stores;
+  evictToFit();
+  m_stats.entryCount = m_entries.size();
+  m_stats.totalBytes = m_totalBytes;
+  return Result<void>::ok();
+}
+
+void DecodedAssetCache::evictToFit() {
+  while (m_totalBytes > m_config.maxBytes && !m_entries.empty()) {
+    auto oldest = std::min_element(
+        m_entries.begin(), m_entries.end(), [](const auto &a, const auto &b) {
+          return a.second.lastUse < b.second.lastUse;
+        });
+    std::error_code ec;
+    fs::remove(pathOf(oldest->first), ec);
+    m_totalBytes -= oldest->second.size;
+    m_entries.erase(oldest);
+    ++m_stats.evictions;
+  }
+}
+
+std::optional<SharedBuffer>
+DecodedAssetCache::load(const DecodedAssetKey &key) {
+  u32 meta[4];
+  return loadEntry(key, meta);
+}
+
+Result<void> DecodedAssetCache::store(const DecodedAssetKey &key,
+                                      std::span<const u8> payload) {
+  const u32 meta[4] = {};
+  return storeEntry(key, meta, payload);
+}
+
+// Image meta: width, height
+std::optional<DecodedImage>
+DecodedAssetCache::loadImage(const DecodedAssetKey &key) {
+  u32 meta[4];
+  auto payload = loadEntry(key, meta);
+  if (!payload || payload->size() != usize{meta[0]} * meta[1] * 4 ||
+      meta[0] == 0) {
+    return std::nullopt;
+  }
+  DecodedImage image;
+  image.width = static_cast<i32>(meta[0]);
+  image.height = static_cast<i32>(meta[1]);
+  image.pixels = std::move(*payload);
+  return image;
+}
+
+Result<void> DecodedAssetCache::storeImage(const DecodedAssetKey &key,
+                                           const DecodedImage &image) {
+  if (image.width <= 0 || image.height <= 0 ||
+      image.pixels.size() != static_cast<usize>(image.width) *
+                                 static_cast<usize>(image.height) * 4) {
+    return Result<void>::error("Invalid decoded image for " + key.id);
+  }
+  const u32 meta[4] = {static_cast<u32>(image.width),
+                       static_cast<u32>(image.height), 0, 0};
+  return storeEntry(key, meta, image.pixels);
+}
+
+// FontAtlas meta: width, height, line height, glyph count
+std::optional<renderer::FontAtlasImage>
+DecodedAssetCache::loadFontAtlas(const DecodedAssetKey &key) {
+  u32 meta[4];
+  auto payload = loadEntry(key, meta);
+  if (!payload) {
+    return std::nullopt;
+  }
+  const usize glyphBytes = usize{meta[3]} * sizeof(GlyphRecord);
+  const usize pixelBytes = usize{meta[0]} * meta[1] * 4;
+  if (payload->size() != glyphBytes + pixelBytes) {
+    return std::nullopt;
+  }
+
+  renderer::FontAtlasImage atlas;
+  atlas.image.width = static_cast<i32>(meta[0]);
+  atlas.image.height = static_cast<i32>(meta[1]);
+  atlas.lineHeight = static_cast<i32>(meta[2]);
+  atlas.glyphs.reserve(meta[3]);
+  for (u32 i = 0; i < meta[3]; ++i) {
+    GlyphRecord record;
+    std::memcpy(&record, payload->data() + i * sizeof(GlyphRecord),
+                sizeof(record));
+    renderer::GlyphInfo glyph;
+    glyph.advanceX = record.advanceX;
+    glyph.bearingX = record.bearingX;
+    glyph.bearingY = record.bearingY;
+    glyph.width = record.width;
+    glyph.height = record.height;
+    glyph.uv = renderer::Rect(record.uv[0], record.uv[1], record.uv[2],
+                              record.uv[3]);
+    atlas.glyphs[static_cast<char32_t>(record.codepoint)] = glyph;
+  }
+  const auto pixels = payload->span().subspan(glyphBytes);
+  atlas.image.pixels.assign(pixels.begin(), pixels.end());
+  return atlas;
+}
+
+Result<void>
+DecodedAssetCache::storeFontAtlas(const DecodedAssetKey &key,
+                                  const renderer::FontAtlasImage &atlas) {
+  const auto &image = atlas.image;
+  if (image.width <= 0 || image.height <= 0 ||
+      image.pixels.size() != static_cast<usize>(image.width) *
+                                 static_cast<usize>(image.height) * 4) {
+    return Result<void>::error("Invalid font atlas for " + key.id);
+  }
+
+  // Sorted so identical atlases produce identical files
+  std::vector<GlyphRecord> records;
+  records.reserve(atlas.glyphs.size());
+  for (const auto &[codepoint, glyph] : atlas.glyphs) {
+    records.push_back({static_cast<u32>(codepoint),
+                       glyph.advanceX,
+                       glyph.bearingX,
+                       glyph.bearingY,
+                       glyph.width,
+                       glyph.height,
+                       {glyph.uv.x, glyph.uv.y, glyph.uv.width,
+                        glyph.uv.height}});
+  }
+  std::sort(records.begin(), records.end(),
+            [](const GlyphRecord &a, const GlyphRecord &b) {
+              return a.codepoint < b.codepoint;
+            });
+
+  const u32 meta[4] = {static_cast<u32>(image.width),
+                       static_cast<u32>(image.height),
+                       static_cast<u32>(atlas.lineHeight),
+                       static_cast<u32>(records.size())};
+  return storeEntry(
+      key, meta,
+      std::span<const u8>(reinterpret_cast<const u8 *>(records.data()),
+                          records.size() * sizeof(GlyphRecord)),
+      image.pixels);
+}
+
+std::optional<scripting::CompiledScript>
+DecodedAssetCache::loadScript(const DecodedAssetKey &key) {
+  auto payload = load(key);
+  if (!payload) {
+    return std::nullopt;
+  }
+  auto image = scripting::CompiledScriptImage::fromBuffer(payload->toVector());
+  if (image.isError()) {
+    NOVELMIND_LOG_WARN("Discarding cached script '" + key.id +
+                       "': " + image.error());
+    return std::nullopt;
+  }
+  return image.value().toCompiledScript();
+}
+
+Result<void>
+DecodedAssetCache::storeScript(const DecodedAssetKey &key,
+                               const scripting::CompiledScript &script) {
+  return store(key, scripting::serializeNmc2(script, m_config.engineVersion));
+}
+
+void DecodedAssetCache::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (const auto &[name, entry] : m_entries) {
+    std::error_code ec;
+    fs::remove(pathOf(name), ec);
+  }
+  m_entries.clear();
+  m_totalBytes = 0;
+  m_stats.entryCount = 0;
+  m_stats.totalBytes = 0;
+}
+
+DecodedAssetCacheStats DecodedAssetCache::stats() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_stats;
+}
+
+} // namespace NovelMind::resource
@@ -1,7 +1,9 @@
 #include "NovelMind/resource/resource_manager.hpp"
 #include "NovelMind/core/logger.hpp"
+#include "NovelMind/vfs/pack_security.hpp"
 #include <filesystem>
 #include <fstream>
+#include <unordered_set>
 
 namespace NovelMind::resource {
 
@@ -36,13 +38,40 @@ bool readFileToBytes(const std::string &path, std::vector<u8> &out) {
 
 } // namespace
 
-ResourceManager::ResourceManager(vfs::IVirtualFileSystem *vfs) : m_vfs(vfs) {}
+ResourceManager::ResourceManager(vfs::IVirtualFileSystem *vfs) : m_vfs(vfs) {
+  AsyncLoaderConfig config;
+  config.workerThreads = 0;
+  enableAsyncLoading(config);
+}
+
+ResourceManager::~ResourceManager() {
+  // Workers read through this object; stop them before members go away
+  m_loader.reset();
+  clearCache();
+}
 
-ResourceManager::~ResourceManager() { clearCache(); }
+void ResourceManager::setVfs(vfs::IVirtualFileSystem *vfs) {
+  std::unique_lock<std::shared_mutex> lock(m_sourceMutex);
+  m_vfs = vfs;
+}
 
-void ResourceManager::setVfs(vfs::IVirtualFileSystem *vfs) { m_vfs = vfs; }
+LoadHandle<usize> ResourceManager::preload(std::span<const std::string> ids,
+                                           LoadPriority priority) {
+  if (ids.empty()) {
+    return AsyncLoader::resolved(std::make_shared<usize>(0));
+  }
+  std::function<Result<std::shared_ptr<usize>>()> batch =
+      [this, ids = std::vector<std::string>(ids.begin(), ids.end())] {
+        std::shared_lock<std::shared_mutex> lock(m_sourceMutex);
+        const usize cached = m_vfs ? m_vfs->preload(ids) : 0;
+        return Result<std::shared_ptr<usize>>::ok(
+            std::make_shared<usize>(cached));
+      };
+  return m_loader->requestTask("preload", priority, std::move(batch));
+}
 
 void ResourceManager::setBasePath(const std::string &path) {
+  std::unique_lock<std::shared_mutex> lock(m_sourceMutex);
   m_basePath = path;
   if (!m_basePath.empty() &&
       m_basePath.back() != '/' && m_basePath.back() != '\\') {
@@ -50,6 +79,10 @@ void ResourceManager::setBasePath(const std::string &path) {
   }
 }
 
+void ResourceManager::setDecodedAssetCache(DecodedAssetCache *cache) {
+  m_decodedCache.store(cache, std::memory_order_release);
+}
+
 Result<TextureHandle> ResourceManager::loadTexture(const std::string &id) {
   if (id.empty()) {
     return Result<TextureHandle>::error("Texture id is empty");
@@ -60,23 +93,220 @@ Result<TextureHandle> ResourceManager::loadTexture(const std::string &id) {
     return Result<TextureHandle>::ok(it->second);
   }
 
+  // Finish an in-flight request here rather than loading twice
+  auto pending = m_pendingTextures.find(id);
+  if (pending != m_pendingTextures.end()) {
+    TextureLoadHandle handle = pending->second;
+    auto waited = m_loader->wait(handle);
+    collectTexture(id, handle);
+    if (waited.isOk()) {
+      return Result<TextureHandle>::ok(waited.value());
+    }
+  }
+
   auto dataResult = readResource(id);
   if (dataResult.isError()) {
     return Result<TextureHandle>::error(dataResult.error());
   }
 
+  auto image = decodeTexture(id, dataResult.value());
+  if (image.isError()) {
+    return Result<TextureHandle>::error(image.error());
+  }
+
   auto texture = std::make_shared<renderer::Texture>();
-  auto loadResult = texture->loadFromMemory(dataResult.value());
+  auto loadResult = texture->loadFromRGBA(image.value().pixels.data(),
+                                          image.value().width,
+                                          image.value().height);
   if (loadResult.isError()) {
     return Result<TextureHandle>::error(loadResult.error());
   }
 
   m_textures[id] = texture;
+  m_failedTextures.erase(id);
   return Result<TextureHandle>::ok(texture);
 }
 
 void ResourceManager::unloadTexture(const std::string &id) {
   m_textures.erase(id);
+  auto pending = m_pendingTextures.find(id);
+  if (pending != m_pendingTextures.end()) {
+    pending->second.cancel();
+    m_pendingTextures.erase(pending);
+  }
+}
+
+void ResourceManager::enableAsyncLoading(const AsyncLoaderConfig &config) {
+  m_loader.reset();
+  m_pendingTextures.clear();
+  m_pendingData.clear();
+  m_loader = std::make_unique<AsyncLoader>(
+      [this](const std::string &id) { return readResource(id); }, config);
+}
+
+bool ResourceManager::isAsyncLoadingEnabled() const {
+  return m_loader->config().workerThreads > 0;
+}
+
+TextureLoadHandle ResourceManager::requestTexture(const std::string &id,
+                                                  LoadPriority priority) {
+  auto it = m_textures.find(id);
+  if (it != m_textures.end() && it->second && it->second->isValid()) {
+    return AsyncLoader::resolved(it->second);
+  }
+
+  auto pending = m_pendingTextures.find(id);
+  if (pending != m_pendingTextures.end()) {
+    if (priority < pending->second.state()->priority.load()) {
+      m_loader->setPriority(pending->second.state(), priority);
+    }
+    return pending->second;
+  }
+
+  using ImageHandle = std::shared_ptr<DecodedImage>;
+  auto handle = m_loader->request<renderer::Texture, DecodedImage>(
+      id, priority,
+      [this, id](const SharedBuffer &bytes) -> Result<ImageHandle> {
+        auto image = decodeTexture(id, bytes);
+        if (image.isError()) {
+          return Result<ImageHandle>::error(image.error());
+        }
+        return Result<ImageHandle>::ok(
+            std::make_shared<DecodedImage>(std::move(image.value())));
+      },
+      [](ImageHandle image) -> Result<TextureHandle> {
+        auto texture = std::make_shared<renderer::Texture>();
+        auto uploaded = texture->loadFromRGBA(image->pixels.data(),
+                                              image->width, image->height);
+        if (uploaded.isError()) {
+          return Result<TextureHandle>::error(uploaded.error());
+        }
+        return Result<TextureHandle>::ok(std::move(texture));
+      });
+  m_pendingTextures.emplace(id, handle);
+  return handle;
+}
+
+DataLoadHandle ResourceManager::requestData(const std::string &id,
+                                            LoadPriority priority) {
+  auto it = m_data.find(id);
+  if (it != m_data.end()) {
+    return AsyncLoader::resolved(std::make_shared<SharedBuffer>(it->second));
+  }
+
+  auto pending = m_pendingData.find(id);
+  if (pending != m_pendingData.end()) {
+    if (priority < pending->second.state()->priority.load()) {
+      m_loader->setPriority(pending->second.state(), priority);
+    }
+    return pending->second;
+  }
+
+  auto handle = m_loader->requestData(id, priority);
+  m_pendingData.emplace(id, handle);
+  return handle;
+}
+
+void ResourceManager::unloadData(const std::string &id) {
+  m_data.erase(id);
+  auto pending = m_pendingData.find(id);
+  if (pending != m_pendingData.end()) {
+    pending->second.cancel();
+    m_pendingData.erase(pending);
+  }
+}
+
+void ResourceManager::setFailedTextureRetryDelay(f64 seconds) {
+  m_failedRetryDelay =
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<f64>(seconds));
+}
+
+TextureHandle ResourceManager::acquireTexture(const std::string &id) {
+  if (!isAsyncLoadingEnabled()) {
+    auto result = loadTexture(id);
+    return result.isOk() ? result.value() : nullptr;
+  }
+
+  auto it = m_textures.find(id);
+  if (it != m_textures.end() && it->second && it->second->isValid()) {
+    return it->second;
+  }
+  if (id.empty()) {
+    return nullptr;
+  }
+  auto failed = m_failedTextures.find(id);
+  if (failed != m_failedTextures.end()) {
+    if (std::chrono::steady_clock::now() < failed->second) {
+      return nullptr;
+    }
+    m_failedTextures.erase(failed);
+  }
+
+  auto handle = requestTexture(id, LoadPriority::Immediate);
+  if (handle.isDone()) {
+    collectTexture(id, handle);
+  }
+  return handle.get();
+}
+
+usize ResourceManager::update(f64 budgetMs) {
+  const usize completed = m_loader->processUploads(budgetMs);
+  for (auto it = m_pendingTextures.begin(); it != m_pendingTextures.end();) {
+    if (!it->second.isDone()) {
+      ++it;
+      continue;
+    }
+    // Copies: collectTexture erases the entry
+    const std::string id = it->first;
+    const TextureLoadHandle handle = it->second;
+    ++it;
+    collectTexture(id, handle);
+  }
+  for (auto it = m_pendingData.begin(); it != m_pendingData.end();) {
+    if (!it->second.isDone()) {
+      ++it;
+      continue;
+    }
+    const std::string id = it->first;
+    const DataLoadHandle handle = it->second;
+    ++it;
+    collectData(id, handle);
+  }
+  return completed;
+}
+
+void ResourceManager::collectTexture(const std::string &id,
+                                     const TextureLoadHandle &handle) {
+  m_pendingTextures.erase(id);
+  switch (handle.status()) {
+  case LoadStatus::Ready:
+    m_textures[id] = handle.get();
+    break;
+  case LoadStatus::Failed:
+    NOVELMIND_LOG_WARN("Failed to load texture '" + id +
+                       "': " + handle.error());
+    m_failedTextures[id] =
+        std::chrono::steady_clock::now() + m_failedRetryDelay;
+    break;
+  default:
+    break;
+  }
+}
+
+void ResourceManager::collectData(const std::string &id,
+                                  const DataLoadHandle &handle) {
+  m_pendingData.erase(id);
+  switch (handle.status()) {
+  case LoadStatus::Ready:
+    m_data[id] = *handle.get();
+    break;
+  case LoadStatus::Failed:
+    NOVELMIND_LOG_WARN("Failed to read '" + id + "': " + handle.error());
+    break;
+  default:
+    break;
+  }
 }
 
 Result<FontHandle> ResourceManager::loadFont(const std::string &id, i32 size) {
@@ -139,7 +369,8 @@ ResourceManager::loadFontAtlas(const std::string &id, i32 size,
   }
 
   auto atlas = std::make_shared<renderer::FontAtlas>();
-  auto buildResult = atlas->build(*fontResult.value(), charset);
+  auto buildResult =
+      buildFontAtlas(*atlas, id, *fontResult.value(), size, charset);
   if (buildResult.isError()) {
     return Result<FontAtlasHandle>::error(buildResult.error());
   }
@@ -149,17 +380,156 @@ ResourceManager::loadFontAtlas(const std::string &id, i32 size,
 }
 
 Result<std::vector<u8>> ResourceManager::readData(const std::string &id) const {
+  auto data = readShared(id);
+  if (data.isError()) {
+    return Result<std::vector<u8>>::error(data.error());
+  }
+  return Result<std::vector<u8>>::ok(data.value().toVector());
+}
+
+Result<SharedBuffer> ResourceManager::readShared(const std::string &id) const {
+  // Bytes fetched ahead by requestData(), e.g. prefetched audio
+  auto it = m_data.find(id);
+  if (it != m_data.end()) {
+    return Result<SharedBuffer>::ok(it->second);
+  }
+  auto pending = m_pendingData.find(id);
+  if (pending != m_pendingData.end() && pending->second.isReady()) {
+    return Result<SharedBuffer>::ok(*pending->second.get());
+  }
   return readResource(id);
 }
 
 void ResourceManager::clearCache() {
+  if (m_loader) {
+    m_loader->cancelAll();
+  }
+  m_pendingTextures.clear();
+  m_failedTextures.clear();
+  m_pendingData.clear();
+  m_data.clear();
   m_textures.clear();
   m_fonts.clear();
   m_fontAtlases.clear();
 }
 
+usize ResourceManager::reload(const std::string &id) {
+  m_failedTextures.erase(id);
+  // Bytes read ahead are stale; the next read goes to the source
+  unloadData(id);
+  auto pending = m_pendingTextures.find(id);
+  if (pending != m_pendingTextures.end()) {
+    pending->second.cancel();
+    m_pendingTextures.erase(pending);
+  }
+
+  usize reloaded = 0;
+  if (m_textures.count(id) != 0 || m_fonts.count(id) != 0 ||
+      m_fontAtlases.count(id) != 0) {
+    auto bytes = readResource(id);
+    if (bytes.isOk()) {
+      reloaded = reloadFrom(id, bytes.value());
+    } else {
+      NOVELMIND_LOG_WARN("Cannot reload '" + id + "': " + bytes.error());
+    }
+  }
+
+  for (const auto &listener : m_reloadListeners) {
+    listener(id);
+  }
+  return reloaded;
+}
+
+usize ResourceManager::reloadAll() {
+  std::unordered_set<std::string> ids;
+  for (const auto &entry : m_textures) {
+    ids.insert(entry.first);
+  }
+  for (const auto &entry : m_fonts) {
+    ids.insert(entry.first);
+  }
+  for (const auto &entry : m_fontAtlases) {
+    ids.insert(entry.first);
+  }
+
+  usize reloaded = 0;
+  for (const auto &id : ids) {
+    reloaded += reload(id);
+  }
+  return reloaded;
+}
+
+void ResourceManager::addReloadListener(ReloadListener listener) {
+  m_reloadListeners.push_back(std::move(listener));
+}
+
+usize ResourceManager::reloadFrom(const std::string &id,
+                                  const SharedBuffer &bytes) {
+  usize reloaded = 0;
+  const auto warn = [&id](const std::string &error) {
+    NOVELMIND_LOG_WARN("Cannot reload '" + id + "': " + error);
+  };
+
+  // Decode into fresh objects and move them over the live ones, so every
+  // handle sees the change and failures leave the old asset in place
+  auto texture = m_textures.find(id);
+  if (texture != m_textures.end() && texture->second) {
+    auto image = decodeTexture(id, bytes);
+    renderer::Texture fresh;
+    auto loaded = image.isOk()
+                      ? fresh.loadFromRGBA(image.value().pixels.data(),
+                                           image.value().width,
+                                           image.value().height)
+                      : Result<void>::error(image.error());
+    if (loaded.isOk()) {
+      *texture->second = std::move(fresh);
+      ++reloaded;
+    } else {
+      warn(loaded.error());
+    }
+  }
+
+  auto fonts = m_fonts.find(id);
+  if (fonts != m_fonts.end()) {
+    for (auto &[size, font] : fonts->second) {
+      renderer::Font fresh;
+      auto loaded = fresh.loadFromMemory(bytes, size);
+      if (font && loaded.isOk()) {
+        *font = std::move(fresh);
+        ++reloaded;
+      } else if (loaded.isError()) {
+        warn(loaded.error());
+      }
+    }
+  }
+
+  auto atlases = m_fontAtlases.find(id);
+  if (atlases != m_fontAtlases.end() && fonts != m_fonts.end()) {
+    for (auto &[size, charsets] : atlases->second) {
+      const auto font = fonts->second.find(size);
+      if (font == fonts->second.end() || !font->second) {
+        continue;
+      }
+      for (auto &[charset, atlas] : charsets) {
+        renderer::FontAtlas fresh;
+        auto built = buildFontAtlas(fresh, id, *font->second, size, charset);
+        if (atlas && built.isOk()) {
+          *atlas = std::move(fresh);
+          ++reloaded;
+        } else if (built.isError()) {
+          warn(built.error());
+        }
+      }
+    }
+  }
+
+  return reloaded;
+}
+
 size_t ResourceManager::getTextureCount() const { return m_textures.size(); }
 
+size_t ResourceManager::getDataCount() const { return m_data.size(); }
+
 size_t ResourceManager::getFontCount() const {
   size_t count = 0;
   for (const auto &pair : m_fonts) {
@@ -178,26 +548,106 @@ size_t ResourceManager::getFontAtlasCount() const {
   return count;
 }
 
-Result<std::vector<u8>>
+Result<SharedBuffer>
 ResourceManager::readResource(const std::string &id) const {
+  // Shared: workers read in parallel, setVfs() waits for them to finish
+  std::shared_lock<std::shared_mutex> lock(m_sourceMutex);
   std::vector<u8> data;
 
   std::string path = resolvePath(id);
   if (!path.empty() && readFileToBytes(path, data)) {
-    return Result<std::vector<u8>>::ok(std::move(data));
+    return Result<SharedBuffer>::ok(SharedBuffer(std::move(data)));
   }
 
   if (m_vfs) {
-    auto vfsResult = m_vfs->readFile(id);
+    auto vfsResult = m_vfs->readShared(id);
     if (vfsResult.isOk()) {
       return vfsResult;
     }
   }
 
-  return Result<std::vector<u8>>::error(
+  return Result<SharedBuffer>::error(
       "Failed to read resource: " + id);
 }
 
+u32 ResourceManager::sourceChecksum(const std::string &id,
+                                    const SharedBuffer &bytes) const {
+  {
+    // Packs record a checksum per entry; files on disk take precedence
+    std::shared_lock<std::shared_mutex> lock(m_sourceMutex);
+    if (m_vfs && resolvePath(id).empty()) {
+      auto info = m_vfs->getInfo(id);
+      if (info && info->checksum != 0) {
+        return info->checksum;
+      }
+    }
+  }
+  return VFS::PackIntegrityChecker::calculateCrc32(bytes.data(), bytes.size());
+}
+
+Result<DecodedImage>
+ResourceManager::decodeTexture(const std::string &id,
+                               const SharedBuffer &bytes) const {
+  DecodedAssetCache *cache = m_decodedCache.load(std::memory_order_acquire);
+  std::optional<DecodedAssetKey> key;
+  if (cache) {
+    key = DecodedAssetKey{DecodedAssetKind::Image, id, {},
+                          sourceChecksum(id, bytes)};
+    if (auto cached = cache->loadImage(*key)) {
+      return Result<DecodedImage>::ok(std::move(*cached));
+    }
+  }
+
+  auto decoded = renderer::Texture::decodeImage(bytes);
+  if (decoded.isError()) {
+    return Result<DecodedImage>::error(decoded.error());
+  }
+  DecodedImage image;
+  image.width = decoded.value().width;
+  image.height = decoded.value().height;
+  image.pixels = SharedBuffer(std::move(decoded.value().pixels));
+
+  if (key) {
+    auto stored = cache->storeImage(*key, image);
+    if (stored.isError()) {
+      NOVELMIND_LOG_WARN("Not caching decoded texture '" + id +
+                         "': " + stored.error());
+    }
+  }
+  return Result<DecodedImage>::ok(std::move(image));
+}
+
+Result<void> ResourceManager::buildFontAtlas(renderer::FontAtlas &atlas,
+                                             const std::string &id,
+                                             const renderer::Font &font,
+                                             i32 size,
+                                             const std::string &charset) const {
+  DecodedAssetCache *cache = m_decodedCache.load(std::memory_order_acquire);
+  if (!cache) {
+    return atlas.build(font, charset);
+  }
+
+  const DecodedAssetKey key{DecodedAssetKind::FontAtlas, id,
+                            std::to_string(size) + ":" + charset,
+                            sourceChecksum(id, font.getData())};
+  if (auto cached = cache->loadFontAtlas(key)) {
+    if (atlas.load(*cached).isOk()) {
+      return Result<void>::ok();
+    }
+  }
+
+  auto image = renderer::FontAtlas::rasterize(font, charset);
+  if (image.isError()) {
+    return Result<void>::error(image.error());
+  }
+  auto stored = cache->storeFontAtlas(key, image.value());
+  if (stored.isError()) {
+    NOVELMIND_LOG_WARN("Not caching font atlas '" + id +
+                       "': " + stored.error());
+  }
+  return atlas.load(image.value());
+}
+
 std::string ResourceManager::resolvePath(const std::string &id) const {
   if (id.empty()) {
     return {};
@@ -120,6 +120,11 @@ void SceneGraph::showBackground(const std::string &textureId) {
   // Clear existing backgrounds
   m_backgroundLayer.clear();
 
+  // Start the load now so it is usually uploaded by the first render
+  if (m_resources && !textureId.empty()) {
+    m_resources->requestTexture(textureId, resource::LoadPriority::Immediate);
+  }
+
   auto bg = std::make_unique<BackgroundObject>("main_background");
   bg->setTextureId(textureId);
   registerObject(bg.get());
@@ -139,6 +144,11 @@ CharacterObject *SceneGraph::showCharacter(const std::string &id,
     return character;
   }
 
+  if (m_resources && !characterId.empty()) {
+    m_resources->requestTexture(characterId,
+                                resource::LoadPriority::Immediate);
+  }
+
   // Create new character
   auto character = std::make_unique<CharacterObject>(id, characterId);
   character->setSlotPosition(position);
@@ -63,15 +63,12 @@ void CharacterObject::render(renderer::IRenderer &renderer) {
     return;
   }
 
-  auto texResult = m_resources->loadTexture(textureId);
-  if (texResult.isError()) {
-    return;
-  }
-
-  const auto &texture = *texResult.value();
-  if (!texture.isValid()) {
+  // Null while the texture is still loading
+  auto textureHandle = m_resources->acquireTexture(textureId);
+  if (!textureHandle || !textureHandle->isValid()) {
     return;
   }
+  const auto &texture = *textureHandle;
 
   renderer::Transform2D transform = m_transform;
   const float desiredW = detail::parseFloat(getProperty("width"), -1.0f);
@@ -95,9 +95,9 @@ void DialogueUIObject::render(renderer::IRenderer &renderer) {
                       m_transform.y - height * m_anchorY, width, height};
 
   if (!m_backgroundTextureId.empty()) {
-    auto texResult = m_resources->loadTexture(m_backgroundTextureId);
-    if (texResult.isOk() && texResult.value()->isValid()) {
-      const auto &texture = *texResult.value();
+    auto textureHandle = m_resources->acquireTexture(m_backgroundTextureId);
+    if (textureHandle && textureHandle->isValid()) {
+      const auto &texture = *textureHandle;
       renderer::Transform2D transform{};
       transform.x = rect.x;
       transform.y = rect.y;
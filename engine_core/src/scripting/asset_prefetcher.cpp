@@ -0,0 +1,341 @@
+#include "NovelMind/scripting/asset_prefetcher.hpp"
+#include <algorithm>
+#include <deque>
+#include <unordered_set>
+
+namespace NovelMind::scripting {
+
+namespace {
+
+// The runtime stops on these until the player acts
+bool isWaitOpcode(OpCode op) {
+  return op == OpCode::SAY || op == OpCode::CHOICE || op == OpCode::WAIT;
+}
+
+const std::string_view *stringOperand(const PrefetchScript &script,
+                                      const Instruction &instr) {
+  if (instr.operand >= script.strings.size()) {
+    return nullptr;
+  }
+  const std::string_view &value = script.strings[instr.operand];
+  return value.empty() ? nullptr : &value;
+}
+
+// Views over an owning script for the duration of one analysis call
+struct ScriptViews {
+  std::vector<std::string_view> strings;
+  PrefetchScript script;
+
+  explicit ScriptViews(const CompiledScript &source)
+      : strings(source.stringTable.begin(), source.stringTable.end()),
+        script{source.instructions, strings, &source} {}
+  ScriptViews(const ScriptViews &) = delete;
+  ScriptViews &operator=(const ScriptViews &) = delete;
+};
+
+} // namespace
+
+std::vector<PrefetchTarget> AssetPrefetcher::scan(const CompiledScript &script,
+                                                  u32 ip, u32 horizon) {
+  return scan(ScriptViews(script).script, ip, horizon);
+}
+
+std::vector<PrefetchTarget> AssetPrefetcher::scan(const PrefetchScript &script,
+                                                  u32 ip, u32 horizon) {
+  std::vector<PrefetchTarget> targets;
+  const auto code = script.instructions;
+  if (horizon == 0 || ip >= code.size()) {
+    return targets;
+  }
+
+  // Scene jumps still waiting for the linker point nowhere yet
+  std::unordered_set<u32> unresolved;
+  if (script.tables) {
+    for (const auto &ref : script.tables->externalSceneRefs) {
+      unresolved.insert(ref.instructionIndex);
+    }
+  }
+
+  struct Node {
+    u32 ip;
+    u32 distance;
+    u32 waits;
+  };
+  // Breadth-first, so each instruction is first reached by a shortest path
+  std::deque<Node> frontier{{ip, 0, 0}};
+  std::unordered_set<u32> visited{ip};
+  std::unordered_set<std::string> seen;
+
+  auto addTarget = [&](PrefetchAssetKind kind, std::string_view id,
+                       const Node &node) {
+    std::string name(id);
+    if (seen.insert(keyOf(kind, name)).second) {
+      targets.push_back({kind, std::move(name), node.distance, node.waits});
+    }
+  };
+
+  while (!frontier.empty()) {
+    const Node node = frontier.front();
+    frontier.pop_front();
+    const Instruction &instr = code[node.ip];
+
+    switch (instr.opcode) {
+    case OpCode::SHOW_BACKGROUND:
+      if (const auto *id = stringOperand(script, instr)) {
+        addTarget(PrefetchAssetKind::Background, *id, node);
+      }
+      break;
+    case OpCode::SHOW_CHARACTER:
+      if (const auto *id = stringOperand(script, instr);
+          id && script.tables) {
+        // Same sprite the runtime requests; undeclared characters show
+        // nothing
+        const auto &characters = script.tables->characters;
+        auto it = characters.find(std::string(*id));
+        if (it != characters.end()) {
+          const std::string sprite =
+              it->second.defaultSprite.value_or(std::string(*id));
+          if (!sprite.empty()) {
+            addTarget(PrefetchAssetKind::Character, sprite, node);
+          }
+        }
+      }
+      break;
+    case OpCode::PLAY_SOUND:
+      if (const auto *id = stringOperand(script, instr)) {
+        addTarget(PrefetchAssetKind::Sound, *id, node);
+      }
+      break;
+    case OpCode::PLAY_MUSIC:
+      if (const auto *id = stringOperand(script, instr)) {
+        addTarget(PrefetchAssetKind::Music, *id, node);
+      }
+      break;
+    default:
+      break;
+    }
+
+    if (node.distance + 1 >= horizon) {
+      continue;
+    }
+    const u32 waits = node.waits + (isWaitOpcode(instr.opcode) ? 1u : 0u);
+    auto follow = [&](u32 next) {
+      if (next < code.size() && visited.insert(next).second) {
+        frontier.push_back({next, node.distance + 1, waits});
+      }
+    };
+
+    switch (instr.opcode) {
+    case OpCode::HALT:
+    case OpCode::RETURN:
+      break;
+    case OpCode::JUMP:
+      follow(instr.operand);
+      break;
+    case OpCode::GOTO_SCENE:
+      if (unresolved.count(node.ip) == 0) {
+        follow(instr.operand);
+      }
+      break;
+    default:
+      // Conditional jumps, including a CHOICE's jump table, take both sides
+      follow(node.ip + 1);
+      if (isJumpOpcode(instr.opcode)) {
+        follow(instr.operand);
+      }
+      break;
+    }
+  }
+  return targets;
+}
+
+std::vector<std::string>
+AssetPrefetcher::firstUseOrder(const CompiledScript &script) {
+  const ScriptViews views(script);
+  const auto horizon = static_cast<u32>(script.instructions.size());
+  std::vector<u32> starts{0};
+  std::vector<u32> entries;
+  for (const auto &[scene, ip] : script.sceneEntryPoints) {
+    entries.push_back(ip);
+  }
+  std::sort(entries.begin(), entries.end());
+  starts.insert(starts.end(), entries.begin(), entries.end());
+
+  std::vector<std::string> order;
+  std::unordered_set<std::string> seen;
+  for (u32 ip : starts) {
+    for (auto &target : scan(views.script, ip, horizon)) {
+      if (seen.insert(target.id).second) {
+        order.push_back(std::move(target.id));
+      }
+    }
+  }
+  return order;
+}
+
+void AssetPrefetcher::setScript(const PrefetchScript &script) {
+  clear();
+  m_script = script;
+}
+
+void AssetPrefetcher::setResourceManager(resource::ResourceManager *resources) {
+  clear();
+  m_resources = resources;
+}
+
+void AssetPrefetcher::setConfig(const PrefetchConfig &config) {
+  m_config = config;
+  m_scanned = false;
+}
+
+std::string AssetPrefetcher::keyOf(PrefetchAssetKind kind,
+                                   const std::string &id) {
+  // Textures share one cache; audio is read as raw data
+  const bool texture = kind == PrefetchAssetKind::Background ||
+                       kind == PrefetchAssetKind::Character;
+  return (texture ? "t:" : "d:") + id;
+}
+
+void AssetPrefetcher::update(u32 ip) {
+  if (m_script.instructions.empty() || !m_resources) {
+    return;
+  }
+  if (m_scanned && ip == m_lastIp) {
+    return;
+  }
+  m_scanned = true;
+  m_lastIp = ip;
+  ++m_stats.scans;
+
+  auto targets = scan(m_script, ip, m_config.instructionHorizon);
+  if (targets.size() > m_config.maxTargets) {
+    targets.resize(m_config.maxTargets);
+  }
+
+  std::unordered_map<std::string, Tracked> window;
+  window.reserve(targets.size());
+  for (const auto &target : targets) {
+    const std::string key = keyOf(target.kind, target.id);
+    Tracked tracked;
+    auto it = m_tracked.find(key);
+    if (it != m_tracked.end()) {
+      tracked = std::move(it->second);
+      m_tracked.erase(it);
+    } else {
+      tracked.kind = target.kind;
+      tracked.id = target.id;
+    }
+    request(target, tracked);
+    window.emplace(key, std::move(tracked));
+  }
+
+  // Whatever is left was on a branch that is no longer reachable
+  for (auto &[key, tracked] : m_tracked) {
+    release(tracked);
+  }
+  m_tracked = std::move(window);
+}
+
+resource::LoadHandle<usize> AssetPrefetcher::preload(u32 ip) {
+  // A batch for a scene already left is not worth reading
+  m_preload.cancel();
+  m_preload = {};
+  if (m_script.instructions.empty() || !m_resources) {
+    return m_preload;
+  }
+
+  std::vector<std::string> ids;
+  for (auto &target : scan(m_script, ip, m_config.instructionHorizon)) {
+    if (target.waitsBefore == 0 && ids.size() < m_config.maxTargets) {
+      ids.push_back(std::move(target.id));
+    }
+  }
+  m_preload = m_resources->preload(ids);
+  return m_preload;
+}
+
+void AssetPrefetcher::request(const PrefetchTarget &target, Tracked &tracked) {
+  const auto priority = target.waitsBefore == 0
+                            ? resource::LoadPriority::NextLine
+                            : resource::LoadPriority::Prefetch;
+
+  // Failed and cancelled requests are retried while still in the window
+  const auto status = tracked.status();
+  if (tracked.state() && status == resource::LoadStatus::Ready) {
+    return;
+  }
+  if (tracked.state() && status == resource::LoadStatus::Pending) {
+    // Only raise its priority as it gets closer
+    const auto &state = tracked.state();
+    if (priority < state->priority.load()) {
+      m_resources->getLoader().setPriority(state, priority);
+    }
+    return;
+  }
+
+  if (tracked.kind == PrefetchAssetKind::Background ||
+      tracked.kind == PrefetchAssetKind::Character) {
+    tracked.texture = m_resources->requestTexture(target.id, priority);
+  } else {
+    tracked.data = m_resources->requestData(target.id, priority);
+  }
+  ++m_stats.requested;
+}
+
+void AssetPrefetcher::release(Tracked &tracked) {
+  if (!tracked.used) {
+    ++m_stats.dropped;
+  }
+  // A request the runtime promoted to Immediate is shared with it
+  const auto &state = tracked.state();
+  const bool pending =
+      state && tracked.status() == resource::LoadStatus::Pending;
+  if (pending &&
+      state->priority.load() == resource::LoadPriority::Immediate) {
+    return;
+  }
+  if (tracked.texture.isValid()) {
+    if (pending) {
+      tracked.texture.cancel();
+    }
+  } else if (tracked.data.isValid()) {
+    // Audio bytes are kept for readShared() only while in the window;
+    // anything already playing holds its own reference
+    m_resources->unloadData(tracked.id);
+  }
+}
+
+void AssetPrefetcher::recordUse(PrefetchAssetKind kind,
+                                const std::string &id) {
+  auto it = m_tracked.find(keyOf(kind, id));
+  if (it == m_tracked.end()) {
+    ++m_stats.misses;
+    return;
+  }
+
+  Tracked &tracked = it->second;
+  tracked.used = true;
+  switch (tracked.status()) {
+  case resource::LoadStatus::Ready:
+    ++m_stats.hits;
+    break;
+  case resource::LoadStatus::Pending:
+    ++m_stats.late;
+    break;
+  default:
+    ++m_stats.misses;
+    break;
+  }
+}
+
+void AssetPrefetcher::clear() {
+  m_preload.cancel();
+  m_preload = {};
+  for (auto &[key, tracked] : m_tracked) {
+    release(tracked);
+  }
+  m_tracked.clear();
+  m_scanned = false;
+}
+
+} // namespace NovelMind::scripting
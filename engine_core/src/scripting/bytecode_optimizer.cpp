@@ -0,0 +1,489 @@
+#include "NovelMind/scripting/bytecode_optimizer.hpp"
+#include "vm_detail.hpp"
+#include <cstring>
+#include <optional>
+
+namespace NovelMind::scripting {
+
+namespace {
+
+constexpr int kMaxRounds = 16;
+
+bool isConstantPush(const Instruction &instr) {
+  switch (instr.opcode) {
+  case OpCode::PUSH_INT:
+  case OpCode::PUSH_FLOAT:
+  case OpCode::PUSH_BOOL:
+  case OpCode::PUSH_NULL:
+    return true;
+  default:
+    return false;
+  }
+}
+
+TaggedValue constantOf(const Instruction &instr) {
+  switch (instr.opcode) {
+  case OpCode::PUSH_INT:
+    return static_cast<i32>(instr.operand);
+  case OpCode::PUSH_FLOAT: {
+    f32 val;
+    std::memcpy(&val, &instr.operand, sizeof(f32));
+    return val;
+  }
+  case OpCode::PUSH_BOOL:
+    return instr.operand != 0;
+  default:
+    return {};
+  }
+}
+
+std::optional<Instruction> pushFor(const TaggedValue &value) {
+  switch (value.type()) {
+  case ValueType::Int:
+    return Instruction(OpCode::PUSH_INT, static_cast<u32>(value.asInt()));
+  case ValueType::Float: {
+    f32 val = value.asFloat();
+    u32 bits = 0;
+    std::memcpy(&bits, &val, sizeof(f32));
+    return Instruction(OpCode::PUSH_FLOAT, bits);
+  }
+  case ValueType::Bool:
+    return Instruction(OpCode::PUSH_BOOL, value.asBool() ? 1u : 0u);
+  case ValueType::Null:
+    return Instruction(OpCode::PUSH_NULL);
+  case ValueType::String:
+    break;
+  }
+  return std::nullopt;
+}
+
+std::optional<TaggedValue> foldBinary(OpCode op, const TaggedValue &a,
+                                      const TaggedValue &b) {
+  using detail::evalBinary;
+  switch (op) {
+  case OpCode::ADD:
+    return evalBinary<OpCode::ADD>(a, b);
+  case OpCode::SUB:
+    return evalBinary<OpCode::SUB>(a, b);
+  case OpCode::MUL:
+    return evalBinary<OpCode::MUL>(a, b);
+  case OpCode::DIV:
+    // Leave division by zero to the VM so it is still reported at runtime
+    if (b.asFloat() == 0.0f) {
+      return std::nullopt;
+    }
+    return evalBinary<OpCode::DIV>(a, b);
+  case OpCode::MOD:
+    if (b.asInt() == 0) {
+      return std::nullopt;
+    }
+    return evalBinary<OpCode::MOD>(a, b);
+  case OpCode::EQ:
+    return evalBinary<OpCode::EQ>(a, b);
+  case OpCode::NE:
+    return evalBinary<OpCode::NE>(a, b);
+  case OpCode::LT:
+    return evalBinary<OpCode::LT>(a, b);
+  case OpCode::LE:
+    return evalBinary<OpCode::LE>(a, b);
+  case OpCode::GT:
+    return evalBinary<OpCode::GT>(a, b);
+  case OpCode::GE:
+    return evalBinary<OpCode::GE>(a, b);
+  case OpCode::AND:
+    return evalBinary<OpCode::AND>(a, b);
+  case OpCode::OR:
+    return evalBinary<OpCode::OR>(a, b);
+  default:
+    return std::nullopt;
+  }
+}
+
+std::optional<OpCode> fusedBranchFor(OpCode compare) {
+  switch (compare) {
+  case OpCode::EQ:
+    return OpCode::JUMP_IF_NOT_EQ;
+  case OpCode::NE:
+    return OpCode::JUMP_IF_NOT_NE;
+  case OpCode::LT:
+    return OpCode::JUMP_IF_NOT_LT;
+  case OpCode::LE:
+    return OpCode::JUMP_IF_NOT_LE;
+  case OpCode::GT:
+    return OpCode::JUMP_IF_NOT_GT;
+  case OpCode::GE:
+    return OpCode::JUMP_IF_NOT_GE;
+  default:
+    return std::nullopt;
+  }
+}
+
+bool hasInstructionOperand(OpCode op) {
+  return isJumpOpcode(op) || op == OpCode::GOTO_SCENE;
+}
+
+} // namespace
+
+BytecodeOptimizer::BytecodeOptimizer(OptimizationLevel level)
+    : m_level(level) {}
+
+OptimizationStats BytecodeOptimizer::optimize(CompiledScript &script) {
+  m_stats = OptimizationStats{};
+  m_stats.instructionsBefore = script.instructions.size();
+
+  if (m_level == OptimizationLevel::O0 || script.instructions.empty()) {
+    m_stats.instructionsAfter = script.instructions.size();
+    return m_stats;
+  }
+
+  m_code = std::move(script.instructions);
+
+  for (int round = 0; round < kMaxRounds; ++round) {
+    bool changed = false;
+
+    computeTargets(script);
+    changed |= foldConstants();
+
+    computeTargets(script);
+    changed |= simplifyBranches();
+
+    computeTargets(script);
+    changed |= threadJumps();
+
+    if (m_level >= OptimizationLevel::O2) {
+      computeTargets(script);
+      changed |= fuseCompareBranch();
+    }
+
+    changed |= removeUnreachable(script);
+
+    if (!changed) {
+      break;
+    }
+  }
+
+  compact(script);
+  script.instructions = std::move(m_code);
+  m_code.clear();
+  m_isTarget.clear();
+
+  m_stats.instructionsAfter = script.instructions.size();
+  return m_stats;
+}
+
+void BytecodeOptimizer::computeTargets(const CompiledScript &script) {
+  const usize size = m_code.size();
+  m_isTarget.assign(size + 1, 0);
+
+  for (const auto &instr : m_code) {
+    if (hasInstructionOperand(instr.opcode) && instr.operand <= size) {
+      m_isTarget[instr.operand] = 1;
+    }
+  }
+  for (const auto &[name, entry] : script.sceneEntryPoints) {
+    if (entry <= size) {
+      m_isTarget[entry] = 1;
+    }
+  }
+}
+
+usize BytecodeOptimizer::nextLive(usize index) const {
+  usize next = index + 1;
+  while (next < m_code.size() && m_code[next].opcode == OpCode::NOP) {
+    ++next;
+  }
+  return next;
+}
+
+bool BytecodeOptimizer::isBlocked(usize from, usize to) const {
+  // A branch landing anywhere after `from` up to `to` would skip part of a
+  // rewritten sequence, so the pair cannot be merged.
+  for (usize i = from + 1; i <= to; ++i) {
+    if (m_isTarget[i]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool BytecodeOptimizer::foldConstants() {
+  bool changed = false;
+  const usize size = m_code.size();
+
+  for (usize i = 0; i < size; ++i) {
+    if (!isConstantPush(m_code[i])) {
+      continue;
+    }
+
+    usize j = nextLive(i);
+    if (j >= size || isBlocked(i, j)) {
+      continue;
+    }
+
+    const TaggedValue a = constantOf(m_code[i]);
+    const OpCode next = m_code[j].opcode;
+
+    if (next == OpCode::NEG || next == OpCode::NOT) {
+      TaggedValue result =
+          next == OpCode::NEG ? detail::negate(a) : TaggedValue(!a.asBool());
+      if (auto push = pushFor(result)) {
+        m_code[i] = *push;
+        m_code[j] = Instruction(OpCode::NOP);
+        ++m_stats.constantsFolded;
+        changed = true;
+      }
+      continue;
+    }
+
+    if (!isConstantPush(m_code[j])) {
+      continue;
+    }
+
+    usize k = nextLive(j);
+    if (k >= size || isBlocked(j, k)) {
+      continue;
+    }
+
+    auto result = foldBinary(m_code[k].opcode, a, constantOf(m_code[j]));
+    if (!result) {
+      continue;
+    }
+    if (auto push = pushFor(*result)) {
+      m_code[i] = *push;
+      m_code[j] = Instruction(OpCode::NOP);
+      m_code[k] = Instruction(OpCode::NOP);
+      ++m_stats.constantsFolded;
+      changed = true;
+    }
+  }
+
+  return changed;
+}
+
+bool BytecodeOptimizer::simplifyBranches() {
+  bool changed = false;
+  const usize size = m_code.size();
+
+  for (usize i = 0; i < size; ++i) {
+    const OpCode op = m_code[i].opcode;
+    if (op != OpCode::NOT && !isConstantPush(m_code[i])) {
+      continue;
+    }
+
+    usize j = nextLive(i);
+    if (j >= size || isBlocked(i, j)) {
+      continue;
+    }
+    Instruction &branch = m_code[j];
+    if (branch.opcode != OpCode::JUMP_IF &&
+        branch.opcode != OpCode::JUMP_IF_NOT) {
+      continue;
+    }
+
+    if (op == OpCode::NOT) {
+      // NOT; JUMP_IF -> JUMP_IF_NOT (and vice versa)
+      branch.opcode = branch.opcode == OpCode::JUMP_IF ? OpCode::JUMP_IF_NOT
+                                                       : OpCode::JUMP_IF;
+    } else {
+      // Constant condition: unconditional jump or fall through
+      const bool condition = constantOf(m_code[i]).asBool();
+      const bool taken = condition == (branch.opcode == OpCode::JUMP_IF);
+      if (taken) {
+        branch.opcode = OpCode::JUMP;
+      } else {
+        branch = Instruction(OpCode::NOP);
+      }
+    }
+
+    m_code[i] = Instruction(OpCode::NOP);
+    ++m_stats.branchesSimplified;
+    changed = true;
+  }
+
+  return changed;
+}
+
+bool BytecodeOptimizer::threadJumps() {
+  bool changed = false;
+  const usize size = m_code.size();
+
+  auto firstLiveAt = [this, size](usize index) {
+    while (index < size && m_code[index].opcode == OpCode::NOP) {
+      ++index;
+    }
+    return index;
+  };
+
+  for (usize i = 0; i < size; ++i) {
+    Instruction &instr = m_code[i];
+    if (!isJumpOpcode(instr.opcode) || instr.operand > size) {
+      continue;
+    }
+
+    // Follow chains of unconditional jumps (bounded to survive cycles)
+    usize target = firstLiveAt(instr.operand);
+    for (usize hops = 0; hops < size; ++hops) {
+      if (target >= size || m_code[target].opcode != OpCode::JUMP ||
+          m_code[target].operand > size || m_code[target].operand == target) {
+        break;
+      }
+      target = firstLiveAt(m_code[target].operand);
+    }
+
+    if (target != instr.operand) {
+      instr.operand = static_cast<u32>(target);
+      ++m_stats.jumpsThreaded;
+      changed = true;
+    }
+
+    if (target == nextLive(i)) {
+      // Branch to the next instruction: only the condition pop remains
+      if (instr.opcode == OpCode::JUMP) {
+        instr = Instruction(OpCode::NOP);
+        ++m_stats.jumpsThreaded;
+        changed = true;
+      } else if (instr.opcode == OpCode::JUMP_IF ||
+                 instr.opcode == OpCode::JUMP_IF_NOT) {
+        instr = Instruction(OpCode::POP);
+        ++m_stats.jumpsThreaded;
+        changed = true;
+      }
+    } else if (instr.opcode == OpCode::JUMP && target < size &&
+               m_code[target].opcode == OpCode::HALT) {
+      instr = Instruction(OpCode::HALT);
+      ++m_stats.jumpsThreaded;
+      changed = true;
+    }
+  }
+
+  return changed;
+}
+
+bool BytecodeOptimizer::fuseCompareBranch() {
+  bool changed = false;
+  const usize size = m_code.size();
+
+  for (usize i = 0; i < size; ++i) {
+    auto fused = fusedBranchFor(m_code[i].opcode);
+    if (!fused) {
+      continue;
+    }
+
+    usize j = nextLive(i);
+    if (j >= size || isBlocked(i, j) ||
+        m_code[j].opcode != OpCode::JUMP_IF_NOT) {
+      continue;
+    }
+
+    m_code[i] = Instruction(*fused, m_code[j].operand);
+    m_code[j] = Instruction(OpCode::NOP);
+    ++m_stats.branchesFused;
+    changed = true;
+  }
+
+  return changed;
+}
+
+bool BytecodeOptimizer::removeUnreachable(const CompiledScript &script) {
+  const usize size = m_code.size();
+  std::vector<u8> reachable(size, 0);
+  std::vector<usize> worklist;
+
+  auto visit = [&](usize index) {
+    if (index < size && !reachable[index]) {
+      reachable[index] = 1;
+      worklist.push_back(index);
+    }
+  };
+
+  visit(0);
+  for (const auto &[name, entry] : script.sceneEntryPoints) {
+    visit(entry);
+  }
+
+  while (!worklist.empty()) {
+    usize i = worklist.back();
+    worklist.pop_back();
+    const Instruction &instr = m_code[i];
+
+    switch (instr.opcode) {
+    case OpCode::HALT:
+    case OpCode::RETURN:
+      break;
+    case OpCode::JUMP:
+    case OpCode::GOTO_SCENE:
+      // Compiled GOTO_SCENE operands are always scene entry points, and
+      // ScriptRuntime restarts the VM there, so nothing after one runs
+      visit(instr.operand);
+      break;
+    default:
+      if (isJumpOpcode(instr.opcode)) {
+        visit(instr.operand);
+      }
+      visit(i + 1);
+      break;
+    }
+  }
+
+  bool changed = false;
+  for (usize i = 0; i < size; ++i) {
+    if (!reachable[i] && m_code[i].opcode != OpCode::NOP) {
+      m_code[i] = Instruction(OpCode::NOP);
+      ++m_stats.deadInstructionsRemoved;
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+void BytecodeOptimizer::compact(CompiledScript &script) {
+  const usize size = m_code.size();
+
+  // newIndex[i] = position of the first kept instruction at or after i
+  std::vector<u32> newIndex(size + 1, 0);
+  u32 kept = 0;
+  for (usize i = 0; i < size; ++i) {
+    newIndex[i] = kept;
+    if (m_code[i].opcode != OpCode::NOP) {
+      ++kept;
+    }
+  }
+  newIndex[size] = kept;
+
+  auto remap = [&](u32 target) {
+    return target <= size ? newIndex[target] : kept;
+  };
+
+  // The line table is filtered alongside; a stale one is dropped
+  const bool hasLines = script.sourceLines.size() == size;
+  std::vector<u32> lines;
+
+  std::vector<Instruction> out;
+  out.reserve(kept);
+  for (usize i = 0; i < size; ++i) {
+    if (m_code[i].opcode == OpCode::NOP) {
+      continue;
+    }
+    Instruction copy = m_code[i];
+    if (hasInstructionOperand(copy.opcode)) {
+      copy.operand = remap(copy.operand);
+    }
+    out.push_back(copy);
+    if (hasLines) {
+      lines.push_back(script.sourceLines[i]);
+    }
+  }
+
+  for (auto &[name, entry] : script.sceneEntryPoints) {
+    entry = remap(entry);
+  }
+
+  if (out.empty()) {
+    out.emplace_back(OpCode::HALT);
+    lines.push_back(0);
+  }
+  m_code = std::move(out);
+  script.sourceLines = hasLines ? std::move(lines) : std::vector<u32>{};
+}
+
+} // namespace NovelMind::scripting
@@ -0,0 +1,367 @@
+#include "NovelMind/scripting/compiled_script_image.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+namespace NovelMind::scripting {
+
+namespace {
+
+static_assert(std::endian::native == std::endian::little,
+              "NMC2 images are little-endian and mapped without swapping");
+
+constexpr usize kSectionAlignment = 8;
+
+usize alignUp(usize value) {
+  return (value + kSectionAlignment - 1) & ~(kSectionAlignment - 1);
+}
+
+template <typename T> void writeAt(std::vector<u8> &out, usize offset,
+                                   const T &value) {
+  std::memcpy(out.data() + offset, &value, sizeof(T));
+}
+
+// Typed view of a validated section. Sections are 8-byte aligned relative to
+// the start of the image, and mappings/buffers are at least that aligned.
+template <typename T>
+std::span<const T> sectionView(const u8 *base, usize offset, usize count) {
+  return {reinterpret_cast<const T *>(base + offset), count};
+}
+
+bool rangeValid(u64 offset, u64 length, u64 size) {
+  return offset <= size && length <= size - offset;
+}
+
+} // namespace
+
+std::vector<u8> serializeNmc2(const CompiledScript &script,
+                              u32 engineVersion) {
+  // Blob strings: the string table first, then scene and character names
+  std::vector<std::string_view> blobStrings(script.stringTable.begin(),
+                                            script.stringTable.end());
+  auto addBlobString = [&blobStrings](std::string_view str) {
+    blobStrings.push_back(str);
+    return static_cast<u32>(blobStrings.size() - 1);
+  };
+
+  std::vector<std::pair<std::string_view, u32>> scenes(
+      script.sceneEntryPoints.begin(), script.sceneEntryPoints.end());
+  std::sort(scenes.begin(), scenes.end());
+
+  std::vector<Nmc2Scene> sceneTable;
+  sceneTable.reserve(scenes.size());
+  for (const auto &[name, entry] : scenes) {
+    sceneTable.push_back({addBlobString(name), entry});
+  }
+
+  std::vector<const CharacterDecl *> characters;
+  characters.reserve(script.characters.size());
+  for (const auto &[id, ch] : script.characters) {
+    characters.push_back(&ch);
+  }
+  std::sort(characters.begin(), characters.end(),
+            [](const CharacterDecl *a, const CharacterDecl *b) {
+              return a->id < b->id;
+            });
+
+  std::vector<Nmc2Character> characterTable;
+  characterTable.reserve(characters.size());
+  for (const auto *ch : characters) {
+    Nmc2Character entry{};
+    entry.idString = addBlobString(ch->id);
+    entry.displayNameString = addBlobString(ch->displayName);
+    entry.colorString = addBlobString(ch->color);
+    characterTable.push_back(entry);
+  }
+
+  std::vector<u32> stringOffsets;
+  stringOffsets.reserve(blobStrings.size() + 1);
+  usize blobSize = 0;
+  for (auto str : blobStrings) {
+    stringOffsets.push_back(static_cast<u32>(blobSize));
+    blobSize += str.size() + 1;
+  }
+  stringOffsets.push_back(static_cast<u32>(blobSize));
+
+  Nmc2Header header{};
+  std::memcpy(header.magic, kNmc2Magic, sizeof(header.magic));
+  header.formatVersion = kNmc2FormatVersion;
+  header.engineVersion = engineVersion;
+  header.headerSize = sizeof(Nmc2Header);
+
+  usize offset = alignUp(sizeof(Nmc2Header));
+  header.instructionCount = static_cast<u32>(script.instructions.size());
+  header.instructionOffset = static_cast<u32>(offset);
+  offset = alignUp(offset + script.instructions.size() * sizeof(Instruction));
+
+  header.stringCount = static_cast<u32>(script.stringTable.size());
+  header.blobStringCount = static_cast<u32>(blobStrings.size());
+  header.stringOffsetsOffset = static_cast<u32>(offset);
+  offset = alignUp(offset + stringOffsets.size() * sizeof(u32));
+
+  header.stringBlobOffset = static_cast<u32>(offset);
+  header.stringBlobSize = static_cast<u32>(blobSize);
+  offset = alignUp(offset + blobSize);
+
+  header.sceneCount = static_cast<u32>(sceneTable.size());
+  header.sceneTableOffset = static_cast<u32>(offset);
+  offset = alignUp(offset + sceneTable.size() * sizeof(Nmc2Scene));
+
+  header.characterCount = static_cast<u32>(characterTable.size());
+  header.characterTableOffset = static_cast<u32>(offset);
+  offset = alignUp(offset + characterTable.size() * sizeof(Nmc2Character));
+
+  const bool hasLines =
+      !script.sourceLines.empty() &&
+      script.sourceLines.size() == script.instructions.size();
+  if (hasLines) {
+    header.lineTableOffset = static_cast<u32>(offset);
+    offset = alignUp(offset + script.sourceLines.size() * sizeof(u32));
+  }
+
+  header.fileSize = offset;
+
+  std::vector<u8> out(offset, 0);
+  writeAt(out, 0, header);
+
+  // Written field by field so struct padding is always zero on disk
+  usize pos = header.instructionOffset;
+  for (const auto &instr : script.instructions) {
+    out[pos] = static_cast<u8>(instr.opcode);
+    writeAt(out, pos + offsetof(Instruction, operand), instr.operand);
+    pos += sizeof(Instruction);
+  }
+
+  if (!stringOffsets.empty()) {
+    std::memcpy(out.data() + header.stringOffsetsOffset, stringOffsets.data(),
+                stringOffsets.size() * sizeof(u32));
+  }
+
+  for (usize i = 0; i < blobStrings.size(); ++i) {
+    if (!blobStrings[i].empty()) {
+      std::memcpy(out.data() + header.stringBlobOffset + stringOffsets[i],
+                  blobStrings[i].data(), blobStrings[i].size());
+    }
+  }
+
+  if (!sceneTable.empty()) {
+    std::memcpy(out.data() + header.sceneTableOffset, sceneTable.data(),
+                sceneTable.size() * sizeof(Nmc2Scene));
+  }
+  if (!characterTable.empty()) {
+    std::memcpy(out.data() + header.characterTableOffset,
+                characterTable.data(),
+                characterTable.size() * sizeof(Nmc2Character));
+  }
+  if (hasLines) {
+    std::memcpy(out.data() + header.lineTableOffset, script.sourceLines.data(),
+                script.sourceLines.size() * sizeof(u32));
+  }
+
+  return out;
+}
+
+Result<void> writeNmc2(const CompiledScript &script, const std::string &path,
+                       u32 engineVersion) {
+  std::vector<u8> bytes = serializeNmc2(script, engineVersion);
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    return Result<void>::error("Cannot open file for writing: " + path);
+  }
+  file.write(reinterpret_cast<const char *>(bytes.data()),
+             static_cast<std::streamsize>(bytes.size()));
+  if (!file.good()) {
+    return Result<void>::error("Failed to write file: " + path);
+  }
+  return Result<void>::ok();
+}
+
+bool isNmc2(std::span<const u8> bytes) {
+  return bytes.size() >= sizeof(kNmc2Magic) &&
+         std::memcmp(bytes.data(), kNmc2Magic, sizeof(kNmc2Magic)) == 0;
+}
+
+Result<CompiledScriptImage> CompiledScriptImage::open(const std::string &path) {
+  auto file = platform::MappedFile::open(path);
+  if (file.isError()) {
+    return Result<CompiledScriptImage>::error(file.error());
+  }
+
+  CompiledScriptImage image;
+  image.m_file = std::move(file).value();
+  auto parsed = image.parse();
+  if (parsed.isError()) {
+    return Result<CompiledScriptImage>::error(path + ": " + parsed.error());
+  }
+  return Result<CompiledScriptImage>::ok(std::move(image));
+}
+
+Result<CompiledScriptImage>
+CompiledScriptImage::fromBuffer(std::vector<u8> bytes) {
+  CompiledScriptImage image;
+  image.m_file = platform::MappedFile::fromBuffer(std::move(bytes));
+  auto parsed = image.parse();
+  if (parsed.isError()) {
+    return Result<CompiledScriptImage>::error(parsed.error());
+  }
+  return Result<CompiledScriptImage>::ok(std::move(image));
+}
+
+Result<void> CompiledScriptImage::parse() {
+  const u8 *base = m_file.data();
+  const u64 size = m_file.size();
+
+  if (size < sizeof(Nmc2Header) || !isNmc2(m_file.bytes())) {
+    return Result<void>::error("Not an NMC2 compiled script");
+  }
+
+  Nmc2Header header;
+  std::memcpy(&header, base, sizeof(header));
+
+  if (header.formatVersion != kNmc2FormatVersion) {
+    return Result<void>::error("Unsupported NMC2 format version " +
+                               std::to_string(header.formatVersion));
+  }
+  if (header.headerSize != sizeof(Nmc2Header) || header.fileSize != size) {
+    return Result<void>::error("Corrupt NMC2 header");
+  }
+  if (reinterpret_cast<std::uintptr_t>(base) % kSectionAlignment != 0) {
+    return Result<void>::error("NMC2 image is not suitably aligned");
+  }
+
+  auto sectionOk = [size](u32 offset, u64 count, u64 elementSize) {
+    return offset % kSectionAlignment == 0 &&
+           rangeValid(offset, count * elementSize, size);
+  };
+
+  if (!sectionOk(header.instructionOffset, header.instructionCount,
+                 sizeof(Instruction)) ||
+      !sectionOk(header.stringOffsetsOffset,
+                 static_cast<u64>(header.blobStringCount) + 1, sizeof(u32)) ||
+      !sectionOk(header.stringBlobOffset, header.stringBlobSize, 1) ||
+      !sectionOk(header.sceneTableOffset, header.sceneCount,
+                 sizeof(Nmc2Scene)) ||
+      !sectionOk(header.characterTableOffset, header.characterCount,
+                 sizeof(Nmc2Character)) ||
+      (header.lineTableOffset != 0 &&
+       !sectionOk(header.lineTableOffset, header.instructionCount,
+                  sizeof(u32))) ||
+      header.stringCount > header.blobStringCount) {
+    return Result<void>::error("NMC2 section out of bounds");
+  }
+
+  // String offsets must be monotonic and every string NUL-terminated
+  auto offsets = sectionView<u32>(base, header.stringOffsetsOffset,
+                                  static_cast<usize>(header.blobStringCount) +
+                                      1);
+  const char *blob = reinterpret_cast<const char *>(base) +
+                     header.stringBlobOffset;
+  if (offsets.back() != header.stringBlobSize) {
+    return Result<void>::error("Corrupt NMC2 string table");
+  }
+
+  m_strings.clear();
+  m_strings.reserve(header.blobStringCount);
+  for (u32 i = 0; i < header.blobStringCount; ++i) {
+    const u32 begin = offsets[i];
+    const u32 end = offsets[i + 1];
+    if (begin >= end || end > header.stringBlobSize || blob[end - 1] != '\0') {
+      return Result<void>::error("Corrupt NMC2 string table");
+    }
+    m_strings.emplace_back(blob + begin, end - begin - 1);
+  }
+
+  m_scenes = sectionView<Nmc2Scene>(base, header.sceneTableOffset,
+                                    header.sceneCount);
+  for (usize i = 0; i < m_scenes.size(); ++i) {
+    const auto &scene = m_scenes[i];
+    if (scene.nameString >= header.blobStringCount ||
+        scene.entryPoint > header.instructionCount) {
+      return Result<void>::error("Corrupt NMC2 scene table");
+    }
+    if (i > 0 &&
+        m_strings[m_scenes[i - 1].nameString] >= m_strings[scene.nameString]) {
+      return Result<void>::error("NMC2 scene table is not sorted");
+    }
+  }
+
+  m_characters = sectionView<Nmc2Character>(base, header.characterTableOffset,
+                                            header.characterCount);
+  for (const auto &ch : m_characters) {
+    if (ch.idString >= header.blobStringCount ||
+        ch.displayNameString >= header.blobStringCount ||
+        ch.colorString >= header.blobStringCount) {
+      return Result<void>::error("Corrupt NMC2 character table");
+    }
+  }
+
+  m_instructions = sectionView<Instruction>(base, header.instructionOffset,
+                                            header.instructionCount);
+  if (header.lineTableOffset != 0) {
+    m_sourceLines = sectionView<u32>(base, header.lineTableOffset,
+                                     header.instructionCount);
+  } else {
+    m_sourceLines = {};
+  }
+  m_stringCount = header.stringCount;
+  m_engineVersion = header.engineVersion;
+  return Result<void>::ok();
+}
+
+std::string_view CompiledScriptImage::sceneName(usize index) const {
+  return m_strings[m_scenes[index].nameString];
+}
+
+u32 CompiledScriptImage::sceneEntryPoint(usize index) const {
+  return m_scenes[index].entryPoint;
+}
+
+std::optional<u32>
+CompiledScriptImage::findScene(std::string_view name) const {
+  auto it = std::lower_bound(m_scenes.begin(), m_scenes.end(), name,
+                             [this](const Nmc2Scene &scene,
+                                    std::string_view key) {
+                               return m_strings[scene.nameString] < key;
+                             });
+  if (it == m_scenes.end() || m_strings[it->nameString] != name) {
+    return std::nullopt;
+  }
+  return it->entryPoint;
+}
+
+CompiledScript CompiledScriptImage::metadata() const {
+  CompiledScript script;
+  script.sceneEntryPoints.reserve(m_scenes.size());
+  for (const auto &scene : m_scenes) {
+    script.sceneEntryPoints.emplace(std::string(m_strings[scene.nameString]),
+                                    scene.entryPoint);
+  }
+
+  for (const auto &entry : m_characters) {
+    CharacterDecl ch;
+    ch.id = m_strings[entry.idString];
+    ch.displayName = m_strings[entry.displayNameString];
+    ch.color = m_strings[entry.colorString];
+    script.characters.emplace(ch.id, std::move(ch));
+  }
+
+  return script;
+}
+
+CompiledScript CompiledScriptImage::toCompiledScript() const {
+  CompiledScript script = metadata();
+  script.instructions.assign(m_instructions.begin(), m_instructions.end());
+  script.sourceLines.assign(m_sourceLines.begin(), m_sourceLines.end());
+
+  script.stringTable.reserve(m_stringCount);
+  for (auto str : strings()) {
+    script.stringTable.emplace_back(str);
+  }
+
+  return script;
+}
+
+} // namespace NovelMind::scripting
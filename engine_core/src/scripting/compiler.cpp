@@ -22,6 +22,9 @@ Result<CompiledScript> Compiler::compile(const Program &program) {
     auto it = m_labels.find(pending.targetLabel);
     if (it != m_labels.end()) {
       m_output.instructions[pending.instructionIndex].operand = it->second;
+    } else if (m_allowExternalScenes) {
+      m_output.externalSceneRefs.push_back(
+          {pending.instructionIndex, pending.targetLabel});
     } else {
       error("Undefined label: " + pending.targetLabel);
     }
@@ -44,10 +47,12 @@ void Compiler::reset() {
   m_pendingJumps.clear();
   m_labels.clear();
   m_currentScene.clear();
+  m_currentLine = 0;
 }
 
 void Compiler::emitOp(OpCode op, u32 operand) {
   m_output.instructions.emplace_back(op, operand);
+  m_output.sourceLines.push_back(m_currentLine);
 }
 
 u32 Compiler::emitJump(OpCode op) {
@@ -123,6 +128,10 @@ void Compiler::compileScene(const SceneDecl &decl) {
 }
 
 void Compiler::compileStatement(const Statement &stmt) {
+  // Nested statements set their own line; restore ours for the tail of
+  // compound statements (else branches, jump patches).
+  const u32 outerLine = m_currentLine;
+  m_currentLine = stmt.location.line;
   std::visit(
       [this](const auto &s) {
         using T = std::decay_t<decltype(s)>;
@@ -160,6 +169,7 @@ void Compiler::compileStatement(const Statement &stmt) {
         }
       },
       stmt.data);
+  m_currentLine = outerLine;
 }
 
 void Compiler::compileExpression(const Expression &expr) {
@@ -218,7 +218,7 @@ Result<Program> IRToASTConverter::convert(const IRGraph &graph) {
         continue;
       }
 
-      auto stmt = convertNode(node, graph);
+      auto stmt = convertNode(node, graph, program.nodes());
       if (stmt) {
         scene.body.push_back(std::move(stmt));
       }
@@ -230,8 +230,9 @@ Result<Program> IRToASTConverter::convert(const IRGraph &graph) {
   return Result<Program>::ok(std::move(program));
 }
 
-std::unique_ptr<Statement>
-IRToASTConverter::convertNode(const IRNode *node, const IRGraph & /*graph*/) {
+StmtPtr IRToASTConverter::convertNode(const IRNode *node,
+                                      const IRGraph & /*graph*/,
+                                      AstArena &arena) {
   m_visited.insert(node->getId());
 
   switch (node->getType()) {
@@ -239,23 +240,20 @@ IRToASTConverter::convertNode(const IRNode *node, const IRGraph & /*graph*/) {
     ShowStmt show;
     show.target = ShowStmt::Target::Character;
     show.identifier = node->getStringProperty("character");
-    return std::make_unique<Statement>(std::move(show),
-                                       node->getSourceLocation());
+    return arena.makeStmt(std::move(show), node->getSourceLocation());
   }
 
   case IRNodeType::ShowBackground: {
     ShowStmt show;
     show.target = ShowStmt::Target::Background;
     show.identifier = node->getStringProperty("background");
-    return std::make_unique<Statement>(std::move(show),
-                                       node->getSourceLocation());
+    return arena.makeStmt(std::move(show), node->getSourceLocation());
   }
 
   case IRNodeType::HideCharacter: {
     HideStmt hide;
     hide.identifier = node->getStringProperty("character");
-    return std::make_unique<Statement>(std::move(hide),
-                                       node->getSourceLocation());
+    return arena.makeStmt(std::move(hide), node->getSourceLocation());
   }
 
   case IRNodeType::Dialogue: {
@@ -265,8 +263,7 @@ IRToASTConverter::convertNode(const IRNode *node, const IRGraph & /*graph*/) {
       say.speaker = character;
     }
     say.text = node->getStringProperty("text");
-    return std::make_unique<Statement>(std::move(say),
-                                       node->getSourceLocation());
+    return arena.makeStmt(std::move(say), node->getSourceLocation());
   }
 
   case IRNodeType::PlayMusic: {
@@ -274,30 +271,26 @@ IRToASTConverter::convertNode(const IRNode *node, const IRGraph & /*graph*/) {
     play.type = PlayStmt::MediaType::Music;
     play.resource = node->getStringProperty("track");
     play.loop = node->getBoolProperty("loop", false);
-    return std::make_unique<Statement>(std::move(play),
-                                       node->getSourceLocation());
+    return arena.makeStmt(std::move(play), node->getSourceLocation());
   }
 
   case IRNodeType::PlaySound: {
     PlayStmt play;
     play.type = PlayStmt::MediaType::Sound;
     play.resource = node->getStringProperty("track");
-    return std::make_unique<Statement>(std::move(play),
-                                       node->getSourceLocation());
+    return arena.makeStmt(std::move(play), node->getSourceLocation());
   }
 
   case IRNodeType::Wait: {
     WaitStmt wait;
     wait.duration = static_cast<f32>(node->getFloatProperty("duration", 1.0));
-    return std::make_unique<Statement>(std::move(wait),
-                                       node->getSourceLocation());
+    return arena.makeStmt(std::move(wait), node->getSourceLocation());
   }
 
   case IRNodeType::Goto: {
     GotoStmt gotoStmt;
     gotoStmt.target = node->getStringProperty("target");
-    return std::make_unique<Statement>(std::move(gotoStmt),
-                                       node->getSourceLocation());
+    return arena.makeStmt(std::move(gotoStmt), node->getSourceLocation());
   }
 
   default:
@@ -305,9 +298,9 @@ IRToASTConverter::convertNode(const IRNode *node, const IRGraph & /*graph*/) {
   }
 }
 
-std::unique_ptr<Expression>
-IRToASTConverter::convertToExpression(const IRNode * /*node*/,
-                                      const IRGraph & /*graph*/) {
+ExprPtr IRToASTConverter::convertToExpression(const IRNode * /*node*/,
+                                              const IRGraph & /*graph*/,
+                                              AstArena & /*arena*/) {
   // Stub implementation
   return nullptr;
 }
@@ -1,6 +1,7 @@
 #include "NovelMind/scripting/lexer.hpp"
 #include <algorithm>
 #include <cctype>
+#include <charconv>
 
 namespace NovelMind::scripting {
 
@@ -71,35 +72,53 @@ void Lexer::reset() {
 }
 
 Result<std::vector<Token>> Lexer::tokenize(std::string_view source) {
+  core::Arena arena(4 * 1024);
+  auto views = tokenizeViews(source, arena);
+  if (views.isError()) {
+    return Result<std::vector<Token>>::error(views.error());
+  }
+
+  std::vector<Token> tokens;
+  tokens.reserve(views.value().size());
+  for (const auto &view : views.value()) {
+    tokens.push_back(view.toToken());
+  }
+  return Result<std::vector<Token>>::ok(std::move(tokens));
+}
+
+Result<std::vector<TokenView>> Lexer::tokenizeViews(std::string_view source,
+                                                    core::Arena &arena) {
   reset();
   m_source = source;
+  m_arena = &arena;
 
-  std::vector<Token> tokens;
+  std::vector<TokenView> tokens;
   tokens.reserve(source.size() / 4); // Rough estimate
 
   while (!isAtEnd()) {
     m_start = m_current;
     m_startColumn = m_column;
 
-    Token token = scanToken();
+    TokenView token = scanToken();
 
     if (token.type == TokenType::Error) {
-      m_errors.emplace_back(token.lexeme, token.location);
+      m_errors.emplace_back(std::string(token.lexeme), token.location);
     } else if (token.type != TokenType::Newline) {
       // Skip newlines in token stream (optional: keep for statement separation)
-      tokens.push_back(std::move(token));
+      tokens.push_back(token);
     }
   }
 
   // Add end-of-file token
-  tokens.emplace_back(TokenType::EndOfFile, "",
+  tokens.emplace_back(TokenType::EndOfFile, std::string_view(),
                       SourceLocation(m_line, m_column));
+  m_arena = nullptr;
 
   if (!m_errors.empty()) {
-    return Result<std::vector<Token>>::error(m_errors[0].message);
+    return Result<std::vector<TokenView>>::error(m_errors[0].message);
   }
 
-  return Result<std::vector<Token>>::ok(std::move(tokens));
+  return Result<std::vector<TokenView>>::ok(std::move(tokens));
 }
 
 const std::vector<LexerError> &Lexer::getErrors() const { return m_errors; }
@@ -178,7 +197,7 @@ void Lexer::skipBlockComment() {
   }
 }
 
-Token Lexer::scanToken() {
+TokenView Lexer::scanToken() {
   skipWhitespace();
 
   m_start = m_current;
@@ -294,22 +313,24 @@ Token Lexer::scanToken() {
   return errorToken("Unexpected character");
 }
 
-Token Lexer::makeToken(TokenType type) {
-  std::string lexeme(m_source.substr(m_start, m_current - m_start));
-  return Token(type, std::move(lexeme), SourceLocation(m_line, m_startColumn));
+TokenView Lexer::makeToken(TokenType type) {
+  return TokenView(type, m_source.substr(m_start, m_current - m_start),
+                   SourceLocation(m_line, m_startColumn));
 }
 
-Token Lexer::makeToken(TokenType type, const std::string &lexeme) {
-  return Token(type, lexeme, SourceLocation(m_line, m_startColumn));
+TokenView Lexer::makeToken(TokenType type, std::string_view lexeme) {
+  return TokenView(type, lexeme, SourceLocation(m_line, m_startColumn));
 }
 
-Token Lexer::errorToken(const std::string &message) {
-  return Token(TokenType::Error, message,
-               SourceLocation(m_line, m_startColumn));
+// Messages are string literals, so the view stays valid
+TokenView Lexer::errorToken(std::string_view message) {
+  return TokenView(TokenType::Error, message,
+                   SourceLocation(m_line, m_startColumn));
 }
 
-Token Lexer::scanString() {
-  std::string value;
+TokenView Lexer::scanString() {
+  const size_t contentStart = m_current;
+  bool hasEscapes = false;
 
   while (!isAtEnd() && peek() != '"') {
     if (peek() == '\n') {
@@ -317,33 +338,24 @@ Token Lexer::scanString() {
     }
 
     if (peek() == '\\') {
+      hasEscapes = true;
       advance(); // Skip backslash
       if (isAtEnd()) {
         return errorToken("Unterminated string (escape at end)");
       }
 
-      char escaped = advance();
-      switch (escaped) {
+      switch (advance()) {
       case 'n':
-        value += '\n';
-        break;
       case 'r':
-        value += '\r';
-        break;
       case 't':
-        value += '\t';
-        break;
       case '\\':
-        value += '\\';
-        break;
       case '"':
-        value += '"';
         break;
       default:
         return errorToken("Invalid escape sequence");
       }
     } else {
-      value += advance();
+      advance();
     }
   }
 
@@ -351,14 +363,42 @@ Token Lexer::scanString() {
     return errorToken("Unterminated string");
   }
 
+  std::string_view raw =
+      m_source.substr(contentStart, m_current - contentStart);
   advance(); // Closing quote
 
-  Token token(TokenType::String, std::move(value),
-              SourceLocation(m_line, m_startColumn));
-  return token;
+  if (!hasEscapes) {
+    return makeToken(TokenType::String, raw);
+  }
+
+  // Decoded text is never longer than the raw text
+  char *out = m_arena->allocateChars(raw.size());
+  size_t length = 0;
+  for (size_t i = 0; i < raw.size(); ++i) {
+    char c = raw[i];
+    if (c == '\\') {
+      switch (raw[++i]) {
+      case 'n':
+        c = '\n';
+        break;
+      case 'r':
+        c = '\r';
+        break;
+      case 't':
+        c = '\t';
+        break;
+      default: // '\\' or '"'
+        c = raw[i];
+        break;
+      }
+    }
+    out[length++] = c;
+  }
+
+  return makeToken(TokenType::String, std::string_view(out, length));
 }
 
-Token Lexer::scanNumber() {
+TokenView Lexer::scanNumber() {
   // Scan integer part
   while (!isAtEnd() && safeIsDigit(peek())) {
     advance();
@@ -375,37 +415,41 @@ Token Lexer::scanNumber() {
     }
   }
 
-  std::string lexeme(m_source.substr(m_start, m_current - m_start));
-  Token token(isFloat ? TokenType::Float : TokenType::Integer, lexeme,
-              SourceLocation(m_line, m_startColumn));
+  TokenView token =
+      makeToken(isFloat ? TokenType::Float : TokenType::Integer);
+  const char *first = token.lexeme.data();
+  const char *last = first + token.lexeme.size();
 
+  std::from_chars_result parsed{};
   if (isFloat) {
-    token.floatValue = std::stof(lexeme);
+    parsed = std::from_chars(first, last, token.floatValue);
   } else {
-    token.intValue = std::stoi(lexeme);
+    parsed = std::from_chars(first, last, token.intValue);
+  }
+  if (parsed.ec != std::errc()) {
+    return errorToken("Numeric literal out of range");
   }
 
   return token;
 }
 
-Token Lexer::scanIdentifier() {
+TokenView Lexer::scanIdentifier() {
   while (!isAtEnd() && (safeIsAlnum(peek()) || peek() == '_')) {
     advance();
   }
 
-  std::string lexeme(m_source.substr(m_start, m_current - m_start));
-  TokenType type = identifierType(lexeme);
-
-  return Token(type, std::move(lexeme), SourceLocation(m_line, m_startColumn));
+  TokenView token = makeToken(TokenType::Identifier);
+  token.type = identifierType(token.lexeme);
+  return token;
 }
 
-Token Lexer::scanColorLiteral() {
+TokenView Lexer::scanColorLiteral() {
   // Already consumed '#', now read hex digits
   while (!isAtEnd() && safeIsXdigit(peek())) {
     advance();
   }
 
-  std::string lexeme(m_source.substr(m_start, m_current - m_start));
+  std::string_view lexeme = m_source.substr(m_start, m_current - m_start);
 
   // Validate color format: #RGB, #RGBA, #RRGGBB, #RRGGBBAA
   size_t hexLen = lexeme.size() - 1; // Exclude '#'
@@ -413,11 +457,10 @@ Token Lexer::scanColorLiteral() {
     return errorToken("Invalid color literal format");
   }
 
-  return Token(TokenType::String, std::move(lexeme),
-               SourceLocation(m_line, m_startColumn));
+  return makeToken(TokenType::String, lexeme);
 }
 
-TokenType Lexer::identifierType(const std::string &lexeme) const {
+TokenType Lexer::identifierType(std::string_view lexeme) const {
   auto it = m_keywords.find(lexeme);
   if (it != m_keywords.end()) {
     return it->second;
@@ -2,15 +2,25 @@
 
 namespace NovelMind::scripting {
 
-Parser::Parser() : m_tokens(nullptr), m_current(0) {}
+Parser::Parser() : m_tokens(nullptr), m_current(0), m_arena(nullptr) {}
 
 Parser::~Parser() = default;
 
 Result<Program> Parser::parse(const std::vector<Token> &tokens) {
+  std::vector<TokenView> views;
+  views.reserve(tokens.size());
+  for (const auto &token : tokens) {
+    views.emplace_back(token);
+  }
+  return parse(views);
+}
+
+Result<Program> Parser::parse(const std::vector<TokenView> &tokens) {
   m_tokens = &tokens;
   m_current = 0;
   m_errors.clear();
   m_program = Program{};
+  m_arena = &m_program.nodes();
 
   while (!isAtEnd()) {
     try {
@@ -33,11 +43,11 @@ const std::vector<ParseError> &Parser::getErrors() const { return m_errors; }
 
 bool Parser::isAtEnd() const { return peek().type == TokenType::EndOfFile; }
 
-const Token &Parser::peek() const { return (*m_tokens)[m_current]; }
+const TokenView &Parser::peek() const { return (*m_tokens)[m_current]; }
 
-const Token &Parser::previous() const { return (*m_tokens)[m_current - 1]; }
+const TokenView &Parser::previous() const { return (*m_tokens)[m_current - 1]; }
 
-const Token &Parser::advance() {
+const TokenView &Parser::advance() {
   if (!isAtEnd()) {
     ++m_current;
   }
@@ -68,7 +78,7 @@ bool Parser::match(std::initializer_list<TokenType> types) {
   return false;
 }
 
-const Token &Parser::consume(TokenType type, const std::string &message) {
+const TokenView &Parser::consume(TokenType type, const std::string &message) {
   if (check(type)) {
     return advance();
   }
@@ -137,31 +147,31 @@ CharacterDecl Parser::parseCharacterDecl() {
   // character Hero(name="Alex", color="#FFCC00")
   CharacterDecl decl;
 
-  const Token &id =
+  const TokenView &id =
       consume(TokenType::Identifier, "Expected character identifier");
   decl.id = id.lexeme;
 
   if (match(TokenType::LeftParen)) {
     // Parse properties
     do {
-      const Token &propName =
+      const TokenView &propName =
           consume(TokenType::Identifier, "Expected property name");
       consume(TokenType::Assign, "Expected '=' after property name");
 
       if (propName.lexeme == "name") {
-        const Token &value =
+        const TokenView &value =
             consume(TokenType::String, "Expected string for name");
         decl.displayName = value.lexeme;
       } else if (propName.lexeme == "color") {
-        const Token &value =
+        const TokenView &value =
             consume(TokenType::String, "Expected color string");
         decl.color = value.lexeme;
       } else if (propName.lexeme == "sprite") {
-        const Token &value =
+        const TokenView &value =
             consume(TokenType::String, "Expected sprite string");
         decl.defaultSprite = value.lexeme;
       } else {
-        error("Unknown character property: " + propName.lexeme);
+        error("Unknown character property: " + std::string(propName.lexeme));
         // Skip the value
         advance();
       }
@@ -177,7 +187,7 @@ SceneDecl Parser::parseSceneDecl() {
   // scene intro { ... }
   SceneDecl decl;
 
-  const Token &name = consume(TokenType::Identifier, "Expected scene name");
+  const TokenView &name = consume(TokenType::Identifier, "Expected scene name");
   decl.name = name.lexeme;
 
   consume(TokenType::LeftBrace, "Expected '{' before scene body");
@@ -232,16 +242,16 @@ StmtPtr Parser::parseStatement() {
 
   // Check for shorthand say: Identifier "string"
   if (check(TokenType::Identifier)) {
-    const Token &id = peek();
+    const TokenView &id = peek();
     if (m_current + 1 < m_tokens->size() &&
         (*m_tokens)[m_current + 1].type == TokenType::String) {
       advance(); // consume identifier
       SayStmt say;
       say.speaker = id.lexeme;
-      const Token &text =
+      const TokenView &text =
           consume(TokenType::String, "Expected string after speaker");
       say.text = text.lexeme;
-      return makeStmt(std::move(say), id.location);
+      return m_arena->makeStmt(std::move(say), id.location);
     }
   }
 
@@ -250,7 +260,7 @@ StmtPtr Parser::parseStatement() {
   if (expr) {
     ExpressionStmt exprStmt;
     exprStmt.expression = std::move(expr);
-    return makeStmt(std::move(exprStmt), previous().location);
+    return m_arena->makeStmt(std::move(exprStmt), previous().location);
   }
 
   return nullptr;
@@ -265,18 +275,18 @@ StmtPtr Parser::parseShowStmt() {
 
   if (match(TokenType::Background)) {
     stmt.target = ShowStmt::Target::Background;
-    const Token &resource =
+    const TokenView &resource =
         consume(TokenType::String, "Expected background resource");
     stmt.resource = resource.lexeme;
   } else {
-    const Token &id =
+    const TokenView &id =
         consume(TokenType::Identifier, "Expected character/sprite identifier");
     stmt.identifier = id.lexeme;
     stmt.target = ShowStmt::Target::Character;
 
     // Optional sprite override
     if (check(TokenType::String)) {
-      const Token &sprite = advance();
+      const TokenView &sprite = advance();
       stmt.resource = sprite.lexeme;
     }
 
@@ -285,10 +295,10 @@ StmtPtr Parser::parseShowStmt() {
       stmt.position = parsePosition();
 
       if (stmt.position == Position::Custom) {
-        const Token &x = consume(TokenType::Float, "Expected X coordinate");
+        const TokenView &x = consume(TokenType::Float, "Expected X coordinate");
         stmt.customX = x.floatValue;
         consume(TokenType::Comma, "Expected ',' between coordinates");
-        const Token &y = consume(TokenType::Float, "Expected Y coordinate");
+        const TokenView &y = consume(TokenType::Float, "Expected Y coordinate");
         stmt.customY = y.floatValue;
       }
     }
@@ -296,19 +306,19 @@ StmtPtr Parser::parseShowStmt() {
 
   // Optional transition
   if (match(TokenType::Transition)) {
-    const Token &trans =
+    const TokenView &trans =
         consume(TokenType::Identifier, "Expected transition type");
     stmt.transition = trans.lexeme;
 
     if (check(TokenType::Float) || check(TokenType::Integer)) {
-      const Token &dur = advance();
+      const TokenView &dur = advance();
       stmt.duration = dur.type == TokenType::Float
                           ? dur.floatValue
                           : static_cast<f32>(dur.intValue);
     }
   }
 
-  return makeStmt(std::move(stmt), loc);
+  return m_arena->makeStmt(std::move(stmt), loc);
 }
 
 StmtPtr Parser::parseHideStmt() {
@@ -316,25 +326,25 @@ StmtPtr Parser::parseHideStmt() {
   SourceLocation loc = previous().location;
   HideStmt stmt;
 
-  const Token &id =
+  const TokenView &id =
       consume(TokenType::Identifier, "Expected identifier to hide");
   stmt.identifier = id.lexeme;
 
   // Optional transition
   if (match(TokenType::Transition)) {
-    const Token &trans =
+    const TokenView &trans =
         consume(TokenType::Identifier, "Expected transition type");
     stmt.transition = trans.lexeme;
 
     if (check(TokenType::Float) || check(TokenType::Integer)) {
-      const Token &dur = advance();
+      const TokenView &dur = advance();
       stmt.duration = dur.type == TokenType::Float
                           ? dur.floatValue
                           : static_cast<f32>(dur.intValue);
     }
   }
 
-  return makeStmt(std::move(stmt), loc);
+  return m_arena->makeStmt(std::move(stmt), loc);
 }
 
 StmtPtr Parser::parseSayStmt() {
@@ -344,14 +354,14 @@ StmtPtr Parser::parseSayStmt() {
   SayStmt stmt;
 
   if (check(TokenType::Identifier)) {
-    const Token &speaker = advance();
+    const TokenView &speaker = advance();
     stmt.speaker = speaker.lexeme;
   }
 
-  const Token &text = consume(TokenType::String, "Expected dialogue text");
+  const TokenView &text = consume(TokenType::String, "Expected dialogue text");
   stmt.text = text.lexeme;
 
-  return makeStmt(std::move(stmt), loc);
+  return m_arena->makeStmt(std::move(stmt), loc);
 }
 
 StmtPtr Parser::parseChoiceStmt() {
@@ -367,7 +377,7 @@ StmtPtr Parser::parseChoiceStmt() {
   while (!check(TokenType::RightBrace) && !isAtEnd()) {
     ChoiceOption option;
 
-    const Token &text = consume(TokenType::String, "Expected choice text");
+    const TokenView &text = consume(TokenType::String, "Expected choice text");
     option.text = text.lexeme;
 
     // Optional condition
@@ -379,7 +389,7 @@ StmtPtr Parser::parseChoiceStmt() {
 
     // Either goto or block
     if (match(TokenType::Goto)) {
-      const Token &target =
+      const TokenView &target =
           consume(TokenType::Identifier, "Expected goto target");
       option.gotoTarget = target.lexeme;
     } else if (check(TokenType::LeftBrace)) {
@@ -399,7 +409,7 @@ StmtPtr Parser::parseChoiceStmt() {
 
   consume(TokenType::RightBrace, "Expected '}' after choice block");
 
-  return makeStmt(std::move(stmt), loc);
+  return m_arena->makeStmt(std::move(stmt), loc);
 }
 
 StmtPtr Parser::parseIfStmt() {
@@ -427,7 +437,7 @@ StmtPtr Parser::parseIfStmt() {
     }
   }
 
-  return makeStmt(std::move(stmt), loc);
+  return m_arena->makeStmt(std::move(stmt), loc);
 }
 
 StmtPtr Parser::parseGotoStmt() {
@@ -435,10 +445,11 @@ StmtPtr Parser::parseGotoStmt() {
   SourceLocation loc = previous().location;
   GotoStmt stmt;
 
-  const Token &target = consume(TokenType::Identifier, "Expected goto target");
+  const TokenView &target =
+      consume(TokenType::Identifier, "Expected goto target");
   stmt.target = target.lexeme;
 
-  return makeStmt(std::move(stmt), loc);
+  return m_arena->makeStmt(std::move(stmt), loc);
 }
 
 StmtPtr Parser::parseWaitStmt() {
@@ -446,7 +457,7 @@ StmtPtr Parser::parseWaitStmt() {
   SourceLocation loc = previous().location;
   WaitStmt stmt;
 
-  const Token &duration = advance();
+  const TokenView &duration = advance();
   if (duration.type == TokenType::Float) {
     stmt.duration = duration.floatValue;
   } else if (duration.type == TokenType::Integer) {
@@ -456,7 +467,7 @@ StmtPtr Parser::parseWaitStmt() {
     stmt.duration = 0.0f;
   }
 
-  return makeStmt(std::move(stmt), loc);
+  return m_arena->makeStmt(std::move(stmt), loc);
 }
 
 StmtPtr Parser::parsePlayStmt() {
@@ -474,12 +485,13 @@ StmtPtr Parser::parsePlayStmt() {
     return nullptr;
   }
 
-  const Token &resource = consume(TokenType::String, "Expected resource path");
+  const TokenView &resource =
+      consume(TokenType::String, "Expected resource path");
   stmt.resource = resource.lexeme;
 
   // Optional volume
   if (check(TokenType::Float) || check(TokenType::Integer)) {
-    const Token &vol = advance();
+    const TokenView &vol = advance();
     stmt.volume = vol.type == TokenType::Float ? vol.floatValue
                                                : static_cast<f32>(vol.intValue);
   }
@@ -490,7 +502,7 @@ StmtPtr Parser::parsePlayStmt() {
     stmt.loop = true;
   }
 
-  return makeStmt(std::move(stmt), loc);
+  return m_arena->makeStmt(std::move(stmt), loc);
 }
 
 StmtPtr Parser::parseStopStmt() {
@@ -510,7 +522,7 @@ StmtPtr Parser::parseStopStmt() {
 
   // Optional fade
   if (match(TokenType::Fade)) {
-    const Token &dur = advance();
+    const TokenView &dur = advance();
     if (dur.type == TokenType::Float) {
       stmt.fadeOut = dur.floatValue;
     } else if (dur.type == TokenType::Integer) {
@@ -518,7 +530,7 @@ StmtPtr Parser::parseStopStmt() {
     }
   }
 
-  return makeStmt(std::move(stmt), loc);
+  return m_arena->makeStmt(std::move(stmt), loc);
 }
 
 StmtPtr Parser::parseSetStmt() {
@@ -533,14 +545,15 @@ StmtPtr Parser::parseSetStmt() {
     stmt.isFlag = true;
   }
 
-  const Token &var = consume(TokenType::Identifier, "Expected variable name");
+  const TokenView &var =
+      consume(TokenType::Identifier, "Expected variable name");
   stmt.variable = var.lexeme;
 
   consume(TokenType::Assign, "Expected '=' after variable name");
 
   stmt.value = parseExpression();
 
-  return makeStmt(std::move(stmt), loc);
+  return m_arena->makeStmt(std::move(stmt), loc);
 }
 
 StmtPtr Parser::parseTransitionStmt() {
@@ -551,7 +564,7 @@ StmtPtr Parser::parseTransitionStmt() {
 
   // Transition type can be a keyword (fade) or identifier (dissolve, slide,
   // etc.)
-  const Token &type = advance();
+  const TokenView &type = advance();
   if (type.type == TokenType::Fade) {
     stmt.type = "fade";
   } else if (type.type == TokenType::Identifier) {
@@ -561,7 +574,7 @@ StmtPtr Parser::parseTransitionStmt() {
     stmt.type = "fade";
   }
 
-  const Token &dur = advance();
+  const TokenView &dur = advance();
   if (dur.type == TokenType::Float) {
     stmt.duration = dur.floatValue;
   } else if (dur.type == TokenType::Integer) {
@@ -573,11 +586,11 @@ StmtPtr Parser::parseTransitionStmt() {
 
   // Optional color
   if (check(TokenType::String)) {
-    const Token &color = advance();
+    const TokenView &color = advance();
     stmt.color = color.lexeme;
   }
 
-  return makeStmt(std::move(stmt), loc);
+  return m_arena->makeStmt(std::move(stmt), loc);
 }
 
 StmtPtr Parser::parseBlock() {
@@ -588,7 +601,7 @@ StmtPtr Parser::parseBlock() {
 
   consume(TokenType::RightBrace, "Expected '}' after block");
 
-  return makeStmt(std::move(block), loc);
+  return m_arena->makeStmt(std::move(block), loc);
 }
 
 // Grammar rules - expressions (precedence climbing)
@@ -608,7 +621,7 @@ ExprPtr Parser::parseOr() {
     binary.op = op;
     binary.right = std::move(right);
 
-    expr = makeExpr(std::move(binary), loc);
+    expr = m_arena->makeExpr(std::move(binary), loc);
   }
 
   return expr;
@@ -627,7 +640,7 @@ ExprPtr Parser::parseAnd() {
     binary.op = op;
     binary.right = std::move(right);
 
-    expr = makeExpr(std::move(binary), loc);
+    expr = m_arena->makeExpr(std::move(binary), loc);
   }
 
   return expr;
@@ -646,7 +659,7 @@ ExprPtr Parser::parseEquality() {
     binary.op = op;
     binary.right = std::move(right);
 
-    expr = makeExpr(std::move(binary), loc);
+    expr = m_arena->makeExpr(std::move(binary), loc);
   }
 
   return expr;
@@ -666,7 +679,7 @@ ExprPtr Parser::parseComparison() {
     binary.op = op;
     binary.right = std::move(right);
 
-    expr = makeExpr(std::move(binary), loc);
+    expr = m_arena->makeExpr(std::move(binary), loc);
   }
 
   return expr;
@@ -685,7 +698,7 @@ ExprPtr Parser::parseTerm() {
     binary.op = op;
     binary.right = std::move(right);
 
-    expr = makeExpr(std::move(binary), loc);
+    expr = m_arena->makeExpr(std::move(binary), loc);
   }
 
   return expr;
@@ -704,7 +717,7 @@ ExprPtr Parser::parseFactor() {
     binary.op = op;
     binary.right = std::move(right);
 
-    expr = makeExpr(std::move(binary), loc);
+    expr = m_arena->makeExpr(std::move(binary), loc);
   }
 
   return expr;
@@ -720,7 +733,7 @@ ExprPtr Parser::parseUnary() {
     unary.op = op;
     unary.operand = std::move(operand);
 
-    return makeExpr(std::move(unary), loc);
+    return m_arena->makeExpr(std::move(unary), loc);
   }
 
   return parseCall();
@@ -753,18 +766,18 @@ ExprPtr Parser::parseCall() {
       call.callee = std::move(callee);
       call.arguments = std::move(args);
 
-      expr = makeExpr(std::move(call), loc);
+      expr = m_arena->makeExpr(std::move(call), loc);
     } else if (match(TokenType::Dot)) {
       // Property access
       SourceLocation loc = previous().location;
-      const Token &name =
+      const TokenView &name =
           consume(TokenType::Identifier, "Expected property name after '.'");
 
       PropertyExpr prop;
       prop.object = std::move(expr);
       prop.property = name.lexeme;
 
-      expr = makeExpr(std::move(prop), loc);
+      expr = m_arena->makeExpr(std::move(prop), loc);
     } else {
       break;
     }
@@ -779,37 +792,37 @@ ExprPtr Parser::parsePrimary() {
   if (match(TokenType::True)) {
     LiteralExpr lit;
     lit.value = true;
-    return makeExpr(std::move(lit), loc);
+    return m_arena->makeExpr(std::move(lit), loc);
   }
 
   if (match(TokenType::False)) {
     LiteralExpr lit;
     lit.value = false;
-    return makeExpr(std::move(lit), loc);
+    return m_arena->makeExpr(std::move(lit), loc);
   }
 
   if (match(TokenType::Integer)) {
     LiteralExpr lit;
     lit.value = previous().intValue;
-    return makeExpr(std::move(lit), loc);
+    return m_arena->makeExpr(std::move(lit), loc);
   }
 
   if (match(TokenType::Float)) {
     LiteralExpr lit;
     lit.value = previous().floatValue;
-    return makeExpr(std::move(lit), loc);
+    return m_arena->makeExpr(std::move(lit), loc);
   }
 
   if (match(TokenType::String)) {
     LiteralExpr lit;
-    lit.value = previous().lexeme;
-    return makeExpr(std::move(lit), loc);
+    lit.value = std::string(previous().lexeme);
+    return m_arena->makeExpr(std::move(lit), loc);
   }
 
   if (match(TokenType::Identifier)) {
     IdentifierExpr id;
     id.name = previous().lexeme;
-    return makeExpr(std::move(id), loc);
+    return m_arena->makeExpr(std::move(id), loc);
   }
 
   if (match(TokenType::LeftParen)) {
@@ -829,7 +842,7 @@ ExprPtr Parser::parsePrimary() {
 
 Position Parser::parsePosition() {
   if (check(TokenType::Identifier)) {
-    const std::string &pos = peek().lexeme;
+    std::string_view pos = peek().lexeme;
 
     if (pos == "left") {
       advance();
@@ -854,8 +867,8 @@ Position Parser::parsePosition() {
 }
 
 std::string Parser::parseString() {
-  const Token &str = consume(TokenType::String, "Expected string");
-  return str.lexeme;
+  const TokenView &str = consume(TokenType::String, "Expected string");
+  return std::string(str.lexeme);
 }
 
 std::vector<StmtPtr> Parser::parseStatementList() {
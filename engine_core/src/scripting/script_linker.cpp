@@ -0,0 +1,118 @@
+#include "NovelMind/scripting/script_linker.hpp"
+#include <unordered_map>
+
+namespace NovelMind::scripting {
+
+Result<CompiledScript>
+ScriptLinker::link(const std::vector<const CompiledScript *> &units,
+                   const std::vector<std::string> &unitNames) {
+  m_errors.clear();
+
+  auto unitName = [&unitNames](usize index) {
+    return index < unitNames.size() ? unitNames[index]
+                                    : "unit " + std::to_string(index);
+  };
+
+  CompiledScript out;
+  std::unordered_map<std::string, u32> stringIndex;
+  std::unordered_map<std::string, usize> sceneOwner;
+  std::unordered_map<std::string, usize> characterOwner;
+
+  usize totalInstructions = 0;
+  for (const auto *unit : units) {
+    totalInstructions += unit->instructions.size();
+  }
+  out.instructions.reserve(totalInstructions);
+
+  // Unresolved references, rebased into the linked instruction array
+  std::vector<std::pair<CompiledScript::SceneReference, usize>> pending;
+
+  for (usize u = 0; u < units.size(); ++u) {
+    const CompiledScript &unit = *units[u];
+    const u32 base = static_cast<u32>(out.instructions.size());
+
+    std::vector<u32> stringRemap(unit.stringTable.size());
+    for (usize i = 0; i < unit.stringTable.size(); ++i) {
+      auto [it, inserted] = stringIndex.try_emplace(
+          unit.stringTable[i], static_cast<u32>(out.stringTable.size()));
+      if (inserted) {
+        out.stringTable.push_back(unit.stringTable[i]);
+      }
+      stringRemap[i] = it->second;
+    }
+
+    if (unit.sourceLines.size() == unit.instructions.size()) {
+      out.sourceLines.insert(out.sourceLines.end(), unit.sourceLines.begin(),
+                             unit.sourceLines.end());
+    } else {
+      out.sourceLines.resize(out.sourceLines.size() +
+                             unit.instructions.size());
+    }
+
+    for (Instruction instr : unit.instructions) {
+      if (hasStringOperand(instr.opcode)) {
+        if (instr.operand < stringRemap.size()) {
+          instr.operand = stringRemap[instr.operand];
+        } else {
+          m_errors.push_back(unitName(u) + ": string operand out of range");
+        }
+      } else if (isJumpOpcode(instr.opcode) ||
+                 instr.opcode == OpCode::GOTO_SCENE) {
+        instr.operand += base;
+      }
+      out.instructions.push_back(instr);
+    }
+
+    for (const auto &[name, entry] : unit.sceneEntryPoints) {
+      auto [it, inserted] = sceneOwner.try_emplace(name, u);
+      if (!inserted) {
+        m_errors.push_back(unitName(u) + ": scene '" + name +
+                           "' is already defined in " +
+                           unitName(it->second));
+        continue;
+      }
+      out.sceneEntryPoints[name] = entry + base;
+    }
+
+    for (const auto &[id, decl] : unit.characters) {
+      auto [it, inserted] = characterOwner.try_emplace(id, u);
+      if (!inserted) {
+        m_errors.push_back(unitName(u) + ": character '" + id +
+                           "' is already defined in " +
+                           unitName(it->second));
+        continue;
+      }
+      out.characters[id] = decl;
+    }
+
+    for (const auto &[name, type] : unit.variables) {
+      out.variables.try_emplace(name, type);
+    }
+
+    for (const auto &ref : unit.externalSceneRefs) {
+      pending.push_back({{ref.instructionIndex + base, ref.scene}, u});
+    }
+  }
+
+  for (const auto &[ref, u] : pending) {
+    auto it = out.sceneEntryPoints.find(ref.scene);
+    if (it == out.sceneEntryPoints.end()) {
+      m_errors.push_back(unitName(u) + ": undefined scene '" + ref.scene +
+                         "'");
+      continue;
+    }
+    out.instructions[ref.instructionIndex].operand = it->second;
+  }
+
+  if (out.instructions.empty()) {
+    out.instructions.emplace_back(OpCode::HALT);
+    out.sourceLines.push_back(0);
+  }
+
+  if (!m_errors.empty()) {
+    return Result<CompiledScript>::error(m_errors.front());
+  }
+  return Result<CompiledScript>::ok(std::move(out));
+}
+
+} // namespace NovelMind::scripting
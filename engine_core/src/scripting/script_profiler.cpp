@@ -0,0 +1,267 @@
+#include "NovelMind/scripting/script_profiler.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+namespace NovelMind::scripting {
+
+namespace {
+
+constexpr const char *kGlobalScene = "<global>";
+
+// Scene ranges ordered by entry point; a scene owns every instruction up to
+// the next entry point.
+struct SceneRanges {
+  std::vector<std::pair<u32, std::string>> entries;
+
+  explicit SceneRanges(const CompiledScript &script) {
+    entries.reserve(script.sceneEntryPoints.size());
+    for (const auto &[name, entry] : script.sceneEntryPoints) {
+      entries.emplace_back(entry, name);
+    }
+    std::sort(entries.begin(), entries.end());
+  }
+
+  // Index into entries, or -1 for code ahead of the first scene
+  [[nodiscard]] i64 indexOf(u32 ip) const {
+    auto it = std::upper_bound(
+        entries.begin(), entries.end(), ip,
+        [](u32 value, const auto &entry) { return value < entry.first; });
+    return static_cast<i64>(it - entries.begin()) - 1;
+  }
+
+  [[nodiscard]] std::string nameOf(u32 ip) const {
+    const i64 index = indexOf(ip);
+    return index < 0 ? kGlobalScene
+                     : entries[static_cast<usize>(index)].second;
+  }
+};
+
+} // namespace
+
+ScriptProfiler::ScriptProfiler() : m_origin(Clock::now()) {}
+
+void ScriptProfiler::reset() {
+  std::fill(m_ipCounts.begin(), m_ipCounts.end(), 0);
+  std::fill(m_ipNativeMs.begin(), m_ipNativeMs.end(), 0.0);
+  m_opcodeCounts.fill(0);
+  m_nativeStats.fill({});
+  m_totalInstructions = 0;
+  m_events.clear();
+  m_origin = Clock::now();
+}
+
+void ScriptProfiler::attach(usize programSize) {
+  if (programSize > m_ipCounts.size()) {
+    m_ipCounts.resize(programSize, 0);
+    m_ipNativeMs.resize(programSize, 0.0);
+  }
+}
+
+void ScriptProfiler::recordNativeCall(OpCode op, u32 ip,
+                                      Clock::time_point start,
+                                      Clock::time_point end) {
+  const f64 ms = std::chrono::duration<f64, std::milli>(end - start).count();
+
+  NativeCallStats &stats = m_nativeStats[static_cast<usize>(op)];
+  ++stats.calls;
+  stats.totalMs += ms;
+  stats.maxMs = std::max(stats.maxMs, ms);
+
+  if (ip < m_ipNativeMs.size()) {
+    m_ipNativeMs[ip] += ms;
+  }
+
+  if (m_events.size() < m_maxTraceEvents) {
+    const f64 startUs =
+        std::chrono::duration<f64, std::micro>(start - m_origin).count();
+    m_events.push_back({op, ip, startUs, ms * 1000.0});
+  }
+}
+
+std::vector<ScriptSceneProfile>
+ScriptProfiler::sceneProfile(const CompiledScript &script) const {
+  SceneRanges ranges(script);
+
+  std::vector<ScriptSceneProfile> scenes(ranges.entries.size() + 1);
+  scenes[0].scene = kGlobalScene;
+  for (usize i = 0; i < ranges.entries.size(); ++i) {
+    scenes[i + 1].scene = ranges.entries[i].second;
+    scenes[i + 1].entryPoint = ranges.entries[i].first;
+  }
+
+  const usize size = std::min(m_ipCounts.size(), script.instructions.size());
+  for (usize ip = 0; ip < size; ++ip) {
+    if (m_ipCounts[ip] == 0) {
+      continue;
+    }
+    auto &scene = scenes[static_cast<usize>(
+        ranges.indexOf(static_cast<u32>(ip)) + 1)];
+    scene.instructions += m_ipCounts[ip];
+    scene.nativeMs += m_ipNativeMs[ip];
+    if (isNativeOpcode(script.instructions[ip].opcode)) {
+      scene.nativeCalls += m_ipCounts[ip];
+    }
+  }
+
+  scenes.erase(std::remove_if(scenes.begin(), scenes.end(),
+                              [](const ScriptSceneProfile &scene) {
+                                return scene.instructions == 0;
+                              }),
+               scenes.end());
+  std::stable_sort(scenes.begin(), scenes.end(),
+                   [](const ScriptSceneProfile &a,
+                      const ScriptSceneProfile &b) {
+                     return a.instructions > b.instructions;
+                   });
+  return scenes;
+}
+
+std::vector<ScriptLineProfile>
+ScriptProfiler::lineProfile(const CompiledScript &script) const {
+  std::vector<ScriptLineProfile> lines;
+  if (script.sourceLines.size() != script.instructions.size()) {
+    return lines;
+  }
+
+  SceneRanges ranges(script);
+  std::map<u32, ScriptLineProfile> byLine;
+  const usize size = std::min(m_ipCounts.size(), script.instructions.size());
+  for (usize ip = 0; ip < size; ++ip) {
+    const u32 line = script.sourceLines[ip];
+    if (m_ipCounts[ip] == 0 || line == 0) {
+      continue;
+    }
+    auto [it, inserted] = byLine.try_emplace(line);
+    if (inserted) {
+      it->second.line = line;
+      it->second.scene = ranges.nameOf(static_cast<u32>(ip));
+    }
+    it->second.instructions += m_ipCounts[ip];
+    it->second.nativeMs += m_ipNativeMs[ip];
+  }
+
+  lines.reserve(byLine.size());
+  for (auto &[line, profile] : byLine) {
+    lines.push_back(std::move(profile));
+  }
+  std::stable_sort(lines.begin(), lines.end(),
+                   [](const ScriptLineProfile &a, const ScriptLineProfile &b) {
+                     return a.instructions > b.instructions;
+                   });
+  return lines;
+}
+
+std::string ScriptProfiler::formatReport(const CompiledScript &script,
+                                         usize maxRows) const {
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(3);
+  out << "Script profile: " << m_totalInstructions << " instructions\n";
+
+  out << "\nHot scenes:\n";
+  const auto scenes = sceneProfile(script);
+  for (usize i = 0; i < scenes.size() && i < maxRows; ++i) {
+    const auto &scene = scenes[i];
+    out << "  " << std::setw(24) << std::left << scene.scene << std::right
+        << std::setw(12) << scene.instructions << " instr "
+        << std::setw(8) << scene.nativeCalls << " native "
+        << std::setw(10) << scene.nativeMs << " ms\n";
+  }
+
+  const auto lines = lineProfile(script);
+  if (!lines.empty()) {
+    out << "\nHot lines:\n";
+    for (usize i = 0; i < lines.size() && i < maxRows; ++i) {
+      const auto &line = lines[i];
+      out << "  line " << std::setw(6) << std::left << line.line
+          << std::right << std::setw(12) << line.instructions << " instr "
+          << std::setw(10) << line.nativeMs << " ms  (" << line.scene
+          << ")\n";
+    }
+  }
+
+  std::vector<std::pair<u64, usize>> opcodes;
+  for (usize op = 0; op < m_opcodeCounts.size(); ++op) {
+    if (m_opcodeCounts[op] != 0) {
+      opcodes.emplace_back(m_opcodeCounts[op], op);
+    }
+  }
+  std::sort(opcodes.rbegin(), opcodes.rend());
+
+  out << "\nOpcodes:\n";
+  for (usize i = 0; i < opcodes.size() && i < maxRows; ++i) {
+    const auto op = static_cast<OpCode>(opcodes[i].second);
+    const auto &native = nativeStats(op);
+    out << "  " << std::setw(16) << std::left << opcodeToString(op)
+        << std::right << std::setw(12) << opcodes[i].first;
+    if (native.calls != 0) {
+      out << "  native " << native.totalMs << " ms (max " << native.maxMs
+          << " ms)";
+    }
+    out << "\n";
+  }
+
+  return out.str();
+}
+
+bool ScriptProfiler::exportToChromeTrace(const std::string &filename,
+                                         const CompiledScript &script) const {
+  std::ofstream file(filename);
+  if (!file.is_open()) {
+    return false;
+  }
+
+  SceneRanges ranges(script);
+  const bool hasLines =
+      script.sourceLines.size() == script.instructions.size();
+
+  file << std::fixed << std::setprecision(3);
+  file << "{\"traceEvents\":[\n";
+
+  bool first = true;
+  f64 endUs = 0.0;
+  for (const auto &event : m_events) {
+    if (!first) {
+      file << ",\n";
+    }
+    first = false;
+    endUs = std::max(endUs, event.startUs + event.durationUs);
+
+    file << "{";
+    file << "\"name\":\"" << opcodeToString(event.opcode) << "\",";
+    file << "\"cat\":\"script\",";
+    file << "\"ph\":\"X\",";
+    file << "\"ts\":" << event.startUs << ",";
+    file << "\"dur\":" << event.durationUs << ",";
+    file << "\"pid\":1,";
+    file << "\"tid\":\"script\",";
+    file << "\"args\":{\"ip\":" << event.ip << ",\"scene\":\""
+         << ranges.nameOf(event.ip) << "\"";
+    if (hasLines && event.ip < script.sourceLines.size()) {
+      file << ",\"line\":" << script.sourceLines[event.ip];
+    }
+    file << "}}";
+  }
+
+  // One counter sample with the instruction total of every scene
+  const auto scenes = sceneProfile(script);
+  if (!scenes.empty()) {
+    if (!first) {
+      file << ",\n";
+    }
+    file << "{\"name\":\"instructions per scene\",\"ph\":\"C\",\"ts\":"
+         << endUs << ",\"pid\":1,\"args\":{";
+    for (usize i = 0; i < scenes.size(); ++i) {
+      file << (i == 0 ? "" : ",") << "\"" << scenes[i].scene
+           << "\":" << scenes[i].instructions;
+    }
+    file << "}}";
+  }
+
+  file << "\n]}\n";
+  return file.good();
+}
+
+} // namespace NovelMind::scripting
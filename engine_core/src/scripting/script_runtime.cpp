@@ -1,6 +1,8 @@
 #include "NovelMind/scripting/script_runtime.hpp"
 #include "NovelMind/core/logger.hpp"
+#include "NovelMind/scripting/compiled_script_image.hpp"
 #include <algorithm>
+#include <chrono>
 #include <cstring>
 
 namespace NovelMind::scripting {
@@ -9,22 +11,46 @@ ScriptRuntime::ScriptRuntime() = default;
 ScriptRuntime::~ScriptRuntime() = default;
 
 Result<void> ScriptRuntime::load(const CompiledScript &script) {
-  m_script = script;
-
   auto result = m_vm.load(script.instructions, script.stringTable);
   if (!result.isOk()) {
     return Result<void>::error(result.error());
   }
 
+  // The VM owns the bytecode; only the lookup tables are kept here
+  m_script = CompiledScript{};
+  m_script.sceneEntryPoints = script.sceneEntryPoints;
+  m_script.characters = script.characters;
+  m_script.externalSceneRefs = script.externalSceneRefs;
+  onScriptLoaded();
+  return Result<void>::ok();
+}
+
+Result<void>
+ScriptRuntime::load(std::shared_ptr<const CompiledScriptImage> image) {
+  if (!image) {
+    return Result<void>::error("No script image");
+  }
+  CompiledScript tables = image->metadata();
+  auto result = m_vm.load(std::move(image));
+  if (!result.isOk()) {
+    return Result<void>::error(result.error());
+  }
+
+  m_script = std::move(tables);
+  onScriptLoaded();
+  return Result<void>::ok();
+}
+
+void ScriptRuntime::onScriptLoaded() {
+  m_prefetcher.setScript({m_vm.program(), m_vm.strings(), &m_script});
   registerCallbacks();
   m_state = RuntimeState::Idle;
+  m_pendingScene.clear();
   m_visibleCharacters.clear();
   m_currentBackground.clear();
   m_currentSpeaker.clear();
   m_currentDialogue.clear();
   m_currentChoices.clear();
-
-  return Result<void>::ok();
 }
 
 void ScriptRuntime::setSceneManager(scene::SceneManager *manager) {
@@ -47,8 +73,14 @@ void ScriptRuntime::setAnimationManager(scene::AnimationManager *manager) {
   m_animationManager = manager;
 }
 
+void ScriptRuntime::setResourceManager(resource::ResourceManager *resources) {
+  m_resources = resources;
+  m_prefetcher.setResourceManager(resources);
+}
+
 void ScriptRuntime::setConfig(const RuntimeConfig &config) {
   m_config = config;
+  m_prefetcher.setConfig(config.prefetch);
 }
 
 const RuntimeConfig &ScriptRuntime::getConfig() const { return m_config; }
@@ -72,10 +104,10 @@ Result<void> ScriptRuntime::gotoScene(const std::string &sceneName) {
 
   u32 entryPoint = it->second;
   m_currentScene = sceneName;
-  m_vm.reset();
+  m_pendingScene.clear();
 
-  // Load the full program and set IP to scene entry point
-  m_vm.load(m_script.instructions, m_script.stringTable);
+  // The whole program is already loaded; a scene is just an entry point
+  m_vm.reset();
   m_vm.setIP(entryPoint);
   m_visibleCharacters.clear();
   m_currentChoices.clear();
@@ -85,6 +117,8 @@ Result<void> ScriptRuntime::gotoScene(const std::string &sceneName) {
   m_dialogueActive = false;
 
   m_state = RuntimeState::Running;
+  m_prefetcher.preload(entryPoint);
+  m_prefetcher.update(entryPoint);
   fireEvent(ScriptEventType::SceneChange, sceneName);
 
   NOVELMIND_LOG_INFO("Jumped to scene '" + sceneName + "' at instruction " +
@@ -129,36 +163,9 @@ void ScriptRuntime::update(f64 deltaTime) {
       // Waiting on dialogue/choices is tracked by ScriptRuntime state.
       m_vm.signalContinue();
     }
-    // Execute VM steps
-    if (m_skipMode) {
-      // In skip mode, run faster
-      for (i32 i = 0; i < 10 && m_state == RuntimeState::Running; ++i) {
-        if (!m_vm.step()) {
-          if (m_vm.isWaiting() || m_vm.isPaused()) {
-            break;
-          }
-          m_state = RuntimeState::Halted;
-          break;
-        }
-
-        if (m_vm.isWaiting() || m_vm.isPaused()) {
-          break;
-        }
-      }
-    } else {
-      // Normal execution
-      if (!m_vm.step()) {
-        if (m_vm.isWaiting() || m_vm.isPaused()) {
-          break;
-        }
-        m_state = RuntimeState::Halted;
-        break;
-      }
-
-      if (m_vm.isHalted()) {
-        m_state = RuntimeState::Halted;
-      }
-    }
+    runSlice();
+    // Look ahead from wherever the slice stopped, usually a line of dialogue
+    m_prefetcher.update(m_vm.getIP());
     break;
   }
 
@@ -166,6 +173,59 @@ void ScriptRuntime::update(f64 deltaTime) {
   updateDialogue(deltaTime);
 }
 
+void ScriptRuntime::runSlice() {
+  using Clock = std::chrono::steady_clock;
+  // Instructions between clock reads; reading the clock costs about as
+  // much as a few dozen instructions in the dispatch engine
+  constexpr u32 kClockCheckInterval = 256;
+
+  const u32 maxInstructions = m_config.instructionBudget;
+  const u32 maxMicros = m_config.timeBudgetMicros;
+  const auto deadline = Clock::now() + std::chrono::microseconds(maxMicros);
+
+  u32 executed = 0;
+  bool overran = false;
+  while (m_state == RuntimeState::Running) {
+    if (maxInstructions != 0 && executed >= maxInstructions) {
+      overran = true;
+      break;
+    }
+    if (maxMicros != 0 && executed != 0 && Clock::now() >= deadline) {
+      overran = true;
+      break;
+    }
+
+    u32 chunk = kClockCheckInterval;
+    if (maxInstructions != 0) {
+      chunk = std::min(chunk, maxInstructions - executed);
+    }
+    // Returns early after every native command so the state it set is
+    // seen before more script runs
+    executed += m_vm.run(chunk);
+
+    if (!m_pendingScene.empty()) {
+      std::string sceneName;
+      sceneName.swap(m_pendingScene);
+      gotoScene(sceneName);
+      continue;
+    }
+
+    if (m_vm.isHalted()) {
+      m_state = RuntimeState::Halted;
+      break;
+    }
+    if (m_vm.isWaiting() || m_vm.isPaused()) {
+      break;
+    }
+  }
+
+  m_lastSliceInstructions = executed;
+  if (overran) {
+    fireEvent(ScriptEventType::SliceOverrun, m_currentScene,
+              Value{static_cast<i32>(executed)});
+  }
+}
+
 void ScriptRuntime::continueExecution() {
   if (m_state == RuntimeState::WaitingInput) {
     m_state = RuntimeState::Running;
@@ -230,6 +290,10 @@ bool ScriptRuntime::isComplete() const {
   return m_state == RuntimeState::Halted;
 }
 
+u32 ScriptRuntime::getLastSliceInstructions() const {
+  return m_lastSliceInstructions;
+}
+
 const std::string &ScriptRuntime::getCurrentScene() const {
   return m_currentScene;
 }
@@ -344,31 +408,46 @@ void ScriptRuntime::setEventCallback(EventCallback callback) {
 
 VirtualMachine &ScriptRuntime::getVM() { return m_vm; }
 
-// VM callback handlers
+const AssetPrefetcher &ScriptRuntime::getPrefetcher() const {
+  return m_prefetcher;
+}
 
-void ScriptRuntime::onShowBackground(const std::vector<Value> &args) {
-  if (args.empty()) {
-    return;
-  }
+// VM native opcode handlers
+//
+// These run for every VN command, including while skip mode fast-forwards
+// through thousands of lines, so they read operands straight from the VM
+// views and only copy into long-lived members whose capacity is reused.
+
+void ScriptRuntime::onShowBackground(const NativeCallArgs &args) {
+  m_currentBackground.assign(args.text);
 
-  std::string bgName = asString(args[0]);
-  m_currentBackground = bgName;
+  if (m_resources && !m_currentBackground.empty()) {
+    m_prefetcher.recordUse(PrefetchAssetKind::Background, m_currentBackground);
+    m_resources->requestTexture(m_currentBackground,
+                                resource::LoadPriority::Immediate);
+  }
 
   // The scene manager would load and display the background
   if (m_sceneManager) {
-    // m_sceneManager->setBackground(bgName);
+    // m_sceneManager->setBackground(m_currentBackground);
   }
 
-  fireEvent(ScriptEventType::BackgroundChanged, bgName);
+  fireEvent(ScriptEventType::BackgroundChanged, m_currentBackground);
 }
 
-void ScriptRuntime::onShowCharacter(const std::vector<Value> &args) {
-  if (args.size() < 2) {
-    return;
-  }
+void ScriptRuntime::onShowCharacter(const NativeCallArgs &args) {
+  const TaggedValue &idVal = args.fromTop(1);
+  const TaggedValue &posVal = args.fromTop(0);
 
-  std::string charId = asString(args[0]);
-  i32 posCode = asInt(args[1]);
+  if (idVal.isNull()) {
+    m_nameScratch.assign(args.text);
+  } else if (idVal.isString()) {
+    m_nameScratch.assign(idVal.stringView());
+  } else {
+    m_nameScratch = idVal.asString();
+  }
+  const std::string &charId = m_nameScratch;
+  i32 posCode = posVal.isNull() ? 1 : posVal.asInt();
   Scene::CharacterPosition position = parsePosition(posCode);
   (void)position; // Will be used when scene manager integration is implemented
 
@@ -383,6 +462,14 @@ void ScriptRuntime::onShowCharacter(const std::vector<Value> &args) {
     return;
   }
 
+  if (m_resources) {
+    const std::string sprite = it->second.defaultSprite.value_or(charId);
+    if (!sprite.empty()) {
+      m_prefetcher.recordUse(PrefetchAssetKind::Character, sprite);
+      m_resources->requestTexture(sprite, resource::LoadPriority::Immediate);
+    }
+  }
+
   // Create or get character sprite
   if (m_sceneManager) {
     // m_sceneManager->showCharacter(charId, position);
@@ -391,12 +478,8 @@ void ScriptRuntime::onShowCharacter(const std::vector<Value> &args) {
   fireEvent(ScriptEventType::CharacterShow, charId, Value{posCode});
 }
 
-void ScriptRuntime::onHideCharacter(const std::vector<Value> &args) {
-  if (args.empty()) {
-    return;
-  }
-
-  std::string charId = asString(args[0]);
+void ScriptRuntime::onHideCharacter(const NativeCallArgs &args) {
+  const std::string_view charId = args.text;
   m_visibleCharacters.erase(std::remove(m_visibleCharacters.begin(),
                                         m_visibleCharacters.end(), charId),
                             m_visibleCharacters.end());
@@ -408,20 +491,19 @@ void ScriptRuntime::onHideCharacter(const std::vector<Value> &args) {
   fireEvent(ScriptEventType::CharacterHide, charId);
 }
 
-void ScriptRuntime::onSay(const std::vector<Value> &args) {
-  if (args.empty()) {
-    return;
-  }
-
-  std::string text = asString(args[0]);
-  std::string speaker;
+void ScriptRuntime::onSay(const NativeCallArgs &args) {
+  const TaggedValue &speakerVal = args.fromTop(0);
 
-  if (args.size() > 1 && !isNull(args[1])) {
-    speaker = asString(args[1]);
+  m_currentDialogue.assign(args.text);
+  if (speakerVal.isNull()) {
+    m_currentSpeaker.clear();
+  } else if (speakerVal.isString()) {
+    m_currentSpeaker.assign(speakerVal.stringView());
+  } else {
+    m_currentSpeaker = speakerVal.asString();
   }
-
-  m_currentSpeaker = speaker;
-  m_currentDialogue = text;
+  const std::string &speaker = m_currentSpeaker;
+  const std::string &text = m_currentDialogue;
 
   if (m_dialogueBox) {
     if (!speaker.empty()) {
@@ -446,20 +528,21 @@ void ScriptRuntime::onSay(const std::vector<Value> &args) {
   }
 
   m_state = RuntimeState::WaitingInput;
-  fireEvent(ScriptEventType::DialogueStart, speaker, Value{text});
-}
-
-void ScriptRuntime::onChoice(const std::vector<Value> &args) {
-  if (args.empty()) {
-    return;
+  if (m_eventCallback) {
+    fireEvent(ScriptEventType::DialogueStart, speaker, Value{text});
   }
+}
 
-  i32 count = asInt(args[0]);
+void ScriptRuntime::onChoice(const NativeCallArgs &args) {
   m_currentChoices.clear();
 
-  // Extract choice texts from the next args
-  for (i32 i = 1; i <= count && i < static_cast<i32>(args.size()); ++i) {
-    m_currentChoices.push_back(asString(args[static_cast<size_t>(i)]));
+  for (u32 i = 0; i < args.operand; ++i) {
+    const TaggedValue &option = args.option(i);
+    if (option.isString()) {
+      m_currentChoices.emplace_back(option.stringView());
+    } else {
+      m_currentChoices.push_back(option.asString());
+    }
   }
 
   if (m_choiceMenu) {
@@ -474,78 +557,59 @@ void ScriptRuntime::onChoice(const std::vector<Value> &args) {
   fireEvent(ScriptEventType::ChoiceStart);
 }
 
-void ScriptRuntime::onGotoScene(const std::vector<Value> &args) {
-  if (args.empty()) {
-    return;
-  }
-
-  std::string sceneName;
-  if (std::holds_alternative<std::string>(args[0])) {
-    sceneName = std::get<std::string>(args[0]);
-  } else {
-    u32 entryPoint = static_cast<u32>(asInt(args[0]));
-    for (const auto &pair : m_script.sceneEntryPoints) {
-      if (pair.second == entryPoint) {
-        sceneName = pair.first;
-        break;
-      }
+void ScriptRuntime::onGotoScene(const NativeCallArgs &args) {
+  const u32 entryPoint = args.operand;
+  for (const auto &pair : m_script.sceneEntryPoints) {
+    if (pair.second == entryPoint) {
+      // Deferred to runSlice(): the VM advances past the instruction being
+      // executed when the handler returns, so the entry point would be
+      // skipped
+      m_pendingScene = pair.first;
+      return;
     }
   }
-
-  if (sceneName.empty()) {
-    return;
-  }
-
-  gotoScene(sceneName);
 }
 
-void ScriptRuntime::onWait(const std::vector<Value> &args) {
-  if (args.empty()) {
-    return;
-  }
-
+void ScriptRuntime::onWait(const NativeCallArgs &args) {
   // Duration is stored as raw bits
-  u32 durBits = static_cast<u32>(asInt(args[0]));
   f32 duration;
-  std::memcpy(&duration, &durBits, sizeof(f32));
+  std::memcpy(&duration, &args.operand, sizeof(f32));
 
   m_waitTimer = duration;
   m_state = RuntimeState::WaitingTimer;
 }
 
-void ScriptRuntime::onPlaySound(const std::vector<Value> &args) {
-  if (args.empty()) {
-    return;
-  }
-
-  std::string soundId = asString(args[0]);
+void ScriptRuntime::onPlaySound(const NativeCallArgs &args) {
+  m_nameScratch.assign(args.text);
 
+  if (m_resources) {
+    m_prefetcher.recordUse(PrefetchAssetKind::Sound, m_nameScratch);
+  }
   if (m_audioManager) {
-    m_audioManager->playSound(soundId);
+    m_audioManager->playSound(m_nameScratch);
   }
 
-  fireEvent(ScriptEventType::SoundPlay, soundId);
+  fireEvent(ScriptEventType::SoundPlay, m_nameScratch);
 }
 
-void ScriptRuntime::onPlayMusic(const std::vector<Value> &args) {
-  if (args.empty()) {
-    return;
-  }
-
-  std::string musicId = asString(args[0]);
+void ScriptRuntime::onPlayMusic(const NativeCallArgs &args) {
+  m_nameScratch.assign(args.text);
 
+  if (m_resources) {
+    m_prefetcher.recordUse(PrefetchAssetKind::Music, m_nameScratch);
+  }
   if (m_audioManager) {
-    m_audioManager->playMusic(musicId);
+    m_audioManager->playMusic(m_nameScratch);
   }
 
-  fireEvent(ScriptEventType::MusicStart, musicId);
+  fireEvent(ScriptEventType::MusicStart, m_nameScratch);
 }
 
-void ScriptRuntime::onStopMusic(const std::vector<Value> &args) {
+void ScriptRuntime::onStopMusic(const NativeCallArgs &args) {
   f32 fadeOut = 0.0f;
 
-  if (!args.empty()) {
-    u32 durBits = static_cast<u32>(asInt(args[0]));
+  if (!args.values.empty()) {
+    u32 durBits = static_cast<u32>(args.fromTop(0).asInt());
     std::memcpy(&fadeOut, &durBits, sizeof(f32));
   }
 
@@ -556,66 +620,43 @@ void ScriptRuntime::onStopMusic(const std::vector<Value> &args) {
   fireEvent(ScriptEventType::MusicStop);
 }
 
-void ScriptRuntime::onTransition(const std::vector<Value> &args) {
-  if (args.size() < 2) {
-    return;
-  }
-
-  std::string type = asString(args[0]);
-  u32 durBits = static_cast<u32>(asInt(args[1]));
+void ScriptRuntime::onTransition(const NativeCallArgs &args) {
+  m_nameScratch.assign(args.text);
+  u32 durBits = static_cast<u32>(args.fromTop(0).asInt());
   f32 duration;
   std::memcpy(&duration, &durBits, sizeof(f32));
 
-  m_activeTransition = createTransition(type, duration);
+  m_activeTransition = createTransition(m_nameScratch, duration);
   if (m_activeTransition) {
     m_activeTransition->start(duration);
     m_state = RuntimeState::WaitingTransition;
-    fireEvent(ScriptEventType::TransitionStart, type);
+    fireEvent(ScriptEventType::TransitionStart, m_nameScratch);
   }
 }
 
 // Internal helpers
 
 void ScriptRuntime::registerCallbacks() {
-  m_vm.registerCallback(OpCode::SHOW_BACKGROUND,
-                        [this](const auto &args) { onShowBackground(args); });
-
-  m_vm.registerCallback(OpCode::SHOW_CHARACTER,
-                        [this](const auto &args) { onShowCharacter(args); });
-
-  m_vm.registerCallback(OpCode::HIDE_CHARACTER,
-                        [this](const auto &args) { onHideCharacter(args); });
-
-  m_vm.registerCallback(OpCode::SAY, [this](const auto &args) { onSay(args); });
-
-  m_vm.registerCallback(OpCode::CHOICE,
-                        [this](const auto &args) { onChoice(args); });
-
-  m_vm.registerCallback(OpCode::GOTO_SCENE,
-                        [this](const auto &args) { onGotoScene(args); });
-
-  m_vm.registerCallback(OpCode::WAIT,
-                        [this](const auto &args) { onWait(args); });
-
-  m_vm.registerCallback(OpCode::PLAY_SOUND,
-                        [this](const auto &args) { onPlaySound(args); });
-
-  m_vm.registerCallback(OpCode::PLAY_MUSIC,
-                        [this](const auto &args) { onPlayMusic(args); });
-
-  m_vm.registerCallback(OpCode::STOP_MUSIC,
-                        [this](const auto &args) { onStopMusic(args); });
-
-  m_vm.registerCallback(OpCode::TRANSITION,
-                        [this](const auto &args) { onTransition(args); });
-}
-
-void ScriptRuntime::fireEvent(ScriptEventType type, const std::string &name,
+  using RT = ScriptRuntime;
+  m_vm.bindNativeHandler<&RT::onShowBackground>(OpCode::SHOW_BACKGROUND, this);
+  m_vm.bindNativeHandler<&RT::onShowCharacter>(OpCode::SHOW_CHARACTER, this);
+  m_vm.bindNativeHandler<&RT::onHideCharacter>(OpCode::HIDE_CHARACTER, this);
+  m_vm.bindNativeHandler<&RT::onSay>(OpCode::SAY, this);
+  m_vm.bindNativeHandler<&RT::onChoice>(OpCode::CHOICE, this);
+  m_vm.bindNativeHandler<&RT::onGotoScene>(OpCode::GOTO_SCENE, this);
+  m_vm.bindNativeHandler<&RT::onWait>(OpCode::WAIT, this);
+  m_vm.bindNativeHandler<&RT::onPlaySound>(OpCode::PLAY_SOUND, this);
+  m_vm.bindNativeHandler<&RT::onPlayMusic>(OpCode::PLAY_MUSIC, this);
+  m_vm.bindNativeHandler<&RT::onStopMusic>(OpCode::STOP_MUSIC, this);
+  m_vm.bindNativeHandler<&RT::onTransition>(OpCode::TRANSITION, this);
+}
+
+void ScriptRuntime::fireEvent(ScriptEventType type, std::string_view name,
                               const Value &value) {
   if (m_eventCallback) {
     ScriptEvent event;
     event.type = type;
-    event.name = name;
+    event.name = std::string(name);
     event.value = value;
     m_eventCallback(event);
   }
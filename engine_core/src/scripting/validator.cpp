@@ -32,6 +32,12 @@ void Validator::setReportUnused(bool report) { m_reportUnused = report; }
 
 void Validator::setReportDeadCode(bool report) { m_reportDeadCode = report; }
 
+void Validator::setExternalSymbols(std::vector<std::string> characters,
+                                   std::vector<std::string> scenes) {
+  m_externalCharacters = {characters.begin(), characters.end()};
+  m_externalScenes = {scenes.begin(), scenes.end()};
+}
+
 void Validator::reset() {
   m_characters.clear();
   m_scenes.clear();
@@ -40,6 +46,19 @@ void Validator::reset() {
   m_currentScene.clear();
   m_currentLocation = {};
   m_errors.clear();
+
+  for (const auto &name : m_externalCharacters) {
+    SymbolInfo &info = m_characters[name];
+    info.name = name;
+    info.isDefined = true;
+    info.isUsed = true;
+  }
+  for (const auto &name : m_externalScenes) {
+    SymbolInfo &info = m_scenes[name];
+    info.name = name;
+    info.isDefined = true;
+    info.isUsed = true;
+  }
 }
 
 // First pass: collect definitions
@@ -485,7 +504,8 @@ void Validator::analyzeControlFlow(const Program &program) {
   // Report unreachable scenes
   if (m_reportDeadCode) {
     for (const auto &[sceneName, info] : m_scenes) {
-      if (info.isDefined && reachable.find(sceneName) == reachable.end()) {
+      if (info.isDefined && reachable.find(sceneName) == reachable.end() &&
+          m_externalScenes.find(sceneName) == m_externalScenes.end()) {
         // First scene is always reachable
         if (sceneName != startScene) {
           warning(ErrorCode::UnreachableScene,
@@ -1,13 +1,112 @@
 #include "NovelMind/scripting/vm.hpp"
 #include "NovelMind/core/logger.hpp"
+#include "NovelMind/scripting/compiled_script_image.hpp"
+#include "NovelMind/scripting/script_profiler.hpp"
+#include "vm_detail.hpp"
 #include <algorithm>
 #include <cstring>
 
 namespace NovelMind::scripting {
 
+using detail::evalBinary;
+using detail::negate;
+
+namespace {
+
+// Marshal a native call into the owned argument list std::function
+// callbacks have always received.
+std::vector<Value> toCallbackArgs(const NativeCallArgs &args) {
+  std::vector<Value> out;
+  switch (args.opcode) {
+  case OpCode::SHOW_CHARACTER: {
+    const TaggedValue &id = args.fromTop(1);
+    const TaggedValue &pos = args.fromTop(0);
+    out.push_back(id.isNull() ? Value{std::string(args.text)} : id.toValue());
+    out.push_back(pos.isNull() ? Value{static_cast<i32>(1)} : pos.toValue());
+    break;
+  }
+  case OpCode::SAY:
+  case OpCode::TRANSITION:
+    out.emplace_back(std::string(args.text));
+    out.push_back(args.fromTop(0).toValue());
+    break;
+  case OpCode::CHOICE:
+    out.reserve(static_cast<usize>(args.operand) + 1);
+    out.emplace_back(static_cast<i32>(args.operand));
+    for (u32 i = 0; i < args.operand; ++i) {
+      out.push_back(args.option(i).toValue());
+    }
+    break;
+  case OpCode::STOP_MUSIC:
+    if (!args.values.empty()) {
+      out.push_back(args.fromTop(0).toValue());
+    }
+    break;
+  case OpCode::WAIT:
+  case OpCode::GOTO_SCENE:
+    out.emplace_back(static_cast<i32>(args.operand));
+    break;
+  default:
+    out.emplace_back(std::string(args.text));
+    break;
+  }
+  return out;
+}
+
+bool isNameOpcode(OpCode op) {
+  switch (op) {
+  case OpCode::LOAD_VAR:
+  case OpCode::STORE_VAR:
+  case OpCode::LOAD_GLOBAL:
+  case OpCode::STORE_GLOBAL:
+  case OpCode::SET_FLAG:
+  case OpCode::CHECK_FLAG:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Name operands index the slot tables directly in the interpreter loop, so
+// they are bounds-checked once here instead of on every access.
+Result<void> checkNameOperands(std::span<const Instruction> program,
+                               usize stringCount) {
+  for (usize ip = 0; ip < program.size(); ++ip) {
+    if (isNameOpcode(program[ip].opcode) &&
+        program[ip].operand >= stringCount) {
+      return Result<void>::error("Invalid name operand at instruction " +
+                                 std::to_string(ip));
+    }
+  }
+  return Result<void>::ok();
+}
+
+} // namespace
+
+template <OpCode Op> void VirtualMachine::applyBinary() {
+  TaggedValue b = pop();
+  TaggedValue a = pop();
+  push(evalBinary<Op>(a, b));
+}
+
+template <OpCode Op> bool VirtualMachine::compareTop() {
+  TaggedValue b = pop();
+  TaggedValue a = pop();
+  return evalBinary<Op>(a, b).asBool();
+}
+
+template <OpCode Op> void VirtualMachine::branchUnless(u32 target) {
+  if (!compareTop<Op>()) {
+    // -1 because step() increments after execution (wraps for target 0)
+    m_ip = target - 1;
+  }
+}
+
 VirtualMachine::VirtualMachine()
     : m_ip(0), m_running(false), m_paused(false), m_waiting(false),
-      m_halted(false), m_choiceResult(-1) {}
+      m_halted(false), m_choiceResult(-1) {
+  m_stack.reserve(64);
+}
 
 VirtualMachine::~VirtualMachine() = default;
 
@@ -16,14 +115,84 @@ Result<void> VirtualMachine::load(const std::vector<Instruction> &program,
   if (program.empty()) {
     return Result<void>::error("Empty program");
   }
+  if (auto checked = checkNameOperands(program, stringTable.size());
+      checked.isError()) {
+    return checked;
+  }
+
+  // Variables may borrow strings from the table being replaced
+  for (auto &value : m_variables.values) {
+    value.detach();
+  }
+  m_image.reset();
+  m_ownedProgram = program;
+  m_ownedStrings = stringTable;
+  m_ownedStringViews.assign(m_ownedStrings.begin(), m_ownedStrings.end());
+  m_program = m_ownedProgram;
+  m_strings = m_ownedStringViews;
+  return bindProgram();
+}
+
+Result<void> VirtualMachine::load(
+    std::shared_ptr<const CompiledScriptImage> image) {
+  if (!image || image->instructions().empty()) {
+    return Result<void>::error("Empty program");
+  }
+  if (auto checked =
+          checkNameOperands(image->instructions(), image->strings().size());
+      checked.isError()) {
+    return checked;
+  }
+
+  for (auto &value : m_variables.values) {
+    value.detach();
+  }
+  m_ownedProgram.clear();
+  m_ownedStrings.clear();
+  m_ownedStringViews.clear();
+  m_image = std::move(image);
+  m_program = m_image->instructions();
+  m_strings = m_image->strings();
+  return bindProgram();
+}
 
-  m_program = program;
-  m_stringTable = stringTable;
+Result<void> VirtualMachine::bindProgram() {
+  ++m_programVersion;
+  resolveSlots();
   reset();
+  if (m_profiler) {
+    m_profiler->attach(m_program.size());
+  }
 
   return Result<void>::ok();
 }
 
+void VirtualMachine::resolveSlots() {
+  // Map name operands (string table indices) to dense slot indices once so
+  // the interpreter loop never touches a string for variable or flag
+  // access. The bytecode itself stays untouched, so it can live in a
+  // read-only mapping.
+  m_variableSlots.assign(m_strings.size(), 0);
+  m_flagSlots.assign(m_strings.size(), 0);
+  for (const auto &instr : m_program) {
+    switch (instr.opcode) {
+    case OpCode::LOAD_VAR:
+    case OpCode::STORE_VAR:
+    case OpCode::LOAD_GLOBAL:
+    case OpCode::STORE_GLOBAL:
+      m_variableSlots[instr.operand] =
+          m_variables.intern(m_strings[instr.operand]);
+      break;
+    case OpCode::SET_FLAG:
+    case OpCode::CHECK_FLAG:
+      m_flagSlots[instr.operand] = m_flags.intern(m_strings[instr.operand]);
+      break;
+    default:
+      break;
+    }
+  }
+}
+
 void VirtualMachine::reset() {
   m_ip = 0;
   m_stack.clear();
@@ -44,7 +213,11 @@ bool VirtualMachine::step() {
     return false;
   }
 
-  executeInstruction(m_program[m_ip]);
+  const Instruction &instr = m_program[m_ip];
+  if (m_profiler) {
+    m_profiler->recordInstruction(m_ip, instr.opcode);
+  }
+  executeInstruction(instr);
   ++m_ip;
 
   return !m_halted;
@@ -54,11 +227,142 @@ void VirtualMachine::run() {
   m_running = true;
   m_paused = false;
 
+  if (m_dispatchMode != DispatchMode::Switch && !m_profiler) {
+    runThreaded(0, false);
+    return;
+  }
+
   while (m_running && !m_halted && !m_paused && !m_waiting) {
     step();
   }
 }
 
+// Opcodes the threaded engine executes inline. Anything else (HALT, CALL,
+// RETURN, VN commands) goes through executeInstruction() and may yield.
+#define NOVELMIND_VM_INLINE_OPS(X)                                             \
+  X(NOP)                                                                       \
+  X(JUMP)                                                                      \
+  X(JUMP_IF)                                                                   \
+  X(JUMP_IF_NOT)                                                               \
+  X(PUSH_INT)                                                                  \
+  X(PUSH_FLOAT)                                                                \
+  X(PUSH_STRING)                                                               \
+  X(PUSH_BOOL)                                                                 \
+  X(PUSH_NULL)                                                                 \
+  X(POP)                                                                       \
+  X(DUP)                                                                       \
+  X(LOAD_VAR)                                                                  \
+  X(LOAD_GLOBAL)                                                               \
+  X(STORE_VAR)                                                                 \
+  X(STORE_GLOBAL)                                                              \
+  X(ADD)                                                                       \
+  X(SUB)                                                                       \
+  X(MUL)                                                                       \
+  X(DIV)                                                                       \
+  X(MOD)                                                                       \
+  X(NEG)                                                                       \
+  X(EQ)                                                                        \
+  X(NE)                                                                        \
+  X(LT)                                                                        \
+  X(LE)                                                                        \
+  X(GT)                                                                        \
+  X(GE)                                                                        \
+  X(AND)                                                                       \
+  X(OR)                                                                        \
+  X(NOT)                                                                       \
+  X(SET_FLAG)                                                                  \
+  X(CHECK_FLAG)                                                                \
+  X(JUMP_IF_NOT_EQ)                                                            \
+  X(JUMP_IF_NOT_NE)                                                            \
+  X(JUMP_IF_NOT_LT)                                                            \
+  X(JUMP_IF_NOT_LE)                                                            \
+  X(JUMP_IF_NOT_GT)                                                            \
+  X(JUMP_IF_NOT_GE)
+
+#if (defined(__GNUC__) || defined(__clang__)) &&                               \
+    !defined(NOVELMIND_VM_SWITCH_DISPATCH)
+#define NOVELMIND_VM_COMPUTED_GOTO 1
+#else
+#define NOVELMIND_VM_COMPUTED_GOTO 0
+#endif
+
+bool VirtualMachine::computedGotoAvailable() {
+  return NOVELMIND_VM_COMPUTED_GOTO != 0;
+}
+
+namespace {
+
+bool isInlineOp(OpCode op) {
+  switch (op) {
+#define NOVELMIND_VM_CASE(name) case OpCode::name:
+    NOVELMIND_VM_INLINE_OPS(NOVELMIND_VM_CASE)
+#undef NOVELMIND_VM_CASE
+    return true;
+  default:
+    return false;
+  }
+}
+
+} // namespace
+
+// The switch loop is always built so it stays tested on every toolchain
+#define NOVELMIND_VM_LOOP_NAME runSwitchLoop
+#define NOVELMIND_VM_LOOP_GOTO 0
+#include "vm_dispatch_loop.inl"
+
+#if NOVELMIND_VM_COMPUTED_GOTO
+// Labels-as-values is a GNU extension; it is the whole point of this loop.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#if defined(__clang__)
+#pragma GCC diagnostic ignored "-Wgnu-label-as-value"
+#endif
+#define NOVELMIND_VM_LOOP_NAME runComputedGoto
+#define NOVELMIND_VM_LOOP_GOTO 1
+#include "vm_dispatch_loop.inl"
+#pragma GCC diagnostic pop
+#endif
+
+u64 VirtualMachine::runThreaded(u64 budget, bool yieldOnSlow) {
+#if NOVELMIND_VM_COMPUTED_GOTO
+  if (m_dispatchMode == DispatchMode::Threaded) {
+    return runComputedGoto(budget, yieldOnSlow);
+  }
+#endif
+  return runSwitchLoop(budget, yieldOnSlow);
+}
+
+u32 VirtualMachine::run(u32 maxInstructions) {
+  if (m_halted || m_paused || m_waiting || maxInstructions == 0) {
+    return 0;
+  }
+
+  if (m_dispatchMode == DispatchMode::Switch || m_profiler) {
+    u32 executed = 0;
+    while (executed < maxInstructions && !m_halted && !m_paused &&
+           !m_waiting && m_ip < m_program.size()) {
+      const bool inlineOp = isInlineOp(m_program[m_ip].opcode);
+      step();
+      ++executed;
+      if (!inlineOp) {
+        break;
+      }
+    }
+    if (m_ip >= m_program.size()) {
+      m_halted = true;
+    }
+    return executed;
+  }
+
+  // The engine loops while m_running; keep it set only for this call so
+  // signalContinue() and resume() don't start an unbounded run later
+  const bool wasRunning = m_running;
+  m_running = true;
+  const u64 executed = runThreaded(maxInstructions, true);
+  m_running = m_running && wasRunning;
+  return static_cast<u32>(executed);
+}
+
 void VirtualMachine::pause() { m_paused = true; }
 
 void VirtualMachine::resume() {
@@ -87,35 +391,147 @@ void VirtualMachine::setIP(u32 ip) {
 }
 
 void VirtualMachine::setVariable(const std::string &name, Value value) {
-  m_variables[name] = std::move(value);
+  u32 slot = m_variables.intern(name);
+  m_variables.values[slot] = TaggedValue::fromValue(value);
+  m_variables.defined[slot] = 1;
 }
 
 Value VirtualMachine::getVariable(const std::string &name) const {
-  auto it = m_variables.find(name);
-  if (it != m_variables.end()) {
-    return it->second;
+  if (const TaggedValue *value = m_variables.find(name)) {
+    return value->toValue();
   }
   return std::monostate{};
 }
 
 bool VirtualMachine::hasVariable(const std::string &name) const {
-  return m_variables.find(name) != m_variables.end();
+  return m_variables.find(name) != nullptr;
+}
+
+std::unordered_map<std::string, Value>
+VirtualMachine::getAllVariables() const {
+  std::unordered_map<std::string, Value> result;
+  for (usize i = 0; i < m_variables.names.size(); ++i) {
+    if (m_variables.defined[i]) {
+      result.emplace(m_variables.names[i], m_variables.values[i].toValue());
+    }
+  }
+  return result;
 }
 
 void VirtualMachine::setFlag(const std::string &name, bool value) {
-  m_flags[name] = value;
+  u32 slot = m_flags.intern(name);
+  m_flags.values[slot] = value ? 1 : 0;
+  m_flags.defined[slot] = 1;
 }
 
 bool VirtualMachine::getFlag(const std::string &name) const {
-  auto it = m_flags.find(name);
-  if (it != m_flags.end()) {
-    return it->second;
+  if (const u8 *value = m_flags.find(name)) {
+    return *value != 0;
   }
   return false;
 }
 
+std::unordered_map<std::string, bool> VirtualMachine::getAllFlags() const {
+  std::unordered_map<std::string, bool> result;
+  for (usize i = 0; i < m_flags.names.size(); ++i) {
+    if (m_flags.defined[i]) {
+      result.emplace(m_flags.names[i], m_flags.values[i] != 0);
+    }
+  }
+  return result;
+}
+
 void VirtualMachine::registerCallback(OpCode op, NativeCallback callback) {
-  m_callbacks[op] = std::move(callback);
+  const auto index = static_cast<usize>(op);
+  m_callbacks[index] = std::move(callback);
+  m_nativeHandlers[index] = {};
+}
+
+void VirtualMachine::registerNativeHandler(OpCode op, NativeHandlerFn fn,
+                                           void *context) {
+  const auto index = static_cast<usize>(op);
+  m_nativeHandlers[index] = {fn, context};
+  m_callbacks[index] = nullptr;
+}
+
+void VirtualMachine::setProfiler(ScriptProfiler *profiler) {
+  m_profiler = profiler;
+  if (m_profiler) {
+    m_profiler->attach(m_program.size());
+  }
+}
+
+void VirtualMachine::dispatchNative(const Instruction &instr) {
+  const auto index = static_cast<usize>(instr.opcode);
+  const NativeHandler handler = m_nativeHandlers[index];
+  if (!handler.fn && !m_callbacks[index]) {
+    // Nothing bound: operands are left on the stack
+    return;
+  }
+
+  usize arity = 0;
+  bool stringOperand = true;
+  switch (instr.opcode) {
+  case OpCode::SAY:
+  case OpCode::TRANSITION:
+    arity = 1;
+    break;
+  case OpCode::SHOW_CHARACTER:
+    arity = 2;
+    break;
+  case OpCode::STOP_MUSIC:
+    arity = 1;
+    stringOperand = false;
+    break;
+  case OpCode::CHOICE:
+    // Options plus the option count pushed ahead of them
+    arity = static_cast<usize>(instr.operand) + 1;
+    stringOperand = false;
+    break;
+  case OpCode::WAIT:
+  case OpCode::GOTO_SCENE:
+    stringOperand = false;
+    break;
+  default:
+    break;
+  }
+
+  // Move consumed operands into reusable scratch so the handler sees a
+  // stable view even if it pushes to or resets the VM stack.
+  const usize consumed = std::min(arity, m_stack.size());
+  const auto first = m_stack.end() - static_cast<std::ptrdiff_t>(consumed);
+  m_callArgs.clear();
+  m_callArgs.insert(m_callArgs.end(), std::make_move_iterator(first),
+                    std::make_move_iterator(m_stack.end()));
+  m_stack.erase(first, m_stack.end());
+
+  NativeCallArgs args;
+  args.opcode = instr.opcode;
+  args.operand = instr.operand;
+  if (stringOperand) {
+    args.text = getString(instr.operand);
+  }
+  args.values = m_callArgs;
+
+  auto invoke = [&]() {
+    if (handler.fn) {
+      handler.fn(handler.context, args);
+    } else {
+      m_callbacks[index](toCallbackArgs(args));
+    }
+  };
+  if (ScriptProfiler *profiler = m_profiler) {
+    // Capture state first: the handler may reload the program or jump
+    const OpCode op = instr.opcode;
+    const u32 ip = m_ip;
+    const auto start = ScriptProfiler::Clock::now();
+    invoke();
+    profiler->recordNativeCall(op, ip, start,
+                               ScriptProfiler::Clock::now());
+  } else {
+    invoke();
+  }
+  m_callArgs.clear();
 }
 
 void VirtualMachine::signalContinue() {
@@ -176,6 +592,25 @@ void VirtualMachine::executeInstruction(const Instruction &instr) {
     }
     break;
 
+  case OpCode::JUMP_IF_NOT_EQ:
+    branchUnless<OpCode::EQ>(instr.operand);
+    break;
+  case OpCode::JUMP_IF_NOT_NE:
+    branchUnless<OpCode::NE>(instr.operand);
+    break;
+  case OpCode::JUMP_IF_NOT_LT:
+    branchUnless<OpCode::LT>(instr.operand);
+    break;
+  case OpCode::JUMP_IF_NOT_LE:
+    branchUnless<OpCode::LE>(instr.operand);
+    break;
+  case OpCode::JUMP_IF_NOT_GT:
+    branchUnless<OpCode::GT>(instr.operand);
+    break;
+  case OpCode::JUMP_IF_NOT_GE:
+    branchUnless<OpCode::GE>(instr.operand);
+    break;
+
   case OpCode::PUSH_INT:
     push(static_cast<i32>(instr.operand));
     break;
@@ -188,7 +623,7 @@ void VirtualMachine::executeInstruction(const Instruction &instr) {
   }
 
   case OpCode::PUSH_STRING:
-    push(getString(instr.operand));
+    push(TaggedValue::interned(&getString(instr.operand)));
     break;
 
   case OpCode::PUSH_BOOL:
@@ -209,209 +644,83 @@ void VirtualMachine::executeInstruction(const Instruction &instr) {
     }
     break;
 
-  case OpCode::LOAD_VAR: {
-    const std::string &name = getString(instr.operand);
-    push(getVariable(name));
-    break;
-  }
-
-  case OpCode::STORE_VAR: {
-    const std::string &name = getString(instr.operand);
-    setVariable(name, pop());
-    break;
-  }
-
-  case OpCode::ADD: {
-    Value b = pop();
-    Value a = pop();
-    if (getValueType(a) == ValueType::String ||
-        getValueType(b) == ValueType::String) {
-      push(asString(a) + asString(b));
-    } else if (getValueType(a) == ValueType::Float ||
-               getValueType(b) == ValueType::Float) {
-      push(asFloat(a) + asFloat(b));
+  case OpCode::LOAD_VAR:
+  case OpCode::LOAD_GLOBAL: {
+    // Operand names a variable slot (see resolveSlots)
+    const u32 slot = m_variableSlots[instr.operand];
+    if (m_variables.defined[slot]) {
+      push(m_variables.values[slot]);
     } else {
-      push(asInt(a) + asInt(b));
+      push(std::monostate{});
     }
     break;
   }
 
-  case OpCode::SUB: {
-    Value b = pop();
-    Value a = pop();
-    if (getValueType(a) == ValueType::Float ||
-        getValueType(b) == ValueType::Float) {
-      push(asFloat(a) - asFloat(b));
-    } else {
-      push(asInt(a) - asInt(b));
-    }
+  case OpCode::STORE_VAR:
+  case OpCode::STORE_GLOBAL: {
+    const u32 slot = m_variableSlots[instr.operand];
+    m_variables.values[slot] = pop();
+    m_variables.defined[slot] = 1;
     break;
   }
 
-  case OpCode::MUL: {
-    Value b = pop();
-    Value a = pop();
-    if (getValueType(a) == ValueType::Float ||
-        getValueType(b) == ValueType::Float) {
-      push(asFloat(a) * asFloat(b));
-    } else {
-      push(asInt(a) * asInt(b));
-    }
+  case OpCode::ADD:
+    applyBinary<OpCode::ADD>();
     break;
-  }
-
-  case OpCode::DIV: {
-    Value b = pop();
-    Value a = pop();
-    f32 divisor = asFloat(b);
-    if (divisor != 0.0f) {
-      push(asFloat(a) / divisor);
-    } else {
-      NOVELMIND_LOG_ERROR("Division by zero");
-      push(0);
-    }
+  case OpCode::SUB:
+    applyBinary<OpCode::SUB>();
     break;
-  }
-
-  case OpCode::EQ: {
-    Value b = pop();
-    Value a = pop();
-    // Type-aware equality comparison
-    ValueType typeA = getValueType(a);
-    ValueType typeB = getValueType(b);
-    if (typeA == ValueType::Null && typeB == ValueType::Null) {
-      push(true);
-    } else if (typeA == ValueType::Null || typeB == ValueType::Null) {
-      push(false);
-    } else if (typeA == ValueType::String || typeB == ValueType::String) {
-      push(asString(a) == asString(b));
-    } else if (typeA == ValueType::Bool && typeB == ValueType::Bool) {
-      push(asBool(a) == asBool(b));
-    } else if (typeA == ValueType::Float || typeB == ValueType::Float) {
-      push(asFloat(a) == asFloat(b));
-    } else {
-      push(asInt(a) == asInt(b));
-    }
+  case OpCode::MUL:
+    applyBinary<OpCode::MUL>();
     break;
-  }
-
-  case OpCode::NE: {
-    Value b = pop();
-    Value a = pop();
-    // Type-aware inequality comparison
-    ValueType typeA = getValueType(a);
-    ValueType typeB = getValueType(b);
-    if (typeA == ValueType::Null && typeB == ValueType::Null) {
-      push(false);
-    } else if (typeA == ValueType::Null || typeB == ValueType::Null) {
-      push(true);
-    } else if (typeA == ValueType::String || typeB == ValueType::String) {
-      push(asString(a) != asString(b));
-    } else if (typeA == ValueType::Bool && typeB == ValueType::Bool) {
-      push(asBool(a) != asBool(b));
-    } else if (typeA == ValueType::Float || typeB == ValueType::Float) {
-      push(asFloat(a) != asFloat(b));
-    } else {
-      push(asInt(a) != asInt(b));
-    }
+  case OpCode::DIV:
+    applyBinary<OpCode::DIV>();
     break;
-  }
-
-  case OpCode::LT: {
-    Value b = pop();
-    Value a = pop();
-    push(asFloat(a) < asFloat(b));
+  case OpCode::MOD:
+    applyBinary<OpCode::MOD>();
     break;
-  }
-
-  case OpCode::LE: {
-    Value b = pop();
-    Value a = pop();
-    push(asFloat(a) <= asFloat(b));
+  case OpCode::EQ:
+    applyBinary<OpCode::EQ>();
     break;
-  }
-
-  case OpCode::GT: {
-    Value b = pop();
-    Value a = pop();
-    push(asFloat(a) > asFloat(b));
+  case OpCode::NE:
+    applyBinary<OpCode::NE>();
     break;
-  }
-
-  case OpCode::GE: {
-    Value b = pop();
-    Value a = pop();
-    push(asFloat(a) >= asFloat(b));
+  case OpCode::LT:
+    applyBinary<OpCode::LT>();
     break;
-  }
-
-  case OpCode::AND: {
-    Value b = pop();
-    Value a = pop();
-    push(asBool(a) && asBool(b));
+  case OpCode::LE:
+    applyBinary<OpCode::LE>();
     break;
-  }
-
-  case OpCode::OR: {
-    Value b = pop();
-    Value a = pop();
-    push(asBool(a) || asBool(b));
+  case OpCode::GT:
+    applyBinary<OpCode::GT>();
     break;
-  }
-
-  case OpCode::NOT: {
-    Value a = pop();
-    push(!asBool(a));
+  case OpCode::GE:
+    applyBinary<OpCode::GE>();
     break;
-  }
-
-  case OpCode::MOD: {
-    Value b = pop();
-    Value a = pop();
-    i32 divisor = asInt(b);
-    if (divisor != 0) {
-      push(asInt(a) % divisor);
-    } else {
-      NOVELMIND_LOG_ERROR("Modulo by zero");
-      push(0);
-    }
+  case OpCode::AND:
+    applyBinary<OpCode::AND>();
     break;
-  }
-
-  case OpCode::NEG: {
-    Value a = pop();
-    if (getValueType(a) == ValueType::Float) {
-      push(-asFloat(a));
-    } else {
-      push(-asInt(a));
-    }
+  case OpCode::OR:
+    applyBinary<OpCode::OR>();
     break;
-  }
 
-  case OpCode::LOAD_GLOBAL: {
-    const std::string &name = getString(instr.operand);
-    push(getVariable(name));
+  case OpCode::NOT:
+    push(!asBool(pop()));
     break;
-  }
 
-  case OpCode::STORE_GLOBAL: {
-    const std::string &name = getString(instr.operand);
-    setVariable(name, pop());
+  case OpCode::NEG:
+    push(negate(pop()));
     break;
-  }
 
   case OpCode::CALL: {
     // CALL opcode: operand is index into string table for function name
     // For now, function calls are handled as native callbacks
-    const std::string &funcName = getString(instr.operand);
-    auto it = m_callbacks.find(OpCode::CALL);
-    if (it != m_callbacks.end()) {
-      std::vector<Value> args;
-      // Function name is passed as the first argument
-      args.push_back(funcName);
-      it->second(args);
+    const auto index = static_cast<usize>(OpCode::CALL);
+    if (m_nativeHandlers[index].fn || m_callbacks[index]) {
+      dispatchNative(instr);
     } else {
-      NOVELMIND_LOG_WARN("No callback registered for CALL opcode, function: " + funcName);
+      NOVELMIND_LOG_WARN("No callback registered for CALL opcode, function: " +
+                         std::string(getString(instr.operand)));
     }
     // Push null as return value for unhandled functions
     push(std::monostate{});
@@ -426,17 +735,15 @@ void VirtualMachine::executeInstruction(const Instruction &instr) {
   }
 
   case OpCode::SET_FLAG: {
-    bool value = asBool(pop());
-    const std::string &name = getString(instr.operand);
-    setFlag(name, value);
+    const u32 slot = m_flagSlots[instr.operand];
+    m_flags.values[slot] = asBool(pop()) ? 1 : 0;
+    m_flags.defined[slot] = 1;
     break;
   }
 
-  case OpCode::CHECK_FLAG: {
-    const std::string &name = getString(instr.operand);
-    push(getFlag(name));
+  case OpCode::CHECK_FLAG:
+    push(m_flags.values[m_flagSlots[instr.operand]] != 0);
     break;
-  }
 
   case OpCode::SAY:
   case OpCode::SHOW_BACKGROUND:
@@ -449,84 +756,7 @@ void VirtualMachine::executeInstruction(const Instruction &instr) {
   case OpCode::WAIT:
   case OpCode::TRANSITION:
   case OpCode::GOTO_SCENE: {
-    auto it = m_callbacks.find(instr.opcode);
-    if (it != m_callbacks.end()) {
-      std::vector<Value> args;
-      auto popArg = [&]() -> Value {
-        if (m_stack.empty()) {
-          return std::monostate{};
-        }
-        Value val = std::move(m_stack.back());
-        m_stack.pop_back();
-        return val;
-      };
-      switch (instr.opcode) {
-      case OpCode::SHOW_BACKGROUND:
-        args.emplace_back(getString(instr.operand));
-        break;
-      case OpCode::SHOW_CHARACTER: {
-        Value posVal = popArg();
-        Value idVal = popArg();
-        if (std::holds_alternative<std::monostate>(idVal)) {
-          idVal = getString(instr.operand);
-        }
-        if (std::holds_alternative<std::monostate>(posVal)) {
-          posVal = static_cast<i32>(1);
-        }
-        args.push_back(std::move(idVal));
-        args.push_back(std::move(posVal));
-        break;
-      }
-      case OpCode::HIDE_CHARACTER:
-        args.emplace_back(getString(instr.operand));
-        break;
-      case OpCode::SAY: {
-        Value speakerVal = popArg();
-        args.emplace_back(getString(instr.operand));
-        args.push_back(std::move(speakerVal));
-        break;
-      }
-      case OpCode::CHOICE: {
-        const u32 count = instr.operand;
-        std::vector<Value> choices;
-        choices.reserve(count);
-        for (u32 i = 0; i < count; ++i) {
-          choices.push_back(popArg());
-        }
-        popArg(); // discard pushed count if present
-        std::reverse(choices.begin(), choices.end());
-        args.emplace_back(static_cast<i32>(count));
-        for (auto &choice : choices) {
-          args.push_back(std::move(choice));
-        }
-        break;
-      }
-      case OpCode::WAIT:
-        args.emplace_back(static_cast<i32>(instr.operand));
-        break;
-      case OpCode::TRANSITION: {
-        Value durVal = popArg();
-        args.emplace_back(getString(instr.operand));
-        args.push_back(std::move(durVal));
-        break;
-      }
-      case OpCode::PLAY_SOUND:
-      case OpCode::PLAY_MUSIC:
-        args.emplace_back(getString(instr.operand));
-        break;
-      case OpCode::STOP_MUSIC:
-        if (!m_stack.empty()) {
-          args.push_back(popArg());
-        }
-        break;
-      case OpCode::GOTO_SCENE:
-        args.emplace_back(static_cast<i32>(instr.operand));
-        break;
-      default:
-        break;
-      }
-      it->second(args);
-    }
+    dispatchNative(instr);
 
     // These commands typically wait for user input or cause execution to pause
     if (instr.opcode == OpCode::SAY || instr.opcode == OpCode::CHOICE ||
@@ -547,22 +777,24 @@ void VirtualMachine::executeInstruction(const Instruction &instr) {
   }
 }
 
-void VirtualMachine::push(Value value) { m_stack.push_back(std::move(value)); }
+void VirtualMachine::push(TaggedValue value) {
+  m_stack.push_back(std::move(value));
+}
 
-Value VirtualMachine::pop() {
+TaggedValue VirtualMachine::pop() {
   if (m_stack.empty()) {
     NOVELMIND_LOG_WARN("Stack underflow");
-    return std::monostate{};
+    return {};
   }
-  Value val = std::move(m_stack.back());
+  TaggedValue val = std::move(m_stack.back());
   m_stack.pop_back();
   return val;
 }
 
-const std::string &VirtualMachine::getString(u32 index) const {
-  static const std::string empty;
-  if (index < m_stringTable.size()) {
-    return m_stringTable[index];
+const std::string_view &VirtualMachine::getString(u32 index) const {
+  static const std::string_view empty;
+  if (index < m_strings.size()) {
+    return m_strings[index];
   }
   NOVELMIND_LOG_WARN("Invalid string index");
   return empty;
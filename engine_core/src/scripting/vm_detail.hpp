@@ -0,0 +1,110 @@
+#pragma once
+
+// Operator semantics shared by the VM dispatch engines and the bytecode
+// optimizer's constant folder, so folding can never disagree with runtime.
+
+#include "NovelMind/core/logger.hpp"
+#include "NovelMind/scripting/opcode.hpp"
+#include "NovelMind/scripting/tagged_value.hpp"
+#include <string>
+
+namespace NovelMind::scripting::detail {
+
+// Type-aware equality shared by EQ and NE
+inline bool valuesEqual(const TaggedValue &a, const TaggedValue &b) {
+  ValueType typeA = getValueType(a);
+  ValueType typeB = getValueType(b);
+  if (typeA == ValueType::Null || typeB == ValueType::Null) {
+    return typeA == typeB;
+  }
+  if (typeA == ValueType::String || typeB == ValueType::String) {
+    if (a.isString() && b.isString()) {
+      return a.stringView() == b.stringView();
+    }
+    return asString(a) == asString(b);
+  }
+  if (typeA == ValueType::Bool && typeB == ValueType::Bool) {
+    return asBool(a) == asBool(b);
+  }
+  if (typeA == ValueType::Float || typeB == ValueType::Float) {
+    return asFloat(a) == asFloat(b);
+  }
+  return asInt(a) == asInt(b);
+}
+
+inline bool eitherFloat(const TaggedValue &a, const TaggedValue &b) {
+  return getValueType(a) == ValueType::Float ||
+         getValueType(b) == ValueType::Float;
+}
+
+/**
+ * @brief Binary operator semantics, shared by every dispatch engine
+ */
+template <OpCode Op>
+TaggedValue evalBinary(const TaggedValue &a, const TaggedValue &b) {
+  if constexpr (Op == OpCode::ADD) {
+    if (a.isString() && b.isString()) {
+      std::string joined;
+      joined.reserve(a.stringView().size() + b.stringView().size());
+      joined.append(a.stringView()).append(b.stringView());
+      return joined;
+    }
+    if (a.isString() || b.isString()) {
+      return asString(a) + asString(b);
+    }
+    if (eitherFloat(a, b)) {
+      return asFloat(a) + asFloat(b);
+    }
+    return asInt(a) + asInt(b);
+  } else if constexpr (Op == OpCode::SUB) {
+    if (eitherFloat(a, b)) {
+      return asFloat(a) - asFloat(b);
+    }
+    return asInt(a) - asInt(b);
+  } else if constexpr (Op == OpCode::MUL) {
+    if (eitherFloat(a, b)) {
+      return asFloat(a) * asFloat(b);
+    }
+    return asInt(a) * asInt(b);
+  } else if constexpr (Op == OpCode::DIV) {
+    f32 divisor = asFloat(b);
+    if (divisor != 0.0f) {
+      return asFloat(a) / divisor;
+    }
+    NOVELMIND_LOG_ERROR("Division by zero");
+    return 0;
+  } else if constexpr (Op == OpCode::MOD) {
+    i32 divisor = asInt(b);
+    if (divisor != 0) {
+      return asInt(a) % divisor;
+    }
+    NOVELMIND_LOG_ERROR("Modulo by zero");
+    return 0;
+  } else if constexpr (Op == OpCode::EQ) {
+    return valuesEqual(a, b);
+  } else if constexpr (Op == OpCode::NE) {
+    return !valuesEqual(a, b);
+  } else if constexpr (Op == OpCode::LT) {
+    return asFloat(a) < asFloat(b);
+  } else if constexpr (Op == OpCode::LE) {
+    return asFloat(a) <= asFloat(b);
+  } else if constexpr (Op == OpCode::GT) {
+    return asFloat(a) > asFloat(b);
+  } else if constexpr (Op == OpCode::GE) {
+    return asFloat(a) >= asFloat(b);
+  } else if constexpr (Op == OpCode::AND) {
+    return asBool(a) && asBool(b);
+  } else {
+    static_assert(Op == OpCode::OR, "Unsupported binary opcode");
+    return asBool(a) || asBool(b);
+  }
+}
+
+inline TaggedValue negate(const TaggedValue &a) {
+  if (getValueType(a) == ValueType::Float) {
+    return -asFloat(a);
+  }
+  return -asInt(a);
+}
+
+} // namespace NovelMind::scripting::detail
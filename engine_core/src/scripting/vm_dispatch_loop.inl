@@ -0,0 +1,255 @@
+// Body of the threaded dispatch engine, included by vm.cpp once per loop
+// flavour. The includer defines:
+//   NOVELMIND_VM_LOOP_NAME  member function to define
+//   NOVELMIND_VM_LOOP_GOTO  1 for direct-threaded code (computed goto),
+//                           0 for the portable switch loop
+// Both flavours execute identical handler bodies, so they differ only in
+// how the next handler is reached.
+
+u64 VirtualMachine::NOVELMIND_VM_LOOP_NAME(u64 budget, bool yieldOnSlow) {
+  if (budget == 0) {
+    budget = ~u64{0};
+  }
+  const u64 initialBudget = budget;
+
+  while (m_running && !m_halted && !m_paused && !m_waiting) {
+    const u32 size = static_cast<u32>(m_program.size());
+    if (m_ip >= size) {
+      m_halted = true;
+      break;
+    }
+
+    const u32 version = m_programVersion;
+    const Instruction *code = m_program.data();
+    u32 ip = m_ip;
+    auto jumpTarget = [size](u32 operand) {
+      return operand < size ? operand : size;
+    };
+
+#if NOVELMIND_VM_LOOP_GOTO
+    if (m_threadedVersion != version || m_threadedCode.size() != size + 1) {
+      m_threadedCode.resize(size + 1);
+      for (u32 i = 0; i < size; ++i) {
+        const void *handler = &&op_SLOW;
+        switch (code[i].opcode) {
+#define NOVELMIND_VM_LABEL(name)                                               \
+  case OpCode::name:                                                           \
+    handler = &&op_##name;                                                     \
+    break;
+          NOVELMIND_VM_INLINE_OPS(NOVELMIND_VM_LABEL)
+#undef NOVELMIND_VM_LABEL
+        default:
+          break;
+        }
+        m_threadedCode[i] = handler;
+      }
+      m_threadedCode[size] = &&op_END;
+      m_threadedVersion = version;
+    }
+    const void *const *handlers = m_threadedCode.data();
+
+#define VM_OP(name) op_##name:
+#define VM_SLOW op_SLOW:
+#define VM_DISPATCH() goto *handlers[ip]
+#define VM_NEXT()                                                              \
+  if (--budget == 0) {                                                         \
+    goto out_of_budget;                                                        \
+  }                                                                            \
+  goto *handlers[ip]
+
+    VM_DISPATCH();
+#else
+#define VM_OP(name) case OpCode::name:
+#define VM_SLOW default:
+#define VM_NEXT()                                                              \
+  if (--budget == 0) {                                                         \
+    goto out_of_budget;                                                        \
+  }                                                                            \
+  continue
+
+    for (;;) {
+      if (ip >= size) {
+        goto op_END;
+      }
+      switch (code[ip].opcode) {
+#endif
+
+    VM_OP(NOP) {
+      ++ip;
+      VM_NEXT();
+    }
+    VM_OP(JUMP) {
+      ip = jumpTarget(code[ip].operand);
+      VM_NEXT();
+    }
+    VM_OP(JUMP_IF) {
+      ip = asBool(pop()) ? jumpTarget(code[ip].operand) : ip + 1;
+      VM_NEXT();
+    }
+    VM_OP(JUMP_IF_NOT) {
+      ip = asBool(pop()) ? ip + 1 : jumpTarget(code[ip].operand);
+      VM_NEXT();
+    }
+    VM_OP(PUSH_INT) {
+      push(static_cast<i32>(code[ip].operand));
+      ++ip;
+      VM_NEXT();
+    }
+    VM_OP(PUSH_FLOAT) {
+      f32 val;
+      std::memcpy(&val, &code[ip].operand, sizeof(f32));
+      push(val);
+      ++ip;
+      VM_NEXT();
+    }
+    VM_OP(PUSH_STRING) {
+      push(TaggedValue::interned(&getString(code[ip].operand)));
+      ++ip;
+      VM_NEXT();
+    }
+    VM_OP(PUSH_BOOL) {
+      push(code[ip].operand != 0);
+      ++ip;
+      VM_NEXT();
+    }
+    VM_OP(PUSH_NULL) {
+      push(TaggedValue{});
+      ++ip;
+      VM_NEXT();
+    }
+    VM_OP(POP) {
+      pop();
+      ++ip;
+      VM_NEXT();
+    }
+    VM_OP(DUP) {
+      if (!m_stack.empty()) {
+        push(m_stack.back());
+      }
+      ++ip;
+      VM_NEXT();
+    }
+    VM_OP(LOAD_VAR)
+    VM_OP(LOAD_GLOBAL) {
+      const u32 slot = m_variableSlots[code[ip].operand];
+      push(m_variables.defined[slot] ? m_variables.values[slot]
+                                     : TaggedValue{});
+      ++ip;
+      VM_NEXT();
+    }
+    VM_OP(STORE_VAR)
+    VM_OP(STORE_GLOBAL) {
+      const u32 slot = m_variableSlots[code[ip].operand];
+      m_variables.values[slot] = pop();
+      m_variables.defined[slot] = 1;
+      ++ip;
+      VM_NEXT();
+    }
+    VM_OP(SET_FLAG) {
+      const u32 slot = m_flagSlots[code[ip].operand];
+      m_flags.values[slot] = asBool(pop()) ? 1 : 0;
+      m_flags.defined[slot] = 1;
+      ++ip;
+      VM_NEXT();
+    }
+    VM_OP(CHECK_FLAG) {
+      push(m_flags.values[m_flagSlots[code[ip].operand]] != 0);
+      ++ip;
+      VM_NEXT();
+    }
+    VM_OP(NOT) {
+      push(!asBool(pop()));
+      ++ip;
+      VM_NEXT();
+    }
+    VM_OP(NEG) {
+      push(negate(pop()));
+      ++ip;
+      VM_NEXT();
+    }
+
+#define NOVELMIND_VM_BINARY(name)                                              \
+  VM_OP(name) {                                                                \
+    applyBinary<OpCode::name>();                                               \
+    ++ip;                                                                      \
+    VM_NEXT();                                                                 \
+  }
+    NOVELMIND_VM_BINARY(ADD)
+    NOVELMIND_VM_BINARY(SUB)
+    NOVELMIND_VM_BINARY(MUL)
+    NOVELMIND_VM_BINARY(DIV)
+    NOVELMIND_VM_BINARY(MOD)
+    NOVELMIND_VM_BINARY(EQ)
+    NOVELMIND_VM_BINARY(NE)
+    NOVELMIND_VM_BINARY(LT)
+    NOVELMIND_VM_BINARY(LE)
+    NOVELMIND_VM_BINARY(GT)
+    NOVELMIND_VM_BINARY(GE)
+    NOVELMIND_VM_BINARY(AND)
+    NOVELMIND_VM_BINARY(OR)
+#undef NOVELMIND_VM_BINARY
+
+#define NOVELMIND_VM_FUSED_BRANCH(name, cmp)                                   \
+  VM_OP(name) {                                                                \
+    ip = compareTop<OpCode::cmp>() ? ip + 1 : jumpTarget(code[ip].operand);    \
+    VM_NEXT();                                                                 \
+  }
+    NOVELMIND_VM_FUSED_BRANCH(JUMP_IF_NOT_EQ, EQ)
+    NOVELMIND_VM_FUSED_BRANCH(JUMP_IF_NOT_NE, NE)
+    NOVELMIND_VM_FUSED_BRANCH(JUMP_IF_NOT_LT, LT)
+    NOVELMIND_VM_FUSED_BRANCH(JUMP_IF_NOT_LE, LE)
+    NOVELMIND_VM_FUSED_BRANCH(JUMP_IF_NOT_GT, GT)
+    NOVELMIND_VM_FUSED_BRANCH(JUMP_IF_NOT_GE, GE)
+#undef NOVELMIND_VM_FUSED_BRANCH
+
+    VM_SLOW {
+      // Yielding/native opcodes keep step() semantics exactly, including
+      // callbacks that reload the program or move the IP.
+      m_ip = ip;
+      executeInstruction(code[ip]);
+      ++m_ip;
+      --budget;
+      if (yieldOnSlow) {
+        return initialBudget - budget;
+      }
+      if (m_programVersion != version || !m_running || m_halted ||
+          m_paused || m_waiting || m_ip >= size) {
+        goto yield;
+      }
+      if (budget == 0) {
+        return initialBudget;
+      }
+      ip = m_ip;
+#if NOVELMIND_VM_LOOP_GOTO
+      VM_DISPATCH();
+#else
+      continue;
+#endif
+    }
+
+#if !NOVELMIND_VM_LOOP_GOTO
+      }
+    }
+#endif
+
+#undef VM_OP
+#undef VM_SLOW
+#undef VM_DISPATCH
+#undef VM_NEXT
+
+  op_END:
+    m_ip = ip;
+    m_halted = true;
+    break;
+
+  out_of_budget:
+    m_ip = ip;
+    return initialBudget;
+
+  yield:;
+  }
+  return initialBudget - budget;
+}
+
+#undef NOVELMIND_VM_LOOP_NAME
+#undef NOVELMIND_VM_LOOP_GOTO
@@ -0,0 +1,453 @@
+#include "NovelMind/vfs/batch_file_reader.hpp"
+#include "NovelMind/core/logger.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <thread>
+#include <unordered_map>
+
+#if defined(_WIN32)
+#include <filesystem>
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define NOVELMIND_HAS_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+namespace NovelMind::VFS {
+
+namespace {
+
+// One request's destination and progress
+struct ReadState {
+  const std::string *path = nullptr;
+  int fd = -1;
+  u64 offset = 0;
+  usize size = 0; // Bytes wanted, after clamping to the file
+  usize done = 0;
+  std::shared_ptr<u8[]> data;
+  std::string error;
+};
+
+template <typename Fn> void parallelFor(usize count, unsigned jobs, Fn &&fn) {
+  const usize workers = std::min<usize>(jobs, count);
+  if (workers <= 1) {
+    for (usize i = 0; i < count; ++i) {
+      fn(i);
+    }
+    return;
+  }
+
+  std::atomic<usize> next{0};
+  auto worker = [&]() {
+    for (usize i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+      fn(i);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(workers - 1);
+  for (usize t = 1; t < workers; ++t) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+usize clampedSize(const BatchReadRequest &request, u64 fileSize) {
+  const u64 available =
+      request.offset < fileSize ? fileSize - request.offset : 0;
+  return request.size.has_value()
+             ? static_cast<usize>(std::min<u64>(*request.size, available))
+             : static_cast<usize>(available);
+}
+
+#if defined(_WIN32)
+
+// No pread here: each request opens its own stream when it is read
+std::vector<ReadState> prepare(std::span<const BatchReadRequest> requests,
+                               std::vector<int> &) {
+  std::vector<ReadState> states(requests.size());
+  for (usize i = 0; i < requests.size(); ++i) {
+    states[i].path = &requests[i].path;
+    std::error_code ec;
+    const auto fileSize = std::filesystem::file_size(requests[i].path, ec);
+    if (ec) {
+      states[i].error = "Cannot open file: " + requests[i].path;
+      continue;
+    }
+    states[i].offset = requests[i].offset;
+    states[i].size = clampedSize(requests[i], fileSize);
+    states[i].data = std::make_shared_for_overwrite<u8[]>(states[i].size);
+  }
+  return states;
+}
+
+void readBlocking(ReadState &state) {
+  std::ifstream file(*state.path, std::ios::binary);
+  file.seekg(static_cast<std::streamoff>(state.offset));
+  file.read(reinterpret_cast<char *>(state.data.get()),
+            static_cast<std::streamsize>(state.size));
+  if (file.bad()) {
+    state.error = "Failed to read file: " + *state.path;
+    return;
+  }
+  state.done = static_cast<usize>(file.gcount());
+}
+
+void closeAll(std::vector<int> &) {}
+
+#else
+
+// Opens each distinct path once and sizes every destination buffer
+std::vector<ReadState> prepare(std::span<const BatchReadRequest> requests,
+                               std::vector<int> &fds) {
+  std::vector<ReadState> states(requests.size());
+  std::unordered_map<std::string, std::pair<int, u64>> files;
+
+  for (usize i = 0; i < requests.size(); ++i) {
+    const auto &request = requests[i];
+    auto it = files.find(request.path);
+    if (it == files.end()) {
+      std::pair<int, u64> file{-1, 0};
+      const int fd = ::open(request.path.c_str(), O_RDONLY | O_CLOEXEC);
+      struct stat st {};
+      if (fd >= 0 && ::fstat(fd, &st) == 0) {
+        fds.push_back(fd);
+        file = {fd, static_cast<u64>(st.st_size)};
+      } else if (fd >= 0) {
+        ::close(fd);
+      }
+      it = files.emplace(request.path, file).first;
+    }
+
+    auto &state = states[i];
+    state.path = &request.path;
+    const auto [fd, fileSize] = it->second;
+    if (fd < 0) {
+      state.error = "Cannot open file: " + request.path;
+      continue;
+    }
+    state.fd = fd;
+    state.offset = request.offset;
+    state.size = clampedSize(request, fileSize);
+    state.data = std::make_shared_for_overwrite<u8[]>(state.size);
+  }
+  return states;
+}
+
+void readBlocking(ReadState &state) {
+  while (state.done < state.size) {
+    const auto n = ::pread(state.fd, state.data.get() + state.done,
+                           state.size - state.done,
+                           static_cast<off_t>(state.offset + state.done));
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      state.error = "Failed to read file: " + *state.path + " (" +
+                    std::strerror(errno) + ")";
+      return;
+    }
+    if (n == 0) {
+      break; // File shrank since it was sized
+    }
+    state.done += static_cast<usize>(n);
+  }
+}
+
+void closeAll(std::vector<int> &fds) {
+  for (const int fd : fds) {
+    ::close(fd);
+  }
+  fds.clear();
+}
+
+#endif
+
+} // namespace
+
+#if defined(NOVELMIND_HAS_IO_URING)
+
+// Minimal io_uring: raw syscalls over the mapped rings, no liburing
+struct BatchFileReader::Ring {
+  int fd = -1;
+  void *sq = nullptr;
+  usize sqSize = 0;
+  void *cq = nullptr;
+  usize cqSize = 0;
+  io_uring_sqe *sqes = nullptr;
+  usize sqesSize = 0;
+
+  unsigned *sqHead = nullptr;
+  unsigned *sqTail = nullptr;
+  unsigned sqMask = 0;
+  unsigned *sqArray = nullptr;
+  unsigned *cqHead = nullptr;
+  unsigned *cqTail = nullptr;
+  unsigned cqMask = 0;
+  io_uring_cqe *cqes = nullptr;
+  unsigned entries = 0;
+
+  Ring() = default;
+  Ring(const Ring &) = delete;
+  Ring &operator=(const Ring &) = delete;
+
+  ~Ring() {
+    if (sqes) {
+      ::munmap(sqes, sqesSize);
+    }
+    if (cq && cq != sq) {
+      ::munmap(cq, cqSize);
+    }
+    if (sq) {
+      ::munmap(sq, sqSize);
+    }
+    if (fd >= 0) {
+      ::close(fd);
+    }
+  }
+
+  static std::unique_ptr<Ring> create(unsigned depth) {
+    io_uring_params params{};
+    const auto ringFd = static_cast<int>(
+        ::syscall(__NR_io_uring_setup, std::max(depth, 1u), &params));
+    if (ringFd < 0) {
+      return nullptr;
+    }
+
+    auto ring = std::make_unique<Ring>();
+    ring->fd = ringFd;
+    ring->entries = params.sq_entries;
+    ring->sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cqSize =
+        params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMap) {
+      ring->sqSize = ring->cqSize = std::max(ring->sqSize, ring->cqSize);
+    }
+
+    const auto map = [ringFd](usize size, off_t offset) -> void * {
+      void *ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, ringFd, offset);
+      return ptr == MAP_FAILED ? nullptr : ptr;
+    };
+    ring->sq = map(ring->sqSize, IORING_OFF_SQ_RING);
+    if (!ring->sq) {
+      return nullptr;
+    }
+    ring->cq = singleMap ? ring->sq : map(ring->cqSize, IORING_OFF_CQ_RING);
+    ring->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    ring->sqes = static_cast<io_uring_sqe *>(
+        map(ring->sqesSize, IORING_OFF_SQES));
+    if (!ring->cq || !ring->sqes) {
+      return nullptr;
+    }
+
+    auto *sq = static_cast<u8 *>(ring->sq);
+    auto *cq = static_cast<u8 *>(ring->cq);
+    ring->sqHead = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+    ring->sqTail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    ring->sqMask = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    ring->sqArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    ring->cqHead = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    ring->cqTail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    ring->cqMask = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    ring->cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+    return ring;
+  }
+
+  /**
+   * Reads every pending state, resubmitting short reads. Returns false if
+   * the ring itself failed; reads already submitted are still waited for,
+   * so none targets the iovecs or buffers after this returns.
+   */
+  bool run(std::vector<ReadState> &states) {
+    std::deque<usize> pending;
+    for (usize i = 0; i < states.size(); ++i) {
+      if (states[i].error.empty() && states[i].size > 0) {
+        pending.push_back(i);
+      }
+    }
+    std::vector<iovec> iovecs(states.size());
+    unsigned inFlight = 0;
+
+    while (!pending.empty() || inFlight > 0) {
+      unsigned tail = *sqTail;
+      const unsigned head = std::atomic_ref(*sqHead).load(
+          std::memory_order_acquire);
+      while (!pending.empty() && inFlight < entries &&
+             tail - head < entries) {
+        const usize index = pending.front();
+        pending.pop_front();
+        auto &state = states[index];
+        iovecs[index].iov_base = state.data.get() + state.done;
+        iovecs[index].iov_len = state.size - state.done;
+
+        const unsigned slot = tail & sqMask;
+        io_uring_sqe &sqe = sqes[slot];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_READV;
+        sqe.fd = state.fd;
+        sqe.addr = reinterpret_cast<u64>(&iovecs[index]);
+        sqe.len = 1;
+        sqe.off = state.offset + state.done;
+        sqe.user_data = index;
+        sqArray[slot] = slot;
+        ++tail;
+        ++inFlight;
+      }
+      std::atomic_ref(*sqTail).store(tail, std::memory_order_release);
+
+      const unsigned toSubmit =
+          tail - std::atomic_ref(*sqHead).load(std::memory_order_acquire);
+      if (!enter(toSubmit)) {
+        // Entries the kernel never took will not complete; withdraw them
+        const unsigned taken =
+            std::atomic_ref(*sqHead).load(std::memory_order_acquire);
+        inFlight -= tail - taken;
+        std::atomic_ref(*sqTail).store(taken, std::memory_order_release);
+        drain(states, inFlight);
+        return false;
+      }
+      reap(states, pending, inFlight);
+    }
+    return true;
+  }
+
+private:
+  bool enter(unsigned toSubmit) {
+    const auto entered = ::syscall(__NR_io_uring_enter, fd, toSubmit, 1u,
+                                   IORING_ENTER_GETEVENTS, nullptr, 0);
+    return entered >= 0 || errno == EINTR || errno == EAGAIN ||
+           errno == EBUSY;
+  }
+
+  // Consumes the completion queue; returns how many entries it held
+  unsigned reap(std::vector<ReadState> &states, std::deque<usize> &pending,
+                unsigned &inFlight) {
+    unsigned cqIndex = *cqHead;
+    const unsigned cqStart = cqIndex;
+    const unsigned cqEnd =
+        std::atomic_ref(*cqTail).load(std::memory_order_acquire);
+    for (; cqIndex != cqEnd; ++cqIndex) {
+      const io_uring_cqe &cqe = cqes[cqIndex & cqMask];
+      const auto index = static_cast<usize>(cqe.user_data);
+      auto &state = states[index];
+      --inFlight;
+      if (cqe.res == -EINTR || cqe.res == -EAGAIN) {
+        pending.push_back(index);
+      } else if (cqe.res < 0) {
+        state.error = "Failed to read file: " + *state.path + " (" +
+                      std::strerror(-cqe.res) + ")";
+      } else if (cqe.res == 0) {
+        state.size = state.done; // File shrank since it was sized
+      } else {
+        state.done += static_cast<usize>(cqe.res);
+        if (state.done < state.size) {
+          pending.push_back(index);
+        }
+      }
+    }
+    std::atomic_ref(*cqHead).store(cqIndex, std::memory_order_release);
+    return cqIndex - cqStart;
+  }
+
+  // After a failed enter: wait out every submitted read. Completions still
+  // land in the mapped queue even when waiting through the syscall fails,
+  // so fall back to polling it. Unfinished states are left for pread.
+  void drain(std::vector<ReadState> &states, unsigned &inFlight) {
+    std::deque<usize> retry;
+    while (inFlight > 0) {
+      const bool waited = enter(0);
+      if (reap(states, retry, inFlight) == 0 && !waited) {
+        std::this_thread::yield();
+      }
+    }
+  }
+};
+
+#else
+
+struct BatchFileReader::Ring {
+  static std::unique_ptr<Ring> create(unsigned) { return nullptr; }
+  bool run(std::vector<ReadState> &) { return false; }
+};
+
+#endif
+
+BatchFileReader::BatchFileReader(BatchReadConfig config)
+    : m_config(config) {
+  if (m_config.engine != BatchReadEngine::ThreadPool) {
+    m_ring = Ring::create(m_config.queueDepth);
+  }
+  if (m_ring) {
+    m_engine = BatchReadEngine::IoUring;
+  } else if (m_config.engine == BatchReadEngine::IoUring) {
+    NOVELMIND_LOG_WARN("io_uring unavailable, batched reads use pread");
+  }
+}
+
+BatchFileReader::~BatchFileReader() = default;
+
+bool BatchFileReader::ioUringAvailable() {
+  static const bool available = Ring::create(1) != nullptr;
+  return available;
+}
+
+std::vector<Result<SharedBuffer>>
+BatchFileReader::read(std::span<const BatchReadRequest> requests) {
+  std::vector<int> fds;
+  auto states = prepare(requests, fds);
+
+  bool viaRing = false;
+  {
+    std::lock_guard<std::mutex> lock(m_ringMutex);
+    if (m_ring) {
+      viaRing = m_ring->run(states);
+      if (!viaRing) {
+        NOVELMIND_LOG_WARN("io_uring failed, batched reads use pread");
+        m_ring.reset();
+        m_engine.store(BatchReadEngine::ThreadPool);
+      }
+    }
+  }
+  if (!viaRing) {
+    parallelFor(states.size(), std::max(m_config.threads, 1u),
+                [&](usize i) {
+                  if (states[i].error.empty() &&
+                      states[i].done < states[i].size) {
+                    readBlocking(states[i]);
+                  }
+                });
+  }
+  closeAll(fds);
+
+  std::vector<Result<SharedBuffer>> results;
+  results.reserve(states.size());
+  for (auto &state : states) {
+    if (!state.error.empty()) {
+      results.push_back(Result<SharedBuffer>::error(std::move(state.error)));
+      continue;
+    }
+    const std::span<const u8> bytes(state.data.get(), state.done);
+    results.push_back(
+        Result<SharedBuffer>::ok(SharedBuffer(std::move(state.data), bytes)));
+  }
+  return results;
+}
+
+} // namespace NovelMind::VFS
@@ -1,10 +1,22 @@
 #include "NovelMind/vfs/cached_file_system.hpp"
+#include <algorithm>
+#include <chrono>
+#include <limits>
 
 namespace NovelMind::vfs {
 
+namespace {
+
+usize budgetOf(usize maxBytes) {
+  return maxBytes == 0 ? std::numeric_limits<usize>::max() : maxBytes;
+}
+
+} // namespace
+
 CachedFileSystem::CachedFileSystem(std::unique_ptr<IVirtualFileSystem> inner,
-                                   usize maxBytes)
-    : m_maxBytes(maxBytes), m_inner(std::move(inner)) {}
+                                   usize maxBytes, VFS::CachePolicy policy)
+    : m_cache(VFS::ResourceCacheConfig{budgetOf(maxBytes), 16, policy}),
+      m_inner(std::move(inner)) {}
 
 Result<void> CachedFileSystem::mount(const std::string &packPath) {
   if (m_inner) {
@@ -29,35 +41,39 @@ void CachedFileSystem::unmountAll() {
 
 Result<std::vector<u8>>
 CachedFileSystem::readFile(const std::string &resourceId) const {
-  auto it = m_cache.find(resourceId);
-  if (it != m_cache.end()) {
-    touch(resourceId);
-    return Result<std::vector<u8>>::ok(it->second.first.data);
+  auto result = readShared(resourceId);
+  if (result.isError()) {
+    return Result<std::vector<u8>>::error(result.error());
+  }
+  return Result<std::vector<u8>>::ok(result.value().toVector());
+}
+
+Result<SharedBuffer>
+CachedFileSystem::readShared(const std::string &resourceId) const {
+  const VFS::ResourceId key(resourceId);
+  if (auto cached = m_cache.getShared(key)) {
+    return Result<SharedBuffer>::ok(std::move(*cached));
   }
 
   if (!m_inner) {
-    return Result<std::vector<u8>>::error("CachedFileSystem has no inner FS");
+    return Result<SharedBuffer>::error("CachedFileSystem has no inner FS");
   }
 
-  auto result = m_inner->readFile(resourceId);
+  const auto start = std::chrono::steady_clock::now();
+  auto result = m_inner->readShared(resourceId);
   if (result.isError()) {
     return result;
   }
+  const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
 
-  CacheEntry entry;
-  entry.data = result.value();
-  entry.size = entry.data.size();
-
-  m_lru.push_front(resourceId);
-  m_cache[resourceId] = {entry, m_lru.begin()};
-  m_currentBytes += entry.size;
-  evictIfNeeded();
-
-  return Result<std::vector<u8>>::ok(std::move(entry.data));
+  m_cache.put(key, result.value(), static_cast<u64>(std::max<i64>(micros, 1)));
+  return result;
 }
 
 bool CachedFileSystem::exists(const std::string &resourceId) const {
-  if (m_cache.find(resourceId) != m_cache.end()) {
+  if (m_cache.contains(VFS::ResourceId(resourceId))) {
     return true;
   }
   return m_inner ? m_inner->exists(resourceId) : false;
@@ -80,40 +96,19 @@ CachedFileSystem::listResources(ResourceType type) const {
 }
 
 void CachedFileSystem::setMaxBytes(usize maxBytes) {
-  m_maxBytes = maxBytes;
-  evictIfNeeded();
-}
-
-void CachedFileSystem::clearCache() {
-  m_cache.clear();
-  m_lru.clear();
-  m_currentBytes = 0;
+  m_cache.setMaxSize(budgetOf(maxBytes));
 }
 
-void CachedFileSystem::touch(const std::string &resourceId) const {
-  auto it = m_cache.find(resourceId);
-  if (it == m_cache.end()) {
-    return;
-  }
+void CachedFileSystem::clearCache() { m_cache.clear(); }
 
-  m_lru.erase(it->second.second);
-  m_lru.push_front(resourceId);
-  it->second.second = m_lru.begin();
+bool CachedFileSystem::pin(const std::string &resourceId) {
+  return m_cache.pin(VFS::ResourceId(resourceId));
 }
 
-void CachedFileSystem::evictIfNeeded() const {
-  if (m_maxBytes == 0) {
-    return;
-  }
-  while (m_currentBytes > m_maxBytes && !m_lru.empty()) {
-    const std::string &key = m_lru.back();
-    auto it = m_cache.find(key);
-    if (it != m_cache.end()) {
-      m_currentBytes -= it->second.first.size;
-      m_cache.erase(it);
-    }
-    m_lru.pop_back();
-  }
+void CachedFileSystem::unpin(const std::string &resourceId) {
+  m_cache.unpin(VFS::ResourceId(resourceId));
 }
 
+VFS::CacheStats CachedFileSystem::cacheStats() const { return m_cache.stats(); }
+
 } // namespace NovelMind::vfs
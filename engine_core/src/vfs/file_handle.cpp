@@ -107,4 +107,80 @@ Result<void> MemoryFileHandle::seek(i64 offset, SeekOrigin origin) {
   return Result<void>::ok();
 }
 
+DiskFileHandle::DiskFileHandle(const std::string &path)
+    : m_file(path, std::ios::binary | std::ios::ate) {
+  if (m_file.is_open()) {
+    const auto end = m_file.tellg();
+    m_size = end > 0 ? static_cast<usize>(end) : 0;
+    m_file.seekg(0, std::ios::beg);
+  }
+}
+
+bool DiskFileHandle::isValid() const { return m_file.is_open(); }
+
+usize DiskFileHandle::size() const { return m_size; }
+
+usize DiskFileHandle::position() const { return m_position; }
+
+bool DiskFileHandle::isEof() const { return m_position >= m_size; }
+
+Result<usize> DiskFileHandle::read(u8 *buffer, usize count) {
+  if (!isValid()) {
+    return Result<usize>::error("Invalid file handle");
+  }
+
+  if (buffer == nullptr) {
+    return Result<usize>::error("Null buffer");
+  }
+
+  const usize toRead = std::min(count, m_size - m_position);
+  if (toRead == 0) {
+    return Result<usize>::ok(0);
+  }
+
+  m_file.read(reinterpret_cast<char *>(buffer),
+              static_cast<std::streamsize>(toRead));
+  const auto got = static_cast<usize>(m_file.gcount());
+  if (got < toRead) {
+    if (m_file.bad()) {
+      return Result<usize>::error("Failed to read file");
+    }
+    m_file.clear();
+  }
+  m_position += got;
+  return Result<usize>::ok(got);
+}
+
+Result<void> DiskFileHandle::seek(i64 offset, SeekOrigin origin) {
+  if (!isValid()) {
+    return Result<void>::error("Invalid file handle");
+  }
+
+  i64 newPosition = 0;
+
+  switch (origin) {
+  case SeekOrigin::Begin:
+    newPosition = offset;
+    break;
+  case SeekOrigin::Current:
+    newPosition = static_cast<i64>(m_position) + offset;
+    break;
+  case SeekOrigin::End:
+    newPosition = static_cast<i64>(m_size) + offset;
+    break;
+  }
+
+  if (newPosition < 0) {
+    return Result<void>::error("Seek position before beginning of file");
+  }
+
+  if (static_cast<usize>(newPosition) > m_size) {
+    return Result<void>::error("Seek position past end of file");
+  }
+
+  m_file.seekg(static_cast<std::streamoff>(newPosition), std::ios::beg);
+  m_position = static_cast<usize>(newPosition);
+  return Result<void>::ok();
+}
+
 } // namespace NovelMind::VFS
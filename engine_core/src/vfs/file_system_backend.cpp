@@ -1,5 +1,6 @@
 #include "NovelMind/vfs/file_system_backend.hpp"
 #include <algorithm>
+#include <filesystem>
 #include <numeric>
 
 namespace NovelMind::VFS {
@@ -22,6 +23,30 @@ u32 crc32(const std::vector<u8> &data) {
 
 } // anonymous namespace
 
+std::vector<Result<SharedBuffer>>
+IFileSystemBackend::readMany(std::span<const ResourceId> ids) {
+  std::vector<Result<SharedBuffer>> results;
+  results.reserve(ids.size());
+
+  for (const auto &id : ids) {
+    auto handle = open(id);
+    if (!handle || !handle->isValid()) {
+      results.push_back(
+          Result<SharedBuffer>::error("Resource not found: " + id.id()));
+      continue;
+    }
+    auto bytes = handle->readAll();
+    if (!bytes.isOk()) {
+      results.push_back(Result<SharedBuffer>::error(bytes.error()));
+      continue;
+    }
+    results.push_back(
+        Result<SharedBuffer>::ok(SharedBuffer(std::move(bytes).value())));
+  }
+
+  return results;
+}
+
 std::unique_ptr<IFileHandle> MemoryBackend::open(const ResourceId &id) {
   std::lock_guard<std::mutex> lock(m_mutex);
 
@@ -98,4 +123,152 @@ u32 MemoryBackend::calculateChecksum(const std::vector<u8> &data) {
   return crc32(data);
 }
 
+DirectoryBackend::DirectoryBackend(std::string root, u32 priority,
+                                   BatchReadConfig batchConfig)
+    : m_root(std::move(root)), m_priority(priority), m_reader(batchConfig) {}
+
+std::unique_ptr<IFileHandle> DirectoryBackend::open(const ResourceId &id) {
+  const auto path = pathOf(id);
+  if (path.empty()) {
+    return nullptr;
+  }
+
+  auto handle = std::make_unique<DiskFileHandle>(path);
+  if (!handle->isValid()) {
+    return nullptr;
+  }
+  return handle;
+}
+
+bool DirectoryBackend::exists(const ResourceId &id) const {
+  const auto path = pathOf(id);
+  std::error_code ec;
+  return !path.empty() && std::filesystem::is_regular_file(path, ec);
+}
+
+std::optional<ResourceInfo>
+DirectoryBackend::getInfo(const ResourceId &id) const {
+  const auto path = pathOf(id);
+  std::error_code ec;
+  if (path.empty() || !std::filesystem::is_regular_file(path, ec)) {
+    return std::nullopt;
+  }
+
+  const auto size = std::filesystem::file_size(path, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+
+  // No checksum: computing one would mean reading the file
+  ResourceInfo info;
+  info.resourceId = ResourceId(id.id());
+  info.size = static_cast<usize>(size);
+  info.compressedSize = info.size;
+  return info;
+}
+
+std::vector<ResourceId> DirectoryBackend::list(ResourceType type) const {
+  std::vector<ResourceId> result;
+  std::error_code ec;
+  for (std::filesystem::recursive_directory_iterator it(m_root, ec), end;
+       !ec && it != end; it.increment(ec)) {
+    if (!it->is_regular_file(ec)) {
+      continue;
+    }
+    ResourceId id(
+        std::filesystem::relative(it->path(), m_root, ec).generic_string());
+    if (type == ResourceType::Unknown || id.type() == type) {
+      result.push_back(std::move(id));
+    }
+  }
+  return result;
+}
+
+std::vector<Result<SharedBuffer>>
+DirectoryBackend::readMany(std::span<const ResourceId> ids) {
+  std::vector<BatchReadRequest> requests(ids.size());
+  for (usize i = 0; i < ids.size(); ++i) {
+    requests[i].path = pathOf(ids[i]);
+  }
+
+  auto results = m_reader.read(requests);
+  for (usize i = 0; i < ids.size(); ++i) {
+    if (requests[i].path.empty()) {
+      results[i] =
+          Result<SharedBuffer>::error("Resource not found: " + ids[i].id());
+    }
+  }
+  return results;
+}
+
+std::string DirectoryBackend::pathOf(const ResourceId &id) const {
+  const std::filesystem::path relative(id.id());
+  if (id.isEmpty() || relative.has_root_path()) {
+    return {};
+  }
+  for (const auto &part : relative) {
+    if (part == "..") {
+      return {};
+    }
+  }
+  return (std::filesystem::path(m_root) / relative).string();
+}
+
+OverlayBackend::OverlayBackend(std::string root, u32 priority,
+                               FileWatcherConfig watcherConfig,
+                               usize journalCapacity)
+    : DirectoryBackend(root, priority),
+      m_watcher(std::move(root), watcherConfig),
+      m_journalCapacity(std::max<usize>(journalCapacity, 1)) {}
+
+Result<void> OverlayBackend::initialize() {
+  std::lock_guard<std::mutex> lock(m_journalMutex);
+  return m_watcher.start();
+}
+
+void OverlayBackend::shutdown() {
+  std::lock_guard<std::mutex> lock(m_journalMutex);
+  m_watcher.stop();
+}
+
+std::vector<ResourceChange> OverlayBackend::pollChanges() {
+  std::lock_guard<std::mutex> lock(m_journalMutex);
+
+  std::vector<ResourceChange> changes;
+  for (auto &change : m_watcher.poll()) {
+    ResourceChange entry;
+    entry.sequence = ++m_sequence;
+    if (!change.path.empty()) {
+      entry.id = ResourceId(std::move(change.path));
+    }
+    entry.kind = change.kind;
+    changes.push_back(entry);
+
+    m_journal.push_back(std::move(entry));
+    if (m_journal.size() > m_journalCapacity) {
+      m_journal.pop_front();
+    }
+  }
+  return changes;
+}
+
+std::vector<ResourceChange> OverlayBackend::changesSince(u64 sequence) const {
+  std::lock_guard<std::mutex> lock(m_journalMutex);
+
+  // Sequence numbers are consecutive, so the start is a subtraction away
+  const u64 first = m_journal.empty() ? 0 : m_journal.front().sequence;
+  const usize skip =
+      sequence >= first ? static_cast<usize>(sequence - first + 1) : 0;
+  if (skip >= m_journal.size()) {
+    return {};
+  }
+  return {m_journal.begin() + static_cast<std::ptrdiff_t>(skip),
+          m_journal.end()};
+}
+
+u64 OverlayBackend::lastSequence() const {
+  std::lock_guard<std::mutex> lock(m_journalMutex);
+  return m_sequence;
+}
+
 } // namespace NovelMind::VFS
@@ -0,0 +1,244 @@
+#include "NovelMind/vfs/file_watcher.hpp"
+#include "NovelMind/core/logger.hpp"
+#include <filesystem>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace NovelMind::VFS {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+#if defined(__linux__)
+// Writes are reported once the writer closes the file, not per write()
+constexpr u32 kWatchMask = IN_CREATE | IN_CLOSE_WRITE | IN_MOVED_TO |
+                           IN_MOVED_FROM | IN_DELETE | IN_DELETE_SELF;
+#endif
+
+std::string childPath(const std::string &dir, const std::string &name) {
+  return dir.empty() ? name : dir + "/" + name;
+}
+
+} // namespace
+
+FileWatcher::FileWatcher(std::string root, FileWatcherConfig config)
+    : m_root(std::move(root)), m_config(config) {}
+
+FileWatcher::~FileWatcher() { stop(); }
+
+Result<void> FileWatcher::start() {
+  if (m_watching) {
+    return Result<void>::ok();
+  }
+
+  std::error_code ec;
+  if (!fs::is_directory(m_root, ec)) {
+    return Result<void>::error("Not a directory: " + m_root);
+  }
+
+#if defined(__linux__)
+  if (!m_config.forcePolling) {
+    m_notifyFd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_notifyFd >= 0) {
+      watchDirectory("", false);
+      if (m_watchDirs.empty()) {
+        ::close(m_notifyFd);
+        m_notifyFd = -1;
+      }
+    }
+    if (m_notifyFd < 0) {
+      NOVELMIND_LOG_WARN("inotify unavailable, polling " + m_root);
+    }
+  }
+#endif
+
+  if (!usesNotifications()) {
+    m_snapshot = scan();
+    m_lastScan = std::chrono::steady_clock::now();
+  }
+  m_watching = true;
+  return Result<void>::ok();
+}
+
+void FileWatcher::stop() {
+#if defined(__linux__)
+  if (m_notifyFd >= 0) {
+    ::close(m_notifyFd);
+  }
+#endif
+  m_notifyFd = -1;
+  m_watchDirs.clear();
+  m_snapshot.clear();
+  m_changes.clear();
+  m_changeIndex.clear();
+  m_watching = false;
+}
+
+std::vector<FileChange> FileWatcher::poll() {
+  if (!m_watching) {
+    return {};
+  }
+  if (usesNotifications()) {
+    pollNotifications();
+  } else {
+    pollScan();
+  }
+  return takeChanges();
+}
+
+void FileWatcher::record(const std::string &path, FileChangeKind kind) {
+  const auto it = m_changeIndex.find(path);
+  if (it == m_changeIndex.end()) {
+    m_changeIndex.emplace(path, m_changes.size());
+    m_changes.push_back({path, kind});
+    return;
+  }
+
+  auto &change = m_changes[it->second];
+  if (change.kind == FileChangeKind::Added) {
+    if (kind == FileChangeKind::Removed) {
+      // Came and went between polls: nothing to report
+      m_changes.erase(m_changes.begin() +
+                      static_cast<std::ptrdiff_t>(it->second));
+      m_changeIndex.clear();
+      for (usize i = 0; i < m_changes.size(); ++i) {
+        m_changeIndex.emplace(m_changes[i].path, i);
+      }
+    }
+  } else if (kind == FileChangeKind::Added) {
+    // Replaced, e.g. saved through a temporary file and a rename
+    change.kind = FileChangeKind::Modified;
+  } else {
+    change.kind = kind;
+  }
+}
+
+std::vector<FileChange> FileWatcher::takeChanges() {
+  m_changeIndex.clear();
+  return std::exchange(m_changes, {});
+}
+
+std::unordered_map<std::string, FileWatcher::FileStamp>
+FileWatcher::scan() const {
+  std::unordered_map<std::string, FileStamp> files;
+  std::error_code ec;
+  for (fs::recursive_directory_iterator it(m_root, ec), end;
+       !ec && it != end; it.increment(ec)) {
+    if (!it->is_regular_file(ec)) {
+      continue;
+    }
+    FileStamp stamp;
+    stamp.modified = static_cast<i64>(
+        it->last_write_time(ec).time_since_epoch().count());
+    stamp.size = static_cast<u64>(it->file_size(ec));
+    files.emplace(fs::relative(it->path(), m_root, ec).generic_string(),
+                  stamp);
+  }
+  return files;
+}
+
+void FileWatcher::pollScan() {
+  const auto now = std::chrono::steady_clock::now();
+  if (now - m_lastScan < std::chrono::milliseconds(m_config.pollIntervalMs)) {
+    return;
+  }
+  m_lastScan = now;
+
+  auto current = scan();
+  for (const auto &[path, stamp] : current) {
+    const auto previous = m_snapshot.find(path);
+    if (previous == m_snapshot.end()) {
+      record(path, FileChangeKind::Added);
+    } else if (previous->second.modified != stamp.modified ||
+               previous->second.size != stamp.size) {
+      record(path, FileChangeKind::Modified);
+    }
+  }
+  for (const auto &[path, stamp] : m_snapshot) {
+    if (current.find(path) == current.end()) {
+      record(path, FileChangeKind::Removed);
+    }
+  }
+  m_snapshot = std::move(current);
+}
+
+void FileWatcher::pollNotifications() {
+#if defined(__linux__)
+  alignas(inotify_event) char buffer[16 * 1024];
+  for (;;) {
+    const auto bytes = ::read(m_notifyFd, buffer, sizeof(buffer));
+    if (bytes <= 0) {
+      break; // EAGAIN: queue drained
+    }
+
+    for (const char *p = buffer; p < buffer + bytes;) {
+      const auto *event = reinterpret_cast<const inotify_event *>(p);
+      p += sizeof(inotify_event) + event->len;
+
+      if (event->mask & IN_Q_OVERFLOW) {
+        record("", FileChangeKind::Modified);
+        continue;
+      }
+      const auto dir = m_watchDirs.find(event->wd);
+      if (dir == m_watchDirs.end()) {
+        continue;
+      }
+      if (event->mask & IN_IGNORED) {
+        m_watchDirs.erase(dir);
+        continue;
+      }
+      if (event->len == 0) {
+        continue;
+      }
+
+      const auto path = childPath(dir->second, event->name);
+      if (event->mask & IN_ISDIR) {
+        if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+          // Files may have landed before the watch existed
+          watchDirectory(path, true);
+        }
+      } else if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+        record(path, FileChangeKind::Added);
+      } else if (event->mask & IN_CLOSE_WRITE) {
+        record(path, FileChangeKind::Modified);
+      } else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+        record(path, FileChangeKind::Removed);
+      }
+    }
+  }
+#endif
+}
+
+void FileWatcher::watchDirectory(const std::string &relative,
+                                 bool reportFiles) {
+#if defined(__linux__)
+  const auto full = relative.empty() ? m_root : m_root + "/" + relative;
+  const int wd = ::inotify_add_watch(m_notifyFd, full.c_str(), kWatchMask);
+  if (wd < 0) {
+    NOVELMIND_LOG_WARN("Cannot watch directory: " + full);
+    return;
+  }
+  m_watchDirs[wd] = relative;
+
+  std::error_code ec;
+  for (fs::directory_iterator it(full, ec), end; !ec && it != end;
+       it.increment(ec)) {
+    const auto child = childPath(relative, it->path().filename().string());
+    if (it->is_directory(ec)) {
+      watchDirectory(child, reportFiles);
+    } else if (reportFiles && it->is_regular_file(ec)) {
+      record(child, FileChangeKind::Added);
+    }
+  }
+#else
+  (void)relative;
+  (void)reportFiles;
+#endif
+}
+
+} // namespace NovelMind::VFS
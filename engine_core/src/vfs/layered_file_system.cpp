@@ -0,0 +1,168 @@
+#include "NovelMind/vfs/layered_file_system.hpp"
+#include "NovelMind/vfs/secure_pack_reader.hpp"
+#include <algorithm>
+
+namespace NovelMind::vfs {
+
+namespace {
+
+// VFS has two types engine file systems do not know; they read as data
+ResourceType toEngineType(VFS::ResourceType type) {
+  return type > VFS::ResourceType::Data ? ResourceType::Data
+                                        : static_cast<ResourceType>(type);
+}
+
+VFS::ResourceType toVfsType(ResourceType type) {
+  return static_cast<VFS::ResourceType>(type);
+}
+
+std::string packBackendName(const std::string &packPath) {
+  return "pack:" + packPath;
+}
+
+// Serves a mounted engine file system, e.g. a pack, as a VFS backend
+class MountedBackend final : public VFS::IFileSystemBackend {
+public:
+  MountedBackend(std::string name, std::unique_ptr<IVirtualFileSystem> fs)
+      : m_name(std::move(name)), m_fs(std::move(fs)) {}
+
+  [[nodiscard]] std::string name() const override { return m_name; }
+
+  [[nodiscard]] std::unique_ptr<VFS::IFileHandle>
+  open(const VFS::ResourceId &id) override {
+    auto bytes = m_fs->readFile(id.id());
+    if (bytes.isError()) {
+      return nullptr;
+    }
+    return std::make_unique<VFS::MemoryFileHandle>(std::move(bytes).value());
+  }
+
+  [[nodiscard]] bool exists(const VFS::ResourceId &id) const override {
+    return m_fs->exists(id.id());
+  }
+
+  [[nodiscard]] std::optional<VFS::ResourceInfo>
+  getInfo(const VFS::ResourceId &id) const override {
+    auto info = m_fs->getInfo(id.id());
+    if (!info) {
+      return std::nullopt;
+    }
+    VFS::ResourceInfo result;
+    result.resourceId = VFS::ResourceId(info->id, toVfsType(info->type));
+    result.size = info->size;
+    result.checksum = info->checksum;
+    return result;
+  }
+
+  [[nodiscard]] std::vector<VFS::ResourceId>
+  list(VFS::ResourceType type) const override {
+    std::vector<VFS::ResourceId> ids;
+    for (auto &id : m_fs->listResources(toEngineType(type))) {
+      ids.emplace_back(std::move(id));
+    }
+    return ids;
+  }
+
+  // Mapped packs hand out views of their bytes instead of copies
+  [[nodiscard]] std::vector<Result<SharedBuffer>>
+  readMany(std::span<const VFS::ResourceId> ids) override {
+    std::vector<Result<SharedBuffer>> results;
+    results.reserve(ids.size());
+    for (const auto &id : ids) {
+      results.push_back(m_fs->readShared(id.id()));
+    }
+    return results;
+  }
+
+private:
+  std::string m_name;
+  std::unique_ptr<IVirtualFileSystem> m_fs;
+};
+
+} // namespace
+
+LayeredFileSystem::LayeredFileSystem(const VFS::VFSConfig &config)
+    : m_layers(config) {}
+
+Result<void> LayeredFileSystem::mount(const std::string &packPath) {
+  if (std::find(m_packs.begin(), m_packs.end(), packPath) != m_packs.end()) {
+    return Result<void>::ok();
+  }
+
+  auto pack = std::make_unique<SecurePackFileSystem>();
+  auto mounted = pack->mount(packPath);
+  if (mounted.isError()) {
+    return mounted;
+  }
+  m_layers.registerBackend(std::make_unique<MountedBackend>(
+      packBackendName(packPath), std::move(pack)));
+  m_packs.push_back(packPath);
+  return Result<void>::ok();
+}
+
+void LayeredFileSystem::unmount(const std::string &packPath) {
+  auto it = std::find(m_packs.begin(), m_packs.end(), packPath);
+  if (it == m_packs.end()) {
+    return;
+  }
+  m_layers.unregisterBackend(packBackendName(packPath));
+  m_packs.erase(it);
+  m_layers.clearCache();
+}
+
+void LayeredFileSystem::unmountAll() {
+  for (const auto &packPath : m_packs) {
+    m_layers.unregisterBackend(packBackendName(packPath));
+  }
+  m_packs.clear();
+  m_layers.clearCache();
+}
+
+Result<std::vector<u8>>
+LayeredFileSystem::readFile(const std::string &resourceId) const {
+  auto result = readShared(resourceId);
+  if (result.isError()) {
+    return Result<std::vector<u8>>::error(result.error());
+  }
+  return Result<std::vector<u8>>::ok(result.value().toVector());
+}
+
+Result<SharedBuffer>
+LayeredFileSystem::readShared(const std::string &resourceId) const {
+  return m_layers.readShared(VFS::ResourceId(resourceId));
+}
+
+usize LayeredFileSystem::preload(
+    std::span<const std::string> resourceIds) const {
+  std::vector<VFS::ResourceId> ids;
+  ids.reserve(resourceIds.size());
+  for (const auto &id : resourceIds) {
+    ids.emplace_back(id);
+  }
+  return m_layers.preload(ids);
+}
+
+bool LayeredFileSystem::exists(const std::string &resourceId) const {
+  return m_layers.exists(resourceId);
+}
+
+std::optional<ResourceInfo>
+LayeredFileSystem::getInfo(const std::string &resourceId) const {
+  auto info = m_layers.getInfo(VFS::ResourceId(resourceId));
+  if (!info) {
+    return std::nullopt;
+  }
+  return ResourceInfo{resourceId, toEngineType(info->resourceId.type()),
+                      info->size, info->checksum};
+}
+
+std::vector<std::string>
+LayeredFileSystem::listResources(ResourceType type) const {
+  std::vector<std::string> ids;
+  for (const auto &id : m_layers.listResources(toVfsType(type))) {
+    ids.push_back(id.id());
+  }
+  return ids;
+}
+
+} // namespace NovelMind::vfs
@@ -21,7 +21,19 @@ MemoryFileSystem::readFile(const std::string &resourceId) const {
     return Result<std::vector<u8>>::error("Resource not found: " + resourceId);
   }
 
-  return Result<std::vector<u8>>::ok(it->second.data);
+  return Result<std::vector<u8>>::ok(it->second.data.toVector());
+}
+
+Result<SharedBuffer>
+MemoryFileSystem::readShared(const std::string &resourceId) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto it = m_resources.find(resourceId);
+  if (it == m_resources.end()) {
+    return Result<SharedBuffer>::error("Resource not found: " + resourceId);
+  }
+
+  return Result<SharedBuffer>::ok(it->second.data);
 }
 
 bool MemoryFileSystem::exists(const std::string &resourceId) const {
@@ -70,7 +82,7 @@ void MemoryFileSystem::addResource(const std::string &resourceId,
   ResourceEntry entry;
   entry.checksum = calculateChecksum(data);
   entry.type = type;
-  entry.data = std::move(data);
+  entry.data = SharedBuffer(std::move(data));
 
   m_resources[resourceId] = std::move(entry);
 }
@@ -85,7 +97,7 @@ void MemoryFileSystem::clear() {
   m_resources.clear();
 }
 
-u32 MemoryFileSystem::calculateChecksum(const std::vector<u8> &data) {
+u32 MemoryFileSystem::calculateChecksum(std::span<const u8> data) {
   // Simple CRC32 implementation
   u32 crc = 0xFFFFFFFF;
   for (u8 byte : data) {
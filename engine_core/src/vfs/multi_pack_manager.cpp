@@ -4,11 +4,13 @@
  */
 
 #include "NovelMind/vfs/multi_pack_manager.hpp"
+#include "NovelMind/vfs/resource_id.hpp"
 #include <algorithm>
 #include <filesystem>
 #include <cstdlib>
 #include <fstream>
 #include <regex>
+#include <set>
 #include <sstream>
 #include <utility>
 
@@ -121,7 +123,7 @@ Result<void> MultiPackManager::initialize() {
 
   m_packs.clear();
   m_packIdToIndex.clear();
-  m_resourceIndex.clear();
+  m_resourceIndex = {};
   m_modLoadOrder.clear();
 
   auto envResult = configureKeysFromEnvironment();
@@ -276,10 +278,11 @@ PackLoadResult MultiPackManager::loadPackInternal(const std::string &path,
   loadedPack->effectivePriority = calculateEffectivePriority(type, priority);
 
   // Collect provided resources
-  auto resources = loadedPack->reader->listResources();
-  for (const auto &resId : resources) {
-    loadedPack->providedResources.insert(resId);
-  }
+  auto &resources = loadedPack->providedResources;
+  resources = loadedPack->reader->listResources();
+  std::sort(resources.begin(), resources.end());
+  resources.erase(std::unique(resources.begin(), resources.end()),
+                  resources.end());
   result.loadedResources = loadedPack->providedResources.size();
 
   // Add to packs list
@@ -355,7 +358,7 @@ void MultiPackManager::unloadAllPacks() {
 
   m_packs.clear();
   m_packIdToIndex.clear();
-  m_resourceIndex.clear();
+  m_resourceIndex = {};
   m_modLoadOrder.clear();
 }
 
@@ -518,12 +521,12 @@ bool MultiPackManager::isPackEnabled(const std::string &packId) const {
 
 Result<std::vector<u8>>
 MultiPackManager::readResource(const std::string &resourceId) {
-  auto it = m_resourceIndex.find(resourceId);
-  if (it == m_resourceIndex.end()) {
+  auto provider = findProvider(resourceId);
+  if (!provider) {
     return Result<std::vector<u8>>::error("Resource not found: " + resourceId);
   }
 
-  auto &pack = m_packs[it->second];
+  auto &pack = m_packs[*provider];
   if (!pack->info.enabled) {
     return Result<std::vector<u8>>::error("Pack is disabled: " + pack->info.id);
   }
@@ -532,24 +535,24 @@ MultiPackManager::readResource(const std::string &resourceId) {
 }
 
 bool MultiPackManager::exists(const std::string &resourceId) const {
-  return m_resourceIndex.find(resourceId) != m_resourceIndex.end();
+  return findProvider(resourceId).has_value();
 }
 
 std::optional<ResourceInfo>
 MultiPackManager::getResourceInfo(const std::string &resourceId) const {
-  auto it = m_resourceIndex.find(resourceId);
-  if (it == m_resourceIndex.end()) {
+  auto provider = findProvider(resourceId);
+  if (!provider) {
     return std::nullopt;
   }
 
-  return m_packs[it->second]->reader->getInfo(resourceId);
+  return m_packs[*provider]->reader->getInfo(resourceId);
 }
 
 std::string
 MultiPackManager::getResourcePack(const std::string &resourceId) const {
-  auto it = m_resourceIndex.find(resourceId);
-  if (it != m_resourceIndex.end()) {
-    return m_packs[it->second]->info.id;
+  auto provider = findProvider(resourceId);
+  if (provider) {
+    return m_packs[*provider]->info.id;
   }
   return "";
 }
@@ -558,13 +561,21 @@ std::vector<std::string>
 MultiPackManager::listResources(ResourceType type) const {
   std::vector<std::string> result;
 
-  for (const auto &[resourceId, packIndex] : m_resourceIndex) {
-    if (type == ResourceType::Unknown) {
-      result.push_back(resourceId);
-    } else {
-      auto info = m_packs[packIndex]->reader->getInfo(resourceId);
-      if (info && info->type == type) {
+  for (size_t packIndex = 0; packIndex < m_packs.size(); ++packIndex) {
+    const auto &pack = m_packs[packIndex];
+    for (const auto &resourceId : pack->providedResources) {
+      // Only the pack that wins the override provides the resource
+      auto provider = findProvider(resourceId);
+      if (!provider || *provider != packIndex) {
+        continue;
+      }
+      if (type == ResourceType::Unknown) {
         result.push_back(resourceId);
+      } else {
+        auto info = pack->reader->getInfo(resourceId);
+        if (info && info->type == type) {
+          result.push_back(resourceId);
+        }
       }
     }
   }
@@ -830,28 +841,37 @@ PackInfo MultiPackManager::readPackManifest(const std::string &path) {
 }
 
 void MultiPackManager::rebuildResourceIndex() {
-  m_resourceIndex.clear();
-
-  // Sort packs by effective priority (descending for override)
-  std::vector<std::pair<size_t, i32>> sorted;
+  // Higher effective priority overrides; ties keep the earlier-loaded pack
+  std::vector<ResourceIndex::Candidate> candidates;
   for (size_t i = 0; i < m_packs.size(); ++i) {
-    if (m_packs[i]->info.enabled) {
-      sorted.emplace_back(i, m_packs[i]->effectivePriority);
+    const auto &pack = m_packs[i];
+    if (!pack->info.enabled) {
+      continue;
+    }
+    for (size_t r = 0; r < pack->providedResources.size(); ++r) {
+      const std::string &resourceId = pack->providedResources[r];
+      candidates.push_back(
+          {VFS::ResourceId::hashOf(resourceId), resourceId,
+           pack->effectivePriority,
+           ResourceLocation{static_cast<u32>(i), static_cast<u32>(r)}});
     }
   }
 
-  std::sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b) {
-    return a.second > b.second; // Higher priority first
-  });
+  m_resourceIndex = ResourceIndex::build(std::move(candidates));
+}
 
-  // Build index (first occurrence wins due to descending sort)
-  for (const auto &[idx, priority] : sorted) {
-    for (const auto &resourceId : m_packs[idx]->providedResources) {
-      if (m_resourceIndex.find(resourceId) == m_resourceIndex.end()) {
-        m_resourceIndex[resourceId] = idx;
-      }
-    }
+std::optional<size_t>
+MultiPackManager::findProvider(const std::string &resourceId) const {
+  const ResourceLocation *location = m_resourceIndex.find(resourceId);
+  if (!location) {
+    return std::nullopt;
+  }
+  // Rule out a different ID that shares the hash
+  const auto &pack = m_packs[location->pack];
+  if (pack->providedResources[location->entry] != resourceId) {
+    return std::nullopt;
   }
+  return location->pack;
 }
 
 i32 MultiPackManager::calculateEffectivePriority(PackType type,
@@ -0,0 +1,414 @@
+#include "NovelMind/vfs/pack_blocks.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <thread>
+
+#ifdef NOVELMIND_HAS_ZLIB
+#include <zlib.h>
+#endif
+#ifdef NOVELMIND_HAS_LZ4
+#include <lz4.h>
+#endif
+#ifdef NOVELMIND_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+namespace NovelMind::vfs {
+
+namespace {
+
+// Keeps every codec within its int-sized limits
+constexpr u32 MAX_BLOCK_SIZE = 64 * 1024 * 1024;
+
+template <typename Fn> void parallelFor(usize count, unsigned jobs, Fn &&fn) {
+  const usize workers = std::min<usize>(jobs, count);
+  if (workers <= 1) {
+    for (usize i = 0; i < count; ++i) {
+      fn(i);
+    }
+    return;
+  }
+
+  std::atomic<usize> next{0};
+  auto worker = [&]() {
+    for (usize i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+      fn(i);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(workers - 1);
+  for (usize t = 1; t < workers; ++t) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+// Compressed form of @p in, or empty when the codec failed
+std::vector<u8> compressBlock(BlockCodec codec, std::span<const u8> in) {
+  std::vector<u8> out;
+  switch (codec) {
+  case BlockCodec::None:
+    break;
+  case BlockCodec::Zlib: {
+#ifdef NOVELMIND_HAS_ZLIB
+    uLongf length = compressBound(static_cast<uLong>(in.size()));
+    out.resize(static_cast<usize>(length));
+    if (compress2(out.data(), &length, in.data(),
+                  static_cast<uLong>(in.size()),
+                  Z_DEFAULT_COMPRESSION) != Z_OK) {
+      return {};
+    }
+    out.resize(static_cast<usize>(length));
+#endif
+    break;
+  }
+  case BlockCodec::Lz4: {
+#ifdef NOVELMIND_HAS_LZ4
+    const int bound = LZ4_compressBound(static_cast<int>(in.size()));
+    out.resize(static_cast<usize>(bound));
+    const int length = LZ4_compress_default(
+        reinterpret_cast<const char *>(in.data()),
+        reinterpret_cast<char *>(out.data()), static_cast<int>(in.size()),
+        bound);
+    if (length <= 0) {
+      return {};
+    }
+    out.resize(static_cast<usize>(length));
+#endif
+    break;
+  }
+  case BlockCodec::Zstd: {
+#ifdef NOVELMIND_HAS_ZSTD
+    out.resize(ZSTD_compressBound(in.size()));
+    const size_t length =
+        ZSTD_compress(out.data(), out.size(), in.data(), in.size(), 3);
+    if (ZSTD_isError(length)) {
+      return {};
+    }
+    out.resize(length);
+#endif
+    break;
+  }
+  }
+  return out;
+}
+
+// True when @p in decoded to exactly out.size() bytes
+bool decompressBlock(BlockCodec codec, std::span<const u8> in,
+                     std::span<u8> out) {
+  switch (codec) {
+  case BlockCodec::None:
+    return false;
+  case BlockCodec::Zlib: {
+#ifdef NOVELMIND_HAS_ZLIB
+    uLongf length = static_cast<uLongf>(out.size());
+    return uncompress(out.data(), &length, in.data(),
+                      static_cast<uLong>(in.size())) == Z_OK &&
+           length == out.size();
+#else
+    return false;
+#endif
+  }
+  case BlockCodec::Lz4: {
+#ifdef NOVELMIND_HAS_LZ4
+    return LZ4_decompress_safe(reinterpret_cast<const char *>(in.data()),
+                               reinterpret_cast<char *>(out.data()),
+                               static_cast<int>(in.size()),
+                               static_cast<int>(out.size())) ==
+           static_cast<int>(out.size());
+#else
+    return false;
+#endif
+  }
+  case BlockCodec::Zstd: {
+#ifdef NOVELMIND_HAS_ZSTD
+    const size_t length =
+        ZSTD_decompress(out.data(), out.size(), in.data(), in.size());
+    return !ZSTD_isError(length) && length == out.size();
+#else
+    return false;
+#endif
+  }
+  }
+  return false;
+}
+
+template <typename T> void appendRaw(std::vector<u8> &out, const T &value) {
+  const auto *bytes = reinterpret_cast<const u8 *>(&value);
+  out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+} // namespace
+
+bool isBlockCodecAvailable(BlockCodec codec) {
+  switch (codec) {
+  case BlockCodec::None:
+    return true;
+  case BlockCodec::Zlib:
+#ifdef NOVELMIND_HAS_ZLIB
+    return true;
+#else
+    return false;
+#endif
+  case BlockCodec::Lz4:
+#ifdef NOVELMIND_HAS_LZ4
+    return true;
+#else
+    return false;
+#endif
+  case BlockCodec::Zstd:
+#ifdef NOVELMIND_HAS_ZSTD
+    return true;
+#else
+    return false;
+#endif
+  }
+  return false;
+}
+
+const char *blockCodecName(BlockCodec codec) {
+  switch (codec) {
+  case BlockCodec::None:
+    return "none";
+  case BlockCodec::Zlib:
+    return "zlib";
+  case BlockCodec::Lz4:
+    return "lz4";
+  case BlockCodec::Zstd:
+    return "zstd";
+  }
+  return "unknown";
+}
+
+BlockCodec preferredBlockCodec(ResourceType type) {
+  BlockCodec codec = BlockCodec::Zstd;
+  switch (type) {
+  case ResourceType::Texture:
+  case ResourceType::Audio:
+  case ResourceType::Music:
+  case ResourceType::Font:
+    codec = BlockCodec::Lz4;
+    break;
+  default:
+    break;
+  }
+
+  if (isBlockCodecAvailable(codec)) {
+    return codec;
+  }
+  return isBlockCodecAvailable(BlockCodec::Zlib) ? BlockCodec::Zlib
+                                                 : BlockCodec::None;
+}
+
+Result<std::vector<u8>> encodeBlocks(std::span<const u8> data,
+                                     BlockCodec codec, u32 blockSize,
+                                     unsigned jobs) {
+  if (!isBlockCodecAvailable(codec)) {
+    return Result<std::vector<u8>>::error(
+        std::string("Block codec not available: ") + blockCodecName(codec));
+  }
+  if (blockSize == 0 || blockSize > MAX_BLOCK_SIZE) {
+    return Result<std::vector<u8>>::error("Invalid pack block size");
+  }
+
+  const usize blockCount = (data.size() + blockSize - 1) / blockSize;
+  if (blockCount > std::numeric_limits<u32>::max()) {
+    return Result<std::vector<u8>>::error("Too many pack blocks");
+  }
+
+  std::vector<std::vector<u8>> blocks(blockCount);
+  std::atomic<bool> failed{false};
+  parallelFor(blockCount, jobs, [&](usize i) {
+    const usize begin = i * blockSize;
+    const auto raw = data.subspan(
+        begin, std::min<usize>(blockSize, data.size() - begin));
+    if (codec != BlockCodec::None) {
+      blocks[i] = compressBlock(codec, raw);
+      if (blocks[i].empty()) {
+        failed = true;
+      }
+    }
+    // Incompressible blocks are stored raw
+    if (blocks[i].empty() || blocks[i].size() >= raw.size()) {
+      blocks[i].assign(raw.begin(), raw.end());
+    }
+  });
+  if (failed) {
+    return Result<std::vector<u8>>::error(
+        std::string("Block compression failed: ") + blockCodecName(codec));
+  }
+
+  PackBlockHeader header{};
+  header.magic = PACK_BLOCK_MAGIC;
+  header.codec = static_cast<u8>(codec);
+  header.blockSize = blockSize;
+  header.blockCount = static_cast<u32>(blockCount);
+  header.uncompressedSize = data.size();
+
+  usize total = 0;
+  for (const auto &block : blocks) {
+    total += block.size();
+  }
+
+  std::vector<u8> out;
+  out.reserve(sizeof(header) + (blockCount + 1) * sizeof(u64) + total);
+  appendRaw(out, header);
+  u64 offset = 0;
+  appendRaw(out, offset);
+  for (const auto &block : blocks) {
+    offset += block.size();
+    appendRaw(out, offset);
+  }
+  for (const auto &block : blocks) {
+    out.insert(out.end(), block.begin(), block.end());
+  }
+  return Result<std::vector<u8>>::ok(std::move(out));
+}
+
+Result<BlockedResource> BlockedResource::open(std::span<const u8> encoded) {
+  PackBlockHeader header{};
+  if (encoded.size() < sizeof(header)) {
+    return Result<BlockedResource>::error("Truncated block header");
+  }
+  std::memcpy(&header, encoded.data(), sizeof(header));
+
+  if (header.magic != PACK_BLOCK_MAGIC) {
+    return Result<BlockedResource>::error("Invalid block header magic");
+  }
+  if (header.codec > static_cast<u8>(BlockCodec::Zstd)) {
+    return Result<BlockedResource>::error("Unknown block codec");
+  }
+  if (header.blockSize == 0 || header.blockSize > MAX_BLOCK_SIZE) {
+    return Result<BlockedResource>::error("Invalid pack block size");
+  }
+  const u64 expectedBlocks =
+      (header.uncompressedSize + header.blockSize - 1) / header.blockSize;
+  if (header.blockCount != expectedBlocks) {
+    return Result<BlockedResource>::error("Block count does not match size");
+  }
+
+  const u64 tableSize = (static_cast<u64>(header.blockCount) + 1) * 8;
+  if (encoded.size() - sizeof(header) < tableSize) {
+    return Result<BlockedResource>::error("Truncated block table");
+  }
+
+  BlockedResource resource;
+  resource.m_offsets = encoded.data() + sizeof(header);
+  resource.m_blocks = resource.m_offsets + tableSize;
+  resource.m_codec = static_cast<BlockCodec>(header.codec);
+  resource.m_blockSize = header.blockSize;
+  resource.m_blockCount = header.blockCount;
+  resource.m_size = header.uncompressedSize;
+
+  const u64 available = encoded.size() - sizeof(header) - tableSize;
+  if (resource.offsetAt(0) != 0 ||
+      resource.offsetAt(header.blockCount) > available) {
+    return Result<BlockedResource>::error("Block data out of bounds");
+  }
+  for (u32 i = 0; i < header.blockCount; ++i) {
+    const u64 begin = resource.offsetAt(i);
+    const u64 end = resource.offsetAt(i + 1);
+    if (end < begin || end - begin > resource.blockLength(i)) {
+      return Result<BlockedResource>::error("Corrupted block table");
+    }
+  }
+
+  return Result<BlockedResource>::ok(resource);
+}
+
+u64 BlockedResource::offsetAt(u32 index) const {
+  u64 offset = 0;
+  std::memcpy(&offset, m_offsets + static_cast<usize>(index) * 8, 8);
+  return offset;
+}
+
+usize BlockedResource::blockLength(u32 index) const {
+  const u64 begin = static_cast<u64>(index) * m_blockSize;
+  return static_cast<usize>(std::min<u64>(m_blockSize, m_size - begin));
+}
+
+Result<void> BlockedResource::decodeBlock(u32 index, std::span<u8> out) const {
+  if (index >= m_blockCount || out.size() != blockLength(index)) {
+    return Result<void>::error("Invalid block read");
+  }
+
+  const u64 begin = offsetAt(index);
+  const std::span<const u8> stored(
+      m_blocks + begin, static_cast<usize>(offsetAt(index + 1) - begin));
+  if (stored.size() == out.size()) {
+    std::memcpy(out.data(), stored.data(), out.size());
+    return Result<void>::ok();
+  }
+
+  if (!decompressBlock(m_codec, stored, out)) {
+    return Result<void>::error(
+        std::string("Failed to decode ") + blockCodecName(m_codec) +
+        " block " + std::to_string(index));
+  }
+  return Result<void>::ok();
+}
+
+Result<usize> BlockedResource::read(u64 offset, std::span<u8> out) const {
+  if (offset >= m_size || out.empty()) {
+    return Result<usize>::ok(0);
+  }
+  const usize length =
+      static_cast<usize>(std::min<u64>(out.size(), m_size - offset));
+
+  std::vector<u8> scratch;
+  usize written = 0;
+  while (written < length) {
+    const u64 position = offset + written;
+    const u32 index = static_cast<u32>(position / m_blockSize);
+    const usize within = static_cast<usize>(position % m_blockSize);
+    const usize blockBytes = blockLength(index);
+    const usize take = std::min(blockBytes - within, length - written);
+
+    if (within == 0 && take == blockBytes) {
+      auto result = decodeBlock(index, out.subspan(written, take));
+      if (result.isError()) {
+        return Result<usize>::error(result.error());
+      }
+    } else {
+      // Partial block: decode aside and copy the slice we need
+      scratch.resize(blockBytes);
+      auto result = decodeBlock(index, scratch);
+      if (result.isError()) {
+        return Result<usize>::error(result.error());
+      }
+      std::memcpy(out.data() + written, scratch.data() + within, take);
+    }
+    written += take;
+  }
+  return Result<usize>::ok(written);
+}
+
+Result<std::vector<u8>> BlockedResource::readAll(unsigned jobs) const {
+  std::vector<u8> out(static_cast<usize>(m_size));
+  std::atomic<bool> failed{false};
+  std::atomic<u32> failedBlock{0};
+  parallelFor(m_blockCount, jobs, [&](usize i) {
+    const auto index = static_cast<u32>(i);
+    const auto block = std::span<u8>(out).subspan(
+        static_cast<usize>(index) * m_blockSize, blockLength(index));
+    if (decodeBlock(index, block).isError()) {
+      failedBlock = index;
+      failed = true;
+    }
+  });
+  if (failed) {
+    return Result<std::vector<u8>>::error(
+        std::string("Failed to decode ") + blockCodecName(m_codec) +
+        " block " + std::to_string(failedBlock.load()));
+  }
+  return Result<std::vector<u8>>::ok(std::move(out));
+}
+
+} // namespace NovelMind::vfs
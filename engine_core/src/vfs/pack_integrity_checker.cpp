@@ -3,9 +3,12 @@
 #include "pack_security_detail.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <fstream>
 #include <istream>
+#include <limits>
+#include <thread>
 
 #ifdef NOVELMIND_HAS_OPENSSL
 #include <openssl/err.h>
@@ -17,6 +20,33 @@ namespace NovelMind::VFS {
 
 namespace {
 
+template <typename Fn> void parallelFor(usize count, unsigned jobs, Fn &&fn) {
+  const usize workers = std::min<usize>(jobs, count);
+  if (workers <= 1) {
+    for (usize i = 0; i < count; ++i) {
+      fn(i);
+    }
+    return;
+  }
+
+  std::atomic<usize> next{0};
+  auto worker = [&]() {
+    for (usize i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+      fn(i);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(workers - 1);
+  for (usize t = 1; t < workers; ++t) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
 #ifdef NOVELMIND_HAS_OPENSSL
 bool tryComputeSha256(const u8 *data, usize size, std::array<u8, 32> &hash) {
   if (size > 0 && !data) {
@@ -368,6 +398,49 @@ PackIntegrityChecker::verifyPackSignatureStream(std::istream &stream,
   return Result<PackVerificationReport>::ok(report);
 }
 
+Result<PackVerificationReport> PackIntegrityChecker::verifyChunks(
+    const u8 *data, usize size, u32 chunkSize,
+    const std::vector<std::array<u8, 32>> &expected, usize firstChunk,
+    usize count, unsigned jobs) {
+  PackVerificationReport report;
+
+  if ((size > 0 && !data) || chunkSize == 0 ||
+      expected.size() != (size + chunkSize - 1) / chunkSize ||
+      firstChunk > expected.size() || count > expected.size() - firstChunk) {
+    report.result = PackVerificationResult::CorruptedData;
+    report.message = "Invalid chunk range for verification";
+    return Result<PackVerificationReport>::ok(report);
+  }
+
+  // Lowest failing chunk, so the report does not depend on thread timing
+  std::atomic<usize> firstBad{std::numeric_limits<usize>::max()};
+  parallelFor(count, jobs, [&](usize i) {
+    const usize chunk = firstChunk + i;
+    const usize begin = chunk * chunkSize;
+    const usize length = std::min<usize>(chunkSize, size - begin);
+    if (calculateSha256(data + begin, length) != expected[chunk]) {
+      usize current = firstBad.load();
+      while (chunk < current &&
+             !firstBad.compare_exchange_weak(current, chunk)) {
+      }
+    }
+  });
+
+  const usize bad = firstBad.load();
+  if (bad != std::numeric_limits<usize>::max()) {
+    const u64 offset = static_cast<u64>(bad) * chunkSize;
+    report.result = PackVerificationResult::ChecksumMismatch;
+    report.message = "Chunk hash mismatch at chunk " + std::to_string(bad);
+    report.errorOffset = static_cast<u32>(
+        std::min<u64>(offset, std::numeric_limits<u32>::max()));
+    return Result<PackVerificationReport>::ok(report);
+  }
+
+  report.result = PackVerificationResult::Valid;
+  report.message = "Chunk verification passed";
+  return Result<PackVerificationReport>::ok(report);
+}
+
 u32 PackIntegrityChecker::calculateCrc32(const u8 *data, usize size) {
   u32 crc = detail::updateCrc32(0xFFFFFFFF, data, size);
   return ~crc;
@@ -389,4 +462,28 @@ std::array<u8, 32> PackIntegrityChecker::calculateSha256(const u8 *data,
   return hash;
 }
 
+std::vector<std::array<u8, 32>>
+PackIntegrityChecker::calculateChunkHashes(const u8 *data, usize size,
+                                           u32 chunkSize, unsigned jobs) {
+  if (chunkSize == 0 || (size > 0 && !data)) {
+    return {};
+  }
+
+  std::vector<std::array<u8, 32>> hashes((size + chunkSize - 1) / chunkSize);
+  parallelFor(hashes.size(), jobs, [&](usize i) {
+    const usize begin = i * chunkSize;
+    hashes[i] =
+        calculateSha256(data + begin, std::min<usize>(chunkSize, size - begin));
+  });
+  return hashes;
+}
+
+std::array<u8, 32> PackIntegrityChecker::calculateChunkRoot(
+    const std::vector<std::array<u8, 32>> &chunkHashes) {
+  static_assert(sizeof(std::array<u8, 32>) == 32);
+  return calculateSha256(
+      chunkHashes.empty() ? nullptr : chunkHashes.front().data(),
+      chunkHashes.size() * 32);
+}
+
 } // namespace NovelMind::VFS
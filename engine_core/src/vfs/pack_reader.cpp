@@ -1,113 +1,298 @@
 #include "NovelMind/vfs/pack_reader.hpp"
 #include "NovelMind/core/logger.hpp"
+#include "NovelMind/vfs/pack_blocks.hpp"
 #include <cstring>
 
 namespace NovelMind::vfs {
 
+namespace {
+
+// Security: Validate resource size to prevent excessive allocations
+constexpr u64 MAX_RESOURCE_SIZE = 512ULL * 1024 * 1024; // 512 MB max
+
+template <typename T>
+bool readAt(std::span<const u8> bytes, u64 offset, T &out) {
+  if (offset > bytes.size() || bytes.size() - offset < sizeof(T)) {
+    return false;
+  }
+  std::memcpy(&out, bytes.data() + offset, sizeof(T));
+  return true;
+}
+
+} // namespace
+
 PackReader::~PackReader() { unmountAll(); }
 
 Result<void> PackReader::mount(const std::string &packPath) {
-  std::lock_guard<std::mutex> lock(m_mutex);
+  std::lock_guard<std::mutex> lock(m_writeMutex);
 
-  if (m_packs.find(packPath) != m_packs.end()) {
-    return Result<void>::error("Pack already mounted: " + packPath);
+  auto current = snapshot();
+  for (const auto &mounted : current->packs) {
+    if (mounted->path == packPath) {
+      return Result<void>::error("Pack already mounted: " + packPath);
+    }
   }
 
-  std::ifstream file(packPath, std::ios::binary);
-  if (!file.is_open()) {
+  auto mapped = platform::MappedFile::open(packPath);
+  if (mapped.isError()) {
     return Result<void>::error("Failed to open pack file: " + packPath);
   }
 
-  MountedPack pack;
-  pack.path = packPath;
+  auto pack = std::make_shared<MountedPack>();
+  pack->path = packPath;
+  pack->file = std::make_shared<const platform::MappedFile>(
+      std::move(mapped).value());
+  const std::span<const u8> bytes = pack->file->bytes();
 
-  auto headerResult = readPackHeader(file, pack.header);
+  auto headerResult = readPackHeader(bytes, pack->header);
   if (headerResult.isError()) {
     return headerResult;
   }
 
-  auto tableResult = readResourceTable(file, pack);
+  auto tableResult = readResourceTable(bytes, *pack);
   if (tableResult.isError()) {
     return tableResult;
   }
 
-  auto stringResult = readStringTable(file, pack);
+  auto stringResult = readStringTable(bytes, *pack);
   if (stringResult.isError()) {
     return stringResult;
   }
 
-  m_packs[packPath] = std::move(pack);
+  // Drop entries whose ID is not in the string table
+  std::erase_if(pack->entries, [&pack](const PackResourceEntry &entry) {
+    return entry.idStringOffset >= pack->stringTable.size();
+  });
+
+  auto packs = current->packs;
+  packs.push_back(std::move(pack));
+  publish(std::move(packs));
   NOVELMIND_LOG_INFO("Mounted pack: " + packPath);
 
   return Result<void>::ok();
 }
 
 void PackReader::unmount(const std::string &packPath) {
-  std::lock_guard<std::mutex> lock(m_mutex);
-  m_packs.erase(packPath);
+  std::lock_guard<std::mutex> lock(m_writeMutex);
+
+  auto packs = snapshot()->packs;
+  std::erase_if(packs, [&packPath](const auto &pack) {
+    return pack->path == packPath;
+  });
+  publish(std::move(packs));
   NOVELMIND_LOG_INFO("Unmounted pack: " + packPath);
 }
 
 void PackReader::unmountAll() {
-  std::lock_guard<std::mutex> lock(m_mutex);
-  m_packs.clear();
+  std::lock_guard<std::mutex> lock(m_writeMutex);
+  m_packs.store(std::make_shared<const PackSet>(), std::memory_order_release);
   NOVELMIND_LOG_INFO("Unmounted all packs");
 }
 
+void PackReader::publish(
+    std::vector<std::shared_ptr<const MountedPack>> packs) {
+  usize total = 0;
+  for (const auto &pack : packs) {
+    total += pack->entries.size();
+  }
+
+  std::vector<ResourceIndex::Candidate> candidates;
+  candidates.reserve(total);
+  for (u32 p = 0; p < packs.size(); ++p) {
+    const MountedPack &pack = *packs[p];
+    for (u32 e = 0; e < pack.entries.size(); ++e) {
+      const std::string &id = pack.idOf(pack.entries[e]);
+      // Earlier mounts take precedence
+      candidates.push_back({VFS::ResourceId::hashOf(id), id,
+                            -static_cast<i32>(p), ResourceLocation{p, e}});
+    }
+  }
+
+  auto set = std::make_shared<PackSet>();
+  set->index = ResourceIndex::build(std::move(candidates));
+  set->packs = std::move(packs);
+  m_packs.store(std::move(set), std::memory_order_release);
+}
+
+std::pair<const PackReader::MountedPack *, const PackResourceEntry *>
+PackReader::find(const PackSet &set, u64 hash, std::string_view resourceId) {
+  const ResourceLocation *location = set.index.find(hash, resourceId);
+  if (!location) {
+    return {nullptr, nullptr};
+  }
+
+  const MountedPack *pack = set.packs[location->pack].get();
+  const PackResourceEntry *entry = &pack->entries[location->entry];
+  if (pack->idOf(*entry) != resourceId) {
+    return {nullptr, nullptr}; // Another ID with the same hash
+  }
+  return {pack, entry};
+}
+
+Result<PackResourceView>
+PackReader::viewOf(const MountedPack *pack, const PackResourceEntry *entry,
+                   std::string_view resourceId) {
+  if (!pack) {
+    return Result<PackResourceView>::error("Resource not found: " +
+                                           std::string(resourceId));
+  }
+
+  if (entry->flags != 0) {
+    return Result<PackResourceView>::error(
+        "Resource needs decoding; use readFile: " + std::string(resourceId));
+  }
+
+  PackResourceView view;
+  view.backing = pack->file;
+  view.data = storedBytes(*pack, *entry);
+  return Result<PackResourceView>::ok(std::move(view));
+}
+
+std::span<const u8> PackReader::storedBytes(const MountedPack &pack,
+                                            const PackResourceEntry &entry) {
+  // Bounds were checked by validateEntry() at mount time
+  return pack.file->bytes().subspan(
+      static_cast<usize>(pack.header.dataOffset + entry.dataOffset),
+      static_cast<usize>(entry.compressedSize));
+}
+
+Result<PackResourceView>
+PackReader::readView(const std::string &resourceId) const {
+  auto set = snapshot();
+  auto [pack, entry] =
+      find(*set, VFS::ResourceId::hashOf(resourceId), resourceId);
+  return viewOf(pack, entry, resourceId);
+}
+
+Result<PackResourceView>
+PackReader::readView(const VFS::ResourceId &resourceId) const {
+  auto set = snapshot();
+  auto [pack, entry] = find(*set, resourceId.hash(), resourceId.id());
+  return viewOf(pack, entry, resourceId.id());
+}
+
 Result<std::vector<u8>>
 PackReader::readFile(const std::string &resourceId) const {
-  std::lock_guard<std::mutex> lock(m_mutex);
+  auto set = snapshot();
+  auto [pack, entry] =
+      find(*set, VFS::ResourceId::hashOf(resourceId), resourceId);
+  if (!pack) {
+    return Result<std::vector<u8>>::error("Resource not found: " +
+                                          resourceId);
+  }
 
-  for (const auto &[packPath, pack] : m_packs) {
-    auto it = pack.entries.find(resourceId);
-    if (it != pack.entries.end()) {
-      return readResourceData(packPath, it->second);
+  const auto stored = storedBytes(*pack, *entry);
+  if (entry->flags & static_cast<u32>(PackFlags::Blocked)) {
+    auto blocks = BlockedResource::open(stored);
+    if (blocks.isError()) {
+      return Result<std::vector<u8>>::error(blocks.error());
     }
+    return blocks.value().readAll(m_decodeThreads.load());
   }
 
-  return Result<std::vector<u8>>::error("Resource not found: " + resourceId);
+  // Decryption and whole-resource decompression are handled by
+  // PackSecurity when enabled. See pack_security.hpp for configuration.
+  return Result<std::vector<u8>>::ok(
+      std::vector<u8>(stored.begin(), stored.end()));
 }
 
-bool PackReader::exists(const std::string &resourceId) const {
-  std::lock_guard<std::mutex> lock(m_mutex);
+Result<SharedBuffer>
+PackReader::readShared(const std::string &resourceId) const {
+  auto set = snapshot();
+  auto [pack, entry] =
+      find(*set, VFS::ResourceId::hashOf(resourceId), resourceId);
+  if (!pack) {
+    return Result<SharedBuffer>::error("Resource not found: " + resourceId);
+  }
 
-  for (const auto &[packPath, pack] : m_packs) {
-    if (pack.entries.find(resourceId) != pack.entries.end()) {
-      return true;
+  const auto stored = storedBytes(*pack, *entry);
+  if (entry->flags & static_cast<u32>(PackFlags::Blocked)) {
+    auto blocks = BlockedResource::open(stored);
+    if (blocks.isError()) {
+      return Result<SharedBuffer>::error(blocks.error());
     }
+    auto decoded = blocks.value().readAll(m_decodeThreads.load());
+    if (decoded.isError()) {
+      return Result<SharedBuffer>::error(decoded.error());
+    }
+    return Result<SharedBuffer>::ok(
+        SharedBuffer(std::move(decoded).value()));
   }
 
-  return false;
+  // The buffer keeps the mapping alive past an unmount
+  return Result<SharedBuffer>::ok(SharedBuffer(pack->file, stored));
+}
+
+Result<usize> PackReader::readRange(const std::string &resourceId,
+                                    u64 offset, std::span<u8> out) const {
+  auto set = snapshot();
+  auto [pack, entry] =
+      find(*set, VFS::ResourceId::hashOf(resourceId), resourceId);
+  if (!pack) {
+    return Result<usize>::error("Resource not found: " + resourceId);
+  }
+
+  const auto stored = storedBytes(*pack, *entry);
+  if (entry->flags & static_cast<u32>(PackFlags::Blocked)) {
+    auto blocks = BlockedResource::open(stored);
+    if (blocks.isError()) {
+      return Result<usize>::error(blocks.error());
+    }
+    return blocks.value().read(offset, out);
+  }
+
+  if (entry->flags != 0) {
+    return Result<usize>::error("Resource needs decoding; use readFile: " +
+                                resourceId);
+  }
+  if (offset >= stored.size()) {
+    return Result<usize>::ok(0);
+  }
+  const usize length = std::min<usize>(
+      out.size(), stored.size() - static_cast<usize>(offset));
+  std::memcpy(out.data(), stored.data() + offset, length);
+  return Result<usize>::ok(length);
+}
+
+bool PackReader::exists(const std::string &resourceId) const {
+  auto set = snapshot();
+  return find(*set, VFS::ResourceId::hashOf(resourceId), resourceId).first !=
+         nullptr;
 }
 
 std::optional<ResourceInfo>
 PackReader::getInfo(const std::string &resourceId) const {
-  std::lock_guard<std::mutex> lock(m_mutex);
-
-  for (const auto &[packPath, pack] : m_packs) {
-    auto it = pack.entries.find(resourceId);
-    if (it != pack.entries.end()) {
-      ResourceInfo info;
-      info.id = resourceId;
-      info.type = static_cast<ResourceType>(it->second.type);
-      info.size = static_cast<usize>(it->second.uncompressedSize);
-      info.checksum = it->second.checksum;
-      return info;
-    }
+  auto set = snapshot();
+  auto [pack, entry] =
+      find(*set, VFS::ResourceId::hashOf(resourceId), resourceId);
+  if (!pack) {
+    return std::nullopt;
   }
 
-  return std::nullopt;
+  ResourceInfo info;
+  info.id = resourceId;
+  info.type = static_cast<ResourceType>(entry->type);
+  info.size = static_cast<usize>(entry->uncompressedSize);
+  info.checksum = entry->checksum;
+  return info;
 }
 
 std::vector<std::string> PackReader::listResources(ResourceType type) const {
-  std::lock_guard<std::mutex> lock(m_mutex);
+  auto set = snapshot();
 
   std::vector<std::string> result;
 
-  for (const auto &[packPath, pack] : m_packs) {
-    for (const auto &[id, entry] : pack.entries) {
-      if (type == ResourceType::Unknown ||
-          static_cast<ResourceType>(entry.type) == type) {
+  for (u32 p = 0; p < set->packs.size(); ++p) {
+    const MountedPack &pack = *set->packs[p];
+    for (const auto &entry : pack.entries) {
+      if (type != ResourceType::Unknown &&
+          static_cast<ResourceType>(entry.type) != type) {
+        continue;
+      }
+      // Skip IDs shadowed by an earlier pack
+      const std::string &id = pack.idOf(entry);
+      const ResourceLocation *location = set->index.find(id);
+      if (location && location->pack == p) {
         result.push_back(id);
       }
     }
@@ -116,11 +301,9 @@ std::vector<std::string> PackReader::listResources(ResourceType type) const {
   return result;
 }
 
-Result<void> PackReader::readPackHeader(std::ifstream &file,
+Result<void> PackReader::readPackHeader(std::span<const u8> bytes,
                                         PackHeader &header) {
-  file.read(reinterpret_cast<char *>(&header), sizeof(PackHeader));
-
-  if (!file) {
+  if (!readAt(bytes, 0, header)) {
     return Result<void>::error("Failed to read pack header");
   }
 
@@ -143,44 +326,78 @@ Result<void> PackReader::readPackHeader(std::ifstream &file,
     return Result<void>::error("Resource count exceeds maximum allowed");
   }
 
+  if (header.dataOffset > bytes.size()) {
+    return Result<void>::error("Data section starts beyond pack file");
+  }
+
   return Result<void>::ok();
 }
 
-Result<void> PackReader::readResourceTable(std::ifstream &file,
+Result<void> PackReader::readResourceTable(std::span<const u8> bytes,
                                            MountedPack &pack) {
-  file.seekg(static_cast<std::streamoff>(pack.header.resourceTableOffset));
-
-  if (!file) {
-    return Result<void>::error("Failed to seek to resource table");
+  const u64 tableOffset = pack.header.resourceTableOffset;
+  const u64 tableSize =
+      static_cast<u64>(pack.header.resourceCount) * sizeof(PackResourceEntry);
+  if (tableOffset > bytes.size() || bytes.size() - tableOffset < tableSize) {
+    return Result<void>::error("Resource table extends beyond pack file");
   }
 
+  pack.entries.resize(pack.header.resourceCount);
   for (u32 i = 0; i < pack.header.resourceCount; ++i) {
-    PackResourceEntry entry;
-    file.read(reinterpret_cast<char *>(&entry), sizeof(PackResourceEntry));
+    PackResourceEntry &entry = pack.entries[i];
+    readAt(bytes, tableOffset + i * sizeof(PackResourceEntry), entry);
 
-    if (!file) {
-      return Result<void>::error("Failed to read resource entry");
+    auto valid = validateEntry(bytes, pack.header, entry);
+    if (valid.isError()) {
+      return valid;
     }
-
-    // Entry ID will be resolved after reading string table
-    pack.entries[std::to_string(i)] = entry;
   }
 
   return Result<void>::ok();
 }
 
-Result<void> PackReader::readStringTable(std::ifstream &file,
-                                         MountedPack &pack) {
-  file.seekg(static_cast<std::streamoff>(pack.header.stringTableOffset));
+Result<void> PackReader::validateEntry(std::span<const u8> bytes,
+                                       const PackHeader &header,
+                                       const PackResourceEntry &entry) {
+  if (entry.compressedSize > MAX_RESOURCE_SIZE) {
+    return Result<void>::error("Resource size exceeds maximum allowed");
+  }
 
-  if (!file) {
-    return Result<void>::error("Failed to seek to string table");
+  // Security: Validate offset doesn't cause overflow
+  const u64 absoluteOffset = header.dataOffset + entry.dataOffset;
+  if (absoluteOffset < header.dataOffset) {
+    return Result<void>::error("Invalid resource offset (overflow)");
   }
 
-  u32 stringCount = 0;
-  file.read(reinterpret_cast<char *>(&stringCount), sizeof(u32));
+  if (absoluteOffset > bytes.size() ||
+      bytes.size() - absoluteOffset < entry.compressedSize) {
+    return Result<void>::error("Resource data extends beyond pack file");
+  }
+
+  if (entry.flags & static_cast<u32>(PackFlags::Blocked)) {
+    if (entry.uncompressedSize > MAX_RESOURCE_SIZE) {
+      return Result<void>::error("Resource size exceeds maximum allowed");
+    }
+    auto blocks = BlockedResource::open(bytes.subspan(
+        static_cast<usize>(absoluteOffset),
+        static_cast<usize>(entry.compressedSize)));
+    if (blocks.isError()) {
+      return Result<void>::error(blocks.error());
+    }
+    if (blocks.value().size() != entry.uncompressedSize) {
+      return Result<void>::error("Block table size mismatch");
+    }
+  }
 
-  if (!file) {
+  return Result<void>::ok();
+}
+
+Result<void> PackReader::readStringTable(std::span<const u8> bytes,
+                                         MountedPack &pack) {
+  const u64 tableOffset = pack.header.stringTableOffset;
+
+  u32 stringCount = 0;
+  if (!readAt(bytes, tableOffset, stringCount)) {
     return Result<void>::error("Failed to read string count");
   }
 
@@ -190,103 +407,42 @@ Result<void> PackReader::readStringTable(std::ifstream &file,
     return Result<void>::error("String count exceeds maximum allowed");
   }
 
-  // Read string offsets
-  std::vector<u32> offsets(stringCount);
-  file.read(reinterpret_cast<char *>(offsets.data()),
-            static_cast<std::streamsize>(stringCount * sizeof(u32)));
-
-  if (!file) {
+  const u64 offsetsStart = tableOffset + sizeof(u32);
+  const u64 stringDataStart =
+      offsetsStart + static_cast<u64>(stringCount) * sizeof(u32);
+  if (stringDataStart > bytes.size()) {
     return Result<void>::error("Failed to read string offsets");
   }
 
-  // Read string data
-  auto stringDataStart = file.tellg();
   pack.stringTable.reserve(stringCount);
 
   // Security: Limit individual string length to prevent excessive allocations
   constexpr usize MAX_STRING_LENGTH = 1024 * 1024; // 1 MB per string max
 
   for (u32 i = 0; i < stringCount; ++i) {
-    file.seekg(stringDataStart + static_cast<std::streamoff>(offsets[i]));
-    std::string str;
-    std::getline(file, str, '\0');
+    u32 offset = 0;
+    readAt(bytes, offsetsStart + i * sizeof(u32), offset);
 
-    if (str.size() > MAX_STRING_LENGTH) {
-      return Result<void>::error("String length exceeds maximum allowed");
+    const u64 start = stringDataStart + offset;
+    if (start >= bytes.size()) {
+      return Result<void>::error("String offset beyond pack file");
     }
 
-    pack.stringTable.push_back(str);
-  }
+    const usize available = bytes.size() - static_cast<usize>(start);
+    const auto *begin = reinterpret_cast<const char *>(bytes.data() + start);
+    const auto *end =
+        static_cast<const char *>(std::memchr(begin, '\0', available));
+    const usize length =
+        end ? static_cast<usize>(end - begin) : available;
 
-  // Re-map entries with actual string IDs
-  std::unordered_map<std::string, PackResourceEntry> newEntries;
-  u32 index = 0;
-  for (auto &[key, entry] : pack.entries) {
-    if (entry.idStringOffset < pack.stringTable.size()) {
-      const std::string &resourceId = pack.stringTable[entry.idStringOffset];
-      newEntries[resourceId] = entry;
+    if (length > MAX_STRING_LENGTH) {
+      return Result<void>::error("String length exceeds maximum allowed");
     }
-    ++index;
-  }
-  pack.entries = std::move(newEntries);
-
-  return Result<void>::ok();
-}
 
-Result<std::vector<u8>>
-PackReader::readResourceData(const std::string &packPath,
-                             const PackResourceEntry &entry) const {
-  // Security: Validate resource size to prevent excessive allocations
-  constexpr u64 MAX_RESOURCE_SIZE = 512ULL * 1024 * 1024; // 512 MB max per resource
-  if (entry.compressedSize > MAX_RESOURCE_SIZE) {
-    return Result<std::vector<u8>>::error("Resource size exceeds maximum allowed");
-  }
-
-  std::ifstream file(packPath, std::ios::binary);
-  if (!file.is_open()) {
-    return Result<std::vector<u8>>::error("Failed to open pack file");
-  }
-
-  auto it = m_packs.find(packPath);
-  if (it == m_packs.end()) {
-    return Result<std::vector<u8>>::error("Pack not mounted");
-  }
-
-  // Security: Validate offset doesn't cause overflow
-  u64 absoluteOffset = it->second.header.dataOffset + entry.dataOffset;
-  if (absoluteOffset < it->second.header.dataOffset) {
-    return Result<std::vector<u8>>::error("Invalid resource offset (overflow)");
+    pack.stringTable.emplace_back(begin, length);
   }
 
-  // Get file size to validate offset + size doesn't exceed file bounds
-  file.seekg(0, std::ios::end);
-  auto fileSize = file.tellg();
-  if (fileSize < 0) {
-    return Result<std::vector<u8>>::error("Failed to get pack file size");
-  }
-
-  if (absoluteOffset + entry.compressedSize > static_cast<u64>(fileSize)) {
-    return Result<std::vector<u8>>::error("Resource data extends beyond pack file");
-  }
-
-  file.seekg(static_cast<std::streamoff>(absoluteOffset));
-
-  if (!file) {
-    return Result<std::vector<u8>>::error("Failed to seek to resource data");
-  }
-
-  std::vector<u8> data(static_cast<usize>(entry.compressedSize));
-  file.read(reinterpret_cast<char *>(data.data()),
-            static_cast<std::streamsize>(entry.compressedSize));
-
-  if (!file) {
-    return Result<std::vector<u8>>::error("Failed to read resource data");
-  }
-
-  // Decryption and decompression are handled by PackSecurity when enabled.
-  // See pack_security.hpp for encryption/compression configuration.
-
-  return Result<std::vector<u8>>::ok(std::move(data));
+  return Result<void>::ok();
 }
 
 } // namespace NovelMind::vfs
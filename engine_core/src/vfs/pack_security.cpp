@@ -6,6 +6,7 @@
 #include <cstring>
 #include <fstream>
 #include <limits>
+#include <thread>
 #include <utility>
 
 #ifdef NOVELMIND_HAS_ZLIB
@@ -37,6 +38,20 @@ Result<void> SecurePackReader::setPublicKeyFromFile(const std::string &path) {
   return m_integrityChecker->setPublicKeyFromFile(path);
 }
 
+void SecurePackReader::setChunkVerification(ChunkVerification mode,
+                                            unsigned threads) {
+  m_chunkVerification = mode;
+  m_verifyThreads = threads;
+}
+
+usize SecurePackReader::verifiedChunkCount() const {
+  return static_cast<usize>(std::count_if(
+      m_chunkVerified.begin(), m_chunkVerified.end(),
+      [](const auto &verified) {
+        return verified.load(std::memory_order_acquire);
+      }));
+}
+
 Result<void> SecurePackReader::openPack(const std::string &path) {
   closePack();
   m_packPath = path;
@@ -268,6 +283,16 @@ Result<void> SecurePackReader::openPack(const std::string &path) {
     return Result<void>::error("Pack table CRC mismatch");
   }
 
+  const bool chunkHashed =
+      (m_header.flags & detail::kPackFlagChunkHashed) != 0;
+  if (chunkHashed) {
+    file.clear();
+    auto tableResult = loadChunkTable(file, stringDataStartU64);
+    if (tableResult.isError()) {
+      return tableResult;
+    }
+  }
+
   const bool requiresSignature =
       (m_header.flags & detail::kPackFlagSigned) != 0;
   if (requiresSignature) {
@@ -288,10 +313,12 @@ Result<void> SecurePackReader::openPack(const std::string &path) {
       return Result<void>::error("Signature file is empty");
     }
 
+    // Chunk-hashed packs sign the tables, which include the chunk hashes
+    const u64 signedSize = chunkHashed ? m_header.dataOffset : m_fileSize;
     file.clear();
     file.seekg(0, std::ios::beg);
     auto sigReport = m_integrityChecker->verifyPackSignatureStream(
-        file, static_cast<usize>(m_fileSize), signature.data(),
+        file, static_cast<usize>(signedSize), signature.data(),
         signature.size());
     if (!sigReport.isOk() ||
         sigReport.value().result != PackVerificationResult::Valid) {
@@ -305,7 +332,13 @@ Result<void> SecurePackReader::openPack(const std::string &path) {
   const bool hasContentHash = std::any_of(
       std::begin(m_header.contentHash), std::end(m_header.contentHash),
       [](u8 byte) { return byte != 0; });
-  if (hasContentHash) {
+  if (hasContentHash && chunkHashed) {
+    const auto root = PackIntegrityChecker::calculateChunkRoot(m_chunkHashes);
+    if (std::memcmp(m_header.contentHash, root.data(), 16) != 0) {
+      m_lastResult = PackVerificationResult::ChecksumMismatch;
+      return Result<void>::error("Pack content hash mismatch");
+    }
+  } else if (hasContentHash) {
     file.clear();
     file.seekg(0, std::ios::beg);
 
@@ -370,6 +403,28 @@ Result<void> SecurePackReader::openPack(const std::string &path) {
     }
   }
 
+  if (chunkHashed) {
+    // Chunks are checked against the bytes that reads are served from
+    auto mapped = platform::MappedFile::open(path);
+    if (mapped.isError() || mapped.value().size() != m_fileSize) {
+      m_lastResult = PackVerificationResult::CorruptedData;
+      return Result<void>::error(mapped.isError()
+                                     ? mapped.error()
+                                     : "Pack file changed while opening");
+    }
+    m_mapping = std::make_unique<platform::MappedFile>(
+        std::move(mapped.value()));
+    m_chunkVerified = std::vector<std::atomic<bool>>(m_chunkHashes.size());
+
+    if (m_chunkVerification == ChunkVerification::Eager) {
+      auto verified = verifyChunkRange(
+          0, m_fileSize - detail::kFooterSize - m_header.dataOffset);
+      if (verified.isError()) {
+        return verified;
+      }
+    }
+  }
+
   m_isOpen = true;
   m_lastResult = PackVerificationResult::Valid;
   return Result<void>::ok();
@@ -380,6 +435,10 @@ void SecurePackReader::closePack() {
   m_packPath.clear();
   m_entries.clear();
   m_stringTable.clear();
+  m_chunkSize = 0;
+  m_chunkHashes.clear();
+  m_chunkVerified.clear();
+  m_mapping.reset();
   m_fileSize = 0;
   m_lastResult = PackVerificationResult::Valid;
 }
@@ -396,23 +455,34 @@ SecurePackReader::readResource(const std::string &resourceId) {
   }
 
   const PackResourceEntry &entry = it->second;
-  std::ifstream file(m_packPath, std::ios::binary);
-  if (!file.is_open()) {
-    return Result<std::vector<u8>>::error("Failed to open pack file");
-  }
-
   const u64 absoluteOffset = m_header.dataOffset + entry.dataOffset;
-  file.seekg(static_cast<std::streamoff>(absoluteOffset));
-  if (!file) {
-    return Result<std::vector<u8>>::error("Failed to seek to resource data");
-  }
+  std::vector<u8> data;
+
+  if (m_mapping) {
+    auto verified = verifyChunkRange(entry.dataOffset, entry.compressedSize);
+    if (verified.isError()) {
+      return Result<std::vector<u8>>::error(verified.error());
+    }
+    const u8 *begin = m_mapping->data() + absoluteOffset;
+    data.assign(begin, begin + entry.compressedSize);
+  } else {
+    std::ifstream file(m_packPath, std::ios::binary);
+    if (!file.is_open()) {
+      return Result<std::vector<u8>>::error("Failed to open pack file");
+    }
 
-  std::vector<u8> data(static_cast<usize>(entry.compressedSize));
-  if (!data.empty()) {
-    file.read(reinterpret_cast<char *>(data.data()),
-              static_cast<std::streamsize>(data.size()));
+    file.seekg(static_cast<std::streamoff>(absoluteOffset));
     if (!file) {
-      return Result<std::vector<u8>>::error("Failed to read resource data");
+      return Result<std::vector<u8>>::error("Failed to seek to resource data");
+    }
+
+    data.resize(static_cast<usize>(entry.compressedSize));
+    if (!data.empty()) {
+      file.read(reinterpret_cast<char *>(data.data()),
+                static_cast<std::streamsize>(data.size()));
+      if (!file) {
+        return Result<std::vector<u8>>::error("Failed to read resource data");
+      }
     }
   }
 
@@ -490,6 +560,105 @@ SecurePackReader::readResource(const std::string &resourceId) {
   return Result<std::vector<u8>>::ok(std::move(data));
 }
 
+Result<void> SecurePackReader::loadChunkTable(std::ifstream &file,
+                                              u64 tablesEnd) {
+  if (m_header.dataOffset < tablesEnd + detail::kChunkTableTrailerSize) {
+    m_lastResult = PackVerificationResult::CorruptedResourceTable;
+    return Result<void>::error("Missing chunk hash table");
+  }
+
+  struct {
+    u32 magic;
+    u32 chunkSize;
+    u64 chunkCount;
+  } trailer{};
+  static_assert(sizeof(trailer) == detail::kChunkTableTrailerSize);
+  file.seekg(static_cast<std::streamoff>(m_header.dataOffset -
+                                         detail::kChunkTableTrailerSize));
+  file.read(reinterpret_cast<char *>(&trailer), sizeof(trailer));
+  if (!file || trailer.magic != detail::kChunkTableMagic) {
+    m_lastResult = PackVerificationResult::CorruptedResourceTable;
+    return Result<void>::error("Invalid chunk hash table");
+  }
+
+  if (trailer.chunkSize < detail::kMinChunkSize ||
+      trailer.chunkSize > detail::kMaxChunkSize) {
+    m_lastResult = PackVerificationResult::CorruptedResourceTable;
+    return Result<void>::error("Invalid chunk size");
+  }
+
+  const u64 dataSize = m_fileSize - detail::kFooterSize - m_header.dataOffset;
+  const u64 expectedCount =
+      (dataSize + trailer.chunkSize - 1) / trailer.chunkSize;
+  const u64 hashesSize = expectedCount * 32;
+  if (trailer.chunkCount != expectedCount ||
+      m_header.dataOffset - detail::kChunkTableTrailerSize - tablesEnd <
+          hashesSize) {
+    m_lastResult = PackVerificationResult::CorruptedResourceTable;
+    return Result<void>::error("Chunk hash table does not match data size");
+  }
+
+  m_chunkSize = trailer.chunkSize;
+  m_chunkHashes.resize(static_cast<usize>(expectedCount));
+  file.seekg(static_cast<std::streamoff>(
+      m_header.dataOffset - detail::kChunkTableTrailerSize - hashesSize));
+  if (!m_chunkHashes.empty()) {
+    file.read(reinterpret_cast<char *>(m_chunkHashes.data()),
+              static_cast<std::streamsize>(hashesSize));
+    if (!file) {
+      m_lastResult = PackVerificationResult::CorruptedResourceTable;
+      return Result<void>::error("Failed to read chunk hash table");
+    }
+  }
+  return Result<void>::ok();
+}
+
+Result<void> SecurePackReader::verifyChunkRange(u64 offset, u64 size) {
+  if (size == 0 || m_chunkHashes.empty()) {
+    return Result<void>::ok();
+  }
+
+  // Verify the unchecked runs of chunks covering [offset, offset + size)
+  const usize first = static_cast<usize>(offset / m_chunkSize);
+  const usize last = static_cast<usize>((offset + size - 1) / m_chunkSize);
+  const unsigned threads =
+      m_verifyThreads != 0
+          ? m_verifyThreads
+          : std::max(1u, std::thread::hardware_concurrency());
+  const u8 *data = m_mapping->data() + m_header.dataOffset;
+  const usize dataSize = static_cast<usize>(
+      m_fileSize - detail::kFooterSize - m_header.dataOffset);
+
+  const auto verified = [this](usize chunk) {
+    return m_chunkVerified[chunk].load(std::memory_order_acquire);
+  };
+  for (usize chunk = first; chunk <= last;) {
+    if (verified(chunk)) {
+      ++chunk;
+      continue;
+    }
+    usize runEnd = chunk;
+    while (runEnd <= last && !verified(runEnd)) {
+      ++runEnd;
+    }
+
+    auto report = m_integrityChecker->verifyChunks(
+        data, dataSize, m_chunkSize, m_chunkHashes, chunk, runEnd - chunk,
+        threads);
+    if (!report.isOk() ||
+        report.value().result != PackVerificationResult::Valid) {
+      m_lastResult = report.isOk() ? report.value().result
+                                   : PackVerificationResult::ChecksumMismatch;
+      return Result<void>::error(report.isOk() ? report.value().message
+                                               : report.error());
+    }
+    for (; chunk < runEnd; ++chunk) {
+      m_chunkVerified[chunk].store(true, std::memory_order_release);
+    }
+  }
+  return Result<void>::ok();
+}
+
 bool SecurePackReader::exists(const std::string &resourceId) const {
   return m_entries.find(resourceId) != m_entries.end();
 }
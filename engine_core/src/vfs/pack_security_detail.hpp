@@ -16,6 +16,14 @@ inline constexpr usize kGcmTagSize = 16;
 inline constexpr u32 kPackFlagEncrypted = 1u << 0;
 inline constexpr u32 kPackFlagCompressed = 1u << 1;
 inline constexpr u32 kPackFlagSigned = 1u << 2;
+inline constexpr u32 kPackFlagChunkHashed = 1u << 3;
+
+// Chunk hash table of a chunk-hashed pack: u8 hashes[chunkCount][32]
+// followed by this trailer, ending exactly at dataOffset
+inline constexpr u32 kChunkTableMagic = 0x48434D4E; // "NMCH"
+inline constexpr usize kChunkTableTrailerSize = 16;
+inline constexpr u32 kMinChunkSize = 4 * 1024;
+inline constexpr u32 kMaxChunkSize = 64 * 1024 * 1024;
 
 bool readFileToString(std::ifstream &file, std::string &out);
 bool readFileToBytes(std::ifstream &file, std::vector<u8> &out);
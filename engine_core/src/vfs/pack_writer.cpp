@@ -0,0 +1,275 @@
+#include "NovelMind/vfs/pack_writer.hpp"
+#include "NovelMind/vfs/pack_reader.hpp"
+#include "NovelMind/vfs/pack_security.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+namespace NovelMind::vfs {
+
+namespace {
+
+template <typename T> void append(std::vector<u8> &out, const T &value) {
+  const auto *bytes = reinterpret_cast<const u8 *>(&value);
+  out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+} // namespace
+
+PackWriter::PackWriter(PackWriterConfig config) : m_config(config) {}
+
+Result<void> PackWriter::add(const std::string &id, std::span<const u8> data,
+                             ResourceType type) {
+  if (id.empty()) {
+    return Result<void>::error("Resource id is empty");
+  }
+  if (m_entryIndex.count(id) != 0) {
+    return Result<void>::error("Duplicate resource id: " + id);
+  }
+
+  BlockCodec codec = BlockCodec::None;
+  if (m_config.blockThreshold != 0 && data.size() >= m_config.blockThreshold) {
+    codec = preferredBlockCodec(type);
+  }
+
+  // Keyed on the input rather than the stored bytes, so duplicates are
+  // found before spending time compressing them again
+  std::pair<std::array<u8, 32>, BlockCodec> key{{}, codec};
+  if (m_config.deduplicate) {
+    key.first =
+        VFS::PackIntegrityChecker::calculateSha256(data.data(), data.size());
+    const auto existing = m_blobIndex.find(key);
+    if (existing != m_blobIndex.end()) {
+      m_entryIndex.emplace(id, m_entries.size());
+      m_entries.push_back({id, type, existing->second});
+      return Result<void>::ok();
+    }
+  }
+
+  Blob blob;
+  blob.uncompressedSize = data.size();
+  blob.checksum =
+      VFS::PackIntegrityChecker::calculateCrc32(data.data(), data.size());
+  if (codec != BlockCodec::None) {
+    auto encoded =
+        encodeBlocks(data, codec, m_config.blockSize, m_config.jobs);
+    if (encoded.isError()) {
+      return Result<void>::error("Cannot compress " + id + ": " +
+                                 encoded.error());
+    }
+    // Incompressible data is cheaper to read as it is
+    if (encoded.value().size() < data.size()) {
+      blob.bytes = std::move(encoded).value();
+      blob.flags = static_cast<u32>(PackFlags::Blocked);
+    }
+  }
+  if (blob.flags == 0) {
+    blob.bytes.assign(data.begin(), data.end());
+  }
+
+  if (m_config.deduplicate) {
+    m_blobIndex.emplace(key, m_blobs.size());
+  }
+  m_entryIndex.emplace(id, m_entries.size());
+  m_entries.push_back({id, type, m_blobs.size()});
+  m_blobs.push_back(std::move(blob));
+  return Result<void>::ok();
+}
+
+Result<void> PackWriter::addFile(const std::string &id,
+                                 const std::string &sourcePath,
+                                 ResourceType type) {
+  std::ifstream file(sourcePath, std::ios::binary);
+  if (!file) {
+    return Result<void>::error("Cannot open file: " + sourcePath);
+  }
+  const std::vector<u8> data((std::istreambuf_iterator<char>(file)),
+                             std::istreambuf_iterator<char>());
+  if (file.bad()) {
+    return Result<void>::error("Cannot read file: " + sourcePath);
+  }
+  return add(id, data, type);
+}
+
+void PackWriter::setFirstUseOrder(std::vector<std::string> ids) {
+  m_firstUse = std::move(ids);
+}
+
+std::vector<usize> PackWriter::firstUseBlobs() const {
+  std::vector<usize> reads;
+  std::vector<bool> seen(m_blobs.size(), false);
+  for (const auto &id : m_firstUse) {
+    const auto it = m_entryIndex.find(id);
+    if (it == m_entryIndex.end()) {
+      continue;
+    }
+    const usize blob = m_entries[it->second].blob;
+    if (!seen[blob]) {
+      seen[blob] = true;
+      reads.push_back(blob);
+    }
+  }
+  return reads;
+}
+
+u64 PackWriter::seekDistance(const std::vector<usize> &reads,
+                             const std::vector<u64> &offsets,
+                             const std::vector<Blob> &blobs) {
+  u64 distance = 0;
+  u64 position = 0; // Start of the data section
+  for (usize blob : reads) {
+    const u64 offset = offsets[blob];
+    distance += offset > position ? offset - position : position - offset;
+    position = offset + blobs[blob].bytes.size();
+  }
+  return distance;
+}
+
+Result<PackWriter::Layout> PackWriter::layout() {
+  if (m_entries.size() > std::numeric_limits<u32>::max()) {
+    return Result<Layout>::error("Too many resources for one pack");
+  }
+
+  // Payloads in first-use order, then the rest in the order they were added
+  const auto reads = firstUseBlobs();
+  Layout result;
+  result.blobs = reads;
+  std::vector<bool> placed(m_blobs.size(), false);
+  for (usize blob : reads) {
+    placed[blob] = true;
+  }
+  for (usize blob = 0; blob < m_blobs.size(); ++blob) {
+    if (!placed[blob]) {
+      result.blobs.push_back(blob);
+    }
+  }
+
+  std::vector<u64> offsets(m_blobs.size(), 0);
+  std::vector<u64> insertionOffsets(m_blobs.size(), 0);
+  u64 dataSize = 0;
+  for (usize blob : result.blobs) {
+    offsets[blob] = dataSize;
+    dataSize += m_blobs[blob].bytes.size();
+  }
+  u64 insertionEnd = 0;
+  for (usize blob = 0; blob < m_blobs.size(); ++blob) {
+    insertionOffsets[blob] = insertionEnd;
+    insertionEnd += m_blobs[blob].bytes.size();
+  }
+
+  PackHeader header{};
+  header.magic = PACK_MAGIC;
+  header.versionMajor = PACK_VERSION_MAJOR;
+  header.versionMinor = PACK_VERSION_MINOR;
+  header.resourceCount = static_cast<u32>(m_entries.size());
+  header.resourceTableOffset = sizeof(PackHeader);
+  header.stringTableOffset = header.resourceTableOffset +
+                             m_entries.size() * sizeof(PackResourceEntry);
+
+  std::vector<u8> strings;
+  std::vector<u32> stringOffsets;
+  stringOffsets.reserve(m_entries.size());
+  for (const auto &entry : m_entries) {
+    stringOffsets.push_back(static_cast<u32>(strings.size()));
+    strings.insert(strings.end(), entry.id.begin(), entry.id.end());
+    strings.push_back(0);
+  }
+  header.dataOffset = header.stringTableOffset + sizeof(u32) +
+                      stringOffsets.size() * sizeof(u32) + strings.size();
+  header.totalSize = header.dataOffset + dataSize;
+  result.totalSize = header.totalSize;
+
+  std::vector<u8> &out = result.tables;
+  out.reserve(static_cast<usize>(header.dataOffset));
+  append(out, header);
+  for (u32 i = 0; i < m_entries.size(); ++i) {
+    const Blob &blob = m_blobs[m_entries[i].blob];
+    PackResourceEntry entry{};
+    entry.idStringOffset = i;
+    entry.type = static_cast<u32>(m_entries[i].type);
+    entry.dataOffset = offsets[m_entries[i].blob];
+    entry.compressedSize = blob.bytes.size();
+    entry.uncompressedSize = blob.uncompressedSize;
+    entry.flags = blob.flags;
+    entry.checksum = blob.checksum;
+    append(out, entry);
+  }
+  append(out, static_cast<u32>(stringOffsets.size()));
+  for (u32 offset : stringOffsets) {
+    append(out, offset);
+  }
+  out.insert(out.end(), strings.begin(), strings.end());
+
+  m_report = {};
+  m_report.resourceCount = static_cast<u32>(m_entries.size());
+  m_report.blobCount = static_cast<u32>(m_blobs.size());
+  for (const auto &entry : m_entries) {
+    m_report.logicalBytes += m_blobs[entry.blob].bytes.size();
+  }
+  m_report.storedBytes = dataSize;
+  m_report.orderedBlobs = static_cast<u32>(reads.size());
+  m_report.seekDistanceBefore = seekDistance(reads, insertionOffsets, m_blobs);
+  m_report.seekDistanceAfter = seekDistance(reads, offsets, m_blobs);
+  return Result<Layout>::ok(std::move(result));
+}
+
+Result<std::vector<u8>> PackWriter::build() {
+  auto planned = layout();
+  if (planned.isError()) {
+    return Result<std::vector<u8>>::error(planned.error());
+  }
+
+  std::vector<u8> out = std::move(planned.value().tables);
+  out.reserve(static_cast<usize>(planned.value().totalSize));
+  for (usize blob : planned.value().blobs) {
+    out.insert(out.end(), m_blobs[blob].bytes.begin(),
+               m_blobs[blob].bytes.end());
+  }
+  return Result<std::vector<u8>>::ok(std::move(out));
+}
+
+Result<void> PackWriter::write(const std::string &packPath) {
+  auto planned = layout();
+  if (planned.isError()) {
+    return Result<void>::error(planned.error());
+  }
+
+  // Tables, then each payload straight from its blob, so the pack is
+  // never held in memory a second time. A mounted pack may be mapped, so
+  // write beside it and rename over it instead of truncating it.
+  const std::string tempPath = packPath + ".tmp";
+  std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    return Result<void>::error("Cannot create pack: " + tempPath);
+  }
+  const auto put = [&file](const std::vector<u8> &bytes) {
+    file.write(reinterpret_cast<const char *>(bytes.data()),
+               static_cast<std::streamsize>(bytes.size()));
+  };
+  put(planned.value().tables);
+  for (usize blob : planned.value().blobs) {
+    if (!file) {
+      break;
+    }
+    put(m_blobs[blob].bytes);
+  }
+  file.close();
+
+  std::error_code ec;
+  if (!file) {
+    std::filesystem::remove(tempPath, ec);
+    return Result<void>::error("Cannot write pack: " + tempPath);
+  }
+  std::filesystem::rename(tempPath, packPath, ec);
+  if (ec) {
+    std::filesystem::remove(tempPath, ec);
+    return Result<void>::error("Cannot replace pack: " + packPath);
+  }
+  return Result<void>::ok();
+}
+
+} // namespace NovelMind::vfs
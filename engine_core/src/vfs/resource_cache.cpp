@@ -1,147 +1,392 @@
 #include "NovelMind/vfs/resource_cache.hpp"
+#include <algorithm>
 
 namespace NovelMind::VFS {
 
-ResourceCache::ResourceCache(usize maxSize) : m_maxSize(maxSize) {}
+namespace {
+
+// Oldest entries CostAware chooses its victim from
+constexpr usize kCostSampleSize = 8;
+
+// Intrusive lists a node can be on. LRU and CostAware only use Recent;
+// ARC's T1/T2 are Recent/Frequent and its B1/B2 the two ghost lists.
+enum ListId : u8 { Recent, Frequent, GhostRecent, GhostFrequent, kListCount };
+
+usize typeIndex(const ResourceId &id) {
+  const auto index = static_cast<usize>(id.type());
+  return index < kResourceTypeCount ? index : 0;
+}
+
+} // anonymous namespace
+
+struct ResourceCache::Node {
+  Node *prev = this;
+  Node *next = this;
+  const ResourceId *key = nullptr; // Owned by the shard map
+  SharedBuffer data;               // Empty for ghosts
+  usize size = 0;
+  u64 cost = 0;
+  u32 pins = 0;
+  u8 list = Recent;
+
+  [[nodiscard]] bool isGhost() const { return list >= GhostRecent; }
+};
+
+struct alignas(64) ResourceCache::Shard {
+  // Circular list around a sentinel, most recent at the front
+  struct List {
+    Node head;
+    usize bytes = 0;
+    usize count = 0;
+
+    void pushFront(Node *node) {
+      node->prev = &head;
+      node->next = head.next;
+      head.next->prev = node;
+      head.next = node;
+      bytes += node->size;
+      ++count;
+    }
+
+    void unlink(Node *node) {
+      node->prev->next = node->next;
+      node->next->prev = node->prev;
+      node->prev = node->next = node;
+      bytes -= node->size;
+      --count;
+    }
+
+    void reset() {
+      head.prev = head.next = &head;
+      bytes = 0;
+      count = 0;
+    }
+  };
+
+  mutable std::mutex mutex;
+  std::unordered_map<ResourceId, Node> nodes;
+  std::array<List, kListCount> lists;
+  usize arcTarget = 0; // ARC's p: bytes the Recent list aims to hold
+  usize evictions = 0;
+  std::array<CacheTypeStats, kResourceTypeCount> byType{};
+
+  void moveTo(Node &node, u8 list) {
+    lists[node.list].unlink(&node);
+    node.list = list;
+    lists[list].pushFront(&node);
+  }
+
+  void erase(Node &node) {
+    lists[node.list].unlink(&node);
+    nodes.erase(nodes.find(*node.key));
+  }
+
+  [[nodiscard]] Node *oldestUnpinned(u8 list, const Node *keep) {
+    const Node *head = &lists[list].head;
+    for (Node *node = head->prev; node != head; node = node->prev) {
+      if (node->pins == 0 && node != keep) {
+        return node;
+      }
+    }
+    return nullptr;
+  }
+};
+
+ResourceCache::ResourceCache(usize maxSize)
+    : ResourceCache(ResourceCacheConfig{maxSize, 16, CachePolicy::LRU}) {}
+
+ResourceCache::ResourceCache(const ResourceCacheConfig &config)
+    : m_policy(config.policy), m_maxSize(config.maxSize) {
+  m_shardCount = 1;
+  while (m_shardCount < config.shardCount) {
+    m_shardCount <<= 1;
+  }
+  m_shards = std::make_unique<Shard[]>(m_shardCount);
+}
+
+ResourceCache::~ResourceCache() = default;
+
+ResourceCache::Shard &ResourceCache::shardFor(const ResourceId &id) const {
+  const u64 hash = id.hash();
+  return m_shards[static_cast<usize>(hash ^ (hash >> 32)) &
+                  (m_shardCount - 1)];
+}
+
+usize ResourceCache::shardCapacity() const {
+  return std::max<usize>(m_maxSize.load() / m_shardCount, 1);
+}
+
+bool ResourceCache::overBudget() const {
+  return m_currentSize.load() > m_maxSize.load();
+}
 
 void ResourceCache::setMaxSize(usize maxSize) {
-  std::lock_guard<std::mutex> lock(m_mutex);
   m_maxSize = maxSize;
-  evictIfNeeded(0);
+  evictToFit(nullptr);
 }
 
 std::optional<std::vector<u8>> ResourceCache::get(const ResourceId &id) {
-  std::lock_guard<std::mutex> lock(m_mutex);
-
-  const auto it = m_cache.find(id);
-  if (it == m_cache.end()) {
-    ++m_stats.missCount;
+  auto data = getShared(id);
+  if (!data) {
     return std::nullopt;
   }
+  return data->toVector();
+}
 
-  ++m_stats.hitCount;
-  it->second.lastAccess = std::chrono::steady_clock::now();
-  ++it->second.accessCount;
-  updateAccessOrder(id);
+std::optional<SharedBuffer> ResourceCache::getShared(const ResourceId &id) {
+  Shard &shard = shardFor(id);
+  std::lock_guard<std::mutex> lock(shard.mutex);
 
-  return it->second.data;
-}
+  auto &typeStats = shard.byType[typeIndex(id)];
+  const auto it = shard.nodes.find(id);
+  if (it == shard.nodes.end() || it->second.isGhost()) {
+    ++typeStats.missCount;
+    return std::nullopt;
+  }
 
-void ResourceCache::put(const ResourceId &id, std::vector<u8> data) {
-  std::lock_guard<std::mutex> lock(m_mutex);
+  ++typeStats.hitCount;
+  Node &node = it->second;
+  // A second use promotes an ARC entry to the frequent side
+  shard.moveTo(node, m_policy == CachePolicy::ARC ? Frequent : Recent);
+  return node.data;
+}
 
+void ResourceCache::put(const ResourceId &id, SharedBuffer data,
+                        u64 reloadCost) {
   const usize dataSize = data.size();
-
-  if (dataSize > m_maxSize) {
+  if (dataSize > m_maxSize.load()) {
     return;
   }
 
-  const auto existingIt = m_cache.find(id);
-  if (existingIt != m_cache.end()) {
-    m_currentSize -= existingIt->second.data.size();
-    m_cache.erase(existingIt);
-    // Decrement entry count when removing existing entry
-    if (m_stats.entryCount > 0) {
-      --m_stats.entryCount;
+  Shard &shard = shardFor(id);
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto [it, inserted] = shard.nodes.try_emplace(id);
+    Node &node = it->second;
+    u8 list = Recent;
+    if (inserted) {
+      node.key = &it->first;
+      node.list = Recent;
+      shard.lists[Recent].pushFront(&node);
+    } else if (node.isGhost()) {
+      // Evicted recently: ARC shifts its target towards the list that
+      // would have kept it
+      const usize recent = std::max<usize>(shard.lists[GhostRecent].bytes, 1);
+      const usize frequent =
+          std::max<usize>(shard.lists[GhostFrequent].bytes, 1);
+      const usize size = std::max<usize>(dataSize, 1);
+      if (node.list == GhostRecent) {
+        const usize delta = std::max<usize>(frequent / recent, 1) * size;
+        shard.arcTarget = std::min(shard.arcTarget + delta, shardCapacity());
+      } else {
+        const usize delta = std::max<usize>(recent / frequent, 1) * size;
+        shard.arcTarget -= std::min(shard.arcTarget, delta);
+      }
+      list = Frequent;
+    } else {
+      m_currentSize -= node.size;
+      if (m_policy == CachePolicy::ARC) {
+        list = Frequent;
+      }
     }
 
-    const auto orderIt = m_orderIterators.find(id);
-    if (orderIt != m_orderIterators.end()) {
-      m_accessOrder.erase(orderIt->second);
-      m_orderIterators.erase(orderIt);
+    // Resize in place: unlink so list byte totals stay exact
+    shard.lists[node.list].unlink(&node);
+    node.data = std::move(data);
+    node.size = dataSize;
+    node.cost = reloadCost != 0 ? reloadCost : dataSize;
+    node.list = list;
+    shard.lists[list].pushFront(&node);
+    m_currentSize += dataSize;
+
+    while (overBudget() && evictOne(shard, &node)) {
     }
   }
+  evictToFit(&shard);
+}
 
-  evictIfNeeded(dataSize);
+bool ResourceCache::evictOne(Shard &shard, const Node *keep) {
+  Node *victim = nullptr;
+  switch (m_policy) {
+  case CachePolicy::LRU:
+    victim = shard.oldestUnpinned(Recent, keep);
+    break;
 
-  CacheEntry entry;
-  entry.data = std::move(data);
-  entry.lastAccess = std::chrono::steady_clock::now();
-  entry.accessCount = 1;
+  case CachePolicy::CostAware: {
+    // Lowest reload cost per byte among the oldest few
+    const Node *head = &shard.lists[Recent].head;
+    usize sampled = 0;
+    for (Node *node = head->prev; node != head && sampled < kCostSampleSize;
+         node = node->prev) {
+      if (node->pins != 0 || node == keep) {
+        continue;
+      }
+      ++sampled;
+      if (!victim ||
+          static_cast<long double>(node->cost) *
+                  static_cast<long double>(std::max<usize>(victim->size, 1)) <
+              static_cast<long double>(victim->cost) *
+                  static_cast<long double>(std::max<usize>(node->size, 1))) {
+        victim = node;
+      }
+    }
+    break;
+  }
 
-  m_cache[id] = std::move(entry);
-  m_currentSize += dataSize;
+  case CachePolicy::ARC: {
+    Node *recent = shard.oldestUnpinned(Recent, keep);
+    Node *frequent = shard.oldestUnpinned(Frequent, keep);
+    victim = recent && (shard.lists[Recent].bytes > shard.arcTarget ||
+                        !frequent)
+                 ? recent
+                 : frequent;
+    break;
+  }
+  }
 
-  m_accessOrder.push_front(id);
-  m_orderIterators[id] = m_accessOrder.begin();
+  if (!victim) {
+    return false;
+  }
 
-  ++m_stats.entryCount;
+  m_currentSize -= victim->size;
+  ++shard.evictions;
+  if (m_policy != CachePolicy::ARC) {
+    shard.erase(*victim);
+    return true;
+  }
+
+  // Keep the id as a ghost; ghost lists are bounded by the shard's share
+  // of the budget
+  const u8 ghost = victim->list == Recent ? GhostRecent : GhostFrequent;
+  victim->data = SharedBuffer();
+  shard.moveTo(*victim, ghost);
+  const usize capacity = shardCapacity();
+  while (shard.lists[ghost].bytes > capacity) {
+    shard.erase(*shard.lists[ghost].head.prev);
+  }
+  return true;
+}
+
+void ResourceCache::evictToFit(const Shard *skip) {
+  // Start somewhere different each time so no shard is drained first
+  const usize start = m_evictCursor.fetch_add(1);
+  for (usize i = 0; i < m_shardCount && overBudget(); ++i) {
+    Shard &shard = m_shards[(start + i) & (m_shardCount - 1)];
+    if (&shard == skip) {
+      continue;
+    }
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    while (overBudget() && evictOne(shard, nullptr)) {
+    }
+  }
 }
 
 void ResourceCache::remove(const ResourceId &id) {
-  std::lock_guard<std::mutex> lock(m_mutex);
+  Shard &shard = shardFor(id);
+  std::lock_guard<std::mutex> lock(shard.mutex);
 
-  const auto it = m_cache.find(id);
-  if (it != m_cache.end()) {
-    m_currentSize -= it->second.data.size();
-    m_cache.erase(it);
+  const auto it = shard.nodes.find(id);
+  if (it == shard.nodes.end()) {
+    return;
+  }
+  if (!it->second.isGhost()) {
+    m_currentSize -= it->second.size;
+  }
+  shard.erase(it->second);
+}
 
-    const auto orderIt = m_orderIterators.find(id);
-    if (orderIt != m_orderIterators.end()) {
-      m_accessOrder.erase(orderIt->second);
-      m_orderIterators.erase(orderIt);
+void ResourceCache::clear() {
+  for (usize i = 0; i < m_shardCount; ++i) {
+    Shard &shard = m_shards[i];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    m_currentSize -= shard.lists[Recent].bytes + shard.lists[Frequent].bytes;
+    shard.nodes.clear();
+    for (auto &list : shard.lists) {
+      list.reset();
     }
+    shard.arcTarget = 0;
+  }
+}
+
+bool ResourceCache::pin(const ResourceId &id) {
+  Shard &shard = shardFor(id);
+  std::lock_guard<std::mutex> lock(shard.mutex);
 
-    --m_stats.entryCount;
+  const auto it = shard.nodes.find(id);
+  if (it == shard.nodes.end() || it->second.isGhost()) {
+    return false;
   }
+  ++it->second.pins;
+  return true;
 }
 
-void ResourceCache::clear() {
-  std::lock_guard<std::mutex> lock(m_mutex);
-  m_cache.clear();
-  m_accessOrder.clear();
-  m_orderIterators.clear();
-  m_currentSize = 0;
-  m_stats.entryCount = 0;
+void ResourceCache::unpin(const ResourceId &id) {
+  Shard &shard = shardFor(id);
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const auto it = shard.nodes.find(id);
+    if (it == shard.nodes.end() || it->second.pins == 0) {
+      return;
+    }
+    --it->second.pins;
+  }
+  // Space held over budget by the pin can go now
+  evictToFit(nullptr);
 }
 
 bool ResourceCache::contains(const ResourceId &id) const {
-  std::lock_guard<std::mutex> lock(m_mutex);
-  return m_cache.find(id) != m_cache.end();
-}
+  Shard &shard = shardFor(id);
+  std::lock_guard<std::mutex> lock(shard.mutex);
 
-CacheStats ResourceCache::stats() const {
-  std::lock_guard<std::mutex> lock(m_mutex);
+  const auto it = shard.nodes.find(id);
+  return it != shard.nodes.end() && !it->second.isGhost();
+}
 
-  CacheStats result = m_stats;
-  result.totalSize = m_currentSize;
-  result.entryCount = m_cache.size();
-  return result;
+usize ResourceCache::entryCount() const {
+  usize count = 0;
+  for (usize i = 0; i < m_shardCount; ++i) {
+    const Shard &shard = m_shards[i];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    count += shard.lists[Recent].count + shard.lists[Frequent].count;
+  }
+  return count;
 }
 
-void ResourceCache::resetStats() {
-  std::lock_guard<std::mutex> lock(m_mutex);
-  m_stats.hitCount = 0;
-  m_stats.missCount = 0;
-  m_stats.evictionCount = 0;
-}
-
-void ResourceCache::evictIfNeeded(usize requiredSpace) {
-  while (m_currentSize + requiredSpace > m_maxSize && !m_accessOrder.empty()) {
-    const ResourceId &lruId = m_accessOrder.back();
-    const auto it = m_cache.find(lruId);
-
-    if (it != m_cache.end()) {
-      m_currentSize -= it->second.data.size();
-      m_cache.erase(it);
-      ++m_stats.evictionCount;
-      // Decrement entry count when evicting
-      if (m_stats.entryCount > 0) {
-        --m_stats.entryCount;
+CacheStats ResourceCache::stats() const {
+  CacheStats result;
+  for (usize i = 0; i < m_shardCount; ++i) {
+    const Shard &shard = m_shards[i];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    result.entryCount +=
+        shard.lists[Recent].count + shard.lists[Frequent].count;
+    result.evictionCount += shard.evictions;
+    for (usize type = 0; type < kResourceTypeCount; ++type) {
+      result.byType[type].hitCount += shard.byType[type].hitCount;
+      result.byType[type].missCount += shard.byType[type].missCount;
+    }
+    for (const auto &[id, node] : shard.nodes) {
+      if (node.pins != 0) {
+        ++result.pinnedCount;
       }
     }
+  }
 
-    m_orderIterators.erase(lruId);
-    m_accessOrder.pop_back();
+  for (const auto &type : result.byType) {
+    result.hitCount += type.hitCount;
+    result.missCount += type.missCount;
   }
+  result.totalSize = m_currentSize.load();
+  return result;
 }
 
-void ResourceCache::updateAccessOrder(const ResourceId &id) {
-  const auto orderIt = m_orderIterators.find(id);
-  if (orderIt != m_orderIterators.end()) {
-    m_accessOrder.erase(orderIt->second);
-    m_accessOrder.push_front(id);
-    m_orderIterators[id] = m_accessOrder.begin();
+void ResourceCache::resetStats() {
+  for (usize i = 0; i < m_shardCount; ++i) {
+    Shard &shard = m_shards[i];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.byType = {};
+    shard.evictions = 0;
   }
 }
 
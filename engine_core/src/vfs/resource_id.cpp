@@ -5,7 +5,7 @@ namespace NovelMind::VFS {
 
 namespace {
 
-u64 fnv1aHash(const std::string &str) {
+u64 fnv1aHash(std::string_view str) {
   constexpr u64 FNV_PRIME = 0x100000001b3ULL;
   constexpr u64 FNV_OFFSET = 0xcbf29ce484222325ULL;
 
@@ -51,6 +51,8 @@ bool ResourceId::operator<(const ResourceId &other) const {
 
 void ResourceId::computeHash() { m_hash = fnv1aHash(m_id); }
 
+u64 ResourceId::hashOf(std::string_view id) { return fnv1aHash(id); }
+
 ResourceType ResourceId::typeFromExtension(const std::string &path) {
   const auto dotPos = path.rfind('.');
   if (dotPos == std::string::npos) {
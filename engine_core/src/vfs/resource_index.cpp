@@ -0,0 +1,103 @@
+#include "NovelMind/vfs/resource_index.hpp"
+#include "NovelMind/vfs/resource_id.hpp"
+#include <algorithm>
+#include <bit>
+
+namespace NovelMind::vfs {
+
+ResourceIndex ResourceIndex::build(std::vector<Candidate> candidates) {
+  ResourceIndex index;
+
+  // Hash order, best candidate first within each hash
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [](const Candidate &a, const Candidate &b) {
+                     if (a.hash != b.hash) {
+                       return a.hash < b.hash;
+                     }
+                     return a.priority > b.priority;
+                   });
+
+  index.m_slots.reserve(candidates.size());
+  for (usize i = 0; i < candidates.size();) {
+    usize end = i + 1;
+    bool collision = false;
+    while (end < candidates.size() &&
+           candidates[end].hash == candidates[i].hash) {
+      collision = collision || candidates[end].id != candidates[i].id;
+      ++end;
+    }
+
+    if (!collision) {
+      index.m_slots.push_back({candidates[i].hash, candidates[i].location});
+      ++index.m_size;
+    } else {
+      // First occurrence of each distinct ID is its best candidate
+      for (usize j = i; j < end; ++j) {
+        auto [it, inserted] = index.m_collisions.try_emplace(
+            std::string(candidates[j].id), candidates[j].location);
+        if (inserted) {
+          ++index.m_size;
+        }
+      }
+      index.m_slots.push_back({candidates[i].hash, {kCollision, 0}});
+    }
+    i = end;
+  }
+  index.m_slots.shrink_to_fit();
+
+  // About one slot per bucket
+  const u32 bits = std::max<u32>(
+      1, static_cast<u32>(std::bit_width(index.m_slots.size())));
+  index.m_shift = 64 - bits;
+  index.m_directory.assign((usize{1} << bits) + 1, 0);
+  usize slot = 0;
+  for (usize bucket = 0; bucket < (usize{1} << bits); ++bucket) {
+    index.m_directory[bucket] = static_cast<u32>(slot);
+    while (slot < index.m_slots.size() &&
+           (index.m_slots[slot].hash >> index.m_shift) == bucket) {
+      ++slot;
+    }
+  }
+  index.m_directory.back() = static_cast<u32>(index.m_slots.size());
+
+  return index;
+}
+
+const ResourceLocation *ResourceIndex::find(u64 hash,
+                                            std::string_view id) const {
+  if (m_slots.empty()) {
+    return nullptr;
+  }
+
+  const usize bucket = static_cast<usize>(hash >> m_shift);
+  for (u32 i = m_directory[bucket]; i < m_directory[bucket + 1]; ++i) {
+    const Slot &slot = m_slots[i];
+    if (slot.hash != hash) {
+      if (slot.hash > hash) {
+        break;
+      }
+      continue;
+    }
+    if (slot.location.pack != kCollision) {
+      return &slot.location;
+    }
+    auto it = m_collisions.find(std::string(id));
+    return it != m_collisions.end() ? &it->second : nullptr;
+  }
+  return nullptr;
+}
+
+const ResourceLocation *ResourceIndex::find(std::string_view id) const {
+  return find(VFS::ResourceId::hashOf(id), id);
+}
+
+usize ResourceIndex::memoryUsage() const {
+  usize bytes = m_slots.capacity() * sizeof(Slot) +
+                m_directory.capacity() * sizeof(u32);
+  for (const auto &[id, location] : m_collisions) {
+    bytes += sizeof(id) + id.capacity() + sizeof(location);
+  }
+  return bytes;
+}
+
+} // namespace NovelMind::vfs
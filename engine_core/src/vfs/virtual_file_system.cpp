@@ -1,21 +1,29 @@
 #include "NovelMind/vfs/virtual_file_system.hpp"
+#include "NovelMind/core/logger.hpp"
+#include "NovelMind/vfs/pack_security.hpp"
 #include <algorithm>
+#include <chrono>
+#include <unordered_map>
 
 namespace NovelMind::VFS {
 
 namespace {
 std::unique_ptr<VirtualFileSystem> g_globalVFS;
 std::mutex g_globalVFSMutex;
+
+ResourceCacheConfig cacheConfigOf(const VFSConfig &config) {
+  return {config.cacheMaxSize, config.cacheShards, config.cachePolicy};
+}
 } // anonymous namespace
 
 VirtualFileSystem::VirtualFileSystem()
     : m_config(),
-      m_cache(std::make_unique<ResourceCache>(m_config.cacheMaxSize)) {}
+      m_cache(std::make_unique<ResourceCache>(cacheConfigOf(m_config))) {}
 
 VirtualFileSystem::VirtualFileSystem(const VFSConfig &config)
     : m_config(config),
       m_cache(config.enableCaching
-                  ? std::make_unique<ResourceCache>(config.cacheMaxSize)
+                  ? std::make_unique<ResourceCache>(cacheConfigOf(config))
                   : nullptr) {}
 
 VirtualFileSystem::~VirtualFileSystem() { shutdown(); }
@@ -97,28 +105,86 @@ VirtualFileSystem::openStream(const ResourceId &id) {
 }
 
 Result<std::vector<u8>> VirtualFileSystem::readAll(const ResourceId &id) {
-  if (m_config.enableCaching && m_cache) {
-    auto cached = m_cache->get(id);
+  auto result = readShared(id);
+  if (result.isError()) {
+    return Result<std::vector<u8>>::error(result.error());
+  }
+  return Result<std::vector<u8>>::ok(result.value().toVector());
+}
+
+Result<SharedBuffer> VirtualFileSystem::readShared(const ResourceId &id) {
+  // A batch of one, so backends that share their bytes (mapped packs) can
+  auto results = readMany(std::span<const ResourceId>(&id, 1));
+  return std::move(results.front());
+}
+
+std::vector<Result<SharedBuffer>>
+VirtualFileSystem::readMany(std::span<const ResourceId> ids) {
+  std::vector<Result<SharedBuffer>> results;
+  results.reserve(ids.size());
+  std::vector<usize> misses;
+
+  const bool caching = m_config.enableCaching && m_cache;
+  for (usize i = 0; i < ids.size(); ++i) {
+    auto cached =
+        caching ? m_cache->getShared(ids[i]) : std::optional<SharedBuffer>{};
     if (cached.has_value()) {
-      return Result<std::vector<u8>>::ok(std::move(*cached));
+      results.push_back(Result<SharedBuffer>::ok(std::move(*cached)));
+    } else {
+      results.push_back(
+          Result<SharedBuffer>::error("Resource not found: " + ids[i].id()));
+      misses.push_back(i);
     }
   }
-
-  auto handle = openStream(id);
-  if (!handle || !handle->isValid()) {
-    return Result<std::vector<u8>>::error("Resource not found: " + id.id());
+  if (misses.empty()) {
+    return results;
   }
 
-  auto result = handle->readAll();
-  if (!result.isOk()) {
-    return result;
+  const u64 cost = readFromBackends(ids, misses, results);
+  if (caching) {
+    for (const usize i : misses) {
+      if (results[i].isOk()) {
+        m_cache->put(ids[i], results[i].value(), cost);
+      }
+    }
   }
+  return results;
+}
+
+usize VirtualFileSystem::preload(std::span<const ResourceId> ids) {
+  const auto results = readMany(ids);
+  return static_cast<usize>(
+      std::count_if(results.begin(), results.end(),
+                    [](const auto &result) { return result.isOk(); }));
+}
 
-  if (m_config.enableCaching && m_cache) {
-    m_cache->put(id, result.value());
+std::vector<ResourceId>
+VirtualFileSystem::verify(std::span<const ResourceId> ids) {
+  std::vector<Result<SharedBuffer>> results;
+  results.reserve(ids.size());
+  std::vector<usize> indices(ids.size());
+  for (usize i = 0; i < ids.size(); ++i) {
+    results.push_back(
+        Result<SharedBuffer>::error("Resource not found: " + ids[i].id()));
+    indices[i] = i;
   }
+  (void)readFromBackends(ids, indices, results);
 
-  return result;
+  std::vector<ResourceId> failed;
+  for (usize i = 0; i < ids.size(); ++i) {
+    if (results[i].isError()) {
+      failed.push_back(ids[i]);
+      continue;
+    }
+    const auto info = getInfo(ids[i]);
+    const auto &bytes = results[i].value();
+    if (info.has_value() && info->checksum != 0 &&
+        PackIntegrityChecker::calculateCrc32(bytes.data(), bytes.size()) !=
+            info->checksum) {
+      failed.push_back(ids[i]);
+    }
+  }
+  return failed;
 }
 
 Result<std::vector<u8>> VirtualFileSystem::readAll(const std::string &id) {
@@ -171,6 +237,45 @@ VirtualFileSystem::listResources(ResourceType type) const {
   return result;
 }
 
+std::vector<ResourceChange> VirtualFileSystem::pollChanges() {
+  std::vector<ResourceChange> changes;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto &backend : m_backends) {
+      auto backendChanges = backend->pollChanges();
+      changes.insert(changes.end(),
+                     std::make_move_iterator(backendChanges.begin()),
+                     std::make_move_iterator(backendChanges.end()));
+    }
+  }
+  if (changes.empty()) {
+    return changes;
+  }
+
+  for (const auto &change : changes) {
+    if (change.id.isEmpty()) {
+      clearCache();
+      break;
+    }
+    invalidate(change.id);
+  }
+
+  if (m_config.enableLogging) {
+    NOVELMIND_LOG_INFO("VFS: " + std::to_string(changes.size()) +
+                       " resource(s) changed");
+  }
+  if (m_changeCallback) {
+    m_changeCallback(changes);
+  }
+  return changes;
+}
+
+void VirtualFileSystem::invalidate(const ResourceId &id) {
+  if (m_cache) {
+    m_cache->remove(id);
+  }
+}
+
 void VirtualFileSystem::clearCache() {
   if (m_cache) {
     m_cache->clear();
@@ -211,6 +316,69 @@ IFileSystemBackend *VirtualFileSystem::findBackend(const ResourceId &id) const {
   return nullptr;
 }
 
+u64 VirtualFileSystem::readFromBackends(
+    std::span<const ResourceId> ids, const std::vector<usize> &indices,
+    std::vector<Result<SharedBuffer>> &results) {
+  if (indices.empty()) {
+    return 0;
+  }
+
+  // Batched I/O can take long; do it on a snapshot of the backends so
+  // other calls need not wait, and an unregistered backend stays alive
+  std::vector<std::shared_ptr<IFileSystemBackend>> backends;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    backends = m_backends;
+  }
+  const auto start = std::chrono::steady_clock::now();
+
+  // Backends in priority order, each with the ids it serves
+  std::vector<std::pair<IFileSystemBackend *, std::vector<usize>>> groups;
+  std::unordered_map<IFileSystemBackend *, usize> groupOf;
+  for (const usize i : indices) {
+    IFileSystemBackend *backend = nullptr;
+    for (const auto &candidate : backends) {
+      if (candidate->exists(ids[i])) {
+        backend = candidate.get();
+        break;
+      }
+    }
+    if (!backend) {
+      if (m_loadCallback) {
+        m_loadCallback(ids[i], false);
+      }
+      continue;
+    }
+    auto [it, inserted] = groupOf.try_emplace(backend, groups.size());
+    if (inserted) {
+      groups.emplace_back(backend, std::vector<usize>{});
+    }
+    groups[it->second].second.push_back(i);
+  }
+
+  for (auto &[backend, members] : groups) {
+    std::vector<ResourceId> batch;
+    batch.reserve(members.size());
+    for (const usize i : members) {
+      batch.push_back(ids[i]);
+    }
+
+    auto read = backend->readMany(batch);
+    for (usize k = 0; k < members.size(); ++k) {
+      if (m_loadCallback) {
+        m_loadCallback(batch[k], read[k].isOk());
+      }
+      results[members[k]] = std::move(read[k]);
+    }
+  }
+
+  // A batch has no per-resource time; charge each its share
+  const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+  return std::max<u64>(static_cast<u64>(micros) / indices.size(), 1);
+}
+
 void VirtualFileSystem::sortBackendsByPriority() {
   std::sort(m_backends.begin(), m_backends.end(),
             [](const auto &a, const auto &b) {
@@ -22,8 +22,12 @@
 #include "NovelMind/scripting/parser.hpp"
 #include "NovelMind/scripting/validator.hpp"
 #include "NovelMind/scripting/compiler.hpp"
+#include "NovelMind/scripting/compiled_script_image.hpp"
+#include "NovelMind/scripting/script_profiler.hpp"
 #include "NovelMind/scripting/script_runtime.hpp"
 #include "NovelMind/scripting/vm.hpp"
+#include "NovelMind/resource/decoded_asset_cache.hpp"
+#include "NovelMind/vfs/pack_security.hpp"
 #include "NovelMind/core/types.hpp"
 #include "NovelMind/core/logger.hpp"
 
@@ -36,6 +40,8 @@
 #include <thread>
 #include <filesystem>
 #include <cstring>
+#include <memory>
+#include <optional>
 
 // Platform-specific includes for isatty/fileno
 #ifdef _WIN32
@@ -73,6 +79,8 @@ struct RuntimeOptions {
     bool help = false;
     bool version = false;
     bool demoMode = false;
+    std::string profileTrace;  // --profile-script output; empty = off
+    std::string cacheDir;      // --cache-dir; empty = always compile
 };
 
 void printVersion() {
@@ -94,6 +102,10 @@ void printUsage(const char* programName) {
     std::cout << "  -v, --verbose         Verbose output\n";
     std::cout << "  --no-color            Disable colored output\n";
     std::cout << "  --demo                Run built-in demo\n";
+    std::cout << "  --profile-script <trace.json>\n";
+    std::cout << "                        Play through headlessly with the VM profiler,\n";
+    std::cout << "                        print hot scenes/lines and write a Chrome trace\n";
+    std::cout << "  --cache-dir <dir>     Keep compiled .nms scripts in <dir> between runs\n";
     std::cout << "  -h, --help            Show this help message\n";
     std::cout << "  --version             Show version information\n\n";
     std::cout << "Examples:\n";
@@ -101,6 +113,7 @@ void printUsage(const char* programName) {
     std::cout << "  " << programName << " mygame.nmc              # Run compiled bytecode\n";
     std::cout << "  " << programName << " mygame.nms -s chapter2  # Start from chapter2\n";
     std::cout << "  " << programName << " --demo                  # Run built-in demo\n";
+    std::cout << "  " << programName << " mygame.nmc --profile-script trace.json\n";
 }
 
 RuntimeOptions parseArgs(int argc, char* argv[]) {
@@ -129,6 +142,14 @@ RuntimeOptions parseArgs(int argc, char* argv[]) {
             opts.noColor = true;
         } else if (arg == "--demo") {
             opts.demoMode = true;
+        } else if (arg == "--profile-script") {
+            if (i + 1 < argc) {
+                opts.profileTrace = argv[++i];
+            }
+        } else if (arg == "--cache-dir") {
+            if (i + 1 < argc) {
+                opts.cacheDir = argv[++i];
+            }
         } else if (arg[0] != '-') {
             opts.scriptFile = arg;
         }
@@ -148,6 +169,33 @@ std::string readFile(const std::string& path) {
     return buffer.str();
 }
 
+/**
+ * @brief A script ready to run
+ *
+ * NMC2 images stay mapped and are executed in place; only their scene and
+ * character tables are copied into @c script. Scripts compiled from source
+ * or read from NMC1 files are fully owned by @c script.
+ */
+struct LoadedScript {
+    std::shared_ptr<const NovelMind::scripting::CompiledScriptImage> image;
+    NovelMind::scripting::CompiledScript script;
+
+    NovelMind::usize instructionCount() const {
+        return image ? image->instructions().size() : script.instructions.size();
+    }
+
+    NovelMind::usize stringCount() const {
+        return image ? image->strings().size() : script.stringTable.size();
+    }
+
+    NovelMind::Result<void> loadInto(NovelMind::scripting::VirtualMachine& vm) const {
+        if (image) {
+            return vm.load(image);
+        }
+        return vm.load(script.instructions, script.stringTable);
+    }
+};
+
 /**
  * @brief Console-based Visual Novel Runtime
  *
@@ -163,10 +211,11 @@ public:
         , m_typewriterSpeed(speed)
     {}
 
-    void run(const NovelMind::scripting::CompiledScript& script,
-             const std::string& startScene = "") {
-
+    void run(const LoadedScript& loaded, const std::string& startScene = "") {
+        const auto& script = loaded.script;
         m_script = script;
+        m_instructionCount = loaded.instructionCount();
+        m_stringCount = loaded.stringCount();
         m_running = true;
         m_currentScene = startScene.empty() ?
             (script.sceneEntryPoints.empty() ? "" :
@@ -535,8 +584,8 @@ private:
 
         printLine("");
         printLine("Compiled script statistics:");
-        std::cout << "  • " << m_script.instructions.size() << " instructions\n";
-        std::cout << "  • " << m_script.stringTable.size() << " string literals\n";
+        std::cout << "  • " << m_instructionCount << " instructions\n";
+        std::cout << "  • " << m_stringCount << " string literals\n";
         std::cout << "  • " << m_script.sceneEntryPoints.size() << " scenes\n";
         std::cout << "  • " << m_script.characters.size() << " characters\n";
 
@@ -544,6 +593,8 @@ private:
     }
 
     NovelMind::scripting::CompiledScript m_script;
+    NovelMind::usize m_instructionCount = 0;
+    NovelMind::usize m_stringCount = 0;
     bool m_useColor;
     bool m_typewriter;
     float m_typewriterSpeed;
@@ -611,7 +662,51 @@ NovelMind::scripting::CompiledScript compileScript(const std::string& source, bo
     return std::move(compileResult).value();
 }
 
-NovelMind::scripting::CompiledScript loadCompiledScript(const std::string& path) {
+NovelMind::scripting::CompiledScript compileScriptCached(const std::string& path,
+                                                         const std::string& source,
+                                                         const RuntimeOptions& opts) {
+    if (opts.cacheDir.empty()) {
+        return compileScript(source, opts.verbose);
+    }
+
+    NovelMind::resource::DecodedAssetCache cache({opts.cacheDir});
+    auto opened = cache.open();
+    if (opened.isError()) {
+        std::cerr << "Warning: " << opened.error() << "\n";
+        return compileScript(source, opts.verbose);
+    }
+
+    const NovelMind::resource::DecodedAssetKey key{
+        NovelMind::resource::DecodedAssetKind::Script,
+        fs::absolute(path).string(), {},
+        NovelMind::VFS::PackIntegrityChecker::calculateCrc32(
+            reinterpret_cast<const NovelMind::u8*>(source.data()), source.size())};
+    if (auto cached = cache.loadScript(key)) {
+        if (opts.verbose) {
+            std::cout << "Using cached bytecode from " << opts.cacheDir << "\n";
+        }
+        return std::move(*cached);
+    }
+
+    auto script = compileScript(source, opts.verbose);
+    auto stored = cache.storeScript(key, script);
+    if (stored.isError() && opts.verbose) {
+        std::cout << "Could not cache bytecode: " << stored.error() << "\n";
+    }
+    return script;
+}
+
+LoadedScript loadCompiledScript(const std::string& path) {
+    // NMC2 images are mapped and validated in one pass, then run in place
+    auto image = NovelMind::scripting::CompiledScriptImage::open(path);
+    if (image.isOk()) {
+        LoadedScript loaded;
+        loaded.image = std::make_shared<const NovelMind::scripting::CompiledScriptImage>(
+            std::move(image).value());
+        loaded.script = loaded.image->metadata();
+        return loaded;
+    }
+
     std::ifstream file(path, std::ios::binary);
     if (!file.is_open()) {
         throw std::runtime_error("Cannot open file: " + path);
@@ -623,7 +718,7 @@ NovelMind::scripting::CompiledScript loadCompiledScript(const std::string& path)
     char magic[5] = {0};
     file.read(magic, 4);
     if (std::string(magic) != "NMC1") {
-        throw std::runtime_error("Invalid compiled script format");
+        throw std::runtime_error("Invalid compiled script format: " + image.error());
     }
 
     // Read version
@@ -698,7 +793,107 @@ NovelMind::scripting::CompiledScript loadCompiledScript(const std::string& path)
         script.characters[ch.id] = ch;
     }
 
-    return script;
+    LoadedScript loaded;
+    loaded.script = std::move(script);
+    return loaded;
+}
+
+/**
+ * @brief Headless playthrough with the VM profiler attached (--profile-script)
+ *
+ * Every line is acknowledged immediately and choices rotate through their
+ * options, so repeated runs exercise the script deterministically. Stops at
+ * HALT or after a fixed instruction budget (for scripts that loop forever).
+ */
+int runScriptProfile(const LoadedScript& loadedScript, const RuntimeOptions& opts) {
+    using namespace NovelMind::scripting;
+    constexpr NovelMind::u64 kInstructionLimit = 50'000'000;
+
+    struct Driver {
+        std::optional<NovelMind::u32> pendingGoto;
+        NovelMind::u32 choiceCount = 0;
+        NovelMind::u32 choiceRound = 0;
+    } driver;
+
+    VirtualMachine vm;
+    ScriptProfiler profiler;
+    vm.setProfiler(&profiler);
+
+    auto loaded = loadedScript.loadInto(vm);
+    if (loaded.isError()) {
+        throw std::runtime_error(loaded.error());
+    }
+
+    // Reports are indexed by instruction and source line, so a mapped image
+    // is materialized here; only this diagnostic path pays for the copy
+    std::optional<CompiledScript> materialized;
+    if (loadedScript.image) {
+        materialized = loadedScript.image->toCompiledScript();
+    }
+    const CompiledScript& script = materialized ? *materialized : loadedScript.script;
+
+    // Bind every VN command so operands are consumed as in the real runtime
+    // and handler time shows up in the profile.
+    for (OpCode op : {OpCode::CALL, OpCode::SHOW_BACKGROUND, OpCode::SHOW_CHARACTER,
+                      OpCode::HIDE_CHARACTER, OpCode::SAY, OpCode::PLAY_SOUND,
+                      OpCode::PLAY_MUSIC, OpCode::STOP_MUSIC, OpCode::WAIT,
+                      OpCode::TRANSITION}) {
+        vm.registerNativeHandler(op, [](void*, const NativeCallArgs&) {}, nullptr);
+    }
+    vm.registerNativeHandler(
+        OpCode::GOTO_SCENE,
+        [](void* context, const NativeCallArgs& args) {
+            static_cast<Driver*>(context)->pendingGoto = args.operand;
+        },
+        &driver);
+    vm.registerNativeHandler(
+        OpCode::CHOICE,
+        [](void* context, const NativeCallArgs& args) {
+            static_cast<Driver*>(context)->choiceCount = args.operand;
+        },
+        &driver);
+
+    if (!opts.startScene.empty()) {
+        auto it = script.sceneEntryPoints.find(opts.startScene);
+        if (it == script.sceneEntryPoints.end()) {
+            throw std::runtime_error("Scene not found: " + opts.startScene);
+        }
+        vm.setIP(it->second);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    while (!vm.isHalted() && profiler.totalInstructions() < kInstructionLimit) {
+        if (vm.isWaiting()) {
+            if (driver.pendingGoto) {
+                vm.setIP(*driver.pendingGoto);
+                driver.pendingGoto.reset();
+                vm.signalContinue();
+            } else if (driver.choiceCount > 0) {
+                vm.signalChoice(static_cast<NovelMind::i32>(driver.choiceRound++ %
+                                                            driver.choiceCount));
+                driver.choiceCount = 0;
+            } else {
+                vm.signalContinue();
+            }
+        }
+        vm.step();
+    }
+    const double elapsedMs = std::chrono::duration<double, std::milli>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count();
+
+    std::cout << profiler.formatReport(script);
+    std::cout << "\nWall time: " << elapsedMs << " ms";
+    if (!vm.isHalted()) {
+        std::cout << " (stopped at the " << kInstructionLimit << " instruction limit)";
+    }
+    std::cout << "\n";
+
+    if (!profiler.exportToChromeTrace(opts.profileTrace, script)) {
+        throw std::runtime_error("Cannot write trace: " + opts.profileTrace);
+    }
+    std::cout << "Trace written to " << opts.profileTrace << "\n";
+    return 0;
 }
 
 int main(int argc, char* argv[]) {
@@ -742,7 +937,7 @@ int main(int argc, char* argv[]) {
         fs::path filePath(opts.scriptFile);
         std::string ext = filePath.extension().string();
 
-        NovelMind::scripting::CompiledScript script;
+        LoadedScript script;
 
         if (ext == ".nmc") {
             // Load compiled script
@@ -755,16 +950,28 @@ int main(int argc, char* argv[]) {
             if (opts.verbose) {
                 std::cout << "Compiling script: " << opts.scriptFile << "\n";
             }
+            const auto start = std::chrono::steady_clock::now();
             std::string source = readFile(opts.scriptFile);
-            script = compileScript(source, opts.verbose);
+            script.script = compileScriptCached(opts.scriptFile, source, opts);
+            if (opts.verbose) {
+                std::cout << "Script ready in "
+                          << std::chrono::duration<double, std::milli>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count()
+                          << " ms\n";
+            }
         } else {
             throw std::runtime_error("Unknown file type: " + ext +
                                    " (expected .nms or .nmc)");
         }
 
         if (opts.verbose) {
-            std::cout << "Loaded " << script.sceneEntryPoints.size() << " scenes, "
-                      << script.characters.size() << " characters\n";
+            std::cout << "Loaded " << script.script.sceneEntryPoints.size() << " scenes, "
+                      << script.script.characters.size() << " characters\n";
+        }
+
+        if (!opts.profileTrace.empty()) {
+            return runScriptProfile(script, opts);
         }
 
         // Run the visual novel
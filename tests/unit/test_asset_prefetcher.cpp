@@ -0,0 +1,236 @@
+#include <catch2/catch_test_macros.hpp>
+#include "NovelMind/resource/resource_manager.hpp"
+#include "NovelMind/scripting/asset_prefetcher.hpp"
+#include "NovelMind/scripting/lexer.hpp"
+#include "NovelMind/scripting/parser.hpp"
+#include "NovelMind/scripting/script_runtime.hpp"
+#include "NovelMind/vfs/layered_file_system.hpp"
+#include "NovelMind/vfs/memory_fs.hpp"
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace NovelMind;
+using namespace NovelMind::scripting;
+
+namespace {
+
+CompiledScript compileSource(const std::string &source) {
+  Lexer lexer;
+  auto tokens = lexer.tokenize(source);
+  REQUIRE(tokens.isOk());
+
+  Parser parser;
+  auto program = parser.parse(tokens.value());
+  REQUIRE(program.isOk());
+
+  Compiler compiler;
+  auto compiled = compiler.compile(program.value());
+  REQUIRE(compiled.isOk());
+  return compiled.value();
+}
+
+const char *kBranchingScript = R"(
+character Hero(name="Hero", sprite="chars/hero.ppm")
+scene intro {
+    show background "bg/room.ppm"
+    say Hero "Hello"
+    show Hero at center
+    choice {
+        "Forest" -> goto forest
+        "City" -> goto city
+    }
+}
+scene forest {
+    show background "bg/forest.ppm"
+    play music "music/forest.ogg"
+    say Hero "Trees"
+}
+scene city {
+    show background "bg/city.ppm"
+    play sound "sfx/car.ogg"
+    say Hero "Cars"
+})";
+
+// 1x1 binary PPM
+std::vector<u8> tinyImage() {
+  const std::string header = "P6\n1 1\n255\n";
+  std::vector<u8> bytes(header.begin(), header.end());
+  const u8 pixel[] = {10, 20, 30};
+  bytes.insert(bytes.end(), std::begin(pixel), std::end(pixel));
+  return bytes;
+}
+
+const PrefetchTarget *findTarget(const std::vector<PrefetchTarget> &targets,
+                                 const std::string &id) {
+  auto it = std::find_if(targets.begin(), targets.end(),
+                         [&id](const PrefetchTarget &t) { return t.id == id; });
+  return it == targets.end() ? nullptr : &*it;
+}
+
+} // namespace
+
+TEST_CASE("AssetPrefetcher scans every branch ahead of the IP",
+          "[scripting][prefetch]") {
+  const auto script = compileSource(kBranchingScript);
+  const u32 entry = script.sceneEntryPoints.at("intro");
+
+  const auto targets = AssetPrefetcher::scan(script, entry, 512);
+  REQUIRE(targets.size() == 6);
+  REQUIRE(targets.front().id == "bg/room.ppm");
+  REQUIRE(targets.front().distance == 0);
+  REQUIRE(targets.front().waitsBefore == 0);
+
+  const auto *hero = findTarget(targets, "chars/hero.ppm");
+  REQUIRE(hero != nullptr);
+  REQUIRE(hero->kind == PrefetchAssetKind::Character);
+  REQUIRE(hero->waitsBefore == 1);
+
+  // Both sides of the choice, past the scene jumps
+  for (const char *id : {"bg/forest.ppm", "music/forest.ogg", "bg/city.ppm",
+                         "sfx/car.ogg"}) {
+    const auto *target = findTarget(targets, id);
+    REQUIRE(target != nullptr);
+    REQUIRE(target->waitsBefore >= 2);
+    REQUIRE(target->distance > hero->distance);
+  }
+  REQUIRE(findTarget(targets, "music/forest.ogg")->kind ==
+          PrefetchAssetKind::Music);
+
+  for (usize i = 1; i < targets.size(); ++i) {
+    REQUIRE(targets[i - 1].distance <= targets[i].distance);
+  }
+
+  SECTION("the horizon bounds every path") {
+    const auto near = AssetPrefetcher::scan(script, entry, hero->distance + 1);
+    REQUIRE(near.size() == 2);
+    REQUIRE(AssetPrefetcher::scan(script, entry, 1).size() == 1);
+    REQUIRE(AssetPrefetcher::scan(script, entry, 0).empty());
+  }
+
+  SECTION("paths end at the script end") {
+    const u32 city = script.sceneEntryPoints.at("city");
+    const auto tail = AssetPrefetcher::scan(script, city, 512);
+    REQUIRE(tail.size() == 2);
+    REQUIRE(findTarget(tail, "bg/forest.ppm") == nullptr);
+  }
+}
+
+TEST_CASE("ScriptRuntime prefetches assets before they are shown",
+          "[scripting][prefetch]") {
+  vfs::MemoryFileSystem fs;
+  for (const char *id : {"bg/room.ppm", "bg/forest.ppm", "bg/city.ppm",
+                         "chars/hero.ppm"}) {
+    fs.addResource(id, tinyImage(), vfs::ResourceType::Texture);
+  }
+  fs.addResource("music/forest.ogg", {1, 2, 3}, vfs::ResourceType::Music);
+  fs.addResource("sfx/car.ogg", {4, 5, 6}, vfs::ResourceType::Audio);
+  resource::ResourceManager resources(&fs);
+
+  ScriptRuntime runtime;
+  REQUIRE(runtime.load(compileSource(kBranchingScript)).isOk());
+  runtime.setResourceManager(&resources);
+  REQUIRE(runtime.gotoScene("intro").isOk());
+
+  // The background shown at scene entry cannot be ready in time
+  runtime.update(0.016);
+  REQUIRE(runtime.isWaitingForInput());
+  const auto &prefetcher = runtime.getPrefetcher();
+  REQUIRE(prefetcher.getStats().late == 1);
+  REQUIRE(prefetcher.trackedCount() == 5);
+
+  // Loads complete while the player reads
+  while (resources.getLoader().pendingCount() > 0) {
+    resources.update(1000.0);
+  }
+  REQUIRE(resources.getTextureCount() == 4);
+  REQUIRE(resources.getDataCount() == 2);
+
+  runtime.continueExecution();
+  runtime.update(0.016);
+  REQUIRE(runtime.isWaitingForChoice());
+  REQUIRE(prefetcher.getStats().hits == 1);
+
+  // Audio providers read prefetched bytes from memory, not the source
+  fs.removeResource("sfx/car.ogg");
+  auto sound = resources.readShared("sfx/car.ogg");
+  REQUIRE(sound.isOk());
+  REQUIRE(sound.value().size() == 3);
+
+  runtime.selectChoice(1);
+  for (int frame = 0; frame < 4 && !runtime.isWaitingForInput(); ++frame) {
+    runtime.update(0.016);
+  }
+  REQUIRE(runtime.isWaitingForInput());
+
+  const auto &stats = prefetcher.getStats();
+  REQUIRE(stats.hits == 3);
+  REQUIRE(stats.misses == 0);
+  REQUIRE(stats.late == 1);
+  // The forest branch left the window without being used
+  REQUIRE(stats.dropped == 2);
+  REQUIRE(stats.hitRate() == 0.75);
+  // Both tracks are behind the IP now and their bytes were released
+  REQUIRE(resources.getDataCount() == 0);
+}
+
+TEST_CASE("ScriptRuntime batch-reads a scene's first assets on entry",
+          "[scripting][prefetch]") {
+  vfs::LayeredFileSystem files;
+  auto packed = std::make_unique<VFS::MemoryBackend>();
+  for (const char *id : {"bg/room.ppm", "bg/forest.ppm", "bg/city.ppm",
+                         "chars/hero.ppm"}) {
+    packed->addResource(id, tinyImage(), VFS::ResourceType::Texture);
+  }
+  packed->addResource("music/forest.ogg", {1, 2, 3}, VFS::ResourceType::Music);
+  files.layers().registerBackend(std::move(packed));
+  resource::ResourceManager resources(&files);
+
+  ScriptRuntime runtime;
+  REQUIRE(runtime.load(compileSource(kBranchingScript)).isOk());
+  runtime.setResourceManager(&resources);
+
+  // Entering the scene only queues the batch; nothing is read yet
+  REQUIRE(runtime.gotoScene("intro").isOk());
+  REQUIRE(files.layers().stats().loadedResources == 0);
+
+  // The batch is Immediate, so a zero budget still runs it, and nothing
+  // queued behind it. Only what is shown before the first line is read.
+  resources.update(0.0);
+  REQUIRE(files.layers().stats().loadedResources == 1);
+  REQUIRE(files.layers().stats().cacheStats.missCount == 1);
+
+  // Both forest assets come before its first line
+  REQUIRE(runtime.gotoScene("forest").isOk());
+  resources.update(0.0);
+  REQUIRE(files.layers().stats().loadedResources == 3);
+}
+
+TEST_CASE("Scene preloads run on loader workers", "[scripting][prefetch]") {
+  vfs::LayeredFileSystem files;
+  auto packed = std::make_unique<VFS::MemoryBackend>();
+  packed->addResource("bg/forest.ppm", tinyImage(),
+                      VFS::ResourceType::Texture);
+  packed->addResource("music/forest.ogg", {1, 2, 3}, VFS::ResourceType::Music);
+  files.layers().registerBackend(std::move(packed));
+  resource::ResourceManager resources(&files);
+  resource::AsyncLoaderConfig config;
+  config.workerThreads = 1;
+  resources.enableAsyncLoading(config);
+
+  ScriptRuntime runtime;
+  REQUIRE(runtime.load(compileSource(kBranchingScript)).isOk());
+  runtime.setResourceManager(&resources);
+
+  // Read by the worker; this thread never calls update()
+  REQUIRE(runtime.gotoScene("forest").isOk());
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (files.layers().stats().loadedResources < 2 &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::yield();
+  }
+  REQUIRE(files.layers().stats().loadedResources == 2);
+}
@@ -0,0 +1,233 @@
+#include <catch2/catch_test_macros.hpp>
+#include "NovelMind/core/types.hpp"
+#include "NovelMind/scripting/bytecode_optimizer.hpp"
+#include "NovelMind/scripting/compiler.hpp"
+#include "NovelMind/scripting/lexer.hpp"
+#include "NovelMind/scripting/parser.hpp"
+#include "NovelMind/scripting/vm.hpp"
+
+using namespace NovelMind::scripting;
+using NovelMind::i32;
+using NovelMind::u32;
+
+namespace {
+
+CompiledScript compileSource(const std::string &source) {
+  Lexer lexer;
+  auto tokens = lexer.tokenize(source);
+  REQUIRE(tokens.isOk());
+
+  Parser parser;
+  auto program = parser.parse(tokens.value());
+  REQUIRE(program.isOk());
+
+  Compiler compiler;
+  auto compiled = compiler.compile(program.value());
+  REQUIRE(compiled.isOk());
+  return compiled.value();
+}
+
+CompiledScript makeScript(std::vector<Instruction> instructions) {
+  CompiledScript script;
+  script.instructions = std::move(instructions);
+  return script;
+}
+
+Value runAndRead(const CompiledScript &script, const std::string &name) {
+  VirtualMachine vm;
+  REQUIRE(vm.load(script.instructions, script.stringTable).isOk());
+  vm.run();
+  return vm.getVariable(name);
+}
+
+} // namespace
+
+TEST_CASE("BytecodeOptimizer folds constants", "[scripting][optimizer]") {
+  // x = (2 + 3) * 4
+  CompiledScript script = makeScript({
+      {OpCode::PUSH_INT, 2},
+      {OpCode::PUSH_INT, 3},
+      {OpCode::ADD, 0},
+      {OpCode::PUSH_INT, 4},
+      {OpCode::MUL, 0},
+      {OpCode::STORE_GLOBAL, 0},
+      {OpCode::HALT, 0},
+  });
+  script.stringTable = {"x"};
+
+  BytecodeOptimizer optimizer(OptimizationLevel::O1);
+  auto stats = optimizer.optimize(script);
+
+  REQUIRE(stats.constantsFolded == 2);
+  REQUIRE(script.instructions.size() == 3);
+  REQUIRE(script.instructions[0].opcode == OpCode::PUSH_INT);
+  REQUIRE(script.instructions[0].operand == 20);
+  REQUIRE(asInt(runAndRead(script, "x")) == 20);
+}
+
+TEST_CASE("BytecodeOptimizer leaves division by zero to the VM",
+          "[scripting][optimizer]") {
+  CompiledScript script = makeScript({
+      {OpCode::PUSH_INT, 1},
+      {OpCode::PUSH_INT, 0},
+      {OpCode::DIV, 0},
+      {OpCode::HALT, 0},
+  });
+
+  BytecodeOptimizer optimizer(OptimizationLevel::O2);
+  auto stats = optimizer.optimize(script);
+
+  REQUIRE(stats.constantsFolded == 0);
+  REQUIRE(script.instructions.size() == 4);
+}
+
+TEST_CASE("BytecodeOptimizer threads jumps and removes dead code",
+          "[scripting][optimizer]") {
+  CompiledScript script = makeScript({
+      {OpCode::JUMP, 2},           // 0 -> 2 -> 5
+      {OpCode::PUSH_INT, 99},      // 1 unreachable
+      {OpCode::JUMP, 5},           // 2
+      {OpCode::PUSH_INT, 7},       // 3 unreachable
+      {OpCode::STORE_GLOBAL, 0},   // 4 unreachable
+      {OpCode::PUSH_INT, 1},       // 5 scene "end"
+      {OpCode::STORE_GLOBAL, 0},   // 6
+      {OpCode::HALT, 0},           // 7
+  });
+  script.stringTable = {"x"};
+  script.sceneEntryPoints["end"] = 5;
+
+  BytecodeOptimizer optimizer(OptimizationLevel::O1);
+  auto stats = optimizer.optimize(script);
+
+  REQUIRE(stats.jumpsThreaded > 0);
+  REQUIRE(stats.deadInstructionsRemoved > 0);
+  REQUIRE(script.instructions.size() == 3);
+  REQUIRE(script.sceneEntryPoints["end"] == 0);
+  REQUIRE(asInt(runAndRead(script, "x")) == 1);
+}
+
+TEST_CASE("BytecodeOptimizer ends reachability at GOTO_SCENE",
+          "[scripting][optimizer]") {
+  CompiledScript script = makeScript({
+      {OpCode::PUSH_INT, 1},       // 0 scene "start"
+      {OpCode::STORE_GLOBAL, 0},   // 1
+      {OpCode::GOTO_SCENE, 5},     // 2
+      {OpCode::PUSH_INT, 2},       // 3 unreachable
+      {OpCode::STORE_GLOBAL, 0},   // 4 unreachable
+      {OpCode::PUSH_INT, 3},       // 5 scene "end"
+      {OpCode::STORE_GLOBAL, 0},   // 6
+      {OpCode::HALT, 0},           // 7
+  });
+  script.stringTable = {"x"};
+  script.sceneEntryPoints["start"] = 0;
+  script.sceneEntryPoints["end"] = 5;
+
+  BytecodeOptimizer optimizer(OptimizationLevel::O1);
+  auto stats = optimizer.optimize(script);
+
+  REQUIRE(stats.deadInstructionsRemoved == 2);
+  REQUIRE(script.instructions.size() == 6);
+  REQUIRE(script.instructions[2].opcode == OpCode::GOTO_SCENE);
+  REQUIRE(script.instructions[2].operand == 3);
+  REQUIRE(script.sceneEntryPoints["end"] == 3);
+}
+
+TEST_CASE("BytecodeOptimizer simplifies constant and negated branches",
+          "[scripting][optimizer]") {
+  SECTION("constant false condition drops the branch body") {
+    CompiledScript script = makeScript({
+        {OpCode::PUSH_BOOL, 0},
+        {OpCode::JUMP_IF_NOT, 4},
+        {OpCode::PUSH_INT, 1},
+        {OpCode::STORE_GLOBAL, 0},
+        {OpCode::HALT, 0},
+    });
+    script.stringTable = {"x"};
+
+    BytecodeOptimizer optimizer(OptimizationLevel::O1);
+    auto stats = optimizer.optimize(script);
+
+    REQUIRE(stats.branchesSimplified == 1);
+    REQUIRE(script.instructions.size() == 1);
+    REQUIRE(script.instructions[0].opcode == OpCode::HALT);
+  }
+
+  SECTION("NOT before JUMP_IF_NOT becomes JUMP_IF") {
+    CompiledScript script = makeScript({
+        {OpCode::LOAD_GLOBAL, 0},
+        {OpCode::NOT, 0},
+        {OpCode::JUMP_IF_NOT, 5},
+        {OpCode::PUSH_INT, 1},
+        {OpCode::STORE_GLOBAL, 0},
+        {OpCode::HALT, 0},
+    });
+    script.stringTable = {"x"};
+
+    BytecodeOptimizer optimizer(OptimizationLevel::O1);
+    optimizer.optimize(script);
+
+    REQUIRE(script.instructions.size() == 5);
+    REQUIRE(script.instructions[1].opcode == OpCode::JUMP_IF);
+    REQUIRE(script.instructions[1].operand == 4);
+  }
+}
+
+TEST_CASE("BytecodeOptimizer fuses compare and branch at O2",
+          "[scripting][optimizer]") {
+  CompiledScript source = makeScript({
+      {OpCode::LOAD_GLOBAL, 0},   // 0
+      {OpCode::PUSH_INT, 3},      // 1
+      {OpCode::LT, 0},            // 2
+      {OpCode::JUMP_IF_NOT, 9},   // 3
+      {OpCode::LOAD_GLOBAL, 0},   // 4
+      {OpCode::PUSH_INT, 1},      // 5
+      {OpCode::ADD, 0},           // 6
+      {OpCode::STORE_GLOBAL, 0},  // 7
+      {OpCode::JUMP, 0},          // 8
+      {OpCode::HALT, 0},          // 9
+  });
+  source.stringTable = {"i"};
+
+  CompiledScript o1 = source;
+  BytecodeOptimizer(OptimizationLevel::O1).optimize(o1);
+  REQUIRE(o1.instructions.size() == source.instructions.size());
+
+  CompiledScript o2 = source;
+  auto stats = BytecodeOptimizer(OptimizationLevel::O2).optimize(o2);
+  REQUIRE(stats.branchesFused == 1);
+  REQUIRE(o2.instructions.size() == source.instructions.size() - 1);
+  REQUIRE(o2.instructions[2].opcode == OpCode::JUMP_IF_NOT_LT);
+  REQUIRE(o2.instructions[2].operand == 8);
+
+  REQUIRE(asInt(runAndRead(source, "i")) == 3);
+  REQUIRE(asInt(runAndRead(o2, "i")) == 3);
+}
+
+TEST_CASE("BytecodeOptimizer preserves compiled script behaviour",
+          "[scripting][optimizer]") {
+  CompiledScript original = compileSource(R"(
+    scene start {
+      set total = 2 * 3 + 4
+      if total > 5 {
+        set result = total - 1
+      } else {
+        set result = 0
+      }
+      if not (1 == 2) {
+        set negated = 1
+      }
+    }
+  )");
+
+  for (auto level : {OptimizationLevel::O1, OptimizationLevel::O2}) {
+    CompiledScript optimized = original;
+    auto stats = BytecodeOptimizer(level).optimize(optimized);
+
+    REQUIRE(stats.instructionsAfter < stats.instructionsBefore);
+    REQUIRE(optimized.sceneEntryPoints.at("start") == 0);
+    REQUIRE(asInt(runAndRead(optimized, "total")) ==
+            asInt(runAndRead(original, "total")));
+    REQUIRE(asInt(runAndRead(optimized, "result")) == 9);
+    REQUIRE(asInt(runAndRead(optimized, "negated")) == 1);
+  }
+}
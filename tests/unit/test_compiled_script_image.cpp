@@ -0,0 +1,148 @@
+#include <catch2/catch_test_macros.hpp>
+#include "NovelMind/core/types.hpp"
+#include "NovelMind/scripting/compiled_script_image.hpp"
+#include "NovelMind/scripting/vm.hpp"
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+using namespace NovelMind::scripting;
+using NovelMind::u32;
+using NovelMind::u8;
+
+namespace {
+
+CompiledScript makeSampleScript() {
+  CompiledScript script;
+  script.instructions = {
+      {OpCode::PUSH_INT, 5},      {OpCode::STORE_GLOBAL, 0},
+      {OpCode::PUSH_STRING, 1},   {OpCode::STORE_GLOBAL, 2},
+      {OpCode::HALT, 0},          {OpCode::PUSH_INT, 7},
+      {OpCode::STORE_GLOBAL, 0},  {OpCode::HALT, 0},
+  };
+  script.stringTable = {"score", "hello", "greeting"};
+  script.sceneEntryPoints = {{"intro", 0}, {"ending", 5}, {"middle", 2}};
+
+  CharacterDecl hero;
+  hero.id = "hero";
+  hero.displayName = "Hero";
+  hero.color = "#ff0000";
+  script.characters[hero.id] = hero;
+  return script;
+}
+
+} // namespace
+
+TEST_CASE("NMC2 round-trips a compiled script", "[scripting][nmc2]") {
+  CompiledScript original = makeSampleScript();
+  auto image = CompiledScriptImage::fromBuffer(serializeNmc2(original, 42));
+  REQUIRE(image.isOk());
+
+  const auto &view = image.value();
+  REQUIRE(view.engineVersion() == 42);
+  REQUIRE(view.instructions().size() == original.instructions.size());
+  for (std::size_t i = 0; i < original.instructions.size(); ++i) {
+    REQUIRE(view.instructions()[i].opcode == original.instructions[i].opcode);
+    REQUIRE(view.instructions()[i].operand ==
+            original.instructions[i].operand);
+  }
+
+  REQUIRE(view.strings().size() == 3);
+  REQUIRE(view.strings()[1] == "hello");
+
+  REQUIRE(view.sceneCount() == 3);
+  REQUIRE(view.sceneName(0) == "ending");
+  REQUIRE(view.findScene("middle").value() == 2);
+  REQUIRE_FALSE(view.findScene("missing").has_value());
+
+  CompiledScript restored = view.toCompiledScript();
+  REQUIRE(restored.stringTable == original.stringTable);
+  REQUIRE(restored.sceneEntryPoints == original.sceneEntryPoints);
+  REQUIRE(restored.characters.at("hero").displayName == "Hero");
+  REQUIRE(restored.characters.at("hero").color == "#ff0000");
+}
+
+TEST_CASE("NMC2 images load into the VM", "[scripting][nmc2]") {
+  const auto path =
+      (std::filesystem::temp_directory_path() / "novelmind_nmc2_test.nmc")
+          .string();
+  REQUIRE(writeNmc2(makeSampleScript(), path).isOk());
+
+  auto image = CompiledScriptImage::open(path);
+  REQUIRE(image.isOk());
+
+  auto shared =
+      std::make_shared<const CompiledScriptImage>(std::move(image).value());
+  VirtualMachine vm;
+  REQUIRE(vm.load(shared).isOk());
+  // Executes from the image's own sections rather than a copy
+  REQUIRE(vm.program().data() == shared->instructions().data());
+  REQUIRE(vm.strings().data() == shared->strings().data());
+  vm.run();
+  REQUIRE(asInt(vm.getVariable("score")) == 5);
+  REQUIRE(asString(vm.getVariable("greeting")) == "hello");
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("NMC2 rejects malformed images", "[scripting][nmc2]") {
+  std::vector<u8> bytes = serializeNmc2(makeSampleScript());
+
+  SECTION("wrong magic") {
+    bytes[3] = '1';
+    REQUIRE(CompiledScriptImage::fromBuffer(bytes).isError());
+  }
+
+  SECTION("truncated file") {
+    bytes.resize(bytes.size() - 8);
+    REQUIRE(CompiledScriptImage::fromBuffer(bytes).isError());
+  }
+
+  SECTION("section out of bounds") {
+    Nmc2Header header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    header.instructionCount = 0x10000000u;
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    REQUIRE(CompiledScriptImage::fromBuffer(bytes).isError());
+  }
+
+  SECTION("unterminated string") {
+    Nmc2Header header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    bytes[header.stringBlobOffset + 5] = 'x'; // NUL after "score"
+    REQUIRE(CompiledScriptImage::fromBuffer(bytes).isError());
+  }
+}
+
+TEST_CASE("NMC2 load benchmark", "[.][benchmark][nmc2]") {
+  CompiledScript script;
+  for (u32 i = 0; i < 200000; ++i) {
+    script.instructions.emplace_back(OpCode::PUSH_STRING, i % 1000);
+    script.instructions.emplace_back(OpCode::POP);
+  }
+  script.instructions.emplace_back(OpCode::HALT);
+  for (u32 i = 0; i < 1000; ++i) {
+    script.stringTable.push_back("line " + std::to_string(i));
+  }
+
+  const auto path =
+      (std::filesystem::temp_directory_path() / "novelmind_nmc2_bench.nmc")
+          .string();
+  REQUIRE(writeNmc2(script, path).isOk());
+
+  auto start = std::chrono::steady_clock::now();
+  auto image = CompiledScriptImage::open(path);
+  REQUIRE(image.isOk());
+  VirtualMachine vm;
+  REQUIRE(vm.load(std::make_shared<const CompiledScriptImage>(
+                      std::move(image).value()))
+              .isOk());
+  auto elapsed = std::chrono::duration<double, std::milli>(
+                     std::chrono::steady_clock::now() - start)
+                     .count();
+
+  std::cout << "NMC2 open + VM load of " << script.instructions.size()
+            << " instructions: " << elapsed << " ms\n";
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,294 @@
+#include <catch2/catch_test_macros.hpp>
+#include "NovelMind/core/application.hpp"
+#include "NovelMind/resource/decoded_asset_cache.hpp"
+#include "NovelMind/resource/resource_manager.hpp"
+#include "NovelMind/scripting/lexer.hpp"
+#include "NovelMind/scripting/parser.hpp"
+#include "NovelMind/vfs/memory_fs.hpp"
+#include "test_helpers.hpp"
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace NovelMind;
+using namespace NovelMind::resource;
+using namespace NovelMind::test;
+
+namespace {
+
+DecodedImage solidImage(i32 width, i32 height, u8 value) {
+  DecodedImage image;
+  image.width = width;
+  image.height = height;
+  image.pixels = SharedBuffer(std::vector<u8>(
+      static_cast<usize>(width) * static_cast<usize>(height) * 4, value));
+  return image;
+}
+
+DecodedAssetKey imageKey(const std::string &id, u32 checksum = 1) {
+  return DecodedAssetKey{DecodedAssetKind::Image, id, {}, checksum};
+}
+
+usize countFiles(const std::string &directory) {
+  usize count = 0;
+  for ([[maybe_unused]] const auto &file :
+       std::filesystem::directory_iterator(directory)) {
+    ++count;
+  }
+  return count;
+}
+
+} // namespace
+
+TEST_CASE("DecodedAssetCache keeps decoded images between instances",
+          "[resource][decoded_cache]") {
+  const ScratchDirectory scratch("novelmind_decoded_cache_images");
+  const auto &directory = scratch.path();
+  {
+    DecodedAssetCache cache({directory});
+    REQUIRE_FALSE(cache.loadImage(imageKey("bg/room.png")).has_value());
+    REQUIRE(cache.storeImage(imageKey("bg/room.png"), solidImage(4, 2, 9))
+                .isError());
+
+    REQUIRE(cache.open().isOk());
+    REQUIRE(cache.storeImage(imageKey("bg/room.png"), solidImage(4, 2, 9))
+                .isOk());
+    REQUIRE(cache.stats().stores == 1);
+  }
+
+  DecodedAssetCache cache({directory});
+  REQUIRE(cache.open().isOk());
+  REQUIRE(cache.stats().entryCount == 1);
+
+  auto image = cache.loadImage(imageKey("bg/room.png"));
+  REQUIRE(image.has_value());
+  REQUIRE(image->width == 4);
+  REQUIRE(image->height == 2);
+  REQUIRE(image->pixels.toVector() == std::vector<u8>(32, 9));
+  REQUIRE(cache.stats().hits == 1);
+
+  SECTION("a changed source misses and drops the entry") {
+    REQUIRE_FALSE(cache.loadImage(imageKey("bg/room.png", 2)).has_value());
+    REQUIRE(cache.stats().entryCount == 0);
+    REQUIRE(countFiles(directory) == 0);
+  }
+
+  SECTION("entries are only valid for the engine that wrote them") {
+    DecodedAssetCache newer({directory, 1024 * 1024, kEngineVersion + 1});
+    REQUIRE(newer.open().isOk());
+    REQUIRE_FALSE(newer.loadImage(imageKey("bg/room.png")).has_value());
+    REQUIRE(newer.storeImage(imageKey("bg/room.png"), solidImage(1, 1, 3))
+                .isOk());
+    REQUIRE(newer.loadImage(imageKey("bg/room.png"))->pixels[0] == 3);
+  }
+
+  SECTION("kinds and variants are separate entries") {
+    auto other = imageKey("bg/room.png");
+    other.variant = "half";
+    REQUIRE_FALSE(cache.loadImage(other).has_value());
+    other.kind = DecodedAssetKind::Script;
+    other.variant.clear();
+    REQUIRE_FALSE(cache.load(other).has_value());
+  }
+}
+
+TEST_CASE("DecodedAssetCache evicts the least recently used entries",
+          "[resource][decoded_cache]") {
+  const ScratchDirectory scratch("novelmind_decoded_cache_evict");
+  const auto &directory = scratch.path();
+  // Header plus 4x4 RGBA is 128 bytes; room for three entries
+  DecodedAssetCache cache({directory, 400});
+  REQUIRE(cache.open().isOk());
+
+  REQUIRE(cache.storeImage(imageKey("a"), solidImage(4, 4, 1)).isOk());
+  REQUIRE(cache.storeImage(imageKey("b"), solidImage(4, 4, 2)).isOk());
+  REQUIRE(cache.storeImage(imageKey("c"), solidImage(4, 4, 3)).isOk());
+  REQUIRE(cache.loadImage(imageKey("a")).has_value());
+
+  REQUIRE(cache.storeImage(imageKey("d"), solidImage(4, 4, 4)).isOk());
+  auto stats = cache.stats();
+  REQUIRE(stats.evictions == 1);
+  REQUIRE(stats.entryCount == 3);
+  REQUIRE(stats.totalBytes <= 400);
+  REQUIRE(countFiles(directory) == 3);
+  REQUIRE_FALSE(cache.loadImage(imageKey("b")).has_value());
+  REQUIRE(cache.loadImage(imageKey("a")).has_value());
+
+  // Larger than the whole budget: never written
+  REQUIRE(cache.storeImage(imageKey("huge"), solidImage(16, 16, 5)).isOk());
+  REQUIRE_FALSE(cache.loadImage(imageKey("huge")).has_value());
+
+  // A smaller budget is enforced when the directory is opened
+  DecodedAssetCache smaller({directory, 200});
+  REQUIRE(smaller.open().isOk());
+  REQUIRE(smaller.stats().entryCount == 1);
+  REQUIRE(countFiles(directory) == 1);
+}
+
+TEST_CASE("DecodedAssetCache stores font atlases and compiled scripts",
+          "[resource][decoded_cache]") {
+  const ScratchDirectory scratch("novelmind_decoded_cache_kinds");
+  const auto &directory = scratch.path();
+  DecodedAssetCache cache({directory});
+  REQUIRE(cache.open().isOk());
+
+  renderer::FontAtlasImage atlas;
+  atlas.image.width = 2;
+  atlas.image.height = 2;
+  atlas.image.pixels = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+  atlas.lineHeight = 19;
+  atlas.glyphs[U'A'].advanceX = 7.5f;
+  atlas.glyphs[U'A'].uv = renderer::Rect(0.0f, 0.5f, 0.5f, 0.5f);
+  atlas.glyphs[U' '].advanceX = 3.0f;
+
+  const DecodedAssetKey atlasKey{DecodedAssetKind::FontAtlas, "fonts/ui.ttf",
+                                 "24:A ", 77};
+  REQUIRE(cache.storeFontAtlas(atlasKey, atlas).isOk());
+  auto loaded = cache.loadFontAtlas(atlasKey);
+  REQUIRE(loaded.has_value());
+  REQUIRE(loaded->image.pixels == atlas.image.pixels);
+  REQUIRE(loaded->lineHeight == 19);
+  REQUIRE(loaded->glyphs.size() == 2);
+  REQUIRE(loaded->glyphs.at(U'A').advanceX == 7.5f);
+  REQUIRE(loaded->glyphs.at(U'A').uv.y == 0.5f);
+
+  scripting::Lexer lexer;
+  auto tokens = lexer.tokenize(R"(
+character Hero(name="Hero")
+scene intro {
+    say Hero "Hello"
+    goto outro
+}
+scene outro {
+    say Hero "Bye"
+})");
+  REQUIRE(tokens.isOk());
+  scripting::Parser parser;
+  auto program = parser.parse(tokens.value());
+  REQUIRE(program.isOk());
+  scripting::Compiler compiler;
+  auto script = compiler.compile(program.value());
+  REQUIRE(script.isOk());
+
+  const DecodedAssetKey scriptKey{DecodedAssetKind::Script, "game.nms", {},
+                                  123};
+  REQUIRE(cache.storeScript(scriptKey, script.value()).isOk());
+  auto restored = cache.loadScript(scriptKey);
+  REQUIRE(restored.has_value());
+  REQUIRE(restored->instructions.size() ==
+          script.value().instructions.size());
+  for (usize i = 0; i < restored->instructions.size(); ++i) {
+    REQUIRE(restored->instructions[i].opcode ==
+            script.value().instructions[i].opcode);
+    REQUIRE(restored->instructions[i].operand ==
+            script.value().instructions[i].operand);
+  }
+  REQUIRE(restored->stringTable == script.value().stringTable);
+  REQUIRE(restored->sceneEntryPoints == script.value().sceneEntryPoints);
+}
+
+TEST_CASE("ResourceManager skips decoding textures found in the cache",
+          "[resource][decoded_cache]") {
+  const ScratchDirectory scratch("novelmind_decoded_cache_manager");
+  const auto &directory = scratch.path();
+  vfs::MemoryFileSystem fs;
+  fs.addResource("bg/room.ppm", ppmImage(3, 2, 200),
+                 vfs::ResourceType::Texture);
+
+  {
+    DecodedAssetCache cache({directory});
+    REQUIRE(cache.open().isOk());
+    ResourceManager resources(&fs);
+    resources.setDecodedAssetCache(&cache);
+    REQUIRE(resources.loadTexture("bg/room.ppm").isOk());
+    REQUIRE(cache.stats().misses == 1);
+    REQUIRE(cache.stats().stores == 1);
+  }
+
+  // Next launch
+  DecodedAssetCache cache({directory});
+  REQUIRE(cache.open().isOk());
+  ResourceManager resources(&fs);
+  resources.setDecodedAssetCache(&cache);
+  auto texture = resources.loadTexture("bg/room.ppm");
+  REQUIRE(texture.isOk());
+  REQUIRE(texture.value()->getWidth() == 3);
+  REQUIRE(texture.value()->getHeight() == 2);
+  REQUIRE(cache.stats().hits == 1);
+  REQUIRE(cache.stats().stores == 0);
+
+  SECTION("asynchronous loads use the cache too") {
+    resources.unloadTexture("bg/room.ppm");
+    auto handle =
+        resources.requestTexture("bg/room.ppm", LoadPriority::Immediate);
+    while (!handle.isDone()) {
+      resources.update(1000.0);
+    }
+    REQUIRE(handle.isReady());
+    REQUIRE(cache.stats().hits == 2);
+  }
+
+  SECTION("changed source bytes are decoded again") {
+    resources.clearCache();
+    fs.addResource("bg/room.ppm", ppmImage(5, 5, 10),
+                   vfs::ResourceType::Texture);
+    auto changed = resources.loadTexture("bg/room.ppm");
+    REQUIRE(changed.isOk());
+    REQUIRE(changed.value()->getWidth() == 5);
+    REQUIRE(cache.stats().misses == 1);
+    REQUIRE(cache.stats().stores == 1);
+  }
+}
+
+TEST_CASE("Application opens the configured decoded asset cache",
+          "[resource][decoded_cache]") {
+  const ScratchDirectory scratch("novelmind_decoded_cache_app");
+  const auto directory = scratch.path() + "/cache";
+  core::EngineConfig config;
+  config.window.title = "decoded cache";
+  config.decodedCacheDirectory = directory;
+
+  core::Application app;
+  REQUIRE(app.initialize(config).isOk());
+  REQUIRE(std::filesystem::is_directory(directory));
+  app.shutdown();
+}
+
+TEST_CASE("DecodedAssetCache cold and warm texture startup",
+          "[.][benchmark][decoded_cache]") {
+  using Clock = std::chrono::steady_clock;
+  constexpr int kTextures = 32;
+  const ScratchDirectory scratch("novelmind_decoded_cache_bench");
+  const auto &directory = scratch.path();
+
+  vfs::MemoryFileSystem fs;
+  for (int i = 0; i < kTextures; ++i) {
+    fs.addResource("bg/" + std::to_string(i) + ".ppm",
+                   ppmImage(1024, 1024, static_cast<u8>(i)),
+                   vfs::ResourceType::Texture);
+  }
+
+  const auto launch = [&](bool useCache) {
+    DecodedAssetCache cache({directory, 512 * 1024 * 1024});
+    REQUIRE(cache.open().isOk());
+    ResourceManager resources(&fs);
+    if (useCache) {
+      resources.setDecodedAssetCache(&cache);
+    }
+    const auto start = Clock::now();
+    for (int i = 0; i < kTextures; ++i) {
+      REQUIRE(resources.loadTexture("bg/" + std::to_string(i) + ".ppm")
+                  .isOk());
+    }
+    return std::chrono::duration<double, std::milli>(Clock::now() - start)
+        .count();
+  };
+
+  const double uncached = launch(false);
+  const double cold = launch(true);
+  const double warm = launch(true);
+  std::cout << kTextures << " 1024x1024 textures: no cache " << uncached
+            << " ms, cold " << cold << " ms, warm " << warm << " ms\n";
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+/**
+ * @file test_helpers.hpp
+ * @brief Scratch files and images shared by the unit tests
+ */
+
+#include "NovelMind/core/types.hpp"
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace NovelMind::test {
+
+/**
+ * @brief Empty directory under the system temp path, removed with its
+ *        contents when this goes out of scope
+ *
+ * The name gets a suffix unique to this process, so parallel ctest runs
+ * never share it. Declare it before anything that keeps files open in it.
+ */
+class ScratchDirectory {
+public:
+  explicit ScratchDirectory(const std::string &name) {
+    static const std::string suffix = std::to_string(std::random_device{}());
+    m_path = (std::filesystem::temp_directory_path() / (name + "_" + suffix))
+                 .string();
+    std::filesystem::remove_all(m_path);
+    std::filesystem::create_directories(m_path);
+  }
+
+  ~ScratchDirectory() {
+    std::error_code ec;
+    std::filesystem::remove_all(m_path, ec);
+  }
+
+  ScratchDirectory(const ScratchDirectory &) = delete;
+  ScratchDirectory &operator=(const ScratchDirectory &) = delete;
+
+  [[nodiscard]] const std::string &path() const { return m_path; }
+
+private:
+  std::string m_path;
+};
+
+/// Write @p bytes to @p path, creating parent directories as needed
+inline void writeFile(const std::filesystem::path &path,
+                      const std::vector<u8> &bytes) {
+  std::filesystem::create_directories(path.parent_path());
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char *>(bytes.data()),
+             static_cast<std::streamsize>(bytes.size()));
+}
+
+/// Binary PPM of one colour, which stb decodes like any other format
+inline std::vector<u8> ppmImage(i32 width, i32 height, u8 r, u8 g, u8 b) {
+  const std::string header = "P6\n" + std::to_string(width) + " " +
+                             std::to_string(height) + "\n255\n";
+  std::vector<u8> bytes(header.begin(), header.end());
+  bytes.reserve(bytes.size() +
+                static_cast<usize>(width) * static_cast<usize>(height) * 3);
+  for (i32 i = 0; i < width * height; ++i) {
+    bytes.insert(bytes.end(), {r, g, b});
+  }
+  return bytes;
+}
+
+/// Grey PPM with every channel set to @p value
+inline std::vector<u8> ppmImage(i32 width, i32 height, u8 value) {
+  return ppmImage(width, height, value, value, value);
+}
+
+} // namespace NovelMind::test
@@ -1,6 +1,10 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_approx.hpp>
 #include "NovelMind/scripting/lexer.hpp"
+#include "NovelMind/scripting/parser.hpp"
+#include <chrono>
+#include <iostream>
+#include <string>
 
 using namespace NovelMind::scripting;
 
@@ -240,3 +244,119 @@ TEST_CASE("Lexer reports errors", "[lexer]")
         REQUIRE(result.isError());
     }
 }
+
+TEST_CASE("Lexer view mode borrows lexemes from the source", "[lexer]")
+{
+    const std::string source = "say Hero \"plain\" \"tab\\there\" 42 1.5 #FFCC00";
+    NovelMind::core::Arena arena;
+    Lexer lexer;
+
+    auto result = lexer.tokenizeViews(source, arena);
+    REQUIRE(result.isOk());
+
+    const auto& tokens = result.value();
+    REQUIRE(tokens.size() == 8);
+
+    auto inSource = [&source](std::string_view view) {
+        return view.data() >= source.data() &&
+               view.data() + view.size() <= source.data() + source.size();
+    };
+
+    SECTION("identifiers, numbers and unescaped strings point into the source")
+    {
+        REQUIRE(tokens[1].lexeme == "Hero");
+        REQUIRE(inSource(tokens[1].lexeme));
+        REQUIRE(tokens[2].lexeme == "plain");
+        REQUIRE(inSource(tokens[2].lexeme));
+        REQUIRE(tokens[4].intValue == 42);
+        REQUIRE(tokens[5].floatValue == Catch::Approx(1.5f));
+        REQUIRE(tokens[6].lexeme == "#FFCC00");
+        REQUIRE(inSource(tokens[6].lexeme));
+    }
+
+    SECTION("only escaped strings are decoded into the arena")
+    {
+        REQUIRE(tokens[3].lexeme == "tab\there");
+        REQUIRE_FALSE(inSource(tokens[3].lexeme));
+        REQUIRE(arena.bytesUsed() == std::string("tab\\there").size());
+    }
+
+    SECTION("matches the owning token stream")
+    {
+        Lexer owning;
+        auto owned = owning.tokenize(source);
+        REQUIRE(owned.isOk());
+        REQUIRE(owned.value().size() == tokens.size());
+        for (size_t i = 0; i < tokens.size(); ++i) {
+            REQUIRE(owned.value()[i].type == tokens[i].type);
+            REQUIRE(owned.value()[i].lexeme == tokens[i].lexeme);
+            REQUIRE(owned.value()[i].location.column == tokens[i].location.column);
+        }
+    }
+}
+
+TEST_CASE("Parser consumes view tokens", "[lexer][parser]")
+{
+    const std::string source = R"(
+        character Hero(name="Hero", color="#ff0000")
+        scene intro {
+            say Hero "Line one\nLine two"
+        }
+    )";
+
+    NovelMind::core::Arena arena;
+    Lexer lexer;
+    auto tokens = lexer.tokenizeViews(source, arena);
+    REQUIRE(tokens.isOk());
+
+    Parser parser;
+    auto program = parser.parse(tokens.value());
+    REQUIRE(program.isOk());
+    REQUIRE(program.value().characters.size() == 1);
+    REQUIRE(program.value().characters[0].color == "#ff0000");
+    REQUIRE(program.value().scenes.size() == 1);
+    REQUIRE(program.value().scenes[0].name == "intro");
+}
+
+TEST_CASE("Lexer rejects out-of-range numbers", "[lexer]")
+{
+    Lexer lexer;
+    auto result = lexer.tokenize("set x = 99999999999999999999");
+    REQUIRE(result.isError());
+}
+
+TEST_CASE("Lexer throughput on a 10 MB script", "[.][benchmark][lexer]")
+{
+    std::string source;
+    source.reserve(10 * 1024 * 1024 + 256);
+    for (int i = 0; source.size() < 10 * 1024 * 1024; ++i) {
+        const std::string n = std::to_string(i);
+        source += "scene s" + n + " {\n"
+                  "    say Hero \"Line " + n + " of the story\"\n"
+                  "    set counter = counter + " + n + " // running total\n"
+                  "    if counter >= 1.5 { goto s" + n + " }\n"
+                  "    say Hero \"Quote: \\\"escaped\\\"\"\n"
+                  "}\n";
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    Lexer lexer;
+    auto start = Clock::now();
+    auto owned = lexer.tokenize(source);
+    auto ownedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    REQUIRE(owned.isOk());
+
+    NovelMind::core::Arena arena;
+    start = Clock::now();
+    auto views = lexer.tokenizeViews(source, arena);
+    auto viewMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    REQUIRE(views.isOk());
+    REQUIRE(views.value().size() == owned.value().size());
+
+    std::cout << "Lexed " << source.size() / (1024 * 1024) << " MB into "
+              << views.value().size() << " tokens: tokenize() " << ownedMs
+              << " ms, tokenizeViews() " << viewMs << " ms (arena "
+              << arena.bytesUsed() << " bytes in " << arena.blockCount()
+              << " blocks)\n";
+}
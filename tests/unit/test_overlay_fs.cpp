@@ -0,0 +1,288 @@
+#include <catch2/catch_test_macros.hpp>
+#include "NovelMind/resource/resource_manager.hpp"
+#include "NovelMind/vfs/file_watcher.hpp"
+#include "NovelMind/vfs/layered_file_system.hpp"
+#include "NovelMind/vfs/memory_fs.hpp"
+#include "NovelMind/vfs/virtual_file_system.hpp"
+#include "test_helpers.hpp"
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace NovelMind;
+using namespace NovelMind::VFS;
+using namespace NovelMind::test;
+
+namespace {
+
+// Events may trail the write slightly; wait for the first non-empty poll
+template <typename Poll> auto pollUntilChanged(Poll &&poll) {
+  auto changes = poll();
+  for (int i = 0; i < 200 && changes.empty(); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    changes = poll();
+  }
+  return changes;
+}
+
+void checkWatcher(FileWatcher &watcher, const std::string &root) {
+  REQUIRE(watcher.start().isOk());
+  REQUIRE(watcher.poll().empty());
+
+  writeFile(root + "/a.txt", {1, 2, 3});
+  auto changes = pollUntilChanged([&] { return watcher.poll(); });
+  REQUIRE(changes.size() == 1);
+  REQUIRE(changes[0].path == "a.txt");
+  REQUIRE(changes[0].kind == FileChangeKind::Added);
+
+  // Written twice between polls: reported once
+  writeFile(root + "/a.txt", {4});
+  writeFile(root + "/a.txt", {5, 6});
+  changes = pollUntilChanged([&] { return watcher.poll(); });
+  REQUIRE(changes.size() == 1);
+  REQUIRE(changes[0].kind == FileChangeKind::Modified);
+
+  // New directories are picked up with what is already in them
+  writeFile(root + "/sub/deep/b.txt", {7});
+  changes = pollUntilChanged([&] { return watcher.poll(); });
+  REQUIRE(changes.size() == 1);
+  REQUIRE(changes[0].path == "sub/deep/b.txt");
+  REQUIRE(changes[0].kind == FileChangeKind::Added);
+
+  writeFile(root + "/sub/deep/b.txt", {8, 8, 8, 8});
+  std::filesystem::remove(root + "/a.txt");
+  changes = pollUntilChanged([&] { return watcher.poll(); });
+  REQUIRE(changes.size() == 2);
+  for (const auto &change : changes) {
+    REQUIRE(change.kind == (change.path == "a.txt"
+                                ? FileChangeKind::Removed
+                                : FileChangeKind::Modified));
+  }
+
+  watcher.stop();
+  writeFile(root + "/c.txt", {9});
+  REQUIRE(watcher.poll().empty());
+}
+
+} // namespace
+
+TEST_CASE("FileWatcher reports coalesced changes under a tree",
+          "[vfs][hot_reload]") {
+  SECTION("notifications where available") {
+    const ScratchDirectory scratch("novelmind_watch_notify");
+    const auto &root = scratch.path();
+    FileWatcher watcher(root);
+    checkWatcher(watcher, root);
+  }
+
+  SECTION("rescanning") {
+    const ScratchDirectory scratch("novelmind_watch_scan");
+    const auto &root = scratch.path();
+    FileWatcher watcher(root, {true, 0});
+    checkWatcher(watcher, root);
+    REQUIRE_FALSE(watcher.usesNotifications());
+  }
+
+  SECTION("missing roots are an error") {
+    const ScratchDirectory scratch("novelmind_watch_missing");
+    FileWatcher watcher(scratch.path() + "/none");
+    REQUIRE(watcher.start().isError());
+    REQUIRE(watcher.poll().empty());
+  }
+}
+
+TEST_CASE("OverlayBackend invalidates only the changed cache entries",
+          "[vfs][hot_reload]") {
+  const ScratchDirectory scratch("novelmind_overlay");
+  const auto &root = scratch.path();
+  writeFile(root + "/data/edited.bin", {1});
+
+  VirtualFileSystem vfs;
+  auto packed = std::make_unique<MemoryBackend>();
+  packed->addResource("bg/room.png", {10});
+  packed->addResource("data/other.bin", {20});
+  vfs.registerBackend(std::move(packed));
+  auto overlay = std::make_unique<OverlayBackend>(root);
+  OverlayBackend *watched = overlay.get();
+  vfs.registerBackend(std::move(overlay));
+  REQUIRE(vfs.initialize().isOk());
+  REQUIRE(watched->isWatching());
+
+  std::vector<ResourceChange> heard;
+  vfs.setChangeCallback([&heard](const std::vector<ResourceChange> &changes) {
+    heard.insert(heard.end(), changes.begin(), changes.end());
+  });
+
+  const std::vector<ResourceId> ids = {ResourceId("bg/room.png"),
+                                       ResourceId("data/other.bin"),
+                                       ResourceId("data/edited.bin")};
+  REQUIRE(vfs.preload(ids) == 3);
+  REQUIRE(vfs.stats().loadedResources == 3);
+  REQUIRE(vfs.pollChanges().empty());
+  REQUIRE(heard.empty());
+
+  // Shadow a packed resource and edit an overlay one
+  writeFile(root + "/bg/room.png", {11});
+  writeFile(root + "/data/edited.bin", {2});
+  auto changes = pollUntilChanged([&] { return vfs.pollChanges(); });
+  while (changes.size() < 2) {
+    auto more = pollUntilChanged([&] { return vfs.pollChanges(); });
+    REQUIRE_FALSE(more.empty());
+    changes.insert(changes.end(), more.begin(), more.end());
+  }
+  REQUIRE(changes.size() == 2);
+  REQUIRE(heard.size() == 2);
+  REQUIRE(vfs.stats().loadedResources == 1);
+
+  REQUIRE(vfs.readShared(ResourceId("bg/room.png")).value()[0] == 11);
+  REQUIRE(vfs.readShared(ResourceId("data/edited.bin")).value()[0] == 2);
+  REQUIRE(vfs.readShared(ResourceId("data/other.bin")).value()[0] == 20);
+  REQUIRE(vfs.stats().cacheStats.hitCount >= 1);
+
+  SECTION("the journal answers what changed since a sequence number") {
+    REQUIRE(watched->lastSequence() == 2);
+    REQUIRE(watched->changesSince(0).size() == 2);
+    const auto later = watched->changesSince(1);
+    REQUIRE(later.size() == 1);
+    REQUIRE(later[0].sequence == 2);
+    REQUIRE(watched->changesSince(2).empty());
+  }
+
+  SECTION("removing the overlay file reveals the packed one") {
+    std::filesystem::remove(root + "/bg/room.png");
+    changes = pollUntilChanged([&] { return vfs.pollChanges(); });
+    REQUIRE(changes.size() == 1);
+    REQUIRE(changes[0].kind == FileChangeKind::Removed);
+    REQUIRE(changes[0].id.id() == "bg/room.png");
+    REQUIRE(vfs.readShared(ResourceId("bg/room.png")).value()[0] == 10);
+  }
+
+  vfs.shutdown();
+}
+
+TEST_CASE("ResourceManager reloads changed assets in place",
+          "[resource][hot_reload]") {
+  vfs::MemoryFileSystem fs;
+  fs.addResource("bg/room.ppm", ppmImage(2, 2, 10),
+                 vfs::ResourceType::Texture);
+  fs.addResource("bg/hall.ppm", ppmImage(3, 3, 20),
+                 vfs::ResourceType::Texture);
+  resource::ResourceManager resources(&fs);
+
+  std::vector<std::string> heard;
+  resources.addReloadListener(
+      [&heard](const std::string &id) { heard.push_back(id); });
+
+  auto room = resources.loadTexture("bg/room.ppm").value();
+  auto hall = resources.loadTexture("bg/hall.ppm").value();
+  REQUIRE(room->getWidth() == 2);
+
+  fs.addResource("bg/room.ppm", ppmImage(4, 5, 30),
+                 vfs::ResourceType::Texture);
+  REQUIRE(resources.reload("bg/room.ppm") == 1);
+  // The handle already held sees the new image
+  REQUIRE(room->getWidth() == 4);
+  REQUIRE(room->getHeight() == 5);
+  REQUIRE(resources.loadTexture("bg/room.ppm").value() == room);
+  REQUIRE(hall->getWidth() == 3);
+
+  // Broken saves keep the last good asset
+  fs.addResource("bg/room.ppm", {1, 2, 3}, vfs::ResourceType::Texture);
+  REQUIRE(resources.reload("bg/room.ppm") == 0);
+  REQUIRE(room->getWidth() == 4);
+
+  // Ids nobody loaded only reach the listeners
+  REQUIRE(resources.reload("music/theme.ogg") == 0);
+  REQUIRE(heard == std::vector<std::string>{"bg/room.ppm", "bg/room.ppm",
+                                            "music/theme.ogg"});
+  REQUIRE(resources.reloadAll() == 1);
+}
+
+TEST_CASE("LayeredFileSystem drives hot reload from an overlay",
+          "[vfs][resource][hot_reload]") {
+  const ScratchDirectory scratch("novelmind_layered_overlay");
+  const auto &root = scratch.path();
+  vfs::LayeredFileSystem files;
+  auto packed = std::make_unique<MemoryBackend>();
+  packed->addResource("bg/room.ppm", ppmImage(2, 2, 10),
+                      ResourceType::Texture);
+  packed->addResource("sfx/door.ogg", {1, 2, 3}, ResourceType::Audio);
+  files.layers().registerBackend(std::move(packed));
+  auto overlay = std::make_unique<OverlayBackend>(root);
+  OverlayBackend *watched = overlay.get();
+  files.layers().registerBackend(std::move(overlay));
+  REQUIRE(files.layers().initialize().isOk());
+
+  REQUIRE(files.exists("bg/room.ppm"));
+  REQUIRE(files.getInfo("sfx/door.ogg")->type == vfs::ResourceType::Audio);
+  REQUIRE(files.listResources(vfs::ResourceType::Texture) ==
+          std::vector<std::string>{"bg/room.ppm"});
+
+  resource::ResourceManager resources(&files);
+  std::vector<std::string> heard;
+  resources.addReloadListener(
+      [&heard](const std::string &id) { heard.push_back(id); });
+  auto room = resources.loadTexture("bg/room.ppm").value();
+  REQUIRE(room->getWidth() == 2);
+  REQUIRE(resources.readShared("sfx/door.ogg").value().size() == 3);
+
+  // Saving loose copies shadows the packed assets
+  writeFile(root + "/bg/room.ppm", ppmImage(4, 5, 30));
+  writeFile(root + "/sfx/door.ogg", {4, 5});
+  std::vector<ResourceChange> changes;
+  while (changes.size() < 2) {
+    auto more = pollUntilChanged([&] { return files.layers().pollChanges(); });
+    REQUIRE_FALSE(more.empty());
+    changes.insert(changes.end(), more.begin(), more.end());
+  }
+  for (const auto &change : changes) {
+    resources.reload(change.id.id());
+  }
+
+  REQUIRE(room->getWidth() == 4);
+  REQUIRE(room->getHeight() == 5);
+  REQUIRE(resources.readShared("sfx/door.ogg").value().size() == 2);
+  REQUIRE(heard.size() == 2);
+  REQUIRE(watched->lastSequence() == 2);
+
+  files.layers().shutdown();
+}
+
+TEST_CASE("Hot reload of one asset against clearing everything",
+          "[.][benchmark][hot_reload]") {
+  using Clock = std::chrono::steady_clock;
+  constexpr int kTextures = 200;
+  vfs::MemoryFileSystem fs;
+  for (int i = 0; i < kTextures; ++i) {
+    fs.addResource("bg/" + std::to_string(i) + ".ppm",
+                   ppmImage(256, 256, static_cast<u8>(i)),
+                   vfs::ResourceType::Texture);
+  }
+  resource::ResourceManager resources(&fs);
+  const auto loadAll = [&] {
+    for (int i = 0; i < kTextures; ++i) {
+      REQUIRE(resources.loadTexture("bg/" + std::to_string(i) + ".ppm")
+                  .isOk());
+    }
+  };
+  loadAll();
+
+  fs.addResource("bg/7.ppm", ppmImage(256, 256, 99),
+                 vfs::ResourceType::Texture);
+  auto start = Clock::now();
+  resources.clearCache();
+  loadAll();
+  const double cleared =
+      std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+  start = Clock::now();
+  REQUIRE(resources.reload("bg/7.ppm") == 1);
+  const double precise =
+      std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+  std::cout << kTextures << " textures, one edited: clear and reload "
+            << cleared << " ms, reload changed " << precise << " ms\n";
+}
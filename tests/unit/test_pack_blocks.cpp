@@ -0,0 +1,184 @@
+#include <catch2/catch_test_macros.hpp>
+#include "NovelMind/vfs/pack_blocks.hpp"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+using namespace NovelMind::vfs;
+using NovelMind::u32;
+using NovelMind::u64;
+using NovelMind::u8;
+using NovelMind::usize;
+
+namespace {
+
+// Compressible but not trivially so: text-like runs with some noise
+std::vector<u8> makeData(usize size, u32 seed = 7) {
+  std::mt19937 rng(seed);
+  const char *words[] = {"scene ", "say ", "Hero ", "\"Hello\" ", "goto ",
+                         "choice ", "{\n", "}\n", "set ", "flag "};
+  std::vector<u8> data;
+  data.reserve(size);
+  while (data.size() < size) {
+    const char *word = words[rng() % 10];
+    data.insert(data.end(), word, word + std::strlen(word));
+    if (rng() % 8 == 0) {
+      data.push_back(static_cast<u8>(rng()));
+    }
+  }
+  data.resize(size);
+  return data;
+}
+
+BlockCodec bestAvailableCodec() {
+  for (auto codec : {BlockCodec::Zstd, BlockCodec::Lz4, BlockCodec::Zlib}) {
+    if (isBlockCodecAvailable(codec)) {
+      return codec;
+    }
+  }
+  return BlockCodec::None;
+}
+
+} // namespace
+
+TEST_CASE("Block encoding round-trips", "[vfs][blocks]") {
+  const auto data = makeData(300 * 1000);
+  for (auto codec : {BlockCodec::None, BlockCodec::Zlib, BlockCodec::Lz4,
+                     BlockCodec::Zstd}) {
+    INFO("codec " << blockCodecName(codec));
+    if (!isBlockCodecAvailable(codec)) {
+      REQUIRE(encodeBlocks(data, codec).isError());
+      continue;
+    }
+
+    auto encoded = encodeBlocks(data, codec, 64 * 1024, 2);
+    REQUIRE(encoded.isOk());
+    if (codec != BlockCodec::None) {
+      REQUIRE(encoded.value().size() < data.size());
+    }
+
+    auto resource = BlockedResource::open(encoded.value());
+    REQUIRE(resource.isOk());
+    REQUIRE(resource.value().size() == data.size());
+    REQUIRE(resource.value().blockCount() == 5);
+    REQUIRE(resource.value().blockLength(4) == 300 * 1000 - 4 * 64 * 1024);
+
+    auto serial = resource.value().readAll();
+    REQUIRE(serial.isOk());
+    REQUIRE(serial.value() == data);
+    auto parallel = resource.value().readAll(4);
+    REQUIRE(parallel.isOk());
+    REQUIRE(parallel.value() == data);
+  }
+}
+
+TEST_CASE("Block ranges decode only what they cover", "[vfs][blocks]") {
+  const auto data = makeData(200 * 1000);
+  auto encoded = encodeBlocks(data, bestAvailableCodec(), 16 * 1024);
+  REQUIRE(encoded.isOk());
+  auto resource = BlockedResource::open(encoded.value());
+  REQUIRE(resource.isOk());
+
+  // Spans a block boundary, then runs past the end
+  std::vector<u8> out(40 * 1000);
+  auto read = resource.value().read(15 * 1024, out);
+  REQUIRE(read.isOk());
+  REQUIRE(read.value() == out.size());
+  REQUIRE(std::equal(out.begin(), out.end(), data.begin() + 15 * 1024));
+
+  read = resource.value().read(data.size() - 100, out);
+  REQUIRE(read.isOk());
+  REQUIRE(read.value() == 100);
+  REQUIRE(std::equal(out.begin(), out.begin() + 100, data.end() - 100));
+
+  read = resource.value().read(data.size(), out);
+  REQUIRE(read.isOk());
+  REQUIRE(read.value() == 0);
+}
+
+TEST_CASE("Corrupted block tables are rejected", "[vfs][blocks]") {
+  const auto data = makeData(50 * 1000);
+  auto encoded = encodeBlocks(data, bestAvailableCodec(), 8 * 1024);
+  REQUIRE(encoded.isOk());
+  auto bytes = encoded.value();
+
+  SECTION("truncated") {
+    bytes.resize(bytes.size() - 1);
+    REQUIRE(BlockedResource::open(bytes).isError());
+  }
+
+  SECTION("offsets out of order") {
+    const u64 bad = ~u64{0};
+    std::memcpy(bytes.data() + sizeof(PackBlockHeader) + 8, &bad, 8);
+    REQUIRE(BlockedResource::open(bytes).isError());
+  }
+
+  SECTION("block count inconsistent with size") {
+    PackBlockHeader header{};
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    header.blockCount += 1;
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    REQUIRE(BlockedResource::open(bytes).isError());
+  }
+}
+
+TEST_CASE("Preferred block codecs fall back to what is built in",
+          "[vfs][blocks]") {
+  for (auto type : {ResourceType::Texture, ResourceType::Script,
+                    ResourceType::Music, ResourceType::Data}) {
+    REQUIRE(isBlockCodecAvailable(preferredBlockCodec(type)));
+  }
+  if (isBlockCodecAvailable(BlockCodec::Lz4)) {
+    REQUIRE(preferredBlockCodec(ResourceType::Texture) == BlockCodec::Lz4);
+  }
+  if (isBlockCodecAvailable(BlockCodec::Zstd)) {
+    REQUIRE(preferredBlockCodec(ResourceType::Script) == BlockCodec::Zstd);
+  }
+}
+
+TEST_CASE("Block decompression throughput", "[.][benchmark][blocks]") {
+  using Clock = std::chrono::steady_clock;
+  const auto data = makeData(32 * 1024 * 1024);
+
+  auto measure = [](const char *label, usize bytes, auto &&fn) {
+    const auto start = Clock::now();
+    fn();
+    const double ms =
+        std::chrono::duration<double, std::milli>(Clock::now() - start)
+            .count();
+    std::cout << label << ": " << ms << " ms ("
+              << (static_cast<double>(bytes) / (1024.0 * 1024.0)) /
+                     (ms / 1000.0)
+              << " MB/s)\n";
+  };
+
+  for (auto codec : {BlockCodec::Zlib, BlockCodec::Lz4, BlockCodec::Zstd}) {
+    if (!isBlockCodecAvailable(codec)) {
+      std::cout << blockCodecName(codec) << ": not built in\n";
+      continue;
+    }
+
+    // A single block covering the resource is the old whole-buffer path
+    auto whole = encodeBlocks(data, codec, static_cast<u32>(data.size()));
+    auto blocked = encodeBlocks(data, codec, DEFAULT_PACK_BLOCK_SIZE, 8);
+    REQUIRE(whole.isOk());
+    REQUIRE(blocked.isOk());
+    auto wholeResource = BlockedResource::open(whole.value());
+    auto blockedResource = BlockedResource::open(blocked.value());
+
+    std::cout << blockCodecName(codec) << " (" << whole.value().size()
+              << " -> " << blocked.value().size() << " bytes)\n";
+    measure("  whole buffer   ", data.size(),
+            [&] { REQUIRE(wholeResource.value().readAll().isOk()); });
+    measure("  64K blocks x1  ", data.size(),
+            [&] { REQUIRE(blockedResource.value().readAll().isOk()); });
+    measure("  64K blocks x4  ", data.size(),
+            [&] { REQUIRE(blockedResource.value().readAll(4).isOk()); });
+
+    std::vector<u8> header(4096);
+    measure("  4K header read ", header.size(), [&] {
+      REQUIRE(blockedResource.value().read(data.size() / 2, header).isOk());
+    });
+  }
+}
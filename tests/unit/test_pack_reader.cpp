@@ -0,0 +1,267 @@
+#include <catch2/catch_test_macros.hpp>
+#include "NovelMind/vfs/pack_blocks.hpp"
+#include "NovelMind/vfs/pack_reader.hpp"
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using namespace NovelMind::vfs;
+using NovelMind::u32;
+using NovelMind::u64;
+using NovelMind::u8;
+
+namespace {
+
+struct PackFileEntry {
+  std::string id;
+  ResourceType type;
+  std::vector<u8> data; // As stored in the pack
+  u32 flags = 0;
+  u64 uncompressedSize = 0; // 0 = data.size()
+};
+
+template <typename T> void append(std::vector<u8> &out, const T &value) {
+  const auto *bytes = reinterpret_cast<const u8 *>(&value);
+  out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+// Layout: header | resource table | string table | data
+std::vector<u8> buildPack(const std::vector<PackFileEntry> &files) {
+  PackHeader header{};
+  header.magic = PACK_MAGIC;
+  header.versionMajor = PACK_VERSION_MAJOR;
+  header.versionMinor = PACK_VERSION_MINOR;
+  header.resourceCount = static_cast<u32>(files.size());
+  header.resourceTableOffset = sizeof(PackHeader);
+  header.stringTableOffset =
+      header.resourceTableOffset + files.size() * sizeof(PackResourceEntry);
+
+  std::vector<u8> strings;
+  std::vector<u32> stringOffsets;
+  for (const auto &file : files) {
+    stringOffsets.push_back(static_cast<u32>(strings.size()));
+    strings.insert(strings.end(), file.id.begin(), file.id.end());
+    strings.push_back(0);
+  }
+  header.dataOffset = header.stringTableOffset + sizeof(u32) +
+                      stringOffsets.size() * sizeof(u32) + strings.size();
+
+  std::vector<u8> out;
+  append(out, header);
+  u64 dataOffset = 0;
+  for (u32 i = 0; i < files.size(); ++i) {
+    PackResourceEntry entry{};
+    entry.idStringOffset = i;
+    entry.type = static_cast<u32>(files[i].type);
+    entry.dataOffset = dataOffset;
+    entry.compressedSize = files[i].data.size();
+    entry.uncompressedSize = files[i].uncompressedSize != 0
+                                 ? files[i].uncompressedSize
+                                 : files[i].data.size();
+    entry.flags = files[i].flags;
+    append(out, entry);
+    dataOffset += files[i].data.size();
+  }
+  append(out, static_cast<u32>(stringOffsets.size()));
+  for (u32 offset : stringOffsets) {
+    append(out, offset);
+  }
+  out.insert(out.end(), strings.begin(), strings.end());
+  for (const auto &file : files) {
+    out.insert(out.end(), file.data.begin(), file.data.end());
+  }
+  return out;
+}
+
+std::string writeTempPack(const std::string &name,
+                          const std::vector<u8> &bytes) {
+  const auto path =
+      (std::filesystem::temp_directory_path() / name).string();
+  std::ofstream file(path, std::ios::binary);
+  file.write(reinterpret_cast<const char *>(bytes.data()),
+             static_cast<std::streamsize>(bytes.size()));
+  return path;
+}
+
+const std::vector<PackFileEntry> kFiles = {
+    {"bg/room.png", ResourceType::Texture, {1, 2, 3, 4, 5}},
+    {"music/theme.ogg", ResourceType::Music, {9, 8, 7}},
+    {"scripts/main.nmc", ResourceType::Script, {42}},
+};
+
+} // namespace
+
+TEST_CASE("PackReader serves resources from the mapped pack", "[vfs][pack]") {
+  const auto path = writeTempPack("novelmind_pack_reader.nmres",
+                                  buildPack(kFiles));
+  PackReader reader;
+  REQUIRE(reader.mount(path).isOk());
+  REQUIRE(reader.mount(path).isError());
+
+  for (const auto &file : kFiles) {
+    auto data = reader.readFile(file.id);
+    REQUIRE(data.isOk());
+    REQUIRE(data.value() == file.data);
+
+    auto info = reader.getInfo(file.id);
+    REQUIRE(info.has_value());
+    REQUIRE(info->type == file.type);
+    REQUIRE(info->size == file.data.size());
+  }
+  REQUIRE_FALSE(reader.exists("missing"));
+  REQUIRE(reader.readFile("missing").isError());
+  REQUIRE(reader.listResources().size() == kFiles.size());
+  REQUIRE(reader.listResources(ResourceType::Music).size() == 1);
+
+  SECTION("views alias the mapping and outlive unmount") {
+    auto view = reader.readView("bg/room.png");
+    REQUIRE(view.isOk());
+    const auto bytes = view.value().backing->bytes();
+    REQUIRE(view.value().data.data() >= bytes.data());
+    REQUIRE(view.value().data.data() + view.value().data.size() <=
+            bytes.data() + bytes.size());
+
+    reader.unmount(path);
+    REQUIRE_FALSE(reader.exists("bg/room.png"));
+    REQUIRE(std::vector<u8>(view.value().data.begin(),
+                            view.value().data.end()) == kFiles[0].data);
+  }
+
+  SECTION("shared reads alias the mapping and outlive unmount") {
+    auto view = reader.readView("music/theme.ogg");
+    auto shared = reader.readShared("music/theme.ogg");
+    REQUIRE(shared.isOk());
+    REQUIRE(shared.value().data() == view.value().data.data());
+    REQUIRE(reader.readShared("missing").isError());
+
+    reader.unmountAll();
+    REQUIRE(shared.value().toVector() == kFiles[1].data);
+  }
+
+  SECTION("concurrent readers") {
+    std::atomic<int> failures{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&reader, &failures] {
+        for (int i = 0; i < 1000; ++i) {
+          const auto &file = kFiles[static_cast<size_t>(i) % kFiles.size()];
+          auto view = reader.readView(file.id);
+          if (view.isError() ||
+              !std::equal(view.value().data.begin(), view.value().data.end(),
+                          file.data.begin(), file.data.end())) {
+            ++failures;
+          }
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    REQUIRE(failures == 0);
+  }
+
+  reader.unmountAll();
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("PackReader validates resource bounds at mount time",
+          "[vfs][pack]") {
+  auto bytes = buildPack(kFiles);
+  PackResourceEntry entry{};
+  std::memcpy(&entry, bytes.data() + sizeof(PackHeader), sizeof(entry));
+  entry.compressedSize = 1 << 20;
+  std::memcpy(bytes.data() + sizeof(PackHeader), &entry, sizeof(entry));
+
+  const auto path = writeTempPack("novelmind_pack_reader_bad.nmres", bytes);
+  PackReader reader;
+  auto result = reader.mount(path);
+  REQUIRE(result.isError());
+  REQUIRE(result.error() == "Resource data extends beyond pack file");
+  REQUIRE(reader.listResources().empty());
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("PackReader resolves duplicate IDs by mount order", "[vfs][pack]") {
+  const auto basePath = writeTempPack("novelmind_pack_base.nmres",
+                                      buildPack(kFiles));
+  const auto modPath = writeTempPack(
+      "novelmind_pack_mod.nmres",
+      buildPack({{"bg/room.png", ResourceType::Texture, {6, 6}},
+                 {"bg/extra.png", ResourceType::Texture, {7}}}));
+
+  PackReader reader;
+  REQUIRE(reader.mount(modPath).isOk());
+  REQUIRE(reader.mount(basePath).isOk());
+
+  REQUIRE(reader.readFile("bg/room.png").value() == std::vector<u8>{6, 6});
+  REQUIRE(reader.readFile("music/theme.ogg").isOk());
+  REQUIRE(reader.readView(NovelMind::VFS::ResourceId("bg/extra.png")).isOk());
+  REQUIRE(reader.listResources().size() == 4);
+
+  reader.unmount(modPath);
+  REQUIRE(reader.readFile("bg/room.png").value() == kFiles[0].data);
+  REQUIRE_FALSE(reader.exists("bg/extra.png"));
+
+  reader.unmountAll();
+  std::filesystem::remove(basePath);
+  std::filesystem::remove(modPath);
+}
+
+TEST_CASE("PackReader decodes block-compressed entries", "[vfs][pack]") {
+  std::vector<u8> raw(100 * 1000);
+  for (size_t i = 0; i < raw.size(); ++i) {
+    raw[i] = static_cast<u8>((i / 7) % 251);
+  }
+  auto encoded = encodeBlocks(raw, preferredBlockCodec(ResourceType::Music),
+                              16 * 1024);
+  REQUIRE(encoded.isOk());
+
+  const auto path = writeTempPack(
+      "novelmind_pack_blocked.nmres",
+      buildPack({{"music/theme.ogg", ResourceType::Music, encoded.value(),
+                  static_cast<u32>(PackFlags::Blocked), raw.size()},
+                 {"bg/room.png", ResourceType::Texture, {1, 2, 3}}}));
+  PackReader reader;
+  REQUIRE(reader.mount(path).isOk());
+  reader.setDecodeThreads(2);
+
+  auto whole = reader.readFile("music/theme.ogg");
+  REQUIRE(whole.isOk());
+  REQUIRE(whole.value() == raw);
+  REQUIRE(reader.getInfo("music/theme.ogg")->size == raw.size());
+  REQUIRE(reader.readView("music/theme.ogg").isError());
+
+  std::vector<u8> slice(1000);
+  auto read = reader.readRange("music/theme.ogg", 50 * 1000, slice);
+  REQUIRE(read.isOk());
+  REQUIRE(read.value() == slice.size());
+  REQUIRE(std::equal(slice.begin(), slice.end(), raw.begin() + 50 * 1000));
+
+  read = reader.readRange("bg/room.png", 1, slice);
+  REQUIRE(read.isOk());
+  REQUIRE(read.value() == 2);
+  REQUIRE(slice[0] == 2);
+
+  reader.unmountAll();
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("PackReader rejects blocked entries with bad tables at mount",
+          "[vfs][pack]") {
+  const std::vector<u8> raw(10 * 1000, 5);
+  auto encoded = encodeBlocks(raw, BlockCodec::None, 4096);
+  REQUIRE(encoded.isOk());
+
+  // Declared size disagrees with the block header
+  const auto path = writeTempPack(
+      "novelmind_pack_blocked_bad.nmres",
+      buildPack({{"data.bin", ResourceType::Data, encoded.value(),
+                  static_cast<u32>(PackFlags::Blocked), raw.size() + 1}}));
+  PackReader reader;
+  auto result = reader.mount(path);
+  REQUIRE(result.isError());
+  REQUIRE(result.error() == "Block table size mismatch");
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,321 @@
+#include <catch2/catch_test_macros.hpp>
+#include "NovelMind/vfs/pack_security.hpp"
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using namespace NovelMind::VFS;
+using NovelMind::u16;
+using NovelMind::u32;
+using NovelMind::u64;
+using NovelMind::u8;
+using NovelMind::usize;
+
+namespace {
+
+// On-disk layout read by SecurePackReader
+struct Header {
+  u32 magic;
+  u16 versionMajor;
+  u16 versionMinor;
+  u32 flags;
+  u32 resourceCount;
+  u64 resourceTableOffset;
+  u64 stringTableOffset;
+  u64 dataOffset;
+  u64 totalSize;
+  u8 contentHash[16];
+};
+
+struct Entry {
+  u32 idStringOffset;
+  u32 type;
+  u64 dataOffset;
+  u64 compressedSize;
+  u64 uncompressedSize;
+  u32 flags;
+  u32 checksum;
+  u8 iv[8];
+};
+
+struct Footer {
+  u32 magic;
+  u32 tablesCrc32;
+  u64 createdTimestamp;
+  u32 buildNumber;
+  u8 reserved[12];
+};
+
+constexpr u32 kChunkHashed = 1u << 3;
+constexpr u32 kChunkSize = 4096;
+
+template <typename T> void append(std::vector<u8> &out, const T &value) {
+  const auto *bytes = reinterpret_cast<const u8 *>(&value);
+  out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T> void store(std::vector<u8> &out, usize at, const T &v) {
+  std::memcpy(out.data() + at, &v, sizeof(T));
+}
+
+// Restore the table CRC after editing bytes before the data section
+void resealTables(std::vector<u8> &pack) {
+  Header header{};
+  std::memcpy(&header, pack.data(), sizeof(header));
+  Footer footer{};
+  std::memcpy(&footer, pack.data() + pack.size() - sizeof(Footer),
+              sizeof(footer));
+  footer.tablesCrc32 = PackIntegrityChecker::calculateCrc32(
+      pack.data(), static_cast<usize>(header.dataOffset));
+  store(pack, pack.size() - sizeof(Footer), footer);
+}
+
+// header | entries | strings | chunk hashes | trailer | data | footer
+std::vector<u8>
+buildChunkedPack(const std::vector<std::pair<std::string, std::vector<u8>>>
+                     &files) {
+  std::vector<u8> data;
+  std::vector<Entry> entries;
+  std::vector<u8> strings;
+  std::vector<u32> stringOffsets;
+  for (u32 i = 0; i < files.size(); ++i) {
+    const auto &[id, bytes] = files[i];
+    Entry entry{};
+    entry.idStringOffset = i;
+    entry.dataOffset = data.size();
+    entry.compressedSize = bytes.size();
+    entry.uncompressedSize = bytes.size();
+    entry.checksum =
+        PackIntegrityChecker::calculateCrc32(bytes.data(), bytes.size());
+    entries.push_back(entry);
+    data.insert(data.end(), bytes.begin(), bytes.end());
+
+    stringOffsets.push_back(static_cast<u32>(strings.size()));
+    strings.insert(strings.end(), id.begin(), id.end());
+    strings.push_back(0);
+  }
+  const auto hashes = PackIntegrityChecker::calculateChunkHashes(
+      data.data(), data.size(), kChunkSize);
+  const auto root = PackIntegrityChecker::calculateChunkRoot(hashes);
+
+  Header header{};
+  header.magic = 0x53524D4E;
+  header.versionMajor = 1;
+  header.flags = kChunkHashed;
+  header.resourceCount = static_cast<u32>(files.size());
+  header.resourceTableOffset = sizeof(Header);
+  header.stringTableOffset =
+      header.resourceTableOffset + entries.size() * sizeof(Entry);
+  header.dataOffset = header.stringTableOffset + sizeof(u32) +
+                      stringOffsets.size() * sizeof(u32) + strings.size() +
+                      hashes.size() * 32 + 16;
+  header.totalSize = header.dataOffset + data.size() + sizeof(Footer);
+  std::memcpy(header.contentHash, root.data(), sizeof(header.contentHash));
+
+  std::vector<u8> out;
+  append(out, header);
+  for (const auto &entry : entries) {
+    append(out, entry);
+  }
+  append(out, static_cast<u32>(stringOffsets.size()));
+  for (u32 offset : stringOffsets) {
+    append(out, offset);
+  }
+  out.insert(out.end(), strings.begin(), strings.end());
+  for (const auto &hash : hashes) {
+    out.insert(out.end(), hash.begin(), hash.end());
+  }
+  append(out, u32{0x48434D4E});
+  append(out, kChunkSize);
+  append(out, static_cast<u64>(hashes.size()));
+  out.insert(out.end(), data.begin(), data.end());
+
+  Footer footer{};
+  footer.magic = 0x46524D4E;
+  append(out, footer);
+  resealTables(out);
+  return out;
+}
+
+std::string writeTempPack(const std::string &name,
+                          const std::vector<u8> &bytes) {
+  const auto path =
+      (std::filesystem::temp_directory_path() / name).string();
+  std::ofstream file(path, std::ios::binary);
+  file.write(reinterpret_cast<const char *>(bytes.data()),
+             static_cast<std::streamsize>(bytes.size()));
+  return path;
+}
+
+std::vector<u8> pattern(usize size, u8 seed) {
+  std::vector<u8> out(size);
+  for (usize i = 0; i < size; ++i) {
+    out[i] = static_cast<u8>(seed + i * 31 + (i >> 9));
+  }
+  return out;
+}
+
+// Two resources over five 4K chunks; chunk 2 is shared
+const std::vector<std::pair<std::string, std::vector<u8>>> kFiles = {
+    {"bg/room.png", pattern(10000, 1)},
+    {"music/theme.ogg", pattern(10000, 2)},
+};
+
+} // namespace
+
+TEST_CASE("Chunk hashes are independent of thread count",
+          "[vfs][pack][security]") {
+  const auto data = pattern(100 * 1000, 3);
+  const auto serial =
+      PackIntegrityChecker::calculateChunkHashes(data.data(), data.size(),
+                                                 kChunkSize);
+  const auto parallel = PackIntegrityChecker::calculateChunkHashes(
+      data.data(), data.size(), kChunkSize, 4);
+  REQUIRE(serial.size() == 25);
+  REQUIRE(serial == parallel);
+  REQUIRE(serial.back() == PackIntegrityChecker::calculateSha256(
+                               data.data() + 24 * kChunkSize,
+                               data.size() - 24 * kChunkSize));
+
+  PackIntegrityChecker checker;
+  auto report = checker.verifyChunks(data.data(), data.size(), kChunkSize,
+                                     serial, 0, serial.size(), 4);
+  REQUIRE(report.isOk());
+  REQUIRE(report.value().result == PackVerificationResult::Valid);
+
+  auto corrupted = data;
+  corrupted[7 * kChunkSize + 5] ^= 0xFF;
+  corrupted[20 * kChunkSize] ^= 0xFF;
+  report = checker.verifyChunks(corrupted.data(), corrupted.size(),
+                                kChunkSize, serial, 0, serial.size(), 4);
+  REQUIRE(report.value().result == PackVerificationResult::ChecksumMismatch);
+  REQUIRE(report.value().errorOffset == 7 * kChunkSize);
+
+  // Only the requested range is hashed
+  report = checker.verifyChunks(corrupted.data(), corrupted.size(),
+                                kChunkSize, serial, 8, 12);
+  REQUIRE(report.value().result == PackVerificationResult::Valid);
+  REQUIRE(PackIntegrityChecker::calculateChunkRoot(serial) !=
+          PackIntegrityChecker::calculateChunkRoot(
+              PackIntegrityChecker::calculateChunkHashes(
+                  corrupted.data(), corrupted.size(), kChunkSize)));
+}
+
+TEST_CASE("SecurePackReader verifies chunk-hashed packs at mount",
+          "[vfs][pack][security]") {
+  const auto path =
+      writeTempPack("novelmind_chunked.nmres", buildChunkedPack(kFiles));
+  SecurePackReader reader;
+  reader.setChunkVerification(ChunkVerification::Eager, 2);
+  REQUIRE(reader.openPack(path).isOk());
+  REQUIRE(reader.verifiedChunkCount() == 5);
+
+  for (const auto &[id, bytes] : kFiles) {
+    auto data = reader.readResource(id);
+    REQUIRE(data.isOk());
+    REQUIRE(data.value() == bytes);
+  }
+  reader.closePack();
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("SecurePackReader verifies lazily from several threads",
+          "[vfs][pack][security]") {
+  const auto path = writeTempPack("novelmind_chunked_threads.nmres",
+                                  buildChunkedPack(kFiles));
+  SecurePackReader reader;
+  reader.setChunkVerification(ChunkVerification::Lazy, 1);
+  REQUIRE(reader.openPack(path).isOk());
+
+  std::vector<int> failures(4, 0);
+  std::vector<std::thread> threads;
+  for (usize t = 0; t < failures.size(); ++t) {
+    threads.emplace_back([&reader, &failures, t] {
+      for (int round = 0; round < 20; ++round) {
+        for (const auto &[id, bytes] : kFiles) {
+          auto data = reader.readResource(id);
+          if (data.isError() || data.value() != bytes) {
+            ++failures[t];
+          }
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  REQUIRE(failures == std::vector<int>(4, 0));
+  REQUIRE(reader.verifiedChunkCount() == 5);
+  REQUIRE(reader.lastVerificationResult() == PackVerificationResult::Valid);
+  reader.closePack();
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("SecurePackReader rejects tampered chunk-hashed packs",
+          "[vfs][pack][security]") {
+  auto pack = buildChunkedPack(kFiles);
+  Header header{};
+  std::memcpy(&header, pack.data(), sizeof(header));
+
+  SECTION("data corruption fails eager mount") {
+    pack[header.dataOffset + 19000] ^= 0xFF;
+    const auto path = writeTempPack("novelmind_chunked_bad.nmres", pack);
+    SecurePackReader reader;
+    auto result = reader.openPack(path);
+    REQUIRE(result.isError());
+    REQUIRE(result.error() == "Chunk hash mismatch at chunk 4");
+    REQUIRE(reader.lastVerificationResult() ==
+            PackVerificationResult::ChecksumMismatch);
+    std::filesystem::remove(path);
+  }
+
+  SECTION("data corruption fails only the reads that touch it when lazy") {
+    pack[header.dataOffset + 19000] ^= 0xFF;
+    const auto path = writeTempPack("novelmind_chunked_lazy.nmres", pack);
+    SecurePackReader reader;
+    reader.setChunkVerification(ChunkVerification::Lazy);
+    REQUIRE(reader.openPack(path).isOk());
+    REQUIRE(reader.verifiedChunkCount() == 0);
+
+    REQUIRE(reader.readResource("bg/room.png").isOk());
+    REQUIRE(reader.verifiedChunkCount() == 3);
+    REQUIRE(reader.readResource("music/theme.ogg").isError());
+    REQUIRE(reader.readResource("bg/room.png").isOk());
+    reader.closePack();
+    std::filesystem::remove(path);
+  }
+
+  SECTION("rewritten chunk hashes no longer match the content hash") {
+    const usize hashes = header.dataOffset - 16 - 5 * 32;
+    pack[header.dataOffset + 19000] ^= 0xFF;
+    const auto forged = PackIntegrityChecker::calculateSha256(
+        pack.data() + header.dataOffset + 4 * kChunkSize,
+        10000 * 2 - 4 * kChunkSize);
+    std::memcpy(pack.data() + hashes + 4 * 32, forged.data(), 32);
+    resealTables(pack);
+
+    const auto path = writeTempPack("novelmind_chunked_forged.nmres", pack);
+    SecurePackReader reader;
+    auto result = reader.openPack(path);
+    REQUIRE(result.isError());
+    REQUIRE(result.error() == "Pack content hash mismatch");
+    std::filesystem::remove(path);
+  }
+
+  SECTION("chunk table inconsistent with the data size") {
+    const usize trailer = header.dataOffset - 16;
+    store(pack, trailer + 8, u64{6});
+    resealTables(pack);
+
+    const auto path = writeTempPack("novelmind_chunked_count.nmres", pack);
+    SecurePackReader reader;
+    auto result = reader.openPack(path);
+    REQUIRE(result.isError());
+    REQUIRE(result.error() == "Chunk hash table does not match data size");
+    std::filesystem::remove(path);
+  }
+}
@@ -0,0 +1,250 @@
+#include <catch2/catch_test_macros.hpp>
+#include "NovelMind/scripting/asset_prefetcher.hpp"
+#include "NovelMind/scripting/lexer.hpp"
+#include "NovelMind/scripting/parser.hpp"
+#include "NovelMind/vfs/pack_reader.hpp"
+#include "NovelMind/vfs/pack_writer.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace NovelMind;
+using namespace NovelMind::vfs;
+
+namespace {
+
+std::vector<u8> pattern(usize size, u8 seed) {
+  std::vector<u8> bytes(size);
+  for (usize i = 0; i < size; ++i) {
+    bytes[i] = static_cast<u8>((i * 31 + seed) % 251);
+  }
+  return bytes;
+}
+
+std::string tempPath(const std::string &name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// The resource table as written, in the order resources were added
+std::vector<PackResourceEntry> entriesOf(const std::vector<u8> &pack) {
+  PackHeader header;
+  std::memcpy(&header, pack.data(), sizeof(header));
+  std::vector<PackResourceEntry> entries(header.resourceCount);
+  std::memcpy(entries.data(), pack.data() + header.resourceTableOffset,
+              entries.size() * sizeof(PackResourceEntry));
+  return entries;
+}
+
+scripting::CompiledScript compileSource(const std::string &source) {
+  scripting::Lexer lexer;
+  auto tokens = lexer.tokenize(source);
+  REQUIRE(tokens.isOk());
+  scripting::Parser parser;
+  auto program = parser.parse(tokens.value());
+  REQUIRE(program.isOk());
+  scripting::Compiler compiler;
+  auto compiled = compiler.compile(program.value());
+  REQUIRE(compiled.isOk());
+  return compiled.value();
+}
+
+} // namespace
+
+TEST_CASE("PackWriter stores identical resources once", "[vfs][pack]") {
+  const auto shared = pattern(1000, 1);
+  const auto unique = pattern(300, 2);
+
+  PackWriter writer;
+  REQUIRE(writer.add("bg/room.png", shared, ResourceType::Texture).isOk());
+  REQUIRE(writer.add("data/unique.bin", unique, ResourceType::Data).isOk());
+  REQUIRE(writer.add("bg/room_copy.png", shared, ResourceType::Texture)
+              .isOk());
+  REQUIRE(writer.add("bg/room.png", unique, ResourceType::Texture).isError());
+  REQUIRE(writer.resourceCount() == 3);
+
+  const auto path = tempPath("novelmind_pack_writer_dedup.nmres");
+  REQUIRE(writer.write(path).isOk());
+
+  const auto &report = writer.report();
+  REQUIRE(report.resourceCount == 3);
+  REQUIRE(report.blobCount == 2);
+  REQUIRE(report.logicalBytes == 2300);
+  REQUIRE(report.storedBytes == 1300);
+  REQUIRE(report.bytesSaved() == 1000);
+
+  PackReader reader;
+  REQUIRE(reader.mount(path).isOk());
+  REQUIRE(reader.readFile("bg/room.png").value() == shared);
+  REQUIRE(reader.readFile("bg/room_copy.png").value() == shared);
+  REQUIRE(reader.readFile("data/unique.bin").value() == unique);
+  REQUIRE(reader.getInfo("bg/room_copy.png")->type == ResourceType::Texture);
+  // Both entries resolve to the same bytes of the mapping
+  REQUIRE(reader.readView("bg/room.png").value().data.data() ==
+          reader.readView("bg/room_copy.png").value().data.data());
+
+  SECTION("without deduplication every resource keeps its own copy") {
+    PackWriter copies(PackWriterConfig{false});
+    REQUIRE(copies.add("a", shared, ResourceType::Data).isOk());
+    REQUIRE(copies.add("b", shared, ResourceType::Data).isOk());
+    REQUIRE(copies.build().isOk());
+    REQUIRE(copies.report().blobCount == 2);
+    REQUIRE(copies.report().bytesSaved() == 0);
+  }
+
+  reader.unmountAll();
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("PackWriter block-compresses large resources", "[vfs][pack]") {
+  const std::vector<u8> text(64 * 1024, 'a');
+  const auto noise = pattern(64 * 1024, 3);
+
+  PackWriterConfig config;
+  config.blockThreshold = 4096;
+  config.blockSize = 16 * 1024;
+  PackWriter writer(config);
+  REQUIRE(writer.add("scripts/a.nms", text, ResourceType::Script).isOk());
+  REQUIRE(writer.add("scripts/b.nms", text, ResourceType::Script).isOk());
+  REQUIRE(writer.add("data/small.bin", {text.data(), 100}, ResourceType::Data)
+              .isOk());
+  REQUIRE(writer.add("data/noise.bin", noise, ResourceType::Data).isOk());
+
+  auto pack = writer.build();
+  REQUIRE(pack.isOk());
+  const auto entries = entriesOf(pack.value());
+  const u32 blocked = static_cast<u32>(PackFlags::Blocked);
+  if (preferredBlockCodec(ResourceType::Script) != BlockCodec::None) {
+    REQUIRE(entries[0].flags == blocked);
+    REQUIRE(entries[0].compressedSize < text.size());
+  }
+  REQUIRE(entries[1].dataOffset == entries[0].dataOffset);
+  REQUIRE(entries[2].flags == 0);
+  REQUIRE(writer.report().blobCount == 3);
+
+  const auto path = tempPath("novelmind_pack_writer_blocked.nmres");
+  REQUIRE(writer.write(path).isOk());
+  // Streamed to disk, the pack is byte for byte what build() returns
+  std::ifstream written(path, std::ios::binary);
+  REQUIRE(std::vector<u8>(std::istreambuf_iterator<char>(written),
+                          std::istreambuf_iterator<char>()) == pack.value());
+  PackReader reader;
+  REQUIRE(reader.mount(path).isOk());
+  REQUIRE(reader.readFile("scripts/b.nms").value() == text);
+  REQUIRE(reader.readFile("data/noise.bin").value() == noise);
+  REQUIRE(reader.getInfo("scripts/a.nms")->size == text.size());
+  reader.unmountAll();
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("PackWriter replaces a pack without truncating it",
+          "[vfs][pack]") {
+  const auto path = tempPath("novelmind_pack_writer_replace.nmres");
+  const auto first = pattern(4096, 1);
+  PackWriter oldWriter;
+  REQUIRE(oldWriter.add("data/a.bin", first, ResourceType::Data).isOk());
+  REQUIRE(oldWriter.write(path).isOk());
+
+  PackReader mounted;
+  REQUIRE(mounted.mount(path).isOk());
+
+  const auto second = pattern(8192, 2);
+  PackWriter newWriter;
+  REQUIRE(newWriter.add("data/a.bin", second, ResourceType::Data).isOk());
+
+  SECTION("a failed write keeps the previous pack") {
+    std::filesystem::create_directories(path + ".tmp");
+    REQUIRE(newWriter.write(path).isError());
+    std::filesystem::remove_all(path + ".tmp");
+
+    PackReader reader;
+    REQUIRE(reader.mount(path).isOk());
+    REQUIRE(reader.readFile("data/a.bin").value() == first);
+  }
+
+#if !defined(_WIN32)
+  // Windows cannot replace a file that is mapped
+  SECTION("a mounted pack keeps serving its old contents") {
+    REQUIRE(newWriter.write(path).isOk());
+    REQUIRE_FALSE(std::filesystem::exists(path + ".tmp"));
+    REQUIRE(mounted.readFile("data/a.bin").value() == first);
+
+    PackReader reader;
+    REQUIRE(reader.mount(path).isOk());
+    REQUIRE(reader.readFile("data/a.bin").value() == second);
+  }
+#endif
+
+  mounted.unmountAll();
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("PackWriter lays payloads out in first-use order", "[vfs][pack]") {
+  PackWriter writer;
+  const std::vector<std::string> ids = {"a", "b", "c", "d"};
+  for (usize i = 0; i < ids.size(); ++i) {
+    REQUIRE(writer.add(ids[i], pattern(100, static_cast<u8>(i)),
+                       ResourceType::Data)
+                .isOk());
+  }
+  REQUIRE(writer.add("d_copy", pattern(100, 3), ResourceType::Data).isOk());
+
+  SECTION("without an order payloads stay in insertion order") {
+    const auto entries = entriesOf(writer.build().value());
+    for (usize i = 0; i < ids.size(); ++i) {
+      REQUIRE(entries[i].dataOffset == i * 100);
+    }
+    REQUIRE(writer.report().orderedBlobs == 0);
+    REQUIRE(writer.report().seekDistanceBefore == 0);
+    REQUIRE(writer.report().seekReduction() == 0.0);
+  }
+
+  SECTION("listed ids come first, the rest keep their order") {
+    writer.setFirstUseOrder({"d_copy", "missing", "b", "d", "b"});
+    const auto entries = entriesOf(writer.build().value());
+    REQUIRE(entries[3].dataOffset == 0);   // d, through its copy
+    REQUIRE(entries[4].dataOffset == 0);   // d_copy
+    REQUIRE(entries[1].dataOffset == 100); // b
+    REQUIRE(entries[0].dataOffset == 200); // a
+    REQUIRE(entries[2].dataOffset == 300); // c
+
+    const auto &report = writer.report();
+    REQUIRE(report.orderedBlobs == 2);
+    // Added order: seek to d at 300, back from 400 to b at 100
+    REQUIRE(report.seekDistanceBefore == 600);
+    REQUIRE(report.seekDistanceAfter == 0);
+    REQUIRE(report.seekReduction() == 1.0);
+  }
+}
+
+TEST_CASE("AssetPrefetcher lists assets in first-use order",
+          "[vfs][pack][prefetch]") {
+  const auto script = compileSource(R"(
+character Hero(name="Hero", sprite="chars/hero.ppm")
+scene intro {
+    show background "bg/room.ppm"
+    say Hero "Hello"
+    show Hero at center
+    play music "music/theme.ogg"
+    goto forest
+}
+scene credits {
+    play music "music/credits.ogg"
+    show background "bg/room.ppm"
+    say Hero "The end"
+}
+scene forest {
+    show background "bg/forest.ppm"
+    play music "music/theme.ogg"
+    say Hero "Trees"
+})");
+
+  const auto order = scripting::AssetPrefetcher::firstUseOrder(script);
+  REQUIRE(order == std::vector<std::string>{"bg/room.ppm", "chars/hero.ppm",
+                                            "music/theme.ogg",
+                                            "bg/forest.ppm",
+                                            "music/credits.ogg"});
+}
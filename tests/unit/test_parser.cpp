@@ -2,6 +2,10 @@
 #include <catch2/catch_approx.hpp>
 #include "NovelMind/scripting/lexer.hpp"
 #include "NovelMind/scripting/parser.hpp"
+#include "NovelMind/scripting/validator.hpp"
+#include <chrono>
+#include <iostream>
+#include <string>
 
 using namespace NovelMind::scripting;
 
@@ -432,3 +436,85 @@ TEST_CASE("Parser parses wait and transition", "[parser]")
         REQUIRE(trans.duration == Catch::Approx(1.0f));
     }
 }
+
+TEST_CASE("Parser allocates nodes from the program arena", "[parser]")
+{
+    Lexer lexer;
+    Parser parser;
+
+    std::string source = "scene big {\n";
+    for (int i = 0; i < 600; ++i) {
+        source += "    set x = x + " + std::to_string(i) + "\n";
+    }
+    source += "}\n";
+
+    auto tokens = lexer.tokenize(source);
+    REQUIRE(tokens.isOk());
+    auto result = parser.parse(tokens.value());
+    REQUIRE(result.isOk());
+
+    // Moving the program must not invalidate node references
+    Program program = std::move(result).value();
+    REQUIRE(program.scenes.size() == 1);
+    REQUIRE(program.scenes[0].body.size() == 600);
+
+    const AstArena& arena = *program.arena;
+    REQUIRE(arena.statementCount() == 600);
+    REQUIRE(arena.expressionCount() == 1800); // x, literal and the sum
+    REQUIRE(arena.blockCount() < 16);
+
+    const auto& last = program.scenes[0].body.back();
+    REQUIRE(last.index() == 599);
+    const auto& set = std::get<SetStmt>(last->data);
+    const auto& sum = std::get<BinaryExpr>(set.value->data);
+    REQUIRE(std::get<NovelMind::i32>(std::get<LiteralExpr>(sum.right->data).value) == 599);
+}
+
+TEST_CASE("Moved-from Program gets a fresh arena", "[parser]")
+{
+    Program program;
+    program.nodes().makeStmt(WaitStmt{1.0f});
+
+    Program moved = std::move(program);
+    REQUIRE(moved.nodes().statementCount() == 1);
+
+    // The source gave its arena away; using it again must not crash
+    auto stmt = program.nodes().makeStmt(WaitStmt{2.0f});
+    REQUIRE(stmt);
+    REQUIRE(program.nodes().statementCount() == 1);
+    REQUIRE(moved.nodes().statementCount() == 1);
+}
+
+TEST_CASE("Parse + validate throughput", "[.][benchmark][parser]")
+{
+    std::string source = "character Hero(name=\"Hero\", color=\"#ff0000\")\n";
+    for (int i = 0; i < 20000; ++i) {
+        const std::string n = std::to_string(i);
+        source += "scene s" + n + " {\n"
+                  "    say Hero \"Line " + n + "\"\n"
+                  "    set counter = counter + " + n + " * 2\n"
+                  "    if counter >= 10 and not done { set done = true } else { wait 0.5 }\n"
+                  "    goto s" + std::to_string((i + 1) % 20000) + "\n"
+                  "}\n";
+    }
+
+    using Clock = std::chrono::steady_clock;
+    Lexer lexer;
+    auto tokens = lexer.tokenize(source);
+    REQUIRE(tokens.isOk());
+
+    auto start = Clock::now();
+    Parser parser;
+    auto result = parser.parse(tokens.value());
+    REQUIRE(result.isOk());
+    Validator validator;
+    auto validation = validator.validate(result.value());
+    auto elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    REQUIRE(validation.isValid);
+
+    const AstArena& arena = *result.value().arena;
+    const auto nodes = arena.expressionCount() + arena.statementCount();
+    std::cout << "Parse + validate: " << nodes << " nodes in " << arena.blockCount()
+              << " arena blocks (one heap allocation per node before), " << elapsed
+              << " ms\n";
+}
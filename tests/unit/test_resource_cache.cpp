@@ -0,0 +1,306 @@
+#include <catch2/catch_test_macros.hpp>
+#include "NovelMind/vfs/cached_file_system.hpp"
+#include "NovelMind/vfs/memory_fs.hpp"
+#include "NovelMind/vfs/resource_cache.hpp"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace NovelMind::VFS;
+using NovelMind::u32;
+using NovelMind::u8;
+using NovelMind::usize;
+
+namespace {
+
+std::vector<u8> blob(usize size, u8 fill = 1) {
+  return std::vector<u8>(size, fill);
+}
+
+ResourceId key(const std::string &name) { return ResourceId(name); }
+
+// One shard so eviction order is fully deterministic
+ResourceCache singleShard(usize maxSize, CachePolicy policy) {
+  return ResourceCache(ResourceCacheConfig{maxSize, 1, policy});
+}
+
+} // namespace
+
+TEST_CASE("ResourceCache stores entries and counts hits per type",
+          "[vfs][cache]") {
+  ResourceCache cache(1024);
+  REQUIRE(cache.shardCount() == 16);
+
+  cache.put(key("bg/room.png"), blob(100));
+  cache.put(key("music/theme.ogg"), blob(200));
+  REQUIRE(cache.currentSize() == 300);
+  REQUIRE(cache.entryCount() == 2);
+  REQUIRE(cache.contains(key("bg/room.png")));
+
+  REQUIRE(cache.get(key("bg/room.png")) == blob(100));
+  REQUIRE(cache.get(key("bg/room.png")).has_value());
+  REQUIRE_FALSE(cache.get(key("bg/hall.png")).has_value());
+  REQUIRE_FALSE(cache.get(key("music/other.ogg")).has_value());
+
+  // Replacing keeps the accounting exact
+  cache.put(key("music/theme.ogg"), blob(50, 2));
+  REQUIRE(cache.currentSize() == 150);
+  REQUIRE(cache.get(key("music/theme.ogg")) == blob(50, 2));
+
+  auto stats = cache.stats();
+  REQUIRE(stats.hitCount == 3);
+  REQUIRE(stats.missCount == 2);
+  REQUIRE(stats.entryCount == 2);
+  REQUIRE(stats.totalSize == 150);
+  REQUIRE(stats.byType[static_cast<usize>(ResourceType::Texture)].hitCount ==
+          2);
+  REQUIRE(stats.hitRate(ResourceType::Texture) == 2.0 / 3.0);
+  REQUIRE(stats.hitRate(ResourceType::Audio) == 0.5);
+
+  cache.remove(key("bg/room.png"));
+  REQUIRE(cache.currentSize() == 50);
+  cache.clear();
+  REQUIRE(cache.currentSize() == 0);
+  REQUIRE(cache.entryCount() == 0);
+
+  cache.resetStats();
+  REQUIRE(cache.stats().hitCount == 0);
+}
+
+TEST_CASE("ResourceCache keeps every shard within one budget",
+          "[vfs][cache]") {
+  ResourceCache cache(ResourceCacheConfig{1000, 4, CachePolicy::LRU});
+  for (int i = 0; i < 50; ++i) {
+    cache.put(key("item" + std::to_string(i)), blob(100));
+    REQUIRE(cache.currentSize() <= 1000);
+  }
+  REQUIRE(cache.entryCount() == 10);
+  REQUIRE(cache.stats().evictionCount == 40);
+
+  // Larger than the whole budget: never admitted
+  cache.put(key("huge"), blob(1001));
+  REQUIRE_FALSE(cache.contains(key("huge")));
+
+  cache.setMaxSize(500);
+  REQUIRE(cache.currentSize() <= 500);
+  REQUIRE(cache.entryCount() == 5);
+}
+
+TEST_CASE("ResourceCache LRU evicts the least recently used entry",
+          "[vfs][cache]") {
+  auto cache = singleShard(300, CachePolicy::LRU);
+  cache.put(key("a"), blob(100));
+  cache.put(key("b"), blob(100));
+  cache.put(key("c"), blob(100));
+  REQUIRE(cache.get(key("a")).has_value());
+
+  cache.put(key("d"), blob(100));
+  REQUIRE_FALSE(cache.contains(key("b")));
+  REQUIRE(cache.contains(key("a")));
+  REQUIRE(cache.contains(key("c")));
+  REQUIRE(cache.contains(key("d")));
+}
+
+TEST_CASE("ResourceCache never evicts pinned entries", "[vfs][cache]") {
+  auto cache = singleShard(200, CachePolicy::LRU);
+  cache.put(key("a"), blob(100));
+  cache.put(key("b"), blob(100));
+  REQUIRE(cache.pin(key("a")));
+  REQUIRE_FALSE(cache.pin(key("missing")));
+
+  cache.put(key("c"), blob(100));
+  REQUIRE(cache.contains(key("a")));
+  REQUIRE_FALSE(cache.contains(key("b")));
+  REQUIRE(cache.stats().pinnedCount == 1);
+
+  // With nothing else to evict the budget is exceeded until unpinned
+  REQUIRE(cache.pin(key("c")));
+  cache.put(key("d"), blob(100));
+  REQUIRE(cache.contains(key("a")));
+  REQUIRE(cache.contains(key("c")));
+  REQUIRE(cache.currentSize() == 300);
+
+  cache.unpin(key("a"));
+  REQUIRE(cache.currentSize() == 200);
+  REQUIRE_FALSE(cache.contains(key("a")));
+  REQUIRE(cache.contains(key("c")));
+}
+
+TEST_CASE("ResourceCache ARC keeps frequently used entries through a scan",
+          "[vfs][cache]") {
+  const auto run = [](CachePolicy policy) {
+    auto cache = singleShard(1000, policy);
+    for (int i = 0; i < 5; ++i) {
+      const auto id = key("hot" + std::to_string(i));
+      cache.put(id, blob(100));
+      (void)cache.get(id);
+    }
+    for (int i = 0; i < 20; ++i) {
+      cache.put(key("scan" + std::to_string(i)), blob(100));
+    }
+    usize hot = 0;
+    for (int i = 0; i < 5; ++i) {
+      if (cache.contains(key("hot" + std::to_string(i)))) {
+        ++hot;
+      }
+    }
+    REQUIRE(cache.currentSize() <= 1000);
+    return hot;
+  };
+
+  REQUIRE(run(CachePolicy::ARC) == 5);
+  REQUIRE(run(CachePolicy::LRU) == 0);
+
+  SECTION("a recently evicted id comes back as frequent") {
+    auto cache = singleShard(300, CachePolicy::ARC);
+    cache.put(key("a"), blob(100));
+    cache.put(key("b"), blob(100));
+    cache.put(key("c"), blob(100));
+    cache.put(key("d"), blob(100)); // a becomes a ghost
+    REQUIRE_FALSE(cache.contains(key("a")));
+    REQUIRE_FALSE(cache.get(key("a")).has_value());
+
+    cache.put(key("a"), blob(100));
+    cache.put(key("e"), blob(100));
+    cache.put(key("f"), blob(100));
+    REQUIRE(cache.contains(key("a")));
+    REQUIRE(cache.entryCount() == 3);
+  }
+}
+
+TEST_CASE("ResourceCache CostAware keeps expensive entries longer",
+          "[vfs][cache]") {
+  auto cache = singleShard(300, CachePolicy::CostAware);
+  cache.put(key("cheap1"), blob(100), 10);
+  cache.put(key("slow"), blob(100), 50000);
+  cache.put(key("cheap2"), blob(100), 10);
+
+  cache.put(key("next1"), blob(100), 10);
+  REQUIRE_FALSE(cache.contains(key("cheap1")));
+  cache.put(key("next2"), blob(100), 10);
+  REQUIRE_FALSE(cache.contains(key("cheap2")));
+  // Oldest by far, but the most expensive to reload
+  REQUIRE(cache.contains(key("slow")));
+}
+
+TEST_CASE("ResourceCache stays consistent under concurrent use",
+          "[vfs][cache]") {
+  for (auto policy :
+       {CachePolicy::LRU, CachePolicy::ARC, CachePolicy::CostAware}) {
+    ResourceCache cache(ResourceCacheConfig{64 * 1024, 8, policy});
+    std::atomic<bool> corrupt{false};
+    std::vector<std::thread> threads;
+    for (u32 t = 0; t < 4; ++t) {
+      threads.emplace_back([&cache, &corrupt, t] {
+        std::mt19937 rng(t);
+        for (int i = 0; i < 5000; ++i) {
+          const auto n = static_cast<u32>(rng() % 200);
+          const auto id = key("res" + std::to_string(n) + ".png");
+          if (auto data = cache.get(id)) {
+            if (data->size() != 512 + n ||
+                (*data)[0] != static_cast<u8>(n)) {
+              corrupt = true;
+            }
+          } else {
+            cache.put(id, blob(512 + n, static_cast<u8>(n)), n + 1);
+          }
+          if (n % 50 == 0 && cache.pin(id)) {
+            cache.unpin(id);
+          }
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+
+    REQUIRE_FALSE(corrupt);
+    REQUIRE(cache.currentSize() <= cache.maxSize());
+    const auto stats = cache.stats();
+    REQUIRE(stats.hitCount + stats.missCount == 4 * 5000);
+    REQUIRE(stats.pinnedCount == 0);
+    REQUIRE(stats.entryCount == cache.entryCount());
+  }
+}
+
+TEST_CASE("CachedFileSystem serves repeated reads from the cache",
+          "[vfs][cache]") {
+  auto inner = std::make_unique<NovelMind::vfs::MemoryFileSystem>();
+  inner->addResource("bg/room.png", blob(100, 7),
+                     NovelMind::vfs::ResourceType::Texture);
+  inner->addResource("sfx/click.ogg", blob(300, 8),
+                     NovelMind::vfs::ResourceType::Audio);
+  NovelMind::vfs::CachedFileSystem fs(std::move(inner), 350);
+
+  REQUIRE(fs.readFile("bg/room.png").value() == blob(100, 7));
+  REQUIRE(fs.readFile("bg/room.png").value() == blob(100, 7));
+  REQUIRE(fs.readFile("missing.png").isError());
+
+  auto stats = fs.cacheStats();
+  REQUIRE(stats.hitCount == 1);
+  REQUIRE(stats.hitRate(ResourceType::Texture) == 1.0 / 3.0);
+  REQUIRE(stats.entryCount == 1);
+
+  // A pinned entry survives reads that overflow the budget
+  REQUIRE(fs.pin("bg/room.png"));
+  REQUIRE(fs.readFile("sfx/click.ogg").isOk());
+  REQUIRE(fs.cacheStats().entryCount == 2);
+  fs.unpin("bg/room.png");
+  REQUIRE(fs.cacheStats().totalSize <= 350);
+
+  fs.clearCache();
+  REQUIRE(fs.cacheStats().entryCount == 0);
+}
+
+TEST_CASE("ResourceCache multithreaded throughput",
+          "[.][benchmark][cache]") {
+  using Clock = std::chrono::steady_clock;
+  constexpr int kOpsPerThread = 200000;
+  const unsigned threadCount =
+      std::max(4u, std::thread::hardware_concurrency());
+
+  std::vector<ResourceId> ids;
+  for (int i = 0; i < 1024; ++i) {
+    ids.push_back(key("assets/item" + std::to_string(i) + ".png"));
+  }
+
+  for (auto policy :
+       {CachePolicy::LRU, CachePolicy::ARC, CachePolicy::CostAware}) {
+    for (usize shards : {usize{1}, usize{16}}) {
+      // Room for about half the working set
+      ResourceCache cache(ResourceCacheConfig{512 * 1024, shards, policy});
+      const auto start = Clock::now();
+      std::vector<std::thread> threads;
+      for (unsigned t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&cache, &ids, t] {
+          std::mt19937 rng(t);
+          // Skewed towards low indices, like a scene's recurring assets
+          std::geometric_distribution<usize> pick(0.004);
+          for (int i = 0; i < kOpsPerThread; ++i) {
+            const auto &id = ids[pick(rng) % ids.size()];
+            if (!cache.get(id)) {
+              cache.put(id, blob(1024), 1 + (id.hash() % 100));
+            }
+          }
+        });
+      }
+      for (auto &thread : threads) {
+        thread.join();
+      }
+      const double ms =
+          std::chrono::duration<double, std::milli>(Clock::now() - start)
+              .count();
+      const char *name = policy == CachePolicy::LRU   ? "LRU"
+                         : policy == CachePolicy::ARC ? "ARC"
+                                                      : "CostAware";
+      std::cout << name << " x" << shards << " shards, " << threadCount
+                << " threads: " << ms << " ms, "
+                << (threadCount * kOpsPerThread) / (ms / 1000.0) / 1e6
+                << " Mops/s, hit rate " << cache.stats().hitRate() << "\n";
+    }
+  }
+}
@@ -0,0 +1,87 @@
+#include <catch2/catch_test_macros.hpp>
+#include "NovelMind/vfs/resource_id.hpp"
+#include "NovelMind/vfs/resource_index.hpp"
+#include <string>
+#include <vector>
+
+using namespace NovelMind::vfs;
+using NovelMind::VFS::ResourceId;
+using NovelMind::i32;
+using NovelMind::u32;
+
+namespace {
+
+ResourceIndex::Candidate candidate(const std::string &id, i32 priority,
+                                   u32 pack, u32 entry) {
+  return {ResourceId::hashOf(id), id, priority, ResourceLocation{pack, entry}};
+}
+
+} // namespace
+
+TEST_CASE("ResourceIndex hash matches ResourceId", "[vfs][index]") {
+  REQUIRE(ResourceId::hashOf("bg/room.png") ==
+          ResourceId("bg/room.png").hash());
+}
+
+TEST_CASE("ResourceIndex resolves overrides by priority", "[vfs][index]") {
+  // Pack 0 = base, 1 = patch, 2 = mod
+  const std::vector<std::string> ids = {"bg/room.png", "music/theme.ogg",
+                                        "scripts/main.nmc"};
+  std::vector<ResourceIndex::Candidate> candidates = {
+      candidate(ids[0], 1000, 0, 0), candidate(ids[1], 1000, 0, 1),
+      candidate(ids[2], 1000, 0, 2), candidate(ids[0], 2000, 1, 0),
+      candidate(ids[0], 5000, 2, 0), candidate(ids[1], 2000, 1, 1),
+  };
+  const ResourceIndex index = ResourceIndex::build(candidates);
+
+  REQUIRE(index.size() == 3);
+  REQUIRE(index.find(ids[0])->pack == 2);
+  REQUIRE(index.find(ids[1])->pack == 1);
+  REQUIRE(index.find(ids[2])->pack == 0);
+  REQUIRE(index.find(ids[2])->entry == 2);
+  REQUIRE(index.find("missing.png") == nullptr);
+
+  SECTION("ties keep the earlier candidate") {
+    const ResourceIndex tie = ResourceIndex::build(
+        {candidate(ids[0], 0, 3, 0), candidate(ids[0], 0, 4, 0)});
+    REQUIRE(tie.size() == 1);
+    REQUIRE(tie.find(ids[0])->pack == 3);
+  }
+}
+
+TEST_CASE("ResourceIndex separates IDs that share a hash", "[vfs][index]") {
+  const std::string a = "a.png";
+  const std::string b = "b.png";
+  const ResourceIndex index = ResourceIndex::build({
+      {42, a, 0, ResourceLocation{0, 0}},
+      {42, b, 0, ResourceLocation{0, 1}},
+      {42, a, 10, ResourceLocation{1, 0}},
+  });
+
+  REQUIRE(index.size() == 2);
+  REQUIRE(index.find(42, a)->pack == 1);
+  REQUIRE(index.find(42, b)->entry == 1);
+  REQUIRE(index.find(42, "c.png") == nullptr);
+  REQUIRE(index.find(43, a) == nullptr);
+}
+
+TEST_CASE("ResourceIndex scales to large packs", "[vfs][index]") {
+  std::vector<std::string> ids;
+  ids.reserve(100000);
+  for (u32 i = 0; i < 100000; ++i) {
+    ids.push_back("textures/sprite_" + std::to_string(i) + ".png");
+  }
+  std::vector<ResourceIndex::Candidate> candidates;
+  candidates.reserve(ids.size());
+  for (u32 i = 0; i < ids.size(); ++i) {
+    candidates.push_back(candidate(ids[i], 0, 0, i));
+  }
+  const ResourceIndex index = ResourceIndex::build(std::move(candidates));
+
+  REQUIRE(index.size() == ids.size());
+  for (u32 i = 0; i < ids.size(); i += 997) {
+    REQUIRE(index.find(ids[i])->entry == i);
+  }
+  // Slots plus directory, no strings
+  REQUIRE(index.memoryUsage() < ids.size() * 32);
+}
@@ -0,0 +1,142 @@
+#include <catch2/catch_test_macros.hpp>
+#include "NovelMind/core/types.hpp"
+#include "NovelMind/scripting/compiler.hpp"
+#include "NovelMind/scripting/lexer.hpp"
+#include "NovelMind/scripting/parser.hpp"
+#include "NovelMind/scripting/script_linker.hpp"
+#include "NovelMind/scripting/validator.hpp"
+#include "NovelMind/scripting/vm.hpp"
+
+using namespace NovelMind::scripting;
+using NovelMind::i32;
+using NovelMind::u32;
+using NovelMind::usize;
+
+namespace {
+
+Program parseSource(const std::string &source) {
+  Lexer lexer;
+  auto tokens = lexer.tokenize(source);
+  REQUIRE(tokens.isOk());
+  Parser parser;
+  auto program = parser.parse(tokens.value());
+  REQUIRE(program.isOk());
+  return std::move(program).value();
+}
+
+CompiledScript compileUnit(const std::string &source) {
+  Program program = parseSource(source);
+  Compiler compiler;
+  compiler.setAllowExternalScenes(true);
+  auto compiled = compiler.compile(program);
+  REQUIRE(compiled.isOk());
+  return compiled.value();
+}
+
+} // namespace
+
+TEST_CASE("Compiler records cross-file scene references",
+          "[scripting][linker]") {
+  Program program = parseSource(R"(
+    scene start {
+      goto elsewhere
+    }
+  )");
+
+  SECTION("rejected by default") {
+    Compiler compiler;
+    REQUIRE(compiler.compile(program).isError());
+  }
+
+  SECTION("recorded when external scenes are allowed") {
+    Compiler compiler;
+    compiler.setAllowExternalScenes(true);
+    auto compiled = compiler.compile(program);
+    REQUIRE(compiled.isOk());
+    REQUIRE(compiled.value().externalSceneRefs.size() == 1);
+    REQUIRE(compiled.value().externalSceneRefs[0].scene == "elsewhere");
+  }
+}
+
+TEST_CASE("Validator accepts symbols from other files", "[scripting][linker]") {
+  Program program = parseSource(R"(
+    scene start {
+      say Hero "Hi"
+      goto elsewhere
+    }
+  )");
+
+  Validator plain;
+  REQUIRE_FALSE(plain.validate(program).isValid);
+
+  Validator project;
+  project.setExternalSymbols({"Hero"}, {"elsewhere"});
+  REQUIRE(project.validate(program).isValid);
+}
+
+TEST_CASE("ScriptLinker merges units", "[scripting][linker]") {
+  CompiledScript first = compileUnit(R"(
+    scene start {
+      set score = 1
+      goto finale
+    }
+  )");
+  CompiledScript second = compileUnit(R"(
+    scene finale {
+      set score = score + 10
+      set label = "done"
+    }
+  )");
+
+  ScriptLinker linker;
+  auto linked = linker.link({&first, &second}, {"a.nms", "b.nms"});
+  REQUIRE(linked.isOk());
+
+  const CompiledScript &script = linked.value();
+  REQUIRE(script.instructions.size() ==
+          first.instructions.size() + second.instructions.size());
+  REQUIRE(script.sceneEntryPoints.at("start") == 0);
+  REQUIRE(script.sceneEntryPoints.at("finale") == first.instructions.size());
+  REQUIRE(script.externalSceneRefs.empty());
+
+  // "score" is shared, so the merged table holds it once
+  usize scoreCount = 0;
+  for (const auto &str : script.stringTable) {
+    if (str == "score") {
+      ++scoreCount;
+    }
+  }
+  REQUIRE(scoreCount == 1);
+
+  // GOTO_SCENE now points at the second unit's scene
+  bool foundGoto = false;
+  for (const auto &instr : script.instructions) {
+    if (instr.opcode == OpCode::GOTO_SCENE) {
+      REQUIRE(instr.operand == script.sceneEntryPoints.at("finale"));
+      foundGoto = true;
+    }
+  }
+  REQUIRE(foundGoto);
+
+  VirtualMachine vm;
+  REQUIRE(vm.load(script.instructions, script.stringTable).isOk());
+  vm.setIP(script.sceneEntryPoints.at("finale"));
+  vm.run();
+  REQUIRE(asString(vm.getVariable("label")) == "done");
+  REQUIRE(asInt(vm.getVariable("score")) == 10);
+}
+
+TEST_CASE("ScriptLinker reports conflicts and missing scenes",
+          "[scripting][linker]") {
+  CompiledScript first = compileUnit("scene start { goto nowhere }");
+  CompiledScript second = compileUnit("scene start { }");
+
+  ScriptLinker linker;
+  auto linked = linker.link({&first, &second}, {"a.nms", "b.nms"});
+  REQUIRE(linked.isError());
+  REQUIRE(linker.getErrors().size() == 2);
+  REQUIRE(linker.getErrors()[0].find("already defined in a.nms") !=
+          std::string::npos);
+  REQUIRE(linker.getErrors()[1].find("undefined scene 'nowhere'") !=
+          std::string::npos);
+}
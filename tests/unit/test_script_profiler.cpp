@@ -0,0 +1,155 @@
+#include <catch2/catch_test_macros.hpp>
+#include "NovelMind/core/types.hpp"
+#include "NovelMind/scripting/bytecode_optimizer.hpp"
+#include "NovelMind/scripting/compiled_script_image.hpp"
+#include "NovelMind/scripting/compiler.hpp"
+#include "NovelMind/scripting/lexer.hpp"
+#include "NovelMind/scripting/parser.hpp"
+#include "NovelMind/scripting/script_profiler.hpp"
+#include "NovelMind/scripting/vm.hpp"
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+
+using namespace NovelMind::scripting;
+using NovelMind::u32;
+using NovelMind::u64;
+
+namespace {
+
+CompiledScript compileSource(const std::string &source) {
+  Lexer lexer;
+  auto tokens = lexer.tokenize(source);
+  REQUIRE(tokens.isOk());
+
+  Parser parser;
+  auto program = parser.parse(tokens.value());
+  REQUIRE(program.isOk());
+
+  Compiler compiler;
+  auto compiled = compiler.compile(program.value());
+  REQUIRE(compiled.isOk());
+  return compiled.value();
+}
+
+// Lines 2-9: "intro" runs once, "counting" loops 50 times via goto
+const char *kLoopScript = R"(scene intro {
+    set n = 0
+    goto counting
+}
+scene counting {
+    set n = n + 1
+    if n < 50 {
+        goto counting
+    }
+})";
+
+// Drive the VM the way ScriptRuntime does: follow GOTO_SCENE by IP
+void runWithGotos(VirtualMachine &vm) {
+  struct Pending {
+    bool set = false;
+    u32 target = 0;
+  } pending;
+  vm.registerNativeHandler(
+      OpCode::GOTO_SCENE,
+      [](void *context, const NativeCallArgs &args) {
+        auto *p = static_cast<Pending *>(context);
+        p->set = true;
+        p->target = args.operand;
+      },
+      &pending);
+
+  while (!vm.isHalted()) {
+    if (vm.isWaiting()) {
+      REQUIRE(pending.set);
+      vm.setIP(pending.target);
+      pending.set = false;
+      vm.signalContinue();
+    }
+    vm.step();
+  }
+}
+
+} // namespace
+
+TEST_CASE("Compiler records a source line per instruction",
+          "[scripting][profiler]") {
+  CompiledScript script = compileSource(kLoopScript);
+  REQUIRE(script.sourceLines.size() == script.instructions.size());
+  REQUIRE(script.sourceLines[script.sceneEntryPoints.at("counting")] == 6);
+
+  SECTION("kept aligned by the optimizer") {
+    BytecodeOptimizer optimizer(OptimizationLevel::O2);
+    optimizer.optimize(script);
+    REQUIRE(script.sourceLines.size() == script.instructions.size());
+    REQUIRE(script.sourceLines[script.sceneEntryPoints.at("counting")] == 6);
+  }
+
+  SECTION("round-tripped through NMC2") {
+    auto image = CompiledScriptImage::fromBuffer(serializeNmc2(script));
+    REQUIRE(image.isOk());
+    REQUIRE(image.value().toCompiledScript().sourceLines == script.sourceLines);
+  }
+}
+
+TEST_CASE("ScriptProfiler counts instructions per IP, opcode and scene",
+          "[scripting][profiler]") {
+  CompiledScript script = compileSource(kLoopScript);
+
+  VirtualMachine vm;
+  ScriptProfiler profiler;
+  vm.setProfiler(&profiler);
+  REQUIRE(vm.load(script.instructions, script.stringTable).isOk());
+  runWithGotos(vm);
+
+  const auto counts = profiler.instructionCounts();
+  REQUIRE(std::accumulate(counts.begin(), counts.end(), u64{0}) ==
+          profiler.totalInstructions());
+  REQUIRE(profiler.opcodeCount(OpCode::ADD) == 50);
+  REQUIRE(profiler.opcodeCount(OpCode::GOTO_SCENE) == 50);
+  REQUIRE(profiler.nativeStats(OpCode::GOTO_SCENE).calls == 50);
+
+  const auto scenes = profiler.sceneProfile(script);
+  REQUIRE(scenes.size() == 2);
+  REQUIRE(scenes[0].scene == "counting");
+  REQUIRE(scenes[0].nativeCalls == 49);
+  REQUIRE(scenes[1].scene == "intro");
+  REQUIRE(scenes[0].instructions + scenes[1].instructions ==
+          profiler.totalInstructions());
+
+  const auto lines = profiler.lineProfile(script);
+  REQUIRE_FALSE(lines.empty());
+  REQUIRE(lines[0].scene == "counting");
+  REQUIRE(profiler.formatReport(script).find("counting") != std::string::npos);
+
+  SECTION("exports a Chrome trace") {
+    const auto path = (std::filesystem::temp_directory_path() /
+                       "novelmind_script_profile.json")
+                          .string();
+    REQUIRE(profiler.exportToChromeTrace(path, script));
+
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    const std::string json = contents.str();
+    REQUIRE(json.rfind("{\"traceEvents\":[", 0) == 0);
+    REQUIRE(json.find("\"name\":\"GOTO_SCENE\"") != std::string::npos);
+    REQUIRE(json.find("\"counting\":") != std::string::npos);
+    std::filesystem::remove(path);
+  }
+}
+
+TEST_CASE("VM without a profiler is unaffected", "[scripting][profiler]") {
+  CompiledScript script = compileSource(kLoopScript);
+
+  ScriptProfiler profiler;
+  VirtualMachine vm;
+  vm.setProfiler(&profiler);
+  vm.setProfiler(nullptr);
+  REQUIRE(vm.load(script.instructions, script.stringTable).isOk());
+  runWithGotos(vm);
+
+  REQUIRE(profiler.totalInstructions() == 0);
+  REQUIRE(asInt(vm.getVariable("n")) == 50);
+}
@@ -0,0 +1,162 @@
+#include <catch2/catch_test_macros.hpp>
+#include "NovelMind/scripting/compiled_script_image.hpp"
+#include "NovelMind/scripting/compiler.hpp"
+#include "NovelMind/scripting/lexer.hpp"
+#include "NovelMind/scripting/parser.hpp"
+#include "NovelMind/scripting/script_runtime.hpp"
+#include <memory>
+#include <vector>
+
+using namespace NovelMind::scripting;
+using NovelMind::i32;
+using NovelMind::u32;
+
+namespace {
+
+CompiledScript compileSource(const std::string &source) {
+  Lexer lexer;
+  auto tokens = lexer.tokenize(source);
+  REQUIRE(tokens.isOk());
+
+  Parser parser;
+  auto program = parser.parse(tokens.value());
+  REQUIRE(program.isOk());
+
+  Compiler compiler;
+  auto compiled = compiler.compile(program.value());
+  REQUIRE(compiled.isOk());
+  return compiled.value();
+}
+
+// A computed loop that would stall a frame if run to completion at once
+const char *kBusyScript = R"(scene intro {
+    set n = 0
+    goto counting
+}
+scene counting {
+    set n = n + 1
+    if n < 2000 {
+        goto counting
+    }
+    say Hero "done"
+})";
+
+struct SliceRecorder {
+  std::vector<i32> overruns;
+
+  void attach(ScriptRuntime &runtime) {
+    runtime.setEventCallback([this](const ScriptEvent &event) {
+      if (event.type == ScriptEventType::SliceOverrun) {
+        overruns.push_back(asInt(event.value));
+      }
+    });
+  }
+};
+
+} // namespace
+
+TEST_CASE("ScriptRuntime bounds each update by the instruction budget",
+          "[scripting][runtime]") {
+  ScriptRuntime runtime;
+  SliceRecorder recorder;
+  recorder.attach(runtime);
+
+  RuntimeConfig config;
+  config.instructionBudget = 100;
+  config.timeBudgetMicros = 0;
+  runtime.setConfig(config);
+
+  REQUIRE(runtime.load(compileSource(kBusyScript)).isOk());
+  REQUIRE(runtime.gotoScene("intro").isOk());
+
+  int frames = 0;
+  while (runtime.getState() == RuntimeState::Running && frames < 100000) {
+    runtime.update(1.0 / 60.0);
+    REQUIRE(runtime.getLastSliceInstructions() <= 100);
+    ++frames;
+  }
+
+  // State survives across slices and scene reloads
+  REQUIRE(runtime.isWaitingForInput());
+  REQUIRE(runtime.getCurrentDialogue() == "done");
+  REQUIRE(asInt(runtime.getVariable("n")) == 2000);
+
+  REQUIRE(frames > 1);
+  REQUIRE(recorder.overruns.size() == static_cast<size_t>(frames - 1));
+  REQUIRE(recorder.overruns.front() == 100);
+}
+
+TEST_CASE("ScriptRuntime with no budget runs until the script blocks",
+          "[scripting][runtime]") {
+  ScriptRuntime runtime;
+  SliceRecorder recorder;
+  recorder.attach(runtime);
+
+  RuntimeConfig config;
+  config.instructionBudget = 0;
+  config.timeBudgetMicros = 0;
+  runtime.setConfig(config);
+
+  REQUIRE(runtime.load(compileSource(kBusyScript)).isOk());
+  REQUIRE(runtime.gotoScene("intro").isOk());
+  runtime.update(1.0 / 60.0);
+
+  REQUIRE(runtime.isWaitingForInput());
+  REQUIRE(asInt(runtime.getVariable("n")) == 2000);
+  REQUIRE(recorder.overruns.empty());
+
+  runtime.continueExecution();
+  runtime.update(1.0 / 60.0);
+  REQUIRE(runtime.isComplete());
+}
+
+TEST_CASE("ScriptRuntime yields when the time budget runs out",
+          "[scripting][runtime]") {
+  ScriptRuntime runtime;
+  SliceRecorder recorder;
+  recorder.attach(runtime);
+
+  RuntimeConfig config;
+  config.instructionBudget = 0;
+  config.timeBudgetMicros = 1;
+  runtime.setConfig(config);
+
+  REQUIRE(runtime.load(compileSource(kBusyScript)).isOk());
+  REQUIRE(runtime.gotoScene("intro").isOk());
+  runtime.update(1.0 / 60.0);
+
+  // The clock is sampled between bounded VM runs, so some work gets done
+  REQUIRE(runtime.getState() == RuntimeState::Running);
+  REQUIRE(recorder.overruns.size() == 1);
+  REQUIRE(runtime.getLastSliceInstructions() > 0);
+  REQUIRE(runtime.getLastSliceInstructions() < 8000);
+
+  while (runtime.getState() == RuntimeState::Running) {
+    runtime.update(1.0 / 60.0);
+  }
+  REQUIRE(asInt(runtime.getVariable("n")) == 2000);
+}
+
+TEST_CASE("ScriptRuntime runs an NMC2 image in place", "[scripting][runtime]") {
+  auto image = CompiledScriptImage::fromBuffer(
+      serializeNmc2(compileSource(kBusyScript)));
+  REQUIRE(image.isOk());
+  auto shared =
+      std::make_shared<const CompiledScriptImage>(std::move(image).value());
+
+  ScriptRuntime runtime;
+  RuntimeConfig config;
+  config.instructionBudget = 0;
+  config.timeBudgetMicros = 0;
+  runtime.setConfig(config);
+
+  REQUIRE(runtime.load(shared).isOk());
+  REQUIRE(runtime.gotoScene("intro").isOk());
+  runtime.update(1.0 / 60.0);
+
+  // Scene jumps reuse the mapped bytecode instead of reloading a copy
+  REQUIRE(runtime.isWaitingForInput());
+  REQUIRE(runtime.getCurrentDialogue() == "done");
+  REQUIRE(asInt(runtime.getVariable("n")) == 2000);
+  REQUIRE(runtime.getCurrentScene() == "counting");
+}
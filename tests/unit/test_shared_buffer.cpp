@@ -0,0 +1,89 @@
+#include <catch2/catch_test_macros.hpp>
+#include "NovelMind/core/shared_buffer.hpp"
+#include "NovelMind/resource/resource_manager.hpp"
+#include "NovelMind/vfs/cached_file_system.hpp"
+#include "NovelMind/vfs/memory_fs.hpp"
+#include "NovelMind/vfs/resource_cache.hpp"
+#include <memory>
+#include <vector>
+
+using namespace NovelMind;
+
+TEST_CASE("SharedBuffer adopts, slices and copies bytes", "[core][buffer]") {
+  std::vector<u8> bytes{1, 2, 3, 4, 5};
+  const u8 *storage = bytes.data();
+  SharedBuffer buffer(std::move(bytes));
+  REQUIRE(buffer.data() == storage);
+  REQUIRE(buffer.size() == 5);
+  REQUIRE(buffer[4] == 5);
+
+  const SharedBuffer copy = buffer;
+  REQUIRE(copy.sharesWith(buffer));
+
+  auto middle = buffer.slice(1, 3);
+  buffer = SharedBuffer();
+  REQUIRE(buffer.empty());
+  REQUIRE(middle.data() == storage + 1);
+  REQUIRE(middle.toVector() == std::vector<u8>{2, 3, 4});
+
+  const auto owned = SharedBuffer::copyOf(middle);
+  REQUIRE(owned.toVector() == middle.toVector());
+  REQUIRE_FALSE(owned.sharesWith(middle));
+
+  // Any owner can back a view
+  auto block = std::make_shared<std::vector<u8>>(8, u8{7});
+  SharedBuffer view(block, std::span<const u8>(*block).subspan(2, 4));
+  block.reset();
+  REQUIRE(view.size() == 4);
+  REQUIRE(view[0] == 7);
+}
+
+TEST_CASE("Resource bytes are shared from storage through the cache",
+          "[vfs][buffer]") {
+  auto memory = std::make_unique<vfs::MemoryFileSystem>();
+  memory->addResource("music/theme.ogg", std::vector<u8>(64, 3),
+                      vfs::ResourceType::Music);
+  const auto stored = memory->readShared("music/theme.ogg");
+  REQUIRE(stored.isOk());
+  REQUIRE(stored.value().sharesWith(
+      memory->readShared("music/theme.ogg").value()));
+
+  vfs::CachedFileSystem cached(std::move(memory), 1024);
+  const auto first = cached.readShared("music/theme.ogg");
+  const auto second = cached.readShared("music/theme.ogg");
+  REQUIRE(first.value().sharesWith(stored.value()));
+  REQUIRE(second.value().sharesWith(stored.value()));
+  REQUIRE(cached.cacheStats().hitCount == 1);
+  REQUIRE(cached.readShared("missing.ogg").isError());
+
+  // readFile still hands out a private copy
+  const auto copy = cached.readFile("music/theme.ogg");
+  REQUIRE(copy.value() == std::vector<u8>(64, 3));
+  REQUIRE(copy.value().data() != stored.value().data());
+
+  SECTION("evicted entries stay valid for their holders") {
+    VFS::ResourceCache cache(VFS::ResourceCacheConfig{100, 1});
+    cache.put(VFS::ResourceId("a.bin"), std::vector<u8>(80, 1));
+    const auto held = cache.getShared(VFS::ResourceId("a.bin"));
+    REQUIRE(held.has_value());
+    cache.put(VFS::ResourceId("b.bin"), std::vector<u8>(80, 2));
+    REQUIRE_FALSE(cache.contains(VFS::ResourceId("a.bin")));
+    REQUIRE(held->toVector() == std::vector<u8>(80, 1));
+  }
+
+  SECTION("the resource manager and loader pass the same bytes on") {
+    vfs::MemoryFileSystem fs;
+    fs.addResource("data/table.bin", {9, 8, 7}, vfs::ResourceType::Data);
+    const auto source = fs.readShared("data/table.bin").value();
+    resource::ResourceManager resources(&fs);
+
+    REQUIRE(resources.readShared("data/table.bin").value().sharesWith(source));
+    auto handle = resources.requestData("data/table.bin",
+                                        resource::LoadPriority::Immediate);
+    while (!handle.isDone()) {
+      resources.update(1000.0);
+    }
+    REQUIRE(handle.isReady());
+    REQUIRE(handle.get()->sharesWith(source));
+  }
+}
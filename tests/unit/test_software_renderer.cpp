@@ -0,0 +1,385 @@
+#include <catch2/catch_test_macros.hpp>
+#include "NovelMind/renderer/software_renderer.hpp"
+#include "NovelMind/resource/resource_manager.hpp"
+#include "NovelMind/scene/scene_graph.hpp"
+#include "NovelMind/scene/transition.hpp"
+#include "NovelMind/vfs/memory_fs.hpp"
+#include "test_helpers.hpp"
+#include <chrono>
+#include <iostream>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace NovelMind;
+using namespace NovelMind::renderer;
+using namespace NovelMind::test;
+
+namespace {
+
+bool same(const Color &a, const Color &b) {
+  return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+Transform2D at(f32 x, f32 y) {
+  Transform2D transform;
+  transform.x = x;
+  transform.y = y;
+  return transform;
+}
+
+// Left half red, right half blue, top row of each half lighter
+Texture makeTexture(i32 width, i32 height) {
+  std::vector<u8> pixels;
+  pixels.reserve(static_cast<usize>(width * height) * 4);
+  for (i32 y = 0; y < height; ++y) {
+    for (i32 x = 0; x < width; ++x) {
+      const u8 light = y == 0 ? 100 : 0;
+      const bool left = x < width / 2;
+      pixels.insert(pixels.end(),
+                    {static_cast<u8>(left ? 255 : light), light,
+                     static_cast<u8>(left ? light : 255), 255});
+    }
+  }
+  Texture texture;
+  REQUIRE(texture.loadFromRGBA(pixels.data(), width, height).isOk());
+  return texture;
+}
+
+// Records what the renderer presents instead of showing it
+class FrameWindow : public platform::IWindow {
+public:
+  Result<void> create(const platform::WindowConfig &config) override {
+    m_config = config;
+    return Result<void>::ok();
+  }
+  void destroy() override {}
+  void setTitle(const std::string &title) override { m_config.title = title; }
+  void setSize(i32 width, i32 height) override {
+    m_config.width = width;
+    m_config.height = height;
+  }
+  void setFullscreen(bool fullscreen) override {
+    m_config.fullscreen = fullscreen;
+  }
+  [[nodiscard]] i32 getWidth() const override { return m_config.width; }
+  [[nodiscard]] i32 getHeight() const override { return m_config.height; }
+  [[nodiscard]] bool isFullscreen() const override {
+    return m_config.fullscreen;
+  }
+  [[nodiscard]] bool shouldClose() const override { return false; }
+  void pollEvents() override {}
+  void swapBuffers() override { ++swaps; }
+  bool presentPixels(std::span<const u8> rgba, i32 width,
+                     i32 height) override {
+    frames.emplace_back(rgba.begin(), rgba.end());
+    frameWidth = width;
+    frameHeight = height;
+    return true;
+  }
+  [[nodiscard]] void *getNativeHandle() const override { return nullptr; }
+
+  std::vector<std::vector<u8>> frames;
+  i32 frameWidth = 0;
+  i32 frameHeight = 0;
+  int swaps = 0;
+
+private:
+  platform::WindowConfig m_config;
+};
+
+// Sprites, rotation, every blend mode and a fade in one frame
+std::vector<u8> drawMixedFrame(SoftwareRendererConfig config,
+                               const Texture &texture) {
+  SoftwareRenderer renderer(config);
+  REQUIRE(renderer.initialize(101, 67).isOk());
+  renderer.beginFrame();
+  for (int i = 0; i < 12; ++i) {
+    Transform2D transform = at(static_cast<f32>(i * 9 - 5),
+                               static_cast<f32>((i * 13) % 60 - 4));
+    transform.rotation = static_cast<f32>(i * 17);
+    transform.scaleX = 1.0f + static_cast<f32>(i % 3) * 0.7f;
+    transform.scaleY = 1.5f;
+    renderer.setBlendMode(static_cast<BlendMode>(i % 4));
+    renderer.drawSprite(texture, transform,
+                        Color(255, static_cast<u8>(40 + i * 15), 200,
+                              static_cast<u8>(90 + i * 13)));
+  }
+  renderer.setBlendMode(BlendMode::Alpha);
+  renderer.fillRect(Rect{7.5f, 3.25f, 60.0f, 33.0f}, Color(10, 200, 90, 77));
+  renderer.drawRect(Rect{2, 2, 97, 63}, Color(250, 250, 250, 180));
+  renderer.setFade(0.3f, Color(20, 0, 40, 255));
+  renderer.endFrame();
+  return {renderer.pixels().begin(), renderer.pixels().end()};
+}
+
+} // namespace
+
+TEST_CASE("SoftwareRenderer blends with the GL blend functions",
+          "[renderer][software]") {
+  SoftwareRenderer renderer(SoftwareRendererConfig{1, 16, {}});
+  REQUIRE(renderer.initialize(8, 8).isOk());
+  REQUIRE(renderer.getWidth() == 8);
+
+  renderer.clear(Color(0, 0, 255, 255));
+  renderer.fillRect(Rect{0, 0, 4, 4}, Color(200, 100, 0, 128));
+  renderer.setBlendMode(BlendMode::None);
+  renderer.fillRect(Rect{4, 0, 4, 4}, Color(100, 200, 30, 255));
+  renderer.setBlendMode(BlendMode::Additive);
+  renderer.fillRect(Rect{4, 0, 2, 2}, Color(200, 100, 0, 128));
+  renderer.setBlendMode(BlendMode::None);
+  renderer.fillRect(Rect{0, 4, 4, 4}, Color(200, 200, 200, 255));
+  renderer.setBlendMode(BlendMode::Multiply);
+  renderer.fillRect(Rect{0, 4, 4, 4}, Color(128, 255, 0, 128));
+  renderer.flush();
+
+  REQUIRE(same(renderer.pixelAt(1, 1), Color(100, 50, 127, 191)));
+  REQUIRE(same(renderer.pixelAt(4, 0), Color(200, 250, 30, 255)));
+  REQUIRE(same(renderer.pixelAt(7, 3), Color(100, 200, 30, 255)));
+  REQUIRE(same(renderer.pixelAt(3, 7), Color(200, 255, 100, 255)));
+  REQUIRE(same(renderer.pixelAt(5, 5), Color(0, 0, 255, 255)));
+  REQUIRE(same(renderer.pixelAt(8, 0), Color(0, 0, 0, 0)));
+}
+
+TEST_CASE("SoftwareRenderer covers pixels whose centres are inside",
+          "[renderer][software]") {
+  SoftwareRenderer renderer(SoftwareRendererConfig{1, 16, {}});
+  REQUIRE(renderer.initialize(10, 10).isOk());
+  renderer.clear(Color::Black);
+
+  SECTION("fractional rectangles") {
+    renderer.fillRect(Rect{1.4f, 1.6f, 2.0f, 2.0f}, Color::White);
+    renderer.flush();
+    REQUIRE(same(renderer.pixelAt(1, 1), Color::Black));
+    REQUIRE(same(renderer.pixelAt(1, 2), Color::White));
+    REQUIRE(same(renderer.pixelAt(2, 3), Color::White));
+    REQUIRE(same(renderer.pixelAt(3, 3), Color::Black));
+  }
+
+  SECTION("outlines are one pixel wide") {
+    renderer.drawRect(Rect{2, 2, 5, 4}, Color::White);
+    renderer.flush();
+    REQUIRE(same(renderer.pixelAt(2, 2), Color::White));
+    REQUIRE(same(renderer.pixelAt(6, 5), Color::White));
+    REQUIRE(same(renderer.pixelAt(2, 4), Color::White));
+    REQUIRE(same(renderer.pixelAt(3, 3), Color::Black));
+    REQUIRE(same(renderer.pixelAt(7, 2), Color::Black));
+  }
+
+  SECTION("fades cover the whole framebuffer") {
+    renderer.setFade(1.0f, Color(9, 8, 7, 255));
+    renderer.flush();
+    REQUIRE(same(renderer.pixelAt(0, 0), Color(9, 8, 7, 255)));
+    REQUIRE(same(renderer.pixelAt(9, 9), Color(9, 8, 7, 255)));
+  }
+}
+
+TEST_CASE("SoftwareRenderer samples textures like the sprite transform",
+          "[renderer][software]") {
+  const Texture texture = makeTexture(4, 2);
+  REQUIRE(texture.getPixels().size() == 32);
+  SoftwareRenderer renderer(SoftwareRendererConfig{1, 16, {}});
+  REQUIRE(renderer.initialize(16, 16).isOk());
+  renderer.clear(Color::Black);
+
+  SECTION("scaled and tinted") {
+    Transform2D transform = at(2, 2);
+    transform.scaleX = 2.0f;
+    transform.scaleY = 3.0f;
+    renderer.drawSprite(texture, transform, Color(255, 255, 128, 255));
+    renderer.flush();
+
+    REQUIRE(same(renderer.pixelAt(2, 2), Color(255, 100, 50, 255)));
+    REQUIRE(same(renderer.pixelAt(5, 4), Color(255, 100, 50, 255)));
+    REQUIRE(same(renderer.pixelAt(5, 5), Color(255, 0, 0, 255)));
+    REQUIRE(same(renderer.pixelAt(6, 7), Color(0, 0, 128, 255)));
+    REQUIRE(same(renderer.pixelAt(10, 7), Color::Black));
+    REQUIRE(same(renderer.pixelAt(9, 8), Color::Black));
+  }
+
+  SECTION("source rectangle and rotation") {
+    Transform2D transform = at(8, 8);
+    transform.rotation = 90.0f; // (x, y) -> (-y, x)
+    renderer.drawSprite(texture, Rect{2, 0, 2, 2}, transform, Color::White);
+    renderer.flush();
+
+    REQUIRE(same(renderer.pixelAt(7, 8), Color(100, 100, 255, 255)));
+    REQUIRE(same(renderer.pixelAt(6, 9), Color(0, 0, 255, 255)));
+    REQUIRE(same(renderer.pixelAt(8, 8), Color::Black));
+    REQUIRE(same(renderer.pixelAt(7, 10), Color::Black));
+  }
+
+  SECTION("GPU-only textures are skipped") {
+    const Texture empty;
+    renderer.drawSprite(empty, at(0, 0));
+    renderer.flush();
+    REQUIRE(same(renderer.pixelAt(0, 0), Color::Black));
+  }
+}
+
+TEST_CASE("SoftwareRenderer output does not depend on threads or SIMD",
+          "[renderer][software]") {
+  const Texture texture = makeTexture(17, 11);
+  const auto reference =
+      drawMixedFrame(SoftwareRendererConfig{1, 64, SimdLevel::Scalar},
+                     texture);
+
+  const SimdLevel levels[] = {SimdLevel::Scalar, SimdLevel::SSE2,
+                              SimdLevel::AVX2};
+  for (SimdLevel level : levels) {
+    for (unsigned threads : {1u, 3u}) {
+      for (u32 tileSize : {16u, 64u}) {
+        SoftwareRenderer probe(
+            SoftwareRendererConfig{threads, tileSize, level});
+        REQUIRE(probe.simdLevel() <= SoftwareRenderer::bestSimdLevel());
+        REQUIRE(drawMixedFrame(
+                    SoftwareRendererConfig{threads, tileSize, level},
+                    texture) == reference);
+      }
+    }
+  }
+}
+
+TEST_CASE("SoftwareRenderer renders scene graph frames to golden pixels",
+          "[renderer][software][scene]") {
+  vfs::MemoryFileSystem fs;
+  fs.addResource("bg/room.ppm", ppmImage(64, 48, 40, 80, 120),
+                 vfs::ResourceType::Texture);
+  fs.addResource("chars/hero.ppm", ppmImage(16, 16, 255, 255, 255),
+                 vfs::ResourceType::Texture);
+  resource::ResourceManager resources(&fs);
+
+  scene::SceneGraph graph;
+  graph.setResourceManager(&resources);
+  graph.showBackground("bg/room.ppm");
+  graph.findObject("main_background")->setPosition(32, 24);
+  auto *hero = graph.showCharacter("hero", "chars/hero.ppm",
+                                   scene::CharacterObject::Position::Custom);
+  hero->setPosition(32, 24);
+
+  auto overlay = std::make_unique<scene::EffectOverlayObject>("flash");
+  overlay->setEffectType(scene::EffectOverlayObject::EffectType::Fade);
+  overlay->setColor(Color(0, 0, 0, 255));
+  overlay->startEffect(1.0f);
+  graph.addToLayer(scene::LayerType::Effects, std::move(overlay));
+
+  SoftwareRenderer renderer(SoftwareRendererConfig{2, 16, {}});
+  REQUIRE(renderer.initialize(64, 48).isOk());
+  auto renderFrame = [&](Scene::ITransition *transition) {
+    renderer.beginFrame();
+    graph.render(renderer);
+    if (transition) {
+      transition->render(renderer);
+    }
+    renderer.endFrame();
+  };
+
+  // Fully faded: the overlay starts opaque
+  renderFrame(nullptr);
+  REQUIRE(same(renderer.pixelAt(0, 0), Color(0, 0, 0, 255)));
+  REQUIRE(same(renderer.pixelAt(32, 24), Color(0, 0, 0, 255)));
+  REQUIRE(renderer.getStats().quads == 3);
+
+  // Halfway: alpha 127 over the background and the dimmed character
+  graph.update(0.5);
+  renderFrame(nullptr);
+  REQUIRE(same(renderer.pixelAt(0, 0), Color(20, 40, 60, 191)));
+  REQUIRE(same(renderer.pixelAt(63, 47), Color(20, 40, 60, 191)));
+  REQUIRE(same(renderer.pixelAt(24, 16), Color(96, 96, 96, 191)));
+  REQUIRE(same(renderer.pixelAt(39, 31), Color(96, 96, 96, 191)));
+  REQUIRE(same(renderer.pixelAt(40, 32), Color(20, 40, 60, 191)));
+
+  // Effect over: the plain scene, then a fade-out transition halfway
+  graph.update(0.6);
+  renderFrame(nullptr);
+  REQUIRE(same(renderer.pixelAt(0, 0), Color(40, 80, 120, 255)));
+  REQUIRE(same(renderer.pixelAt(32, 24), Color(191, 191, 191, 255)));
+  REQUIRE(renderer.getStats().quads == 2);
+
+  Scene::FadeTransition transition(Color(255, 255, 255, 255), true);
+  transition.start(1.0f);
+  transition.update(0.5);
+  renderFrame(&transition);
+  REQUIRE(same(renderer.pixelAt(0, 0), Color(147, 167, 187, 191)));
+  REQUIRE(same(renderer.pixelAt(32, 24), Color(223, 223, 223, 191)));
+}
+
+TEST_CASE("SoftwareRenderer presents frames through its window",
+          "[renderer][software]") {
+  FrameWindow window;
+  REQUIRE(window.create({"test", 40, 24, false, false, false}).isOk());
+
+  // Several threads, so every frame reuses the same raster workers
+  SoftwareRenderer renderer(SoftwareRendererConfig{3, 8, {}});
+  REQUIRE(renderer.initialize(window).isOk());
+  for (u8 frame = 0; frame < 3; ++frame) {
+    renderer.beginFrame();
+    renderer.fillRect(Rect{static_cast<f32>(frame * 10), 4, 12, 12},
+                      Color(200, frame, 50, 255));
+    renderer.endFrame();
+
+    REQUIRE(window.frames.size() == frame + 1u);
+    REQUIRE(window.frames.back() ==
+            std::vector<u8>(renderer.pixels().begin(),
+                            renderer.pixels().end()));
+  }
+  REQUIRE(window.frameWidth == 40);
+  REQUIRE(window.frameHeight == 24);
+  REQUIRE(window.swaps == 0);
+
+  // Offscreen rendering after a re-initialize presents nothing
+  REQUIRE(renderer.initialize(40, 24).isOk());
+  renderer.beginFrame();
+  renderer.endFrame();
+  REQUIRE(window.frames.size() == 3);
+}
+
+TEST_CASE("SoftwareRenderer writes PNG images", "[renderer][software]") {
+  SoftwareRenderer renderer(SoftwareRendererConfig{1, 16, {}});
+  REQUIRE(renderer.savePng("unused.png").isError());
+  REQUIRE(renderer.initialize(0, 4).isError());
+  REQUIRE(renderer.initialize(300, 5).isOk());
+  renderer.clear(Color(1, 2, 3, 4));
+  renderer.fillRect(Rect{299, 4, 1, 1}, Color(250, 251, 252, 255));
+  renderer.flush();
+
+  const auto png = renderer.encodePng();
+  auto decoded = Texture::decodeImage(png);
+  REQUIRE(decoded.isOk());
+  const auto &image = decoded.value();
+  REQUIRE(image.width == 300);
+  REQUIRE(image.height == 5);
+  REQUIRE(std::vector<u8>(renderer.pixels().begin(),
+                          renderer.pixels().end()) == image.pixels);
+}
+
+TEST_CASE("Software rasterizer throughput",
+          "[.][benchmark][renderer][software]") {
+  using Clock = std::chrono::steady_clock;
+  const Texture background = makeTexture(1280, 720);
+  const Texture sprite = makeTexture(400, 600);
+
+  for (SimdLevel level :
+       {SimdLevel::Scalar, SoftwareRenderer::bestSimdLevel()}) {
+    SoftwareRenderer renderer(SoftwareRendererConfig{0, 64, level});
+    REQUIRE(renderer.initialize(1280, 720).isOk());
+
+    constexpr int kFrames = 20;
+    const auto start = Clock::now();
+    for (int frame = 0; frame < kFrames; ++frame) {
+      renderer.beginFrame();
+      renderer.drawSprite(background, at(0, 0));
+      renderer.drawSprite(sprite, at(100, 120), Color(255, 255, 255, 230));
+      renderer.drawSprite(sprite, at(780, 120), Color(255, 255, 255, 230));
+      renderer.fillRect(Rect{40, 520, 1200, 180}, Color(0, 0, 0, 160));
+      renderer.setFade(0.25f);
+      renderer.endFrame();
+    }
+    const double ms =
+        std::chrono::duration<double, std::milli>(Clock::now() - start)
+            .count();
+    std::cout << "software renderer, level " << static_cast<int>(level)
+              << ", " << renderer.threadCount()
+              << " threads: " << ms / kFrames << " ms per 720p frame\n";
+  }
+}
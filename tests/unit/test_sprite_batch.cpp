@@ -0,0 +1,318 @@
+#include <catch2/catch_test_macros.hpp>
+#include "NovelMind/platform/window.hpp"
+#include "NovelMind/renderer/sprite_batch.hpp"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace NovelMind;
+using namespace NovelMind::renderer;
+
+namespace {
+
+Texture makeTexture(i32 width, i32 height) {
+  std::vector<u8> pixels(static_cast<usize>(width * height) * 4, 255);
+  Texture texture;
+  REQUIRE(texture.loadFromRGBA(pixels.data(), width, height).isOk());
+  return texture;
+}
+
+bool near(f32 a, f32 b) { return std::fabs(a - b) < 1e-3f; }
+
+// What each flush handed to the backend
+struct Recorder {
+  std::vector<SpriteVertex> vertices;
+  std::vector<SpriteDrawCommand> commands;
+  u32 flushes = 0;
+
+  void attach(SpriteBatch &batch) {
+    batch.setFlushCallback([this](std::span<const SpriteVertex> v,
+                                  std::span<const SpriteDrawCommand> c) {
+      vertices.assign(v.begin(), v.end());
+      commands.assign(c.begin(), c.end());
+      ++flushes;
+    });
+  }
+};
+
+Transform2D at(f32 x, f32 y) {
+  Transform2D transform;
+  transform.x = x;
+  transform.y = y;
+  return transform;
+}
+
+} // namespace
+
+TEST_CASE("SpriteBatch places quads like the immediate-mode renderer",
+          "[renderer][batch]") {
+  const Texture texture = makeTexture(64, 32);
+  SpriteBatch batch;
+  Recorder recorder;
+  recorder.attach(batch);
+
+  SECTION("anchor, scale, then translate") {
+    Transform2D transform = at(100, 50);
+    transform.scaleX = 2.0f;
+    transform.scaleY = 3.0f;
+    transform.anchorX = 8.0f;
+    transform.anchorY = 4.0f;
+    batch.draw(texture, Rect{16, 8, 32, 16}, transform, Color(1, 2, 3, 4));
+    batch.flush();
+
+    REQUIRE(recorder.vertices.size() == 4);
+    const auto &v = recorder.vertices;
+    REQUIRE(near(v[0].x, 84));
+    REQUIRE(near(v[0].y, 38));
+    REQUIRE(near(v[2].x, 148));
+    REQUIRE(near(v[2].y, 86));
+    REQUIRE(near(v[1].x, 148));
+    REQUIRE(near(v[3].y, 86));
+    REQUIRE(near(v[0].u, 0.25f));
+    REQUIRE(near(v[0].v, 0.25f));
+    REQUIRE(near(v[2].u, 0.75f));
+    REQUIRE(near(v[2].v, 0.75f));
+    REQUIRE(v[3].r == 1);
+    REQUIRE(v[3].a == 4);
+  }
+
+  SECTION("rotation in degrees, counter-clockwise in GL terms") {
+    Transform2D transform = at(10, 10);
+    transform.rotation = 90.0f;
+    batch.draw(texture, Rect{0, 0, 64, 32}, transform, Color::White);
+    batch.flush();
+
+    const auto &v = recorder.vertices;
+    REQUIRE(near(v[0].x, 10));
+    REQUIRE(near(v[0].y, 10));
+    REQUIRE(near(v[1].x, 10));
+    REQUIRE(near(v[1].y, 74)); // (64, 0) -> (0, 64)
+    REQUIRE(near(v[3].x, -22));
+    REQUIRE(near(v[3].y, 10)); // (0, 32) -> (-32, 0)
+  }
+
+  SECTION("invalid textures draw nothing") {
+    const Texture empty;
+    batch.draw(empty, Rect{0, 0, 1, 1}, at(0, 0), Color::White);
+    batch.flush();
+    REQUIRE(recorder.flushes == 0);
+  }
+
+  SECTION("commands outlive moves of the texture") {
+    Texture moving = makeTexture(8, 8);
+    const SpriteTexture queued = SpriteTexture::of(moving);
+    batch.draw(moving, Rect{0, 0, 8, 8}, at(0, 0), Color::White);
+    const Texture moved = std::move(moving);
+    batch.flush();
+
+    REQUIRE(recorder.commands.size() == 1);
+    REQUIRE(recorder.commands[0].texture == queued);
+    REQUIRE(recorder.commands[0].texture.pixels == moved.getPixels().data());
+    REQUIRE(recorder.commands[0].texture.width == 8);
+  }
+
+  REQUIRE(SpriteBatch::quadIndices(2) ==
+          std::vector<u16>{0, 1, 2, 0, 2, 3, 4, 5, 6, 4, 6, 7});
+}
+
+TEST_CASE("SpriteBatch groups quads without changing what is on top",
+          "[renderer][batch]") {
+  const Texture atlas = makeTexture(256, 256);
+  const Texture sprite = makeTexture(100, 100);
+  SpriteBatch batch;
+  Recorder recorder;
+  recorder.attach(batch);
+
+  SECTION("separate quads share a run across other textures") {
+    batch.draw(atlas, Rect{0, 0, 10, 10}, at(0, 0), Color::White);
+    batch.draw(sprite, Rect{0, 0, 100, 100}, at(500, 500), Color::White);
+    batch.draw(atlas, Rect{0, 0, 10, 10}, at(20, 0), Color::White);
+    batch.flush();
+
+    REQUIRE(recorder.commands.size() == 2);
+    REQUIRE(recorder.commands[0].texture == SpriteTexture::of(atlas));
+    REQUIRE(recorder.commands[0].quadCount == 2);
+    REQUIRE(recorder.commands[1].texture == SpriteTexture::of(sprite));
+    REQUIRE(recorder.commands[1].firstQuad == 2);
+    // The second glyph moved ahead of the sprite
+    REQUIRE(near(recorder.vertices[4].x, 20));
+  }
+
+  SECTION("a quad stays above what it overlaps") {
+    batch.draw(atlas, Rect{0, 0, 10, 10}, at(0, 0), Color::White);
+    batch.fill(Rect{0, 0, 50, 50}, Color::Black);
+    batch.draw(atlas, Rect{0, 0, 10, 10}, at(20, 20), Color::White);
+    batch.flush();
+
+    REQUIRE(recorder.commands.size() == 3);
+    REQUIRE_FALSE(recorder.commands[1].texture);
+    REQUIRE(recorder.commands[2].texture == SpriteTexture::of(atlas));
+  }
+
+  SECTION("blend modes split runs") {
+    batch.draw(atlas, Rect{0, 0, 10, 10}, at(0, 0), Color::White);
+    batch.setBlendMode(BlendMode::Additive);
+    batch.draw(atlas, Rect{0, 0, 10, 10}, at(0, 0), Color::White);
+    batch.setBlendMode(BlendMode::Alpha);
+    batch.draw(atlas, Rect{0, 0, 10, 10}, at(100, 100), Color::White);
+    batch.flush();
+
+    REQUIRE(recorder.commands.size() == 2);
+    REQUIRE(recorder.commands[0].blend == BlendMode::Alpha);
+    REQUIRE(recorder.commands[0].quadCount == 2);
+    REQUIRE(recorder.commands[1].blend == BlendMode::Additive);
+  }
+}
+
+TEST_CASE("SpriteBatch flushes when full and counts the work",
+          "[renderer][batch]") {
+  const Texture atlas = makeTexture(16, 16);
+  SpriteBatch batch(SpriteBatchConfig{3, 16});
+  Recorder recorder;
+  recorder.attach(batch);
+
+  for (int i = 0; i < 7; ++i) {
+    batch.draw(atlas, Rect{0, 0, 4, 4}, at(static_cast<f32>(i * 8), 0),
+               Color::White);
+  }
+  REQUIRE(recorder.flushes == 2);
+  REQUIRE(batch.pendingQuads() == 1);
+  batch.flush();
+  batch.flush();
+  REQUIRE(recorder.flushes == 3);
+
+  const auto &stats = batch.stats();
+  REQUIRE(stats.quads == 7);
+  REQUIRE(stats.vertices == 28);
+  REQUIRE(stats.batches == 3);
+  REQUIRE(stats.drawCalls == 3);
+  batch.resetStats();
+  REQUIRE(batch.stats().quads == 0);
+}
+
+TEST_CASE("A dialogue frame becomes a handful of draw calls",
+          "[renderer][batch]") {
+  const Texture background = makeTexture(1280, 720);
+  const Texture hero = makeTexture(400, 600);
+  const Texture heroine = makeTexture(400, 600);
+  const Texture glyphs = makeTexture(512, 512);
+  SpriteBatch batch;
+  Recorder recorder;
+  recorder.attach(batch);
+
+  batch.draw(background, Rect{0, 0, 1280, 720}, at(0, 0), Color::White);
+  batch.draw(hero, Rect{0, 0, 400, 600}, at(100, 120), Color::White);
+  batch.draw(heroine, Rect{0, 0, 400, 600}, at(780, 120), Color::White);
+  batch.fill(Rect{40, 520, 1200, 180}, Color(0, 0, 0, 160));
+  batch.fill(Rect{60, 490, 200, 40}, Color(20, 20, 60, 220));
+  // Name plate then three lines of text, one glyph per character
+  for (int i = 0; i < 8; ++i) {
+    batch.draw(glyphs, Rect{0, 0, 12, 20},
+               at(70.0f + static_cast<f32>(i) * 14.0f, 500), Color::White);
+  }
+  for (int line = 0; line < 3; ++line) {
+    for (int i = 0; i < 80; ++i) {
+      batch.draw(glyphs, Rect{12, 0, 12, 20},
+                 at(60.0f + static_cast<f32>(i) * 14.0f,
+                    540.0f + static_cast<f32>(line) * 40.0f),
+                 Color::White);
+    }
+  }
+  batch.flush();
+
+  // Background, two characters, the boxes, then every glyph at once
+  REQUIRE(batch.stats().quads == 253);
+  REQUIRE(batch.stats().drawCalls == 5);
+  REQUIRE(recorder.commands.back().texture == SpriteTexture::of(glyphs));
+  REQUIRE(recorder.commands.back().quadCount == 248);
+}
+
+// Needs a display and an OpenGL driver; CI runs it under Xvfb on llvmpipe
+TEST_CASE("OpenGL renderer draws batched quads in a hidden window",
+          "[.][renderer][gl]") {
+  auto window = platform::createWindow();
+  platform::WindowConfig config;
+  config.width = 64;
+  config.height = 64;
+  config.resizable = false;
+  config.hidden = true;
+  REQUIRE(window->create(config).isOk());
+  // A native handle means SDL, so the OpenGL backend is the real one
+  REQUIRE(window->getNativeHandle() != nullptr);
+
+  auto renderer = createRenderer(RendererBackend::OpenGL);
+  REQUIRE(renderer->initialize(*window).isOk());
+
+  // Created with the context current, so it lives on the GPU
+  const std::vector<u8> green = {0, 255, 0, 255, 0, 255, 0, 255,
+                                 0, 255, 0, 255, 0, 255, 0, 255};
+  Texture texture;
+  REQUIRE(texture.loadFromRGBA(green.data(), 2, 2).isOk());
+  REQUIRE(texture.getNativeHandle() != nullptr);
+
+  renderer->beginFrame();
+  renderer->clear(Color(0, 0, 0, 255));
+  renderer->fillRect(Rect{0, 0, 32, 64}, Color(255, 0, 0, 255));
+  Transform2D transform = at(32, 0);
+  transform.scaleX = 16.0f;
+  transform.scaleY = 16.0f;
+  renderer->drawSprite(texture, transform);
+  // The queued draw keeps the GL name, not the Texture object
+  const Texture moved = std::move(texture);
+
+  auto frame = renderer->captureFrame();
+  REQUIRE(frame.isOk());
+  const auto &image = frame.value();
+  REQUIRE(image.width == 64);
+  REQUIRE(image.height == 64);
+  const auto pixel = [&image](i32 x, i32 y) {
+    const u8 *p = image.pixels.data() + (y * image.width + x) * 4;
+    return Color(p[0], p[1], p[2], p[3]);
+  };
+  REQUIRE(pixel(8, 40).r == 255);
+  REQUIRE(pixel(8, 40).g == 0);
+  REQUIRE(pixel(48, 8).r == 0);
+  REQUIRE(pixel(48, 8).g == 255);
+  REQUIRE(pixel(48, 48).r == 0);
+  REQUIRE(pixel(48, 48).g == 0);
+
+  renderer->endFrame();
+  REQUIRE(renderer->getStats().quads == 2);
+  REQUIRE(renderer->getStats().batches == 1);
+  REQUIRE(renderer->getStats().drawCalls == 2);
+}
+
+TEST_CASE("Sprite batching throughput", "[.][benchmark][renderer][batch]") {
+  using Clock = std::chrono::steady_clock;
+  const Texture atlas = makeTexture(1024, 1024);
+  const Texture sprite = makeTexture(256, 256);
+  SpriteBatch batch;
+  u64 drawn = 0;
+  batch.setFlushCallback([&drawn](std::span<const SpriteVertex> vertices,
+                                  std::span<const SpriteDrawCommand>) {
+    drawn += vertices.size();
+  });
+
+  constexpr int kFrames = 200;
+  constexpr int kQuads = 5000;
+  const auto start = Clock::now();
+  for (int frame = 0; frame < kFrames; ++frame) {
+    batch.resetStats();
+    for (int i = 0; i < kQuads; ++i) {
+      Transform2D transform = at(static_cast<f32>(i % 100) * 12.0f,
+                                 static_cast<f32>(i / 100) * 14.0f);
+      transform.rotation = (i % 7 == 0) ? 15.0f : 0.0f;
+      batch.draw(i % 50 == 0 ? sprite : atlas, Rect{0, 0, 12, 14}, transform,
+                 Color::White);
+    }
+    batch.flush();
+  }
+  const double ms =
+      std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+  std::cout << kQuads << " quads per frame: " << ms / kFrames
+            << " ms per frame, " << batch.stats().drawCalls
+            << " draw calls instead of " << kQuads << " (" << drawn
+            << " vertices)\n";
+}
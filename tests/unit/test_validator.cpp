@@ -139,7 +139,7 @@ TEST_CASE("Validator - Undefined character in show statement reports error", "[v
     showStmt.identifier = "UndefinedCharacter";
     showStmt.position = Position::Center;
 
-    scene.body.push_back(makeStmt(showStmt));
+    scene.body.push_back(program.arena->makeStmt(showStmt));
     program.scenes.push_back(std::move(scene));
 
     auto result = validator.validate(program);
@@ -169,7 +169,7 @@ TEST_CASE("Validator - Undefined scene in goto reports error", "[validator]")
     GotoStmt gotoStmt;
     gotoStmt.target = "nonexistent_scene";
 
-    scene.body.push_back(makeStmt(gotoStmt));
+    scene.body.push_back(program.arena->makeStmt(gotoStmt));
     program.scenes.push_back(std::move(scene));
 
     auto result = validator.validate(program);
@@ -200,14 +200,14 @@ TEST_CASE("Validator - Valid goto to defined scene passes", "[validator]")
 
     GotoStmt gotoStmt;
     gotoStmt.target = "scene2";
-    scene1.body.push_back(makeStmt(gotoStmt));
+    scene1.body.push_back(program.arena->makeStmt(gotoStmt));
     program.scenes.push_back(std::move(scene1));
 
     SceneDecl scene2;
     scene2.name = "scene2";
     SayStmt sayStmt;
     sayStmt.text = "Hello";
-    scene2.body.push_back(makeStmt(sayStmt));
+    scene2.body.push_back(program.arena->makeStmt(sayStmt));
     program.scenes.push_back(std::move(scene2));
 
     auto result = validator.validate(program);
@@ -242,7 +242,7 @@ TEST_CASE("Validator - Unused character reports warning", "[validator]")
     scene.name = "test_scene";
     SayStmt sayStmt;
     sayStmt.text = "Hello";
-    scene.body.push_back(makeStmt(sayStmt));
+    scene.body.push_back(program.arena->makeStmt(sayStmt));
     program.scenes.push_back(std::move(scene));
 
     auto result = validator.validate(program);
@@ -281,7 +281,7 @@ TEST_CASE("Validator - Used character does not report warning", "[validator]")
     showStmt.target = ShowStmt::Target::Character;
     showStmt.identifier = "Hero";
     showStmt.position = Position::Center;
-    scene.body.push_back(makeStmt(showStmt));
+    scene.body.push_back(program.arena->makeStmt(showStmt));
 
     program.scenes.push_back(std::move(scene));
 
@@ -309,7 +309,7 @@ TEST_CASE("Validator - Empty choice block reports error", "[validator]")
 
     ChoiceStmt choiceStmt;
     // No options
-    scene.body.push_back(makeStmt(std::move(choiceStmt)));
+    scene.body.push_back(program.arena->makeStmt(std::move(choiceStmt)));
     program.scenes.push_back(std::move(scene));
 
     auto result = validator.validate(program);
@@ -339,7 +339,7 @@ TEST_CASE("Validator - Undefined speaker in say reports error", "[validator]")
     SayStmt sayStmt;
     sayStmt.speaker = "UndefinedSpeaker";
     sayStmt.text = "Hello";
-    scene.body.push_back(makeStmt(sayStmt));
+    scene.body.push_back(program.arena->makeStmt(sayStmt));
     program.scenes.push_back(std::move(scene));
 
     auto result = validator.validate(program);
@@ -380,12 +380,12 @@ TEST_CASE("Validator - Valid program validates successfully", "[validator]")
     showStmt.target = ShowStmt::Target::Character;
     showStmt.identifier = "Hero";
     showStmt.position = Position::Center;
-    scene.body.push_back(makeStmt(showStmt));
+    scene.body.push_back(program.arena->makeStmt(showStmt));
 
     SayStmt sayStmt;
     sayStmt.speaker = "Hero";
     sayStmt.text = "Hello, world!";
-    scene.body.push_back(makeStmt(sayStmt));
+    scene.body.push_back(program.arena->makeStmt(sayStmt));
 
     program.scenes.push_back(std::move(scene));
 
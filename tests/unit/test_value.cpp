@@ -1,4 +1,5 @@
 #include <catch2/catch_test_macros.hpp>
+#include "NovelMind/scripting/tagged_value.hpp"
 #include "NovelMind/scripting/value.hpp"
 
 using namespace NovelMind::scripting;
@@ -65,3 +66,24 @@ TEST_CASE("asString conversions", "[value]")
     REQUIRE(asString(false) == "false");
     REQUIRE(asString(std::monostate{}) == "null");
 }
+
+TEST_CASE("TaggedValue round-trips through Value", "[value]")
+{
+    REQUIRE(TaggedValue::fromValue(Value{NovelMind::i32{7}}).asInt() == 7);
+    REQUIRE(TaggedValue::fromValue(Value{true}).asBool());
+    REQUIRE(TaggedValue::fromValue(Value{}).isNull());
+
+    TaggedValue owned = TaggedValue::fromValue(Value{std::string{"hello"}});
+    TaggedValue copy = owned;
+    owned = TaggedValue(NovelMind::i32{1});
+    REQUIRE(copy.stringView() == "hello");
+    REQUIRE(std::get<std::string>(copy.toValue()) == "hello");
+
+    std::string storage = "interned";
+    const std::string_view table = storage;
+    TaggedValue borrowed = TaggedValue::interned(&table);
+    REQUIRE(getValueType(borrowed) == ValueType::String);
+    borrowed.detach();
+    storage[0] = 'X';
+    REQUIRE(asString(borrowed) == "interned");
+}
@@ -1,5 +1,7 @@
 #include <catch2/catch_test_macros.hpp>
 #include "NovelMind/scripting/vm.hpp"
+#include <chrono>
+#include <iostream>
 
 using namespace NovelMind::scripting;
 
@@ -204,3 +206,172 @@ TEST_CASE("VM reset", "[scripting]")
     REQUIRE_FALSE(vm.isHalted());
     REQUIRE_FALSE(vm.isRunning());
 }
+
+TEST_CASE("VM variable slots persist across reload", "[scripting]")
+{
+    VirtualMachine vm;
+
+    // Set before load: bytecode must observe the value through its slot
+    vm.setVariable("score", NovelMind::i32{40});
+
+    std::vector<Instruction> program = {
+        {OpCode::LOAD_GLOBAL, 1},
+        {OpCode::PUSH_INT, 2},
+        {OpCode::ADD, 0},
+        {OpCode::STORE_GLOBAL, 1},
+        {OpCode::PUSH_BOOL, 1},
+        {OpCode::SET_FLAG, 0},
+        {OpCode::HALT, 0}
+    };
+    std::vector<std::string> strings = {"seen", "score"};
+
+    REQUIRE(vm.load(program, strings).isOk());
+    vm.run();
+    REQUIRE(std::get<NovelMind::i32>(vm.getVariable("score")) == 42);
+    REQUIRE(vm.getFlag("seen"));
+
+    // Reloading with a different string layout keeps values by name
+    std::vector<Instruction> second = {
+        {OpCode::LOAD_VAR, 0},
+        {OpCode::STORE_VAR, 1},
+        {OpCode::CHECK_FLAG, 2},
+        {OpCode::STORE_VAR, 3},
+        {OpCode::HALT, 0}
+    };
+    REQUIRE(vm.load(second, {"score", "copy", "seen", "flag_copy"}).isOk());
+    vm.run();
+    REQUIRE(std::get<NovelMind::i32>(vm.getVariable("copy")) == 42);
+    REQUIRE(std::get<bool>(vm.getVariable("flag_copy")) == true);
+
+    auto all = vm.getAllVariables();
+    REQUIRE(all.size() == 3);
+    REQUIRE(all.count("score") == 1);
+    REQUIRE_FALSE(vm.hasVariable("missing"));
+}
+
+namespace {
+
+// i = 0; do { i = i + 1 } while (i < iterations); then SAY, then HALT
+std::vector<Instruction> makeCountingLoop(NovelMind::u32 iterations) {
+    return {
+        {OpCode::PUSH_INT, 0},
+        {OpCode::STORE_GLOBAL, 0},
+        {OpCode::LOAD_GLOBAL, 0},   // 2: loop head
+        {OpCode::PUSH_INT, 1},
+        {OpCode::ADD, 0},
+        {OpCode::STORE_GLOBAL, 0},
+        {OpCode::LOAD_GLOBAL, 0},
+        {OpCode::PUSH_INT, iterations},
+        {OpCode::LT, 0},
+        {OpCode::JUMP_IF, 2},
+        {OpCode::PUSH_NULL, 0},
+        {OpCode::SAY, 1},
+        {OpCode::HALT, 0}
+    };
+}
+
+} // namespace
+
+TEST_CASE("VM dispatch modes agree", "[scripting]")
+{
+    for (auto mode : {DispatchMode::Switch, DispatchMode::Threaded,
+                      DispatchMode::Portable}) {
+        VirtualMachine vm;
+        vm.setDispatchMode(mode);
+        REQUIRE(vm.load(makeCountingLoop(100), {"i", "done"}).isOk());
+
+        std::string said;
+        vm.registerCallback(OpCode::SAY, [&said](const std::vector<Value> &args) {
+            said = asString(args[0]);
+        });
+
+        vm.run();
+        REQUIRE(vm.isWaiting());
+        REQUIRE_FALSE(vm.isHalted());
+        REQUIRE(vm.getIP() == 12);
+        REQUIRE(said == "done");
+        REQUIRE(std::get<NovelMind::i32>(vm.getVariable("i")) == 100);
+
+        vm.signalContinue();
+        REQUIRE(vm.isHalted());
+    }
+}
+
+TEST_CASE("VM threaded dispatch stops at end of program", "[scripting]")
+{
+    for (auto mode : {DispatchMode::Threaded, DispatchMode::Portable}) {
+        VirtualMachine vm;
+        vm.setDispatchMode(mode);
+        REQUIRE(vm.load({{OpCode::PUSH_INT, 3}, {OpCode::JUMP, 99}}, {})
+                    .isOk());
+        vm.run();
+        REQUIRE(vm.isHalted());
+    }
+}
+
+TEST_CASE("VM bounded run stops at the budget and after native commands",
+          "[scripting]")
+{
+    for (auto mode : {DispatchMode::Switch, DispatchMode::Threaded,
+                      DispatchMode::Portable}) {
+        VirtualMachine vm;
+        vm.setDispatchMode(mode);
+        REQUIRE(vm.load(makeCountingLoop(100), {"i", "done"}).isOk());
+
+        int said = 0;
+        vm.registerCallback(OpCode::SAY,
+                            [&said](const std::vector<Value> &) { ++said; });
+
+        REQUIRE(vm.run(50) == 50);
+        REQUIRE(vm.getIP() == 2); // Back at the loop head
+        REQUIRE_FALSE(vm.isRunning());
+
+        // 2 prologue + 8 per iteration, then PUSH_NULL and SAY
+        NovelMind::u32 executed = 50;
+        while (!vm.isWaiting()) {
+            const NovelMind::u32 ran = vm.run(1000);
+            REQUIRE(ran > 0);
+            executed += ran;
+        }
+        REQUIRE(executed == 2 + 8 * 100 + 2);
+        REQUIRE(said == 1);
+        REQUIRE(vm.run(1000) == 0);
+
+        // Not left running: continuing must not execute on its own
+        vm.signalContinue();
+        REQUIRE_FALSE(vm.isHalted());
+        REQUIRE(vm.run(1000) == 1);
+        REQUIRE(vm.isHalted());
+    }
+}
+
+TEST_CASE("VM dispatch throughput benchmark", "[.][benchmark][scripting]")
+{
+    constexpr NovelMind::u32 kIterations = 2000000;
+    // 2 prologue + 8 per iteration + PUSH_NULL + SAY
+    const double executed = 2.0 + 8.0 * kIterations + 2.0;
+
+    if (!VirtualMachine::computedGotoAvailable()) {
+        std::cout << "[vm dispatch benchmark] computed goto not built, "
+                     "threaded runs the portable loop\n";
+    }
+    for (auto mode : {DispatchMode::Switch, DispatchMode::Portable,
+                      DispatchMode::Threaded}) {
+        VirtualMachine vm;
+        vm.setDispatchMode(mode);
+        REQUIRE(vm.load(makeCountingLoop(kIterations), {"i", "done"}).isOk());
+
+        auto start = std::chrono::steady_clock::now();
+        vm.run();
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+
+        REQUIRE(vm.isWaiting());
+        std::cout << "[vm dispatch benchmark] "
+                  << (mode == DispatchMode::Switch     ? "step()  "
+                      : mode == DispatchMode::Portable ? "portable"
+                                                       : "threaded")
+                  << ": " << executed / elapsed.count() / 1e6
+                  << " M instructions/s\n";
+    }
+}
@@ -0,0 +1,87 @@
+#include <catch2/catch_test_macros.hpp>
+#include "NovelMind/scripting/vm.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+using namespace NovelMind::scripting;
+
+// Counts every heap allocation in this binary, which is why these tests
+// are built as vm_allocation_tests rather than into unit_tests.
+namespace {
+std::atomic<std::size_t> g_allocations{0};
+} // namespace
+
+void *operator new(std::size_t size) {
+    ++g_allocations;
+    if (void *ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace {
+
+// Strings longer than the small-string buffer so copies must allocate
+const std::vector<std::string> kBenchStrings = {
+    "player_reputation_with_the_northern_guild",
+    "A line of dialogue long enough to defeat small string optimisation"};
+
+std::vector<Instruction> makeStringHeavyProgram(int iterations) {
+    std::vector<Instruction> program;
+    for (int i = 0; i < iterations; ++i) {
+        program.emplace_back(OpCode::PUSH_STRING, 1);
+        program.emplace_back(OpCode::STORE_GLOBAL, 0);
+        program.emplace_back(OpCode::LOAD_GLOBAL, 0);
+        program.emplace_back(OpCode::DUP, 0);
+        program.emplace_back(OpCode::EQ, 0);
+        program.emplace_back(OpCode::POP, 0);
+    }
+    program.emplace_back(OpCode::HALT, 0);
+    return program;
+}
+
+// Heap allocations made by a second run of @p program
+std::size_t allocationsPerRun(const std::vector<Instruction> &program) {
+    VirtualMachine vm;
+    REQUIRE(vm.load(program, kBenchStrings).isOk());
+
+    // First run builds the one-off threaded translation of the program
+    vm.run();
+    vm.reset();
+
+    const std::size_t before = g_allocations.load();
+    vm.run();
+    const std::size_t after = g_allocations.load();
+
+    REQUIRE(vm.isHalted());
+    REQUIRE(asString(vm.getVariable(kBenchStrings[0])) == kBenchStrings[1]);
+    return after - before;
+}
+
+} // namespace
+
+TEST_CASE("VM string values do not allocate in the hot loop", "[scripting]")
+{
+    REQUIRE(allocationsPerRun(makeStringHeavyProgram(64)) == 0);
+}
+
+// The VM before TaggedValue, built from the commit preceding it, made
+// 50000 allocations (0.83 per instruction) on this program.
+TEST_CASE("VM allocations per instruction benchmark", "[.][benchmark][scripting]")
+{
+    const auto program = makeStringHeavyProgram(10000);
+    const std::size_t allocations = allocationsPerRun(program);
+
+    std::cout << "[vm alloc benchmark] " << program.size() << " instructions, "
+              << allocations << " allocations ("
+              << static_cast<double>(allocations) /
+                     static_cast<double>(program.size())
+              << " per instruction)\n";
+
+    REQUIRE(allocations == 0);
+}
@@ -148,3 +148,91 @@ TEST_CASE("VM VN opcodes pass args", "[scripting]") {
     REQUIRE(asInt(args[0]) == 123);
   }
 }
+
+namespace {
+
+struct ChoiceRecorder {
+  std::vector<std::string> options;
+  u32 calls = 0;
+
+  void onChoice(const NativeCallArgs &args) {
+    ++calls;
+    options.clear();
+    for (u32 i = 0; i < args.operand; ++i) {
+      options.emplace_back(args.option(i).stringView());
+    }
+  }
+};
+
+} // namespace
+
+TEST_CASE("VM native handlers receive stack views", "[scripting]") {
+  SECTION("SAY exposes text and speaker without copying") {
+    VirtualMachine vm;
+    std::vector<Instruction> program = {
+        {OpCode::PUSH_STRING, 1},
+        {OpCode::SAY, 0},
+        {OpCode::HALT, 0},
+    };
+    REQUIRE(vm.load(program, {"Hello", "Hero"}).isOk());
+
+    struct Captured {
+      std::string text;
+      std::string speaker;
+    } captured;
+    vm.registerNativeHandler(
+        OpCode::SAY,
+        [](void *context, const NativeCallArgs &args) {
+          auto *out = static_cast<Captured *>(context);
+          out->text.assign(args.text);
+          out->speaker.assign(args.fromTop(0).stringView());
+        },
+        &captured);
+
+    vm.run();
+
+    REQUIRE(vm.isWaiting());
+    REQUIRE(captured.text == "Hello");
+    REQUIRE(captured.speaker == "Hero");
+  }
+
+  SECTION("CHOICE options in declaration order; operands are consumed") {
+    VirtualMachine vm;
+    std::vector<Instruction> program = {
+        {OpCode::PUSH_INT, 2},
+        {OpCode::PUSH_STRING, 0},
+        {OpCode::PUSH_STRING, 1},
+        {OpCode::CHOICE, 2},
+        {OpCode::HALT, 0},
+    };
+    REQUIRE(vm.load(program, {"Left", "Right"}).isOk());
+
+    ChoiceRecorder recorder;
+    vm.bindNativeHandler<&ChoiceRecorder::onChoice>(OpCode::CHOICE, &recorder);
+
+    vm.run();
+    REQUIRE(recorder.calls == 1);
+    REQUIRE(recorder.options == std::vector<std::string>{"Left", "Right"});
+
+    // The selection is the only value left on the stack
+    vm.registerCallback(OpCode::SAY, [](const std::vector<Value> &) {});
+    vm.signalChoice(1);
+    REQUIRE(vm.isHalted());
+  }
+
+  SECTION("Latest registration wins") {
+    VirtualMachine vm;
+    REQUIRE(vm.load({{OpCode::WAIT, 7}, {OpCode::HALT, 0}}, {}).isOk());
+
+    ChoiceRecorder unused;
+    bool legacyCalled = false;
+    vm.bindNativeHandler<&ChoiceRecorder::onChoice>(OpCode::WAIT, &unused);
+    vm.registerCallback(OpCode::WAIT, [&legacyCalled](const std::vector<Value> &in) {
+      legacyCalled = asInt(in[0]) == 7;
+    });
+
+    vm.step();
+    REQUIRE(legacyCalled);
+    REQUIRE(unused.calls == 0);
+  }
+}